@@ -3,6 +3,8 @@
  *
  * Efficient memory management for clauses using a single contiguous
  * memory region. This improves cache locality and reduces fragmentation.
+ * On Linux, large arenas are mapped with transparent huge pages and
+ * grow with mremap (see arena.c).
  *********************************************************************/
 
 #ifndef BSAT_ARENA_H
@@ -20,35 +22,68 @@ typedef struct Arena {
     uint32_t* memory;      // Contiguous memory block
     size_t    size;        // Current size in uint32_t units
     size_t    capacity;    // Total capacity in uint32_t units
-    size_t    wasted;      // Wasted space from deletions
+    size_t    wasted;      // Wasted space from deletions and shrinking
     uint32_t  num_growths; // Number of times arena was expanded
     size_t    peak_size;   // Peak size reached (for stats)
+    uint32_t  num_clauses; // Active (not deleted) clauses
+    bool      mapped;      // Memory is an anonymous mapping (else malloc'd)
+    bool      huge_pages;  // Mapping advised for transparent huge pages
+
+    // Generations: clauses below `tenured` survived a collection as
+    // keepers and are only moved by major collections
+    size_t    tenured;        // First word of the young region
+    size_t    tenured_wasted; // Part of `wasted` below `tenured`
+    uint32_t  num_collections;
+    uint32_t  num_major;      // Collections that included the tenured region
+
+    // Collection in progress: survivors are copied to `to_space` and
+    // then back to `gc_base`
+    uint32_t* to_space;
+    size_t    to_size;
+    size_t    to_capacity;
+    size_t    gc_base;
+    size_t    gc_tenured;     // Tenure boundary set by arena_gc_tenure
 } Arena;
 
 /*********************************************************************
  * Clause Header Structure
  *
- * Stored inline before clause literals in arena.
- * Compact representation to minimize memory overhead.
+ * Two words stored inline before the clause literals. Learned clauses
+ * carry their activity in one more word just before the header, so
+ * original clauses pay nothing for it:
+ *
+ *   original: [size|flags] [lbd|used] lits...
+ *   learned:  [activity] [size|flags] [lbd|used] lits...
+ *                        ^ cref
+ *
+ * A clause moved by garbage collection keeps its forwarding CRef in
+ * the second word.
  *********************************************************************/
 
 typedef struct ClauseHeader {
     uint32_t size     : 28;  // Number of literals (max 268M)
-    uint32_t flags    : 4;   // Clause flags (learned, deleted, etc.)
-    uint32_t lbd;            // Literal Block Distance score
-    float    activity;       // Clause activity for deletion
+    uint32_t flags    : 4;   // Clause flags (learned, deleted, moved)
+    uint32_t lbd      : 30;  // Literal Block Distance score (never above size)
+    uint32_t used     : 2;   // Reductions the clause survives unused
 } ClauseHeader;
 
+// Words of header and activity in front of the literals
+#define HEADER_WORDS (sizeof(ClauseHeader) / sizeof(uint32_t))
+#define ACTIVITY_WORDS 1
+
 // Get clause header from CRef
 #define CLAUSE_HEADER(arena, cref) ((ClauseHeader*)&(arena)->memory[cref])
 
 // Get literals array from CRef
-#define CLAUSE_LITS(arena, cref) ((Lit*)&(arena)->memory[cref + sizeof(ClauseHeader)/sizeof(uint32_t)])
+#define CLAUSE_LITS(arena, cref) ((Lit*)&(arena)->memory[(cref) + HEADER_WORDS])
 
 // Get clause size from CRef
 #define CLAUSE_SIZE(arena, cref) (CLAUSE_HEADER(arena, cref)->size)
 
-// Calculate total memory needed for a clause
+// Activity of a learned clause (the word before its header)
+#define CLAUSE_ACTIVITY(arena, cref) ((float*)&(arena)->memory[(cref) - ACTIVITY_WORDS])
+
+// Calculate total memory needed for an original clause
 static inline size_t clause_bytes(uint32_t size) {
     return sizeof(ClauseHeader) + size * sizeof(Lit);
 }
@@ -69,6 +104,10 @@ bool arena_reserve(Arena* arena, size_t min_capacity);
 // Free arena and all its memory
 void arena_free(Arena* arena);
 
+// Drop every clause but keep the memory (and the collector's scratch
+// block) for the next formula
+void arena_clear(Arena* arena);
+
 // Allocate space for a new clause
 // Returns INVALID_CLAUSE on failure
 CRef arena_alloc(Arena* arena, const Lit* lits, uint32_t size, bool learned);
@@ -76,10 +115,44 @@ CRef arena_alloc(Arena* arena, const Lit* lits, uint32_t size, bool learned);
 // Mark clause as deleted (doesn't free memory immediately)
 void arena_delete(Arena* arena, CRef cref);
 
-// Garbage collect deleted clauses and compact memory
-// Updates all CRefs in the provided arrays
-void arena_gc(Arena* arena, CRef** watches, uint32_t num_watches,
-              CRef* clauses, uint32_t* num_clauses);
+// Turn a learned clause into an original one; its activity word is
+// wasted until the next collection
+void arena_promote(Arena* arena, CRef cref);
+
+// Drop the trailing literals of a clause (size may only decrease)
+void arena_shrink(Arena* arena, CRef cref, uint32_t new_size);
+
+/*********************************************************************
+ * Garbage Collection
+ *
+ * Generational copying collector driven by the owner's references.
+ * A minor collection only evacuates the young region above `tenured`;
+ * a major collection, run once a quarter of the tenured region is
+ * wasted, evacuates everything. arena_gc_move copies a clause to a
+ * scratch block on its first visit and leaves the final CRef in the old
+ * header, so later references to the same clause are just forwarded;
+ * references to deleted clauses come back as INVALID_CLAUSE. Clauses
+ * are laid out in the order they are first moved, so moving them while
+ * walking the watch lists keeps clauses watched by the same literal
+ * together. Clauses moved before arena_gc_tenure are promoted to the
+ * tenured region. arena_gc_end copies the survivors back in place, so a
+ * collection needs extra memory only for the live clauses it moves.
+ * Every reference must be passed through arena_gc_move before
+ * arena_gc_end; clauses nobody references are dropped.
+ *********************************************************************/
+
+// Collect once a quarter of the young or of the tenured region is wasted
+static inline bool arena_gc_due(const Arena* arena) {
+    size_t young = arena->size - arena->tenured;
+    size_t young_wasted = arena->wasted - arena->tenured_wasted;
+    return young_wasted * 4 >= young
+        || arena->tenured_wasted * 4 >= arena->tenured;
+}
+
+bool arena_gc_begin(Arena* arena);
+CRef arena_gc_move(Arena* arena, CRef cref);
+void arena_gc_tenure(Arena* arena);
+void arena_gc_end(Arena* arena);
 
 // Get current memory usage statistics
 typedef struct {
@@ -87,6 +160,8 @@ typedef struct {
     size_t used_bytes;      // Currently used memory
     size_t wasted_bytes;    // Wasted from deletions
     uint32_t num_clauses;   // Number of active clauses
+    bool mapped;            // Served by the mapping backend
+    bool huge_pages;        // Advised for transparent huge pages
 } ArenaStats;
 
 ArenaStats arena_stats(const Arena* arena);
@@ -115,14 +190,14 @@ static inline void set_clause_lbd(Arena* arena, CRef cref, uint32_t lbd) {
     CLAUSE_HEADER(arena, cref)->lbd = lbd;
 }
 
-// Get clause activity
+// Get clause activity (always 0 for original clauses)
 static inline float clause_activity(const Arena* arena, CRef cref) {
-    return CLAUSE_HEADER(arena, cref)->activity;
+    return clause_learned(arena, cref) ? *CLAUSE_ACTIVITY(arena, cref) : 0.0f;
 }
 
-// Bump clause activity
+// Bump clause activity (learned clauses only)
 static inline void bump_clause_activity(Arena* arena, CRef cref, float inc) {
-    CLAUSE_HEADER(arena, cref)->activity += inc;
+    *CLAUSE_ACTIVITY(arena, cref) += inc;
 }
 
 #endif // BSAT_ARENA_H
\ No newline at end of file
@@ -0,0 +1,56 @@
+/*********************************************************************
+ * BSAT Competition Solver - Batch Solving
+ *
+ * Solves a stream of independent instances in one process, so that
+ * process startup and solver allocation are paid once per worker rather
+ * than once per instance. Each worker thread owns one solver and
+ * returns it to a clean state with solver_reset between instances,
+ * which keeps the capacity of its arrays, arena and watch lists.
+ *
+ * Input, one item per line (blank lines and lines starting with '#'
+ * are skipped):
+ *
+ *   <path>          a DIMACS file (compressed files are fine)
+ *   @<bytes>        a frame: exactly <bytes> bytes of DIMACS text follow
+ *
+ * Workers take the next item as soon as they are idle. Every item
+ * produces one JSON line on the output, in completion order:
+ *
+ *   {"id": 0, "input": "a.cnf", "result": "SAT", "seconds": 0.0012,
+ *    "variables": 20, "clauses": 91, "decisions": 17, ...}
+ *
+ * "id" counts items from 0 in input order; frames have no "input".
+ * Failed items have "result": "ERROR" and an "error" message. With
+ * models enabled, SAT lines carry "model": [1, -2, ...].
+ *********************************************************************/
+
+#ifndef BSAT_BATCH_H
+#define BSAT_BATCH_H
+
+#include "solver.h"
+#include <stdio.h>
+
+// Maximum number of batch workers
+#define BATCH_MAX_THREADS 64
+
+typedef struct BatchOpts {
+    uint32_t threads;          // Worker threads (one solver each)
+    bool     models;           // Include the model in SAT lines
+} BatchOpts;
+
+typedef struct BatchStats {
+    uint64_t instances;        // Items processed
+    uint64_t sat;
+    uint64_t unsat;
+    uint64_t unknown;          // Stopped by a conflict or decision limit
+    uint64_t errors;           // Unreadable or malformed items
+    double   time;             // Wall-clock seconds for the whole batch
+} BatchStats;
+
+// Solve every item read from in, writing one JSON line per item to out.
+// Conflict and decision limits in opts apply per instance. Returns false
+// if no worker could be started.
+bool batch_solve(const SolverOpts* opts, FILE* in, FILE* out,
+                 const BatchOpts* bopts, BatchStats* stats);
+
+#endif // BSAT_BATCH_H
@@ -0,0 +1,167 @@
+/*********************************************************************
+ * BSAT Competition Solver - Checkpoint and Resume
+ *
+ * A checkpoint holds everything a long run has built up, so that a run
+ * killed by a preemptible job scheduler can continue where it was
+ * instead of starting over: the clause arena as one block, the original
+ * and learned clause lists, the level-0 units and binary clauses, the
+ * activities, saved and best phases and VMTF stamps, the elimination
+ * stack, and the restart, mode, inprocessing and statistics state.
+ *
+ * It is written at decision level 0, so watches, the trail and the
+ * decision order are rebuilt on loading rather than saved. The XOR
+ * matrices are not saved either: their clauses stay in the formula, so
+ * a resumed run is complete without them. The file is written next to
+ * the target and renamed over it, so a kill during the write leaves the
+ * previous checkpoint intact.
+ *
+ * File layout (native byte order, every part padded to 8 bytes):
+ *
+ *   CheckpointHeader
+ *   stats, mode and inprocessing state (raw Solver structs)
+ *   arena words, clause list, learned clause list
+ *   units, binary clauses (literal pairs)
+ *   activities (doubles), variable flags (CHECKPOINT_VAR_*),
+ *   VMTF stamps, elimination stack, Glucose LBD window
+ *
+ * The header records the sizes of the raw structs, and a checksum over
+ * everything after it; a file from another build or a damaged one is
+ * refused. It also records a fingerprint of the input file the run was
+ * started on, so a checkpoint is never resumed against another formula.
+ * Loading maps the file and copies it out.
+ *********************************************************************/
+
+#ifndef BSAT_CHECKPOINT_H
+#define BSAT_CHECKPOINT_H
+
+#include "types.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// Forward declaration
+struct Solver;
+
+/*********************************************************************
+ * File Format
+ *********************************************************************/
+
+#define CHECKPOINT_MAGIC "BSATCKPT"
+#define CHECKPOINT_VERSION 2
+
+// Optional parts present in the file
+#define CHECKPOINT_QUEUE   1    // VMTF stamps
+#define CHECKPOINT_MODES   2    // Search mode state
+#define CHECKPOINT_ELIM    4    // Elimination stack
+#define CHECKPOINT_WINDOW  8    // Glucose sliding window
+
+// Per-variable flag bits
+#define CHECKPOINT_VAR_POLARITY   1
+#define CHECKPOINT_VAR_FROZEN     2
+#define CHECKPOINT_VAR_MATRIX     4
+#define CHECKPOINT_VAR_BEST       8
+#define CHECKPOINT_VAR_ELIMINATED 16
+
+typedef struct CheckpointHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t header_size;        // sizeof(CheckpointHeader)
+    uint32_t stats_size;         // Sizes of the raw Solver structs
+    uint32_t mode_size;
+    uint32_t inprocess_size;
+    uint32_t flags;              // CHECKPOINT_* parts present
+    uint64_t file_size;
+    uint64_t checksum;           // Over everything after the header
+
+    // Input (CheckpointInput; zero if the solver was given none)
+    uint64_t input_size;
+    uint64_t input_hash;
+
+    // Formula
+    uint32_t num_vars;
+    uint32_t num_input_vars;
+    uint32_t num_clauses;        // Clause list entries (binary slots included)
+    uint32_t num_learnts;
+    uint32_t num_units;
+    uint32_t num_binaries;
+    uint64_t arena_size;         // Words
+    uint64_t arena_wasted;
+    uint64_t arena_peak;
+    uint64_t arena_tenured;
+    uint64_t arena_tenured_wasted;
+    uint32_t arena_clauses;
+    uint32_t arena_growths;
+    uint32_t arena_collections;
+    uint32_t arena_major;
+
+    // Search
+    uint64_t rng;
+    double   var_inc;
+    double   clause_inc;
+    uint64_t queue_stamp;
+
+    // Restarts
+    uint32_t restart_conflicts;
+    uint32_t restart_threshold;
+    uint32_t restart_luby_index;
+    uint32_t restart_stuck;
+    double   slow_ma;
+    double   fast_ma;
+    uint64_t lbd_sum;
+    uint64_t lbd_count;
+    uint32_t window_size;
+    uint32_t window_count;
+    uint32_t window_head;
+
+    // Rephasing
+    uint32_t best_trail_size;
+    uint32_t rephase_conflicts;
+    uint32_t rephase_count;
+
+    // Local search schedule
+    uint64_t ls_conflicts;
+    uint64_t ls_interval;
+    uint64_t ls_next;
+    uint32_t ls_calls;
+    uint32_t ls_successes;
+
+    // Elimination
+    uint32_t elim_stack_size;
+    uint32_t elim_threads;
+    uint64_t elim_vars;
+    uint64_t elim_clauses_removed;
+    uint64_t elim_resolvents_added;
+    uint64_t elim_resolvents_subsumed;
+    uint64_t elim_clauses_blocked;
+    uint64_t elim_batches;
+    double   elim_time;
+} CheckpointHeader;
+
+/*********************************************************************
+ * Checkpoint API
+ *********************************************************************/
+
+// Fingerprint of an input file: its size and a hash of its bytes as
+// stored (compressed inputs are not unpacked)
+typedef struct CheckpointInput {
+    uint64_t size;
+    uint64_t hash;
+} CheckpointInput;
+
+// Fingerprint the file at path. Returns false if it cannot be read or
+// is not a regular file (a pipe could not be read again for parsing).
+bool checkpoint_input(const char* path, CheckpointInput* input);
+
+// Save the state of s, which must be at decision level 0, together with
+// the fingerprint in s->checkpoint.input. Returns false if the file
+// could not be written (an older checkpoint is kept).
+bool checkpoint_write(const struct Solver* s, const char* path);
+
+// Restore a checkpoint into s, a solver without variables or clauses
+// created with the options of the run to resume. If input is given, a
+// checkpoint of any other input is refused. Preprocessing is marked
+// done. Returns false with a message in *error if the file is missing,
+// from another build, of another input or damaged; s must then be freed.
+bool checkpoint_load(struct Solver* s, const char* path, const CheckpointInput* input,
+                     const char** error);
+
+#endif // BSAT_CHECKPOINT_H
@@ -0,0 +1,94 @@
+/*********************************************************************
+ * BSAT Competition Solver - Cube-and-Conquer
+ *
+ * Splits one hard instance into many independent subproblems.
+ *
+ * Cube phase: a lookahead splitter built on failed literal probing.
+ * At every node, it probes both polarities of the most promising
+ * variables, asserts failed literals, and branches on the variable
+ * whose two probes propagate the most (product score, as in march).
+ * Each leaf at the requested depth becomes a cube line "a l1 l2 ... 0"
+ * (iCNF format). Refuted branches are not written, so the cubes
+ * together cover every possible model.
+ *
+ * Conquer phase: each worker thread loads the formula once and solves
+ * its cubes as assumptions of one incremental solver, so clauses learned
+ * on one cube help with the next and are shared between workers. Workers
+ * pull cube indices from a shared atomic queue, so the load balances
+ * itself however uneven the cubes are. For distribution across machines,
+ * --cube-node K/N makes a process take only the cubes with
+ * index % N == K. Every finished cube appends a line to the results
+ * file, and a restarted run skips the cubes already refuted in it.
+ *********************************************************************/
+
+#ifndef BSAT_CUBE_H
+#define BSAT_CUBE_H
+
+#include "solver.h"
+#include "dimacs.h"
+#include <stdio.h>
+
+/*********************************************************************
+ * Configuration Constants
+ *********************************************************************/
+
+// Default split depth (up to 2^depth cubes)
+#define CUBE_DEFAULT_DEPTH 10
+
+// Variables probed per lookahead node (preselected by occurrence count)
+#define CUBE_LOOKAHEAD_CANDIDATES 64
+
+/*********************************************************************
+ * Cube Generation
+ *********************************************************************/
+
+typedef struct CubeGenStats {
+    uint64_t cubes;            // Cubes written
+    uint64_t refuted;          // Branches closed by propagation or lookahead
+    uint64_t probes;           // Literals probed
+    uint64_t failed_literals;  // Failed literals asserted inside the tree
+    double   time;             // Wall-clock seconds spent
+} CubeGenStats;
+
+// Split the formula loaded in s to the given depth and write cubes to out.
+// Returns FALSE if lookahead refutes the whole formula, UNDEF otherwise.
+// The solver is left at decision level 0.
+lbool cube_generate(Solver* s, uint32_t depth, FILE* out, CubeGenStats* stats);
+
+/*********************************************************************
+ * Cube Files
+ *********************************************************************/
+
+typedef struct CubeSet {
+    Lit*      lits;        // Literals of all cubes, back to back
+    uint32_t* start;       // Cube i is lits[start[i] .. start[i + 1])
+    uint32_t  num_cubes;   // Number of cubes
+    uint32_t  max_var;     // Largest variable mentioned
+} CubeSet;
+
+// Read "a ... 0" lines (other lines are ignored). Returns false on error.
+bool cube_read_file(const char* filename, CubeSet* set);
+
+// Free cube storage
+void cube_set_free(CubeSet* set);
+
+/*********************************************************************
+ * Cube Solving
+ *********************************************************************/
+
+typedef struct CubeSolveOpts {
+    const char* results_file;  // Progress/results log for resuming (NULL = none)
+    uint32_t    threads;       // Local worker threads
+    uint32_t    node;          // This process takes cubes with index % num_nodes == node
+    uint32_t    num_nodes;     // Number of cooperating processes (1 = all cubes)
+} CubeSolveOpts;
+
+// Solve every cube of the DIMACS file cnf_file. Resource limits in opts
+// apply per cube, except max_time, which bounds the whole run.
+// Returns TRUE as soon as any cube is SAT (*model receives that solver),
+// FALSE if all cubes are refuted and this process owns all of them (or
+// the formula is refuted without any cube), UNDEF otherwise. *error receives the parse result.
+lbool cube_solve(const SolverOpts* opts, const char* cnf_file, const CubeSet* cubes,
+                 const CubeSolveOpts* copts, Solver** model, DimacsError* error);
+
+#endif // BSAT_CUBE_H
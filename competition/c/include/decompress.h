@@ -0,0 +1,81 @@
+/*********************************************************************
+ * BSAT Competition Solver - Streaming Decompression
+ *
+ * Reads gzip, xz or zstd compressed input and hands out the
+ * decompressed bytes in chunks. The format is detected from the magic
+ * bytes, not the file name.
+ *
+ * Pipeline design:
+ * A producer thread reads and decompresses into a small ring of fixed
+ * chunks while the consumer (the DIMACS tokenizer) scans the chunk it
+ * holds, so input I/O, decompression and clause insertion overlap.
+ * The consumer gets the decompressed bytes in place (no copy) and
+ * returns a chunk to the producer by asking for the next one.
+ *
+ * Codecs are compiled in when the library is available at build time
+ * (BSAT_HAVE_ZLIB, BSAT_HAVE_LZMA, BSAT_HAVE_ZSTD).
+ *********************************************************************/
+
+#ifndef BSAT_DECOMPRESS_H
+#define BSAT_DECOMPRESS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+/*********************************************************************
+ * Configuration Constants
+ *********************************************************************/
+
+// Size of one decompressed chunk
+#define DECOMPRESS_CHUNK (1 << 20)
+
+// Number of chunks in the producer/consumer ring
+#define DECOMPRESS_RING 4
+
+// Bytes needed to recognize every supported format
+#define DECOMPRESS_MAGIC_SIZE 6
+
+/*********************************************************************
+ * Formats
+ *********************************************************************/
+
+typedef enum {
+    COMPRESS_NONE = 0,   // Plain text
+    COMPRESS_GZIP,       // 1f 8b
+    COMPRESS_XZ,         // fd 37 7a 58 5a 00
+    COMPRESS_ZSTD        // 28 b5 2f fd
+} CompressFormat;
+
+// Detect the format from the first bytes of the input
+CompressFormat decompress_detect(const unsigned char* magic, size_t size);
+
+// Whether this build can decode the format
+bool decompress_supported(CompressFormat format);
+
+// Format name for messages ("gzip", "xz", "zstd")
+const char* decompress_format_name(CompressFormat format);
+
+/*********************************************************************
+ * Decompressor
+ *********************************************************************/
+
+typedef struct Decompressor Decompressor;
+
+// Start decoding a stream. The prefix holds bytes already read from the
+// stream (e.g. the magic); it is copied. Returns NULL if the format is
+// not supported or out of memory.
+Decompressor* decompress_open(FILE* in, CompressFormat format,
+                              const unsigned char* prefix, size_t prefix_size);
+
+// Next chunk of decompressed data, valid until the next call.
+// Returns NULL at the end of the input or on error.
+const char* decompress_next(Decompressor* d, size_t* size);
+
+// Whether decoding stopped because of corrupt or truncated input
+bool decompress_failed(const Decompressor* d);
+
+// Stop the producer and free everything (does not close the stream)
+void decompress_close(Decompressor* d);
+
+#endif // BSAT_DECOMPRESS_H
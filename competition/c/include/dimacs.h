@@ -19,23 +19,34 @@ typedef enum {
     DIMACS_ERROR_FILE,       // Cannot open/read file
     DIMACS_ERROR_FORMAT,     // Invalid format
     DIMACS_ERROR_MEMORY,     // Out of memory
-    DIMACS_ERROR_SIZE        // Problem too large
+    DIMACS_ERROR_SIZE,       // Problem too large
+    DIMACS_ERROR_COMPRESSION // Corrupt input or codec not built in
 } DimacsError;
 
 /*********************************************************************
  * Parser API
  *********************************************************************/
 
-// Parse DIMACS file and add clauses to solver
+// Parse DIMACS file and add clauses to solver. Plain regular files are
+// memory-mapped and scanned in place; other files are streamed.
+// gzip, xz and zstd input is detected by its magic bytes. XOR lines
+// ("x1 -2 3 0") go through solver_add_xor after the clauses.
 // Returns DIMACS_OK on success, error code otherwise
 DimacsError dimacs_parse_file(Solver* s, const char* filename);
 
-// Parse DIMACS from FILE stream
+// Parse DIMACS from a memory buffer (need not be NUL-terminated)
+DimacsError dimacs_parse_buffer(Solver* s, const char* data, size_t size);
+
+// Parse DIMACS from FILE stream (compressed input is detected)
 DimacsError dimacs_parse_stream(Solver* s, FILE* file);
 
 // Parse DIMACS from string buffer
 DimacsError dimacs_parse_string(Solver* s, const char* str);
 
+// Read a whole DIMACS file into a NUL-terminated string, decompressing
+// if needed. Returns NULL and sets *error on failure; caller frees.
+char* dimacs_read_text(const char* filename, DimacsError* error);
+
 // Get error description
 const char* dimacs_error_string(DimacsError err);
 
@@ -46,6 +57,20 @@ const char* dimacs_error_string(DimacsError err);
 // Write solution in DIMACS format
 void dimacs_write_solution(const Solver* s, FILE* out);
 
+// Write the model as "v" lines, 20 literals per line, ending in "v ... 0".
+// Variables without a value are written as false.
+void dimacs_write_model(const Solver* s, FILE* out);
+
+// Binary model for tools that mmap it: a 16-byte header (magic
+// "BSATMDL1", then the variable count and a zero word, both 32-bit
+// little-endian) followed by one bit per variable, set when it is true:
+// variable v is bit (v - 1) % 8 of byte (v - 1) / 8.
+#define MODEL_BINARY_MAGIC "BSATMDL1"
+#define MODEL_BINARY_HEADER 16
+
+// Write the binary model to a file; false on I/O errors
+bool dimacs_write_model_binary(const Solver* s, const char* filename);
+
 // Write UNSAT proof/core (if available)
 void dimacs_write_proof(const Solver* s, FILE* out);
 
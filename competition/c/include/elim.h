@@ -13,8 +13,22 @@
  *   - Resolvents R = all non-tautological resolutions of P × N
  *   - Elimination is beneficial if |R| <= |P| + |N|
  *
- * After solving, eliminated variables are reconstructed by processing
- * the elimination stack in reverse order.
+ * Candidates come from a min-heap keyed by |P|·|N|. Variables are taken
+ * in batches whose clauses share no variable with another candidate of
+ * the batch; the resolvents of a batch are computed in parallel (the
+ * clause database is read-only meanwhile) and committed sequentially in
+ * heap order, so the result does not depend on the thread count.
+ *
+ * Blocked clause elimination (BCE) runs on the same occurrence lists: a
+ * clause C is blocked on l if every resolvent of C with a clause
+ * containing ¬l is a tautology. C is removed and saved on the
+ * elimination stack with l first.
+ *
+ * After solving, eliminated variables are reconstructed (and blocked
+ * clauses satisfied) by processing the elimination stack in reverse order.
+ * A clause or assumption added later that mentions the variable of a
+ * stack entry brings the removed clauses back (elim_restore), as in
+ * CaDiCaL's incremental interface.
  *********************************************************************/
 
 #ifndef BSAT_ELIM_H
@@ -28,31 +42,41 @@
 struct Solver;
 
 /*********************************************************************
- * Occurrence List
- *
- * Tracks which clauses contain a given literal.
- * Used for efficient variable elimination cost calculation.
+ * Configuration Constants
  *********************************************************************/
 
-typedef struct OccList {
-    CRef*    clauses;    // Array of clause references
-    uint32_t size;       // Number of clauses in list
-    uint32_t capacity;   // Allocated capacity
-} OccList;
+// Upper bound on worker threads (elim_threads = 0 picks the CPU count)
+#define ELIM_MAX_THREADS 16
+
+// Candidates per batch (fixed, so batches do not depend on the thread count)
+#define ELIM_BATCH_SIZE 1024
+
+// Occurrence lists longer than this are not scanned for subsumers
+#define ELIM_SUBSUME_MAX_OCC 64
+
+// Literals whose negation occurs more often are not tried as blocking
+// literals
+#define ELIM_BLOCKED_MAX_OCC 64
 
 /*********************************************************************
- * Elimination Stack Entry
+ * Occurrence List
  *
- * Records information needed to reconstruct eliminated variables.
- * After solving, we process the stack in reverse order to assign
- * values to eliminated variables.
+ * Tracks which clauses contain a given literal, with the clause's
+ * 64-bit signature (bit var % 64) as a subsumption filter: C can only
+ * subsume or strengthen D if sig(C) & ~sig(D) == 0. Entries of deleted
+ * clauses are dropped lazily; live[lit] counts the others.
  *********************************************************************/
 
-typedef struct ElimEntry {
-    Var      var;         // The eliminated variable
-    Lit*     clause;      // Copy of one clause containing +var (for reconstruction)
-    uint32_t clause_size; // Size of the saved clause
-} ElimEntry;
+typedef struct Occ {
+    uint64_t sig;        // Variable signature of the clause
+    CRef     cref;       // Clause reference
+} Occ;
+
+typedef struct OccList {
+    Occ*     occs;       // Occurrences (may include deleted clauses)
+    uint32_t size;       // Number of entries
+    uint32_t capacity;   // Allocated capacity
+} OccList;
 
 /*********************************************************************
  * Elimination State
@@ -63,34 +87,61 @@ typedef struct ElimEntry {
 
 typedef struct ElimState {
     // Occurrence lists: occs[lit] = clauses containing lit
-    OccList* occs;
-    uint32_t occs_capacity;  // Capacity (2 * num_vars)
-
-    // Elimination stack for solution reconstruction
-    ElimEntry* stack;
-    uint32_t   stack_size;
-    uint32_t   stack_capacity;
+    OccList*  occs;
+    uint32_t* live;          // live[lit] = non-deleted clauses in occs[lit]
+    uint32_t  occs_capacity; // Capacity (2 * num_vars)
+
+    // Binary clauses held in the arena while BVE runs (moved back to the
+    // implication lists at the end)
+    CRef*     bins;
+    uint32_t  bins_size;
+    uint32_t  bins_capacity;
+
+    // Candidate min-heap keyed by |P|·|N|
+    Var*      heap;
+    uint32_t* heap_pos;      // Position in heap (UINT32_MAX if absent)
+    uint32_t  heap_size;
+
+    // Elimination stack for solution reconstruction, one flat literal
+    // array. For each eliminated variable the clauses of both sides are
+    // saved with the eliminated literal first, each followed by its size,
+    // the smaller side first, then a unit for the other side (the default
+    // value); a blocked clause is saved with its blocking literal first.
+    // Reconstruction reads it backwards: a clause not satisfied by its
+    // other literals makes its first literal true. The other side never
+    // fires there; it is kept so elim_restore can bring it back.
+    Lit*      stack;
+    uint32_t  stack_size;
+    uint32_t  stack_capacity;
+
+    // witness[v]: v is the variable of the first literal of a stack
+    // entry. Rebuilt by elim_restore when the stack size changed since.
+    uint8_t*  witness;
+    uint32_t  witness_vars;  // Variables covered by witness
+    uint32_t  witness_stack; // Stack size witness was built for
 
     // Per-variable elimination status
-    bool*    eliminated;     // eliminated[v] = true if v was eliminated
-    uint32_t elim_capacity;  // Capacity of eliminated array
+    bool*     eliminated;    // eliminated[v] = true if v was eliminated
+    uint8_t*  locked;        // Variable occurs in a clause of a batch candidate
+    uint32_t  elim_capacity; // Capacity of eliminated array
 
     // Statistics
     uint64_t vars_eliminated;
     uint64_t clauses_removed;
     uint64_t resolvents_added;
-
-    // Track resolvent CRefs for debugging/dumping
-    CRef*    resolvent_crefs;
-    uint32_t resolvent_crefs_size;
-    uint32_t resolvent_crefs_capacity;
+    uint64_t resolvents_subsumed; // Resolvents dropped as subsumed
+    uint64_t clauses_blocked;     // Clauses removed by BCE
+    uint64_t batches;
+    uint32_t threads;             // Threads used by the last run
+    double   time;                // Seconds in BVE and BCE runs
 } ElimState;
 
 /*********************************************************************
  * Initialization and Cleanup
  *********************************************************************/
 
-// Initialize elimination state (call after solver has variables)
+// Initialize elimination state (call after solver has variables); grows
+// an existing state to variables added since
 void elim_init(struct Solver* s);
 
 // Free all elimination structures
@@ -100,41 +151,41 @@ void elim_free(struct Solver* s);
  * Occurrence List Management
  *********************************************************************/
 
-// Build occurrence lists from current clause database
-void elim_build_occs(struct Solver* s);
+// Build occurrence lists from current clause database (binary clauses
+// are copied from the implication lists into the arena). Returns false
+// if memory ran out, leaving the clause database unchanged.
+bool elim_build_occs(struct Solver* s);
+
+// Add clause to the occurrence list of lit
+void elim_add_occ(struct Solver* s, Lit lit, CRef cref, uint64_t sig);
 
-// Add clause to occurrence lists for all its literals
-void elim_add_occ(struct Solver* s, Lit lit, CRef cref);
+// Append an entry to an occurrence list (false if out of memory)
+bool occ_push(OccList* ol, CRef cref, uint64_t sig);
 
-// Remove clause from occurrence lists for all its literals
-void elim_remove_occ(struct Solver* s, Lit lit, CRef cref);
+// Variable signature of a clause
+uint64_t clause_signature(const Lit* lits, uint32_t size);
 
-// Clear all occurrence lists (but keep allocated memory)
+// Release all occurrence lists
 void elim_clear_occs(struct Solver* s);
 
 /*********************************************************************
  * Variable Elimination
  *********************************************************************/
 
-// Calculate the cost of eliminating a variable
-// Returns number of resolvents that would be created (filtering tautologies)
-// Returns -1 if elimination is not worthwhile (too many resolvents)
-int elim_cost(struct Solver* s, Var v);
-
-// Check if a resolvent would be a tautology (contains both x and ¬x)
-bool elim_is_tautology(const Lit* c1, uint32_t s1,
-                       const Lit* c2, uint32_t s2,
-                       Var pivot);
-
-// Eliminate a single variable
-// Returns true on success, false if elimination not possible
-bool elim_eliminate_var(struct Solver* s, Var v);
-
 // Main BVE preprocessing loop
 // Eliminates variables with positive cost-benefit ratio
 // Returns number of variables eliminated
 uint32_t elim_preprocess(struct Solver* s);
 
+// One BVE round at decision level 0, also during search. Candidates are
+// scheduled until their |P|·|N| sum exceeds effort. Returns the number
+// of variables eliminated (s->result is FALSE if the formula is UNSAT).
+uint32_t elim_run(struct Solver* s, uint64_t effort);
+
+// Remove blocked irredundant clauses at decision level 0, visiting at
+// most about effort clause literals. Returns the number removed.
+uint32_t elim_blocked_clauses(struct Solver* s, uint64_t effort);
+
 /*********************************************************************
  * Solution Reconstruction
  *********************************************************************/
@@ -143,15 +194,23 @@ uint32_t elim_preprocess(struct Solver* s);
 // Must be called after solver finds SAT, before returning model
 void elim_extend_model(struct Solver* s);
 
+// Take the stack entries off the stack whose first literal is on a
+// variable of lits, and transitively those on a variable of a clause
+// taken off before (later entries only, as their removal assumed the
+// earlier clauses), so lits can be added as a clause or assumed at
+// level 0. Their variables are no longer eliminated. The clauses to add
+// back go to *restored, each as its size followed by its literals
+// (*restored_size words, malloc'd, NULL if none). Returns false if
+// memory ran out, leaving the stack unchanged.
+bool elim_restore(struct Solver* s, const Lit* lits, uint32_t size,
+                  Lit** restored, uint32_t* restored_size);
+
 /*********************************************************************
  * Utility Functions
  *********************************************************************/
 
 // Check if a variable has been eliminated
-static inline bool elim_is_eliminated(const struct Solver* s, Var v);
-
-// Get occurrence list for a literal
-static inline OccList* elim_get_occs(struct Solver* s, Lit lit);
+bool elim_is_eliminated(const struct Solver* s, Var v);
 
 // Print elimination statistics
 void elim_print_stats(const struct Solver* s);
@@ -0,0 +1,142 @@
+/*********************************************************************
+ * BSAT Competition Solver - XOR Reasoning (Gauss-Jordan Elimination)
+ *
+ * XOR constraints x1 ^ x2 ^ ... ^ xk = rhs are recovered from their CNF
+ * encodings: the 2^(k-1) clauses over the same variables that exclude
+ * the assignments of the wrong parity (binary ones from the implication
+ * lists). XORs sharing variables form one matrix over GF(2) with
+ * bit-packed rows, brought into reduced row echelon form once.
+ *
+ * During search each row watches its basic column and one non-basic
+ * column (Han & Jiang, "When Boolean Satisfiability Meets Gaussian
+ * Elimination in a Simplex Way", CAV 2012). When a watched column is
+ * assigned the row moves the watch, swaps its basic column for an
+ * unassigned one (adding the row to every other row containing it), or
+ * has one unassigned column left and implies it. Row additions keep
+ * every row a consequence of the formula, so the matrix is never
+ * restored on backtracking. Implications and conflicts get a clause
+ * over the row's variables in the arena, so conflict analysis treats
+ * them like any other reason.
+ *
+ * The CNF encodings stay in the formula: the matrices only add
+ * propagation, so models need no extra check. Matrix variables are
+ * kept out of BCE and BVE, which would break up the encodings.
+ *********************************************************************/
+
+#ifndef BSAT_GAUSS_H
+#define BSAT_GAUSS_H
+
+#include "types.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// Forward declaration
+struct Solver;
+
+/*********************************************************************
+ * Configuration Constants
+ *********************************************************************/
+
+// Longest XOR recovered from clauses (it takes 2^(k-1) of them)
+#define GAUSS_MAX_XOR_SIZE 5
+
+// XORs added with more variables are cut into pieces of this many,
+// chained by fresh variables
+#define GAUSS_XOR_CUT 4
+
+// Connected XORs with fewer rows are left to clause propagation, and
+// matrices with more columns are not built
+#define GAUSS_MIN_ROWS 2
+#define GAUSS_MAX_COLS 4096
+
+// No row or column
+#define GAUSS_NONE UINT32_MAX
+
+/*********************************************************************
+ * Matrix
+ *
+ * Column c of row r is bit c % 64 of word r * words + c / 64. A column
+ * counts as assigned once its trail literal was processed, so every
+ * row update sees the assignment in trail order.
+ *********************************************************************/
+
+// Rows whose non-basic watch is one column
+typedef struct GaussWatches {
+    uint32_t* rows;
+    uint32_t  size;
+    uint32_t  capacity;
+} GaussWatches;
+
+typedef struct GaussMatrix {
+    uint32_t  num_rows;
+    uint32_t  num_cols;
+    uint32_t  words;         // 64-bit words per row
+    uint64_t* bits;          // Rows, num_rows * words
+    uint8_t*  rhs;           // Parity of each row
+    uint32_t* basic;         // Basic column of each row (in no other row)
+    uint32_t* basic_row;     // Row of each basic column, GAUSS_NONE otherwise
+    uint32_t* watch;         // Watched non-basic column of each row, or GAUSS_NONE
+    uint32_t* watch_pos;     // Index of the row in its column's watch list
+    GaussWatches* watches;   // Per column
+    Var*      vars;          // Variable of each column
+    uint64_t* assigned;      // Processed columns (one row of bits)
+    uint64_t* values;        // Their values (zero elsewhere)
+
+    // Rows to check, each queued once
+    uint32_t* queue;
+    uint8_t*  queued;
+    uint32_t  queue_size;
+    bool      recheck;       // Check every row on the next call
+} GaussMatrix;
+
+typedef struct GaussState {
+    GaussMatrix* matrices;
+    uint32_t     num_matrices;
+    uint32_t     num_xors;       // XORs recovered from the clauses
+    uint32_t     num_rows;       // Rows and columns over all matrices
+    uint32_t     num_cols;
+
+    // Column of each variable (variables added later have none)
+    uint32_t     num_vars;
+    uint32_t*    var_matrix;     // Matrix index + 1, 0 = none
+    uint32_t*    var_col;
+
+    // Processed variables in trail order, for backtracking
+    Var*         stack;
+    uint32_t     stack_size;
+    uint32_t     qhead;          // Next trail position to process
+
+    // Reason and conflict clauses in the arena, deleted once unused
+    CRef*        reasons;
+    uint32_t     num_reasons;
+    uint32_t     reasons_capacity;
+    uint32_t     reasons_kept;   // Live after the last release
+    Lit*         scratch;        // Clause being built (widest matrix)
+} GaussState;
+
+/*********************************************************************
+ * Gauss-Jordan API
+ *********************************************************************/
+
+// Recover the XORs of the irredundant clauses and build the matrices.
+// Must be called at decision level 0, before BCE and BVE. Returns false
+// if the XORs are inconsistent (s->result is then FALSE).
+bool gauss_init(struct Solver* s);
+
+// Free the matrices
+void gauss_free(struct Solver* s);
+
+// Process the trail literals not seen yet. Returns a conflict clause or
+// INVALID_CLAUSE; implied literals are put on the trail.
+CRef gauss_propagate(struct Solver* s);
+
+// The trail was cut back (compacted = level-0 literals were moved down)
+void gauss_backtrack(struct Solver* s, bool compacted);
+
+// Delete the reason and conflict clauses no variable refers to
+void gauss_release_reasons(struct Solver* s);
+
+// Forward the remaining clause references after arena_gc_move
+void gauss_move_reasons(struct Solver* s);
+
+#endif // BSAT_GAUSS_H
@@ -1,7 +1,19 @@
 /*********************************************************************
  * BSAT Competition Solver - Local Search Hybridization
  *
- * WalkSAT-style local search for SAT instances.
+ * WalkSAT and ProbSAT style local search for SAT instances.
+ *
+ * Clauses and occurrence lists are stored in flat CSR arrays and the
+ * unsatisfied clauses in an indexed set, so picking an unsatisfied
+ * clause is O(1) and a flip only touches the occurrences of the flipped
+ * variable. Break counts are maintained incrementally: each clause
+ * keeps the XOR of the variables of its true literals, which is the
+ * critical variable whenever exactly one literal is true.
+ *
+ * The state is built once and kept by the solver across calls. Clauses
+ * learned or added afterwards are appended (local_search_add_clause) and
+ * the occurrence lists are re-laid out lazily at the next run, so a call
+ * never walks the clause arena again.
  *********************************************************************/
 
 #ifndef BSAT_LOCAL_SEARCH_H
@@ -14,6 +26,16 @@
 // Forward declarations
 typedef struct Solver Solver;
 
+/*********************************************************************
+ * Configuration Constants
+ *********************************************************************/
+
+// ProbSAT break-count probabilities are tabulated up to this break value
+#define LS_PROB_TABLE_SIZE 64
+
+// ProbSAT polynomial base (eps + break)^-cb
+#define LS_PROBSAT_EPS 1.0
+
 /*********************************************************************
  * Local Search State
  *********************************************************************/
@@ -21,29 +43,46 @@ typedef struct Solver Solver;
 typedef struct LocalSearchState {
     // Current assignment (1-indexed)
     bool*    assignment;     // assignment[v] = true/false for variable v
+    bool*    fixed;          // fixed[v] = assigned at level 0, never flipped
     uint32_t num_vars;
 
+    // Clauses (CSR): clause c is lits[clause_start[c] .. clause_start[c+1])
+    Lit*      lits;
+    uint32_t* clause_start;
+    uint32_t  num_clauses;
+    uint32_t  max_clause_size;
+    uint32_t  lits_capacity;
+    uint32_t  clause_capacity;
+
+    // Occurrence lists (CSR by literal): clauses containing lit are
+    // occs[occ_start[lit] .. occ_start[lit+1])
+    uint32_t* occ_start;
+    uint32_t* occs;
+    bool      occs_dirty;     // Clauses appended since the last layout
+
     // Clause satisfaction tracking
     uint32_t* num_true_lits;  // num_true_lits[c] = count of true literals in clause c
-    uint32_t  num_unsat;      // Number of unsatisfied clauses
+    Var*      true_xor;       // XOR of the variables of the true literals in clause c
 
-    // Break counts (for focused random walk)
-    int32_t* break_count;    // break_count[v] = net unsatisfied clauses if we flip v
+    // Unsatisfied clauses (indexed set)
+    uint32_t* unsat;          // unsat[0 .. num_unsat-1]
+    uint32_t* unsat_pos;      // Position of clause c in unsat (if unsatisfied)
+    uint32_t  num_unsat;
 
-    // Clause data (copied from solver for fast access)
-    Lit**    clause_lits;    // clause_lits[c] = array of literals in clause c
-    uint32_t* clause_sizes;   // clause_sizes[c] = size of clause c
-    uint32_t num_clauses;
+    // Break counts: clauses that become unsatisfied if v is flipped
+    uint32_t* break_count;
 
-    // Occurrence lists (for break count updates)
-    uint32_t** pos_occs;     // pos_occs[v] = clauses where v appears positively
-    uint32_t*  pos_occ_count;
-    uint32_t** neg_occs;     // neg_occs[v] = clauses where v appears negatively
-    uint32_t*  neg_occ_count;
+    // Heuristic
+    bool      probsat;        // ProbSAT instead of WalkSAT
+    double    prob_table[LS_PROB_TABLE_SIZE];  // ProbSAT weight per break count
+    double*   weights;        // Scratch, max_clause_size entries
+    uint64_t  rng;            // xorshift64* state
 
     // Statistics
     uint64_t flips;
     uint64_t restarts;
+    uint64_t added_clauses;   // Clauses appended after initialization
+    double   time;            // Seconds spent in local_search_run
 } LocalSearchState;
 
 /*********************************************************************
@@ -62,13 +101,22 @@ LocalSearchState* local_search_init(Solver* s);
 void local_search_free(LocalSearchState* ls);
 
 /**
- * Run WalkSAT from current solver state.
+ * Append a clause (original or learned) to the local search formula.
+ * Learned clauses must be implied by the formula. Returns false on
+ * allocation failure.
+ */
+bool local_search_add_clause(LocalSearchState* ls, const Lit* lits, uint32_t size);
+
+/**
+ * Run WalkSAT (or ProbSAT, see --ls-probsat) from current solver state.
+ * The walk starts from the best rephasing assignment (saved phases if
+ * rephasing is off) and never flips variables fixed at level 0.
  * Returns true if a satisfying assignment was found.
  *
  * @param s       Solver (used to read current phases and write back solution)
  * @param ls      Local search state
  * @param max_flips  Maximum number of variable flips
- * @param noise   Probability of random walk (0.0 to 1.0)
+ * @param noise   Probability of random walk for WalkSAT (0.0 to 1.0)
  */
 bool local_search_run(Solver* s, LocalSearchState* ls, uint32_t max_flips, double noise);
 
@@ -0,0 +1,90 @@
+/*********************************************************************
+ * BSAT Competition Solver - Phase Timers and Search Histograms
+ *
+ * Compiled in with -DBSAT_PHASES (make PHASES=1). Each timed phase
+ * adds the cycle counter delta (rdtsc on x86, nanoseconds elsewhere)
+ * to a per-solver total; ticks are converted to seconds at report time
+ * against the wall clock. Histograms use power-of-two buckets.
+ *
+ * Without BSAT_PHASES the macros expand to nothing and the Solver has
+ * no phase state, so the instrumentation costs exactly nothing.
+ *********************************************************************/
+
+#ifndef BSAT_PHASES_H
+#define BSAT_PHASES_H
+
+#include <stdint.h>
+#include <time.h>
+
+typedef enum {
+    PHASE_PREPROCESS,    // Preprocessing before the search
+    PHASE_PROPAGATE,     // Search propagation (not probing or vivification)
+    PHASE_ANALYZE,       // First-UIP conflict analysis
+    PHASE_MINIMIZE,      // Recursive clause minimization
+    PHASE_BACKTRACK,     // Backjumping and chronological backtracking
+    PHASE_DECIDE,        // Picking the next decision
+    PHASE_RESTART,       // Restarts (trail reuse included)
+    PHASE_REDUCE,        // Learned clause reduction, GC included
+    PHASE_GC,            // Arena garbage collection
+    PHASE_INPROCESS,     // Inprocessing rounds (probe, subsume, vivify, ...)
+    PHASE_LOCAL_SEARCH,  // Local search calls
+    PHASES
+} Phase;
+
+typedef enum {
+    HIST_LBD,            // LBD of learned clauses (units excluded)
+    HIST_LEARNT_SIZE,    // Size of learned clauses after minimization
+    HIST_TRAIL,          // Trail length at conflict
+    HIST_JUMP,           // Levels undone by a conflict
+    HISTOGRAMS
+} Histogram;
+
+// Bucket b > 0 holds values in [2^(b-1), 2^b); bucket 0 holds 0
+#define HIST_BUCKETS 33
+
+typedef struct PhaseStats {
+    uint64_t ticks[PHASES];
+    uint64_t calls[PHASES];
+    uint64_t hist[HISTOGRAMS][HIST_BUCKETS];
+    uint64_t start_ticks;    // Calibration against the wall clock
+    double   start_seconds;
+} PhaseStats;
+
+extern const char* const phase_names[PHASES];
+extern const char* const histogram_names[HISTOGRAMS];
+
+static inline double phase_wall_seconds(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static inline uint64_t phase_ticks(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __builtin_ia32_rdtsc();
+#else
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+static inline uint32_t hist_bucket(uint64_t value) {
+    return value ? 64 - (uint32_t)__builtin_clzll(value) : 0;
+}
+
+#ifdef BSAT_PHASES
+#define PHASE_START(s, phase) uint64_t phase##_start = phase_ticks()
+#define PHASE_STOP(s, phase) \
+    do { \
+        (s)->phases.ticks[phase] += phase_ticks() - phase##_start; \
+        (s)->phases.calls[phase]++; \
+    } while (0)
+#define HIST_ADD(s, histogram, value) ((s)->phases.hist[histogram][hist_bucket(value)]++)
+#else
+#define PHASE_START(s, phase) ((void)0)
+#define PHASE_STOP(s, phase) ((void)0)
+#define HIST_ADD(s, histogram, value) ((void)0)
+#endif
+
+#endif // BSAT_PHASES_H
@@ -0,0 +1,104 @@
+/*********************************************************************
+ * BSAT Competition Solver - Portfolio Parallel Solving
+ *
+ * Runs several independently configured Solver instances on the same
+ * formula in parallel threads. Workers share unit and low-LBD learned
+ * clauses through a lock-free exchange, and the first worker that
+ * finds a definite answer (SAT/UNSAT) stops all the others.
+ *
+ * Exchange design:
+ * Every worker owns one single-producer ring of fixed-size slots.
+ * Publishing a clause writes the literals and then releases the slot
+ * stamp (seqlock style). Readers keep a private cursor per ring and
+ * validate the stamp before and after copying, so a slot overwritten
+ * by a fast producer is simply skipped. Nobody ever blocks.
+ *********************************************************************/
+
+#ifndef BSAT_PORTFOLIO_H
+#define BSAT_PORTFOLIO_H
+
+#include "solver.h"
+#include "dimacs.h"
+#include <stdatomic.h>
+
+/*********************************************************************
+ * Configuration Constants
+ *********************************************************************/
+
+// Largest clause that fits in an exchange slot (longer clauses are not shared)
+#define SHARE_MAX_SIZE 8
+
+// Default number of slots per worker ring (must be a power of two)
+#define SHARE_RING_SLOTS 4096
+
+// Maximum number of portfolio workers
+#define PORTFOLIO_MAX_THREADS 64
+
+// How often the driver checks for answers and the deadline
+#define PORTFOLIO_POLL_NSEC (5 * 1000 * 1000)  // 5 ms
+
+/*********************************************************************
+ * Clause Exchange
+ *********************************************************************/
+
+typedef struct ShareSlot {
+    _Atomic uint64_t stamp;                  // Sequence number + 1 once published
+    _Atomic uint32_t size;                   // Number of literals
+    _Atomic uint32_t lbd;                    // LBD reported by the producer
+    _Atomic uint32_t lits[SHARE_MAX_SIZE];   // Clause literals
+} CACHE_ALIGNED ShareSlot;
+
+typedef struct ShareRing {
+    ShareSlot*       slots;                  // Ring storage (num_slots entries)
+    _Atomic uint64_t head CACHE_ALIGNED;     // Next sequence number to publish
+} ShareRing;
+
+typedef struct ClauseExchange {
+    ShareRing*     rings;        // One ring per worker
+    uint32_t       num_rings;    // Number of workers
+    uint32_t       num_slots;    // Slots per ring (power of two)
+    uint32_t       max_lbd;      // Only clauses with LBD <= max_lbd are exported
+    atomic_bool    stop;         // Set once any worker has an answer (or on timeout)
+    atomic_int     winner;       // Id of the winning worker (-1 = none yet)
+} ClauseExchange;
+
+// Create an exchange for num_rings workers (num_slots rounded up to a power of two)
+ClauseExchange* exchange_new(uint32_t num_rings, uint32_t num_slots, uint32_t max_lbd);
+
+// Free exchange and all rings
+void exchange_free(ClauseExchange* ex);
+
+// Connect a solver to the exchange as worker 'id' (allocates read cursors)
+bool exchange_attach(ClauseExchange* ex, Solver* s, uint32_t id);
+
+// Publish a learned clause (unit or LBD <= max_lbd) from solver s
+void exchange_export(Solver* s, const Lit* lits, uint32_t size, uint32_t lbd);
+
+// Import all clauses published by other workers since the last call.
+// Must be called at decision level 0. Returns false if the solver became UNSAT.
+bool exchange_import(Solver* s);
+
+// Check whether the portfolio has asked this solver to stop
+static inline bool exchange_should_stop(const ClauseExchange* ex) {
+    return ex && atomic_load_explicit(&ex->stop, memory_order_relaxed);
+}
+
+/*********************************************************************
+ * Portfolio Driver
+ *********************************************************************/
+
+// Derive the options of worker 'id' from the user's base options.
+// Worker 0 always runs the base configuration unchanged (apart from the seed).
+SolverOpts portfolio_worker_opts(const SolverOpts* base, uint32_t id);
+
+// Short human-readable description of worker id's configuration
+const char* portfolio_worker_name(uint32_t id);
+
+// Solve the DIMACS file with num_threads workers (each parses the file itself).
+// On SAT/UNSAT, *winner receives the winning solver; otherwise it receives
+// the solver of worker 0. The caller frees it with solver_free.
+// *error receives the parse result. Returns TRUE/FALSE/UNDEF like solver_solve.
+lbool portfolio_solve(const SolverOpts* opts, const char* filename,
+                      uint32_t num_threads, Solver** winner, DimacsError* error);
+
+#endif // BSAT_PORTFOLIO_H
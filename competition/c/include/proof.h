@@ -0,0 +1,68 @@
+/*********************************************************************
+ * BSAT Competition Solver - DRAT Proof Writer
+ *
+ * Encodes clause additions and deletions in text or binary DRAT format
+ * into large user-space buffers.
+ *
+ * Binary format: 'a' or 'd', then each literal as the unsigned value
+ * 2 * var + sign in 7-bit groups (least significant first, high bit
+ * set on all but the last byte), and a terminating 0 byte.
+ *
+ * Writer design:
+ * Full buffers are handed to a background thread that does all the
+ * file I/O, so the CDCL loop only encodes into memory. It blocks only
+ * when every buffer is still waiting to be written (disk slower than
+ * the solver).
+ *********************************************************************/
+
+#ifndef BSAT_PROOF_H
+#define BSAT_PROOF_H
+
+#include "types.h"
+#include <stdio.h>
+
+/*********************************************************************
+ * Configuration Constants
+ *********************************************************************/
+
+// Size of one proof buffer
+#define PROOF_BUFFER_SIZE (4 << 20)
+
+// Number of buffers shared with the writer thread
+#define PROOF_BUFFERS 4
+
+// Room for the longest encoded literal (text: " -4294967295")
+#define PROOF_MAX_LIT_BYTES 12
+
+/*********************************************************************
+ * Proof Writer
+ *********************************************************************/
+
+typedef struct ProofStats {
+    uint64_t added;          // Clause additions logged
+    uint64_t deleted;        // Clause deletions logged
+    uint64_t bytes;          // Encoded proof bytes
+    double   write_time;     // Seconds in file writes (writer thread)
+    double   wait_time;      // Seconds the solver waited for a free buffer
+} ProofStats;
+
+typedef struct ProofWriter ProofWriter;
+
+// Open a proof file. With threaded = false the solver thread writes
+// full buffers itself. Returns NULL if the file cannot be opened.
+ProofWriter* proof_open(const char* path, bool binary, bool threaded);
+
+// Log a clause addition or deletion
+void proof_add(ProofWriter* p, const Lit* lits, uint32_t size);
+void proof_delete(ProofWriter* p, const Lit* lits, uint32_t size);
+
+// Hand everything logged so far to the file (does not wait for the write)
+void proof_flush(ProofWriter* p);
+
+// Write all pending data and close the file. Returns false on I/O errors.
+bool proof_close(ProofWriter* p);
+
+// Statistics so far
+ProofStats proof_stats(const ProofWriter* p);
+
+#endif // BSAT_PROOF_H
@@ -11,10 +11,17 @@
 #include "arena.h"
 #include "watch.h"
 #include "elim.h"
+#include "gauss.h"
+#include "subsume.h"
 #include "local_search.h"
+#include "proof.h"
+#include "phases.h"
 #include <time.h>
 #include <stdio.h>
 
+// Forward declaration (defined in portfolio.h)
+struct ClauseExchange;
+
 /*********************************************************************
  * Solver Options
  *********************************************************************/
@@ -24,14 +31,17 @@ typedef struct SolverOpts {
     uint32_t max_conflicts;      // Conflict limit (0 = unlimited)
     uint32_t max_decisions;      // Decision limit (0 = unlimited)
     double   max_time;           // Time limit in seconds (0 = unlimited)
+    uint64_t max_ticks;          // Effort limit in ticks, reproducible (0 = unlimited)
 
     // Branching heuristic
     bool     lrb;                // Use LRB/CHB instead of VSIDS (false)
+    bool     vmtf;               // Use the VMTF queue instead of VSIDS/LRB (false)
     double   var_decay;          // Variable activity decay for VSIDS (0.95)
     double   var_inc;            // Variable activity increment (1.0)
     double   clause_decay;       // Clause activity decay (0.999)
     double   lrb_step_min;       // Minimum step size for LRB (0.06)
     double   lrb_step_max;       // Maximum step size for LRB (0.4)
+    uint32_t seed;               // Random seed for phase/branching randomness (0)
 
     // Restart parameters
     uint32_t restart_first;      // First restart interval (100)
@@ -40,6 +50,16 @@ typedef struct SolverOpts {
     bool     luby_restart;       // Use Luby restart sequence (vs geometric/glucose)
     uint32_t luby_unit;          // Luby unit size (conflicts per Luby unit, default 512)
     uint32_t restart_postpone;   // Min trail growth to postpone restart (10%)
+    bool     restart_reuse;      // Keep the trail levels the heuristic would redo (true)
+
+    // Search modes: alternate focused search (VMTF, Glucose EMA restarts)
+    // and stable search (VSIDS, Luby restarts, target phases)
+    bool     modes;              // Switch between the modes (false)
+    uint32_t mode_interval;      // Conflicts of the first focused phase (1000)
+
+    // Backtracking policy
+    bool     chrono;             // Chronological backtracking on long jumps (true)
+    uint32_t chrono_threshold;   // Jumps over more levels go back one level (100; 0 = always)
 
     // Glucose EMA parameters (for --glucose-restart-ema)
     bool     glucose_use_ema;    // Use EMA (true) vs sliding window (false)
@@ -63,40 +83,61 @@ typedef struct SolverOpts {
     // Clause management
     uint32_t max_lbd;           // Max LBD for keeping learned clauses (30)
     uint32_t glue_lbd;          // LBD threshold for glue clauses (2)
-    double   reduce_fraction;   // Fraction of learned clauses to keep (0.5)
+    uint32_t tier2_lbd;         // LBD limit of the mid tier kept while used (6)
+    double   reduce_fraction;   // Fraction of unused candidates to keep (0.5)
     uint32_t reduce_interval;   // Conflicts between reductions (2000)
     bool     minimize;          // Enable clause minimization (true)
+    bool     shrink;            // Replace the literals of a level by their UIP (true)
 
     // Preprocessing
-    bool     bce;               // Enable blocked clause elimination (true)
+    bool     bce;               // Enable blocked clause elimination (false)
     bool     probing;           // Enable failed literal probing (true)
+    bool     gauss;             // Gauss-Jordan elimination on recovered XORs (false)
 
     // Bounded Variable Elimination (BVE) - SatELite-style preprocessing
     bool     elim;              // Enable BVE preprocessing (false - opt-in)
     uint32_t elim_max_occ;      // Max occurrences to consider for elimination (10)
     uint32_t elim_grow;         // Max clause growth allowed (0 = no growth)
+    uint32_t elim_threads;      // Resolution threads (0 = one per CPU)
 
     // DRAT Proof Logging
     const char* proof_path;     // Path to proof file (NULL = disabled)
     bool     binary_proof;      // Use binary DRAT format (false)
 
-    // Inprocessing
+    // Checkpoints of the search state (see checkpoint.h)
+    const char* checkpoint_path; // File rewritten at restarts (NULL = disabled)
+    double   checkpoint_interval; // Seconds between checkpoints (600)
+
+    // Portfolio workers
+    bool     pin_threads;       // Pin each worker to its own CPU (false)
+
+    // Inprocessing: each technique's budget is a per-mille share of the
+    // search propagations since its previous round
     bool     inprocess;         // Enable inprocessing (false)
-    uint32_t inprocess_interval; // Conflicts between inprocessing (10000)
+    uint32_t inprocess_interval; // Conflicts before the first round (10000)
+    uint32_t inprocess_probe;   // Probing share, in propagations (50)
+    uint32_t inprocess_subsume; // Subsumption share, in literal visits (200)
+    uint32_t inprocess_vivify;  // Vivification share, in propagations (100)
+    uint32_t inprocess_bce;     // BCE share, in literal visits (50)
+    uint32_t inprocess_elim;    // BVE share, in resolution pairs (50)
     bool     subsumption;       // Enable subsumption (true)
+    uint32_t subsume_effort;    // Literal visits per subsumption round (10000000)
     bool     var_elim;          // Enable variable elimination (true)
 
     // Local search hybridization
     bool     local_search;      // Enable local search (false - opt-in)
-    uint32_t ls_interval;       // Conflicts between local search calls (5000)
+    uint32_t ls_interval;       // Conflicts before the first local search call (5000)
     uint32_t ls_max_flips;      // Max flips per local search call (100000)
     double   ls_noise;          // Noise parameter for WalkSAT (0.5)
+    bool     ls_probsat;        // ProbSAT variable selection instead of WalkSAT (false)
+    double   ls_cb;             // ProbSAT break exponent (2.3)
 
     // Output options
     bool     verbose;           // Verbose output (false) - same as BSAT_VERBOSE
     bool     debug;             // Debug output (false) - same as DEBUG_CDCL
     bool     quiet;             // Suppress all output (false)
     bool     stats;             // Print statistics (true)
+    uint32_t report_interval;   // Conflicts between progress lines (0 = none)
 } SolverOpts;
 
 // Get default options
@@ -108,28 +149,103 @@ SolverOpts default_opts(void);
 #define IS_DEBUG(s) (g_debug)
 
 /*********************************************************************
- * Variable Information
+ * Inprocessing Schedule
+ *
+ * Techniques run at decision level 0 once their interval has passed.
+ * Intervals are search ticks; the base interval is the ticks the first
+ * opts.inprocess_interval conflicts took, when every technique has its
+ * first round. A round that simplifies the formula halves the interval
+ * (down to the base), a fruitless one doubles it (up to
+ * INPROCESS_MAX_SCALE times that).
  *********************************************************************/
 
-typedef struct VarInfo {
-    // VSIDS/LRB activity - first for 8-byte alignment and cache-friendly heap access
-    double   activity;       // Variable activity score
+#define INPROCESS_MAX_SCALE 64
+
+// Smallest effort budget of a round, so early rounds get work done
+#define INPROCESS_MIN_EFFORT 10000
+
+typedef enum InprocessTechnique {
+    INPROCESS_PROBE,
+    INPROCESS_SUBSUME,
+    INPROCESS_VIVIFY,
+    INPROCESS_BCE,
+    INPROCESS_ELIM,
+    INPROCESS_TECHNIQUES
+} InprocessTechnique;
+
+typedef struct InprocessSchedule {
+    uint64_t next;           // Search ticks at which the next round is due
+    uint64_t interval;       // Search ticks between rounds (0 = not started)
+    uint64_t last_props;     // Search propagations at the last round
+    uint64_t rounds;         // Rounds run
+    uint64_t productive;     // Rounds that simplified the formula
+    uint64_t effort;         // Budget handed out over all rounds
+    double   time;           // Seconds spent
+} InprocessSchedule;
 
-    // Core assignment state - most frequently accessed together
-    lbool    value;          // Current assignment (UNDEF/TRUE/FALSE)
-    Level    level;          // Decision level
-    CRef     reason;         // Reason clause (INVALID_CLAUSE for decisions)
-    uint32_t trail_pos;      // Position in trail
+/*********************************************************************
+ * Variable Information
+ *********************************************************************/
 
-    // Less frequently accessed
-    uint32_t last_polarity;  // Last conflict where polarity was saved
-    uint32_t heap_pos;       // Position in VSIDS heap
+// Cold per-variable state. The assignment (value, level, reason, trail
+// position) lives in separate Solver arrays so propagation only touches
+// the bytes it reads, and the branching scores live next to the heap.
+typedef struct VarInfo {
     uint64_t last_conflict;  // Last conflict where variable participated (for LRB)
+    uint32_t last_polarity;  // Last conflict where polarity was saved
 
     // Phase saving - 1 byte, naturally packs at end with padding
     bool     polarity;       // Saved polarity
+    bool     frozen;         // Never removed by preprocessing (incremental interface)
+    bool     in_matrix;      // Column of a Gauss-Jordan matrix (kept by BCE and BVE)
 } VarInfo;
 
+/*********************************************************************
+ * VMTF Queue Link
+ *
+ * Variables form a doubly linked list in the order they were last
+ * bumped; a bump moves the variable to the end and gives it a new,
+ * larger stamp.
+ *********************************************************************/
+
+typedef struct VmtfLink {
+    Var      prev;           // Bumped earlier (0 = none)
+    Var      next;           // Bumped later (0 = none)
+    uint64_t stamp;          // Bump time, increasing along the list
+} VmtfLink;
+
+// A variable bumped by conflict analysis, with its stamp before the bump
+typedef struct VmtfBump {
+    uint64_t stamp;
+    Var      var;
+} VmtfBump;
+
+// Per decision level facts about the learned clause being minimized
+typedef struct AnalyzeLevel {
+    uint32_t stamp;      // Analysis that last saw a literal on this level
+    uint32_t count;      // Clause literals on this level
+    uint32_t first;      // Earliest trail position among them
+    uint32_t last;       // Latest trail position among them
+    Lit      uip;        // Literal replacing them after shrinking, or LIT_UNDEF
+} AnalyzeLevel;
+
+// Depth-first search frame of the redundancy check
+typedef struct MinimizeFrame {
+    Var      var;
+    uint32_t next;       // Next reason literal to look at
+} MinimizeFrame;
+
+// Work done in one search mode
+typedef struct ModeStats {
+    uint64_t conflicts;
+    uint64_t decisions;
+    uint64_t propagations;
+    uint64_t ticks;
+    uint64_t restarts;
+    uint32_t phases;     // Phases spent in the mode
+    double   time;       // CPU seconds
+} ModeStats;
+
 /*********************************************************************
  * Trail Entry
  *********************************************************************/
@@ -146,6 +262,7 @@ typedef struct Trail {
 typedef struct Solver {
     // Problem size
     uint32_t num_vars;
+    uint32_t num_input_vars;  // Variables before the first XOR auxiliary (0 = none added)
     uint32_t var_capacity;    // Allocated capacity for variable arrays
     uint32_t num_clauses;
     uint32_t num_original;    // Number of original clauses
@@ -153,13 +270,20 @@ typedef struct Solver {
     // Core data structures
     Arena*        arena;       // Clause allocator
     WatchManager* watches;     // Watch lists
-    VarInfo*      vars;        // Variable information
+    VarInfo*      vars;        // Variable information (cold)
+
+    // Assignment, structure-of-arrays
+    uint8_t*  vals;           // lbool per literal: vals[lit] is the value of lit
+    Level*    levels;         // Decision level per variable
+    CRef*     reasons;        // Reason clause per variable (INVALID_CLAUSE for decisions)
+    uint32_t* trail_pos;      // Trail position per variable
 
     // Trail (assignment stack)
     Trail*   trail;           // Assignment trail
     uint32_t trail_size;      // Current trail size
     uint32_t trail_lim;       // Next decision position
-    uint32_t qhead;           // Propagation queue head
+    uint32_t qhead;           // Propagation queue head (long clauses)
+    uint32_t bin_qhead;       // Propagation queue head (binary implications)
     Level*   trail_lims;      // Decision level limits
     Level    decision_level;  // Current decision level
 
@@ -169,18 +293,57 @@ typedef struct Solver {
     CRef*    learnts;         // Learned clauses
     uint32_t learnts_size;    // Size of learned clause array
 
-    // VSIDS heap
+    // Learned clause reduction
     struct {
-        Var*     heap;        // Binary max-heap of variables
-        uint32_t size;        // Current heap size
-        double   var_inc;     // Activity increment
-        double   var_decay;   // Activity decay factor
+        double   clause_inc;  // Clause activity increment
+        CRef*    cands;       // Reduction candidates (scratch, grows with learnts)
+        uint32_t cands_size;  // Capacity of cands
+    } db;
+
+    // VSIDS heap, with dense activity and position arrays so that heap
+    // operations do not stride over VarInfo
+    struct {
+        Var*      heap;       // Binary max-heap of variables
+        double*   activity;   // Activity per variable
+        uint32_t* pos;        // Heap position per variable (UINT32_MAX = not in heap)
+        uint32_t  size;       // Current heap size
+        double    var_inc;    // Activity increment
+        double    var_decay;  // Activity decay factor
     } order;
 
+    // VMTF queue (opts.vmtf): variables are always linked, and search
+    // points at the last one that may be unassigned
+    struct {
+        VmtfLink* links;      // List links and stamp per variable
+        Var       first;      // Least recently bumped
+        Var       last;       // Most recently bumped
+        Var       search;     // Every variable after it is assigned
+        uint64_t  stamp;      // Last stamp handed out
+        VmtfBump* bumped;     // Variables bumped by the current analysis
+        uint32_t  num_bumped;
+    } queue;
+
+    // Search mode (opts.modes). The VSIDS heap and the VMTF queue are
+    // each updated only while their mode is active; the first phase is
+    // focused and lasts opts.mode_interval conflicts, later phases a
+    // search tick budget that doubles after each stable phase.
+    struct {
+        bool      vmtf;            // Decisions from the VMTF queue (opts.vmtf, or focused)
+        bool      stable;          // Current mode
+        uint64_t  budget;          // Search ticks per phase (0 = still in the first)
+        uint64_t  last_restart;    // Conflicts at the last restart (stable Luby)
+        uint32_t  luby_index;      // Stable restarts so far
+        ModeStats start;           // Totals when the current phase began
+        ModeStats stats[2];        // Finished phases: focused, stable
+    } mode;
+
     // Conflict analysis
-    uint8_t* seen;            // Seen flags for conflict analysis
-    Lit*     analyze_stack;   // Temporary stack for analysis
-    uint32_t analyze_toclear; // Number of seen variables to clear
+    uint8_t* seen;            // Seen flags for conflict analysis (SEEN_* marks in minimization)
+    MinimizeFrame* analyze_stack; // Redundancy check search stack
+    Var*     analyze_toclear; // Variables marked outside the learned clause
+    uint32_t num_toclear;
+    AnalyzeLevel* analyze_levels; // Indexed by decision level
+    uint32_t analyze_stamp;   // Current analysis (stamps analyze_levels)
     Lit      binary_conflict_lits[2]; // Literals from binary clause conflict
     Lit*     binary_reasons;  // binary_reasons[v] = other literal if propagated by binary, LIT_UNDEF otherwise
 
@@ -188,20 +351,46 @@ typedef struct Solver {
     struct {
         uint64_t decisions;
         uint64_t propagations;
+        uint64_t ticks;              // Deterministic effort (see solver.c)
         uint64_t conflicts;
         uint64_t restarts;
+        uint64_t reuse_restarts;     // Restarts that kept part of the trail
+        uint64_t reused_literals;    // Trail literals those restarts kept
+        uint64_t reused_propagations; // Implied literals among them (propagations avoided)
+        uint64_t chrono_backtracks;  // Conflicts that backtracked one level instead of jumping
         uint64_t reduces;
+        double   gc_time;            // Seconds in arena garbage collection
+        double   gc_max_time;        // Longest collection pause
+        double   reduce_time;        // Seconds in clause database reduction (incl. GC)
+        double   reduce_max_time;    // Longest single reduction
+        uint32_t tier_core;          // Tier sizes after the last reduction
+        uint32_t tier_mid;
+        uint32_t tier_local;
         uint64_t learned_clauses;
         uint64_t learned_literals;
         uint64_t deleted_clauses;
         uint64_t subsumed_clauses;   // Clauses removed by on-the-fly subsumption
+        uint64_t subsume_rounds;     // Occurrence-list subsumption rounds
+        uint64_t subsume_removed;    // Clauses removed by those rounds
+        uint64_t subsume_strengthened; // Clauses strengthened by self-subsumption
+        double   subsume_time;       // Seconds in subsumption rounds
         uint64_t minimized_literals; // Literals removed by clause minimization
+        uint64_t shrunk_literals;    // Literals removed by shrinking
         uint64_t blocked_clauses;    // Clauses removed by blocked clause elimination
+        uint64_t gauss_propagations; // Literals implied by the XOR matrices
+        uint64_t gauss_conflicts;    // Conflicts found by them
+        uint64_t gauss_pivots;       // Basic column swaps
         uint64_t max_lbd;
         uint64_t glue_clauses;
+        uint64_t reports;            // Progress lines printed (--report-interval)
         double   start_time;
     } stats;
 
+#ifdef BSAT_PHASES
+    // Phase timers and histograms (see phases.h)
+    PhaseStats phases;
+#endif
+
     // Restart state
     struct {
         uint32_t conflicts_since;     // Conflicts since last restart
@@ -228,8 +417,11 @@ typedef struct Solver {
     // Variable Elimination (BVE)
     ElimState* elim;          // Elimination state (NULL if not using BVE)
 
+    // Gauss-Jordan elimination
+    GaussState* gauss;        // XOR matrices (NULL if none were built)
+
     // DRAT Proof Logging
-    FILE* proof_file;         // Proof output file (NULL if not logging)
+    ProofWriter* proof;       // Proof writer (NULL if not logging)
 
     // Rephasing state (Kissat-style target phases)
     struct {
@@ -242,15 +434,91 @@ typedef struct Solver {
     // Local search state
     struct {
         LocalSearchState* state;      // Local search state (NULL until first use)
-        uint64_t conflicts_since;     // Conflicts since last local search
+        uint64_t conflicts_since;     // Conflicts before the first call
+        uint64_t interval;            // Search ticks between calls (0 = no call yet)
+        uint64_t next;                // Search ticks at which the next call is due
         uint32_t calls;               // Number of local search calls
         uint32_t successes;           // Number of successful local search calls
     } local_search;
 
+    // Inprocessing state (kept per solver so several instances can coexist)
+    struct {
+        InprocessSchedule sched[INPROCESS_TECHNIQUES];
+        uint64_t props;               // Propagations made by inprocessing
+        uint64_t ticks;               // Ticks spent by inprocessing
+        uint64_t base;                // Base interval in search ticks (0 = not measured)
+        uint32_t vivify_cursor;       // Next learned clause to vivify
+        Var      probe_cursor;        // Next variable to probe
+    } inprocess;
+
+    // Random number generator state (seeded from opts.seed)
+    uint64_t rng;
+
+    // Portfolio clause sharing (exchange is NULL when solving alone)
+    struct {
+        struct ClauseExchange* exchange; // Shared exchange (owned by the portfolio)
+        uint32_t  id;                 // This solver's ring in the exchange
+        uint64_t* cursors;            // Next sequence number to read from each ring
+        uint64_t  exported;           // Clauses published to other workers
+        uint64_t  imported;           // Clauses received from other workers
+        uint64_t  imported_units;     // Received clauses that became level-0 units
+    } share;
+
+    // Checkpoints (opts.checkpoint_path), written by plain solve calls
+    // only: assumptions and portfolio sharing live outside the solver
+    struct {
+        bool     active;              // This solve call writes checkpoints
+        double   last;                // Wall time of the last one (or of the call)
+        uint32_t written;             // Checkpoints written
+        double   time;                // Seconds spent writing them
+        uint64_t input_size;          // Fingerprint of the input they belong
+        uint64_t input_hash;          // to (CheckpointInput, set by the caller)
+    } checkpoint;
+
+    // Incremental solving state (kept across solve calls)
+    struct {
+        bool     preprocessed;        // BCE/probing/BVE already ran (first call only)
+        uint32_t solves;              // Number of solve calls
+        lbool*   model;               // Assignment of the last SAT answer
+        uint32_t model_size;          // Variables covered by model
+        Lit*     conflict;            // Final conflict: negations of failed assumptions
+        uint32_t conflict_size;       // Number of literals in conflict
+        uint32_t conflict_capacity;   // Allocated size of conflict
+    } incremental;
+
     // Result
-    lbool result;             // SAT/UNSAT/UNKNOWN
+    lbool result;             // TRUE = last answer SAT, FALSE = formula UNSAT (final)
 } Solver;
 
+/*********************************************************************
+ * Assignment Access
+ *
+ * vals[] is indexed by literal, so testing a watched or implied literal
+ * is one byte load with no sign branch.
+ *********************************************************************/
+
+// Value of a literal
+static inline lbool lit_value(const Solver* s, Lit lit) {
+    return (lbool)s->vals[lit];
+}
+
+// Value of a variable (of its positive literal)
+static inline lbool var_value(const Solver* s, Var v) {
+    return (lbool)s->vals[mkLit(v, false)];
+}
+
+// Make lit true (does not touch the trail)
+static inline void assign_lit(Solver* s, Lit lit) {
+    s->vals[lit] = TRUE;
+    s->vals[neg(lit)] = FALSE;
+}
+
+// Clear the value of a variable
+static inline void unassign_var(Solver* s, Var v) {
+    s->vals[mkLit(v, false)] = UNDEF;
+    s->vals[mkLit(v, true)] = UNDEF;
+}
+
 /*********************************************************************
  * Solver API
  *********************************************************************/
@@ -264,27 +532,64 @@ Solver* solver_new_with_opts(const SolverOpts* opts);
 // Free solver and all resources
 void solver_free(Solver* s);
 
+// Return the solver to the state of solver_new_with_opts(opts), but keep
+// the capacity of its variable arrays, clause arena and watch lists so
+// that the next formula of similar size allocates nothing.
+// Returns false on allocation failure (the solver can still be freed).
+bool solver_reset(Solver* s, const SolverOpts* opts);
+
 // Add a variable (returns variable index)
 Var solver_new_var(Solver* s);
 
+// Pre-size variable arrays and the clause list (e.g. from a DIMACS header)
+// so that adding up to these counts does not reallocate
+bool solver_reserve(Solver* s, uint32_t num_vars, uint32_t num_clauses);
+
 // Add a clause
 bool solver_add_clause(Solver* s, const Lit* lits, uint32_t size);
 
+// Add the XOR of the literals (true when an odd number of them is true).
+// XORs over more than GAUSS_MAX_XOR_SIZE variables are cut with fresh
+// variables after the existing ones; solver_input_vars then leaves them
+// out, so create every variable of the problem first.
+bool solver_add_xor(Solver* s, const Lit* lits, uint32_t size);
+
+// Variables of the problem, without XOR auxiliaries
+static inline uint32_t solver_input_vars(const Solver* s) {
+    return s->num_input_vars ? s->num_input_vars : s->num_vars;
+}
+
 // Main solve function
 lbool solver_solve(Solver* s);
 
-// Solve with assumptions
+// Solve with assumptions (MiniSat-style). Can be called repeatedly: learned
+// clauses, activities and phases are kept, clauses may be added in between,
+// and preprocessing only runs on the first call. FALSE under assumptions
+// leaves the formula usable; solver_conflict then gives the failed subset.
 lbool solver_solve_with_assumptions(Solver* s, const Lit* assumps, uint32_t n_assumps);
 
+// Exclude (or re-admit) a variable from preprocessing. Freeze every variable
+// that later clauses or assumptions will mention before the first solve;
+// the first call's assumption variables are frozen automatically.
+void solver_set_frozen(Solver* s, Var v, bool frozen);
+
+// Check whether a variable is frozen
+bool solver_is_frozen(const Solver* s, Var v);
+
 // Get variable value in model
 lbool solver_model_value(const Solver* s, Var v);
 
-// Get conflict clause (for UNSAT)
+// Final conflict of the last UNSAT answer: a clause over the negations of
+// the assumptions that were needed (empty if the formula itself is UNSAT)
 const Lit* solver_conflict(const Solver* s, uint32_t* size);
 
 // Print statistics
 void solver_print_stats(const Solver* s);
 
+// Write the statistics as a JSON object (phase times and histograms
+// only in builds with BSAT_PHASES)
+void solver_write_stats_json(const Solver* s, FILE* out);
+
 /*********************************************************************
  * Internal Functions (for testing/debugging)
  *********************************************************************/
@@ -301,13 +606,34 @@ bool solver_decide(Solver* s);
 // Backtrack to level
 void solver_backtrack(Solver* s, Level level);
 
+// Open a new decision level with lit and propagate (false on conflict)
+bool solver_decide_literal(Solver* s, Lit lit);
+
+// Open a new decision level with lit without propagating
+void solver_new_decision(Solver* s, Lit lit);
+
+// Probe lit one level above the current one and undo it again.
+// Returns false if lit fails; *implied (optional) receives the number of
+// literals the probe assigned (lookahead measure)
+bool solver_probe(Solver* s, Lit lit, uint32_t* implied);
+
 // Reduce learned clause database
 void solver_reduce_db(Solver* s);
 
+// Rebuild the decision order from the activities and VMTF stamps, e.g.
+// after they were restored from a checkpoint
+void solver_rebuild_order(Solver* s);
+
 // Check if should restart
 bool solver_should_restart(Solver* s);
 
-// Simplify clause database
+// Run the inprocessing techniques that are due (at decision level 0).
+// Returns false if the formula was found UNSAT.
 bool solver_simplify(Solver* s);
 
+// Add a clause learned elsewhere (e.g. by another portfolio worker).
+// Must be called at decision level 0. The clause is simplified against the
+// level-0 assignment; returns false if it is falsified (solver becomes UNSAT).
+bool solver_import_clause(Solver* s, const Lit* lits, uint32_t size, uint32_t lbd);
+
 #endif // BSAT_SOLVER_H
\ No newline at end of file
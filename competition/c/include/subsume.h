@@ -0,0 +1,35 @@
+/*********************************************************************
+ * BSAT Competition Solver - Backward Subsumption and Strengthening
+ *
+ * Occurrence-list pass over the irredundant clauses and the tier-2
+ * learned clauses (LBD <= tier2_lbd), run at decision level 0.
+ *
+ * Every clause C, binary clauses first and then by increasing size, is
+ * tried as a subsumer: the occurrences of the literal l of C whose
+ * variable occurs least are scanned (both l and ¬l), and a clause D
+ * passing the signature filter sig(C) & ~sig(D) == 0 is
+ *   - deleted if C ⊆ D (backward subsumption), or
+ *   - strengthened to D \ {¬k} if C \ {k} ∪ {¬k} ⊆ D (self-subsuming
+ *     resolution); the shorter D is queued as a subsumer again.
+ * A learned clause that subsumes an irredundant one becomes irredundant.
+ *
+ * Work is bounded by an effort budget counted in visited occurrence
+ * entries and clause literals, so a round cannot stall the search.
+ *********************************************************************/
+
+#ifndef BSAT_SUBSUME_H
+#define BSAT_SUBSUME_H
+
+#include "types.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// Forward declaration
+struct Solver;
+
+// Run one round visiting at most effort literals. Must be called at
+// decision level 0. Returns false if the formula was found UNSAT
+// (s->result is then FALSE).
+bool subsume_run(struct Solver* s, uint64_t effort);
+
+#endif // BSAT_SUBSUME_H
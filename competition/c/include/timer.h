@@ -0,0 +1,20 @@
+/*********************************************************************
+ * BSAT Competition Solver - Wall-Clock Timer
+ *
+ * Monotonic seconds for timing work that may run on several threads
+ * (clock() would sum the CPU time of all of them). Needs clock_gettime,
+ * so the including file defines _POSIX_C_SOURCE.
+ *********************************************************************/
+
+#ifndef BSAT_TIMER_H
+#define BSAT_TIMER_H
+
+#include <time.h>
+
+static inline double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+#endif // BSAT_TIMER_H
@@ -75,8 +75,7 @@ typedef enum {
     CLAUSE_ORIGINAL = 0,     // Original problem clause
     CLAUSE_LEARNED = 1,      // Learned during search
     CLAUSE_DELETED = 2,      // Marked for deletion
-    CLAUSE_GLUE = 4,         // Glue clause (LBD <= 2)
-    CLAUSE_FROZEN = 8        // Protected from deletion
+    CLAUSE_MOVED = 4         // Copied by garbage collection (header holds new CRef)
 } ClauseFlags;
 
 /*********************************************************************
@@ -165,4 +164,41 @@ static inline lbool lxor(lbool a, bool b) {
 #define ASSERT(cond) assert(cond)
 #endif
 
+/*********************************************************************
+ * Pseudo-Random Numbers
+ *
+ * xorshift64* generator with per-instance state. Each solver (and each
+ * portfolio thread) owns its own state, so runs are reproducible from
+ * the seed and no global rand() state is shared between threads.
+ *********************************************************************/
+
+// Initialize generator state from a seed (splitmix64 scramble, never zero)
+static inline uint64_t rng_seed(uint64_t seed) {
+    uint64_t z = seed + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    return z ? z : 0x9E3779B97F4A7C15ULL;
+}
+
+// Next 64-bit random value
+static inline uint64_t rng_next(uint64_t* state) {
+    uint64_t x = *state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *state = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+// Uniform double in [0, 1)
+static inline double rng_double(uint64_t* state) {
+    return (double)(rng_next(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// Uniform integer in [0, n) (n > 0)
+static inline uint32_t rng_below(uint64_t* state, uint32_t n) {
+    return (uint32_t)(((rng_next(state) >> 32) * (uint64_t)n) >> 32);
+}
+
 #endif // BSAT_TYPES_H
\ No newline at end of file
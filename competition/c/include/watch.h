@@ -3,6 +3,11 @@
  *
  * Efficient implementation of the two-watched literal scheme for
  * unit propagation. Uses blocking literals for cache optimization.
+ *
+ * Binary clauses are not watched: each literal has a separate compact
+ * implication list holding the other literal of every binary clause it
+ * occurs in (4 bytes per entry). Propagation scans these lists before
+ * any long-clause watch is touched.
  *********************************************************************/
 
 #ifndef BSAT_WATCH_H
@@ -36,6 +41,47 @@ typedef struct WatchList {
     uint32_t capacity;    // Allocated capacity
 } WatchList;
 
+/*********************************************************************
+ * Binary Implication List
+ *
+ * For literal l, the other literals of all binary clauses (l ∨ x).
+ * When l becomes false, every x is implied.
+ *********************************************************************/
+
+typedef struct BinList {
+    Lit*     lits;        // Other literal of each binary clause
+    uint32_t size;        // Current number of entries
+    uint32_t capacity;    // Allocated capacity
+} BinList;
+
+/*********************************************************************
+ * Watch Slab
+ *
+ * The arrays of all watch and implication lists come from one slab
+ * instead of a malloc each. Blocks have power-of-two size classes and
+ * are carved from 1 MB chunks in the order lists first grow, so the
+ * lists of neighbouring literals share cache lines and pages instead of
+ * being scattered between allocator headers. A list that outgrows its
+ * block leaves it on the free list of its class for the next list of
+ * that size. Arrays beyond the largest class are malloc'd.
+ *********************************************************************/
+
+#define WATCH_SLAB_MIN_BYTES   16                // Smallest block (class 0)
+#define WATCH_SLAB_CLASSES     13                // Largest block: 64 KB
+#define WATCH_SLAB_MAX_BYTES   ((size_t)WATCH_SLAB_MIN_BYTES << (WATCH_SLAB_CLASSES - 1))
+#define WATCH_SLAB_CHUNK_BYTES (1024 * 1024)
+
+typedef struct WatchSlab {
+    char**   chunks;          // Chunks blocks are carved from
+    uint32_t num_chunks;
+    uint32_t chunks_capacity;
+    char*    next;            // Uncarved tail of the last chunk
+    size_t   left;
+    void*    free_blocks[WATCH_SLAB_CLASSES];  // Linked through their first word
+    size_t   free_bytes;      // Bytes on the free lists
+    size_t   large_bytes;     // Arrays beyond the largest class
+} WatchSlab;
+
 /*********************************************************************
  * Watch Manager
  *
@@ -43,11 +89,14 @@ typedef struct WatchList {
  *********************************************************************/
 
 typedef struct WatchManager {
-    WatchList* lists;     // Array of watch lists (2 * num_vars)
+    WatchList* lists;     // Array of long-clause watch lists (2 * num_vars)
+    BinList*   bins;      // Array of binary implication lists (2 * num_vars)
+    WatchSlab  slab;      // Storage of the list arrays
     uint32_t   num_vars;  // Number of variables
     uint64_t   updates;   // Statistics: watch updates
-    uint64_t   visits;    // Statistics: clause visits
+    uint64_t   visits;    // Statistics: long watches examined
     uint64_t   skipped;   // Statistics: skipped by blocker
+    uint64_t   binary_visits;  // Statistics: binary implications examined
 } WatchManager;
 
 /*********************************************************************
@@ -73,34 +122,26 @@ void watch_add(WatchManager* wm, Lit lit, CRef cref, Lit blocker);
 // Remove all watches for a clause (when deleting clause)
 void watch_remove_clause(WatchManager* wm, Arena* arena, CRef cref);
 
+// Add binary clause (a ∨ b) to the implication lists of both literals
+void watch_add_binary(WatchManager* wm, Lit a, Lit b);
+
+// Remove binary clause (a ∨ b); returns false if it was not present
+bool watch_remove_binary(WatchManager* wm, Lit a, Lit b);
+
 // Get watch list for a literal
 static inline WatchList* watch_list(WatchManager* wm, Lit lit) {
     return &wm->lists[toInt(lit)];
 }
 
+// Get binary implication list for a literal
+static inline BinList* bin_list(WatchManager* wm, Lit lit) {
+    return &wm->bins[toInt(lit)];
+}
+
 /*********************************************************************
  * Watch List Operations
  *********************************************************************/
 
-// Ensure watch list has capacity for at least one more watch
-static inline bool watchlist_ensure_capacity(WatchList* wl) {
-    if (wl->size >= wl->capacity) {
-        uint32_t new_cap = wl->capacity ? wl->capacity * 2 : 16;
-        Watch* new_watches = (Watch*)realloc(wl->watches, new_cap * sizeof(Watch));
-        if (!new_watches) return false;
-        wl->watches = new_watches;
-        wl->capacity = new_cap;
-    }
-    return true;
-}
-
-// Add a watch to a watch list
-static inline void watchlist_push(WatchList* wl, Watch w) {
-    if (watchlist_ensure_capacity(wl)) {
-        wl->watches[wl->size++] = w;
-    }
-}
-
 // Remove watch at index i (swap with last and shrink)
 static inline void watchlist_remove(WatchList* wl, uint32_t i) {
     ASSERT(i < wl->size);
@@ -112,40 +153,23 @@ static inline void watchlist_clear(WatchList* wl) {
     wl->size = 0;
 }
 
-/*********************************************************************
- * Binary Clause Optimization
- *
- * Binary clauses don't need full watch structure.
- * Store them implicitly in watch lists for faster propagation.
- *********************************************************************/
-
-// Check if watch represents a binary clause
-static inline bool is_binary_watch(Watch w) {
-    return w.cref == INVALID_CLAUSE;
-}
-
-// Create binary watch (cref = INVALID_CLAUSE, blocker = other literal)
-static inline Watch make_binary_watch(Lit other) {
-    return (Watch){INVALID_CLAUSE, other};
-}
-
-// Get the implied literal from binary watch
-static inline Lit binary_other(Watch w) {
-    ASSERT(is_binary_watch(w));
-    return w.blocker;
-}
-
 /*********************************************************************
  * Watch Statistics
  *********************************************************************/
 
 typedef struct {
-    uint64_t total_watches;   // Total number of watches
-    uint64_t binary_watches;  // Number of binary clause watches
+    uint64_t total_watches;   // Long-clause watches plus binary entries
+    uint64_t long_watches;    // Number of long-clause watches
+    uint64_t binary_watches;  // Number of binary implication entries (2 per clause)
+    uint64_t binary_clauses;  // Number of binary clauses
     uint64_t updates;         // Total watch updates
-    uint64_t visits;          // Total clause visits
+    uint64_t visits;          // Long watches examined
     uint64_t skipped;         // Clauses skipped by blocker
+    uint64_t binary_visits;   // Binary implications examined
     double   skip_rate;       // Percentage of skipped visits
+    size_t   slab_bytes;      // Chunk memory of the slab
+    size_t   slab_free_bytes; // Part of it on the free lists
+    size_t   large_bytes;     // Lists malloc'd outside the slab
 } WatchStats;
 
 WatchStats watch_stats(const WatchManager* wm);
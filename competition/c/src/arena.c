@@ -2,9 +2,14 @@
  * BSAT Competition Solver - Arena Memory Allocator Implementation
  *********************************************************************/
 
+#define _GNU_SOURCE  // mremap, MAP_ANONYMOUS, MADV_HUGEPAGE
+
 #include "../include/arena.h"
 #include <stdio.h>
 #include <string.h>
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
 
 // Initial capacity in uint32_t units (16MB)
 #define INITIAL_CAPACITY (4 * 1024 * 1024)
@@ -12,17 +17,87 @@
 // Growth factor when expanding arena
 #define GROWTH_FACTOR 1.5
 
+// Blocks from this size on are mapped directly (one huge page)
+#define MAP_MIN_BYTES (2 * 1024 * 1024)
+
+/*********************************************************************
+ * Memory Backend
+ *
+ * On Linux, arenas of a huge page and more are mapped directly rather
+ * than taken from malloc. The mapping is advised for transparent huge
+ * pages, which cuts the TLB misses of propagation's scattered clause
+ * visits, and grows with mremap, which moves page table entries instead
+ * of copying the clauses. Pages are only backed when first touched, so
+ * each portfolio worker's arena lands on the NUMA node of the thread
+ * that builds it. Smaller arenas and other systems use malloc/realloc.
+ *********************************************************************/
+
+#ifdef __linux__
+
+static uint32_t* memory_map(Arena* arena, size_t bytes) {
+    void* memory = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) return NULL;
+#ifdef MADV_HUGEPAGE
+    arena->huge_pages = madvise(memory, bytes, MADV_HUGEPAGE) == 0;
+#endif
+    return (uint32_t*)memory;
+}
+
+#endif
+
+// New block for arena->memory (which keeps its first `used` words);
+// the old block is released on success and kept on failure
+static uint32_t* memory_resize(Arena* arena, size_t new_capacity, size_t used) {
+    size_t old_bytes = arena->capacity * sizeof(uint32_t);
+    size_t new_bytes = new_capacity * sizeof(uint32_t);
+#ifdef __linux__
+    if (arena->mapped) {
+        void* memory = mremap(arena->memory, old_bytes, new_bytes, MREMAP_MAYMOVE);
+        if (memory == MAP_FAILED) return NULL;
+#ifdef MADV_HUGEPAGE
+        if (arena->huge_pages) madvise(memory, new_bytes, MADV_HUGEPAGE);
+#endif
+        return (uint32_t*)memory;
+    }
+    if (new_bytes >= MAP_MIN_BYTES) {
+        uint32_t* memory = memory_map(arena, new_bytes);
+        if (!memory) return NULL;
+        if (arena->memory) {
+            memcpy(memory, arena->memory, used * sizeof(uint32_t));
+            free(arena->memory);
+        }
+        arena->mapped = true;
+        return memory;
+    }
+#else
+    (void)old_bytes;
+    (void)used;
+#endif
+    return (uint32_t*)realloc(arena->memory, new_bytes);
+}
+
+static void memory_release(Arena* arena) {
+#ifdef __linux__
+    if (arena->mapped) {
+        munmap(arena->memory, arena->capacity * sizeof(uint32_t));
+        return;
+    }
+#endif
+    free(arena->memory);
+}
+
 /*********************************************************************
  * Arena Management
  *********************************************************************/
 
 size_t estimate_arena_size(uint32_t num_clauses, uint32_t num_vars) {
     // Estimate space needed:
-    // - ClauseHeader: 3 words (12 bytes for size/flags/lbd + 4 bytes for activity)
+    // - ClauseHeader: 2 words (size/flags, lbd/used), plus 1 word of
+    //   activity for learned clauses
     // - Average literals per clause: assume 3 for 3-SAT
-    // So each clause needs ~6 words on average
+    // So each clause needs ~5 words on average
 
-    size_t clause_space = (size_t)num_clauses * 6;
+    size_t clause_space = (size_t)num_clauses * 5;
 
     // Learned clauses: assume we'll learn 50% as many as original
     size_t learned_space = clause_space / 2;
@@ -55,7 +130,11 @@ Arena* arena_init(size_t initial_capacity) {
         initial_capacity = INITIAL_CAPACITY;
     }
 
-    arena->memory = (uint32_t*)malloc(initial_capacity * sizeof(uint32_t));
+    arena->memory = NULL;
+    arena->capacity = 0;
+    arena->mapped = false;
+    arena->huge_pages = false;
+    arena->memory = memory_resize(arena, initial_capacity, 0);
     if (!arena->memory) {
         free(arena);
         return NULL;
@@ -66,6 +145,16 @@ Arena* arena_init(size_t initial_capacity) {
     arena->wasted = 0;
     arena->num_growths = 0;
     arena->peak_size = 1;
+    arena->num_clauses = 0;
+    arena->tenured = 1;
+    arena->tenured_wasted = 0;
+    arena->num_collections = 0;
+    arena->num_major = 0;
+    arena->to_space = NULL;
+    arena->to_size = 0;
+    arena->to_capacity = 0;
+    arena->gc_base = 1;
+    arena->gc_tenured = 1;
 
     // Initialize first word to prevent CRef 0 from being valid
     arena->memory[0] = 0;
@@ -75,11 +164,27 @@ Arena* arena_init(size_t initial_capacity) {
 
 void arena_free(Arena* arena) {
     if (arena) {
-        free(arena->memory);
+        free(arena->to_space);
+        memory_release(arena);
         free(arena);
     }
 }
 
+void arena_clear(Arena* arena) {
+    arena->size = 1;
+    arena->wasted = 0;
+    arena->num_growths = 0;
+    arena->peak_size = 1;
+    arena->num_clauses = 0;
+    arena->tenured = 1;
+    arena->tenured_wasted = 0;
+    arena->num_collections = 0;
+    arena->num_major = 0;
+    arena->to_size = 0;
+    arena->gc_base = 1;
+    arena->gc_tenured = 1;
+}
+
 /*********************************************************************
  * Allocation
  *********************************************************************/
@@ -96,9 +201,7 @@ static bool arena_grow(Arena* arena, size_t needed) {
         }
     }
 
-    // Reallocate memory
-    uint32_t* new_memory = (uint32_t*)realloc(arena->memory,
-                                               new_capacity * sizeof(uint32_t));
+    uint32_t* new_memory = memory_resize(arena, new_capacity, arena->size);
     if (!new_memory) {
         return false;  // Out of memory
     }
@@ -138,9 +241,7 @@ bool arena_reserve(Arena* arena, size_t min_capacity) {
         }
     }
 
-    // Reallocate memory
-    uint32_t* new_memory = (uint32_t*)realloc(arena->memory,
-                                               new_capacity * sizeof(uint32_t));
+    uint32_t* new_memory = memory_resize(arena, new_capacity, arena->size);
     if (!new_memory) {
         return false;  // Out of memory
     }
@@ -162,10 +263,15 @@ bool arena_reserve(Arena* arena, size_t min_capacity) {
     return true;
 }
 
+// Words taken by a clause, activity included
+static inline size_t clause_words(const ClauseHeader* header) {
+    return (header->flags & CLAUSE_LEARNED ? ACTIVITY_WORDS : 0) + HEADER_WORDS + header->size;
+}
+
 CRef arena_alloc(Arena* arena, const Lit* lits, uint32_t size, bool learned) {
     // Calculate space needed
-    size_t header_words = (sizeof(ClauseHeader) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
-    size_t total_words = header_words + size;
+    size_t activity_words = learned ? ACTIVITY_WORDS : 0;
+    size_t total_words = activity_words + HEADER_WORDS + size;
 
     // Ensure we have enough space
     if (arena->size + total_words > arena->capacity) {
@@ -174,15 +280,16 @@ CRef arena_alloc(Arena* arena, const Lit* lits, uint32_t size, bool learned) {
         }
     }
 
-    // Allocate at current position
-    CRef cref = arena->size;
+    // Allocate at current position, past the activity word
+    CRef cref = (CRef)(arena->size + activity_words);
 
     // Initialize clause header
     ClauseHeader* header = CLAUSE_HEADER(arena, cref);
     header->size = size;
     header->flags = learned ? CLAUSE_LEARNED : CLAUSE_ORIGINAL;
     header->lbd = 0;
-    header->activity = 0.0f;
+    header->used = 0;
+    if (learned) *CLAUSE_ACTIVITY(arena, cref) = 0.0f;
 
     // Copy literals
     Lit* dest = CLAUSE_LITS(arena, cref);
@@ -190,6 +297,7 @@ CRef arena_alloc(Arena* arena, const Lit* lits, uint32_t size, bool learned) {
 
     // Update arena size
     arena->size += total_words;
+    arena->num_clauses++;
 
     // Track peak size
     if (arena->size > arena->peak_size) {
@@ -203,6 +311,15 @@ CRef arena_alloc(Arena* arena, const Lit* lits, uint32_t size, bool learned) {
  * Deletion and Garbage Collection
  *********************************************************************/
 
+// A moved clause keeps its new CRef in place of lbd and used
+#define CLAUSE_FORWARD(arena, cref) ((arena)->memory[(cref) + 1])
+
+// Deleted and shrunk space is wasted until the next collection
+static inline void add_waste(Arena* arena, CRef cref, size_t words) {
+    arena->wasted += words;
+    if (cref < arena->tenured) arena->tenured_wasted += words;
+}
+
 void arena_delete(Arena* arena, CRef cref) {
     if (cref == INVALID_CLAUSE) return;
 
@@ -210,90 +327,89 @@ void arena_delete(Arena* arena, CRef cref) {
     if (header->flags & CLAUSE_DELETED) return;  // Already deleted
 
     header->flags |= CLAUSE_DELETED;
-
-    // Track wasted space
-    size_t header_words = (sizeof(ClauseHeader) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
-    arena->wasted += header_words + header->size;
+    arena->num_clauses--;
+    add_waste(arena, cref, clause_words(header));
 }
 
-// Helper to relocate a clause during GC
-static CRef relocate_clause(uint32_t* dest, uint32_t* src, CRef old_cref) {
-    ClauseHeader* header = (ClauseHeader*)src;
-    size_t header_words = (sizeof(ClauseHeader) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
-    size_t total_words = header_words + header->size;
-
-    // Copy entire clause
-    memcpy(dest, src, total_words * sizeof(uint32_t));
+void arena_promote(Arena* arena, CRef cref) {
+    ClauseHeader* header = CLAUSE_HEADER(arena, cref);
+    if (!(header->flags & CLAUSE_LEARNED)) return;
 
-    // Return new location
-    return (CRef)(dest - ((Arena*)NULL)->memory);  // Offset from start
+    header->flags &= ~CLAUSE_LEARNED;
+    add_waste(arena, cref, ACTIVITY_WORDS);
 }
 
-void arena_gc(Arena* arena, CRef** watches, uint32_t num_watches,
-              CRef* clauses, uint32_t* num_clauses) {
-
-    // Only GC if wasted space is significant (>25% of used space)
-    if (arena->wasted * 4 < arena->size) {
-        return;
-    }
-
-    // Create relocation map
-    CRef* reloc = (CRef*)calloc(arena->size, sizeof(CRef));
-    if (!reloc) return;  // Can't GC without map
+void arena_shrink(Arena* arena, CRef cref, uint32_t new_size) {
+    ClauseHeader* header = CLAUSE_HEADER(arena, cref);
+    if (new_size >= header->size) return;
 
-    // Compact arena
-    uint32_t dest = 1;  // Start after reserved index
-    uint32_t src = 1;
+    add_waste(arena, cref, header->size - new_size);
+    header->size = new_size;
+}
 
-    while (src < arena->size) {
-        ClauseHeader* header = (ClauseHeader*)&arena->memory[src];
-        size_t header_words = (sizeof(ClauseHeader) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
-        size_t total_words = header_words + header->size;
+bool arena_gc_begin(Arena* arena) {
+    // Major collection once the tenured region has decayed
+    bool major = arena->tenured == 1 || arena->tenured_wasted * 4 >= arena->tenured;
+    arena->gc_base = major ? 1 : arena->tenured;
+
+    size_t live = (arena->size - arena->gc_base) - (arena->wasted - (major ? 0 : arena->tenured_wasted));
+    size_t capacity = live > 0 ? live : 1;
+    arena->to_space = (uint32_t*)malloc(capacity * sizeof(uint32_t));
+    if (!arena->to_space) return false;  // Keep running with the fragmented arena
+
+    arena->to_size = 0;
+    arena->to_capacity = capacity;
+    arena->gc_tenured = arena->gc_base;
+    arena->num_collections++;
+    if (major) arena->num_major++;
+    return true;
+}
 
-        if (!(header->flags & CLAUSE_DELETED)) {
-            // Relocate active clause
-            if (dest != src) {
-                memmove(&arena->memory[dest], &arena->memory[src],
-                        total_words * sizeof(uint32_t));
-            }
-            reloc[src] = dest;
-            dest += total_words;
-        } else {
-            reloc[src] = INVALID_CLAUSE;
-        }
+CRef arena_gc_move(Arena* arena, CRef cref) {
+    if (cref == INVALID_CLAUSE) return INVALID_CLAUSE;
 
-        src += total_words;
+    ClauseHeader* old = CLAUSE_HEADER(arena, cref);
+    if (cref < arena->gc_base) {
+        // Tenured clause in a minor collection: stays in place
+        return (old->flags & CLAUSE_DELETED) ? INVALID_CLAUSE : cref;
     }
-
-    // Update all references
-
-    // Update watches
-    for (uint32_t i = 0; i < num_watches; i++) {
-        if (watches[i]) {
-            uint32_t watch_size = 0;  // Need to track this properly
-            for (uint32_t j = 0; j < watch_size; j++) {
-                if (watches[i][j] != INVALID_CLAUSE) {
-                    watches[i][j] = reloc[watches[i][j]];
-                }
-            }
-        }
+    if (old->flags & CLAUSE_MOVED) return CLAUSE_FORWARD(arena, cref);
+    if (old->flags & CLAUSE_DELETED) return INVALID_CLAUSE;
+
+    size_t activity_words = old->flags & CLAUSE_LEARNED ? ACTIVITY_WORDS : 0;
+    size_t total_words = clause_words(old);
+    if (arena->to_size + total_words > arena->to_capacity) {
+        // Only if the waste accounting was off
+        size_t capacity = (arena->to_size + total_words) * GROWTH_FACTOR;
+        uint32_t* grown = (uint32_t*)realloc(arena->to_space, capacity * sizeof(uint32_t));
+        if (!grown) return INVALID_CLAUSE;
+        arena->to_space = grown;
+        arena->to_capacity = capacity;
     }
+    memcpy(&arena->to_space[arena->to_size], &arena->memory[cref - activity_words],
+           total_words * sizeof(uint32_t));
+    CRef moved = (CRef)(arena->gc_base + arena->to_size + activity_words);
+    arena->to_size += total_words;
+
+    old->flags |= CLAUSE_MOVED;
+    CLAUSE_FORWARD(arena, cref) = moved;
+    return moved;
+}
 
-    // Update clause array
-    uint32_t j = 0;
-    for (uint32_t i = 0; i < *num_clauses; i++) {
-        CRef new_ref = reloc[clauses[i]];
-        if (new_ref != INVALID_CLAUSE) {
-            clauses[j++] = new_ref;
-        }
-    }
-    *num_clauses = j;
+void arena_gc_tenure(Arena* arena) {
+    arena->gc_tenured = arena->gc_base + arena->to_size;
+}
 
-    // Update arena size
-    arena->size = dest;
-    arena->wasted = 0;
+void arena_gc_end(Arena* arena) {
+    // Survivors never take more room than the region they came from
+    memcpy(&arena->memory[arena->gc_base], arena->to_space, arena->to_size * sizeof(uint32_t));
+    free(arena->to_space);
+    arena->to_space = NULL;
 
-    free(reloc);
+    if (arena->gc_base == 1) arena->tenured_wasted = 0;
+    arena->size = arena->gc_base + arena->to_size;
+    arena->wasted = arena->tenured_wasted;
+    arena->tenured = arena->gc_tenured;
 }
 
 /*********************************************************************
@@ -306,19 +422,9 @@ ArenaStats arena_stats(const Arena* arena) {
     stats.total_bytes = arena->capacity * sizeof(uint32_t);
     stats.used_bytes = arena->size * sizeof(uint32_t);
     stats.wasted_bytes = arena->wasted * sizeof(uint32_t);
-
-    // Count active clauses
-    uint32_t pos = 1;
-    while (pos < arena->size) {
-        ClauseHeader* header = (ClauseHeader*)&arena->memory[pos];
-        size_t header_words = (sizeof(ClauseHeader) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
-
-        if (!(header->flags & CLAUSE_DELETED)) {
-            stats.num_clauses++;
-        }
-
-        pos += header_words + header->size;
-    }
+    stats.num_clauses = arena->num_clauses;
+    stats.mapped = arena->mapped;
+    stats.huge_pages = arena->huge_pages;
 
     return stats;
 }
\ No newline at end of file
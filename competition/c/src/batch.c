@@ -0,0 +1,283 @@
+/*********************************************************************
+ * BSAT Competition Solver - Batch Solving Implementation
+ *********************************************************************/
+
+#define _POSIX_C_SOURCE 200809L  // getline, clock_gettime
+
+#include "../include/batch.h"
+#include "../include/dimacs.h"
+#include "../include/timer.h"
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*********************************************************************
+ * Shared State
+ *********************************************************************/
+
+typedef struct BatchRun {
+    SolverOpts       opts;          // Per-instance solver options
+    bool             models;
+    FILE*            in;
+    FILE*            out;
+    pthread_mutex_t  in_lock;       // Reading items and handing out ids
+    pthread_mutex_t  out_lock;      // Writing lines and counting results
+    uint64_t         next_id;
+    bool             eof;
+    BatchStats*      stats;
+} BatchRun;
+
+// One worker's reusable buffers: the solver and everything else an item
+// needs grow to the largest item seen and are then reused
+typedef struct BatchWorker {
+    pthread_t  thread;
+    BatchRun*  run;
+    Solver*    solver;
+    char*      line;               // Current input line (path or frame header)
+    size_t     line_capacity;
+    char*      frame;              // Current frame text
+    size_t     frame_capacity;
+    char*      out;                // JSON line being built
+    size_t     out_size;
+    size_t     out_capacity;
+} BatchWorker;
+
+/*********************************************************************
+ * Output
+ *********************************************************************/
+
+static bool out_reserve(BatchWorker* w, size_t extra) {
+    if (w->out_size + extra <= w->out_capacity) return true;
+    size_t capacity = w->out_capacity ? w->out_capacity : 4096;
+    while (w->out_size + extra > capacity) capacity *= 2;
+    char* grown = (char*)realloc(w->out, capacity);
+    if (!grown) return false;
+    w->out = grown;
+    w->out_capacity = capacity;
+    return true;
+}
+
+static void out_printf(BatchWorker* w, const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    size_t room = w->out_capacity - w->out_size;
+    int n = vsnprintf(w->out ? w->out + w->out_size : NULL, room, fmt, args);
+    va_end(args);
+    if (n < 0) return;
+    if ((size_t)n >= room) {
+        if (!out_reserve(w, (size_t)n + 1)) return;
+        va_start(args, fmt);
+        vsnprintf(w->out + w->out_size, (size_t)n + 1, fmt, args);
+        va_end(args);
+    }
+    w->out_size += (size_t)n;
+}
+
+// JSON string with quotes, backslashes and control characters escaped
+static void out_string(BatchWorker* w, const char* str) {
+    out_printf(w, "\"");
+    for (const char* p = str; *p; p++) {
+        unsigned char c = (unsigned char)*p;
+        if (c == '"' || c == '\\') {
+            out_printf(w, "\\%c", c);
+        } else if (c < 0x20) {
+            out_printf(w, "\\u%04x", c);
+        } else {
+            out_printf(w, "%c", c);
+        }
+    }
+    out_printf(w, "\"");
+}
+
+static void out_model(BatchWorker* w) {
+    const Solver* s = w->solver;
+    out_printf(w, ", \"model\": [");
+    for (Var v = 1; v <= solver_input_vars(s); v++) {
+        bool value = solver_model_value(s, v) == TRUE;
+        out_printf(w, "%s%s%u", v > 1 ? ", " : "", value ? "" : "-", v);
+    }
+    out_printf(w, "]");
+}
+
+/*********************************************************************
+ * Input
+ *********************************************************************/
+
+// Read the next item under the input lock. Returns false at end of
+// input; *frame_size is set for frames (the text is in w->frame).
+static bool next_item(BatchWorker* w, uint64_t* id, size_t* frame_size, bool* truncated) {
+    BatchRun* run = w->run;
+    bool found = false;
+    *frame_size = 0;
+    *truncated = false;
+
+    pthread_mutex_lock(&run->in_lock);
+    while (!run->eof) {
+        ssize_t len = getline(&w->line, &w->line_capacity, run->in);
+        if (len < 0) {
+            run->eof = true;
+            break;
+        }
+        while (len > 0 && (w->line[len - 1] == '\n' || w->line[len - 1] == '\r')) {
+            w->line[--len] = '\0';
+        }
+        if (len == 0 || w->line[0] == '#') continue;
+
+        if (w->line[0] == '@') {
+            size_t size = strtoull(w->line + 1, NULL, 10);
+            if (size + 1 > w->frame_capacity) {
+                char* grown = (char*)realloc(w->frame, size + 1);
+                if (!grown) {
+                    // Cannot skip the frame on a pipe: stop reading
+                    run->eof = true;
+                    *truncated = true;
+                    *id = run->next_id++;
+                    found = true;
+                    break;
+                }
+                w->frame = grown;
+                w->frame_capacity = size + 1;
+            }
+            size_t got = fread(w->frame, 1, size, run->in);
+            w->frame[got] = '\0';
+            *frame_size = got;
+            *truncated = got < size;
+            if (got < size) run->eof = true;
+        }
+
+        *id = run->next_id++;
+        found = true;
+        break;
+    }
+    pthread_mutex_unlock(&run->in_lock);
+
+    return found;
+}
+
+/*********************************************************************
+ * Workers
+ *********************************************************************/
+
+static void solve_item(BatchWorker* w, uint64_t id, size_t frame_size, bool truncated) {
+    BatchRun* run = w->run;
+    bool frame = w->line[0] == '@';
+    double start = now_seconds();
+
+    // The first item uses the fresh solver
+    DimacsError err = DIMACS_ERROR_MEMORY;
+    bool ready = w->solver ? solver_reset(w->solver, &run->opts)
+                           : (w->solver = solver_new_with_opts(&run->opts)) != NULL;
+    if (ready && truncated) {
+        err = DIMACS_ERROR_FILE;
+    } else if (ready) {
+        err = frame ? dimacs_parse_buffer(w->solver, w->frame, frame_size)
+                    : dimacs_parse_file(w->solver, w->line);
+    }
+
+    lbool result = UNDEF;
+    if (err == DIMACS_OK) result = solver_solve(w->solver);
+    double seconds = now_seconds() - start;
+
+    w->out_size = 0;
+    out_printf(w, "{\"id\": %llu", (unsigned long long)id);
+    if (!frame) {
+        out_printf(w, ", \"input\": ");
+        out_string(w, w->line);
+    }
+
+    if (err != DIMACS_OK) {
+        out_printf(w, ", \"result\": \"ERROR\", \"error\": ");
+        out_string(w, truncated ? "Truncated frame" : dimacs_error_string(err));
+    } else {
+        const Solver* s = w->solver;
+        out_printf(w, ", \"result\": \"%s\"",
+                   result == TRUE ? "SAT" : result == FALSE ? "UNSAT" : "UNKNOWN");
+        out_printf(w, ", \"seconds\": %.6f, \"variables\": %u, \"clauses\": %u",
+                   seconds, s->num_vars, s->num_clauses);
+        out_printf(w, ", \"decisions\": %llu, \"propagations\": %llu, \"conflicts\": %llu"
+                   ", \"restarts\": %llu, \"learned_clauses\": %llu",
+                   (unsigned long long)s->stats.decisions,
+                   (unsigned long long)s->stats.propagations,
+                   (unsigned long long)s->stats.conflicts,
+                   (unsigned long long)s->stats.restarts,
+                   (unsigned long long)s->stats.learned_clauses);
+        if (result == TRUE && run->models) out_model(w);
+    }
+    out_printf(w, "}\n");
+
+    pthread_mutex_lock(&run->out_lock);
+    fwrite(w->out, 1, w->out_size, run->out);
+    fflush(run->out);  // Consumers read results as they come
+    BatchStats* stats = run->stats;
+    stats->instances++;
+    if (err != DIMACS_OK) stats->errors++;
+    else if (result == TRUE) stats->sat++;
+    else if (result == FALSE) stats->unsat++;
+    else stats->unknown++;
+    pthread_mutex_unlock(&run->out_lock);
+}
+
+static void* batch_worker_main(void* arg) {
+    BatchWorker* w = (BatchWorker*)arg;
+
+    uint64_t id;
+    size_t frame_size;
+    bool truncated;
+    while (next_item(w, &id, &frame_size, &truncated)) {
+        solve_item(w, id, frame_size, truncated);
+    }
+
+    return NULL;
+}
+
+bool batch_solve(const SolverOpts* opts, FILE* in, FILE* out,
+                 const BatchOpts* bopts, BatchStats* stats) {
+    memset(stats, 0, sizeof(*stats));
+
+    uint32_t threads = bopts->threads ? bopts->threads : 1;
+    if (threads > BATCH_MAX_THREADS) threads = BATCH_MAX_THREADS;
+
+    BatchRun run;
+    memset(&run, 0, sizeof(run));
+    run.opts = *opts;
+    run.opts.quiet = true;      // Output is the JSON lines only
+    run.opts.stats = false;
+    run.opts.proof_path = NULL;
+    run.opts.max_time = 0.0;
+    if (threads > 1) run.opts.elim_threads = 1;  // Workers already occupy the cores
+    run.models = bopts->models;
+    run.in = in;
+    run.out = out;
+    run.stats = stats;
+
+    BatchWorker* workers = (BatchWorker*)calloc(threads, sizeof(BatchWorker));
+    if (!workers) return false;
+
+    pthread_mutex_init(&run.in_lock, NULL);
+    pthread_mutex_init(&run.out_lock, NULL);
+
+    double start = now_seconds();
+    uint32_t launched = 0;
+    for (uint32_t i = 0; i < threads; i++) {
+        workers[i].run = &run;
+        if (pthread_create(&workers[i].thread, NULL, batch_worker_main, &workers[i]) != 0) break;
+        launched++;
+    }
+    for (uint32_t i = 0; i < launched; i++) {
+        pthread_join(workers[i].thread, NULL);
+    }
+    stats->time = now_seconds() - start;
+
+    for (uint32_t i = 0; i < threads; i++) {
+        solver_free(workers[i].solver);
+        free(workers[i].line);
+        free(workers[i].frame);
+        free(workers[i].out);
+    }
+    pthread_mutex_destroy(&run.in_lock);
+    pthread_mutex_destroy(&run.out_lock);
+    free(workers);
+
+    return launched > 0;
+}
@@ -0,0 +1,605 @@
+/*********************************************************************
+ * BSAT Competition Solver - Checkpoint and Resume Implementation
+ *
+ * Writing streams the parts of the state through stdio; loading maps
+ * the file, checks it whole, then copies each part into a fresh solver
+ * (see checkpoint.h for the layout).
+ *********************************************************************/
+
+#define _POSIX_C_SOURCE 200809L  // mmap, fileno, fsync
+
+#include "../include/checkpoint.h"
+#include "../include/solver.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/*********************************************************************
+ * Checksum
+ *
+ * FNV-1a over 64-bit words. Every part is padded to a whole number of
+ * words, so the writer can sum each part as it goes and the reader the
+ * mapped file in one pass.
+ *********************************************************************/
+
+#define CHECKPOINT_ALIGN 8
+#define CHECKSUM_SEED  0xcbf29ce484222325ULL
+#define CHECKSUM_PRIME 0x100000001b3ULL
+
+static inline size_t padded(size_t bytes) {
+    return (bytes + CHECKPOINT_ALIGN - 1) & ~(size_t)(CHECKPOINT_ALIGN - 1);
+}
+
+// Sum of bytes followed by zero padding
+static uint64_t checksum_add(uint64_t h, const void* data, size_t bytes) {
+    const unsigned char* p = (const unsigned char*)data;
+    size_t full = bytes / sizeof(uint64_t);
+    for (size_t i = 0; i < full; i++) {
+        uint64_t w;
+        memcpy(&w, p + i * sizeof(uint64_t), sizeof(uint64_t));
+        h = (h ^ w) * CHECKSUM_PRIME;
+    }
+    size_t tail = bytes % sizeof(uint64_t);
+    if (tail) {
+        uint64_t w = 0;
+        memcpy(&w, p + full * sizeof(uint64_t), tail);
+        h = (h ^ w) * CHECKSUM_PRIME;
+    }
+    return h;
+}
+
+/*********************************************************************
+ * Input Fingerprint
+ *********************************************************************/
+
+#define INPUT_CHUNK (1024 * 1024)  // Whole words, so chunks sum like one block
+
+bool checkpoint_input(const char* path, CheckpointInput* input) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    unsigned char* buffer = (unsigned char*)malloc(INPUT_CHUNK);
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || !buffer) {
+        free(buffer);
+        close(fd);
+        return false;
+    }
+
+    uint64_t hash = CHECKSUM_SEED;
+    uint64_t size = 0;
+    bool ok = true;
+    for (;;) {
+        // Fill the chunk completely unless the file ends
+        size_t filled = 0;
+        while (filled < INPUT_CHUNK) {
+            ssize_t got = read(fd, buffer + filled, INPUT_CHUNK - filled);
+            if (got < 0) ok = false;
+            if (got <= 0) break;
+            filled += (size_t)got;
+        }
+        hash = checksum_add(hash, buffer, filled);
+        size += filled;
+        if (!ok || filled < INPUT_CHUNK) break;
+    }
+    free(buffer);
+    close(fd);
+
+    input->size = size;
+    input->hash = hash;
+    return ok;
+}
+
+/*********************************************************************
+ * Writing
+ *********************************************************************/
+
+typedef struct Writer {
+    FILE*    out;
+    uint64_t checksum;
+    uint64_t size;         // Bytes written after the header
+    bool     ok;
+} Writer;
+
+static void write_part(Writer* w, const void* data, size_t bytes) {
+    static const unsigned char zeros[CHECKPOINT_ALIGN];
+    size_t pad = padded(bytes) - bytes;
+
+    if (bytes && fwrite(data, 1, bytes, w->out) != bytes) w->ok = false;
+    if (pad && fwrite(zeros, 1, pad, w->out) != pad) w->ok = false;
+    w->checksum = checksum_add(w->checksum, data, bytes);
+    w->size += bytes + pad;
+}
+
+static uint8_t var_flags(const Solver* s, Var v) {
+    uint8_t flags = 0;
+    if (s->vars[v].polarity) flags |= CHECKPOINT_VAR_POLARITY;
+    if (s->vars[v].frozen) flags |= CHECKPOINT_VAR_FROZEN;
+    if (s->vars[v].in_matrix) flags |= CHECKPOINT_VAR_MATRIX;
+    if (s->rephase.best_phase && s->rephase.best_phase[v]) flags |= CHECKPOINT_VAR_BEST;
+    if (s->elim && v < s->elim->elim_capacity && s->elim->eliminated[v]) {
+        flags |= CHECKPOINT_VAR_ELIMINATED;
+    }
+    return flags;
+}
+
+// Header fields other than the magic, sizes and checksum
+static void fill_header(const Solver* s, CheckpointHeader* h) {
+    const Arena* arena = s->arena;
+
+    h->input_size = s->checkpoint.input_size;
+    h->input_hash = s->checkpoint.input_hash;
+    h->num_vars = s->num_vars;
+    h->num_input_vars = s->num_input_vars;
+    h->num_clauses = s->num_clauses;
+    h->num_learnts = s->num_learnts;
+    h->arena_size = arena->size;
+    h->arena_wasted = arena->wasted;
+    h->arena_peak = arena->peak_size;
+    h->arena_tenured = arena->tenured;
+    h->arena_tenured_wasted = arena->tenured_wasted;
+    h->arena_clauses = arena->num_clauses;
+    h->arena_growths = arena->num_growths;
+    h->arena_collections = arena->num_collections;
+    h->arena_major = arena->num_major;
+
+    h->rng = s->rng;
+    h->var_inc = s->order.var_inc;
+    h->clause_inc = s->db.clause_inc;
+    h->queue_stamp = s->queue.stamp;
+
+    h->restart_conflicts = s->restart.conflicts_since;
+    h->restart_threshold = s->restart.threshold;
+    h->restart_luby_index = s->restart.luby_index;
+    h->restart_stuck = s->restart.stuck_conflicts;
+    h->slow_ma = s->restart.slow_ma;
+    h->fast_ma = s->restart.fast_ma;
+    h->lbd_sum = s->restart.lbd_sum;
+    h->lbd_count = s->restart.lbd_count;
+    if (s->restart.recent_lbds) {
+        h->flags |= CHECKPOINT_WINDOW;
+        h->window_size = s->opts.glucose_window_size;
+        h->window_count = s->restart.recent_lbds_count;
+        h->window_head = s->restart.recent_lbds_head;
+    }
+
+    h->best_trail_size = s->rephase.best_trail_size;
+    h->rephase_conflicts = s->rephase.conflicts_since;
+    h->rephase_count = s->rephase.rephase_count;
+
+    h->ls_conflicts = s->local_search.conflicts_since;
+    h->ls_interval = s->local_search.interval;
+    h->ls_next = s->local_search.next;
+    h->ls_calls = s->local_search.calls;
+    h->ls_successes = s->local_search.successes;
+
+    if (s->queue.links) h->flags |= CHECKPOINT_QUEUE;
+    if (s->opts.modes) h->flags |= CHECKPOINT_MODES;
+    if (s->elim) {
+        const ElimState* e = s->elim;
+        h->flags |= CHECKPOINT_ELIM;
+        h->elim_stack_size = e->stack_size;
+        h->elim_threads = e->threads;
+        h->elim_vars = e->vars_eliminated;
+        h->elim_clauses_removed = e->clauses_removed;
+        h->elim_resolvents_added = e->resolvents_added;
+        h->elim_resolvents_subsumed = e->resolvents_subsumed;
+        h->elim_clauses_blocked = e->clauses_blocked;
+        h->elim_batches = e->batches;
+        h->elim_time = e->time;
+    }
+}
+
+// The parts after the header, in file order
+static bool write_parts(const Solver* s, Writer* w, CheckpointHeader* h) {
+    uint32_t n = s->num_vars;
+
+    write_part(w, &s->stats, sizeof(s->stats));
+    if (h->flags & CHECKPOINT_MODES) write_part(w, &s->mode, sizeof(s->mode));
+    write_part(w, &s->inprocess, sizeof(s->inprocess));
+
+    write_part(w, s->arena->memory, s->arena->size * sizeof(uint32_t));
+    write_part(w, s->clauses, (size_t)s->num_clauses * sizeof(CRef));
+    write_part(w, s->learnts, (size_t)s->num_learnts * sizeof(CRef));
+
+    // Level-0 units and binary clauses, each binary once (from its
+    // smaller literal)
+    Lit* units = (Lit*)malloc((s->trail_size + 1) * sizeof(Lit));
+    if (!units) return false;
+    for (uint32_t i = 0; i < s->trail_size; i++) {
+        if (s->trail[i].level == 0) units[h->num_units++] = s->trail[i].lit;
+    }
+    write_part(w, units, h->num_units * sizeof(Lit));
+    free(units);
+
+    size_t num_lits = 2 * (size_t)(n + 1);
+    for (Lit a = 2; a < num_lits; a++) {
+        const BinList* bl = bin_list(s->watches, a);
+        for (uint32_t i = 0; i < bl->size; i++) h->num_binaries += a < bl->lits[i];
+    }
+    Lit* binaries = (Lit*)malloc(2 * (size_t)h->num_binaries * sizeof(Lit) + sizeof(Lit));
+    if (!binaries) return false;
+    size_t k = 0;
+    for (Lit a = 2; a < num_lits; a++) {
+        const BinList* bl = bin_list(s->watches, a);
+        for (uint32_t i = 0; i < bl->size; i++) {
+            if (a < bl->lits[i]) {
+                binaries[k++] = a;
+                binaries[k++] = bl->lits[i];
+            }
+        }
+    }
+    write_part(w, binaries, k * sizeof(Lit));
+    free(binaries);
+
+    // Per-variable state, indexed from 0 like the solver arrays
+    write_part(w, s->order.activity, (n + 1) * sizeof(double));
+
+    uint8_t* flags = (uint8_t*)calloc(n + 1, sizeof(uint8_t));
+    if (!flags) return false;
+    for (Var v = 1; v <= n; v++) flags[v] = var_flags(s, v);
+    write_part(w, flags, (n + 1) * sizeof(uint8_t));
+    free(flags);
+
+    if (h->flags & CHECKPOINT_QUEUE) {
+        uint64_t* stamps = (uint64_t*)calloc(n + 1, sizeof(uint64_t));
+        if (!stamps) return false;
+        for (Var v = 1; v <= n; v++) stamps[v] = s->queue.links[v].stamp;
+        write_part(w, stamps, (n + 1) * sizeof(uint64_t));
+        free(stamps);
+    }
+
+    if (h->flags & CHECKPOINT_ELIM) {
+        write_part(w, s->elim->stack, s->elim->stack_size * sizeof(Lit));
+    }
+    if (h->flags & CHECKPOINT_WINDOW) {
+        write_part(w, s->restart.recent_lbds, h->window_size * sizeof(uint32_t));
+    }
+    return true;
+}
+
+bool checkpoint_write(const Solver* s, const char* path) {
+    if (s->decision_level != 0) return false;
+
+    size_t path_len = strlen(path);
+    char* tmp_path = (char*)malloc(path_len + 5);
+    if (!tmp_path) return false;
+    memcpy(tmp_path, path, path_len);
+    memcpy(tmp_path + path_len, ".tmp", 5);
+
+    Writer w = { fopen(tmp_path, "wb"), CHECKSUM_SEED, 0, true };
+    if (!w.out) {
+        free(tmp_path);
+        return false;
+    }
+
+    // The header goes first with the counts still open and is rewritten
+    // at the end
+    CheckpointHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, CHECKPOINT_MAGIC, sizeof(h.magic));
+    h.version = CHECKPOINT_VERSION;
+    h.header_size = sizeof(CheckpointHeader);
+    h.stats_size = sizeof(s->stats);
+    h.mode_size = sizeof(s->mode);
+    h.inprocess_size = sizeof(s->inprocess);
+    fill_header(s, &h);
+
+    Writer header = { w.out, 0, 0, true };
+    write_part(&header, &h, sizeof(h));
+    bool ok = header.ok && write_parts(s, &w, &h) && w.ok;
+
+    if (ok) {
+        h.file_size = padded(sizeof(h)) + w.size;
+        h.checksum = w.checksum;
+        ok = fseek(w.out, 0, SEEK_SET) == 0 && fwrite(&h, sizeof(h), 1, w.out) == 1;
+    }
+    ok = fflush(w.out) == 0 && ok;
+    ok = fsync(fileno(w.out)) == 0 && ok;
+    ok = fclose(w.out) == 0 && ok;
+
+    // Only a complete file replaces the previous checkpoint
+    ok = ok && rename(tmp_path, path) == 0;
+    if (!ok) remove(tmp_path);
+    free(tmp_path);
+    return ok;
+}
+
+/*********************************************************************
+ * Loading
+ *********************************************************************/
+
+typedef struct Reader {
+    const unsigned char* data;
+    size_t pos;
+    size_t size;
+} Reader;
+
+// Next part of the given size, or NULL past the end of the file
+static const void* read_part(Reader* r, size_t bytes) {
+    size_t next = padded(bytes);
+    if (next < bytes || next > r->size - r->pos) return NULL;
+    const void* part = r->data + r->pos;
+    r->pos += next;
+    return part;
+}
+
+static inline bool lit_valid(Lit lit, uint32_t num_vars) {
+    return var(lit) >= 1 && var(lit) <= num_vars;
+}
+
+// A clause reference of the lists: INVALID_CLAUSE (binary slot), a
+// deleted clause, or a clause over known variables inside the arena
+static bool clause_valid(const Solver* s, CRef cref, bool learned) {
+    if (cref == INVALID_CLAUSE) return !learned;
+    size_t first = learned ? ACTIVITY_WORDS + 1 : 1;
+    if (cref < first || cref + HEADER_WORDS > s->arena->size) return false;
+    if (clause_deleted(s->arena, cref)) return true;
+
+    uint32_t size = CLAUSE_SIZE(s->arena, cref);
+    if (size < 2 || size > s->arena->size - cref - HEADER_WORDS) return false;
+    const Lit* lits = CLAUSE_LITS(s->arena, cref);
+    for (uint32_t i = 0; i < size; i++) {
+        if (!lit_valid(lits[i], s->num_vars)) return false;
+    }
+    return true;
+}
+
+static inline void watch_clause(Solver* s, CRef cref) {
+    const Lit* lits = CLAUSE_LITS(s->arena, cref);
+    watch_add(s->watches, lits[0], cref, lits[1]);
+    watch_add(s->watches, lits[1], cref, lits[0]);
+}
+
+// Sizes of the parts after the header, or 0 if they do not add up
+static uint64_t expected_size(const CheckpointHeader* h) {
+    uint64_t n = (uint64_t)h->num_vars + 1;
+    uint64_t size = padded(sizeof(CheckpointHeader));
+    size += padded(h->stats_size) + padded(h->inprocess_size);
+    if (h->flags & CHECKPOINT_MODES) size += padded(h->mode_size);
+    if (h->arena_size > UINT32_MAX) return 0;
+    size += padded(h->arena_size * sizeof(uint32_t));
+    size += padded((uint64_t)h->num_clauses * sizeof(CRef));
+    size += padded((uint64_t)h->num_learnts * sizeof(CRef));
+    size += padded((uint64_t)h->num_units * sizeof(Lit));
+    size += padded(2 * (uint64_t)h->num_binaries * sizeof(Lit));
+    size += padded(n * sizeof(double)) + padded(n * sizeof(uint8_t));
+    if (h->flags & CHECKPOINT_QUEUE) size += padded(n * sizeof(uint64_t));
+    if (h->flags & CHECKPOINT_ELIM) size += padded((uint64_t)h->elim_stack_size * sizeof(Lit));
+    if (h->flags & CHECKPOINT_WINDOW) size += padded((uint64_t)h->window_size * sizeof(uint32_t));
+    return size;
+}
+
+static const char* check_header(const Solver* s, const CheckpointHeader* h, size_t file_size) {
+    if (memcmp(h->magic, CHECKPOINT_MAGIC, sizeof(h->magic)) != 0) return "not a checkpoint file";
+    if (h->version != CHECKPOINT_VERSION) return "unsupported checkpoint version";
+    if (h->header_size != sizeof(CheckpointHeader) || h->stats_size != sizeof(s->stats) ||
+        h->mode_size != sizeof(s->mode) || h->inprocess_size != sizeof(s->inprocess)) {
+        return "checkpoint written by a different build";
+    }
+    if (h->file_size != file_size || expected_size(h) != file_size) return "checkpoint is truncated";
+    if (h->num_vars > MAX_VARS || h->num_input_vars > h->num_vars) return "checkpoint is damaged";
+
+    const unsigned char* payload = (const unsigned char*)h + padded(sizeof(CheckpointHeader));
+    uint64_t checksum = checksum_add(CHECKSUM_SEED, payload, file_size - padded(sizeof(CheckpointHeader)));
+    if (checksum != h->checksum) return "checkpoint is damaged (checksum mismatch)";
+    return NULL;
+}
+
+// Copy the parts into s (the header is checked)
+static const char* restore(Solver* s, const CheckpointHeader* h, Reader* r) {
+    uint32_t n = h->num_vars;
+
+    const void* stats = read_part(r, h->stats_size);
+    const void* mode = (h->flags & CHECKPOINT_MODES) ? read_part(r, h->mode_size) : NULL;
+    const void* inprocess = read_part(r, h->inprocess_size);
+    const uint32_t* memory = (const uint32_t*)read_part(r, h->arena_size * sizeof(uint32_t));
+    const CRef* clauses = (const CRef*)read_part(r, (size_t)h->num_clauses * sizeof(CRef));
+    const CRef* learnts = (const CRef*)read_part(r, (size_t)h->num_learnts * sizeof(CRef));
+    const Lit* units = (const Lit*)read_part(r, h->num_units * sizeof(Lit));
+    const Lit* binaries = (const Lit*)read_part(r, 2 * (size_t)h->num_binaries * sizeof(Lit));
+    const double* activity = (const double*)read_part(r, (n + 1) * sizeof(double));
+    const uint8_t* flags = (const uint8_t*)read_part(r, (n + 1) * sizeof(uint8_t));
+    const uint64_t* stamps = (h->flags & CHECKPOINT_QUEUE)
+                                 ? (const uint64_t*)read_part(r, (n + 1) * sizeof(uint64_t)) : NULL;
+    const Lit* elim_stack = (h->flags & CHECKPOINT_ELIM)
+                                ? (const Lit*)read_part(r, h->elim_stack_size * sizeof(Lit)) : NULL;
+    const uint32_t* window = (h->flags & CHECKPOINT_WINDOW)
+                                 ? (const uint32_t*)read_part(r, h->window_size * sizeof(uint32_t)) : NULL;
+    if (r->pos != r->size) return "checkpoint is truncated";
+
+    // Variables and the clause list
+    if (!solver_reserve(s, n, h->num_clauses)) return "out of memory";
+    for (Var v = 1; v <= n; v++) {
+        if (solver_new_var(s) == INVALID_VAR) return "out of memory";
+    }
+    s->num_input_vars = h->num_input_vars;
+
+    // The arena as one block
+    Arena* arena = s->arena;
+    if (!arena_reserve(arena, h->arena_size)) return "out of memory";
+    memcpy(arena->memory, memory, h->arena_size * sizeof(uint32_t));
+    arena->size = h->arena_size;
+    arena->wasted = h->arena_wasted;
+    arena->peak_size = h->arena_peak > h->arena_size ? h->arena_peak : h->arena_size;
+    arena->tenured = h->arena_tenured <= h->arena_size ? h->arena_tenured : h->arena_size;
+    arena->tenured_wasted = h->arena_tenured_wasted;
+    arena->num_clauses = h->arena_clauses;
+    arena->num_growths = h->arena_growths;
+    arena->num_collections = h->arena_collections;
+    arena->num_major = h->arena_major;
+
+    // Clause lists and their watches (on the first two literals, as
+    // propagation keeps them)
+    for (uint32_t i = 0; i < h->num_clauses; i++) {
+        if (!clause_valid(s, clauses[i], false)) return "checkpoint is damaged (bad clause)";
+    }
+    for (uint32_t i = 0; i < h->num_learnts; i++) {
+        if (!clause_valid(s, learnts[i], true)) return "checkpoint is damaged (bad clause)";
+    }
+    if (h->num_clauses) memcpy(s->clauses, clauses, h->num_clauses * sizeof(CRef));
+    s->num_clauses = h->num_clauses;
+
+    uint32_t learnts_size = h->num_learnts > 1024 ? h->num_learnts : 1024;
+    s->learnts = (CRef*)malloc(learnts_size * sizeof(CRef));
+    if (!s->learnts) return "out of memory";
+    if (h->num_learnts) memcpy(s->learnts, learnts, h->num_learnts * sizeof(CRef));
+    s->learnts_size = learnts_size;
+    s->num_learnts = h->num_learnts;
+
+    for (uint32_t i = 0; i < s->num_clauses; i++) {
+        CRef cref = s->clauses[i];
+        if (cref != INVALID_CLAUSE && !clause_deleted(arena, cref)) watch_clause(s, cref);
+    }
+    for (uint32_t i = 0; i < s->num_learnts; i++) {
+        CRef cref = s->learnts[i];
+        if (!clause_deleted(arena, cref) && clause_learned(arena, cref)) watch_clause(s, cref);
+    }
+
+    for (uint32_t i = 0; i < 2 * h->num_binaries; i++) {
+        if (!lit_valid(binaries[i], n)) return "checkpoint is damaged (bad literal)";
+    }
+    for (uint32_t i = 0; i < h->num_binaries; i++) {
+        watch_add_binary(s->watches, binaries[2 * i], binaries[2 * i + 1]);
+    }
+
+    // Units go back on the level-0 trail, to be propagated by the next
+    // solve call (a conflict among them makes the formula UNSAT)
+    for (uint32_t i = 0; i < h->num_units; i++) {
+        if (!lit_valid(units[i], n)) return "checkpoint is damaged (bad literal)";
+        solver_add_clause(s, &units[i], 1);
+    }
+
+    // Variables
+    memcpy(s->order.activity, activity, (n + 1) * sizeof(double));
+    for (Var v = 1; v <= n; v++) {
+        s->vars[v].polarity = flags[v] & CHECKPOINT_VAR_POLARITY;
+        s->vars[v].frozen = flags[v] & CHECKPOINT_VAR_FROZEN;
+        s->vars[v].in_matrix = flags[v] & CHECKPOINT_VAR_MATRIX;
+        if (s->rephase.best_phase) s->rephase.best_phase[v] = flags[v] & CHECKPOINT_VAR_BEST;
+        if (stamps && s->queue.links) s->queue.links[v].stamp = stamps[v];
+    }
+
+    // Elimination stack and flags for model reconstruction
+    if (elim_stack) {
+        elim_init(s);
+        ElimState* e = s->elim;
+        if (!e) return "out of memory";
+        if (e->stack_capacity < h->elim_stack_size) {
+            Lit* stack = (Lit*)realloc(e->stack, h->elim_stack_size * sizeof(Lit));
+            if (!stack) return "out of memory";
+            e->stack = stack;
+            e->stack_capacity = h->elim_stack_size;
+        }
+        if (h->elim_stack_size) memcpy(e->stack, elim_stack, h->elim_stack_size * sizeof(Lit));
+        e->stack_size = h->elim_stack_size;
+        for (Var v = 1; v <= n; v++) {
+            e->eliminated[v] = flags[v] & CHECKPOINT_VAR_ELIMINATED;
+        }
+        e->threads = h->elim_threads;
+        e->vars_eliminated = h->elim_vars;
+        e->clauses_removed = h->elim_clauses_removed;
+        e->resolvents_added = h->elim_resolvents_added;
+        e->resolvents_subsumed = h->elim_resolvents_subsumed;
+        e->clauses_blocked = h->elim_clauses_blocked;
+        e->batches = h->elim_batches;
+        e->time = h->elim_time;
+    }
+
+    // Search state; times measured with clock() restart with this process
+    double start_time = s->stats.start_time;
+    memcpy(&s->stats, stats, sizeof(s->stats));
+    s->stats.start_time = start_time;
+    if (mode && s->opts.modes) {
+        double mode_start = s->mode.start.time;
+        memcpy(&s->mode, mode, sizeof(s->mode));
+        s->mode.start.time = mode_start;
+    }
+    memcpy(&s->inprocess, inprocess, sizeof(s->inprocess));
+
+    s->rng = h->rng;
+    s->order.var_inc = h->var_inc;
+    s->db.clause_inc = h->clause_inc;
+    s->queue.stamp = h->queue_stamp;
+
+    s->restart.conflicts_since = h->restart_conflicts;
+    s->restart.threshold = h->restart_threshold;
+    s->restart.luby_index = h->restart_luby_index;
+    s->restart.stuck_conflicts = h->restart_stuck;
+    s->restart.slow_ma = h->slow_ma;
+    s->restart.fast_ma = h->fast_ma;
+    s->restart.lbd_sum = h->lbd_sum;
+    s->restart.lbd_count = h->lbd_count;
+    if (window && s->restart.recent_lbds && h->window_size == s->opts.glucose_window_size &&
+        h->window_count <= h->window_size && h->window_head < h->window_size) {
+        memcpy(s->restart.recent_lbds, window, h->window_size * sizeof(uint32_t));
+        s->restart.recent_lbds_count = h->window_count;
+        s->restart.recent_lbds_head = h->window_head;
+    }
+
+    s->rephase.best_trail_size = h->best_trail_size;
+    s->rephase.conflicts_since = h->rephase_conflicts;
+    s->rephase.rephase_count = h->rephase_count;
+
+    s->local_search.conflicts_since = h->ls_conflicts;
+    s->local_search.interval = h->ls_interval;
+    s->local_search.next = h->ls_next;
+    s->local_search.calls = h->ls_calls;
+    s->local_search.successes = h->ls_successes;
+
+    solver_rebuild_order(s);
+    s->checkpoint.input_size = h->input_size;
+    s->checkpoint.input_hash = h->input_hash;
+    s->incremental.preprocessed = true;
+    return NULL;
+}
+
+bool checkpoint_load(Solver* s, const char* path, const CheckpointInput* input,
+                     const char** error) {
+    if (s->num_vars > 0 || s->num_clauses > 0 || s->trail_size > 0) {
+        *error = "solver already has a formula";
+        return false;
+    }
+    if (s->proof) {
+        *error = "a resumed run cannot continue a proof";
+        return false;
+    }
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        *error = "cannot open checkpoint";
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) ||
+        (size_t)st.st_size < padded(sizeof(CheckpointHeader))) {
+        close(fd);
+        *error = "not a checkpoint file";
+        return false;
+    }
+
+    size_t size = (size_t)st.st_size;
+    void* data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        *error = "cannot map checkpoint";
+        return false;
+    }
+    posix_madvise(data, size, POSIX_MADV_SEQUENTIAL);
+
+    const CheckpointHeader* h = (const CheckpointHeader*)data;
+    *error = check_header(s, h, size);
+    if (!*error && input && (h->input_size != input->size || h->input_hash != input->hash)) {
+        *error = "checkpoint belongs to a different input";
+    }
+    if (!*error) {
+        Reader r = { (const unsigned char*)data, padded(sizeof(CheckpointHeader)), size };
+        *error = restore(s, h, &r);
+    }
+
+    munmap(data, size);
+    return *error == NULL;
+}
@@ -0,0 +1,565 @@
+/*********************************************************************
+ * BSAT Competition Solver - Cube-and-Conquer Implementation
+ *********************************************************************/
+
+#define _POSIX_C_SOURCE 200809L  // nanosleep, clock_gettime
+
+#include "../include/cube.h"
+#include "../include/portfolio.h"
+#include "../include/timer.h"
+#include "../include/watch.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*********************************************************************
+ * Lookahead Cube Generation
+ *********************************************************************/
+
+typedef struct CubeGen {
+    Solver*       s;
+    FILE*         out;
+    Lit*          path;        // Literals of the current cube (decisions + failed literals)
+    uint32_t      path_len;
+    Var*          cand;        // Candidate buffer (CUBE_LOOKAHEAD_CANDIDATES entries)
+    uint64_t*     cand_occ;    // Occurrence score of each candidate
+    CubeGenStats* stats;
+} CubeGen;
+
+// Occurrence estimate for a variable: watch and binary lists of both polarities
+static uint64_t occurrence_score(Solver* s, Var v) {
+    Lit p = mkLit(v, false), n = mkLit(v, true);
+    uint64_t pos = watch_list(s->watches, p)->size + bin_list(s->watches, p)->size;
+    uint64_t neg = watch_list(s->watches, n)->size + bin_list(s->watches, n)->size;
+    return (pos + 1) * (neg + 1);
+}
+
+// Collect the unassigned variables with the highest occurrence scores
+static uint32_t preselect_candidates(CubeGen* g) {
+    Solver* s = g->s;
+    uint32_t n = 0;
+
+    for (Var v = 1; v <= s->num_vars; v++) {
+        if (var_value(s, v) != UNDEF) continue;
+
+        uint64_t occ = occurrence_score(s, v);
+        if (n == CUBE_LOOKAHEAD_CANDIDATES && occ <= g->cand_occ[n - 1]) continue;
+
+        // Insertion into the sorted candidate list (descending)
+        uint32_t i = (n < CUBE_LOOKAHEAD_CANDIDATES) ? n++ : n - 1;
+        while (i > 0 && g->cand_occ[i - 1] < occ) {
+            g->cand[i] = g->cand[i - 1];
+            g->cand_occ[i] = g->cand_occ[i - 1];
+            i--;
+        }
+        g->cand[i] = v;
+        g->cand_occ[i] = occ;
+    }
+
+    return n;
+}
+
+// Write the current path as one cube line
+static void emit_cube(CubeGen* g) {
+    fputc('a', g->out);
+    for (uint32_t i = 0; i < g->path_len; i++) {
+        Lit l = g->path[i];
+        fprintf(g->out, " %s%u", sign(l) ? "-" : "", var(l));
+    }
+    fputs(" 0\n", g->out);
+    g->stats->cubes++;
+}
+
+// Push a literal implied at this node as an extra level of the cube.
+// Returns false if it leads to a conflict.
+static bool assert_implied(CubeGen* g, Lit lit) {
+    g->path[g->path_len++] = lit;
+    g->stats->failed_literals++;
+    return solver_decide_literal(g->s, lit);
+}
+
+// Pick the branching variable by double lookahead over the candidates.
+// Failed literals are asserted on the way. Returns false if the node is
+// refuted; otherwise *branch is the chosen variable (INVALID_VAR if every
+// variable is assigned).
+static bool lookahead(CubeGen* g, Var* branch) {
+    Solver* s = g->s;
+
+    for (;;) {
+        *branch = INVALID_VAR;
+        uint32_t n = preselect_candidates(g);
+        if (n == 0) return true;
+
+        Var best = 0;
+        uint64_t best_score = 0;
+        bool asserted = false;
+
+        for (uint32_t i = 0; i < n; i++) {
+            Var v = g->cand[i];
+            if (var_value(s, v) != UNDEF) continue;  // Fixed by an earlier failed literal
+
+            uint32_t pos_implied, neg_implied;
+            bool pos_ok = solver_probe(s, mkLit(v, false), &pos_implied);
+            bool neg_ok = solver_probe(s, mkLit(v, true), &neg_implied);
+            g->stats->probes += 2;
+
+            if (!pos_ok && !neg_ok) return false;
+            if (!pos_ok || !neg_ok) {
+                if (!assert_implied(g, mkLit(v, !pos_ok))) return false;
+                asserted = true;
+                continue;
+            }
+
+            // Prefer variables that propagate a lot on both sides
+            uint64_t score = (uint64_t)pos_implied * neg_implied + pos_implied + neg_implied;
+            if (score > best_score) {
+                best_score = score;
+                best = v;
+            }
+        }
+
+        // New failed literals change the propagation counts, so look again
+        if (!asserted) {
+            *branch = best;
+            return true;
+        }
+    }
+}
+
+static void generate_node(CubeGen* g, uint32_t depth_left) {
+    Solver* s = g->s;
+    Level node_level = s->decision_level;
+    uint32_t node_path = g->path_len;
+
+    Var v = INVALID_VAR;
+    if (depth_left > 0 && !lookahead(g, &v)) {
+        g->stats->refuted++;
+    } else if (v == INVALID_VAR) {
+        emit_cube(g);
+    } else {
+        for (int polarity = 0; polarity < 2; polarity++) {
+            Lit lit = mkLit(v, polarity == 1);
+            Level branch_level = s->decision_level;
+            g->path[g->path_len++] = lit;
+
+            if (solver_decide_literal(s, lit)) {
+                generate_node(g, depth_left - 1);
+            } else {
+                g->stats->refuted++;
+            }
+
+            solver_backtrack(s, branch_level);
+            g->path_len--;
+        }
+    }
+
+    solver_backtrack(s, node_level);
+    g->path_len = node_path;
+}
+
+lbool cube_generate(Solver* s, uint32_t depth, FILE* out, CubeGenStats* stats) {
+    memset(stats, 0, sizeof(CubeGenStats));
+    double start = now_seconds();
+
+    if (s->result == FALSE || solver_propagate(s) != INVALID_CLAUSE) {
+        s->result = FALSE;
+        return FALSE;
+    }
+
+    CubeGen g;
+    g.s = s;
+    g.out = out;
+    g.stats = stats;
+    g.path_len = 0;
+    g.path = (Lit*)malloc((s->num_vars + 1) * sizeof(Lit));
+    g.cand = (Var*)malloc(CUBE_LOOKAHEAD_CANDIDATES * sizeof(Var));
+    g.cand_occ = (uint64_t*)malloc(CUBE_LOOKAHEAD_CANDIDATES * sizeof(uint64_t));
+    if (!g.path || !g.cand || !g.cand_occ) {
+        free(g.path);
+        free(g.cand);
+        free(g.cand_occ);
+        return UNDEF;
+    }
+
+    fprintf(out, "c bsat cubes depth %u\n", depth);
+    generate_node(&g, depth);
+    solver_backtrack(s, 0);
+
+    free(g.path);
+    free(g.cand);
+    free(g.cand_occ);
+
+    stats->time = now_seconds() - start;
+
+    if (stats->cubes == 0) {
+        s->result = FALSE;
+        return FALSE;
+    }
+    return UNDEF;
+}
+
+/*********************************************************************
+ * Cube Files
+ *********************************************************************/
+
+bool cube_read_file(const char* filename, CubeSet* set) {
+    memset(set, 0, sizeof(CubeSet));
+
+    FILE* f = fopen(filename, "r");
+    if (!f) return false;
+
+    uint32_t lits_cap = 1024, cubes_cap = 64;
+    set->lits = (Lit*)malloc(lits_cap * sizeof(Lit));
+    set->start = (uint32_t*)malloc((cubes_cap + 1) * sizeof(uint32_t));
+    if (!set->lits || !set->start) goto fail;
+    set->start[0] = 0;
+
+    uint32_t num_lits = 0;
+    bool in_cube = false;
+    int ch;
+
+    while ((ch = fgetc(f)) != EOF) {
+        if (!in_cube) {
+            if (ch == 'a') {
+                in_cube = true;
+            } else if (ch != ' ' && ch != '\t' && ch != '\r' && ch != '\n') {
+                // Comment or other line: skip it
+                while (ch != EOF && ch != '\n') ch = fgetc(f);
+            }
+            continue;
+        }
+
+        ungetc(ch, f);
+        long lit;
+        if (fscanf(f, "%ld", &lit) != 1) goto fail;
+
+        if (lit == 0) {
+            in_cube = false;
+            if (set->num_cubes == cubes_cap) {
+                cubes_cap *= 2;
+                uint32_t* grown = (uint32_t*)realloc(set->start, (cubes_cap + 1) * sizeof(uint32_t));
+                if (!grown) goto fail;
+                set->start = grown;
+            }
+            set->start[++set->num_cubes] = num_lits;
+            continue;
+        }
+
+        Var v = (Var)(lit < 0 ? -lit : lit);
+        if (num_lits == lits_cap) {
+            lits_cap *= 2;
+            Lit* grown = (Lit*)realloc(set->lits, lits_cap * sizeof(Lit));
+            if (!grown) goto fail;
+            set->lits = grown;
+        }
+        set->lits[num_lits++] = mkLit(v, lit < 0);
+        if (v > set->max_var) set->max_var = v;
+    }
+
+    fclose(f);
+    if (in_cube) {
+        cube_set_free(set);  // Truncated last cube
+        return false;
+    }
+    return true;
+
+fail:
+    fclose(f);
+    cube_set_free(set);
+    return false;
+}
+
+void cube_set_free(CubeSet* set) {
+    free(set->lits);
+    free(set->start);
+    memset(set, 0, sizeof(CubeSet));
+}
+
+/*********************************************************************
+ * Conquer Phase
+ *********************************************************************/
+
+typedef struct CubeConquer {
+    SolverOpts       opts;          // Per-cube solver options
+    const char*      cnf_text;      // Input formula, read once
+    const CubeSet*   cubes;
+    uint32_t*        queue;         // Cube indices this process still has to solve
+    uint32_t         queue_size;
+    atomic_uint      next;          // Next queue position to hand out
+    ClauseExchange*  exchange;      // Clause sharing, stop flag and SAT winner
+    FILE*            results;       // Results log (NULL = none)
+    pthread_mutex_t  results_lock;
+    atomic_uint      refuted;       // Cubes proven UNSAT in this run
+    atomic_int       error;         // First DimacsError seen
+    atomic_bool      formula_unsat; // A worker refuted the formula itself
+} CubeConquer;
+
+typedef struct CubeWorker {
+    pthread_t    thread;
+    uint32_t     id;
+    CubeConquer* ctx;
+    Solver*      model;             // Solver of the SAT cube (if this worker found it)
+    atomic_bool  finished;
+} CubeWorker;
+
+static void record_result(CubeConquer* ctx, uint32_t cube, lbool result,
+                          double seconds, uint64_t conflicts) {
+    const char* status = (result == TRUE) ? "SAT" : (result == FALSE) ? "UNSAT" : "UNKNOWN";
+
+    if (ctx->opts.verbose) {
+        printf("c [Cube] %u: %s (%.2fs, %llu conflicts)\n",
+               cube, status, seconds, (unsigned long long)conflicts);
+    }
+    if (!ctx->results) return;
+
+    pthread_mutex_lock(&ctx->results_lock);
+    fprintf(ctx->results, "%u %s %.3f %llu\n",
+            cube, status, seconds, (unsigned long long)conflicts);
+    fflush(ctx->results);  // Survive a crash of the whole process
+    pthread_mutex_unlock(&ctx->results_lock);
+}
+
+static void* cube_worker_main(void* arg) {
+    CubeWorker* w = (CubeWorker*)arg;
+    CubeConquer* ctx = w->ctx;
+    const CubeSet* cubes = ctx->cubes;
+
+    SolverOpts opts = ctx->opts;
+    opts.seed = ctx->opts.seed + w->id;
+
+    // One solver per worker: cubes are solved as assumptions, so learned
+    // clauses are implied by the formula and carry over to the next cube
+    Solver* s = solver_new_with_opts(&opts);
+    if (!s || !exchange_attach(ctx->exchange, s, w->id)) {
+        solver_free(s);
+        atomic_store(&ctx->error, DIMACS_ERROR_MEMORY);
+        atomic_store(&ctx->exchange->stop, true);
+        atomic_store(&w->finished, true);
+        return NULL;
+    }
+    DimacsError err = dimacs_parse_string(s, ctx->cnf_text);
+    if (err == DIMACS_OK && cubes->max_var > s->num_vars) {
+        err = DIMACS_ERROR_FORMAT;  // Cube file does not belong to this formula
+    }
+    if (err != DIMACS_OK) {
+        s->share.exchange = NULL;
+        solver_free(s);
+        atomic_store(&ctx->error, err);
+        atomic_store(&ctx->exchange->stop, true);
+        atomic_store(&w->finished, true);
+        return NULL;
+    }
+
+    while (!exchange_should_stop(ctx->exchange)) {
+        uint32_t pos = atomic_fetch_add(&ctx->next, 1);
+        if (pos >= ctx->queue_size) break;
+        uint32_t cube = ctx->queue[pos];
+
+        const Lit* lits = &cubes->lits[cubes->start[cube]];
+        uint32_t size = cubes->start[cube + 1] - cubes->start[cube];
+
+        // Conflict, decision and tick limits count from the start of this cube
+        uint64_t conflicts = s->stats.conflicts;
+        if (opts.max_conflicts) s->opts.max_conflicts = conflicts + opts.max_conflicts;
+        if (opts.max_decisions) s->opts.max_decisions = s->stats.decisions + opts.max_decisions;
+        if (opts.max_ticks) s->opts.max_ticks = s->stats.ticks + opts.max_ticks;
+
+        double start = now_seconds();
+        lbool result = solver_solve_with_assumptions(s, lits, size);
+        double seconds = now_seconds() - start;
+
+        // Interrupted cubes are not recorded, so a resumed run retries them
+        if (result != UNDEF || !exchange_should_stop(ctx->exchange)) {
+            record_result(ctx, cube, result, seconds, s->stats.conflicts - conflicts);
+        }
+
+        if (result == TRUE) {
+            int expected = -1;
+            if (atomic_compare_exchange_strong(&ctx->exchange->winner, &expected, (int)w->id)) {
+                w->model = s;
+            }
+            atomic_store(&ctx->exchange->stop, true);
+            break;
+        }
+        if (result == FALSE) {
+            atomic_fetch_add(&ctx->refuted, 1);
+            if (s->result == FALSE) {
+                // Refuted without the cube: no other cube can be SAT either
+                atomic_store(&ctx->formula_unsat, true);
+                atomic_store(&ctx->exchange->stop, true);
+                break;
+            }
+        }
+    }
+
+    s->share.exchange = NULL;
+    if (w->model != s) solver_free(s);
+    atomic_store(&w->finished, true);
+    return NULL;
+}
+
+// Mark cubes already refuted by an earlier run (from its results file)
+static uint32_t load_finished_cubes(const char* filename, bool* done, uint32_t num_cubes) {
+    FILE* f = fopen(filename, "r");
+    if (!f) return 0;
+
+    uint32_t count = 0;
+    char line[256];
+    while (fgets(line, sizeof(line), f)) {
+        unsigned cube;
+        char status[16];
+        if (line[0] == 'c') continue;
+        if (sscanf(line, "%u %15s", &cube, status) != 2) continue;
+        if (cube < num_cubes && strcmp(status, "UNSAT") == 0 && !done[cube]) {
+            done[cube] = true;
+            count++;
+        }
+    }
+
+    fclose(f);
+    return count;
+}
+
+lbool cube_solve(const SolverOpts* opts, const char* cnf_file, const CubeSet* cubes,
+                 const CubeSolveOpts* copts, Solver** model, DimacsError* error) {
+    *model = NULL;
+    *error = DIMACS_OK;
+
+    uint32_t threads = copts->threads ? copts->threads : 1;
+    if (threads > PORTFOLIO_MAX_THREADS) threads = PORTFOLIO_MAX_THREADS;
+    uint32_t num_nodes = copts->num_nodes ? copts->num_nodes : 1;
+
+    CubeConquer ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.cubes = cubes;
+    ctx.opts = *opts;
+    ctx.opts.max_time = 0.0;   // Enforced below in wall-clock time
+    ctx.opts.quiet = true;     // One banner per cube would drown the output
+    ctx.opts.proof_path = NULL;
+    // Cube literals are assumptions over arbitrary variables; preprocessing
+    // must not remove them or the clauses that mention them
+    ctx.opts.elim = false;
+    ctx.opts.bce = false;
+
+    DimacsError read_error;
+    char* cnf_text = dimacs_read_text(cnf_file, &read_error);
+    bool* done = (bool*)calloc(cubes->num_cubes + 1, sizeof(bool));
+    ctx.queue = (uint32_t*)malloc((cubes->num_cubes + 1) * sizeof(uint32_t));
+    ctx.exchange = exchange_new(threads, SHARE_RING_SLOTS, opts->glue_lbd);
+    CubeWorker* workers = (CubeWorker*)calloc(threads, sizeof(CubeWorker));
+    if (!cnf_text || !done || !ctx.queue || !ctx.exchange || !workers) {
+        *error = cnf_text ? DIMACS_ERROR_MEMORY : read_error;
+        free(cnf_text);
+        free(done);
+        free(ctx.queue);
+        exchange_free(ctx.exchange);
+        free(workers);
+        return UNDEF;
+    }
+    ctx.cnf_text = cnf_text;
+
+    // Resume: skip cubes that an earlier run already refuted
+    if (copts->results_file) {
+        load_finished_cubes(copts->results_file, done, cubes->num_cubes);
+        ctx.results = fopen(copts->results_file, "a");
+        if (ctx.results && ftell(ctx.results) == 0) {
+            fprintf(ctx.results, "c bsat cube results: <cube> <SAT|UNSAT|UNKNOWN> <seconds> <conflicts>\n");
+        }
+    }
+
+    uint32_t owned = 0;
+    for (uint32_t i = 0; i < cubes->num_cubes; i++) {
+        if (i % num_nodes != copts->node) continue;
+        owned++;
+        if (!done[i]) ctx.queue[ctx.queue_size++] = i;
+    }
+
+    if (!opts->quiet) {
+        printf("c [Cube] %u cubes, %u owned by node %u/%u, %u already refuted, %u threads\n",
+               cubes->num_cubes, owned, copts->node, num_nodes, owned - ctx.queue_size, threads);
+        if (copts->results_file && !ctx.results) {
+            printf("c [Cube] Warning: cannot write results file %s\n", copts->results_file);
+        }
+    }
+
+    pthread_mutex_init(&ctx.results_lock, NULL);
+    atomic_init(&ctx.next, 0);
+    atomic_init(&ctx.refuted, 0);
+    atomic_init(&ctx.error, DIMACS_OK);
+    atomic_init(&ctx.formula_unsat, false);
+
+    uint32_t launched = 0;
+    for (uint32_t i = 0; i < threads; i++) {
+        CubeWorker* w = &workers[i];
+        w->id = i;
+        w->ctx = &ctx;
+        atomic_init(&w->finished, false);
+        if (pthread_create(&w->thread, NULL, cube_worker_main, w) != 0) break;
+        launched++;
+    }
+
+    // Wait for all cubes, a SAT cube, or the deadline
+    double start = now_seconds();
+    double deadline = opts->max_time > 0 ? start + opts->max_time : 0.0;
+    struct timespec poll = {0, PORTFOLIO_POLL_NSEC};
+    while (launched > 0) {
+        bool all_finished = true;
+        for (uint32_t i = 0; i < launched; i++) {
+            if (!atomic_load(&workers[i].finished)) {
+                all_finished = false;
+                break;
+            }
+        }
+        if (all_finished) break;
+
+        if (deadline > 0 && now_seconds() >= deadline) break;
+        nanosleep(&poll, NULL);
+    }
+
+    atomic_store(&ctx.exchange->stop, true);
+    for (uint32_t i = 0; i < launched; i++) {
+        pthread_join(workers[i].thread, NULL);
+    }
+
+    lbool result = UNDEF;
+    int win = atomic_load(&ctx.exchange->winner);
+    if (win >= 0) {
+        result = TRUE;
+        *model = workers[win].model;
+    } else if (atomic_load(&ctx.formula_unsat)) {
+        result = FALSE;
+    } else if (launched > 0 && num_nodes == 1 &&
+               atomic_load(&ctx.refuted) == ctx.queue_size) {
+        // Every cube refuted (now or in an earlier run): the formula is UNSAT
+        result = FALSE;
+    }
+    *error = (DimacsError)atomic_load(&ctx.error);
+
+    if (!opts->quiet) {
+        printf("c [Cube] Refuted %u of %u remaining cubes in %.2fs\n",
+               atomic_load(&ctx.refuted), ctx.queue_size, now_seconds() - start);
+    }
+
+    // A solver is still needed for statistics output
+    if (!*model && *error == DIMACS_OK) {
+        *model = solver_new_with_opts(opts);
+        if (*model && dimacs_parse_string(*model, cnf_text) != DIMACS_OK) {
+            solver_free(*model);
+            *model = NULL;
+        }
+        if (*model && result == FALSE) (*model)->result = FALSE;
+    }
+
+    if (ctx.results) fclose(ctx.results);
+    pthread_mutex_destroy(&ctx.results_lock);
+    exchange_free(ctx.exchange);
+    free(workers);
+    free(ctx.queue);
+    free(done);
+    free(cnf_text);
+
+    if (*error != DIMACS_OK) result = UNDEF;
+    return result;
+}
@@ -0,0 +1,403 @@
+/*********************************************************************
+ * BSAT Competition Solver - Streaming Decompression Implementation
+ *********************************************************************/
+
+#include "../include/decompress.h"
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef BSAT_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef BSAT_HAVE_LZMA
+#include <lzma.h>
+#endif
+#ifdef BSAT_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+// Compressed bytes read from the stream at a time
+#define DECOMPRESS_INPUT (1 << 18)
+
+struct Decompressor {
+    CompressFormat format;
+    FILE*          in;
+    unsigned char  prefix[DECOMPRESS_MAGIC_SIZE];  // Bytes read before open
+    size_t         prefix_size;
+    unsigned char* in_buf;       // Compressed input (DECOMPRESS_INPUT bytes)
+    bool           in_eof;       // Stream exhausted
+    bool           finished;     // No more output
+    bool           member_end;   // Codec reached the end of a member/frame
+    bool           error;        // Corrupt or truncated input
+
+#ifdef BSAT_HAVE_ZLIB
+    z_stream       gz;
+#endif
+#ifdef BSAT_HAVE_LZMA
+    lzma_stream    xz;
+#endif
+#ifdef BSAT_HAVE_ZSTD
+    ZSTD_DStream*  zs;
+    ZSTD_inBuffer  zin;
+#endif
+
+    // Chunk ring: the producer fills chunks[(head + count) % RING], the
+    // consumer reads chunks[head] and holds it until the next call
+    char*           chunks[DECOMPRESS_RING];
+    size_t          sizes[DECOMPRESS_RING];
+    uint32_t        head;
+    uint32_t        count;
+    bool            holding;     // Consumer owns chunks[head]
+    bool            done;        // Producer finished
+    bool            stop;        // Consumer closed early
+
+    bool            threaded;
+    pthread_t       thread;
+    pthread_mutex_t lock;
+    pthread_cond_t  cond;
+};
+
+/*********************************************************************
+ * Format Detection
+ *********************************************************************/
+
+CompressFormat decompress_detect(const unsigned char* magic, size_t size) {
+    if (size >= 2 && magic[0] == 0x1f && magic[1] == 0x8b) return COMPRESS_GZIP;
+    if (size >= 6 && memcmp(magic, "\xfd" "7zXZ\0", 6) == 0) return COMPRESS_XZ;
+    if (size >= 4 && memcmp(magic, "\x28\xb5\x2f\xfd", 4) == 0) return COMPRESS_ZSTD;
+    return COMPRESS_NONE;
+}
+
+bool decompress_supported(CompressFormat format) {
+    switch (format) {
+        case COMPRESS_NONE:
+            return true;
+#ifdef BSAT_HAVE_ZLIB
+        case COMPRESS_GZIP:
+            return true;
+#endif
+#ifdef BSAT_HAVE_LZMA
+        case COMPRESS_XZ:
+            return true;
+#endif
+#ifdef BSAT_HAVE_ZSTD
+        case COMPRESS_ZSTD:
+            return true;
+#endif
+        default:
+            return false;
+    }
+}
+
+const char* decompress_format_name(CompressFormat format) {
+    switch (format) {
+        case COMPRESS_NONE: return "none";
+        case COMPRESS_GZIP: return "gzip";
+        case COMPRESS_XZ:   return "xz";
+        case COMPRESS_ZSTD: return "zstd";
+        default:            return "unknown";
+    }
+}
+
+/*********************************************************************
+ * Codecs
+ *********************************************************************/
+
+#if defined(BSAT_HAVE_ZLIB) || defined(BSAT_HAVE_LZMA) || defined(BSAT_HAVE_ZSTD)
+// Refill the compressed input buffer (prefix first, then the stream)
+static size_t read_input(Decompressor* d) {
+    size_t n = d->prefix_size;
+    memcpy(d->in_buf, d->prefix, n);
+    d->prefix_size = 0;
+    n += fread(d->in_buf + n, 1, DECOMPRESS_INPUT - n, d->in);
+    if (n == 0) d->in_eof = true;
+    return n;
+}
+#endif
+
+#ifdef BSAT_HAVE_ZLIB
+// gzip files may hold several members; each one restarts the inflater
+static size_t gzip_fill(Decompressor* d, char* out, size_t cap) {
+    z_stream* z = &d->gz;
+    z->next_out = (Bytef*)out;
+    z->avail_out = (uInt)cap;
+    while (z->avail_out > 0) {
+        if (z->avail_in == 0) {
+            size_t n = read_input(d);
+            if (n == 0) {
+                if (!d->member_end) d->error = true;  // Truncated
+                d->finished = true;
+                break;
+            }
+            z->next_in = d->in_buf;
+            z->avail_in = (uInt)n;
+        }
+        if (d->member_end) {
+            inflateReset(z);
+            d->member_end = false;
+        }
+        int ret = inflate(z, Z_NO_FLUSH);
+        if (ret == Z_STREAM_END) {
+            d->member_end = true;
+        } else if (ret != Z_OK) {
+            d->error = true;
+            d->finished = true;
+            break;
+        }
+    }
+    return cap - z->avail_out;
+}
+#endif
+
+#ifdef BSAT_HAVE_LZMA
+static size_t xz_fill(Decompressor* d, char* out, size_t cap) {
+    lzma_stream* x = &d->xz;
+    x->next_out = (uint8_t*)out;
+    x->avail_out = cap;
+    while (x->avail_out > 0) {
+        if (x->avail_in == 0 && !d->in_eof) {
+            x->avail_in = read_input(d);
+            x->next_in = d->in_buf;
+        }
+        // Concatenated streams end only when told there is no more input
+        lzma_ret ret = lzma_code(x, d->in_eof ? LZMA_FINISH : LZMA_RUN);
+        if (ret == LZMA_STREAM_END) {
+            d->finished = true;
+            break;
+        }
+        if (ret != LZMA_OK) {
+            d->error = true;  // Corrupt, or LZMA_BUF_ERROR when truncated
+            d->finished = true;
+            break;
+        }
+    }
+    return cap - x->avail_out;
+}
+#endif
+
+#ifdef BSAT_HAVE_ZSTD
+static size_t zstd_fill(Decompressor* d, char* out, size_t cap) {
+    ZSTD_outBuffer ob = { out, cap, 0 };
+    while (ob.pos < ob.size) {
+        if (d->zin.pos == d->zin.size) {
+            size_t n = read_input(d);
+            if (n == 0) {
+                if (!d->member_end) d->error = true;  // Frame not complete
+                d->finished = true;
+                break;
+            }
+            d->zin.src = d->in_buf;
+            d->zin.size = n;
+            d->zin.pos = 0;
+        }
+        size_t ret = ZSTD_decompressStream(d->zs, &ob, &d->zin);
+        if (ZSTD_isError(ret)) {
+            d->error = true;
+            d->finished = true;
+            break;
+        }
+        d->member_end = (ret == 0);
+    }
+    return ob.pos;
+}
+#endif
+
+// Decompress up to cap bytes; 0 means end of input or error
+static size_t codec_fill(Decompressor* d, char* out, size_t cap) {
+    (void)out;  // Unused without codecs
+    (void)cap;
+    if (d->finished) return 0;
+    switch (d->format) {
+#ifdef BSAT_HAVE_ZLIB
+        case COMPRESS_GZIP:
+            return gzip_fill(d, out, cap);
+#endif
+#ifdef BSAT_HAVE_LZMA
+        case COMPRESS_XZ:
+            return xz_fill(d, out, cap);
+#endif
+#ifdef BSAT_HAVE_ZSTD
+        case COMPRESS_ZSTD:
+            return zstd_fill(d, out, cap);
+#endif
+        default:
+            return 0;
+    }
+}
+
+static bool codec_init(Decompressor* d) {
+    switch (d->format) {
+#ifdef BSAT_HAVE_ZLIB
+        case COMPRESS_GZIP:
+            // 16 + MAX_WBITS: expect a gzip header
+            return inflateInit2(&d->gz, 16 + MAX_WBITS) == Z_OK;
+#endif
+#ifdef BSAT_HAVE_LZMA
+        case COMPRESS_XZ: {
+            lzma_stream init = LZMA_STREAM_INIT;
+            d->xz = init;
+            return lzma_stream_decoder(&d->xz, UINT64_MAX, LZMA_CONCATENATED) == LZMA_OK;
+        }
+#endif
+#ifdef BSAT_HAVE_ZSTD
+        case COMPRESS_ZSTD:
+            d->zs = ZSTD_createDStream();
+            return d->zs && !ZSTD_isError(ZSTD_initDStream(d->zs));
+#endif
+        default:
+            return false;
+    }
+}
+
+static void codec_free(Decompressor* d) {
+    switch (d->format) {
+#ifdef BSAT_HAVE_ZLIB
+        case COMPRESS_GZIP:
+            inflateEnd(&d->gz);
+            break;
+#endif
+#ifdef BSAT_HAVE_LZMA
+        case COMPRESS_XZ:
+            lzma_end(&d->xz);
+            break;
+#endif
+#ifdef BSAT_HAVE_ZSTD
+        case COMPRESS_ZSTD:
+            ZSTD_freeDStream(d->zs);
+            break;
+#endif
+        default:
+            break;
+    }
+}
+
+/*********************************************************************
+ * Producer Thread
+ *********************************************************************/
+
+static void* producer_main(void* arg) {
+    Decompressor* d = (Decompressor*)arg;
+
+    for (;;) {
+        pthread_mutex_lock(&d->lock);
+        while (d->count == DECOMPRESS_RING && !d->stop) {
+            pthread_cond_wait(&d->cond, &d->lock);
+        }
+        if (d->stop) {
+            pthread_mutex_unlock(&d->lock);
+            break;
+        }
+        uint32_t slot = (d->head + d->count) % DECOMPRESS_RING;
+        pthread_mutex_unlock(&d->lock);
+
+        // Decompress outside the lock while the consumer parses
+        size_t n = codec_fill(d, d->chunks[slot], DECOMPRESS_CHUNK);
+
+        pthread_mutex_lock(&d->lock);
+        if (n > 0) {
+            d->sizes[slot] = n;
+            d->count++;
+        } else {
+            d->done = true;
+        }
+        pthread_cond_broadcast(&d->cond);
+        pthread_mutex_unlock(&d->lock);
+
+        if (n == 0) break;
+    }
+    return NULL;
+}
+
+/*********************************************************************
+ * Public API
+ *********************************************************************/
+
+Decompressor* decompress_open(FILE* in, CompressFormat format,
+                              const unsigned char* prefix, size_t prefix_size) {
+    if (!in || format == COMPRESS_NONE || !decompress_supported(format)) return NULL;
+    if (prefix_size > DECOMPRESS_MAGIC_SIZE) return NULL;
+
+    Decompressor* d = (Decompressor*)calloc(1, sizeof(Decompressor));
+    if (!d) return NULL;
+    d->format = format;
+    d->in = in;
+    if (prefix_size > 0) memcpy(d->prefix, prefix, prefix_size);
+    d->prefix_size = prefix_size;
+
+    d->in_buf = (unsigned char*)malloc(DECOMPRESS_INPUT);
+    bool ok = d->in_buf != NULL;
+    for (int i = 0; i < DECOMPRESS_RING && ok; i++) {
+        d->chunks[i] = (char*)malloc(DECOMPRESS_CHUNK);
+        ok = d->chunks[i] != NULL;
+    }
+    if (!ok || !codec_init(d)) {
+        if (ok) codec_free(d);
+        for (int i = 0; i < DECOMPRESS_RING; i++) free(d->chunks[i]);
+        free(d->in_buf);
+        free(d);
+        return NULL;
+    }
+
+    pthread_mutex_init(&d->lock, NULL);
+    pthread_cond_init(&d->cond, NULL);
+
+    // Without a thread the consumer decompresses on demand
+    d->threaded = pthread_create(&d->thread, NULL, producer_main, d) == 0;
+    return d;
+}
+
+const char* decompress_next(Decompressor* d, size_t* size) {
+    *size = 0;
+    if (!d) return NULL;
+
+    if (!d->threaded) {
+        size_t n = codec_fill(d, d->chunks[0], DECOMPRESS_CHUNK);
+        *size = n;
+        return n > 0 ? d->chunks[0] : NULL;
+    }
+
+    pthread_mutex_lock(&d->lock);
+    if (d->holding) {
+        // Give the previous chunk back to the producer
+        d->head = (d->head + 1) % DECOMPRESS_RING;
+        d->count--;
+        d->holding = false;
+        pthread_cond_broadcast(&d->cond);
+    }
+    while (d->count == 0 && !d->done) {
+        pthread_cond_wait(&d->cond, &d->lock);
+    }
+    const char* chunk = NULL;
+    if (d->count > 0) {
+        d->holding = true;
+        chunk = d->chunks[d->head];
+        *size = d->sizes[d->head];
+    }
+    pthread_mutex_unlock(&d->lock);
+    return chunk;
+}
+
+bool decompress_failed(const Decompressor* d) {
+    return d && d->error;
+}
+
+void decompress_close(Decompressor* d) {
+    if (!d) return;
+
+    if (d->threaded) {
+        pthread_mutex_lock(&d->lock);
+        d->stop = true;
+        pthread_cond_broadcast(&d->cond);
+        pthread_mutex_unlock(&d->lock);
+        pthread_join(d->thread, NULL);
+    }
+    pthread_cond_destroy(&d->cond);
+    pthread_mutex_destroy(&d->lock);
+
+    codec_free(d);
+    for (int i = 0; i < DECOMPRESS_RING; i++) free(d->chunks[i]);
+    free(d->in_buf);
+    free(d);
+}
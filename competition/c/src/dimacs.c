@@ -2,239 +2,392 @@
  * BSAT Competition Solver - DIMACS CNF Parser Implementation
  *********************************************************************/
 
+#define _POSIX_C_SOURCE 200809L  // mmap, posix_madvise, fdopen, pread
+
 #include "../include/dimacs.h"
 #include "../include/arena.h"
+#include "../include/decompress.h"
 #include <stdlib.h>
 #include <string.h>
-#include <ctype.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
-// Maximum line length for reading
-#define MAX_LINE 1048576  // 1MB should be enough for any line
+// Refill size for stream input
+#define READ_CHUNK (1 << 20)
 
-// Temporary buffer for clause literals
-#define MAX_CLAUSE_SIZE 100000
+// Initial capacity of the clause buffer (grows for longer clauses)
+#define CLAUSE_INITIAL_CAPACITY 64
 
 /*********************************************************************
- * Helper Functions
+ * Token Reader
  *********************************************************************/
 
-// Skip whitespace
-static const char* skip_whitespace(const char* p) {
-    while (isspace(*p)) p++;
-    return p;
+// Tokens are scanned straight from memory without line boundaries. The
+// input is either one chunk (memory map, string), refilled from a stream,
+// or handed out chunk by chunk by a decompressor.
+typedef struct DimacsReader {
+    const char*   p;     // Next unread byte
+    const char*   end;   // End of the current chunk
+    FILE*         file;  // Stream to refill from (NULL = single chunk)
+    char*         buf;   // Refill buffer (READ_CHUNK bytes)
+    Decompressor* dec;   // Decompressed chunks (used in place)
+} DimacsReader;
+
+static bool reader_refill(DimacsReader* r) {
+    if (r->dec) {
+        size_t n;
+        const char* chunk = decompress_next(r->dec, &n);
+        r->p = chunk;
+        r->end = chunk ? chunk + n : NULL;
+        return chunk != NULL;
+    }
+    if (!r->file) return false;
+    size_t n = fread(r->buf, 1, READ_CHUNK, r->file);
+    r->p = r->buf;
+    r->end = r->buf + n;
+    return n > 0;
 }
 
-// Skip rest of line
-static const char* skip_line(const char* p) {
-    while (*p && *p != '\n') p++;
-    if (*p == '\n') p++;
-    return p;
+// Next byte without consuming it (EOF at end of input)
+static inline int reader_peek(DimacsReader* r) {
+    if (r->p == r->end && !reader_refill(r)) return EOF;
+    return (unsigned char)*r->p;
 }
 
-// Parse integer
-static const char* parse_int(const char* p, int* value) {
-    p = skip_whitespace(p);
+static inline bool is_space(int ch) {
+    return ch == ' ' || ch == '\n' || ch == '\t' || ch == '\r' || ch == '\v' || ch == '\f';
+}
 
-    int sign = 1;
-    if (*p == '-') {
-        sign = -1;
-        p++;
-    } else if (*p == '+') {
-        p++;
-    }
+// Skip whitespace and return the next byte
+static inline int skip_whitespace(DimacsReader* r) {
+    int ch;
+    while ((ch = reader_peek(r)) != EOF && is_space(ch)) r->p++;
+    return ch;
+}
 
-    if (!isdigit(*p)) {
-        return NULL;  // Not a number
+// Skip the rest of the line, including the newline
+static void skip_line(DimacsReader* r) {
+    for (;;) {
+        if (r->p == r->end && !reader_refill(r)) return;
+        const char* nl = (const char*)memchr(r->p, '\n', (size_t)(r->end - r->p));
+        if (nl) {
+            r->p = nl + 1;
+            return;
+        }
+        r->p = r->end;
     }
+}
 
-    int val = 0;
-    while (isdigit(*p)) {
-        val = val * 10 + (*p - '0');
-        p++;
+// Parse a decimal integer at the current position. Values above limit
+// set *too_large (the digits are still consumed). The token must end at
+// whitespace or end of input.
+static inline bool read_int(DimacsReader* r, uint32_t limit, int64_t* value, bool* too_large) {
+    int ch = reader_peek(r);
+    bool negative = false;
+    if (ch == '-' || ch == '+') {
+        negative = (ch == '-');
+        r->p++;
+        ch = reader_peek(r);
     }
+    if (ch < '0' || ch > '9') return false;
+
+    int64_t v = 0;
+    do {
+        if (v <= (int64_t)limit) v = v * 10 + (ch - '0');
+        r->p++;
+        ch = reader_peek(r);
+    } while (ch >= '0' && ch <= '9');
 
-    *value = sign * val;
-    return p;
+    if (ch != EOF && !is_space(ch)) return false;
+    if (v > (int64_t)limit) *too_large = true;
+
+    *value = negative ? -v : v;
+    return true;
 }
 
 /*********************************************************************
  * Main Parser
  *********************************************************************/
 
-DimacsError dimacs_parse_stream(Solver* s, FILE* file) {
-    if (!s || !file) {
-        return DIMACS_ERROR_FILE;
+// "p cnf <vars> <clauses>": create the variables and reserve space for the
+// clauses in one go, so that clause insertion never reallocates
+static DimacsError parse_header(Solver* s, DimacsReader* r) {
+    r->p++;  // 'p'
+    skip_whitespace(r);
+    const char* word = "cnf";
+    for (int i = 0; i < 3; i++) {
+        if (reader_peek(r) != word[i]) return DIMACS_ERROR_FORMAT;
+        r->p++;
     }
 
-    char* line = (char*)malloc(MAX_LINE);
-    if (!line) {
+    int64_t nvars, nclauses;
+    bool too_large = false;
+    skip_whitespace(r);
+    if (!read_int(r, MAX_VARS, &nvars, &too_large) || nvars < 0) return DIMACS_ERROR_FORMAT;
+    skip_whitespace(r);
+    if (!read_int(r, MAX_CLAUSES, &nclauses, &too_large) || nclauses < 0) return DIMACS_ERROR_FORMAT;
+    if (too_large) return DIMACS_ERROR_FORMAT;
+
+    if (!solver_reserve(s, (uint32_t)nvars, (uint32_t)nclauses)) {
         return DIMACS_ERROR_MEMORY;
     }
+    while (s->num_vars < (uint32_t)nvars) {
+        solver_new_var(s);
+    }
+
+    // Reserve arena capacity based on problem size
+    size_t estimated_capacity = estimate_arena_size((uint32_t)nclauses, (uint32_t)nvars);
+    if (!arena_reserve(s->arena, estimated_capacity)) {
+        return DIMACS_ERROR_MEMORY;
+    }
+
+    return DIMACS_OK;
+}
+
+// XOR lines read so far, each as its size followed by its literals
+typedef struct XorBuffer {
+    Lit*   data;
+    size_t size;
+    size_t capacity;
+} XorBuffer;
+
+static bool xor_buffer_push(XorBuffer* b, const Lit* lits, uint32_t size) {
+    if (b->size + size + 1 > b->capacity) {
+        size_t new_cap = b->capacity ? b->capacity : 256;
+        while (new_cap < b->size + size + 1) new_cap *= 2;
+        Lit* data = (Lit*)realloc(b->data, new_cap * sizeof(Lit));
+        if (!data) return false;
+        b->data = data;
+        b->capacity = new_cap;
+    }
+    b->data[b->size++] = size;
+    memcpy(&b->data[b->size], lits, size * sizeof(Lit));
+    b->size += size;
+    return true;
+}
 
-    Lit* clause = (Lit*)malloc(MAX_CLAUSE_SIZE * sizeof(Lit));
+static DimacsError parse_reader(Solver* s, DimacsReader* r) {
+    uint32_t capacity = CLAUSE_INITIAL_CAPACITY;
+    Lit* clause = (Lit*)malloc(capacity * sizeof(Lit));
     if (!clause) {
-        free(line);
         return DIMACS_ERROR_MEMORY;
     }
 
-    uint32_t expected_vars = 0;
-    uint32_t expected_clauses = 0;
+    uint32_t clause_size = 0;
     uint32_t parsed_clauses = 0;
     bool header_found = false;
-
     DimacsError result = DIMACS_OK;
 
-    // Read line by line
-    while (fgets(line, MAX_LINE, file)) {
-        #ifdef DEBUG
-        if (IS_DEBUG(s)) {
-            printf("[DIMACS] Read line: %s", line);
-        }
-        #endif
-        const char* p = skip_whitespace(line);
+    // XOR lines ("x1 -2 3 0", as in CryptoMiniSat) are encoded after the
+    // clauses, so their auxiliary variables follow every input variable
+    XorBuffer xors = { NULL, 0, 0 };
+    bool in_xor = false;
 
-        // Skip empty lines
-        if (*p == '\0' || *p == '\n') {
-            continue;
-        }
+    for (;;) {
+        int ch = skip_whitespace(r);
+        if (ch == EOF) break;
 
-        // Skip comments (except special ones)
-        if (*p == 'c') {
-            // Could parse special comments here (e.g., "c ind" for independent set)
+        // Comments (and "c ..." lines between literals of a clause)
+        if (ch == 'c') {
+            skip_line(r);
             continue;
         }
 
-        // Parse header
-        if (*p == 'p') {
+        // Header: clauses before it are accepted for lenient parsing
+        if (ch == 'p') {
             if (header_found) {
                 result = DIMACS_ERROR_FORMAT;  // Multiple headers
                 goto cleanup;
             }
+            header_found = true;
+            result = parse_header(s, r);
+            if (result != DIMACS_OK) goto cleanup;
+            continue;
+        }
 
-            p = skip_whitespace(p + 1);
+        // SATLIB files end with a "%" line
+        if (ch == '%') break;
 
-            // Check for "cnf"
-            if (strncmp(p, "cnf", 3) != 0) {
+        if (ch == 'x') {
+            if (in_xor || clause_size > 0) {
                 result = DIMACS_ERROR_FORMAT;
                 goto cleanup;
             }
-            p += 3;
+            in_xor = true;
+            r->p++;
+            continue;
+        }
 
-            // Parse number of variables
-            int nvars;
-            p = parse_int(p, &nvars);
-            if (!p || nvars < 0 || nvars > MAX_VARS) {
-                result = DIMACS_ERROR_FORMAT;
-                goto cleanup;
-            }
-            expected_vars = (uint32_t)nvars;
+        int64_t lit;
+        bool too_large = false;
+        if (!read_int(r, MAX_VARS, &lit, &too_large)) {
+            result = DIMACS_ERROR_FORMAT;
+            goto cleanup;
+        }
+        if (too_large) {
+            result = DIMACS_ERROR_SIZE;
+            goto cleanup;
+        }
 
-            // Parse number of clauses
-            int nclauses;
-            p = parse_int(p, &nclauses);
-            if (!p || nclauses < 0 || nclauses > MAX_CLAUSES) {
-                result = DIMACS_ERROR_FORMAT;
+        if (lit == 0 && in_xor) {
+            if (!xor_buffer_push(&xors, clause, clause_size)) {
+                result = DIMACS_ERROR_MEMORY;
                 goto cleanup;
             }
-            expected_clauses = (uint32_t)nclauses;
-
-            header_found = true;
+            in_xor = false;
+            clause_size = 0;
+            continue;
+        }
 
-            // Ensure we have enough variables
-            while (s->num_vars < expected_vars) {
-                solver_new_var(s);
+        if (lit == 0) {
+            // End of clause
+            #ifdef DEBUG
+            if (IS_DEBUG(s)) {
+                printf("[DIMACS] Adding clause %u with %u literals\n", parsed_clauses + 1, clause_size);
             }
+            #endif
+            // An empty clause makes the solver UNSAT; keep parsing to validate format
+            solver_add_clause(s, clause, clause_size);
+            parsed_clauses++;
+            clause_size = 0;
+            continue;
+        }
 
-            // Reserve arena capacity based on problem size
-            size_t estimated_capacity = estimate_arena_size(expected_clauses, expected_vars);
-            if (!arena_reserve(s->arena, estimated_capacity)) {
+        // Ensure variable exists
+        Var v = (Var)(lit < 0 ? -lit : lit);
+        while (s->num_vars < v) {
+            solver_new_var(s);
+        }
+
+        if (clause_size == capacity) {
+            capacity *= 2;
+            Lit* grown = (Lit*)realloc(clause, capacity * sizeof(Lit));
+            if (!grown) {
                 result = DIMACS_ERROR_MEMORY;
                 goto cleanup;
             }
-
-            continue;
+            clause = grown;
         }
+        clause[clause_size++] = mkLit(v, lit < 0);
+    }
 
-        // Parse clause
-        if (!header_found) {
-            // Allow clauses before header for lenient parsing
-            // Deduce problem size from clauses
+    // Last clause without terminating 0
+    if (in_xor) {
+        if (!xor_buffer_push(&xors, clause, clause_size)) {
+            result = DIMACS_ERROR_MEMORY;
+            goto cleanup;
         }
+    } else if (clause_size > 0) {
+        solver_add_clause(s, clause, clause_size);
+        parsed_clauses++;
+    }
 
-        uint32_t clause_size = 0;
-        const char* clause_start = p;
+    for (size_t i = 0; i < xors.size; i += 1 + xors.data[i]) {
+        solver_add_xor(s, &xors.data[i + 1], xors.data[i]);
+    }
 
-        while (*p) {
-            int lit;
-            const char* next = parse_int(p, &lit);
+cleanup:
+    free(xors.data);
+    free(clause);
+    return result;
+}
 
-            if (!next) {
-                // Check if line continues
-                if (strchr(p, '\n')) {
-                    break;  // End of line, incomplete clause
-                }
-                result = DIMACS_ERROR_FORMAT;
-                goto cleanup;
-            }
+DimacsError dimacs_parse_buffer(Solver* s, const char* data, size_t size) {
+    if (!s || (!data && size > 0)) {
+        return DIMACS_ERROR_FILE;
+    }
 
-            p = next;
+    DimacsReader r = { data, data + size, NULL, NULL, NULL };
+    return parse_reader(s, &r);
+}
 
-            if (lit == 0) {
-                // End of clause
-                break;
-            }
+// Parse compressed input, decompressed on a separate thread
+static DimacsError parse_compressed(Solver* s, FILE* file, CompressFormat format,
+                                    const unsigned char* magic, size_t magic_size) {
+    if (!decompress_supported(format)) {
+        return DIMACS_ERROR_COMPRESSION;
+    }
 
-            // Ensure variable exists
-            Var v = abs(lit);
-            if (v > MAX_VARS) {
-                result = DIMACS_ERROR_SIZE;
-                goto cleanup;
-            }
+    Decompressor* dec = decompress_open(file, format, magic, magic_size);
+    if (!dec) {
+        return DIMACS_ERROR_MEMORY;
+    }
 
-            while (s->num_vars < v) {
-                solver_new_var(s);
-            }
+    DimacsReader r = { NULL, NULL, NULL, NULL, dec };
+    DimacsError result = parse_reader(s, &r);
+    if (decompress_failed(dec)) {
+        result = DIMACS_ERROR_COMPRESSION;
+    } else if (result == DIMACS_OK && ferror(file)) {
+        result = DIMACS_ERROR_FILE;
+    }
 
-            // Add literal to clause
-            if (clause_size >= MAX_CLAUSE_SIZE) {
-                result = DIMACS_ERROR_SIZE;
-                goto cleanup;
-            }
-            clause[clause_size++] = fromDimacs(lit);
-        }
+    decompress_close(dec);
+    return result;
+}
 
-        // Add clause to solver
-        if (clause_size > 0) {
-            #ifdef DEBUG
-            if (IS_DEBUG(s)) {
-                printf("[DIMACS] Adding clause %u with %u literals\n", parsed_clauses + 1, clause_size);
-            }
-            #endif
-            if (!solver_add_clause(s, clause, clause_size)) {
-                // Solver detected UNSAT during clause addition (empty clause)
-                // This is OK, continue parsing to validate format
-            }
-            parsed_clauses++;
-        }
+DimacsError dimacs_parse_stream(Solver* s, FILE* file) {
+    if (!s || !file) {
+        return DIMACS_ERROR_FILE;
     }
 
-    // Check if we got the expected number of clauses (warning only)
-    if (header_found && parsed_clauses != expected_clauses) {
-        // This is common in competition instances, just warn
-        // fprintf(stderr, "Warning: expected %u clauses but parsed %u\n",
-        //         expected_clauses, parsed_clauses);
+    // The magic bytes select plain or compressed input
+    unsigned char magic[DECOMPRESS_MAGIC_SIZE];
+    size_t magic_size = fread(magic, 1, sizeof(magic), file);
+    CompressFormat format = decompress_detect(magic, magic_size);
+    if (format != COMPRESS_NONE) {
+        return parse_compressed(s, file, format, magic, magic_size);
     }
 
-cleanup:
-    free(clause);
-    free(line);
+    char* buf = (char*)malloc(READ_CHUNK);
+    if (!buf) {
+        return DIMACS_ERROR_MEMORY;
+    }
+
+    // First chunk starts with the bytes already read
+    memcpy(buf, magic, magic_size);
+    size_t n = magic_size + fread(buf + magic_size, 1, READ_CHUNK - magic_size, file);
+
+    DimacsReader r = { buf, buf + n, file, buf, NULL };
+    DimacsError result = parse_reader(s, &r);
+    if (result == DIMACS_OK && ferror(file)) {
+        result = DIMACS_ERROR_FILE;
+    }
+
+    free(buf);
     return result;
 }
 
 DimacsError dimacs_parse_file(Solver* s, const char* filename) {
-    FILE* file = fopen(filename, "r");
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        return DIMACS_ERROR_FILE;
+    }
+
+    // Fast path: plain regular files are memory-mapped and scanned in place
+    struct stat st;
+    unsigned char magic[DECOMPRESS_MAGIC_SIZE];
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        ssize_t got = pread(fd, magic, sizeof(magic), 0);
+        if (got >= 0 && decompress_detect(magic, (size_t)got) == COMPRESS_NONE) {
+            size_t size = (size_t)st.st_size;
+            void* data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data != MAP_FAILED) {
+                close(fd);
+                posix_madvise(data, size, POSIX_MADV_SEQUENTIAL);
+                DimacsError result = dimacs_parse_buffer(s, (const char*)data, size);
+                munmap(data, size);
+                return result;
+            }
+        }
+    }
+
+    // Compressed input, pipes, devices, empty files or failed mappings are streamed
+    FILE* file = fdopen(fd, "r");
     if (!file) {
+        close(fd);
         return DIMACS_ERROR_FILE;
     }
 
@@ -243,20 +396,83 @@ DimacsError dimacs_parse_file(Solver* s, const char* filename) {
     return result;
 }
 
+// Append n bytes to a growing text buffer (keeps room for the NUL)
+static bool text_append(char** buf, size_t* len, size_t* cap, const char* data, size_t n) {
+    if (*len + n + 1 > *cap) {
+        size_t new_cap = *cap ? *cap : (1 << 16);
+        while (*len + n + 1 > new_cap) new_cap *= 2;
+        char* grown = (char*)realloc(*buf, new_cap);
+        if (!grown) return false;
+        *buf = grown;
+        *cap = new_cap;
+    }
+    memcpy(*buf + *len, data, n);
+    *len += n;
+    return true;
+}
+
+char* dimacs_read_text(const char* filename, DimacsError* error) {
+    *error = DIMACS_OK;
+    FILE* file = fopen(filename, "rb");
+    if (!file) {
+        *error = DIMACS_ERROR_FILE;
+        return NULL;
+    }
+
+    char* buf = NULL;
+    size_t len = 0, cap = 0;
+    bool ok = true;
+
+    unsigned char magic[DECOMPRESS_MAGIC_SIZE];
+    size_t magic_size = fread(magic, 1, sizeof(magic), file);
+    CompressFormat format = decompress_detect(magic, magic_size);
+
+    if (format == COMPRESS_NONE) {
+        char chunk[1 << 16];
+        ok = text_append(&buf, &len, &cap, (const char*)magic, magic_size);
+        size_t n;
+        while (ok && (n = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+            ok = text_append(&buf, &len, &cap, chunk, n);
+        }
+        if (!ok) *error = DIMACS_ERROR_MEMORY;
+        else if (ferror(file)) *error = DIMACS_ERROR_FILE;
+    } else if (!decompress_supported(format)) {
+        *error = DIMACS_ERROR_COMPRESSION;
+    } else {
+        Decompressor* dec = decompress_open(file, format, magic, magic_size);
+        if (!dec) {
+            *error = DIMACS_ERROR_MEMORY;
+        } else {
+            const char* chunk;
+            size_t n;
+            while (ok && (chunk = decompress_next(dec, &n)) != NULL) {
+                ok = text_append(&buf, &len, &cap, chunk, n);
+            }
+            if (!ok) *error = DIMACS_ERROR_MEMORY;
+            else if (decompress_failed(dec)) *error = DIMACS_ERROR_COMPRESSION;
+            decompress_close(dec);
+        }
+    }
+    fclose(file);
+
+    // Empty files still give an empty string
+    if (*error == DIMACS_OK && !text_append(&buf, &len, &cap, "", 0)) {
+        *error = DIMACS_ERROR_MEMORY;
+    }
+    if (*error != DIMACS_OK) {
+        free(buf);
+        return NULL;
+    }
+    buf[len] = '\0';
+    return buf;
+}
+
 DimacsError dimacs_parse_string(Solver* s, const char* str) {
     if (!s || !str) {
         return DIMACS_ERROR_FILE;
     }
 
-    // Create a memory stream
-    FILE* stream = fmemopen((void*)str, strlen(str), "r");
-    if (!stream) {
-        return DIMACS_ERROR_MEMORY;
-    }
-
-    DimacsError result = dimacs_parse_stream(s, stream);
-    fclose(stream);
-    return result;
+    return dimacs_parse_buffer(s, str, strlen(str));
 }
 
 /*********************************************************************
@@ -275,6 +491,8 @@ const char* dimacs_error_string(DimacsError err) {
             return "Out of memory";
         case DIMACS_ERROR_SIZE:
             return "Problem too large";
+        case DIMACS_ERROR_COMPRESSION:
+            return "Corrupt or unsupported compressed input";
         default:
             return "Unknown error";
     }
@@ -284,31 +502,99 @@ const char* dimacs_error_string(DimacsError err) {
  * Output Functions
  *********************************************************************/
 
-void dimacs_write_solution(const Solver* s, FILE* out) {
-    if (s->result == TRUE) {
-        fprintf(out, "s SATISFIABLE\n");
-        fprintf(out, "v ");
-
-        for (Var v = 1; v <= s->num_vars; v++) {
-            lbool val = solver_model_value(s, v);
-            if (val == TRUE) {
-                fprintf(out, "%u ", v);
-            } else if (val == FALSE) {
-                fprintf(out, "-%u ", v);
-            }
-            // Skip UNDEF variables
+// Model lines are formatted into a buffer and written with one fwrite
+// per buffer. Variables come in order, so the decimal digits of v are
+// kept in a small array and incremented in place instead of being
+// converted for every variable.
+#define MODEL_BUFFER (1 << 16)
+#define MODEL_LITS_PER_LINE 20
+
+void dimacs_write_model(const Solver* s, FILE* out) {
+    char buf[MODEL_BUFFER];
+    char* p = buf;
+    char* limit = buf + MODEL_BUFFER - 32;  // Room for one literal and a line break
+
+    char digits[12];
+    char* first = &digits[sizeof(digits) - 1];  // Digits of v are first .. end
+    char* end = &digits[sizeof(digits)];
+    *first = '0';
+
+    *p++ = 'v';
+    *p++ = ' ';
+    for (Var v = 1; v <= solver_input_vars(s); v++) {
+        // v = v - 1 + 1 in decimal
+        char* d = end - 1;
+        while (d >= first && *d == '9') *d-- = '0';
+        if (d < first) {
+            first = d;
+            *d = '1';
+        } else {
+            (*d)++;
+        }
 
-            // Line wrapping
-            if (v % 20 == 0) {
-                fprintf(out, "\nv ");
-            }
+        if (solver_model_value(s, v) != TRUE) *p++ = '-';
+        memcpy(p, first, (size_t)(end - first));
+        p += end - first;
+        *p++ = ' ';
+
+        if (v % MODEL_LITS_PER_LINE == 0) {
+            memcpy(p, "\nv ", 3);
+            p += 3;
         }
-        fprintf(out, "0\n");
+        if (p >= limit) {
+            fwrite(buf, 1, (size_t)(p - buf), out);
+            p = buf;
+        }
+    }
+    *p++ = '0';
+    *p++ = '\n';
+    fwrite(buf, 1, (size_t)(p - buf), out);
+}
+
+void dimacs_write_solution(const Solver* s, FILE* out) {
+    if (s->result == TRUE) {
+        fputs("s SATISFIABLE\n", out);
+        dimacs_write_model(s, out);
     } else if (s->result == FALSE) {
-        fprintf(out, "s UNSATISFIABLE\n");
+        fputs("s UNSATISFIABLE\n", out);
     } else {
-        fprintf(out, "s UNKNOWN\n");
+        fputs("s UNKNOWN\n", out);
+    }
+}
+
+static void put_le32(unsigned char* p, uint32_t x) {
+    p[0] = (unsigned char)x;
+    p[1] = (unsigned char)(x >> 8);
+    p[2] = (unsigned char)(x >> 16);
+    p[3] = (unsigned char)(x >> 24);
+}
+
+bool dimacs_write_model_binary(const Solver* s, const char* filename) {
+    FILE* out = fopen(filename, "wb");
+    if (!out) return false;
+
+    unsigned char header[MODEL_BINARY_HEADER] = {0};
+    memcpy(header, MODEL_BINARY_MAGIC, 8);
+    uint32_t num_vars = solver_input_vars(s);
+    put_le32(&header[8], num_vars);
+    bool ok = fwrite(header, 1, sizeof(header), out) == sizeof(header);
+
+    // Eight variables per byte, written a buffer at a time
+    unsigned char buf[MODEL_BUFFER];
+    uint32_t n = 0;
+    for (Var base = 1; ok && base <= num_vars; base += 8) {
+        unsigned char byte = 0;
+        for (uint32_t bit = 0; bit < 8 && base + bit <= num_vars; bit++) {
+            if (solver_model_value(s, base + bit) == TRUE) byte |= (unsigned char)(1u << bit);
+        }
+        buf[n++] = byte;
+        if (n == sizeof(buf)) {
+            ok = fwrite(buf, 1, n, out) == n;
+            n = 0;
+        }
     }
+    if (ok && n > 0) ok = fwrite(buf, 1, n, out) == n;
+    return fclose(out) == 0 && ok;
 }
 
 void dimacs_write_proof(const Solver* s, FILE* out) {
@@ -323,6 +609,7 @@ void dimacs_write_cnf(const Solver* s, FILE* out) {
     // Write only original clauses
     for (uint32_t i = 0; i < s->num_clauses; i++) {
         CRef cref = s->clauses[i];
+        if (cref == INVALID_CLAUSE) continue;
         if (!clause_learned(s->arena, cref)) {
             uint32_t size = CLAUSE_SIZE(s->arena, cref);
             Lit* lits = CLAUSE_LITS(s->arena, cref);
@@ -6,12 +6,17 @@
  *            Variable and Clause Elimination" (SAT 2005)
  *********************************************************************/
 
+#define _POSIX_C_SOURCE 200809L  // clock_gettime, sysconf
+
 #include "../include/elim.h"
 #include "../include/solver.h"
+#include "../include/timer.h"
+#include <pthread.h>
+#include <stdatomic.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
-#include <limits.h>
+#include <unistd.h>
 
 /*********************************************************************
  * Initial Capacity Constants
@@ -28,131 +33,302 @@
 extern void proof_add_clause(Solver* s, const Lit* lits, uint32_t size);
 extern void proof_delete_clause(Solver* s, const Lit* lits, uint32_t size);
 
+// Append to the solver's clause list (defined in solver.c)
+extern bool clauses_push(Solver* s, CRef cref);
+
+/*********************************************************************
+ * Helper Functions
+ *********************************************************************/
+
+// Variable signature: one bit per variable class
+uint64_t clause_signature(const Lit* lits, uint32_t size) {
+    uint64_t sig = 0;
+    for (uint32_t i = 0; i < size; i++) sig |= 1ULL << (var(lits[i]) & 63);
+    return sig;
+}
+
+// Literal signature: two bits per variable class, one per sign, so the
+// signature of the negated literals is a swap of neighbouring bits
+static inline uint64_t lit_sig(Lit lit) {
+    return 1ULL << (((var(lit) & 31) << 1) | sign(lit));
+}
+
+static inline uint64_t sig_negate(uint64_t sig) {
+    const uint64_t even = 0x5555555555555555ULL;
+    return ((sig & even) << 1) | ((sig >> 1) & even);
+}
+
+static inline bool candidate(const Solver* s, Var v) {
+    return !s->elim->eliminated[v] && var_value(s, v) == UNDEF && !s->vars[v].frozen &&
+           !s->vars[v].in_matrix;
+}
+
 /*********************************************************************
  * Occurrence List Management
  *********************************************************************/
 
-static void occ_ensure_capacity(OccList* occ, uint32_t min_cap) {
-    if (occ->capacity >= min_cap) return;
+static bool occ_ensure_capacity(OccList* ol, uint32_t min_cap) {
+    if (ol->capacity >= min_cap) return true;
 
-    uint32_t new_cap = occ->capacity ? occ->capacity * 2 : INITIAL_OCC_CAPACITY;
+    uint32_t new_cap = ol->capacity ? ol->capacity * 2 : INITIAL_OCC_CAPACITY;
     while (new_cap < min_cap) new_cap *= 2;
 
-    CRef* new_clauses = (CRef*)realloc(occ->clauses, new_cap * sizeof(CRef));
-    if (!new_clauses) {
-        // Out of memory - just return, caller will handle
-        return;
-    }
-    occ->clauses = new_clauses;
-    occ->capacity = new_cap;
+    Occ* new_occs = (Occ*)realloc(ol->occs, new_cap * sizeof(Occ));
+    if (!new_occs) return false;
+    ol->occs = new_occs;
+    ol->capacity = new_cap;
+    return true;
 }
 
-void elim_add_occ(Solver* s, Lit lit, CRef cref) {
+bool occ_push(OccList* ol, CRef cref, uint64_t sig) {
+    if (!occ_ensure_capacity(ol, ol->size + 1)) return false;
+    ol->occs[ol->size].sig = sig;
+    ol->occs[ol->size].cref = cref;
+    ol->size++;
+    return true;
+}
+
+void elim_add_occ(Solver* s, Lit lit, CRef cref, uint64_t sig) {
     if (!s->elim || lit >= s->elim->occs_capacity) return;
 
-    OccList* occ = &s->elim->occs[lit];
-    occ_ensure_capacity(occ, occ->size + 1);
-    if (occ->size < occ->capacity) {
-        occ->clauses[occ->size++] = cref;
-    }
+    if (occ_push(&s->elim->occs[lit], cref, sig)) s->elim->live[lit]++;
 }
 
-void elim_remove_occ(Solver* s, Lit lit, CRef cref) {
-    if (!s->elim || lit >= s->elim->occs_capacity) return;
+// Drop entries of deleted clauses once they make up half of the list
+static void occ_collect(Solver* s, Lit lit) {
+    OccList* ol = &s->elim->occs[lit];
+    if (ol->size < 2 * s->elim->live[lit] + INITIAL_OCC_CAPACITY) return;
 
-    OccList* occ = &s->elim->occs[lit];
-    for (uint32_t i = 0; i < occ->size; i++) {
-        if (occ->clauses[i] == cref) {
-            // Swap with last and shrink
-            occ->clauses[i] = occ->clauses[occ->size - 1];
-            occ->size--;
-            return;
-        }
+    uint32_t j = 0;
+    for (uint32_t i = 0; i < ol->size; i++) {
+        if (!clause_deleted(s->arena, ol->occs[i].cref)) ol->occs[j++] = ol->occs[i];
     }
+    ol->size = j;
 }
 
 void elim_clear_occs(Solver* s) {
     if (!s->elim) return;
 
     for (uint32_t i = 0; i < s->elim->occs_capacity; i++) {
+        free(s->elim->occs[i].occs);
+        s->elim->occs[i].occs = NULL;
         s->elim->occs[i].size = 0;
+        s->elim->occs[i].capacity = 0;
+        s->elim->live[i] = 0;
     }
 }
 
 /*********************************************************************
- * Initialization and Cleanup
+ * Candidate Heap
+ *
+ * Min-heap on |P|·|N|: pure literals first, then cheap variables.
  *********************************************************************/
 
-void elim_init(Solver* s) {
-    if (s->elim) return;  // Already initialized
+static inline uint64_t heap_key(const ElimState* e, Var v) {
+    return (uint64_t)e->live[mkLit(v, false)] * e->live[mkLit(v, true)];
+}
 
-    s->elim = (ElimState*)calloc(1, sizeof(ElimState));
-    if (!s->elim) return;
+static void heap_up(ElimState* e, uint32_t i) {
+    Var v = e->heap[i];
+    uint64_t key = heap_key(e, v);
+    while (i > 0) {
+        uint32_t parent = (i - 1) / 2;
+        if (heap_key(e, e->heap[parent]) <= key) break;
+        e->heap[i] = e->heap[parent];
+        e->heap_pos[e->heap[i]] = i;
+        i = parent;
+    }
+    e->heap[i] = v;
+    e->heap_pos[v] = i;
+}
 
-    // Allocate occurrence lists (2 per variable: positive and negative literal)
-    uint32_t num_lits = 2 * (s->num_vars + 1);
-    s->elim->occs = (OccList*)calloc(num_lits, sizeof(OccList));
-    s->elim->occs_capacity = num_lits;
+static void heap_down(ElimState* e, uint32_t i) {
+    Var v = e->heap[i];
+    uint64_t key = heap_key(e, v);
+    for (;;) {
+        uint32_t child = 2 * i + 1;
+        if (child >= e->heap_size) break;
+        if (child + 1 < e->heap_size &&
+            heap_key(e, e->heap[child + 1]) < heap_key(e, e->heap[child])) {
+            child++;
+        }
+        if (heap_key(e, e->heap[child]) >= key) break;
+        e->heap[i] = e->heap[child];
+        e->heap_pos[e->heap[i]] = i;
+        i = child;
+    }
+    e->heap[i] = v;
+    e->heap_pos[v] = i;
+}
+
+static Var heap_pop(ElimState* e) {
+    Var v = e->heap[0];
+    e->heap_pos[v] = UINT32_MAX;
+    if (--e->heap_size > 0) {
+        e->heap[0] = e->heap[e->heap_size];
+        heap_down(e, 0);
+    }
+    return v;
+}
+
+// Occurrence counts of v changed: reposition or (re)insert it
+static void heap_touch(Solver* s, Var v) {
+    ElimState* e = s->elim;
+    if (e->heap_pos[v] != UINT32_MAX) {
+        heap_up(e, e->heap_pos[v]);
+        heap_down(e, e->heap_pos[v]);
+    } else if (candidate(s, v)) {
+        e->heap[e->heap_size] = v;
+        heap_up(e, e->heap_size++);
+    }
+}
+
+/*********************************************************************
+ * Initialization and Cleanup
+ *********************************************************************/
 
-    // Allocate elimination stack
-    s->elim->stack = (ElimEntry*)malloc(INITIAL_STACK_CAPACITY * sizeof(ElimEntry));
-    s->elim->stack_capacity = INITIAL_STACK_CAPACITY;
-    s->elim->stack_size = 0;
+// Grow the per-variable arrays of an existing state to the current
+// number of variables (occurrence lists and heap are empty between runs)
+static void elim_grow(Solver* s) {
+    ElimState* e = s->elim;
+    uint32_t capacity = s->num_vars + 1;
+    if (e->elim_capacity >= capacity) return;
+
+    uint32_t num_lits = 2 * capacity;
+    OccList* occs = (OccList*)realloc(e->occs, num_lits * sizeof(OccList));
+    if (occs) e->occs = occs;
+    uint32_t* live = (uint32_t*)realloc(e->live, num_lits * sizeof(uint32_t));
+    if (live) e->live = live;
+    Var* heap = (Var*)realloc(e->heap, capacity * sizeof(Var));
+    if (heap) e->heap = heap;
+    uint32_t* heap_pos = (uint32_t*)realloc(e->heap_pos, capacity * sizeof(uint32_t));
+    if (heap_pos) e->heap_pos = heap_pos;
+    bool* eliminated = (bool*)realloc(e->eliminated, capacity * sizeof(bool));
+    if (eliminated) e->eliminated = eliminated;
+    uint8_t* locked = (uint8_t*)realloc(e->locked, capacity * sizeof(uint8_t));
+    if (locked) e->locked = locked;
+    if (!occs || !live || !heap || !heap_pos || !eliminated || !locked) return;
+
+    memset(e->occs + e->occs_capacity, 0, (num_lits - e->occs_capacity) * sizeof(OccList));
+    memset(e->live + e->occs_capacity, 0, (num_lits - e->occs_capacity) * sizeof(uint32_t));
+    for (Var v = e->elim_capacity; v < capacity; v++) {
+        e->heap_pos[v] = UINT32_MAX;
+        e->eliminated[v] = false;
+        e->locked[v] = 0;
+    }
+    e->occs_capacity = num_lits;
+    e->elim_capacity = capacity;
+}
 
-    // Allocate eliminated flags
-    s->elim->eliminated = (bool*)calloc(s->num_vars + 1, sizeof(bool));
-    s->elim->elim_capacity = s->num_vars + 1;
+void elim_init(Solver* s) {
+    if (s->elim) {
+        elim_grow(s);
+        return;
+    }
 
-    // Initialize statistics
-    s->elim->vars_eliminated = 0;
-    s->elim->clauses_removed = 0;
-    s->elim->resolvents_added = 0;
+    ElimState* e = (ElimState*)calloc(1, sizeof(ElimState));
+    if (!e) return;
 
-    // Initialize resolvent tracking for debugging
-    s->elim->resolvent_crefs = NULL;
-    s->elim->resolvent_crefs_size = 0;
-    s->elim->resolvent_crefs_capacity = 0;
+    // Occurrence lists (2 per variable: positive and negative literal)
+    uint32_t num_lits = 2 * (s->num_vars + 1);
+    e->occs = (OccList*)calloc(num_lits, sizeof(OccList));
+    e->live = (uint32_t*)calloc(num_lits, sizeof(uint32_t));
+    e->occs_capacity = num_lits;
+
+    // Candidate heap
+    e->heap = (Var*)malloc((s->num_vars + 1) * sizeof(Var));
+    e->heap_pos = (uint32_t*)malloc((s->num_vars + 1) * sizeof(uint32_t));
+
+    // Elimination stack
+    e->stack = (Lit*)malloc(INITIAL_STACK_CAPACITY * sizeof(Lit));
+    e->stack_capacity = INITIAL_STACK_CAPACITY;
+
+    // Per-variable flags
+    e->eliminated = (bool*)calloc(s->num_vars + 1, sizeof(bool));
+    e->locked = (uint8_t*)calloc(s->num_vars + 1, sizeof(uint8_t));
+    e->elim_capacity = s->num_vars + 1;
+
+    s->elim = e;
+    if (!e->occs || !e->live || !e->heap || !e->heap_pos || !e->stack ||
+        !e->eliminated || !e->locked) {
+        elim_free(s);
+        return;
+    }
+    for (Var v = 0; v <= s->num_vars; v++) e->heap_pos[v] = UINT32_MAX;
 }
 
 void elim_free(Solver* s) {
     if (!s->elim) return;
 
-    // Free occurrence lists
     if (s->elim->occs) {
         for (uint32_t i = 0; i < s->elim->occs_capacity; i++) {
-            free(s->elim->occs[i].clauses);
+            free(s->elim->occs[i].occs);
         }
         free(s->elim->occs);
     }
-
-    // Free elimination stack entries (clauses are copies)
-    if (s->elim->stack) {
-        for (uint32_t i = 0; i < s->elim->stack_size; i++) {
-            free(s->elim->stack[i].clause);
-        }
-        free(s->elim->stack);
-    }
-
-    // Free eliminated flags
+    free(s->elim->live);
+    free(s->elim->bins);
+    free(s->elim->heap);
+    free(s->elim->heap_pos);
+    free(s->elim->stack);
     free(s->elim->eliminated);
-
-    // Free resolvent tracking
-    free(s->elim->resolvent_crefs);
+    free(s->elim->locked);
+    free(s->elim->witness);
 
     free(s->elim);
     s->elim = NULL;
 }
 
+/*********************************************************************
+ * Clause Bookkeeping
+ *********************************************************************/
+
+static bool bins_push(ElimState* e, CRef cref) {
+    if (e->bins_size >= e->bins_capacity) {
+        uint32_t new_cap = e->bins_capacity ? e->bins_capacity * 2 : 1024;
+        CRef* new_bins = (CRef*)realloc(e->bins, new_cap * sizeof(CRef));
+        if (!new_bins) return false;
+        e->bins = new_bins;
+        e->bins_capacity = new_cap;
+    }
+    e->bins[e->bins_size++] = cref;
+    return true;
+}
+
+static bool stack_push(ElimState* e, Lit lit) {
+    if (e->stack_size >= e->stack_capacity) {
+        uint32_t new_cap = e->stack_capacity * 2;
+        Lit* new_stack = (Lit*)realloc(e->stack, new_cap * sizeof(Lit));
+        if (!new_stack) return false;
+        e->stack = new_stack;
+        e->stack_capacity = new_cap;
+    }
+    e->stack[e->stack_size++] = lit;
+    return true;
+}
+
+// Assign a unit at level 0 (propagated later by the search)
+static void enqueue_unit(Solver* s, Lit unit) {
+    Var v = var(unit);
+    assign_lit(s, unit);
+    s->levels[v] = 0;
+    s->reasons[v] = INVALID_CLAUSE;
+    s->trail_pos[v] = s->trail_size;
+    s->trail[s->trail_size].lit = unit;
+    s->trail[s->trail_size].level = 0;
+    s->trail_size++;
+}
+
 /*********************************************************************
  * Build Occurrence Lists
  *********************************************************************/
 
-void elim_build_occs(Solver* s) {
-    if (!s->elim) return;
+bool elim_build_occs(Solver* s) {
+    if (!s->elim) return false;
 
     elim_clear_occs(s);
 
-    // Iterate through all clauses in the arena
+    // Long clauses
     for (uint32_t i = 0; i < s->num_clauses; i++) {
         CRef cref = s->clauses[i];
         if (cref == INVALID_CLAUSE) continue;
@@ -160,531 +336,651 @@ void elim_build_occs(Solver* s) {
 
         uint32_t size = CLAUSE_SIZE(s->arena, cref);
         Lit* lits = CLAUSE_LITS(s->arena, cref);
-
+        uint64_t sig = clause_signature(lits, size);
         for (uint32_t j = 0; j < size; j++) {
-            elim_add_occ(s, lits[j], cref);
-        }
-    }
-
-    // Also process binary clauses from watch lists
-    // Binary clauses are stored implicitly in watches
-    // We need to iterate through watches to find them
-    for (Var v = 1; v <= s->num_vars; v++) {
-        for (int sign_val = 0; sign_val <= 1; sign_val++) {
-            Lit lit = mkLit(v, sign_val);
-            WatchList* wl = watch_list(s->watches, lit);
-
-            for (uint32_t i = 0; i < wl->size; i++) {
-                Watch w = wl->watches[i];
-                // Binary clauses have INVALID_CLAUSE as cref
-                if (w.cref == INVALID_CLAUSE) {
-                    // This is a binary clause: (neg(lit), w.blocker)
-                    // We record it in occurrence list for the other literal
-                    // But we need to be careful not to double-count
-                    // Only add when we see the smaller literal first
-                    if (lit < neg(lit)) {
-                        // We can't use arena clauses for binary - skip for now
-                        // Binary clause handling is more complex
-                    }
+            elim_add_occ(s, lits[j], cref, sig);
+        }
+    }
+
+    // Binary clauses have no arena reference: while BVE runs they are
+    // held in the arena (unwatched) like any other clause
+    uint32_t num_lits = 2 * (s->num_vars + 1);
+    for (Lit lit = 2; lit < num_lits; lit++) {
+        BinList* bl = bin_list(s->watches, lit);
+        for (uint32_t k = 0; k < bl->size; k++) {
+            Lit other = bl->lits[k];
+            if (lit > other) continue;
+            Lit pair[2] = { lit, other };
+            CRef cref = arena_alloc(s->arena, pair, 2, false);
+            if (cref != INVALID_CLAUSE && !bins_push(s->elim, cref)) {
+                arena_delete(s->arena, cref);
+                cref = INVALID_CLAUSE;
+            }
+            if (cref == INVALID_CLAUSE) {
+                // Out of memory: the implication lists are still intact
+                for (uint32_t i = 0; i < s->elim->bins_size; i++) {
+                    arena_delete(s->arena, s->elim->bins[i]);
                 }
+                s->elim->bins_size = 0;
+                elim_clear_occs(s);
+                return false;
             }
+            uint64_t sig = clause_signature(pair, 2);
+            elim_add_occ(s, lit, cref, sig);
+            elim_add_occ(s, other, cref, sig);
         }
     }
+    return true;
 }
 
-/*********************************************************************
- * Tautology Check
- *********************************************************************/
-
-bool elim_is_tautology(const Lit* c1, uint32_t s1,
-                       const Lit* c2, uint32_t s2,
-                       Var pivot) {
-    // Check if resolving c1 and c2 on pivot produces a tautology
-    // A resolvent is a tautology if it contains both x and ¬x for some variable
-
-    // Quick check: mark all literals from c1 (except pivot)
-    // Then check if c2 contains the negation of any
-
-    // For efficiency, use a simple O(n*m) approach for small clauses
-    // For larger clauses, could use a bitmap
-
-    for (uint32_t i = 0; i < s1; i++) {
-        Var vi = var(c1[i]);
-        if (vi == pivot) continue;
-
-        for (uint32_t j = 0; j < s2; j++) {
-            Var vj = var(c2[j]);
-            if (vj == pivot) continue;
+// Move the surviving binary clauses back to the implication lists
+static void restore_binaries(Solver* s) {
+    ElimState* e = s->elim;
+    uint32_t num_lits = 2 * (s->num_vars + 1);
 
-            // Check if c1[i] and c2[j] are opposite literals of same variable
-            if (vi == vj && sign(c1[i]) != sign(c2[j])) {
-                return true;  // Tautology!
-            }
+    // The implication lists still hold every pair copied at build time:
+    // clear them and re-add the pairs whose arena copy survived
+    for (Lit lit = 2; lit < num_lits; lit++) {
+        bin_list(s->watches, lit)->size = 0;
+    }
+    for (uint32_t i = 0; i < e->bins_size; i++) {
+        CRef cref = e->bins[i];
+        if (!clause_deleted(s->arena, cref)) {
+            Lit* lits = CLAUSE_LITS(s->arena, cref);
+            watch_add_binary(s->watches, lits[0], lits[1]);
+            arena_delete(s->arena, cref);
         }
     }
-
-    return false;
+    e->bins_size = 0;
 }
 
 /*********************************************************************
- * Elimination Cost Calculation
+ * Resolution Workers
+ *
+ * A worker resolves one candidate at a time, reading the occurrence
+ * lists and the arena only, and writes the resolvents (size followed by
+ * literals, level-0 false literals dropped) to its own buffer.
  *********************************************************************/
 
-// Sentinel value meaning "don't eliminate this variable"
-#define ELIM_SKIP INT_MAX
-
-int elim_cost(Solver* s, Var v) {
-    if (!s->elim || v >= s->elim->elim_capacity) return ELIM_SKIP;
-    if (s->elim->eliminated[v]) return ELIM_SKIP;
-    if (s->vars[v].value != UNDEF) return ELIM_SKIP;  // Already assigned
-
-    Lit pos = mkLit(v, false);  // Positive literal
-    Lit negl = mkLit(v, true);   // Negative literal
-
-    OccList* pos_occs = &s->elim->occs[pos];
-    OccList* neg_occs = &s->elim->occs[negl];
-
-    uint32_t pos_count = pos_occs->size;
-    uint32_t neg_count = neg_occs->size;
+typedef struct ElimJob {
+    Var      var;
+    bool     eliminate;   // Bound respected, resolvents are in the buffer
+    uint32_t worker;      // Worker whose buffer holds the resolvents
+    uint32_t begin, end;  // Range in that buffer
+} ElimJob;
+
+typedef struct ElimWorker {
+    Solver*   s;
+    struct ElimBatch* batch;
+    uint32_t  id;
+    uint8_t*  marks;      // Per literal: 1 = in current P clause, 2 = in resolvent
+    uint64_t* sigs;       // Signatures of the N clauses, pivot excluded
+    uint32_t  sigs_capacity;
+    Lit*      out;        // Resolvents of the current batch
+    uint32_t  out_size;
+    uint32_t  out_capacity;
+    uint64_t  subsumed;
+    pthread_t thread;
+} ElimWorker;
+
+typedef struct ElimBatch {
+    ElimJob*    jobs;
+    uint32_t    num_jobs;
+    atomic_uint next;     // Next job to claim
+} ElimBatch;
+
+static bool out_reserve(ElimWorker* w, uint32_t extra) {
+    if (w->out_size + extra <= w->out_capacity) return true;
+    uint32_t new_cap = w->out_capacity ? w->out_capacity : 1024;
+    while (new_cap < w->out_size + extra) new_cap *= 2;
+    Lit* new_out = (Lit*)realloc(w->out, new_cap * sizeof(Lit));
+    if (!new_out) return false;
+    w->out = new_out;
+    w->out_capacity = new_cap;
+    return true;
+}
 
-    // Check occurrence limits
-    if (pos_count > s->opts.elim_max_occ || neg_count > s->opts.elim_max_occ) {
-        return ELIM_SKIP;  // Too many occurrences
+// Is the resolvent (marked with 2 in marks) subsumed by a live clause?
+static bool resolvent_subsumed(ElimWorker* w, const Lit* res, uint32_t size) {
+    const Solver* s = w->s;
+    uint64_t sig = clause_signature(res, size);
+
+    for (uint32_t i = 0; i < size; i++) {
+        const OccList* ol = &s->elim->occs[res[i]];
+        if (ol->size > ELIM_SUBSUME_MAX_OCC) continue;
+        for (uint32_t k = 0; k < ol->size; k++) {
+            if (ol->occs[k].sig & ~sig) continue;
+            CRef cref = ol->occs[k].cref;
+            if (clause_deleted(s->arena, cref)) continue;
+            uint32_t csize = CLAUSE_SIZE(s->arena, cref);
+            if (csize > size) continue;
+            const Lit* lits = CLAUSE_LITS(s->arena, cref);
+            uint32_t j = 0;
+            while (j < csize && (w->marks[lits[j]] & 2)) j++;
+            if (j == csize) return true;
+        }
     }
+    return false;
+}
 
-    // If either side has no occurrences, elimination is trivially beneficial
-    if (pos_count == 0 || neg_count == 0) {
-        return 0;  // Can eliminate with 0 resolvents
+// Compute the resolvents of job->var, giving up once the bound is exceeded
+static void resolve_candidate(ElimWorker* w, ElimJob* job) {
+    const Solver* s = w->s;
+    const ElimState* e = s->elim;
+    Var v = job->var;
+    Lit pos = mkLit(v, false), negl = mkLit(v, true);
+    const OccList* P = &e->occs[pos];
+    const OccList* N = &e->occs[negl];
+
+    job->eliminate = false;
+    job->worker = w->id;
+    job->begin = job->end = w->out_size;
+
+    uint32_t limit = e->live[pos] + e->live[negl] + s->opts.elim_grow;
+    uint32_t count = 0;
+
+    if (N->size > w->sigs_capacity) {
+        uint64_t* new_sigs = (uint64_t*)realloc(w->sigs, N->size * sizeof(uint64_t));
+        if (!new_sigs) return;
+        w->sigs = new_sigs;
+        w->sigs_capacity = N->size;
     }
-
-    // Count non-tautological resolvents
-    int resolvent_count = 0;
-    int original_count = (int)pos_count + (int)neg_count;
-
-    for (uint32_t i = 0; i < pos_count; i++) {
-        CRef cref_i = pos_occs->clauses[i];
-        if (clause_deleted(s->arena, cref_i)) continue;
-
-        uint32_t size_i = CLAUSE_SIZE(s->arena, cref_i);
-        Lit* lits_i = CLAUSE_LITS(s->arena, cref_i);
-
-        for (uint32_t j = 0; j < neg_count; j++) {
-            CRef cref_j = neg_occs->clauses[j];
-            if (clause_deleted(s->arena, cref_j)) continue;
-
-            uint32_t size_j = CLAUSE_SIZE(s->arena, cref_j);
-            Lit* lits_j = CLAUSE_LITS(s->arena, cref_j);
-
-            if (!elim_is_tautology(lits_i, size_i, lits_j, size_j, v)) {
-                resolvent_count++;
-
-                // Early termination: if resolvents already exceed original count + growth limit
-                if (resolvent_count > original_count + (int)s->opts.elim_grow) {
-                    return ELIM_SKIP;  // Not beneficial
-                }
+    for (uint32_t j = 0; j < N->size; j++) {
+        CRef cref = N->occs[j].cref;
+        uint64_t sig = 0;
+        if (!clause_deleted(s->arena, cref)) {
+            const Lit* lits = CLAUSE_LITS(s->arena, cref);
+            uint32_t size = CLAUSE_SIZE(s->arena, cref);
+            for (uint32_t k = 0; k < size; k++) {
+                if (lits[k] != negl) sig |= lit_sig(lits[k]);
             }
         }
+        w->sigs[j] = sig;
     }
 
-    // Check if elimination is beneficial
-    if (resolvent_count <= original_count + (int)s->opts.elim_grow) {
-        return resolvent_count - original_count;  // Return net change (negative = good)
-    }
+    for (uint32_t i = 0; i < P->size; i++) {
+        CRef ci = P->occs[i].cref;
+        if (clause_deleted(s->arena, ci)) continue;
+        const Lit* lits_i = CLAUSE_LITS(s->arena, ci);
+        uint32_t size_i = CLAUSE_SIZE(s->arena, ci);
+
+        uint64_t sig_i = 0;
+        for (uint32_t k = 0; k < size_i; k++) {
+            if (lits_i[k] == pos) continue;
+            sig_i |= lit_sig(lits_i[k]);
+            w->marks[lits_i[k]] |= 1;
+        }
 
-    return ELIM_SKIP;  // Not beneficial
-}
+        bool over = false;
+        for (uint32_t j = 0; j < N->size && !over; j++) {
+            CRef cj = N->occs[j].cref;
+            if (clause_deleted(s->arena, cj)) continue;
+            const Lit* lits_j = CLAUSE_LITS(s->arena, cj);
+            uint32_t size_j = CLAUSE_SIZE(s->arena, cj);
+
+            // Tautology: the signatures filter out most pairs
+            if (sig_i & sig_negate(w->sigs[j])) {
+                bool taut = false;
+                for (uint32_t k = 0; k < size_j && !taut; k++) {
+                    taut = lits_j[k] != negl && (w->marks[neg(lits_j[k])] & 1);
+                }
+                if (taut) continue;
+            }
 
-/*********************************************************************
- * Compute Resolvent
- *********************************************************************/
+            // Build the resolvent, without level-0 false literals
+            if (!out_reserve(w, size_i + size_j)) {
+                over = true;
+                break;
+            }
+            Lit* res = &w->out[w->out_size + 1];
+            uint32_t n = 0;
+            bool satisfied = false;
+            for (uint32_t k = 0; k < size_i && !satisfied; k++) {
+                Lit lit = lits_i[k];
+                if (lit == pos) continue;
+                lbool val = lit_value(s, lit);
+                if (val == TRUE) satisfied = true;
+                else if (val == UNDEF) res[n++] = lit;
+            }
+            for (uint32_t k = 0; k < size_j && !satisfied; k++) {
+                Lit lit = lits_j[k];
+                if (lit == negl || (w->marks[lit] & 1)) continue;
+                lbool val = lit_value(s, lit);
+                if (val == TRUE) satisfied = true;
+                else if (val == UNDEF) res[n++] = lit;
+            }
+            if (satisfied) continue;
+
+            // Drop resolvents that an existing clause subsumes
+            for (uint32_t k = 0; k < n; k++) w->marks[res[k]] |= 2;
+            bool subsumed = resolvent_subsumed(w, res, n);
+            for (uint32_t k = 0; k < n; k++) w->marks[res[k]] &= (uint8_t)~2;
+            if (subsumed) {
+                w->subsumed++;
+                continue;
+            }
 
-// Compute resolvent of two clauses on pivot variable
-// Returns allocated array of literals (caller must free)
-// Returns NULL if resolvent is tautology
-static Lit* compute_resolvent(const Lit* c1, uint32_t s1,
-                              const Lit* c2, uint32_t s2,
-                              Var pivot, uint32_t* result_size) {
-    // Maximum size of resolvent
-    uint32_t max_size = s1 + s2 - 2;  // Remove one literal from each
-    Lit* result = (Lit*)malloc(max_size * sizeof(Lit));
-    if (!result) return NULL;
-
-    uint32_t rsize = 0;
-
-    // Add all literals from c1 except pivot
-    for (uint32_t i = 0; i < s1; i++) {
-        if (var(c1[i]) != pivot) {
-            result[rsize++] = c1[i];
-        }
-    }
-
-    // Add literals from c2 except pivot and duplicates
-    for (uint32_t j = 0; j < s2; j++) {
-        Lit lit = c2[j];
-        if (var(lit) == pivot) continue;
-
-        // Check for duplicate or opposite
-        bool found = false;
-        for (uint32_t k = 0; k < rsize; k++) {
-            if (var(result[k]) == var(lit)) {
-                if (sign(result[k]) != sign(lit)) {
-                    // Tautology! (opposite literals)
-                    free(result);
-                    return NULL;
-                }
-                found = true;  // Duplicate
+            if (++count > limit) {
+                over = true;
                 break;
             }
+            w->out[w->out_size] = n;
+            w->out_size += n + 1;
         }
 
-        if (!found) {
-            result[rsize++] = lit;
+        for (uint32_t k = 0; k < size_i; k++) w->marks[lits_i[k]] &= (uint8_t)~1;
+        if (over) {
+            w->out_size = job->begin;
+            return;
         }
     }
 
-    *result_size = rsize;
-    return result;
+    job->eliminate = true;
+    job->end = w->out_size;
+}
+
+static void* elim_worker_main(void* arg) {
+    ElimWorker* w = (ElimWorker*)arg;
+    ElimBatch* b = w->batch;
+    for (;;) {
+        uint32_t i = atomic_fetch_add_explicit(&b->next, 1, memory_order_relaxed);
+        if (i >= b->num_jobs) break;
+        resolve_candidate(w, &b->jobs[i]);
+    }
+    return NULL;
 }
 
 /*********************************************************************
- * Eliminate Variable
+ * Commit an Elimination
  *********************************************************************/
 
-bool elim_eliminate_var(Solver* s, Var v) {
-    if (!s->elim) return false;
-    if (s->elim->eliminated[v]) return false;
-    if (s->vars[v].value != UNDEF) return false;
-
-    Lit pos = mkLit(v, false);
-    Lit negl = mkLit(v, true);
-
-    OccList* pos_occs = &s->elim->occs[pos];
-    OccList* neg_occs = &s->elim->occs[negl];
-
-    // Save one positive clause for reconstruction
-    // (We need to save a clause containing +v before deletion)
-    ElimEntry entry;
-    entry.var = v;
-    entry.clause = NULL;
-    entry.clause_size = 0;
+static void delete_occ_clauses(Solver* s, Lit lit) {
+    ElimState* e = s->elim;
+    OccList* ol = &e->occs[lit];
+    for (uint32_t i = 0; i < ol->size; i++) {
+        CRef cref = ol->occs[i].cref;
+        if (clause_deleted(s->arena, cref)) continue;
 
-    if (pos_occs->size > 0) {
-        CRef cref = pos_occs->clauses[0];
-        if (!clause_deleted(s->arena, cref)) {
-            uint32_t size = CLAUSE_SIZE(s->arena, cref);
-            Lit* lits = CLAUSE_LITS(s->arena, cref);
-            entry.clause = (Lit*)malloc(size * sizeof(Lit));
-            if (entry.clause) {
-                memcpy(entry.clause, lits, size * sizeof(Lit));
-                entry.clause_size = size;
-            }
+        uint32_t size = CLAUSE_SIZE(s->arena, cref);
+        Lit* lits = CLAUSE_LITS(s->arena, cref);
+        if (s->proof) {
+            proof_delete_clause(s, lits, size);
+        }
+        arena_delete(s->arena, cref);
+        for (uint32_t j = 0; j < size; j++) {
+            if (var(lits[j]) == var(lit)) continue;
+            e->live[lits[j]]--;
+            occ_collect(s, lits[j]);
+            heap_touch(s, var(lits[j]));
         }
+        e->clauses_removed++;
     }
+    ol->size = 0;
+    e->live[lit] = 0;
+}
 
-    // If no positive clause, try negative
-    if (!entry.clause && neg_occs->size > 0) {
-        CRef cref = neg_occs->clauses[0];
-        if (!clause_deleted(s->arena, cref)) {
+// Replace the clauses of job->var by its resolvents. Returns false
+// (nothing changed) if memory for the resolvents is not available.
+static bool commit_elimination(Solver* s, ElimWorker* w, const ElimJob* job) {
+    ElimState* e = s->elim;
+    Var v = job->var;
+    Lit pos = mkLit(v, false), negl = mkLit(v, true);
+
+    // Arena space for all resolvents up front, so nothing is half done
+    size_t words = 0;
+    for (uint32_t i = job->begin; i < job->end; i += w->out[i] + 1) {
+        words += clause_bytes(w->out[i]) / sizeof(uint32_t);
+    }
+    if (!arena_reserve(s->arena, s->arena->size + words)) return false;
+
+    // Save both sides, the smaller one first: each clause with the
+    // eliminated literal first, then its size; finally the default unit
+    // for the other side. Reconstruction only needs the smaller side,
+    // elim_restore needs both.
+    uint32_t stack_mark = e->stack_size;
+    Lit x = e->live[pos] <= e->live[negl] ? pos : negl;
+    Lit sides[2] = { x, neg(x) };
+    for (int side = 0; side < 2; side++) {
+        OccList* ol = &e->occs[sides[side]];
+        for (uint32_t i = 0; i < ol->size; i++) {
+            CRef cref = ol->occs[i].cref;
+            if (clause_deleted(s->arena, cref)) continue;
             uint32_t size = CLAUSE_SIZE(s->arena, cref);
-            Lit* lits = CLAUSE_LITS(s->arena, cref);
-            entry.clause = (Lit*)malloc(size * sizeof(Lit));
-            if (entry.clause) {
-                memcpy(entry.clause, lits, size * sizeof(Lit));
-                entry.clause_size = size;
+            const Lit* lits = CLAUSE_LITS(s->arena, cref);
+            bool ok = stack_push(e, sides[side]);
+            for (uint32_t j = 0; j < size && ok; j++) {
+                if (lits[j] != sides[side]) ok = stack_push(e, lits[j]);
+            }
+            if (!ok || !stack_push(e, size)) {
+                e->stack_size = stack_mark;
+                return false;
             }
         }
     }
+    if (!stack_push(e, neg(x)) || !stack_push(e, 1)) {
+        e->stack_size = stack_mark;
+        return false;
+    }
 
-    // Generate all resolvents
-    for (uint32_t i = 0; i < pos_occs->size; i++) {
-        CRef cref_i = pos_occs->clauses[i];
-        if (clause_deleted(s->arena, cref_i)) continue;
-
-        uint32_t size_i = CLAUSE_SIZE(s->arena, cref_i);
-        Lit* lits_i = CLAUSE_LITS(s->arena, cref_i);
-
-        for (uint32_t j = 0; j < neg_occs->size; j++) {
-            CRef cref_j = neg_occs->clauses[j];
-            if (clause_deleted(s->arena, cref_j)) continue;
-
-            uint32_t size_j = CLAUSE_SIZE(s->arena, cref_j);
-            Lit* lits_j = CLAUSE_LITS(s->arena, cref_j);
-
-            uint32_t rsize;
-            Lit* resolvent = compute_resolvent(lits_i, size_i, lits_j, size_j, v, &rsize);
+    // Add resolvents (units from earlier commits may apply by now)
+    for (uint32_t i = job->begin; i < job->end; i += w->out[i] + 1) {
+        Lit* res = &w->out[i + 1];
+        uint32_t n = 0;
+        bool satisfied = false;
+        for (uint32_t k = 0; k < w->out[i] && !satisfied; k++) {
+            lbool val = lit_value(s, res[k]);
+            if (val == TRUE) satisfied = true;
+            else if (val == UNDEF) res[n++] = res[k];
+        }
+        if (satisfied) continue;
 
-            if (resolvent) {
-                if (rsize == 0) {
-                    // Empty clause - UNSAT
-                    free(resolvent);
-                    free(entry.clause);
-                    s->result = FALSE;
-                    return false;
-                }
+        if (s->proof) {
+            proof_add_clause(s, res, n);
+        }
+        e->resolvents_added++;
 
-                if (rsize == 1) {
-                    // Unit clause - propagate immediately at level 0
-                    Lit unit = resolvent[0];
-                    Var uv = var(unit);
-                    lbool val = s->vars[uv].value;
-                    if (val == UNDEF) {
-                        // Propagate immediately at level 0
-                        s->vars[uv].value = sign(unit) ? FALSE : TRUE;
-                        s->vars[uv].level = 0;
-                        s->vars[uv].reason = INVALID_CLAUSE;
-                        s->vars[uv].trail_pos = s->trail_size;
-                        s->trail[s->trail_size].lit = unit;
-                        s->trail[s->trail_size].level = 0;
-                        s->trail_size++;
-                        if (s->proof_file) {
-                            proof_add_clause(s, resolvent, 1);
-                        }
-                        s->elim->resolvents_added++;
-                    } else if ((val == TRUE && sign(unit)) || (val == FALSE && !sign(unit))) {
-                        // Conflict - unit clause is falsified
-                        free(resolvent);
-                        free(entry.clause);
-                        s->result = FALSE;
-                        return false;
-                    }
-                    // Already satisfied - skip
-                } else {
-                    // Check resolvent status at level 0 before adding
-                    // Some literals might already be assigned from earlier unit propagations
-                    uint32_t unassigned_count = 0;
-                    uint32_t first_unassigned = UINT32_MAX;
-                    uint32_t second_unassigned = UINT32_MAX;
-                    bool satisfied = false;
-
-                    for (uint32_t k = 0; k < rsize; k++) {
-                        Var rv = var(resolvent[k]);
-                        lbool val = s->vars[rv].value;
-                        if (val == UNDEF) {
-                            if (first_unassigned == UINT32_MAX) {
-                                first_unassigned = k;
-                            } else if (second_unassigned == UINT32_MAX) {
-                                second_unassigned = k;
-                            }
-                            unassigned_count++;
-                        } else if ((val == TRUE && !sign(resolvent[k])) ||
-                                   (val == FALSE && sign(resolvent[k]))) {
-                            // Literal is true - clause is satisfied
-                            satisfied = true;
-                            break;
-                        }
-                        // else: literal is false, continue checking
-                    }
-
-                    if (satisfied) {
-                        // Clause already satisfied, skip it
-                        free(resolvent);
-                        continue;
-                    }
-
-                    if (unassigned_count == 0) {
-                        // All literals are false - conflict at level 0 = UNSAT
-                        free(resolvent);
-                        free(entry.clause);
-                        s->result = FALSE;
-                        return false;
-                    }
-
-                    if (unassigned_count == 1) {
-                        // Unit clause - propagate immediately
-                        Lit unit = resolvent[first_unassigned];
-                        Var uv = var(unit);
-                        s->vars[uv].value = sign(unit) ? FALSE : TRUE;
-                        s->vars[uv].level = 0;
-                        s->vars[uv].reason = INVALID_CLAUSE;
-                        s->vars[uv].trail_pos = s->trail_size;
-                        s->trail[s->trail_size].lit = unit;
-                        s->trail[s->trail_size].level = 0;
-                        s->trail_size++;
-                        if (s->proof_file) {
-                            proof_add_clause(s, resolvent, rsize);
-                        }
-                        s->elim->resolvents_added++;
-                        free(resolvent);
-                        continue;
-                    }
-
-                    // Move unassigned literals to front for proper watching
-                    if (first_unassigned != 0) {
-                        Lit tmp = resolvent[0];
-                        resolvent[0] = resolvent[first_unassigned];
-                        resolvent[first_unassigned] = tmp;
-                        if (second_unassigned == 0) {
-                            second_unassigned = first_unassigned;
-                        }
-                    }
-                    if (second_unassigned != 1) {
-                        Lit tmp = resolvent[1];
-                        resolvent[1] = resolvent[second_unassigned];
-                        resolvent[second_unassigned] = tmp;
-                    }
-
-                    // Add resolvent clause
-                    CRef new_cref = arena_alloc(s->arena, resolvent, rsize, false);
-                    if (new_cref != INVALID_CLAUSE) {
-                        // Add to occurrence lists for all literals
-                        for (uint32_t k = 0; k < rsize; k++) {
-                            elim_add_occ(s, resolvent[k], new_cref);
-                        }
-
-                        // Add watches for first two (unassigned) literals
-                        watch_add(s->watches, resolvent[0], new_cref, resolvent[1]);
-                        watch_add(s->watches, resolvent[1], new_cref, resolvent[0]);
-
-                        // Log to DRAT if enabled
-                        if (s->proof_file) {
-                            proof_add_clause(s, resolvent, rsize);
-                        }
-
-                        // Track resolvent CRef for debugging
-                        if (s->elim->resolvent_crefs_size >= s->elim->resolvent_crefs_capacity) {
-                            uint32_t new_cap = s->elim->resolvent_crefs_capacity ? s->elim->resolvent_crefs_capacity * 2 : 64;
-                            CRef* new_arr = (CRef*)realloc(s->elim->resolvent_crefs, new_cap * sizeof(CRef));
-                            if (new_arr) {
-                                s->elim->resolvent_crefs = new_arr;
-                                s->elim->resolvent_crefs_capacity = new_cap;
-                            }
-                        }
-                        if (s->elim->resolvent_crefs_size < s->elim->resolvent_crefs_capacity) {
-                            s->elim->resolvent_crefs[s->elim->resolvent_crefs_size++] = new_cref;
-                        }
-
-                        s->elim->resolvents_added++;
-                    }
-                }
+        if (n == 0) {
+            s->result = FALSE;  // Empty resolvent
+            return false;
+        }
+        if (n == 1) {
+            enqueue_unit(s, res[0]);
+            continue;
+        }
 
-                free(resolvent);
-            }
+        CRef cref = arena_alloc(s->arena, res, n, false);
+        if (n == 2) {
+            bins_push(e, cref);
+            clauses_push(s, INVALID_CLAUSE);
+        } else {
+            watch_add(s->watches, res[0], cref, res[1]);
+            watch_add(s->watches, res[1], cref, res[0]);
+            clauses_push(s, cref);
+        }
+        uint64_t sig = clause_signature(res, n);
+        for (uint32_t k = 0; k < n; k++) {
+            elim_add_occ(s, res[k], cref, sig);
+            heap_touch(s, var(res[k]));
         }
     }
 
-    // Delete original clauses containing v
-    for (uint32_t i = 0; i < pos_occs->size; i++) {
-        CRef cref = pos_occs->clauses[i];
-        if (clause_deleted(s->arena, cref)) continue;
+    // Remove the clauses of v
+    delete_occ_clauses(s, pos);
+    delete_occ_clauses(s, negl);
 
-        uint32_t size = CLAUSE_SIZE(s->arena, cref);
-        Lit* lits = CLAUSE_LITS(s->arena, cref);
-
-        // Log deletion to DRAT
-        if (s->proof_file) {
-            proof_delete_clause(s, lits, size);
-        }
+    e->eliminated[v] = true;
+    e->vars_eliminated++;
+    return true;
+}
 
-        // Remove from occurrence lists
-        for (uint32_t j = 0; j < size; j++) {
-            if (var(lits[j]) != v) {
-                elim_remove_occ(s, lits[j], cref);
-            }
-        }
+/*********************************************************************
+ * Main BVE Preprocessing Loop
+ *********************************************************************/
 
-        // Mark as deleted
-        arena_delete(s->arena, cref);
-        s->elim->clauses_removed++;
+static uint32_t elim_thread_count(const Solver* s) {
+    uint32_t threads = s->opts.elim_threads;
+    if (threads == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cpus > 0 ? (uint32_t)cpus : 1;
     }
+    return threads > ELIM_MAX_THREADS ? ELIM_MAX_THREADS : threads;
+}
 
-    for (uint32_t i = 0; i < neg_occs->size; i++) {
-        CRef cref = neg_occs->clauses[i];
-        if (clause_deleted(s->arena, cref)) continue;
-
-        uint32_t size = CLAUSE_SIZE(s->arena, cref);
-        Lit* lits = CLAUSE_LITS(s->arena, cref);
-
-        // Log deletion to DRAT
-        if (s->proof_file) {
-            proof_delete_clause(s, lits, size);
+// Lock the variables of v's clauses; false if one of them is locked
+static bool try_lock(Solver* s, Var v, Var* locked_vars, uint32_t* num_locked) {
+    ElimState* e = s->elim;
+    for (int side = 0; side < 2; side++) {
+        const OccList* ol = &e->occs[mkLit(v, side)];
+        for (uint32_t i = 0; i < ol->size; i++) {
+            CRef cref = ol->occs[i].cref;
+            if (clause_deleted(s->arena, cref)) continue;
+            const Lit* lits = CLAUSE_LITS(s->arena, cref);
+            uint32_t size = CLAUSE_SIZE(s->arena, cref);
+            for (uint32_t j = 0; j < size; j++) {
+                if (e->locked[var(lits[j])]) return false;
+            }
         }
-
-        // Remove from occurrence lists
-        for (uint32_t j = 0; j < size; j++) {
-            if (var(lits[j]) != v) {
-                elim_remove_occ(s, lits[j], cref);
+    }
+    for (int side = 0; side < 2; side++) {
+        const OccList* ol = &e->occs[mkLit(v, side)];
+        for (uint32_t i = 0; i < ol->size; i++) {
+            CRef cref = ol->occs[i].cref;
+            if (clause_deleted(s->arena, cref)) continue;
+            const Lit* lits = CLAUSE_LITS(s->arena, cref);
+            uint32_t size = CLAUSE_SIZE(s->arena, cref);
+            for (uint32_t j = 0; j < size; j++) {
+                Var u = var(lits[j]);
+                if (!e->locked[u]) {
+                    e->locked[u] = 1;
+                    locked_vars[(*num_locked)++] = u;
+                }
             }
         }
-
-        // Mark as deleted
-        arena_delete(s->arena, cref);
-        s->elim->clauses_removed++;
     }
+    if (!e->locked[v]) {
+        e->locked[v] = 1;
+        locked_vars[(*num_locked)++] = v;
+    }
+    return true;
+}
 
-    // Clear occurrence lists for this variable
-    pos_occs->size = 0;
-    neg_occs->size = 0;
+uint32_t elim_run(Solver* s, uint64_t effort) {
+    // Initialize elimination state
+    elim_init(s);
+    if (!s->elim || s->elim->elim_capacity < s->num_vars + 1) return 0;
+    ElimState* e = s->elim;
+    double start = now_seconds();
+
+    // Build occurrence lists and the candidate heap
+    if (!elim_build_occs(s)) return 0;
+    for (Var v = 1; v <= s->num_vars; v++) heap_touch(s, v);
+
+    uint32_t threads = elim_thread_count(s);
+    uint32_t batch_cap = ELIM_BATCH_SIZE;
+    ElimWorker* workers = (ElimWorker*)calloc(threads, sizeof(ElimWorker));
+    ElimJob* jobs = (ElimJob*)malloc(batch_cap * sizeof(ElimJob));
+    Var* deferred = (Var*)malloc(batch_cap * sizeof(Var));
+    Var* locked_vars = (Var*)malloc((s->num_vars + 1) * sizeof(Var));
+    bool ok = workers && jobs && deferred && locked_vars;
+    for (uint32_t t = 0; ok && t < threads; t++) {
+        workers[t].s = s;
+        workers[t].id = t;
+        workers[t].marks = (uint8_t*)calloc(2 * (s->num_vars + 1), sizeof(uint8_t));
+        ok = workers[t].marks != NULL;
+    }
 
-    // Mark variable as eliminated
-    s->elim->eliminated[v] = true;
-    s->elim->vars_eliminated++;
+    ElimBatch batch;
+    uint32_t eliminated = 0;
+    uint64_t spent = 0;
+    while (ok && e->heap_size > 0 && s->result != FALSE && spent < effort) {
+        // Select candidates whose clauses share no variable
+        uint32_t num_jobs = 0, num_deferred = 0, num_locked = 0;
+        while (e->heap_size > 0 && num_jobs < batch_cap && num_deferred < batch_cap &&
+               spent < effort) {
+            Var v = heap_pop(e);
+            if (!candidate(s, v)) continue;
+            uint32_t np = e->live[mkLit(v, false)], nn = e->live[mkLit(v, true)];
+            if (np > 0 && nn > 0 &&
+                (np > s->opts.elim_max_occ || nn > s->opts.elim_max_occ)) {
+                continue;  // Revisited if its occurrences shrink
+            }
+            if (!try_lock(s, v, locked_vars, &num_locked)) {
+                deferred[num_deferred++] = v;
+                continue;
+            }
+            jobs[num_jobs].var = v;
+            num_jobs++;
+            spent += (uint64_t)np * nn + 1;
+        }
+        if (num_jobs == 0) break;
+
+        // Resolve in parallel; the clause database is read-only here
+        batch.jobs = jobs;
+        batch.num_jobs = num_jobs;
+        atomic_init(&batch.next, 0);
+        uint32_t used = num_jobs < threads ? num_jobs : threads;
+        uint32_t started = 1;
+        for (uint32_t t = 0; t < used; t++) {
+            workers[t].batch = &batch;
+            workers[t].out_size = 0;
+        }
+        for (uint32_t t = 1; t < used; t++) {
+            if (pthread_create(&workers[t].thread, NULL, elim_worker_main, &workers[t]) != 0) break;
+            started++;
+        }
+        elim_worker_main(&workers[0]);
+        for (uint32_t t = 1; t < started; t++) {
+            pthread_join(workers[t].thread, NULL);
+        }
+        e->batches++;
 
-    // Push to elimination stack
-    if (s->elim->stack_size >= s->elim->stack_capacity) {
-        uint32_t new_cap = s->elim->stack_capacity * 2;
-        ElimEntry* new_stack = (ElimEntry*)realloc(s->elim->stack, new_cap * sizeof(ElimEntry));
-        if (new_stack) {
-            s->elim->stack = new_stack;
-            s->elim->stack_capacity = new_cap;
+        // Commit in heap order
+        for (uint32_t i = 0; i < num_locked; i++) e->locked[locked_vars[i]] = 0;
+        for (uint32_t i = 0; i < num_jobs && s->result != FALSE; i++) {
+            if (!jobs[i].eliminate) continue;
+            if (commit_elimination(s, &workers[jobs[i].worker], &jobs[i])) eliminated++;
         }
+        for (uint32_t i = 0; i < num_deferred; i++) heap_touch(s, deferred[i]);
     }
 
-    if (s->elim->stack_size < s->elim->stack_capacity) {
-        s->elim->stack[s->elim->stack_size++] = entry;
-    } else {
-        free(entry.clause);  // Couldn't save, free the copy
+    for (uint32_t t = 0; workers && t < threads; t++) {
+        e->resolvents_subsumed += workers[t].subsumed;
+        free(workers[t].marks);
+        free(workers[t].sigs);
+        free(workers[t].out);
     }
+    free(workers);
+    free(jobs);
+    free(deferred);
+    free(locked_vars);
+
+    // Back to the solver's representation; occurrence lists are not
+    // needed after preprocessing
+    restore_binaries(s);
+    elim_clear_occs(s);
+    for (uint32_t i = 0; i < e->heap_size; i++) e->heap_pos[e->heap[i]] = UINT32_MAX;
+    e->heap_size = 0;
+    e->threads = threads;
+    e->time += now_seconds() - start;
+    return eliminated;
+}
 
-    // Note: eliminated variables are tracked in s->elim->eliminated[v]
-    // The solver's decide() function should check this before making decisions
-    // We don't set value=TRUE because that would confuse the solver
+uint32_t elim_preprocess(Solver* s) {
+    if (!s->opts.elim) return 0;
 
-    return true;
+    uint32_t eliminated = elim_run(s, UINT64_MAX);
+    ElimState* e = s->elim;
+    if (eliminated > 0 && !s->opts.quiet) {
+        printf("c [BVE] Eliminated %u variables, removed %llu clauses, added %llu resolvents "
+               "(%llu subsumed) in %.2fs, %u threads\n",
+               eliminated,
+               (unsigned long long)e->clauses_removed,
+               (unsigned long long)e->resolvents_added,
+               (unsigned long long)e->resolvents_subsumed,
+               e->time, e->threads);
+    }
+
+    return eliminated;
 }
 
 /*********************************************************************
- * Main BVE Preprocessing Loop
+ * Blocked Clause Elimination
+ *
+ * C is blocked on l if every clause D containing ¬l has a literal k
+ * with ¬k in C, so no resolvent on l can be falsified. Removing C keeps
+ * the formula satisfiable; if a model falsifies C, making l true fixes
+ * it without falsifying any D, which is what reconstruction does.
  *********************************************************************/
 
-uint32_t elim_preprocess(Solver* s) {
-    if (!s->opts.elim) return 0;
+// Is the clause (its literals marked in marks) blocked on l?
+static bool clause_blocked_on(Solver* s, const uint8_t* marks, Lit l, uint64_t* spent) {
+    const OccList* ol = &s->elim->occs[neg(l)];
+    for (uint32_t i = 0; i < ol->size; i++) {
+        CRef cref = ol->occs[i].cref;
+        if (clause_deleted(s->arena, cref)) continue;
+        const Lit* lits = CLAUSE_LITS(s->arena, cref);
+        uint32_t size = CLAUSE_SIZE(s->arena, cref);
+        *spent += size;
 
-    // Initialize elimination state
-    elim_init(s);
-    if (!s->elim) return 0;
+        bool taut = false;
+        for (uint32_t k = 0; k < size && !taut; k++) {
+            taut = lits[k] != neg(l) && marks[neg(lits[k])];
+        }
+        if (!taut) return false;
+    }
+    return true;
+}
 
-    // Build occurrence lists
-    elim_build_occs(s);
+// Remove a clause blocked on l, saving it with l first
+static bool remove_blocked(Solver* s, CRef cref, Lit l) {
+    ElimState* e = s->elim;
+    uint32_t size = CLAUSE_SIZE(s->arena, cref);
+    const Lit* lits = CLAUSE_LITS(s->arena, cref);
 
-    uint32_t eliminated = 0;
+    uint32_t stack_mark = e->stack_size;
+    bool ok = stack_push(e, l);
+    for (uint32_t j = 0; j < size && ok; j++) {
+        if (lits[j] != l) ok = stack_push(e, lits[j]);
+    }
+    if (!ok || !stack_push(e, size)) {
+        e->stack_size = stack_mark;
+        return false;
+    }
 
-    // Single pass elimination (safer than iterative)
-    // Can do multiple passes but requires careful occurrence list management
-    for (Var v = 1; v <= s->num_vars; v++) {
-        if (s->elim->eliminated[v]) continue;
-        if (s->vars[v].value != UNDEF) continue;
+    if (s->proof) {
+        proof_delete_clause(s, lits, size);
+    }
+    arena_delete(s->arena, cref);
+    for (uint32_t j = 0; j < size; j++) e->live[lits[j]]--;
+    e->clauses_blocked++;
+    return true;
+}
 
-        int cost = elim_cost(s, v);
-        if (cost != ELIM_SKIP && cost <= 0) {  // Beneficial (cost <= 0 means net reduction)
-            if (elim_eliminate_var(s, v)) {
-                eliminated++;
+uint32_t elim_blocked_clauses(Solver* s, uint64_t effort) {
+    elim_init(s);
+    if (!s->elim || s->elim->elim_capacity < s->num_vars + 1) return 0;
+    ElimState* e = s->elim;
+    double start = now_seconds();
+
+    uint8_t* marks = (uint8_t*)calloc(2 * (s->num_vars + 1), sizeof(uint8_t));
+    if (!marks) return 0;
+    if (!elim_build_occs(s)) {
+        free(marks);
+        return 0;
+    }
 
-                // Check for UNSAT
-                if (s->result == FALSE) {
-                    return eliminated;
-                }
+    // Blocking literals must not be frozen: a clause added later could
+    // contain their negation
+    uint32_t removed = 0;
+    uint64_t spent = 0;
+    for (Var v = 1; v <= s->num_vars && spent < effort; v++) {
+        if (!candidate(s, v)) continue;
+        for (int side = 0; side < 2; side++) {
+            Lit l = mkLit(v, side);
+            if (e->live[l] == 0 || e->live[neg(l)] > ELIM_BLOCKED_MAX_OCC) continue;
+
+            const OccList* ol = &e->occs[l];
+            for (uint32_t i = 0; i < ol->size && spent < effort; i++) {
+                CRef cref = ol->occs[i].cref;
+                if (clause_deleted(s->arena, cref)) continue;
+                const Lit* lits = CLAUSE_LITS(s->arena, cref);
+                uint32_t size = CLAUSE_SIZE(s->arena, cref);
+                spent += size;
+
+                for (uint32_t j = 0; j < size; j++) marks[lits[j]] = 1;
+                bool blocked = clause_blocked_on(s, marks, l, &spent);
+                for (uint32_t j = 0; j < size; j++) marks[lits[j]] = 0;
+
+                if (blocked && remove_blocked(s, cref, l)) removed++;
             }
         }
     }
+    free(marks);
 
-    if (eliminated > 0 && !s->opts.quiet) {
-        printf("c [BVE] Eliminated %u variables, removed %llu clauses, added %llu resolvents\n",
-               eliminated,
-               (unsigned long long)s->elim->clauses_removed,
-               (unsigned long long)s->elim->resolvents_added);
-    }
-
-    return eliminated;
+    restore_binaries(s);
+    elim_clear_occs(s);
+    e->time += now_seconds() - start;
+    return removed;
 }
 
 /*********************************************************************
@@ -694,44 +990,115 @@ uint32_t elim_preprocess(Solver* s) {
 void elim_extend_model(Solver* s) {
     if (!s->elim || s->elim->stack_size == 0) return;
 
-    // Process elimination stack in reverse order
-    for (int i = (int)s->elim->stack_size - 1; i >= 0; i--) {
-        ElimEntry* entry = &s->elim->stack[i];
-        Var v = entry->var;
+    // Walk the stack backwards: every saved clause that is not satisfied
+    // by its other literals makes its first (eliminated) literal true
+    const Lit* stack = s->elim->stack;
+    uint32_t i = s->elim->stack_size;
+    while (i > 0) {
+        uint32_t size = stack[--i];
+        i -= size;
+        const Lit* clause = &stack[i];
 
-        if (!entry->clause || entry->clause_size == 0) {
-            // No saved clause - assign arbitrarily (true)
-            s->vars[v].value = TRUE;
-            continue;
-        }
-
-        // Check if saved clause is satisfied by current model
         bool satisfied = false;
-        Lit v_lit = INVALID_LIT;
-
-        for (uint32_t j = 0; j < entry->clause_size; j++) {
-            Lit lit = entry->clause[j];
-            if (var(lit) == v) {
-                v_lit = lit;
-            } else {
-                // Check if this literal is satisfied
-                lbool val = s->vars[var(lit)].value;
-                if ((val == TRUE && !sign(lit)) || (val == FALSE && sign(lit))) {
-                    satisfied = true;
-                    break;
-                }
-            }
+        for (uint32_t j = 1; j < size && !satisfied; j++) {
+            satisfied = lit_value(s, clause[j]) == TRUE;
         }
+        if (!satisfied) {
+            assign_lit(s, clause[0]);
+        }
+    }
+}
 
-        if (!satisfied && v_lit != INVALID_LIT) {
-            // Clause is not satisfied by other literals
-            // v_lit must be true to satisfy clause
-            s->vars[v].value = sign(v_lit) ? FALSE : TRUE;
-        } else {
-            // Clause already satisfied, assign v arbitrarily
-            s->vars[v].value = TRUE;
+/*********************************************************************
+ * Restoring Removed Clauses
+ *********************************************************************/
+
+// Mark the first-literal variables of all stack entries
+static bool witness_build(ElimState* e) {
+    if (e->witness_stack == e->stack_size && e->witness_vars == e->elim_capacity) return true;
+
+    uint8_t* witness = (uint8_t*)calloc(e->elim_capacity, sizeof(uint8_t));
+    if (!witness) return false;
+    for (uint32_t i = e->stack_size; i > 0; ) {
+        uint32_t size = e->stack[--i];
+        i -= size;
+        witness[var(e->stack[i])] = 1;
+    }
+    free(e->witness);
+    e->witness = witness;
+    e->witness_vars = e->elim_capacity;
+    e->witness_stack = e->stack_size;
+    return true;
+}
+
+bool elim_restore(Solver* s, const Lit* lits, uint32_t size,
+                  Lit** restored, uint32_t* restored_size) {
+    *restored = NULL;
+    *restored_size = 0;
+    ElimState* e = s->elim;
+    if (!e || e->stack_size == 0) return true;
+    if (!witness_build(e)) return false;
+
+    bool hit = false;
+    for (uint32_t i = 0; i < size && !hit; i++) {
+        Var v = var(lits[i]);
+        hit = v < e->witness_vars && e->witness[v];
+    }
+    if (!hit) return true;
+
+    // Entry start offsets in stack order (sizes are stored at the end)
+    uint32_t entries = 0;
+    for (uint32_t i = e->stack_size; i > 0; entries++) i -= e->stack[i - 1] + 1;
+    uint32_t* starts = (uint32_t*)malloc(entries * sizeof(uint32_t));
+    uint8_t* taint = (uint8_t*)calloc(e->elim_capacity, sizeof(uint8_t));
+    Lit* out = (Lit*)malloc(e->stack_size * sizeof(Lit));
+    if (!starts || !taint || !out) {
+        free(starts);
+        free(taint);
+        free(out);
+        return false;
+    }
+    for (uint32_t i = e->stack_size, k = entries; i > 0; ) {
+        i -= e->stack[i - 1] + 1;
+        starts[--k] = i;
+    }
+
+    // One pass in stack order: an entry on a tainted variable is taken
+    // off, and its literals taint later entries. Kept entries move down
+    // over the ones taken off.
+    for (uint32_t i = 0; i < size; i++) {
+        if (var(lits[i]) < e->elim_capacity) taint[var(lits[i])] = 1;
+    }
+    uint32_t kept = 0, n = 0;
+    for (uint32_t k = 0; k < entries; k++) {
+        const Lit* entry = &e->stack[starts[k]];
+        uint32_t entry_size = (k + 1 < entries ? starts[k + 1] : e->stack_size) - starts[k] - 1;
+        Var w = var(entry[0]);
+        if (!taint[w]) {
+            memmove(&e->stack[kept], entry, (entry_size + 1) * sizeof(Lit));
+            kept += entry_size + 1;
+            continue;
+        }
+        e->eliminated[w] = false;
+        if (entry_size == 1) continue;  // Default unit of an eliminated variable
+        out[n++] = entry_size;
+        for (uint32_t j = 0; j < entry_size; j++) {
+            out[n++] = entry[j];
+            taint[var(entry[j])] = 1;
         }
     }
+    e->stack_size = kept;
+    free(starts);
+    free(taint);
+
+    if (n == 0) {
+        free(out);
+    } else {
+        *restored = out;
+        *restored_size = n;
+    }
+    witness_build(e);  // Retried by the next call if memory ran out
+    return true;
 }
 
 /*********************************************************************
@@ -743,11 +1110,6 @@ bool elim_is_eliminated(const Solver* s, Var v) {
     return s->elim->eliminated[v];
 }
 
-OccList* elim_get_occs(Solver* s, Lit lit) {
-    if (!s->elim || lit >= s->elim->occs_capacity) return NULL;
-    return &s->elim->occs[lit];
-}
-
 void elim_print_stats(const Solver* s) {
     if (!s->elim) return;
 
@@ -755,5 +1117,10 @@ void elim_print_stats(const Solver* s) {
     printf("c Variables eliminated: %llu\n", (unsigned long long)s->elim->vars_eliminated);
     printf("c Clauses removed     : %llu\n", (unsigned long long)s->elim->clauses_removed);
     printf("c Resolvents added    : %llu\n", (unsigned long long)s->elim->resolvents_added);
+    printf("c Resolvents subsumed : %llu\n", (unsigned long long)s->elim->resolvents_subsumed);
+    printf("c Blocked clauses     : %llu\n", (unsigned long long)s->elim->clauses_blocked);
+    printf("c Batches             : %llu (%u threads)\n",
+           (unsigned long long)s->elim->batches, s->elim->threads);
+    printf("c Time                : %.2fs\n", s->elim->time);
     printf("c =====================================\n");
 }
@@ -0,0 +1,908 @@
+/*********************************************************************
+ * BSAT Competition Solver - XOR Reasoning Implementation
+ *
+ * XOR recovery, matrix construction and Gauss-Jordan propagation (see
+ * gauss.h), and the CNF encoding behind solver_add_xor.
+ *********************************************************************/
+
+#include "../include/gauss.h"
+#include "../include/solver.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*********************************************************************
+ * Bit Rows
+ *********************************************************************/
+
+static inline uint64_t* row_bits(const GaussMatrix* m, uint32_t r) {
+    return &m->bits[(size_t)r * m->words];
+}
+
+static inline bool bit_test(const uint64_t* bits, uint32_t c) {
+    return (bits[c / 64] >> (c % 64)) & 1;
+}
+
+static inline void bit_set(uint64_t* bits, uint32_t c) {
+    bits[c / 64] |= 1ULL << (c % 64);
+}
+
+static inline void bit_clear(uint64_t* bits, uint32_t c) {
+    bits[c / 64] &= ~(1ULL << (c % 64));
+}
+
+// dst ^= src. A plain word loop, which -O3 -march=native turns into
+// 256- or 512-bit vector XORs.
+static inline void row_xor(uint64_t* restrict dst, const uint64_t* restrict src, uint32_t words) {
+    for (uint32_t w = 0; w < words; w++) dst[w] ^= src[w];
+}
+
+// Parity of the assigned columns of a row that are true
+static inline bool row_parity(const GaussMatrix* m, const uint64_t* row) {
+    uint32_t ones = 0;
+    for (uint32_t w = 0; w < m->words; w++) {
+        ones += (uint32_t)__builtin_popcountll(row[w] & m->values[w]);
+    }
+    return ones & 1;
+}
+
+// First unassigned column of a row other than skip (GAUSS_NONE if none)
+static uint32_t free_column(const GaussMatrix* m, const uint64_t* row, uint32_t skip) {
+    for (uint32_t w = 0; w < m->words; w++) {
+        uint64_t free = row[w] & ~m->assigned[w];
+        if (w == skip / 64) free &= ~(1ULL << (skip % 64));
+        if (free) return w * 64 + (uint32_t)__builtin_ctzll(free);
+    }
+    return GAUSS_NONE;
+}
+
+// Unassigned column whose variable is not on the trail either. Only
+// such a column may become basic: a row whose open columns are all
+// pending waits for them instead.
+static uint32_t open_column(const Solver* s, const GaussMatrix* m, const uint64_t* row) {
+    for (uint32_t w = 0; w < m->words; w++) {
+        uint64_t free = row[w] & ~m->assigned[w];
+        while (free) {
+            uint32_t c = w * 64 + (uint32_t)__builtin_ctzll(free);
+            if (var_value(s, m->vars[c]) == UNDEF) return c;
+            free &= free - 1;
+        }
+    }
+    return GAUSS_NONE;
+}
+
+/*********************************************************************
+ * Row Watches and Queue
+ *********************************************************************/
+
+// Move the non-basic watch of row r to column c (GAUSS_NONE = none). If
+// the list cannot grow the row stays unwatched, which only loses
+// propagations.
+static void set_watch(GaussMatrix* m, uint32_t r, uint32_t c) {
+    uint32_t old = m->watch[r];
+    if (old == c) return;
+    if (old != GAUSS_NONE) {
+        GaussWatches* ws = &m->watches[old];
+        uint32_t last = ws->rows[--ws->size];
+        ws->rows[m->watch_pos[r]] = last;
+        m->watch_pos[last] = m->watch_pos[r];
+    }
+    m->watch[r] = GAUSS_NONE;
+    if (c == GAUSS_NONE) return;
+
+    GaussWatches* ws = &m->watches[c];
+    if (ws->size == ws->capacity) {
+        uint32_t new_cap = ws->capacity ? ws->capacity * 2 : 4;
+        uint32_t* rows = (uint32_t*)realloc(ws->rows, new_cap * sizeof(uint32_t));
+        if (!rows) return;
+        ws->rows = rows;
+        ws->capacity = new_cap;
+    }
+    m->watch[r] = c;
+    m->watch_pos[r] = ws->size;
+    ws->rows[ws->size++] = r;
+}
+
+static inline void enqueue_row(GaussMatrix* m, uint32_t r) {
+    if (m->queued[r]) return;
+    m->queued[r] = 1;
+    m->queue[m->queue_size++] = r;
+}
+
+/*********************************************************************
+ * Implications and Conflicts
+ *********************************************************************/
+
+// Clause of row r under the current assignment, where every column but
+// the implied one is assigned: implied first (LIT_UNDEF for a conflict),
+// then the false literal of each other column
+static CRef row_clause(Solver* s, GaussMatrix* m, uint32_t r, Lit implied) {
+    GaussState* g = s->gauss;
+    const uint64_t* row = row_bits(m, r);
+    Lit* lits = g->scratch;
+    uint32_t size = 0;
+
+    if (implied != LIT_UNDEF) lits[size++] = implied;
+    for (uint32_t w = 0; w < m->words; w++) {
+        uint64_t bits = row[w];
+        while (bits) {
+            Var v = m->vars[w * 64 + (uint32_t)__builtin_ctzll(bits)];
+            bits &= bits - 1;
+            if (implied != LIT_UNDEF && v == var(implied)) continue;
+            ASSERT(var_value(s, v) != UNDEF);
+            lits[size++] = mkLit(v, var_value(s, v) == TRUE);
+        }
+    }
+
+    if (g->num_reasons == g->reasons_capacity) {
+        uint32_t new_cap = g->reasons_capacity ? g->reasons_capacity * 2 : 1024;
+        CRef* reasons = (CRef*)realloc(g->reasons, new_cap * sizeof(CRef));
+        if (!reasons) return INVALID_CLAUSE;
+        g->reasons = reasons;
+        g->reasons_capacity = new_cap;
+    }
+    CRef cref = arena_alloc(s->arena, lits, size, false);
+    if (cref != INVALID_CLAUSE) g->reasons[g->num_reasons++] = cref;
+    return cref;
+}
+
+// Row r has column c as its only unassigned one: make it satisfy the
+// row. Returns a conflict clause if c is already on the trail with the
+// other value. Without memory for the reason the literal is left to the
+// clauses.
+static CRef imply(Solver* s, GaussMatrix* m, uint32_t r, uint32_t c) {
+    bool value = m->rhs[r] ^ row_parity(m, row_bits(m, r));
+    Lit lit = mkLit(m->vars[c], !value);
+
+    lbool current = lit_value(s, lit);
+    if (current == TRUE) return INVALID_CLAUSE;
+    if (current == FALSE) {
+        s->stats.gauss_conflicts++;
+        return row_clause(s, m, r, LIT_UNDEF);
+    }
+
+    // Level-0 literals need no reason
+    CRef reason = INVALID_CLAUSE;
+    if (s->decision_level > 0) {
+        reason = row_clause(s, m, r, lit);
+        if (reason == INVALID_CLAUSE) return INVALID_CLAUSE;
+    }
+
+    Var v = var(lit);
+    assign_lit(s, lit);
+    s->levels[v] = s->decision_level;
+    s->reasons[v] = reason;
+    s->trail_pos[v] = s->trail_size;
+
+    s->trail[s->trail_size].lit = lit;
+    s->trail[s->trail_size].level = s->decision_level;
+    s->trail_size++;
+
+    if (s->opts.phase_saving) {
+        s->vars[v].polarity = !sign(lit);
+    }
+    s->stats.gauss_propagations++;
+    return INVALID_CLAUSE;
+}
+
+// Make column c (unassigned, non-basic) the basic column of row r by
+// adding r to every other row containing c. The changed rows are
+// queued: their watch may have been cancelled out.
+static void pivot(Solver* s, GaussMatrix* m, uint32_t r, uint32_t c) {
+    m->basic_row[m->basic[r]] = GAUSS_NONE;
+    m->basic[r] = c;
+    m->basic_row[c] = r;
+
+    const uint64_t* src = row_bits(m, r);
+    uint32_t word = c / 64;
+    uint64_t mask = 1ULL << (c % 64);
+    for (uint32_t r2 = 0; r2 < m->num_rows; r2++) {
+        uint64_t* dst = row_bits(m, r2);
+        if (r2 == r || !(dst[word] & mask)) continue;
+        row_xor(dst, src, m->words);
+        m->rhs[r2] ^= m->rhs[r];
+        enqueue_row(m, r2);
+    }
+    s->stats.gauss_pivots++;
+}
+
+// Restore the watches of row r after one of its columns was assigned or
+// the row changed, implying its last open column or reporting a
+// conflict when there is none
+static CRef check_row(Solver* s, GaussMatrix* m, uint32_t r) {
+    const uint64_t* row = row_bits(m, r);
+    uint32_t b = m->basic[r];
+    uint32_t w = m->watch[r];
+    bool watch_ok = w != GAUSS_NONE && bit_test(row, w) && !bit_test(m->assigned, w);
+
+    if (!bit_test(m->assigned, b)) {
+        // Open basic column: a second open column keeps the row quiet
+        if (watch_ok) return INVALID_CLAUSE;
+        w = free_column(m, row, b);
+        if (w != GAUSS_NONE) {
+            set_watch(m, r, w);
+            return INVALID_CLAUSE;
+        }
+        return imply(s, m, r, b);
+    }
+
+    uint32_t first = free_column(m, row, GAUSS_NONE);
+    if (first == GAUSS_NONE) {
+        if (m->rhs[r] == row_parity(m, row)) return INVALID_CLAUSE;
+        s->stats.gauss_conflicts++;
+        return row_clause(s, m, r, LIT_UNDEF);
+    }
+    if (free_column(m, row, first) == GAUSS_NONE) {
+        set_watch(m, r, first);
+        return imply(s, m, r, first);
+    }
+
+    // Assigned basic column and two or more open ones: swap the basic
+    // column for an open one
+    uint32_t c = open_column(s, m, row);
+    if (c != GAUSS_NONE) {
+        pivot(s, m, r, c);
+        if (!watch_ok || w == c) set_watch(m, r, free_column(m, row, c));
+        return INVALID_CLAUSE;
+    }
+
+    // All open columns are pending on the trail: wait for them
+    if (!watch_ok) set_watch(m, r, first);
+    return INVALID_CLAUSE;
+}
+
+// Check the queued rows. A conflict leaves the rest for a full check on
+// the next call.
+static CRef check_rows(Solver* s, GaussMatrix* m) {
+    while (m->queue_size > 0) {
+        uint32_t r = m->queue[--m->queue_size];
+        m->queued[r] = 0;
+        CRef conflict = check_row(s, m, r);
+        if (conflict != INVALID_CLAUSE) {
+            while (m->queue_size > 0) m->queued[m->queue[--m->queue_size]] = 0;
+            m->recheck = true;
+            return conflict;
+        }
+    }
+    return INVALID_CLAUSE;
+}
+
+/*********************************************************************
+ * Propagation and Backtracking
+ *********************************************************************/
+
+CRef gauss_propagate(Solver* s) {
+    GaussState* g = s->gauss;
+    if (g->num_reasons > 2 * g->reasons_kept + 1024) gauss_release_reasons(s);
+
+    for (uint32_t i = 0; i < g->num_matrices; i++) {
+        GaussMatrix* m = &g->matrices[i];
+        if (!m->recheck) continue;
+        m->recheck = false;
+        for (uint32_t r = 0; r < m->num_rows; r++) enqueue_row(m, r);
+        CRef conflict = check_rows(s, m);
+        if (conflict != INVALID_CLAUSE) return conflict;
+    }
+
+    while (g->qhead < s->trail_size) {
+        Lit lit = s->trail[g->qhead++].lit;
+        Var v = var(lit);
+        if (v > g->num_vars || g->var_matrix[v] == 0) continue;
+
+        GaussMatrix* m = &g->matrices[g->var_matrix[v] - 1];
+        uint32_t c = g->var_col[v];
+        if (bit_test(m->assigned, c)) continue;  // Seen before the trail was compacted
+
+        bit_set(m->assigned, c);
+        if (!sign(lit)) bit_set(m->values, c);
+        g->stack[g->stack_size++] = v;
+
+        if (m->basic_row[c] != GAUSS_NONE) enqueue_row(m, m->basic_row[c]);
+        const GaussWatches* ws = &m->watches[c];
+        for (uint32_t k = 0; k < ws->size; k++) enqueue_row(m, ws->rows[k]);
+
+        CRef conflict = check_rows(s, m);
+        if (conflict != INVALID_CLAUSE) return conflict;
+    }
+
+    return INVALID_CLAUSE;
+}
+
+static void unassign_column(GaussState* g, Var v) {
+    GaussMatrix* m = &g->matrices[g->var_matrix[v] - 1];
+    bit_clear(m->assigned, g->var_col[v]);
+    bit_clear(m->values, g->var_col[v]);
+}
+
+void gauss_backtrack(Solver* s, bool compacted) {
+    GaussState* g = s->gauss;
+
+    if (!compacted) {
+        // The trail lost a suffix, and so did the processed variables
+        while (g->stack_size > 0 && var_value(s, g->stack[g->stack_size - 1]) == UNDEF) {
+            unassign_column(g, g->stack[--g->stack_size]);
+        }
+        if (g->qhead > s->trail_size) g->qhead = s->trail_size;
+        return;
+    }
+
+    // Level-0 literals were moved down: keep their columns, and rescan
+    // the trail (processed columns are skipped). The rows are checked
+    // again, which also restores open basic columns.
+    uint32_t j = 0;
+    for (uint32_t i = 0; i < g->stack_size; i++) {
+        Var v = g->stack[i];
+        if (var_value(s, v) != UNDEF) {
+            g->stack[j++] = v;
+        } else {
+            unassign_column(g, v);
+        }
+    }
+    g->stack_size = j;
+    g->qhead = 0;
+    for (uint32_t i = 0; i < g->num_matrices; i++) g->matrices[i].recheck = true;
+}
+
+// A reason clause is in use while its first literal is true because of it
+static inline bool reason_locked(const Solver* s, CRef cref) {
+    Lit first = CLAUSE_LITS(s->arena, cref)[0];
+    return s->reasons[var(first)] == cref && lit_value(s, first) == TRUE;
+}
+
+void gauss_release_reasons(Solver* s) {
+    GaussState* g = s->gauss;
+    if (!g) return;
+
+    uint32_t j = 0;
+    for (uint32_t i = 0; i < g->num_reasons; i++) {
+        CRef cref = g->reasons[i];
+        if (reason_locked(s, cref)) {
+            g->reasons[j++] = cref;
+        } else {
+            arena_delete(s->arena, cref);
+        }
+    }
+    g->num_reasons = j;
+    g->reasons_kept = j;
+}
+
+void gauss_move_reasons(Solver* s) {
+    GaussState* g = s->gauss;
+    if (!g) return;
+
+    uint32_t j = 0;
+    for (uint32_t i = 0; i < g->num_reasons; i++) {
+        CRef moved = arena_gc_move(s->arena, g->reasons[i]);
+        if (moved != INVALID_CLAUSE) g->reasons[j++] = moved;
+    }
+    g->num_reasons = j;
+}
+
+/*********************************************************************
+ * XOR Recovery
+ *********************************************************************/
+
+typedef struct Xor {
+    Var      vars[GAUSS_MAX_XOR_SIZE];  // Sorted
+    uint32_t size;
+    bool     rhs;
+} Xor;
+
+typedef struct XorList {
+    Xor*     xors;
+    uint32_t size;
+    uint32_t capacity;
+} XorList;
+
+static bool xor_push(XorList* list, const Var* vars, uint32_t size, bool rhs) {
+    if (list->size == list->capacity) {
+        uint32_t new_cap = list->capacity ? list->capacity * 2 : 256;
+        Xor* xors = (Xor*)realloc(list->xors, new_cap * sizeof(Xor));
+        if (!xors) return false;
+        list->xors = xors;
+        list->capacity = new_cap;
+    }
+    Xor* x = &list->xors[list->size++];
+    memcpy(x->vars, vars, size * sizeof(Var));
+    x->size = size;
+    x->rhs = rhs;
+    return true;
+}
+
+// A clause that may belong to an XOR encoding, keyed by its variables
+typedef struct XorCand {
+    uint64_t hash;
+    CRef     cref;
+} XorCand;
+
+// Variables of a clause in increasing order and the signs in that order
+// (bit i = literal i is negative). False if a variable repeats.
+static bool clause_pattern(const Lit* lits, uint32_t size, Var* vars, uint32_t* mask) {
+    Lit sorted[GAUSS_MAX_XOR_SIZE];
+    for (uint32_t i = 0; i < size; i++) {
+        Lit lit = lits[i];
+        uint32_t j = i;
+        while (j > 0 && var(sorted[j - 1]) > var(lit)) {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = lit;
+    }
+    *mask = 0;
+    for (uint32_t i = 0; i < size; i++) {
+        if (i > 0 && var(sorted[i]) == var(sorted[i - 1])) return false;
+        vars[i] = var(sorted[i]);
+        if (sign(sorted[i])) *mask |= 1u << i;
+    }
+    return true;
+}
+
+static uint64_t vars_hash(const Var* vars, uint32_t size) {
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (uint32_t i = 0; i < size; i++) {
+        h = (h ^ vars[i]) * 0x100000001b3ULL;
+    }
+    return h;
+}
+
+static int cand_cmp(const void* a, const void* b) {
+    const XorCand* x = (const XorCand*)a;
+    const XorCand* y = (const XorCand*)b;
+    if (x->hash != y->hash) return x->hash < y->hash ? -1 : 1;
+    return x->cref < y->cref ? -1 : x->cref > y->cref;
+}
+
+// XORs of 3 to GAUSS_MAX_XOR_SIZE variables from the long irredundant
+// clauses. The clauses are sorted by a hash of their variables; clauses
+// of one XOR are then neighbors, and a group of 2^(k-1) with the same
+// variables and the same sign parity excludes every assignment of that
+// parity.
+static bool find_long_xors(Solver* s, XorList* list) {
+    XorCand* cands = (XorCand*)malloc((s->num_clauses + 1) * sizeof(XorCand));
+    if (!cands) return false;
+
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < s->num_clauses; i++) {
+        CRef cref = s->clauses[i];
+        if (cref == INVALID_CLAUSE || clause_deleted(s->arena, cref)) continue;
+        if (clause_learned(s->arena, cref)) continue;
+        uint32_t size = CLAUSE_SIZE(s->arena, cref);
+        if (size < 3 || size > GAUSS_MAX_XOR_SIZE) continue;
+
+        Var vars[GAUSS_MAX_XOR_SIZE];
+        uint32_t mask;
+        if (!clause_pattern(CLAUSE_LITS(s->arena, cref), size, vars, &mask)) continue;
+        cands[n].hash = vars_hash(vars, size) ^ size;
+        cands[n].cref = cref;
+        n++;
+    }
+    qsort(cands, n, sizeof(XorCand), cand_cmp);
+
+    bool ok = true;
+    uint8_t* used = (uint8_t*)calloc(n + 1, 1);
+    if (!used) ok = false;
+
+    for (uint32_t start = 0; ok && start < n; ) {
+        uint32_t end = start + 1;
+        while (end < n && cands[end].hash == cands[start].hash) end++;
+
+        uint32_t size = CLAUSE_SIZE(s->arena, cands[start].cref);
+        if (end - start >= (1u << (size - 1))) {
+            for (uint32_t i = start; ok && i < end; i++) {
+                if (used[i]) continue;
+                Var vars[GAUSS_MAX_XOR_SIZE];
+                uint32_t mask;
+                clause_pattern(CLAUSE_LITS(s->arena, cands[i].cref), size, vars, &mask);
+                uint32_t parity = (uint32_t)__builtin_popcount(mask) & 1;
+                uint32_t patterns = 1u << mask;
+
+                for (uint32_t j = i + 1; j < end; j++) {
+                    if (used[j] || CLAUSE_SIZE(s->arena, cands[j].cref) != size) continue;
+                    Var other[GAUSS_MAX_XOR_SIZE];
+                    uint32_t other_mask;
+                    clause_pattern(CLAUSE_LITS(s->arena, cands[j].cref), size, other, &other_mask);
+                    if (memcmp(vars, other, size * sizeof(Var)) != 0) continue;
+                    if (((uint32_t)__builtin_popcount(other_mask) & 1) != parity) continue;
+                    patterns |= 1u << other_mask;
+                    used[j] = 1;
+                }
+
+                if ((uint32_t)__builtin_popcount(patterns) == (1u << (size - 1))) {
+                    ok = xor_push(list, vars, size, !parity);
+                }
+            }
+        }
+        start = end;
+    }
+
+    free(used);
+    free(cands);
+    return ok;
+}
+
+// Two-variable XORs (equivalences): (a | q) and (~a | ~q) make
+// a ^ var(q) = !sign(q)
+static bool find_binary_xors(Solver* s, XorList* list) {
+    uint8_t* marks = (uint8_t*)calloc(2 * ((size_t)s->num_vars + 1), 1);
+    if (!marks) return false;
+
+    bool ok = true;
+    for (Var a = 1; ok && a <= s->num_vars; a++) {
+        Lit pos = mkLit(a, false);
+        const BinList* neg_bins = bin_list(s->watches, neg(pos));
+        for (uint32_t i = 0; i < neg_bins->size; i++) marks[neg_bins->lits[i]] = 1;
+
+        const BinList* pos_bins = bin_list(s->watches, pos);
+        for (uint32_t i = 0; ok && i < pos_bins->size; i++) {
+            Lit q = pos_bins->lits[i];
+            if (var(q) <= a || !marks[neg(q)]) continue;
+            Var vars[2] = { a, var(q) };
+            ok = xor_push(list, vars, 2, !sign(q));
+        }
+
+        for (uint32_t i = 0; i < neg_bins->size; i++) marks[neg_bins->lits[i]] = 0;
+    }
+
+    free(marks);
+    return ok;
+}
+
+/*********************************************************************
+ * Matrix Construction
+ *********************************************************************/
+
+static uint32_t uf_find(uint32_t* parent, uint32_t v) {
+    while (parent[v] != v) {
+        parent[v] = parent[parent[v]];
+        v = parent[v];
+    }
+    return v;
+}
+
+static void matrix_free(GaussMatrix* m) {
+    free(m->bits);
+    free(m->rhs);
+    free(m->basic);
+    free(m->basic_row);
+    free(m->watch);
+    free(m->watch_pos);
+    if (m->watches) {
+        for (uint32_t c = 0; c < m->num_cols; c++) free(m->watches[c].rows);
+    }
+    free(m->watches);
+    free(m->vars);
+    free(m->assigned);
+    free(m->values);
+    free(m->queue);
+    free(m->queued);
+}
+
+static bool matrix_alloc(GaussMatrix* m, uint32_t rows, uint32_t cols) {
+    m->num_rows = rows;
+    m->num_cols = cols;
+    m->words = (cols + 63) / 64;
+    m->bits = (uint64_t*)calloc((size_t)rows * m->words, sizeof(uint64_t));
+    m->rhs = (uint8_t*)calloc(rows, 1);
+    m->basic = (uint32_t*)malloc(rows * sizeof(uint32_t));
+    m->basic_row = (uint32_t*)malloc(cols * sizeof(uint32_t));
+    m->watch = (uint32_t*)malloc(rows * sizeof(uint32_t));
+    m->watch_pos = (uint32_t*)calloc(rows, sizeof(uint32_t));
+    m->watches = (GaussWatches*)calloc(cols, sizeof(GaussWatches));
+    m->vars = (Var*)malloc(cols * sizeof(Var));
+    m->assigned = (uint64_t*)calloc(m->words, sizeof(uint64_t));
+    m->values = (uint64_t*)calloc(m->words, sizeof(uint64_t));
+    m->queue = (uint32_t*)malloc(rows * sizeof(uint32_t));
+    m->queued = (uint8_t*)calloc(rows, 1);
+    if (!m->bits || !m->rhs || !m->basic || !m->basic_row || !m->watch || !m->watch_pos ||
+        !m->watches || !m->vars || !m->assigned || !m->values || !m->queue || !m->queued) {
+        return false;
+    }
+    for (uint32_t r = 0; r < rows; r++) m->watch[r] = GAUSS_NONE;
+    for (uint32_t c = 0; c < cols; c++) m->basic_row[c] = GAUSS_NONE;
+    return true;
+}
+
+// Reduced row echelon form: every row gets a basic column that no other
+// row contains. Zero rows are dropped; returns false for 0 = 1.
+static bool matrix_eliminate(GaussMatrix* m) {
+    uint32_t rank = 0;
+    for (uint32_t r = 0; r < m->num_rows; r++) {
+        uint64_t* row = row_bits(m, r);
+        uint32_t c = free_column(m, row, GAUSS_NONE);
+        if (c == GAUSS_NONE) {
+            if (m->rhs[r]) return false;
+            continue;
+        }
+        for (uint32_t r2 = 0; r2 < m->num_rows; r2++) {
+            uint64_t* other = row_bits(m, r2);
+            if (r2 == r || !bit_test(other, c)) continue;
+            row_xor(other, row, m->words);
+            m->rhs[r2] ^= m->rhs[r];
+        }
+        m->basic[r] = c;
+        rank++;
+    }
+
+    // Move the nonzero rows down
+    uint32_t j = 0;
+    for (uint32_t r = 0; r < m->num_rows; r++) {
+        if (free_column(m, row_bits(m, r), GAUSS_NONE) == GAUSS_NONE) continue;
+        if (j != r) {
+            memcpy(row_bits(m, j), row_bits(m, r), m->words * sizeof(uint64_t));
+            m->rhs[j] = m->rhs[r];
+            m->basic[j] = m->basic[r];
+        }
+        m->basic_row[m->basic[j]] = j;
+        j++;
+    }
+    ASSERT(j == rank);
+    m->num_rows = j;
+
+    for (uint32_t r = 0; r < m->num_rows; r++) {
+        set_watch(m, r, free_column(m, row_bits(m, r), m->basic[r]));
+    }
+    return true;
+}
+
+// Split the XORs into connected components and build a matrix for each
+// one with enough rows. Returns false on 0 = 1 (s->result is FALSE).
+static bool build_matrices(Solver* s, GaussState* g, const XorList* list, bool* built) {
+    uint32_t n = s->num_vars + 1;
+    uint32_t* parent = (uint32_t*)malloc(n * sizeof(uint32_t));
+    uint32_t* comp = (uint32_t*)malloc(n * sizeof(uint32_t));      // Root -> component
+    uint32_t* rows = (uint32_t*)calloc(list->size + 1, sizeof(uint32_t));
+    uint32_t* cols = (uint32_t*)calloc(list->size + 1, sizeof(uint32_t));
+    uint32_t* xor_comp = (uint32_t*)malloc((list->size + 1) * sizeof(uint32_t));
+    uint32_t* matrix_of = (uint32_t*)malloc((list->size + 1) * sizeof(uint32_t));
+    bool ok = true;
+    *built = false;
+    if (!parent || !comp || !rows || !cols || !xor_comp || !matrix_of) goto done;
+
+    for (uint32_t v = 0; v < n; v++) {
+        parent[v] = v;
+        comp[v] = GAUSS_NONE;
+    }
+    for (uint32_t i = 0; i < list->size; i++) {
+        const Xor* x = &list->xors[i];
+        uint32_t root = uf_find(parent, x->vars[0]);
+        for (uint32_t k = 1; k < x->size; k++) {
+            uint32_t other = uf_find(parent, x->vars[k]);
+            if (other != root) parent[other] = root;
+        }
+    }
+
+    // Components, their rows and their columns (numbered as met)
+    uint32_t num_comps = 0;
+    for (uint32_t i = 0; i < list->size; i++) {
+        uint32_t root = uf_find(parent, list->xors[i].vars[0]);
+        if (comp[root] == GAUSS_NONE) comp[root] = num_comps++;
+        xor_comp[i] = comp[root];
+        rows[xor_comp[i]]++;
+    }
+    for (uint32_t i = 0; i < list->size; i++) {
+        const Xor* x = &list->xors[i];
+        for (uint32_t k = 0; k < x->size; k++) {
+            Var v = x->vars[k];
+            if (g->var_matrix[v] == 0) {
+                g->var_matrix[v] = xor_comp[i] + 1;
+                g->var_col[v] = cols[xor_comp[i]]++;
+            }
+        }
+    }
+
+    uint32_t num_matrices = 0;
+    for (uint32_t c = 0; c < num_comps; c++) {
+        bool keep = rows[c] >= GAUSS_MIN_ROWS && cols[c] <= GAUSS_MAX_COLS;
+        matrix_of[c] = keep ? num_matrices++ : GAUSS_NONE;
+    }
+    if (num_matrices == 0) goto done;
+
+    g->matrices = (GaussMatrix*)calloc(num_matrices, sizeof(GaussMatrix));
+    if (!g->matrices) goto done;
+    g->num_matrices = num_matrices;
+    for (uint32_t c = 0; c < num_comps; c++) {
+        if (matrix_of[c] == GAUSS_NONE) continue;
+        if (!matrix_alloc(&g->matrices[matrix_of[c]], rows[c], cols[c])) goto done;
+        rows[c] = 0;  // Rows filled so far
+    }
+
+    // Column maps point at matrices now; variables of dropped components
+    // lose theirs
+    uint32_t widest = 0;
+    for (Var v = 1; v < n; v++) {
+        if (g->var_matrix[v] == 0) continue;
+        uint32_t m_index = matrix_of[g->var_matrix[v] - 1];
+        if (m_index == GAUSS_NONE) {
+            g->var_matrix[v] = 0;
+            continue;
+        }
+        GaussMatrix* m = &g->matrices[m_index];
+        m->vars[g->var_col[v]] = v;
+        g->var_matrix[v] = m_index + 1;
+        if (m->num_cols > widest) widest = m->num_cols;
+    }
+    for (uint32_t i = 0; i < list->size; i++) {
+        uint32_t m_index = matrix_of[xor_comp[i]];
+        if (m_index == GAUSS_NONE) continue;
+        GaussMatrix* m = &g->matrices[m_index];
+        const Xor* x = &list->xors[i];
+        uint32_t r = rows[xor_comp[i]]++;
+        uint64_t* row = row_bits(m, r);
+        for (uint32_t k = 0; k < x->size; k++) row[g->var_col[x->vars[k]] / 64] ^= 1ULL << (g->var_col[x->vars[k]] % 64);
+        m->rhs[r] = x->rhs;
+    }
+
+    g->scratch = (Lit*)malloc((widest + 1) * sizeof(Lit));
+    if (!g->scratch) goto done;
+
+    for (uint32_t i = 0; i < g->num_matrices; i++) {
+        GaussMatrix* m = &g->matrices[i];
+        if (!matrix_eliminate(m)) {
+            s->result = FALSE;
+            ok = false;
+            goto done;
+        }
+        m->recheck = true;  // Rows of one column are level-0 units
+        g->num_rows += m->num_rows;
+        g->num_cols += m->num_cols;
+    }
+
+    g->stack = (Var*)malloc((g->num_cols + 1) * sizeof(Var));
+    if (!g->stack) goto done;
+    *built = true;
+
+done:
+    free(parent);
+    free(comp);
+    free(rows);
+    free(cols);
+    free(xor_comp);
+    free(matrix_of);
+    return ok;
+}
+
+void gauss_free(Solver* s) {
+    GaussState* g = s->gauss;
+    if (!g) return;
+
+    for (uint32_t i = 0; i < g->num_matrices; i++) matrix_free(&g->matrices[i]);
+    free(g->matrices);
+    free(g->var_matrix);
+    free(g->var_col);
+    free(g->stack);
+    free(g->reasons);
+    free(g->scratch);
+    free(g);
+    s->gauss = NULL;
+}
+
+bool gauss_init(Solver* s) {
+    if (s->gauss || s->decision_level > 0) return true;
+    if (s->proof) {
+        // Row sums have no DRAT derivation of reasonable size
+        if (!s->opts.quiet) printf("c [Gauss] Disabled with proof logging\n");
+        return true;
+    }
+
+    XorList list = { NULL, 0, 0 };
+    if (!find_long_xors(s, &list) || !find_binary_xors(s, &list) || list.size == 0) {
+        free(list.xors);
+        return true;
+    }
+
+    GaussState* g = (GaussState*)calloc(1, sizeof(GaussState));
+    if (!g) {
+        free(list.xors);
+        return true;
+    }
+    s->gauss = g;
+    g->num_xors = list.size;
+    g->num_vars = s->num_vars;
+    g->var_matrix = (uint32_t*)calloc(s->num_vars + 1, sizeof(uint32_t));
+    g->var_col = (uint32_t*)calloc(s->num_vars + 1, sizeof(uint32_t));
+
+    bool built = false;
+    bool consistent = true;
+    if (g->var_matrix && g->var_col) {
+        consistent = build_matrices(s, g, &list, &built);
+    }
+    free(list.xors);
+
+    if (!consistent) {
+        if (!s->opts.quiet) printf("c [Gauss] %u XORs are inconsistent\n", g->num_xors);
+        gauss_free(s);
+        return false;
+    }
+
+    if (!s->opts.quiet) {
+        printf("c [Gauss] %u XORs, %u matrices (%u rows, %u columns)\n",
+               g->num_xors, built ? g->num_matrices : 0, built ? g->num_rows : 0,
+               built ? g->num_cols : 0);
+    }
+    if (!built) {
+        gauss_free(s);
+        return true;
+    }
+
+    // BCE and BVE must leave the encodings of the rows alone
+    for (Var v = 1; v <= g->num_vars; v++) {
+        if (g->var_matrix[v]) s->vars[v].in_matrix = true;
+    }
+    return true;
+}
+
+/*********************************************************************
+ * XOR Encoding
+ *********************************************************************/
+
+// The 2^(size-1) clauses excluding every assignment of vars whose parity
+// is not rhs (the clause with signs mask excludes the assignment that
+// makes the variables with a negative literal true)
+static bool add_xor_clauses(Solver* s, const Var* vars, uint32_t size, bool rhs) {
+    if (size == 0) {
+        // Empty XOR: 0 = rhs, false exactly when rhs is 1
+        if (rhs) s->result = FALSE;
+        return !rhs;
+    }
+
+    Lit lits[GAUSS_MAX_XOR_SIZE];
+    bool ok = true;
+
+    for (uint32_t mask = 0; ok && mask < (1u << size); mask++) {
+        if (((uint32_t)__builtin_popcount(mask) & 1) == (uint32_t)rhs) continue;
+        for (uint32_t i = 0; i < size; i++) lits[i] = mkLit(vars[i], (mask >> i) & 1);
+        ok = solver_add_clause(s, lits, size);
+    }
+    return ok;
+}
+
+static int var_cmp(const void* a, const void* b) {
+    Var x = *(const Var*)a;
+    Var y = *(const Var*)b;
+    return x < y ? -1 : x > y;
+}
+
+bool solver_add_xor(Solver* s, const Lit* lits, uint32_t size) {
+    if (s->result == FALSE) return false;
+
+    Var* vars = (Var*)malloc((size + 1) * sizeof(Var));
+    if (!vars) return false;
+
+    // A negative literal flips the parity; a variable twice cancels out
+    bool rhs = true;
+    for (uint32_t i = 0; i < size; i++) {
+        vars[i] = var(lits[i]);
+        rhs ^= sign(lits[i]);
+    }
+    qsort(vars, size, sizeof(Var), var_cmp);
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < size; i++) {
+        if (n > 0 && vars[n - 1] == vars[i]) {
+            n--;
+        } else {
+            vars[n++] = vars[i];
+        }
+    }
+
+    // Cut long XORs from the end: the last GAUSS_XOR_CUT - 1 variables
+    // XOR a fresh one to 0, and the fresh one takes their place
+    bool ok = true;
+    while (ok && n > GAUSS_MAX_XOR_SIZE) {
+        if (s->num_input_vars == 0) s->num_input_vars = s->num_vars;
+        Var aux = solver_new_var(s);
+        if (aux == INVALID_VAR) {
+            ok = false;
+            break;
+        }
+        Var piece[GAUSS_XOR_CUT];
+        n -= GAUSS_XOR_CUT - 1;
+        memcpy(piece, &vars[n], (GAUSS_XOR_CUT - 1) * sizeof(Var));
+        piece[GAUSS_XOR_CUT - 1] = aux;
+        ok = add_xor_clauses(s, piece, GAUSS_XOR_CUT, false);
+        vars[n++] = aux;
+    }
+    if (ok) ok = add_xor_clauses(s, vars, n, rhs);
+
+    free(vars);
+    return ok;
+}
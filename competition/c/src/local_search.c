@@ -1,222 +1,326 @@
 /*********************************************************************
  * BSAT Competition Solver - Local Search Implementation
  *
- * WalkSAT-style local search for hybrid CDCL+LS solving.
+ * WalkSAT/ProbSAT local search for hybrid CDCL+LS solving.
  *********************************************************************/
 
+#define _POSIX_C_SOURCE 200809L  // clock_gettime
+
 #include "../include/local_search.h"
 #include "../include/solver.h"
+#include "../include/timer.h"
 #include "../include/arena.h"
+#include "../include/watch.h"
 #include "../include/types.h"
+#include <math.h>
 #include <stdlib.h>
 #include <string.h>
-#include <time.h>
 
 /*********************************************************************
  * Helper Functions
  *********************************************************************/
 
-static inline bool lit_value(LocalSearchState* ls, Lit lit) {
+// xorshift64*
+static inline uint64_t ls_random(LocalSearchState* ls) {
+    ls->rng ^= ls->rng >> 12;
+    ls->rng ^= ls->rng << 25;
+    ls->rng ^= ls->rng >> 27;
+    return ls->rng * 0x2545F4914F6CDD1DULL;
+}
+
+// Uniform in [0, n)
+static inline uint32_t ls_random_below(LocalSearchState* ls, uint32_t n) {
+    return (uint32_t)(((ls_random(ls) >> 32) * n) >> 32);
+}
+
+// Uniform in [0, 1)
+static inline double ls_random_double(LocalSearchState* ls) {
+    return (ls_random(ls) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static inline bool ls_lit_true(LocalSearchState* ls, Lit lit) {
     Var v = var(lit);
     bool val = ls->assignment[v];
     return sign(lit) ? !val : val;
 }
 
-static inline void flip_var(LocalSearchState* ls, Var v) {
-    ls->assignment[v] = !ls->assignment[v];
+static inline void unsat_add(LocalSearchState* ls, uint32_t c) {
+    ls->unsat_pos[c] = ls->num_unsat;
+    ls->unsat[ls->num_unsat++] = c;
+}
+
+static inline void unsat_remove(LocalSearchState* ls, uint32_t c) {
+    uint32_t last = ls->unsat[--ls->num_unsat];
+    uint32_t pos = ls->unsat_pos[c];
+    ls->unsat[pos] = last;
+    ls->unsat_pos[last] = pos;
 }
 
 /**
- * Initialize assignment from solver's saved phases.
+ * Grow the per-variable arrays to cover variables 1..num_vars.
  */
-static void init_assignment_from_phases(LocalSearchState* ls, Solver* s) {
-    for (Var v = 1; v <= ls->num_vars; v++) {
-        ls->assignment[v] = s->vars[v].polarity;
+static bool ls_grow_vars(LocalSearchState* ls, uint32_t num_vars) {
+    size_t n = (size_t)num_vars + 1;
+    bool* assignment = (bool*)realloc(ls->assignment, n * sizeof(bool));
+    if (!assignment) return false;
+    ls->assignment = assignment;
+    bool* fixed = (bool*)realloc(ls->fixed, n * sizeof(bool));
+    if (!fixed) return false;
+    ls->fixed = fixed;
+    uint32_t* break_count = (uint32_t*)realloc(ls->break_count, n * sizeof(uint32_t));
+    if (!break_count) return false;
+    ls->break_count = break_count;
+    uint32_t* occ_start = (uint32_t*)realloc(ls->occ_start, (2 * n + 1) * sizeof(uint32_t));
+    if (!occ_start) return false;
+    ls->occ_start = occ_start;
+
+    for (size_t v = ls->num_vars + 1; v < n; v++) {
+        ls->assignment[v] = false;
+        ls->fixed[v] = false;
+        ls->break_count[v] = 0;
     }
+    ls->num_vars = num_vars;
+    ls->occs_dirty = true;
+    return true;
 }
 
 /**
- * Count true literals in a clause.
+ * Make room for one more clause of the given size.
  */
-static uint32_t count_true_lits(LocalSearchState* ls, uint32_t c) {
-    uint32_t count = 0;
-    for (uint32_t i = 0; i < ls->clause_sizes[c]; i++) {
-        if (lit_value(ls, ls->clause_lits[c][i])) {
-            count++;
-        }
+static bool ls_reserve_clause(LocalSearchState* ls, uint32_t size) {
+    if (ls->num_clauses + 1 > ls->clause_capacity) {
+        uint32_t cap = ls->clause_capacity ? ls->clause_capacity * 2 : 1024;
+        size_t n = (size_t)cap + 1;
+        uint32_t* clause_start = (uint32_t*)realloc(ls->clause_start, n * sizeof(uint32_t));
+        if (!clause_start) return false;
+        ls->clause_start = clause_start;
+        uint32_t* num_true_lits = (uint32_t*)realloc(ls->num_true_lits, n * sizeof(uint32_t));
+        if (!num_true_lits) return false;
+        ls->num_true_lits = num_true_lits;
+        Var* true_xor = (Var*)realloc(ls->true_xor, n * sizeof(Var));
+        if (!true_xor) return false;
+        ls->true_xor = true_xor;
+        uint32_t* unsat = (uint32_t*)realloc(ls->unsat, n * sizeof(uint32_t));
+        if (!unsat) return false;
+        ls->unsat = unsat;
+        uint32_t* unsat_pos = (uint32_t*)realloc(ls->unsat_pos, n * sizeof(uint32_t));
+        if (!unsat_pos) return false;
+        ls->unsat_pos = unsat_pos;
+        ls->clause_capacity = cap;
+    }
+
+    uint32_t used = ls->clause_start[ls->num_clauses];
+    if (used + size > ls->lits_capacity) {
+        uint32_t cap = ls->lits_capacity ? ls->lits_capacity : 4096;
+        while (cap < used + size) cap *= 2;
+        Lit* lits = (Lit*)realloc(ls->lits, (size_t)cap * sizeof(Lit));
+        if (!lits) return false;
+        ls->lits = lits;
+        uint32_t* occs = (uint32_t*)realloc(ls->occs, (size_t)cap * sizeof(uint32_t));
+        if (!occs) return false;
+        ls->occs = occs;
+        ls->lits_capacity = cap;
+    }
+
+    if (size > ls->max_clause_size) {
+        double* weights = (double*)realloc(ls->weights, (size_t)size * sizeof(double));
+        if (!weights) return false;
+        ls->weights = weights;
+        ls->max_clause_size = size;
     }
-    return count;
+    return true;
 }
 
 /**
- * Initialize satisfaction counts and break scores.
+ * Append a clause without updating the occurrence lists.
  */
-static void init_clause_state(LocalSearchState* ls) {
-    ls->num_unsat = 0;
-
-    // Initialize true literal counts
-    for (uint32_t c = 0; c < ls->num_clauses; c++) {
-        ls->num_true_lits[c] = count_true_lits(ls, c);
-        if (ls->num_true_lits[c] == 0) {
-            ls->num_unsat++;
-        }
+static bool ls_push_clause(LocalSearchState* ls, const Lit* lits, uint32_t size) {
+    for (uint32_t i = 0; i < size; i++) {
+        if (var(lits[i]) > ls->num_vars && !ls_grow_vars(ls, var(lits[i]))) return false;
     }
+    if (!ls_reserve_clause(ls, size)) return false;
 
-    // Initialize break counts
-    // break_count[v] = (clauses that become unsat if we flip v) - (clauses that become sat)
-    memset(ls->break_count, 0, (ls->num_vars + 1) * sizeof(int32_t));
+    uint32_t pos = ls->clause_start[ls->num_clauses];
+    memcpy(&ls->lits[pos], lits, size * sizeof(Lit));
+    ls->clause_start[++ls->num_clauses] = pos + size;
+    ls->occs_dirty = true;
+    return true;
+}
 
-    for (Var v = 1; v <= ls->num_vars; v++) {
-        bool current_val = ls->assignment[v];
-
-        // Clauses where v appears positively
-        // If v is true, flipping makes these literals false
-        // If v is false, flipping makes these literals true
-        for (uint32_t i = 0; i < ls->pos_occ_count[v]; i++) {
-            uint32_t c = ls->pos_occs[v][i];
-            if (current_val) {
-                // v is true, lit is true. Flipping makes lit false.
-                if (ls->num_true_lits[c] == 1) {
-                    ls->break_count[v]++;  // Would break clause
-                }
-            } else {
-                // v is false, lit is false. Flipping makes lit true.
-                if (ls->num_true_lits[c] == 0) {
-                    ls->break_count[v]--;  // Would satisfy clause
-                }
-            }
-        }
+/**
+ * Lay out the occurrence lists (CSR by literal) from the clauses:
+ * count into occ_start[lit], prefix sums give the end of each list,
+ * then fill backwards so occ_start[lit] ends at the start of the list.
+ */
+static void ls_layout_occs(LocalSearchState* ls) {
+    uint32_t num_lits = 2 * (ls->num_vars + 1);
+    uint32_t total = ls->clause_start[ls->num_clauses];
 
-        // Clauses where v appears negatively
-        for (uint32_t i = 0; i < ls->neg_occ_count[v]; i++) {
-            uint32_t c = ls->neg_occs[v][i];
-            if (!current_val) {
-                // v is false, neg(v) is true. Flipping makes neg(v) false.
-                if (ls->num_true_lits[c] == 1) {
-                    ls->break_count[v]++;  // Would break clause
-                }
-            } else {
-                // v is true, neg(v) is false. Flipping makes neg(v) true.
-                if (ls->num_true_lits[c] == 0) {
-                    ls->break_count[v]--;  // Would satisfy clause
-                }
-            }
+    memset(ls->occ_start, 0, (num_lits + 1) * sizeof(uint32_t));
+    for (uint32_t i = 0; i < total; i++) {
+        ls->occ_start[ls->lits[i]]++;
+    }
+    for (uint32_t l = 1; l < num_lits; l++) {
+        ls->occ_start[l] += ls->occ_start[l - 1];
+    }
+    ls->occ_start[num_lits] = total;
+    for (uint32_t c = ls->num_clauses; c-- > 0;) {
+        for (uint32_t i = ls->clause_start[c]; i < ls->clause_start[c + 1]; i++) {
+            ls->occs[--ls->occ_start[ls->lits[i]]] = c;
         }
     }
+    ls->occs_dirty = false;
 }
 
 /**
- * Update clause state after flipping variable v.
+ * Initialize assignment from the best phases seen by rephasing (saved
+ * phases if there are none). Variables fixed at level 0 take their value.
  */
-static void update_after_flip(LocalSearchState* ls, Var v) {
-    bool new_val = ls->assignment[v];
-
-    // Process positive occurrences
-    for (uint32_t i = 0; i < ls->pos_occ_count[v]; i++) {
-        uint32_t c = ls->pos_occs[v][i];
-        uint32_t old_true = ls->num_true_lits[c];
-
-        if (new_val) {
-            // Literal became true
-            ls->num_true_lits[c]++;
-            if (old_true == 0) {
-                ls->num_unsat--;
-            }
+static void init_assignment(LocalSearchState* ls, Solver* s) {
+    bool best = s->opts.rephase && s->rephase.best_phase && s->rephase.best_trail_size > 0;
+    for (Var v = 1; v <= ls->num_vars; v++) {
+        lbool val = var_value(s, v);
+        ls->fixed[v] = val != UNDEF;
+        if (val != UNDEF) {
+            ls->assignment[v] = val == TRUE;
         } else {
-            // Literal became false
-            ls->num_true_lits[c]--;
-            if (old_true == 1) {
-                ls->num_unsat++;
-            }
+            ls->assignment[v] = best ? s->rephase.best_phase[v] : s->vars[v].polarity;
         }
     }
+}
 
-    // Process negative occurrences
-    for (uint32_t i = 0; i < ls->neg_occ_count[v]; i++) {
-        uint32_t c = ls->neg_occs[v][i];
-        uint32_t old_true = ls->num_true_lits[c];
+/**
+ * Initialize satisfaction counts, critical variables, the unsatisfied
+ * set and break counts from scratch.
+ */
+static void init_clause_state(LocalSearchState* ls) {
+    ls->num_unsat = 0;
+    memset(ls->break_count, 0, (ls->num_vars + 1) * sizeof(uint32_t));
 
-        if (!new_val) {
-            // neg(v) literal became true
-            ls->num_true_lits[c]++;
-            if (old_true == 0) {
-                ls->num_unsat--;
-            }
-        } else {
-            // neg(v) literal became false
-            ls->num_true_lits[c]--;
-            if (old_true == 1) {
-                ls->num_unsat++;
+    for (uint32_t c = 0; c < ls->num_clauses; c++) {
+        uint32_t count = 0;
+        Var x = 0;
+        for (uint32_t i = ls->clause_start[c]; i < ls->clause_start[c + 1]; i++) {
+            if (ls_lit_true(ls, ls->lits[i])) {
+                count++;
+                x ^= var(ls->lits[i]);
             }
         }
+        ls->num_true_lits[c] = count;
+        ls->true_xor[c] = x;
+        if (count == 0) {
+            unsat_add(ls, c);
+        } else if (count == 1) {
+            ls->break_count[x]++;
+        }
     }
+}
 
-    // Update break counts for v and its neighbors
-    // This is simplified - a full implementation would update all affected variables
-    // For now, we just recalculate break_count for v
-    ls->break_count[v] = 0;
-    for (uint32_t i = 0; i < ls->pos_occ_count[v]; i++) {
-        uint32_t c = ls->pos_occs[v][i];
-        if (new_val && ls->num_true_lits[c] == 1) {
+/**
+ * Flip v and update clause state. Only the occurrences of v are visited.
+ */
+static void flip_var(LocalSearchState* ls, Var v) {
+    ls->assignment[v] = !ls->assignment[v];
+    Lit now_true = mkLit(v, !ls->assignment[v]);
+    Lit now_false = neg(now_true);
+
+    for (uint32_t i = ls->occ_start[now_true]; i < ls->occ_start[now_true + 1]; i++) {
+        uint32_t c = ls->occs[i];
+        uint32_t count = ++ls->num_true_lits[c];
+        if (count == 1) {
+            // Newly satisfied, v is its only true literal
+            unsat_remove(ls, c);
             ls->break_count[v]++;
-        } else if (!new_val && ls->num_true_lits[c] == 0) {
-            ls->break_count[v]--;
+        } else if (count == 2) {
+            // The previous critical variable is no longer critical
+            ls->break_count[ls->true_xor[c]]--;
         }
+        ls->true_xor[c] ^= v;
     }
-    for (uint32_t i = 0; i < ls->neg_occ_count[v]; i++) {
-        uint32_t c = ls->neg_occs[v][i];
-        if (!new_val && ls->num_true_lits[c] == 1) {
-            ls->break_count[v]++;
-        } else if (new_val && ls->num_true_lits[c] == 0) {
+
+    for (uint32_t i = ls->occ_start[now_false]; i < ls->occ_start[now_false + 1]; i++) {
+        uint32_t c = ls->occs[i];
+        uint32_t count = --ls->num_true_lits[c];
+        ls->true_xor[c] ^= v;
+        if (count == 0) {
+            // Newly unsatisfied, v was critical
+            unsat_add(ls, c);
             ls->break_count[v]--;
+        } else if (count == 1) {
+            // The remaining true literal becomes critical
+            ls->break_count[ls->true_xor[c]]++;
         }
     }
 }
 
 /**
- * Pick a random unsatisfied clause.
+ * Pick variable to flip from clause using WalkSAT heuristic.
+ * A variable with break count 0 is always taken. Otherwise, with
+ * probability noise, pick a random variable from the clause, and with
+ * probability (1-noise) the variable with minimum break count.
+ * Fixed variables are skipped; returns 0 if all of them are fixed.
  */
-static uint32_t pick_unsat_clause(LocalSearchState* ls) {
-    // Count unsatisfied clauses and pick random one
-    uint32_t target = rand() % ls->num_unsat;
-    uint32_t count = 0;
-    for (uint32_t c = 0; c < ls->num_clauses; c++) {
-        if (ls->num_true_lits[c] == 0) {
-            if (count == target) {
-                return c;
-            }
-            count++;
+static Var pick_walksat(LocalSearchState* ls, uint32_t c, double noise) {
+    const Lit* lits = &ls->lits[ls->clause_start[c]];
+    uint32_t size = ls->clause_start[c + 1] - ls->clause_start[c];
+
+    Var best_var = 0;
+    uint32_t best_break = UINT32_MAX;
+    uint32_t ties = 0, free_vars = 0;
+    for (uint32_t i = 0; i < size; i++) {
+        Var v = var(lits[i]);
+        if (ls->fixed[v]) continue;
+        free_vars++;
+        uint32_t b = ls->break_count[v];
+        if (b < best_break) {
+            best_var = v;
+            best_break = b;
+            ties = 1;
+        } else if (b == best_break && ls_random_below(ls, ++ties) == 0) {
+            best_var = v;  // Reservoir sampling among ties
+        }
+    }
+
+    if (best_var != 0 && best_break > 0 && ls_random_double(ls) < noise) {
+        uint32_t k = ls_random_below(ls, free_vars);
+        for (uint32_t i = 0; i < size; i++) {
+            Var v = var(lits[i]);
+            if (!ls->fixed[v] && k-- == 0) return v;
         }
     }
-    // Shouldn't reach here
-    return 0;
+    return best_var;
 }
 
 /**
- * Pick variable to flip from clause using WalkSAT heuristic.
- * With probability (1-noise), pick variable with minimum break count.
- * With probability noise, pick random variable from clause.
+ * Pick variable to flip with probability proportional to
+ * (eps + break)^-cb (ProbSAT, polynomial break-only variant).
+ * Fixed variables get weight 0; returns 0 if all of them are fixed.
  */
-static Var pick_var_to_flip(LocalSearchState* ls, uint32_t c, double noise) {
-    // Random walk with probability noise
-    if ((rand() / (double)RAND_MAX) < noise) {
-        uint32_t idx = rand() % ls->clause_sizes[c];
-        return var(ls->clause_lits[c][idx]);
-    }
-
-    // Greedy: pick variable with minimum break count
-    Var best_var = var(ls->clause_lits[c][0]);
-    int32_t best_break = ls->break_count[best_var];
-
-    for (uint32_t i = 1; i < ls->clause_sizes[c]; i++) {
-        Var v = var(ls->clause_lits[c][i]);
-        if (ls->break_count[v] < best_break) {
-            best_var = v;
-            best_break = ls->break_count[v];
+static Var pick_probsat(LocalSearchState* ls, uint32_t c) {
+    const Lit* lits = &ls->lits[ls->clause_start[c]];
+    uint32_t size = ls->clause_start[c + 1] - ls->clause_start[c];
+
+    double total = 0.0;
+    Var last = 0;
+    for (uint32_t i = 0; i < size; i++) {
+        Var v = var(lits[i]);
+        if (ls->fixed[v]) {
+            ls->weights[i] = 0.0;
+            continue;
         }
+        uint32_t b = ls->break_count[v];
+        if (b >= LS_PROB_TABLE_SIZE) b = LS_PROB_TABLE_SIZE - 1;
+        ls->weights[i] = ls->prob_table[b];
+        total += ls->weights[i];
+        last = v;
     }
 
-    return best_var;
+    double r = ls_random_double(ls) * total;
+    for (uint32_t i = 0; i < size; i++) {
+        r -= ls->weights[i];
+        if (r < 0.0) return var(lits[i]);
+    }
+    return last;
 }
 
 /*********************************************************************
@@ -227,88 +331,35 @@ LocalSearchState* local_search_init(Solver* s) {
     LocalSearchState* ls = (LocalSearchState*)calloc(1, sizeof(LocalSearchState));
     if (!ls) return NULL;
 
-    ls->num_vars = s->num_vars;
-    ls->num_clauses = s->num_clauses;
-
-    // Allocate assignment
-    ls->assignment = (bool*)calloc(ls->num_vars + 1, sizeof(bool));
-    if (!ls->assignment) goto error;
+    uint32_t num_lits = 2 * (s->num_vars + 1);
+    ls->clause_start = (uint32_t*)calloc(1, sizeof(uint32_t));
+    if (!ls->clause_start || !ls_grow_vars(ls, s->num_vars)) goto error;
 
-    // Allocate clause tracking
-    ls->num_true_lits = (uint32_t*)calloc(ls->num_clauses, sizeof(uint32_t));
-    if (!ls->num_true_lits) goto error;
-
-    // Allocate break counts
-    ls->break_count = (int32_t*)calloc(ls->num_vars + 1, sizeof(int32_t));
-    if (!ls->break_count) goto error;
-
-    // Allocate clause data arrays
-    ls->clause_lits = (Lit**)calloc(ls->num_clauses, sizeof(Lit*));
-    ls->clause_sizes = (uint32_t*)calloc(ls->num_clauses, sizeof(uint32_t));
-    if (!ls->clause_lits || !ls->clause_sizes) goto error;
-
-    // Copy clause data from solver
+    // Long clauses come from the clause list, binary clauses only live in
+    // the implication lists (taken once, from their smaller literal)
     for (uint32_t i = 0; i < s->num_clauses; i++) {
         CRef cref = s->clauses[i];
-        uint32_t size = CLAUSE_SIZE(s->arena, cref);
-        Lit* lits = CLAUSE_LITS(s->arena, cref);
-
-        ls->clause_sizes[i] = size;
-        ls->clause_lits[i] = (Lit*)malloc(size * sizeof(Lit));
-        if (!ls->clause_lits[i]) goto error;
-
-        for (uint32_t j = 0; j < size; j++) {
-            ls->clause_lits[i][j] = lits[j];
+        if (cref == INVALID_CLAUSE || clause_deleted(s->arena, cref)) continue;
+        if (!ls_push_clause(ls, CLAUSE_LITS(s->arena, cref), CLAUSE_SIZE(s->arena, cref))) {
+            goto error;
         }
     }
-
-    // Allocate occurrence lists
-    ls->pos_occs = (uint32_t**)calloc(ls->num_vars + 1, sizeof(uint32_t*));
-    ls->pos_occ_count = (uint32_t*)calloc(ls->num_vars + 1, sizeof(uint32_t));
-    ls->neg_occs = (uint32_t**)calloc(ls->num_vars + 1, sizeof(uint32_t*));
-    ls->neg_occ_count = (uint32_t*)calloc(ls->num_vars + 1, sizeof(uint32_t));
-    if (!ls->pos_occs || !ls->pos_occ_count || !ls->neg_occs || !ls->neg_occ_count) goto error;
-
-    // Count occurrences
-    for (uint32_t c = 0; c < ls->num_clauses; c++) {
-        for (uint32_t j = 0; j < ls->clause_sizes[c]; j++) {
-            Lit lit = ls->clause_lits[c][j];
-            Var v = var(lit);
-            if (sign(lit)) {
-                ls->neg_occ_count[v]++;
-            } else {
-                ls->pos_occ_count[v]++;
-            }
+    for (Lit lit = 2; lit < num_lits; lit++) {
+        BinList* bl = bin_list(s->watches, lit);
+        for (uint32_t k = 0; k < bl->size; k++) {
+            if (lit >= bl->lits[k]) continue;
+            Lit bin[2] = { lit, bl->lits[k] };
+            if (!ls_push_clause(ls, bin, 2)) goto error;
         }
     }
+    ls_layout_occs(ls);
 
-    // Allocate occurrence list arrays
-    for (Var v = 1; v <= ls->num_vars; v++) {
-        if (ls->pos_occ_count[v] > 0) {
-            ls->pos_occs[v] = (uint32_t*)malloc(ls->pos_occ_count[v] * sizeof(uint32_t));
-            if (!ls->pos_occs[v]) goto error;
-        }
-        if (ls->neg_occ_count[v] > 0) {
-            ls->neg_occs[v] = (uint32_t*)malloc(ls->neg_occ_count[v] * sizeof(uint32_t));
-            if (!ls->neg_occs[v]) goto error;
-        }
-    }
-
-    // Fill occurrence lists (reset counts as indices)
-    memset(ls->pos_occ_count, 0, (ls->num_vars + 1) * sizeof(uint32_t));
-    memset(ls->neg_occ_count, 0, (ls->num_vars + 1) * sizeof(uint32_t));
-
-    for (uint32_t c = 0; c < ls->num_clauses; c++) {
-        for (uint32_t j = 0; j < ls->clause_sizes[c]; j++) {
-            Lit lit = ls->clause_lits[c][j];
-            Var v = var(lit);
-            if (sign(lit)) {
-                ls->neg_occs[v][ls->neg_occ_count[v]++] = c;
-            } else {
-                ls->pos_occs[v][ls->pos_occ_count[v]++] = c;
-            }
-        }
+    // Heuristic
+    ls->probsat = s->opts.ls_probsat;
+    for (uint32_t b = 0; b < LS_PROB_TABLE_SIZE; b++) {
+        ls->prob_table[b] = pow(LS_PROBSAT_EPS + b, -s->opts.ls_cb);
     }
+    ls->rng = 0x9E3779B97F4A7C15ULL ^ ((uint64_t)ls->num_clauses << 32) ^ ls->num_vars;
 
     return ls;
 
@@ -321,84 +372,67 @@ void local_search_free(LocalSearchState* ls) {
     if (!ls) return;
 
     free(ls->assignment);
+    free(ls->fixed);
+    free(ls->lits);
+    free(ls->clause_start);
+    free(ls->occ_start);
+    free(ls->occs);
     free(ls->num_true_lits);
+    free(ls->true_xor);
+    free(ls->unsat);
+    free(ls->unsat_pos);
     free(ls->break_count);
-
-    if (ls->clause_lits) {
-        for (uint32_t i = 0; i < ls->num_clauses; i++) {
-            free(ls->clause_lits[i]);
-        }
-        free(ls->clause_lits);
-    }
-    free(ls->clause_sizes);
-
-    if (ls->pos_occs) {
-        for (Var v = 1; v <= ls->num_vars; v++) {
-            free(ls->pos_occs[v]);
-        }
-        free(ls->pos_occs);
-    }
-    free(ls->pos_occ_count);
-
-    if (ls->neg_occs) {
-        for (Var v = 1; v <= ls->num_vars; v++) {
-            free(ls->neg_occs[v]);
-        }
-        free(ls->neg_occs);
-    }
-    free(ls->neg_occ_count);
-
+    free(ls->weights);
     free(ls);
 }
 
+bool local_search_add_clause(LocalSearchState* ls, const Lit* lits, uint32_t size) {
+    if (!ls_push_clause(ls, lits, size)) return false;
+    ls->added_clauses++;
+    return true;
+}
+
 bool local_search_run(Solver* s, LocalSearchState* ls, uint32_t max_flips, double noise) {
-    // Initialize assignment from saved phases
-    init_assignment_from_phases(ls, s);
+    double start = now_seconds();
+
+    // Catch up with variables and clauses added since the last call
+    if (s->num_vars > ls->num_vars && !ls_grow_vars(ls, s->num_vars)) return false;
+    if (ls->occs_dirty) ls_layout_occs(ls);
+
+    // Initialize assignment from best phases and level-0 facts
+    init_assignment(ls, s);
 
     // Initialize clause satisfaction state
     init_clause_state(ls);
 
-    // If already satisfied, we're done
-    if (ls->num_unsat == 0) {
-        return true;
-    }
-
-    // Main WalkSAT loop
+    // Main loop
     for (uint32_t flip = 0; flip < max_flips && ls->num_unsat > 0; flip++) {
         // Pick a random unsatisfied clause
-        uint32_t c = pick_unsat_clause(ls);
+        uint32_t c = ls->unsat[ls_random_below(ls, ls->num_unsat)];
 
         // Pick variable to flip
-        Var v = pick_var_to_flip(ls, c, noise);
+        Var v = ls->probsat ? pick_probsat(ls, c) : pick_walksat(ls, c, noise);
+        if (v == 0) break;  // Falsified by level-0 facts (not yet propagated)
 
-        // Flip the variable
+        // Flip the variable and update clause state
         flip_var(ls, v);
 
-        // Update clause state
-        update_after_flip(ls, v);
-
         ls->flips++;
     }
 
+    ls->time += now_seconds() - start;
     return ls->num_unsat == 0;
 }
 
 void local_search_copy_solution(Solver* s, LocalSearchState* ls) {
-    // Copy solution to solver's variable values
+    // Copy solution to solver's variable values. Level-0 facts stay as they
+    // are, and nothing goes on the trail: the solver saves the values as its
+    // model and clears them again, so it can keep solving incrementally.
     for (Var v = 1; v <= ls->num_vars; v++) {
-        s->vars[v].value = ls->assignment[v] ? TRUE : FALSE;
         s->vars[v].polarity = ls->assignment[v];
-        s->vars[v].level = 0;
-        s->vars[v].reason = INVALID_CLAUSE;
-    }
-
-    // Update trail to reflect full assignment
-    s->trail_size = 0;
-    for (Var v = 1; v <= ls->num_vars; v++) {
-        Lit lit = mkLit(v, !ls->assignment[v]);
-        s->trail[s->trail_size].lit = lit;
-        s->trail[s->trail_size].level = 0;
-        s->trail_size++;
+        if (var_value(s, v) != UNDEF) continue;
+        assign_lit(s, mkLit(v, !ls->assignment[v]));
+        s->levels[v] = INVALID_LEVEL;
+        s->reasons[v] = INVALID_CLAUSE;
     }
-    s->decision_level = 0;
 }
@@ -4,6 +4,10 @@
 
 #include "../include/solver.h"
 #include "../include/dimacs.h"
+#include "../include/portfolio.h"
+#include "../include/cube.h"
+#include "../include/batch.h"
+#include "../include/checkpoint.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -31,11 +35,40 @@ static void print_usage(const char* program) {
     printf("      --debug               Debug output (same as DEBUG_CDCL=1)\n");
     printf("  -q, --quiet               Suppress all output except result\n");
     printf("  -s, --stats               Print statistics (default)\n");
+    printf("      --stats-json <file>   Also write the statistics as JSON to file\n");
+    printf("      --report-interval <n> Print a progress line every n conflicts (default: 0 = off)\n");
+    printf("      --model-binary <file> Also write a SAT model as a bit-packed binary file\n");
     printf("\n");
     printf("Resource limits:\n");
     printf("  -c, --conflicts <n>       Maximum number of conflicts\n");
     printf("  -d, --decisions <n>       Maximum number of decisions\n");
     printf("  -t, --time <sec>          Time limit in seconds\n");
+    printf("      --ticks <n>           Maximum effort in ticks (reproducible across machines)\n");
+    printf("\n");
+    printf("Checkpointing (single solver):\n");
+    printf("  --checkpoint <file>       Save the search state to file at restarts, and when a\n");
+    printf("                            limit stops the search\n");
+    printf("  --checkpoint-interval <s> Seconds between checkpoints (default: 600)\n");
+    printf("  --resume                  Continue from the --checkpoint file if it exists (the\n");
+    printf("                            input is then not read, preprocessing is skipped)\n");
+    printf("\n");
+    printf("Parallel solving:\n");
+    printf("  --threads <n>             Portfolio mode with n solver threads (default: 1)\n");
+    printf("  --pin-threads             Pin each portfolio worker to its own CPU, keeping its\n");
+    printf("                            clause database on the CPU's NUMA node (Linux)\n");
+    printf("  --seed <n>                Random seed (default: 0)\n");
+    printf("\n");
+    printf("Cube-and-conquer:\n");
+    printf("  --gen-cubes <file>        Write lookahead cubes to file and exit\n");
+    printf("  --cube-depth <n>          Split depth for --gen-cubes (default: %d)\n", CUBE_DEFAULT_DEPTH);
+    printf("  --cubes <file>            Solve each cube of file (uses --threads workers)\n");
+    printf("  --cube-results <file>     Append per-cube results; resume from them on restart\n");
+    printf("  --cube-node <k>/<n>       Only solve cubes with index %% n == k (multi-machine)\n");
+    printf("\n");
+    printf("Batch solving:\n");
+    printf("  --batch <file>            Solve the instances listed in file (- = stdin), one\n");
+    printf("                            JSON line each (uses --threads workers)\n");
+    printf("  --batch-models            Include models in the JSON lines\n");
     printf("\n");
     printf("VSIDS parameters:\n");
     printf("  --var-decay <f>           Variable activity decay (default: 0.95)\n");
@@ -48,6 +81,16 @@ static void print_usage(const char* program) {
     printf("  --glucose-restart-ema     Use Glucose with EMA (conservative, original paper)\n");
     printf("  --glucose-restart-avg     Use Glucose with sliding window (Python-style, aggressive)\n");
     printf("  --no-restarts             Disable restarts\n");
+    printf("  --no-restart-reuse        Always restart to level 0 (default: keep reusable trail)\n");
+    printf("\n");
+    printf("Search modes:\n");
+    printf("  --modes                   Alternate focused (VMTF, Glucose restarts) and stable\n");
+    printf("                            (VSIDS, Luby restarts, target phases) search\n");
+    printf("  --mode-interval <n>       Conflicts of the first focused phase (default: 1000)\n");
+    printf("\n");
+    printf("Backtracking:\n");
+    printf("  --chrono-threshold <n>    Jumps over more levels backtrack one level (default: 100, 0 = always)\n");
+    printf("  --no-chrono               Always backjump to the assertion level\n");
     printf("\n");
     printf("Glucose EMA tuning (only with --glucose-restart or --glucose-restart-ema):\n");
     printf("  --glucose-fast-alpha <f>  Fast MA decay factor (default: 0.8)\n");
@@ -60,6 +103,7 @@ static void print_usage(const char* program) {
     printf("\n");
     printf("Branching heuristic:\n");
     printf("  --lrb                     Use LRB/CHB instead of VSIDS\n");
+    printf("  --vmtf                    Use the VMTF queue (move-to-front) instead of VSIDS\n");
     printf("  --vsids                   Use VSIDS (default)\n");
     printf("\n");
     printf("Phase saving:\n");
@@ -72,28 +116,45 @@ static void print_usage(const char* program) {
     printf("Clause management:\n");
     printf("  --max-lbd <n>             Max LBD for keeping clauses (default: 30)\n");
     printf("  --glue-lbd <n>            LBD threshold for glue clauses (default: 2)\n");
-    printf("  --reduce-fraction <f>     Fraction of clauses to keep (default: 0.5)\n");
+    printf("  --tier2-lbd <n>           LBD limit for clauses kept while used (default: 6)\n");
+    printf("  --reduce-fraction <f>     Fraction of unused clauses to keep (default: 0.5)\n");
     printf("  --reduce-interval <n>     Conflicts between reductions (default: 2000)\n");
     printf("  --no-minimize             Disable clause minimization\n");
-    printf("  --no-subsumption          Disable on-the-fly subsumption\n");
+    printf("  --no-shrink               Disable shrinking of learned clauses\n");
+    printf("  --no-subsumption          Disable subsumption (on-the-fly and occurrence-list rounds)\n");
     printf("\n");
     printf("Preprocessing:\n");
-    printf("  --no-bce                  Disable blocked clause elimination\n");
-    printf("  --elim                    [EXPERIMENTAL] Enable bounded variable elimination (BVE)\n");
+    printf("  --bce                     Enable blocked clause elimination (BCE)\n");
+    printf("  --no-bce                  Disable BCE (default)\n");
+    printf("  --elim                    Enable bounded variable elimination (BVE)\n");
     printf("  --no-elim                 Disable BVE (default)\n");
     printf("  --elim-max-occ <n>        Max occurrences for BVE (default: 10)\n");
     printf("  --elim-grow <n>           Max clause growth for BVE (default: 0)\n");
+    printf("  --elim-threads <n>        BVE resolution threads, 0 = one per CPU (default: 0)\n");
     printf("  --no-probing              Disable failed literal probing\n");
+    printf("  --gauss                   Gauss-Jordan elimination on XORs found in the clauses\n");
+    printf("  --no-gauss                Disable Gauss-Jordan elimination (default)\n");
     printf("\n");
     printf("Inprocessing:\n");
-    printf("  --inprocess               Enable inprocessing (vivification, etc.)\n");
-    printf("  --inprocess-interval <n>  Conflicts between inprocessing (default: 10000)\n");
+    printf("  --inprocess               Enable inprocessing (probing, subsumption, vivification,\n");
+    printf("                            and BCE/BVE when enabled)\n");
+    printf("  --inprocess-interval <n>  Conflicts before the first round; later intervals are\n");
+    printf("                            the ticks they took (default: 10000)\n");
+    printf("  --inprocess-probe <n>     Probing budget, per mille of search propagations (default: 50)\n");
+    printf("  --inprocess-subsume <n>   Subsumption budget, per mille (default: 200)\n");
+    printf("  --inprocess-vivify <n>    Vivification budget, per mille (default: 100)\n");
+    printf("  --inprocess-bce <n>       BCE budget, per mille (default: 50)\n");
+    printf("  --inprocess-elim <n>      BVE budget, per mille (default: 50)\n");
+    printf("  --subsume-effort <n>      Literal visits per subsumption round (default: 10000000)\n");
     printf("\n");
     printf("Local search hybridization:\n");
     printf("  --local-search            Enable WalkSAT-style local search\n");
-    printf("  --ls-interval <n>         Conflicts between local search calls (default: 5000)\n");
+    printf("  --ls-interval <n>         Conflicts before the first local search call; later\n");
+    printf("                            calls are the ticks they took apart (default: 5000)\n");
     printf("  --ls-max-flips <n>        Max flips per local search call (default: 100000)\n");
     printf("  --ls-noise <f>            WalkSAT noise parameter 0.0-1.0 (default: 0.5)\n");
+    printf("  --ls-probsat              Use ProbSAT instead of WalkSAT variable selection\n");
+    printf("  --ls-cb <f>               ProbSAT break exponent (default: 2.3)\n");
     printf("\n");
     printf("Proof logging:\n");
     printf("  --proof <file>            Write DRAT proof to file\n");
@@ -116,9 +177,26 @@ static struct option long_options[] = {
     {"debug",           no_argument,       0, 0},
     {"quiet",           no_argument,       0, 'q'},
     {"stats",           no_argument,       0, 's'},
+    {"stats-json",      required_argument, 0, 0},
+    {"model-binary",    required_argument, 0, 0},
+    {"report-interval", required_argument, 0, 0},
     {"conflicts",       required_argument, 0, 'c'},
     {"decisions",       required_argument, 0, 'd'},
     {"time",            required_argument, 0, 't'},
+    {"ticks",           required_argument, 0, 0},
+    {"checkpoint",      required_argument, 0, 0},
+    {"checkpoint-interval", required_argument, 0, 0},
+    {"resume",          no_argument,       0, 0},
+    {"threads",         required_argument, 0, 0},
+    {"pin-threads",     no_argument,       0, 0},
+    {"seed",            required_argument, 0, 0},
+    {"gen-cubes",       required_argument, 0, 0},
+    {"cube-depth",      required_argument, 0, 0},
+    {"cubes",           required_argument, 0, 0},
+    {"cube-results",    required_argument, 0, 0},
+    {"cube-node",       required_argument, 0, 0},
+    {"batch",           required_argument, 0, 0},
+    {"batch-models",    no_argument,       0, 0},
     {"var-decay",       required_argument, 0, 0},
     {"var-inc",         required_argument, 0, 0},
     {"restart-first",   required_argument, 0, 0},
@@ -130,12 +208,20 @@ static struct option long_options[] = {
     {"no-luby-restart", no_argument,       0, 0},
     {"luby-unit",       required_argument, 0, 0},
     {"no-restarts",     no_argument,       0, 0},
+    {"restart-reuse",   no_argument,       0, 0},
+    {"no-restart-reuse", no_argument,      0, 0},
+    {"modes",           no_argument,       0, 0},
+    {"no-modes",        no_argument,       0, 0},
+    {"mode-interval",   required_argument, 0, 0},
+    {"chrono-threshold", required_argument, 0, 0},
+    {"no-chrono",       no_argument,       0, 0},
     {"glucose-fast-alpha", required_argument, 0, 0},
     {"glucose-slow-alpha", required_argument, 0, 0},
     {"glucose-min-conflicts", required_argument, 0, 0},
     {"glucose-window-size", required_argument, 0, 0},
     {"glucose-k",       required_argument, 0, 0},
     {"lrb",             no_argument,       0, 0},
+    {"vmtf",            no_argument,       0, 0},
     {"vsids",           no_argument,       0, 0},
     {"no-phase-saving", no_argument,       0, 0},
     {"random-phase",    no_argument,       0, 0},
@@ -145,22 +231,36 @@ static struct option long_options[] = {
     {"rephase-interval", required_argument, 0, 0},
     {"max-lbd",         required_argument, 0, 0},
     {"glue-lbd",        required_argument, 0, 0},
+    {"tier2-lbd",       required_argument, 0, 0},
     {"reduce-fraction", required_argument, 0, 0},
     {"reduce-interval", required_argument, 0, 0},
     {"no-minimize",     no_argument,       0, 0},
+    {"no-shrink",       no_argument,       0, 0},
     {"no-subsumption",  no_argument,       0, 0},
+    {"bce",             no_argument,       0, 0},
     {"no-bce",          no_argument,       0, 0},
     {"elim",            no_argument,       0, 0},
     {"no-elim",         no_argument,       0, 0},
     {"elim-max-occ",    required_argument, 0, 0},
     {"elim-grow",       required_argument, 0, 0},
+    {"elim-threads",    required_argument, 0, 0},
     {"no-probing",      no_argument,       0, 0},
+    {"gauss",           no_argument,       0, 0},
+    {"no-gauss",        no_argument,       0, 0},
     {"inprocess",       no_argument,       0, 0},
     {"inprocess-interval", required_argument, 0, 0},
+    {"inprocess-probe",   required_argument, 0, 0},
+    {"inprocess-subsume", required_argument, 0, 0},
+    {"inprocess-vivify",  required_argument, 0, 0},
+    {"inprocess-bce",     required_argument, 0, 0},
+    {"inprocess-elim",    required_argument, 0, 0},
+    {"subsume-effort",  required_argument, 0, 0},
     {"local-search",    no_argument,       0, 0},
     {"ls-interval",     required_argument, 0, 0},
     {"ls-max-flips",    required_argument, 0, 0},
     {"ls-noise",        required_argument, 0, 0},
+    {"ls-probsat",      no_argument,       0, 0},
+    {"ls-cb",           required_argument, 0, 0},
     {"proof",           required_argument, 0, 0},
     {"binary-proof",    no_argument,       0, 0},
     {0, 0, 0, 0}
@@ -173,6 +273,16 @@ static struct option long_options[] = {
 int main(int argc, char** argv) {
     // Default options
     SolverOpts opts = default_opts();
+    uint32_t num_threads = 1;
+    const char* gen_cubes_path = NULL;
+    uint32_t cube_depth = CUBE_DEFAULT_DEPTH;
+    const char* cubes_path = NULL;
+    CubeSolveOpts cube_opts = { NULL, 1, 0, 1 };
+    const char* stats_json_path = NULL;
+    const char* model_binary_path = NULL;
+    const char* batch_path = NULL;
+    BatchOpts batch_opts = { 1, false };
+    bool resume = false;
 
     // Parse command line options
     int c;
@@ -215,6 +325,38 @@ int main(int argc, char** argv) {
                 // Long option
                 if (strcmp(long_options[option_index].name, "debug") == 0) {
                     opts.debug = true;
+                } else if (strcmp(long_options[option_index].name, "ticks") == 0) {
+                    opts.max_ticks = strtoull(optarg, NULL, 10);
+                } else if (strcmp(long_options[option_index].name, "checkpoint") == 0) {
+                    opts.checkpoint_path = optarg;
+                } else if (strcmp(long_options[option_index].name, "checkpoint-interval") == 0) {
+                    opts.checkpoint_interval = atof(optarg);
+                } else if (strcmp(long_options[option_index].name, "resume") == 0) {
+                    resume = true;
+                } else if (strcmp(long_options[option_index].name, "threads") == 0) {
+                    num_threads = (uint32_t)atol(optarg);
+                } else if (strcmp(long_options[option_index].name, "pin-threads") == 0) {
+                    opts.pin_threads = true;
+                } else if (strcmp(long_options[option_index].name, "seed") == 0) {
+                    opts.seed = (uint32_t)atol(optarg);
+                } else if (strcmp(long_options[option_index].name, "gen-cubes") == 0) {
+                    gen_cubes_path = optarg;
+                } else if (strcmp(long_options[option_index].name, "cube-depth") == 0) {
+                    cube_depth = (uint32_t)atol(optarg);
+                } else if (strcmp(long_options[option_index].name, "cubes") == 0) {
+                    cubes_path = optarg;
+                } else if (strcmp(long_options[option_index].name, "cube-results") == 0) {
+                    cube_opts.results_file = optarg;
+                } else if (strcmp(long_options[option_index].name, "batch") == 0) {
+                    batch_path = optarg;
+                } else if (strcmp(long_options[option_index].name, "batch-models") == 0) {
+                    batch_opts.models = true;
+                } else if (strcmp(long_options[option_index].name, "cube-node") == 0) {
+                    if (sscanf(optarg, "%u/%u", &cube_opts.node, &cube_opts.num_nodes) != 2 ||
+                        cube_opts.num_nodes == 0 || cube_opts.node >= cube_opts.num_nodes) {
+                        fprintf(stderr, "Error: --cube-node expects k/n with k < n\n");
+                        return 1;
+                    }
                 } else if (strcmp(long_options[option_index].name, "var-decay") == 0) {
                     opts.var_decay = atof(optarg);
                 } else if (strcmp(long_options[option_index].name, "var-inc") == 0) {
@@ -235,6 +377,21 @@ int main(int argc, char** argv) {
                     opts.luby_unit = (uint32_t)atol(optarg);
                 } else if (strcmp(long_options[option_index].name, "no-restarts") == 0) {
                     opts.restart_first = UINT32_MAX;
+                } else if (strcmp(long_options[option_index].name, "restart-reuse") == 0) {
+                    opts.restart_reuse = true;
+                } else if (strcmp(long_options[option_index].name, "no-restart-reuse") == 0) {
+                    opts.restart_reuse = false;
+                } else if (strcmp(long_options[option_index].name, "modes") == 0) {
+                    opts.modes = true;
+                } else if (strcmp(long_options[option_index].name, "no-modes") == 0) {
+                    opts.modes = false;
+                } else if (strcmp(long_options[option_index].name, "mode-interval") == 0) {
+                    opts.mode_interval = (uint32_t)atol(optarg);
+                } else if (strcmp(long_options[option_index].name, "chrono-threshold") == 0) {
+                    opts.chrono = true;
+                    opts.chrono_threshold = (uint32_t)atol(optarg);
+                } else if (strcmp(long_options[option_index].name, "no-chrono") == 0) {
+                    opts.chrono = false;
                 } else if (strcmp(long_options[option_index].name, "glucose-fast-alpha") == 0) {
                     opts.glucose_fast_alpha = atof(optarg);
                 } else if (strcmp(long_options[option_index].name, "glucose-slow-alpha") == 0) {
@@ -255,8 +412,13 @@ int main(int argc, char** argv) {
                     opts.glucose_k = atof(optarg);
                 } else if (strcmp(long_options[option_index].name, "lrb") == 0) {
                     opts.lrb = true;
+                    opts.vmtf = false;
+                } else if (strcmp(long_options[option_index].name, "vmtf") == 0) {
+                    opts.vmtf = true;
+                    opts.lrb = false;
                 } else if (strcmp(long_options[option_index].name, "vsids") == 0) {
                     opts.lrb = false;
+                    opts.vmtf = false;
                 } else if (strcmp(long_options[option_index].name, "no-phase-saving") == 0) {
                     opts.phase_saving = false;
                 } else if (strcmp(long_options[option_index].name, "random-phase") == 0) {
@@ -273,14 +435,20 @@ int main(int argc, char** argv) {
                     opts.max_lbd = (uint32_t)atol(optarg);
                 } else if (strcmp(long_options[option_index].name, "glue-lbd") == 0) {
                     opts.glue_lbd = (uint32_t)atol(optarg);
+                } else if (strcmp(long_options[option_index].name, "tier2-lbd") == 0) {
+                    opts.tier2_lbd = (uint32_t)atol(optarg);
                 } else if (strcmp(long_options[option_index].name, "reduce-fraction") == 0) {
                     opts.reduce_fraction = atof(optarg);
                 } else if (strcmp(long_options[option_index].name, "reduce-interval") == 0) {
                     opts.reduce_interval = (uint32_t)atol(optarg);
                 } else if (strcmp(long_options[option_index].name, "no-minimize") == 0) {
                     opts.minimize = false;
+                } else if (strcmp(long_options[option_index].name, "no-shrink") == 0) {
+                    opts.shrink = false;
                 } else if (strcmp(long_options[option_index].name, "no-subsumption") == 0) {
                     opts.subsumption = false;
+                } else if (strcmp(long_options[option_index].name, "bce") == 0) {
+                    opts.bce = true;
                 } else if (strcmp(long_options[option_index].name, "no-bce") == 0) {
                     opts.bce = false;
                 } else if (strcmp(long_options[option_index].name, "elim") == 0) {
@@ -291,12 +459,30 @@ int main(int argc, char** argv) {
                     opts.elim_max_occ = (uint32_t)atol(optarg);
                 } else if (strcmp(long_options[option_index].name, "elim-grow") == 0) {
                     opts.elim_grow = (uint32_t)atol(optarg);
+                } else if (strcmp(long_options[option_index].name, "elim-threads") == 0) {
+                    opts.elim_threads = (uint32_t)atol(optarg);
                 } else if (strcmp(long_options[option_index].name, "no-probing") == 0) {
                     opts.probing = false;
+                } else if (strcmp(long_options[option_index].name, "gauss") == 0) {
+                    opts.gauss = true;
+                } else if (strcmp(long_options[option_index].name, "no-gauss") == 0) {
+                    opts.gauss = false;
                 } else if (strcmp(long_options[option_index].name, "inprocess") == 0) {
                     opts.inprocess = true;
                 } else if (strcmp(long_options[option_index].name, "inprocess-interval") == 0) {
                     opts.inprocess_interval = (uint32_t)atol(optarg);
+                } else if (strcmp(long_options[option_index].name, "inprocess-probe") == 0) {
+                    opts.inprocess_probe = (uint32_t)atol(optarg);
+                } else if (strcmp(long_options[option_index].name, "inprocess-subsume") == 0) {
+                    opts.inprocess_subsume = (uint32_t)atol(optarg);
+                } else if (strcmp(long_options[option_index].name, "inprocess-vivify") == 0) {
+                    opts.inprocess_vivify = (uint32_t)atol(optarg);
+                } else if (strcmp(long_options[option_index].name, "inprocess-bce") == 0) {
+                    opts.inprocess_bce = (uint32_t)atol(optarg);
+                } else if (strcmp(long_options[option_index].name, "inprocess-elim") == 0) {
+                    opts.inprocess_elim = (uint32_t)atol(optarg);
+                } else if (strcmp(long_options[option_index].name, "subsume-effort") == 0) {
+                    opts.subsume_effort = (uint32_t)atol(optarg);
                 } else if (strcmp(long_options[option_index].name, "local-search") == 0) {
                     opts.local_search = true;
                 } else if (strcmp(long_options[option_index].name, "ls-interval") == 0) {
@@ -305,10 +491,20 @@ int main(int argc, char** argv) {
                     opts.ls_max_flips = (uint32_t)atol(optarg);
                 } else if (strcmp(long_options[option_index].name, "ls-noise") == 0) {
                     opts.ls_noise = atof(optarg);
+                } else if (strcmp(long_options[option_index].name, "ls-probsat") == 0) {
+                    opts.ls_probsat = true;
+                } else if (strcmp(long_options[option_index].name, "ls-cb") == 0) {
+                    opts.ls_cb = atof(optarg);
                 } else if (strcmp(long_options[option_index].name, "proof") == 0) {
                     opts.proof_path = optarg;
                 } else if (strcmp(long_options[option_index].name, "binary-proof") == 0) {
                     opts.binary_proof = true;
+                } else if (strcmp(long_options[option_index].name, "stats-json") == 0) {
+                    stats_json_path = optarg;
+                } else if (strcmp(long_options[option_index].name, "model-binary") == 0) {
+                    model_binary_path = optarg;
+                } else if (strcmp(long_options[option_index].name, "report-interval") == 0) {
+                    opts.report_interval = (uint32_t)atol(optarg);
                 }
                 break;
 
@@ -318,6 +514,51 @@ int main(int argc, char** argv) {
         }
     }
 
+    // A checkpoint holds one solver: workers of the other modes would
+    // overwrite each other's
+    if (resume && !opts.checkpoint_path) {
+        fprintf(stderr, "Error: --resume needs --checkpoint <file>\n");
+        return 1;
+    }
+    if (opts.checkpoint_path && (batch_path || gen_cubes_path || cubes_path || num_threads > 1)) {
+        fprintf(stderr, "c Warning: --checkpoint only applies to a single solver, ignoring it\n");
+        opts.checkpoint_path = NULL;
+        resume = false;
+    }
+
+    // Batch mode: the instances come from the list, results are JSON lines
+    if (batch_path) {
+        FILE* in = strcmp(batch_path, "-") == 0 ? stdin : fopen(batch_path, "r");
+        if (!in) {
+            fprintf(stderr, "Error: Cannot open batch list %s\n", batch_path);
+            return 1;
+        }
+        g_verbose = opts.verbose;
+        g_debug = opts.debug;
+        batch_opts.threads = num_threads;
+
+        BatchStats batch_stats;
+        bool ok = batch_solve(&opts, in, stdout, &batch_opts, &batch_stats);
+        if (in != stdin) fclose(in);
+        if (!ok) {
+            fprintf(stderr, "Error: Failed to start batch workers\n");
+            return 1;
+        }
+
+        // Summary on stderr: stdout carries only JSON lines
+        if (!opts.quiet) {
+            fprintf(stderr, "c [Batch] %llu instances (%llu SAT, %llu UNSAT, %llu unknown, "
+                    "%llu errors) in %.2fs with %u threads\n",
+                    (unsigned long long)batch_stats.instances,
+                    (unsigned long long)batch_stats.sat,
+                    (unsigned long long)batch_stats.unsat,
+                    (unsigned long long)batch_stats.unknown,
+                    (unsigned long long)batch_stats.errors,
+                    batch_stats.time, num_threads ? num_threads : 1);
+        }
+        return 0;
+    }
+
     // Check for input file
     if (optind >= argc) {
         fprintf(stderr, "Error: No input file specified\n");
@@ -338,57 +579,151 @@ int main(int argc, char** argv) {
         printf("c Reading from %s\n", input_file);
     }
 
-    // Create solver
-    Solver* solver = solver_new_with_opts(&opts);
-    if (!solver) {
-        fprintf(stderr, "Error: Failed to create solver\n");
-        return 1;
+    // Portfolio mode: proofs cannot be combined across workers
+    if (num_threads < 1) num_threads = 1;
+    if (num_threads > 1 && opts.proof_path) {
+        fprintf(stderr, "c Warning: --threads is not supported with --proof, using 1 thread\n");
+        num_threads = 1;
     }
-
-    // Parse input file
-    DimacsError err = dimacs_parse_file(solver, input_file);
-    if (err != DIMACS_OK) {
-        fprintf(stderr, "Error parsing DIMACS file: %s\n", dimacs_error_string(err));
-        solver_free(solver);
-        return 1;
-    }
-
-    if (!opts.quiet) {
-        printf("c Variables: %u\n", solver->num_vars);
-        printf("c Clauses:   %u\n", solver->num_clauses);
-        printf("c\n");
+    if (resume && opts.proof_path) {
+        fprintf(stderr, "c Warning: --resume is not supported with --proof, starting over\n");
+        resume = false;
     }
 
-    // Solve
+    Solver* solver = NULL;
+    lbool result;
     double start_time = (double)clock() / CLOCKS_PER_SEC;
-    lbool result = solver_solve(solver);
+
+    if (gen_cubes_path) {
+        // Cube phase: split the formula and write the cubes
+        solver = solver_new_with_opts(&opts);
+        if (!solver) {
+            fprintf(stderr, "Error: Failed to create solver\n");
+            return 1;
+        }
+        DimacsError err = dimacs_parse_file(solver, input_file);
+        if (err != DIMACS_OK) {
+            fprintf(stderr, "Error parsing DIMACS file: %s\n", dimacs_error_string(err));
+            solver_free(solver);
+            return 1;
+        }
+        FILE* out = fopen(gen_cubes_path, "w");
+        if (!out) {
+            fprintf(stderr, "Error: Cannot open cube file %s\n", gen_cubes_path);
+            solver_free(solver);
+            return 1;
+        }
+
+        CubeGenStats cube_stats;
+        result = cube_generate(solver, cube_depth, out, &cube_stats);
+        fclose(out);
+
+        if (!opts.quiet) {
+            printf("c [Cube] Wrote %llu cubes to %s (depth %u, %llu refuted branches, "
+                   "%llu failed literals, %llu probes, %.2fs)\n",
+                   (unsigned long long)cube_stats.cubes, gen_cubes_path, cube_depth,
+                   (unsigned long long)cube_stats.refuted,
+                   (unsigned long long)cube_stats.failed_literals,
+                   (unsigned long long)cube_stats.probes, cube_stats.time);
+        }
+    } else if (cubes_path) {
+        // Conquer phase: solve every cube under assumptions
+        CubeSet cubes;
+        if (!cube_read_file(cubes_path, &cubes)) {
+            fprintf(stderr, "Error: Cannot read cube file %s\n", cubes_path);
+            return 1;
+        }
+        cube_opts.threads = num_threads;
+
+        DimacsError err;
+        result = cube_solve(&opts, input_file, &cubes, &cube_opts, &solver, &err);
+        cube_set_free(&cubes);
+        if (err != DIMACS_OK) {
+            fprintf(stderr, "Error parsing DIMACS file: %s\n", dimacs_error_string(err));
+            solver_free(solver);
+            return 1;
+        }
+        if (!solver) {
+            fprintf(stderr, "Error: Failed to create solver\n");
+            return 1;
+        }
+    } else if (num_threads > 1) {
+        // Each worker parses the file and solves; the winner is returned
+        DimacsError err;
+        result = portfolio_solve(&opts, input_file, num_threads, &solver, &err);
+        if (err != DIMACS_OK) {
+            fprintf(stderr, "Error parsing DIMACS file: %s\n", dimacs_error_string(err));
+            solver_free(solver);
+            return 1;
+        }
+        if (!solver) {
+            fprintf(stderr, "Error: Failed to create solver\n");
+            return 1;
+        }
+
+        if (!opts.quiet) {
+            printf("c Variables: %u\n", solver->num_vars);
+            printf("c Clauses:   %u\n", solver->num_clauses);
+            printf("c\n");
+        }
+    } else {
+        // Checkpoints are tied to the input they were started on
+        CheckpointInput input = {0, 0};
+        if (opts.checkpoint_path && !checkpoint_input(input_file, &input)) {
+            fprintf(stderr, "c Warning: --checkpoint needs a regular input file, ignoring it\n");
+            opts.checkpoint_path = NULL;
+            resume = false;
+        }
+
+        // Create solver
+        solver = solver_new_with_opts(&opts);
+        if (!solver) {
+            fprintf(stderr, "Error: Failed to create solver\n");
+            return 1;
+        }
+        solver->checkpoint.input_size = input.size;
+        solver->checkpoint.input_hash = input.hash;
+
+        // Continue from the checkpoint if there is one, else parse the input
+        if (resume && access(opts.checkpoint_path, F_OK) == 0) {
+            const char* error;
+            if (!checkpoint_load(solver, opts.checkpoint_path, &input, &error)) {
+                fprintf(stderr, "Error: Cannot resume from %s: %s\n", opts.checkpoint_path, error);
+                solver_free(solver);
+                return 1;
+            }
+            if (!opts.quiet) {
+                printf("c Resumed from %s at %llu conflicts\n", opts.checkpoint_path,
+                       (unsigned long long)solver->stats.conflicts);
+            }
+        } else {
+            DimacsError err = dimacs_parse_file(solver, input_file);
+            if (err != DIMACS_OK) {
+                fprintf(stderr, "Error parsing DIMACS file: %s\n", dimacs_error_string(err));
+                solver_free(solver);
+                return 1;
+            }
+        }
+
+        if (!opts.quiet) {
+            printf("c Variables: %u\n", solver->num_vars);
+            printf("c Clauses:   %u\n", solver->num_clauses);
+            printf("c\n");
+        }
+
+        // Solve
+        start_time = (double)clock() / CLOCKS_PER_SEC;
+        result = solver_solve(solver);
+    }
     double solve_time = (double)clock() / CLOCKS_PER_SEC - start_time;
 
     // Print result
     if (result == TRUE) {
         printf("s SATISFIABLE\n");
-
-        // Print model
-        printf("v ");
-        int vars_per_line = 0;
-        for (Var v = 1; v <= solver->num_vars; v++) {
-            lbool val = solver_model_value(solver, v);
-            if (val == TRUE) {
-                printf("%u ", v);
-            } else if (val == FALSE) {
-                printf("-%u ", v);
-            } else {
-                // Variable doesn't appear in formula - set to false
-                printf("-%u ", v);
-            }
-
-            vars_per_line++;
-            if (vars_per_line >= 20) {
-                printf("\nv ");
-                vars_per_line = 0;
-            }
+        dimacs_write_model(solver, stdout);
+        if (model_binary_path && !dimacs_write_model_binary(solver, model_binary_path)) {
+            fprintf(stderr, "c Warning: Cannot write binary model to %s\n", model_binary_path);
         }
-        printf("0\n");
     } else if (result == FALSE) {
         printf("s UNSATISFIABLE\n");
     } else {
@@ -401,6 +736,15 @@ int main(int argc, char** argv) {
         printf("c CPU time:         %.3f s\n", solve_time);
         solver_print_stats(solver);
     }
+    if (stats_json_path) {
+        FILE* out = fopen(stats_json_path, "w");
+        if (out) {
+            solver_write_stats_json(solver, out);
+            fclose(out);
+        } else {
+            fprintf(stderr, "c Warning: Cannot write statistics to %s\n", stats_json_path);
+        }
+    }
 
     // Clean up
     solver_free(solver);
@@ -0,0 +1,398 @@
+/*********************************************************************
+ * BSAT Competition Solver - Portfolio Parallel Solving Implementation
+ *********************************************************************/
+
+#define _GNU_SOURCE  // nanosleep, clock_gettime, sched_setaffinity
+
+#include "../include/portfolio.h"
+#include "../include/timer.h"
+#include <pthread.h>
+#ifdef __linux__
+#include <sched.h>
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*********************************************************************
+ * Worker Configurations
+ *
+ * Worker 0 always runs the user's configuration. The remaining workers
+ * cycle through this table; each also gets its own seed, so workers
+ * beyond the table size still diverge through random phases.
+ *********************************************************************/
+
+typedef struct WorkerConfig {
+    const char* name;
+    bool        lrb;          // LRB instead of VSIDS
+    bool        luby;         // Luby restarts instead of Glucose EMA
+    double      var_decay;    // VSIDS/LRB activity decay
+    bool        rephase;      // Target phase rephasing
+} WorkerConfig;
+
+static const WorkerConfig worker_configs[] = {
+    {"lrb+glucose",              true,  false, 0.95, true},
+    {"vsids+luby",               false, true,  0.95, true},
+    {"lrb+luby",                 true,  true,  0.95, true},
+    {"vsids+glucose decay=0.90", false, false, 0.90, true},
+    {"vsids+luby decay=0.99",    false, true,  0.99, true},
+    {"lrb+glucose decay=0.85",   true,  false, 0.85, true},
+    {"vsids+glucose no-rephase", false, false, 0.95, false},
+};
+
+SolverOpts portfolio_worker_opts(const SolverOpts* base, uint32_t id) {
+    SolverOpts opts = *base;
+    opts.seed = base->seed + id;
+
+    // The driver enforces the time limit in wall-clock time: clock()
+    // measures CPU time of the whole process, i.e. of all workers together
+    opts.max_time = 0.0;
+
+    // Workers already occupy the cores
+    opts.elim_threads = 1;
+
+    if (id == 0) return opts;
+
+    const WorkerConfig* cfg = &worker_configs[(id - 1) % ARRAY_SIZE(worker_configs)];
+    opts.lrb = cfg->lrb;
+    opts.var_decay = cfg->var_decay;
+    opts.rephase = cfg->rephase;
+    if (cfg->luby) {
+        opts.luby_restart = true;
+        opts.glucose_restart = false;
+    } else {
+        opts.luby_restart = false;
+        opts.glucose_restart = true;
+        opts.glucose_use_ema = true;
+    }
+
+    // Only worker 0 reports progress; the others would just repeat it
+    opts.quiet = true;
+    opts.verbose = false;
+
+    return opts;
+}
+
+const char* portfolio_worker_name(uint32_t id) {
+    if (id == 0) return "base";
+    return worker_configs[(id - 1) % ARRAY_SIZE(worker_configs)].name;
+}
+
+/*********************************************************************
+ * Clause Exchange
+ *********************************************************************/
+
+static uint32_t round_up_pow2(uint32_t n) {
+    uint32_t p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+ClauseExchange* exchange_new(uint32_t num_rings, uint32_t num_slots, uint32_t max_lbd) {
+    ClauseExchange* ex = (ClauseExchange*)calloc(1, sizeof(ClauseExchange));
+    if (!ex) return NULL;
+
+    ex->num_rings = num_rings;
+    ex->num_slots = round_up_pow2(num_slots ? num_slots : SHARE_RING_SLOTS);
+    ex->max_lbd = max_lbd;
+    atomic_init(&ex->stop, false);
+    atomic_init(&ex->winner, -1);
+
+    // Rings are cache-line aligned so producers never share a head line
+    ex->rings = (ShareRing*)aligned_alloc(CACHE_LINE_SIZE, num_rings * sizeof(ShareRing));
+    if (!ex->rings) {
+        free(ex);
+        return NULL;
+    }
+
+    for (uint32_t r = 0; r < num_rings; r++) {
+        ShareRing* ring = &ex->rings[r];
+        atomic_init(&ring->head, 0);
+        ring->slots = (ShareSlot*)aligned_alloc(CACHE_LINE_SIZE, ex->num_slots * sizeof(ShareSlot));
+        if (!ring->slots) {
+            ex->num_rings = r;
+            exchange_free(ex);
+            return NULL;
+        }
+        for (uint32_t i = 0; i < ex->num_slots; i++) {
+            atomic_init(&ring->slots[i].stamp, 0);
+            atomic_init(&ring->slots[i].size, 0);
+            atomic_init(&ring->slots[i].lbd, 0);
+        }
+    }
+
+    return ex;
+}
+
+void exchange_free(ClauseExchange* ex) {
+    if (!ex) return;
+
+    if (ex->rings) {
+        for (uint32_t r = 0; r < ex->num_rings; r++) {
+            free(ex->rings[r].slots);
+        }
+        free(ex->rings);
+    }
+
+    free(ex);
+}
+
+bool exchange_attach(ClauseExchange* ex, Solver* s, uint32_t id) {
+    if (!ex || id >= ex->num_rings) return false;
+
+    uint64_t* cursors = (uint64_t*)calloc(ex->num_rings, sizeof(uint64_t));
+    if (!cursors) return false;
+
+    free(s->share.cursors);
+    s->share.cursors = cursors;
+    s->share.exchange = ex;
+    s->share.id = id;
+    return true;
+}
+
+void exchange_export(Solver* s, const Lit* lits, uint32_t size, uint32_t lbd) {
+    ClauseExchange* ex = s->share.exchange;
+    if (!ex || size == 0 || size > SHARE_MAX_SIZE) return;
+    if (size > 1 && lbd > ex->max_lbd) return;
+
+    // Single producer: only this solver ever advances its own head
+    ShareRing* ring = &ex->rings[s->share.id];
+    uint64_t seq = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    ShareSlot* slot = &ring->slots[seq & (ex->num_slots - 1)];
+
+    // Invalidate the slot before overwriting it (readers re-check the stamp)
+    atomic_store_explicit(&slot->stamp, 0, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    atomic_store_explicit(&slot->size, size, memory_order_relaxed);
+    atomic_store_explicit(&slot->lbd, lbd, memory_order_relaxed);
+    for (uint32_t i = 0; i < size; i++) {
+        atomic_store_explicit(&slot->lits[i], lits[i], memory_order_relaxed);
+    }
+
+    atomic_store_explicit(&slot->stamp, seq + 1, memory_order_release);
+    atomic_store_explicit(&ring->head, seq + 1, memory_order_release);
+
+    s->share.exported++;
+}
+
+bool exchange_import(Solver* s) {
+    ClauseExchange* ex = s->share.exchange;
+    if (!ex) return true;
+
+    Lit lits[SHARE_MAX_SIZE];
+
+    for (uint32_t r = 0; r < ex->num_rings; r++) {
+        if (r == s->share.id) continue;
+
+        ShareRing* ring = &ex->rings[r];
+        uint64_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+        uint64_t cursor = s->share.cursors[r];
+
+        // Lapped by the producer: the oldest clauses are gone, skip ahead
+        if (head - cursor > ex->num_slots) {
+            cursor = head - ex->num_slots;
+        }
+
+        for (; cursor < head; cursor++) {
+            ShareSlot* slot = &ring->slots[cursor & (ex->num_slots - 1)];
+
+            uint64_t stamp = atomic_load_explicit(&slot->stamp, memory_order_acquire);
+            if (stamp != cursor + 1) continue;  // Being rewritten
+
+            uint32_t size = atomic_load_explicit(&slot->size, memory_order_relaxed);
+            uint32_t lbd = atomic_load_explicit(&slot->lbd, memory_order_relaxed);
+            if (size == 0 || size > SHARE_MAX_SIZE) continue;
+            for (uint32_t i = 0; i < size; i++) {
+                lits[i] = atomic_load_explicit(&slot->lits[i], memory_order_relaxed);
+            }
+
+            // Validate that the producer did not overwrite the slot meanwhile
+            atomic_thread_fence(memory_order_acquire);
+            if (atomic_load_explicit(&slot->stamp, memory_order_relaxed) != stamp) continue;
+
+            s->share.imported++;
+            if (!solver_import_clause(s, lits, size, lbd)) {
+                s->share.cursors[r] = cursor + 1;
+                return false;
+            }
+        }
+
+        s->share.cursors[r] = head;
+    }
+
+    return true;
+}
+
+/*********************************************************************
+ * Portfolio Driver
+ *********************************************************************/
+
+typedef struct PortfolioWorker {
+    pthread_t       thread;
+    uint32_t        id;
+    SolverOpts      opts;
+    const char*     filename;
+    ClauseExchange* exchange;
+    Solver*         solver;
+    DimacsError     error;
+    lbool           result;
+    atomic_bool     finished;
+} PortfolioWorker;
+
+// Pin the calling worker to the id-th CPU it may run on (wrapping
+// around when there are more workers than CPUs)
+static void portfolio_pin_worker(uint32_t id) {
+#ifdef __linux__
+    cpu_set_t allowed;
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) return;
+    int count = CPU_COUNT(&allowed);
+    if (count <= 1) return;
+
+    int target = (int)(id % (uint32_t)count);
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (!CPU_ISSET(cpu, &allowed) || target-- > 0) continue;
+        cpu_set_t one;
+        CPU_ZERO(&one);
+        CPU_SET(cpu, &one);
+        sched_setaffinity(0, sizeof(one), &one);
+        return;
+    }
+#else
+    (void)id;
+#endif
+}
+
+static void* portfolio_worker_main(void* arg) {
+    PortfolioWorker* w = (PortfolioWorker*)arg;
+
+    // The solver is built and the input parsed on the worker's own thread,
+    // so first touch places its arena, watch slab and clause lists on the
+    // NUMA node it runs on; pinning keeps the thread next to them
+    if (w->opts.pin_threads) portfolio_pin_worker(w->id);
+
+    w->result = UNDEF;
+    w->solver = solver_new_with_opts(&w->opts);
+    if (!w->solver || !exchange_attach(w->exchange, w->solver, w->id)) {
+        w->error = DIMACS_ERROR_MEMORY;
+        goto done;
+    }
+
+    // Every worker parses the input on its own thread, so parsing overlaps
+    w->error = dimacs_parse_file(w->solver, w->filename);
+    if (w->error != DIMACS_OK) goto done;
+
+    w->result = solver_solve(w->solver);
+
+    if (w->result != UNDEF) {
+        int expected = -1;
+        atomic_compare_exchange_strong(&w->exchange->winner, &expected, (int)w->id);
+    }
+
+done:
+    if (w->result != UNDEF || w->error != DIMACS_OK) {
+        atomic_store(&w->exchange->stop, true);
+    }
+    atomic_store(&w->finished, true);
+    return NULL;
+}
+
+lbool portfolio_solve(const SolverOpts* opts, const char* filename,
+                      uint32_t num_threads, Solver** winner, DimacsError* error) {
+    *winner = NULL;
+    *error = DIMACS_OK;
+
+    if (num_threads < 1) num_threads = 1;
+    if (num_threads > PORTFOLIO_MAX_THREADS) num_threads = PORTFOLIO_MAX_THREADS;
+
+    ClauseExchange* ex = exchange_new(num_threads, SHARE_RING_SLOTS, opts->glue_lbd);
+    PortfolioWorker* workers = (PortfolioWorker*)calloc(num_threads, sizeof(PortfolioWorker));
+    if (!ex || !workers) {
+        exchange_free(ex);
+        free(workers);
+        *error = DIMACS_ERROR_MEMORY;
+        return UNDEF;
+    }
+
+    // Launch workers
+    uint32_t launched = 0;
+    for (uint32_t i = 0; i < num_threads; i++) {
+        PortfolioWorker* w = &workers[i];
+        w->id = i;
+        w->opts = portfolio_worker_opts(opts, i);
+        w->filename = filename;
+        w->exchange = ex;
+        w->error = DIMACS_OK;
+        atomic_init(&w->finished, false);
+
+        if (pthread_create(&w->thread, NULL, portfolio_worker_main, w) != 0) {
+            break;  // Run with the workers we have
+        }
+        launched++;
+    }
+
+    if (launched == 0) {
+        exchange_free(ex);
+        free(workers);
+        *error = DIMACS_ERROR_MEMORY;
+        return UNDEF;
+    }
+
+    // Wait for the first answer, all workers giving up, or the deadline
+    double deadline = opts->max_time > 0 ? now_seconds() + opts->max_time : 0.0;
+    struct timespec poll = {0, PORTFOLIO_POLL_NSEC};
+    for (;;) {
+        if (atomic_load(&ex->stop)) break;
+
+        bool all_finished = true;
+        for (uint32_t i = 0; i < launched; i++) {
+            if (!atomic_load(&workers[i].finished)) {
+                all_finished = false;
+                break;
+            }
+        }
+        if (all_finished) break;
+
+        if (deadline > 0 && now_seconds() >= deadline) break;
+        nanosleep(&poll, NULL);
+    }
+
+    atomic_store(&ex->stop, true);
+    for (uint32_t i = 0; i < launched; i++) {
+        pthread_join(workers[i].thread, NULL);
+    }
+
+    // Pick the winner (or worker 0 if nobody finished)
+    int win = atomic_load(&ex->winner);
+    uint32_t win_id = (win >= 0) ? (uint32_t)win : 0;
+    lbool result = (win >= 0) ? workers[win_id].result : UNDEF;
+
+    for (uint32_t i = 0; i < launched; i++) {
+        if (workers[i].error != DIMACS_OK && *error == DIMACS_OK) {
+            *error = workers[i].error;
+        }
+    }
+
+    if (!opts->quiet && win >= 0) {
+        printf("c [Portfolio] Worker %u (%s) won with %u threads\n",
+               win_id, portfolio_worker_name(win_id), launched);
+    }
+
+    for (uint32_t i = 0; i < launched; i++) {
+        Solver* ws = workers[i].solver;
+        if (!ws) continue;
+        ws->share.exchange = NULL;  // Exchange is freed below
+        if (i == win_id) {
+            *winner = ws;
+        } else {
+            solver_free(ws);
+        }
+    }
+
+    exchange_free(ex);
+    free(workers);
+
+    if (*error != DIMACS_OK) result = UNDEF;
+    return result;
+}
@@ -0,0 +1,243 @@
+/*********************************************************************
+ * BSAT Competition Solver - DRAT Proof Writer Implementation
+ *********************************************************************/
+
+#define _POSIX_C_SOURCE 200809L  // clock_gettime
+
+#include "../include/proof.h"
+#include "../include/timer.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct ProofWriter {
+    FILE*     file;
+    bool      binary;
+    bool      io_error;
+
+    // Buffer ring: buffers[head .. head + count - 1] wait for the writer,
+    // the solver fills buffers[(head + count) % PROOF_BUFFERS]
+    char*     buffers[PROOF_BUFFERS];
+    size_t    lengths[PROOF_BUFFERS];
+    uint32_t  head;
+    uint32_t  count;
+    char*     cur;       // Buffer being filled
+    size_t    len;       // Bytes in cur
+
+    bool            threaded;
+    bool            closing;
+    pthread_t       thread;
+    pthread_mutex_t lock;
+    pthread_cond_t  cond;
+
+    ProofStats stats;
+};
+
+/*********************************************************************
+ * Writer Thread
+ *********************************************************************/
+
+static bool write_buffer(ProofWriter* p, const char* data, size_t size) {
+    return fwrite(data, 1, size, p->file) == size;
+}
+
+static void* writer_main(void* arg) {
+    ProofWriter* p = (ProofWriter*)arg;
+
+    pthread_mutex_lock(&p->lock);
+    for (;;) {
+        while (p->count == 0 && !p->closing) {
+            pthread_cond_wait(&p->cond, &p->lock);
+        }
+        if (p->count == 0) break;  // Closing and drained
+        uint32_t idx = p->head;
+        pthread_mutex_unlock(&p->lock);
+
+        double start = now_seconds();
+        bool ok = write_buffer(p, p->buffers[idx], p->lengths[idx]);
+        double elapsed = now_seconds() - start;
+
+        pthread_mutex_lock(&p->lock);
+        if (!ok) p->io_error = true;
+        p->stats.write_time += elapsed;
+        p->head = (p->head + 1) % PROOF_BUFFERS;
+        p->count--;
+        pthread_cond_broadcast(&p->cond);
+    }
+    pthread_mutex_unlock(&p->lock);
+    return NULL;
+}
+
+// Pass the current buffer to the writer and continue in a free one
+static void submit(ProofWriter* p) {
+    if (p->len == 0) return;
+
+    if (!p->threaded) {
+        p->stats.bytes += p->len;
+        double start = now_seconds();
+        if (!write_buffer(p, p->cur, p->len)) p->io_error = true;
+        p->stats.write_time += now_seconds() - start;
+        p->len = 0;
+        return;
+    }
+
+    pthread_mutex_lock(&p->lock);
+    if (p->count == PROOF_BUFFERS - 1) {
+        double start = now_seconds();
+        while (p->count == PROOF_BUFFERS - 1) {
+            pthread_cond_wait(&p->cond, &p->lock);
+        }
+        p->stats.wait_time += now_seconds() - start;
+    }
+    uint32_t idx = (p->head + p->count) % PROOF_BUFFERS;
+    p->lengths[idx] = p->len;
+    p->stats.bytes += p->len;
+    p->count++;
+    p->cur = p->buffers[(p->head + p->count) % PROOF_BUFFERS];
+    p->len = 0;
+    pthread_cond_broadcast(&p->cond);
+    pthread_mutex_unlock(&p->lock);
+}
+
+/*********************************************************************
+ * Encoding
+ *********************************************************************/
+
+// Make room for a tag or one more literal plus the clause terminator
+static inline void reserve(ProofWriter* p) {
+    if (p->len + PROOF_MAX_LIT_BYTES + 2 > PROOF_BUFFER_SIZE) submit(p);
+}
+
+static inline void put_binary(ProofWriter* p, uint32_t value) {
+    char* out = p->cur + p->len;
+    while (value > 0x7f) {
+        *out++ = (char)(0x80 | (value & 0x7f));
+        value >>= 7;
+    }
+    *out++ = (char)value;
+    p->len = (size_t)(out - p->cur);
+}
+
+// "<dimacs literal> " without printf
+static inline void put_text(ProofWriter* p, Lit lit) {
+    char digits[10];
+    int n = 0;
+    uint32_t v = var(lit);
+    do {
+        digits[n++] = (char)('0' + v % 10);
+        v /= 10;
+    } while (v > 0);
+
+    char* out = p->cur + p->len;
+    if (sign(lit)) *out++ = '-';
+    while (n > 0) *out++ = digits[--n];
+    *out++ = ' ';
+    p->len = (size_t)(out - p->cur);
+}
+
+static void emit(ProofWriter* p, bool deletion, const Lit* lits, uint32_t size) {
+    reserve(p);
+    if (p->binary) {
+        p->cur[p->len++] = deletion ? 'd' : 'a';
+    } else if (deletion) {
+        p->cur[p->len++] = 'd';
+        p->cur[p->len++] = ' ';
+    }
+
+    for (uint32_t i = 0; i < size; i++) {
+        reserve(p);
+        // Internal literals are already 2 * var + sign
+        if (p->binary) put_binary(p, lits[i]);
+        else put_text(p, lits[i]);
+    }
+
+    if (p->binary) {
+        p->cur[p->len++] = 0;
+    } else {
+        p->cur[p->len++] = '0';
+        p->cur[p->len++] = '\n';
+    }
+}
+
+/*********************************************************************
+ * Public API
+ *********************************************************************/
+
+ProofWriter* proof_open(const char* path, bool binary, bool threaded) {
+    ProofWriter* p = (ProofWriter*)calloc(1, sizeof(ProofWriter));
+    if (!p) return NULL;
+
+    p->file = fopen(path, binary ? "wb" : "w");
+    bool ok = p->file != NULL;
+    for (int i = 0; i < PROOF_BUFFERS && ok; i++) {
+        p->buffers[i] = (char*)malloc(PROOF_BUFFER_SIZE);
+        ok = p->buffers[i] != NULL;
+    }
+    if (!ok) {
+        if (p->file) fclose(p->file);
+        for (int i = 0; i < PROOF_BUFFERS; i++) free(p->buffers[i]);
+        free(p);
+        return NULL;
+    }
+
+    p->binary = binary;
+    p->cur = p->buffers[0];
+    pthread_mutex_init(&p->lock, NULL);
+    pthread_cond_init(&p->cond, NULL);
+
+    // Without a thread the solver writes full buffers itself
+    p->threaded = threaded && pthread_create(&p->thread, NULL, writer_main, p) == 0;
+    return p;
+}
+
+void proof_add(ProofWriter* p, const Lit* lits, uint32_t size) {
+    if (!p) return;
+    emit(p, false, lits, size);
+    p->stats.added++;
+}
+
+void proof_delete(ProofWriter* p, const Lit* lits, uint32_t size) {
+    if (!p) return;
+    emit(p, true, lits, size);
+    p->stats.deleted++;
+}
+
+void proof_flush(ProofWriter* p) {
+    if (!p) return;
+    submit(p);
+}
+
+bool proof_close(ProofWriter* p) {
+    if (!p) return true;
+
+    submit(p);
+    if (p->threaded) {
+        pthread_mutex_lock(&p->lock);
+        p->closing = true;
+        pthread_cond_broadcast(&p->cond);
+        pthread_mutex_unlock(&p->lock);
+        pthread_join(p->thread, NULL);
+    }
+    pthread_cond_destroy(&p->cond);
+    pthread_mutex_destroy(&p->lock);
+
+    bool ok = !p->io_error;
+    if (fclose(p->file) != 0) ok = false;
+    for (int i = 0; i < PROOF_BUFFERS; i++) free(p->buffers[i]);
+    free(p);
+    return ok;
+}
+
+ProofStats proof_stats(const ProofWriter* p) {
+    ProofStats stats;
+    memset(&stats, 0, sizeof(stats));
+    if (!p) return stats;
+
+    // The writer thread updates write_time under the lock
+    ProofWriter* w = (ProofWriter*)p;
+    pthread_mutex_lock(&w->lock);
+    stats = w->stats;
+    pthread_mutex_unlock(&w->lock);
+    stats.bytes += p->len;  // Encoded but not yet submitted
+    return stats;
+}
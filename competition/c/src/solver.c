@@ -2,12 +2,19 @@
  * BSAT Competition Solver - Core Solver Implementation
  *********************************************************************/
 
+#define _POSIX_C_SOURCE 200809L  // sigaction
+
 #include "../include/solver.h"
+#include "../include/portfolio.h"
+#include "../include/timer.h"
+#include "../include/checkpoint.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 #include <math.h>
 #include <signal.h>
+#include <time.h>
+#include <sys/resource.h>
 
 /*********************************************************************
  * Variable Array Growth Configuration
@@ -24,6 +31,54 @@
 #define VAR_GROWTH_FACTOR 2
 #endif
 
+/*********************************************************************
+ * Learned Clause Reduction Configuration
+ *********************************************************************/
+
+// Clause activity decay per conflict (MiniSat/Glucose value)
+#define CLAUSE_ACTIVITY_DECAY 0.999
+
+// LBD buckets for candidate selection; larger LBDs share the last bucket
+#define REDUCE_LBD_BUCKETS 64
+
+/*********************************************************************
+ * Search Mode Configuration
+ *********************************************************************/
+
+// Growth of the tick budget of a phase after each stable phase
+#define MODE_GROWTH 2
+
+/*********************************************************************
+ * Propagation Configuration
+ *********************************************************************/
+
+// Watches between the one being processed and the one whose clause
+// header is prefetched (0 disables prefetching)
+#ifndef PROPAGATE_PREFETCH
+#define PROPAGATE_PREFETCH 2
+#endif
+
+/*********************************************************************
+ * Effort Ticks
+ *
+ * A deterministic measure of search effort, independent of the machine
+ * and its load: one tick per cache line of an implication or watch list
+ * scanned, one per clause whose memory propagation reads, and one per
+ * literal conflict analysis visits. Schedules and limits in ticks give
+ * bit-identical runs wherever they run.
+ *********************************************************************/
+
+#define TICK_LINE_BYTES 64
+
+static inline uint64_t cache_lines(uint64_t bytes) {
+    return (bytes + TICK_LINE_BYTES - 1) / TICK_LINE_BYTES;
+}
+
+// Ticks of the search proper (inprocessing rounds excluded)
+static inline uint64_t search_ticks(const Solver* s) {
+    return s->stats.ticks - s->inprocess.ticks;
+}
+
 /*********************************************************************
  * Signal Handling for Progress Monitoring
  *********************************************************************/
@@ -54,6 +109,7 @@ static void print_progress_stats(const Solver* s) {
     fprintf(stderr, "c Elapsed time     : %.3f s\n", elapsed);
     fprintf(stderr, "c Decisions        : %llu\n", (unsigned long long)s->stats.decisions);
     fprintf(stderr, "c Propagations     : %llu\n", (unsigned long long)s->stats.propagations);
+    fprintf(stderr, "c Ticks            : %llu\n", (unsigned long long)s->stats.ticks);
     fprintf(stderr, "c Conflicts        : %llu\n", (unsigned long long)s->stats.conflicts);
     fprintf(stderr, "c Restarts         : %llu\n", (unsigned long long)s->stats.restarts);
     fprintf(stderr, "c Learned clauses  : %llu\n", (unsigned long long)s->stats.learned_clauses);
@@ -72,32 +128,17 @@ static void print_progress_stats(const Solver* s) {
  * DRAT Proof Logging
  *
  * These functions log clause additions and deletions for proof verification.
- * Format: "<lit1> <lit2> ... 0" for add, "d <lit1> <lit2> ... 0" for delete
+ * Encoding and buffered output live in proof.c (text or binary DRAT).
  *********************************************************************/
 
-// Convert internal literal to DIMACS format (already 1-indexed, negative for negated)
-static inline int lit_to_dimacs(Lit lit) {
-    int v = (int)(lit >> 1);  // Variable (already 1-indexed in our encoding)
-    return (lit & 1) ? -v : v;  // Negated for sign bit set
-}
-
 // Log a clause addition to the proof file
 void proof_add_clause(Solver* s, const Lit* lits, uint32_t size) {
-    if (!s->proof_file) return;
-    for (uint32_t i = 0; i < size; i++) {
-        fprintf(s->proof_file, "%d ", lit_to_dimacs(lits[i]));
-    }
-    fprintf(s->proof_file, "0\n");
+    proof_add(s->proof, lits, size);
 }
 
 // Log a clause deletion to the proof file
 void proof_delete_clause(Solver* s, const Lit* lits, uint32_t size) {
-    if (!s->proof_file) return;
-    fprintf(s->proof_file, "d ");
-    for (uint32_t i = 0; i < size; i++) {
-        fprintf(s->proof_file, "%d ", lit_to_dimacs(lits[i]));
-    }
-    fprintf(s->proof_file, "0\n");
+    proof_delete(s->proof, lits, size);
 }
 
 /*********************************************************************
@@ -109,14 +150,17 @@ SolverOpts default_opts(void) {
         .max_conflicts = 0,        // Unlimited
         .max_decisions = 0,        // Unlimited
         .max_time = 0.0,          // Unlimited
+        .max_ticks = 0,           // Unlimited
 
         // Branching heuristic
         .lrb = false,             // Use VSIDS by default
+        .vmtf = false,
         .var_decay = 0.95,
         .var_inc = 1.0,
         .clause_decay = 0.999,
         .lrb_step_min = 0.06,     // Minimum step for LRB (from MapleSAT)
         .lrb_step_max = 0.4,      // Maximum step for LRB (from MapleSAT)
+        .seed = 0,                // Deterministic by default
 
         .restart_first = 100,
         .restart_inc = 1.5,
@@ -124,6 +168,13 @@ SolverOpts default_opts(void) {
         .luby_restart = false,     // Disabled
         .luby_unit = 100,          // Python uses 100, MiniSat uses 512 (using Python's value)
         .restart_postpone = 10,
+        .restart_reuse = true,
+        .modes = false,            // Opt-in focused/stable alternation
+        .mode_interval = 1000,
+
+        // Backtracking policy
+        .chrono = true,
+        .chrono_threshold = 100,
 
         // Glucose EMA parameters (for --glucose-restart-ema)
         .glucose_use_ema = true,       // Use EMA mode - sliding window has correctness bug
@@ -145,37 +196,56 @@ SolverOpts default_opts(void) {
 
         .max_lbd = 30,
         .glue_lbd = 2,
+        .tier2_lbd = 6,
         .reduce_fraction = 0.5,
         .reduce_interval = 2000,
         .minimize = true,         // MiniSat-style clause minimization
+        .shrink = true,           // All-UIP shrinking of learned clauses
 
         .bce = false,             // DISABLED by default - can hurt SAT instance performance
         .probing = true,          // Enable failed literal probing
+        .gauss = false,           // XOR matrices (opt-in with --gauss)
 
         // BVE options (opt-in)
         .elim = false,            // BVE disabled by default (opt-in with --elim)
         .elim_max_occ = 10,       // Max occurrences to consider for elimination
         .elim_grow = 0,           // No clause growth allowed by default
+        .elim_threads = 0,        // One resolution thread per CPU
 
         // DRAT proof logging (opt-in)
         .proof_path = NULL,       // No proof by default
         .binary_proof = false,    // Text format by default
 
+        // Checkpoints (opt-in)
+        .checkpoint_path = NULL,
+        .checkpoint_interval = 600.0,
+
+        .pin_threads = false,     // Workers float (opt-in with --pin-threads)
+
         .inprocess = false,
         .inprocess_interval = 10000,
+        .inprocess_probe = 50,    // Per mille of search propagations
+        .inprocess_subsume = 200,
+        .inprocess_vivify = 100,
+        .inprocess_bce = 50,
+        .inprocess_elim = 50,
         .subsumption = true,
+        .subsume_effort = 10000000,  // Literal visits per subsumption round
         .var_elim = true,
 
         // Local search options (opt-in)
         .local_search = false,    // Disabled by default
-        .ls_interval = 5000,      // Run local search every 5000 conflicts
+        .ls_interval = 5000,      // First local search after 5000 conflicts
         .ls_max_flips = 100000,   // Max flips per local search call
         .ls_noise = 0.5,          // WalkSAT noise parameter
+        .ls_probsat = false,      // WalkSAT by default
+        .ls_cb = 2.3,             // ProbSAT polynomial exponent (3-SAT)
 
         .verbose = false,
         .debug = false,
         .quiet = false,
-        .stats = true
+        .stats = true,
+        .report_interval = 0
     };
 
     // Override from environment variables
@@ -198,61 +268,63 @@ static inline uint32_t heap_right(uint32_t i) { return 2 * i + 2; }
 static inline uint32_t heap_parent(uint32_t i) { return (i - 1) / 2; }
 
 static void heap_percolate_up(Solver* s, uint32_t i) {
-    Var v = s->order.heap[i];
-    double act = s->vars[v].activity;
+    Var* heap = s->order.heap;
+    const double* act = s->order.activity;
+    Var v = heap[i];
+    double a = act[v];
 
     while (i > 0) {
         uint32_t p = heap_parent(i);
-        Var pv = s->order.heap[p];
+        Var pv = heap[p];
 
-        if (s->vars[pv].activity >= act) break;
+        if (act[pv] >= a) break;
 
-        s->order.heap[i] = pv;
-        s->vars[pv].heap_pos = i;
+        heap[i] = pv;
+        s->order.pos[pv] = i;
         i = p;
     }
 
-    s->order.heap[i] = v;
-    s->vars[v].heap_pos = i;
+    heap[i] = v;
+    s->order.pos[v] = i;
 }
 
 static void heap_percolate_down(Solver* s, uint32_t i) {
-    Var v = s->order.heap[i];
-    double act = s->vars[v].activity;
+    Var* heap = s->order.heap;
+    const double* act = s->order.activity;
+    Var v = heap[i];
+    double a = act[v];
 
     while (heap_left(i) < s->order.size) {
         uint32_t child = heap_left(i);
-        if (heap_right(i) < s->order.size &&
-            s->vars[s->order.heap[heap_right(i)]].activity >
-            s->vars[s->order.heap[child]].activity) {
+        if (heap_right(i) < s->order.size && act[heap[heap_right(i)]] > act[heap[child]]) {
             child = heap_right(i);
         }
 
-        if (act >= s->vars[s->order.heap[child]].activity) break;
+        if (a >= act[heap[child]]) break;
 
-        s->order.heap[i] = s->order.heap[child];
-        s->vars[s->order.heap[i]].heap_pos = i;
+        heap[i] = heap[child];
+        s->order.pos[heap[i]] = i;
         i = child;
     }
 
-    s->order.heap[i] = v;
-    s->vars[v].heap_pos = i;
+    heap[i] = v;
+    s->order.pos[v] = i;
 }
 
 static void heap_insert(Solver* s, Var v) {
-    if (s->vars[v].heap_pos != UINT32_MAX) return;  // Already in heap
+    if (s->order.pos[v] != UINT32_MAX) return;  // Already in heap
 
     uint32_t i = s->order.size++;
     s->order.heap[i] = v;
-    s->vars[v].heap_pos = i;
+    s->order.pos[v] = i;
     heap_percolate_up(s, i);
 }
 
 static void heap_remove(Solver* s, Var v) {
-    uint32_t pos = s->vars[v].heap_pos;
+    uint32_t pos = s->order.pos[v];
     if (pos == UINT32_MAX) return;  // Not in heap
 
-    s->vars[v].heap_pos = UINT32_MAX;
+    s->order.pos[v] = UINT32_MAX;
 
     if (pos == s->order.size - 1) {
         s->order.size--;
@@ -261,9 +333,9 @@ static void heap_remove(Solver* s, Var v) {
 
     Var last = s->order.heap[--s->order.size];
     s->order.heap[pos] = last;
-    s->vars[last].heap_pos = pos;
+    s->order.pos[last] = pos;
 
-    if (pos > 0 && s->vars[last].activity > s->vars[s->order.heap[heap_parent(pos)]].activity) {
+    if (pos > 0 && s->order.activity[last] > s->order.activity[s->order.heap[heap_parent(pos)]]) {
         heap_percolate_up(s, pos);
     } else {
         heap_percolate_down(s, pos);
@@ -278,7 +350,113 @@ static Var heap_extract_max(Solver* s) {
     return v;
 }
 
+/*********************************************************************
+ * VMTF Queue Operations
+ *
+ * Conflict analysis collects the variables it bumps; they are moved to
+ * the end of the queue afterwards, sorted by their old stamps so that
+ * their relative order survives. A bump is O(1) and touches no other
+ * variable. Decisions walk backwards from queue.search, which moves
+ * forward again only when a later variable is unassigned.
+ *********************************************************************/
+
+static void vmtf_append(Solver* s, Var v) {
+    VmtfLink* links = s->queue.links;
+
+    links[v].prev = s->queue.last;
+    links[v].next = 0;
+    if (s->queue.last) {
+        links[s->queue.last].next = v;
+    } else {
+        s->queue.first = v;
+    }
+    s->queue.last = v;
+    links[v].stamp = ++s->queue.stamp;
+
+    if (var_value(s, v) == UNDEF) s->queue.search = v;
+}
+
+static void vmtf_move_to_front(Solver* s, Var v) {
+    VmtfLink* links = s->queue.links;
+    if (v == s->queue.last) return;
+
+    Var prev = links[v].prev;
+    Var next = links[v].next;
+    if (s->queue.search == v) s->queue.search = prev ? prev : next;
+
+    if (prev) {
+        links[prev].next = next;
+    } else {
+        s->queue.first = next;
+    }
+    links[next].prev = prev;
+
+    vmtf_append(s, v);
+}
+
+static int vmtf_bump_cmp(const void* a, const void* b) {
+    uint64_t x = ((const VmtfBump*)a)->stamp;
+    uint64_t y = ((const VmtfBump*)b)->stamp;
+    return (x > y) - (x < y);
+}
+
+static void vmtf_bump_analyzed(Solver* s) {
+    VmtfBump* bumped = s->queue.bumped;
+    uint32_t n = s->queue.num_bumped;
+
+    qsort(bumped, n, sizeof(VmtfBump), vmtf_bump_cmp);
+    for (uint32_t i = 0; i < n; i++) {
+        vmtf_move_to_front(s, bumped[i].var);
+    }
+    s->queue.num_bumped = 0;
+}
+
+// Unassigned variable with the latest stamp, or INVALID_VAR
+static Var vmtf_next(Solver* s) {
+    const VmtfLink* links = s->queue.links;
+    Var v = s->queue.search;
+
+    while (v != INVALID_VAR) {
+        bool eliminated = s->elim && v < s->elim->elim_capacity && s->elim->eliminated[v];
+        if (var_value(s, v) == UNDEF && !eliminated) break;
+        v = links[v].prev;
+    }
+    s->queue.search = v;
+    return v;
+}
+
+/*********************************************************************
+ * Decision Order
+ *
+ * The heuristic-independent interface: variables become available to
+ * decisions when they are unassigned, and conflict analysis bumps them.
+ *********************************************************************/
+
+// Make an unassigned variable a decision candidate again
+static inline void order_push(Solver* s, Var v) {
+    if (s->mode.vmtf) {
+        const VmtfLink* links = s->queue.links;
+        if (links[v].stamp > links[s->queue.search].stamp) s->queue.search = v;
+    } else if (s->order.pos[v] == UINT32_MAX) {
+        heap_insert(s, v);
+    }
+}
+
+static void rescale_var_activity(Solver* s) {
+    double* act = s->order.activity;
+    for (Var i = 1; i <= s->num_vars; i++) {
+        act[i] *= 1e-100;
+    }
+    s->order.var_inc *= 1e-100;
+}
+
 static void bump_var_activity(Solver* s, Var v, double inc) {
+    if (s->mode.vmtf) {
+        // Moved to the front once analysis is done (vmtf_bump_analyzed)
+        s->queue.bumped[s->queue.num_bumped++] = (VmtfBump){ s->queue.links[v].stamp, v };
+        return;
+    }
+
     if (s->opts.lrb) {
         // Hybrid VSIDS+LRB: Use VSIDS-style additive bumps with LRB-inspired
         // weighting based on recency of conflict participation
@@ -291,40 +469,64 @@ static void bump_var_activity(Solver* s, Var v, double inc) {
         double multiplier = 1.0 / (1.0 + 0.1 * sqrt((double)age));
 
         // Add weighted increment (like VSIDS but with recency bonus)
-        s->vars[v].activity += s->order.var_inc * multiplier;
+        s->order.activity[v] += s->order.var_inc * multiplier;
         s->vars[v].last_conflict = current;
-
-        // Rescale if needed (same as VSIDS)
-        if (s->vars[v].activity > 1e100) {
-            for (Var i = 1; i <= s->num_vars; i++) {
-                s->vars[i].activity *= 1e-100;
-            }
-            s->order.var_inc *= 1e-100;
-        }
     } else {
         // Standard VSIDS: add increment to activity
-        s->vars[v].activity += inc;
+        s->order.activity[v] += inc;
+    }
 
-        // Rescale if needed
-        if (s->vars[v].activity > 1e100) {
-            for (Var i = 1; i <= s->num_vars; i++) {
-                s->vars[i].activity *= 1e-100;
-            }
-            s->order.var_inc *= 1e-100;
-        }
+    // Rescale if needed (keeps the heap order)
+    if (s->order.activity[v] > 1e100) {
+        rescale_var_activity(s);
     }
 
     // Update heap position
-    if (s->vars[v].heap_pos != UINT32_MAX) {
-        heap_percolate_up(s, s->vars[v].heap_pos);
+    if (s->order.pos[v] != UINT32_MAX) {
+        heap_percolate_up(s, s->order.pos[v]);
     }
 }
 
 static void decay_var_inc(Solver* s) {
-    // Apply decay for both VSIDS and hybrid LRB
+    // Apply decay for both VSIDS and hybrid LRB (frozen while VMTF decides)
+    if (s->mode.vmtf) return;
     s->order.var_inc /= s->order.var_decay;
 }
 
+void solver_rebuild_order(Solver* s) {
+    // Heap over every variable; decisions skip the assigned ones
+    if (!s->opts.vmtf) {
+        s->order.size = 0;
+        for (Var v = 1; v <= s->num_vars; v++) s->order.pos[v] = UINT32_MAX;
+        for (Var v = 1; v <= s->num_vars; v++) heap_insert(s, v);
+    }
+
+    // Queue relinked in stamp order, keeping the stamps
+    if (s->queue.links) {
+        VmtfLink* links = s->queue.links;
+        VmtfBump* order = s->queue.bumped;
+        for (Var v = 1; v <= s->num_vars; v++) {
+            order[v - 1] = (VmtfBump){ links[v].stamp, v };
+        }
+        qsort(order, s->num_vars, sizeof(VmtfBump), vmtf_bump_cmp);
+
+        s->queue.first = s->queue.last = 0;
+        for (uint32_t i = 0; i < s->num_vars; i++) {
+            Var v = order[i].var;
+            links[v].prev = s->queue.last;
+            links[v].next = 0;
+            if (s->queue.last) {
+                links[s->queue.last].next = v;
+            } else {
+                s->queue.first = v;
+            }
+            s->queue.last = v;
+            if (links[v].stamp > s->queue.stamp) s->queue.stamp = links[v].stamp;
+        }
+        s->queue.search = s->queue.last;
+    }
+}
+
 /*********************************************************************
  * Solver Creation and Destruction
  *********************************************************************/
@@ -334,26 +536,27 @@ Solver* solver_new(void) {
     return solver_new_with_opts(&opts);
 }
 
-Solver* solver_new_with_opts(const SolverOpts* opts) {
-    Solver* s = (Solver*)calloc(1, sizeof(Solver));
-    if (!s) return NULL;
-
+// Initialize a zeroed solver; the arena and watch manager are only
+// created if the solver does not have them yet (solver_reset keeps them)
+static bool solver_init(Solver* s, const SolverOpts* opts) {
     // Copy options
     s->opts = *opts;
 
     // Initialize core structures
-    s->arena = arena_init(0);
-    if (!s->arena) goto error;
+    if (!s->arena) s->arena = arena_init(0);
+    if (!s->arena) return false;
 
-    s->watches = watch_init(0);  // Will grow as variables are added
-    if (!s->watches) goto error;
+    if (!s->watches) s->watches = watch_init(0);  // Will grow as variables are added
+    if (!s->watches) return false;
 
     // Initialize order heap
     s->order.var_inc = opts->var_inc;
+    s->db.clause_inc = 1.0;
     s->order.var_decay = opts->var_decay;
 
-    // Initialize variable capacity (will allocate on first variable add)
-    s->var_capacity = 0;
+    // Search modes start focused
+    s->mode.vmtf = opts->vmtf || opts->modes;
+    s->mode.start.time = (double)clock() / CLOCKS_PER_SEC;
 
     // Initialize restart state
     s->restart.threshold = opts->restart_first;
@@ -363,7 +566,7 @@ Solver* solver_new_with_opts(const SolverOpts* opts) {
     // Always allocate if glucose_restart is enabled (may switch modes at runtime)
     if (opts->glucose_restart) {
         s->restart.recent_lbds = (uint32_t*)calloc(opts->glucose_window_size, sizeof(uint32_t));
-        if (!s->restart.recent_lbds) goto error;
+        if (!s->restart.recent_lbds) return false;
         s->restart.recent_lbds_count = 0;
         s->restart.recent_lbds_head = 0;
         s->restart.lbd_sum = 0;
@@ -374,21 +577,27 @@ Solver* solver_new_with_opts(const SolverOpts* opts) {
 
     // Set start time
     s->stats.start_time = (double)clock() / CLOCKS_PER_SEC;
+#ifdef BSAT_PHASES
+    s->phases.start_ticks = phase_ticks();
+    s->phases.start_seconds = phase_wall_seconds();
+#endif
+
+    // Seed per-solver random number generator
+    s->rng = rng_seed(opts->seed);
 
     // Initialize BVE state (will be allocated on demand)
     s->elim = NULL;
 
-    // Initialize DRAT proof file
-    s->proof_file = NULL;
+    // Initialize DRAT proof writer (background thread does the file I/O)
+    s->proof = NULL;
     if (opts->proof_path) {
-        s->proof_file = fopen(opts->proof_path, "w");
-        if (!s->proof_file && !opts->quiet) {
+        s->proof = proof_open(opts->proof_path, opts->binary_proof, true);
+        if (!s->proof && !opts->quiet) {
             fprintf(stderr, "c Warning: Could not open proof file: %s\n", opts->proof_path);
         }
     }
 
     // Initialize rephasing state
-    s->rephase.best_phase = NULL;  // Allocated on demand in grow_var_arrays
     s->rephase.best_trail_size = 0;
     s->rephase.conflicts_since = 0;
     s->rephase.rephase_count = 0;
@@ -401,11 +610,47 @@ Solver* solver_new_with_opts(const SolverOpts* opts) {
 
     s->result = UNDEF;
 
+    return true;
+}
+
+Solver* solver_new_with_opts(const SolverOpts* opts) {
+    Solver* s = (Solver*)calloc(1, sizeof(Solver));
+    if (!s) return NULL;
+
+    // Variable arrays are allocated on first variable add
+    if (!solver_init(s, opts)) {
+        solver_free(s);
+        return NULL;
+    }
+
     return s;
+}
+
+// Free the state that is allocated per formula or on demand
+static void free_formula_state(Solver* s) {
+    free(s->restart.recent_lbds);  // Free Glucose sliding window buffer
+    free(s->share.cursors);        // Free portfolio read cursors
+    free(s->incremental.model);    // Free saved model
+    free(s->incremental.conflict); // Free final conflict
+
+    // Free local search state
+    if (s->local_search.state) {
+        local_search_free(s->local_search.state);
+    }
+
+    // Free BVE state
+    elim_free(s);
+
+    // Free XOR matrices
+    gauss_free(s);
 
-error:
-    solver_free(s);
-    return NULL;
+    // Write out and close DRAT proof file
+    if (s->proof) {
+        if (!proof_close(s->proof) && !s->opts.quiet) {
+            fprintf(stderr, "c Warning: Error writing proof file: %s\n", s->opts.proof_path);
+        }
+        s->proof = NULL;
+    }
 }
 
 void solver_free(Solver* s) {
@@ -415,30 +660,27 @@ void solver_free(Solver* s) {
     watch_free(s->watches);
 
     free(s->vars);
+    free(s->vals);
+    free(s->levels);
+    free(s->reasons);
+    free(s->trail_pos);
     free(s->trail);
     free(s->trail_lims);
     free(s->clauses);
     free(s->learnts);
+    free(s->db.cands);
     free(s->order.heap);
+    free(s->order.activity);
+    free(s->order.pos);
+    free(s->queue.links);
+    free(s->queue.bumped);
     free(s->seen);
     free(s->analyze_stack);
+    free(s->analyze_toclear);
+    free(s->analyze_levels);
     free(s->binary_reasons);
-    free(s->restart.recent_lbds);  // Free Glucose sliding window buffer
     free(s->rephase.best_phase);   // Free rephasing best phase array
-
-    // Free local search state
-    if (s->local_search.state) {
-        local_search_free(s->local_search.state);
-    }
-
-    // Free BVE state
-    elim_free(s);
-
-    // Close DRAT proof file
-    if (s->proof_file) {
-        fclose(s->proof_file);
-        s->proof_file = NULL;
-    }
+    free_formula_state(s);
 
     free(s);
 }
@@ -460,6 +702,23 @@ static bool grow_var_arrays(Solver* s, uint32_t new_capacity) {
     if (!new_vars) return false;
     s->vars = new_vars;
 
+    // Grow assignment arrays (values are per literal)
+    uint8_t* new_vals = (uint8_t*)realloc(s->vals, 2 * alloc_size * sizeof(uint8_t));
+    if (!new_vals) return false;
+    s->vals = new_vals;
+
+    Level* new_levels = (Level*)realloc(s->levels, alloc_size * sizeof(Level));
+    if (!new_levels) return false;
+    s->levels = new_levels;
+
+    CRef* new_reasons = (CRef*)realloc(s->reasons, alloc_size * sizeof(CRef));
+    if (!new_reasons) return false;
+    s->reasons = new_reasons;
+
+    uint32_t* new_trail_pos = (uint32_t*)realloc(s->trail_pos, alloc_size * sizeof(uint32_t));
+    if (!new_trail_pos) return false;
+    s->trail_pos = new_trail_pos;
+
     // Grow trail
     Trail* new_trail = (Trail*)realloc(s->trail, alloc_size * sizeof(Trail));
     if (!new_trail) return false;
@@ -470,21 +729,51 @@ static bool grow_var_arrays(Solver* s, uint32_t new_capacity) {
     if (!new_lims) return false;
     s->trail_lims = new_lims;
 
-    // Grow heap
+    // Grow heap and its dense activity and position arrays
     Var* new_heap = (Var*)realloc(s->order.heap, alloc_size * sizeof(Var));
     if (!new_heap) return false;
     s->order.heap = new_heap;
 
+    double* new_activity = (double*)realloc(s->order.activity, alloc_size * sizeof(double));
+    if (!new_activity) return false;
+    s->order.activity = new_activity;
+
+    uint32_t* new_pos = (uint32_t*)realloc(s->order.pos, alloc_size * sizeof(uint32_t));
+    if (!new_pos) return false;
+    s->order.pos = new_pos;
+
+    // Grow VMTF queue (entry 0 is the null link, with stamp 0)
+    if (s->opts.vmtf || s->opts.modes) {
+        VmtfLink* new_links = (VmtfLink*)realloc(s->queue.links, alloc_size * sizeof(VmtfLink));
+        if (!new_links) return false;
+        s->queue.links = new_links;
+        memset(&s->queue.links[0], 0, sizeof(VmtfLink));
+
+        VmtfBump* new_bumped = (VmtfBump*)realloc(s->queue.bumped, alloc_size * sizeof(VmtfBump));
+        if (!new_bumped) return false;
+        s->queue.bumped = new_bumped;
+    }
+
     // Grow seen array
     uint8_t* new_seen = (uint8_t*)realloc(s->seen, alloc_size * sizeof(uint8_t));
     if (!new_seen) return false;
     s->seen = new_seen;
 
-    // Grow analyze stack
-    Lit* new_stack = (Lit*)realloc(s->analyze_stack, alloc_size * sizeof(Lit));
+    // Grow minimization scratch (levels never exceed the variable count)
+    MinimizeFrame* new_stack = (MinimizeFrame*)realloc(s->analyze_stack, alloc_size * sizeof(MinimizeFrame));
     if (!new_stack) return false;
     s->analyze_stack = new_stack;
 
+    Var* new_toclear = (Var*)realloc(s->analyze_toclear, alloc_size * sizeof(Var));
+    if (!new_toclear) return false;
+    s->analyze_toclear = new_toclear;
+
+    AnalyzeLevel* new_levels_info = (AnalyzeLevel*)realloc(s->analyze_levels, alloc_size * sizeof(AnalyzeLevel));
+    if (!new_levels_info) return false;
+    s->analyze_levels = new_levels_info;
+    uint32_t old_size = s->var_capacity ? s->var_capacity + 1 : 0;
+    memset(&s->analyze_levels[old_size], 0, (alloc_size - old_size) * sizeof(AnalyzeLevel));
+
     // Grow binary reasons array
     Lit* new_binary_reasons = (Lit*)realloc(s->binary_reasons, alloc_size * sizeof(Lit));
     if (!new_binary_reasons) return false;
@@ -541,10 +830,11 @@ Var solver_new_var(Solver* s) {
 
     // Initialize new variable
     memset(&s->vars[v], 0, sizeof(VarInfo));
-    s->vars[v].value = UNDEF;
-    s->vars[v].level = INVALID_LEVEL;
-    s->vars[v].reason = INVALID_CLAUSE;
-    s->vars[v].heap_pos = UINT32_MAX;
+    unassign_var(s, v);
+    s->levels[v] = INVALID_LEVEL;
+    s->reasons[v] = INVALID_CLAUSE;
+    s->order.activity[v] = 0.0;
+    s->order.pos[v] = UINT32_MAX;
     s->vars[v].polarity = false;  // Default phase
 
     // Initialize seen flag
@@ -553,23 +843,103 @@ Var solver_new_var(Solver* s) {
     // Initialize binary reason (LIT_UNDEF means no binary propagation)
     s->binary_reasons[v] = LIT_UNDEF;
 
-    // Add to decision heap
-    heap_insert(s, v);
+    // Add to the decision order (new variables come first in VMTF);
+    // with search modes the variable joins both
+    if (s->opts.vmtf || s->opts.modes) vmtf_append(s, v);
+    if (!s->opts.vmtf) heap_insert(s, v);
 
     return v;
 }
 
+bool solver_reserve(Solver* s, uint32_t num_vars, uint32_t num_clauses) {
+    if (num_vars > MAX_VARS) return false;
+
+    if (num_vars > s->var_capacity) {
+        if (!grow_var_arrays(s, num_vars)) return false;
+        s->var_capacity = num_vars;
+    }
+
+    if (num_clauses > s->num_original) {
+        CRef* new_clauses = (CRef*)realloc(s->clauses, num_clauses * sizeof(CRef));
+        if (!new_clauses) return false;
+        s->clauses = new_clauses;
+        s->num_original = num_clauses;
+    }
+
+    return true;
+}
+
+bool solver_reset(Solver* s, const SolverOpts* opts) {
+    free_formula_state(s);
+
+    // Keep every buffer that grows with the formula, clear the rest
+    Solver kept = *s;
+    uint32_t used = s->num_vars + 1;  // Entries the last formula touched
+    memset(s, 0, sizeof(Solver));
+
+    s->var_capacity = kept.var_capacity;
+    s->num_original = kept.num_original;  // Capacity of clauses
+    s->arena = kept.arena;
+    s->watches = kept.watches;
+    s->vars = kept.vars;
+    s->vals = kept.vals;
+    s->levels = kept.levels;
+    s->reasons = kept.reasons;
+    s->trail_pos = kept.trail_pos;
+    s->trail = kept.trail;
+    s->trail_lims = kept.trail_lims;
+    s->clauses = kept.clauses;
+    s->learnts = kept.learnts;
+    s->learnts_size = kept.learnts_size;
+    s->db.cands = kept.db.cands;
+    s->db.cands_size = kept.db.cands_size;
+    s->order.heap = kept.order.heap;
+    s->order.activity = kept.order.activity;
+    s->order.pos = kept.order.pos;
+    s->queue.links = kept.queue.links;
+    s->queue.bumped = kept.queue.bumped;
+    s->seen = kept.seen;
+    s->analyze_stack = kept.analyze_stack;
+    s->analyze_toclear = kept.analyze_toclear;
+    s->analyze_levels = kept.analyze_levels;
+    s->binary_reasons = kept.binary_reasons;
+    s->rephase.best_phase = kept.rephase.best_phase;
+
+    arena_clear(s->arena);
+    watch_clear(s->watches);
+
+    // solver_new_var initializes the rest of a variable's entries; these
+    // are assumed zero (analysis stamps restart from 0)
+    if (s->var_capacity) {
+        memset(s->seen, 0, used * sizeof(uint8_t));
+        memset(s->analyze_levels, 0, used * sizeof(AnalyzeLevel));
+        if (s->rephase.best_phase) memset(s->rephase.best_phase, 0, used * sizeof(bool));
+
+        // Arrays the new options need but the old ones did not allocate
+        if (((opts->vmtf || opts->modes) && !s->queue.links) || (opts->rephase && !s->rephase.best_phase)) {
+            uint32_t capacity = s->var_capacity;
+            s->opts = *opts;      // grow_var_arrays allocates what opts need
+            s->var_capacity = 0;  // Initialize all entries of new arrays
+            bool grown = grow_var_arrays(s, capacity);
+            s->var_capacity = capacity;
+            if (!grown) return false;
+        }
+    }
+
+    return solver_init(s, opts);
+}
+
 /*********************************************************************
  * Trail Management
  *********************************************************************/
 
 static inline void push_trail(Solver* s, Lit lit) {
     Var v = var(lit);
-    ASSERT(s->vars[v].value == UNDEF);
+    ASSERT(var_value(s, v) == UNDEF);
 
-    s->vars[v].value = sign(lit) ? FALSE : TRUE;
-    s->vars[v].level = s->decision_level;
-    s->vars[v].trail_pos = s->trail_size;
+    assign_lit(s, lit);
+    s->levels[v] = s->decision_level;
+    s->trail_pos[v] = s->trail_size;
 
     s->trail[s->trail_size].lit = lit;
     s->trail[s->trail_size].level = s->decision_level;
@@ -581,6 +951,22 @@ static inline void push_trail(Solver* s, Lit lit) {
     }
 }
 
+// Open a new decision level and assign lit as its decision (no propagation)
+static inline void new_decision(Solver* s, Lit lit) {
+    s->decision_level++;
+    s->trail_lims[s->decision_level] = s->trail_size;
+
+    Var v = var(lit);
+    assign_lit(s, lit);
+    s->levels[v] = s->decision_level;
+    s->reasons[v] = INVALID_CLAUSE;
+    s->trail_pos[v] = s->trail_size;
+
+    s->trail[s->trail_size].lit = lit;
+    s->trail[s->trail_size].level = s->decision_level;
+    s->trail_size++;
+}
+
 void solver_backtrack(Solver* s, Level level) {
     if (level >= s->decision_level) return;
 
@@ -591,50 +977,51 @@ void solver_backtrack(Solver* s, Level level) {
         uint32_t write_pos = 0;
         for (uint32_t i = 0; i < s->trail_size; i++) {
             Var v = var(s->trail[i].lit);
-            if (s->vars[v].level == 0) {
+            if (s->levels[v] == 0) {
                 // Keep this level-0 assignment
                 if (write_pos != i) {
                     s->trail[write_pos] = s->trail[i];
-                    s->vars[v].trail_pos = write_pos;
+                    s->trail_pos[v] = write_pos;
                 }
                 write_pos++;
             } else {
                 // Undo this assignment (level > 0)
-                s->vars[v].value = UNDEF;
-                s->vars[v].level = INVALID_LEVEL;
-                s->vars[v].reason = INVALID_CLAUSE;
+                unassign_var(s, v);
+                s->levels[v] = INVALID_LEVEL;
+                s->reasons[v] = INVALID_CLAUSE;
                 s->binary_reasons[v] = LIT_UNDEF;  // Clear binary reason
 
-                // Re-insert into decision heap
-                if (s->vars[v].heap_pos == UINT32_MAX) {
-                    heap_insert(s, v);
-                }
+                // Make it a decision candidate again
+                order_push(s, v);
             }
         }
         s->trail_size = write_pos;
         s->qhead = write_pos;
+        s->bin_qhead = write_pos;
         s->decision_level = 0;
+        if (s->gauss) gauss_backtrack(s, true);
     } else {
         // Normal backtrack to level > 0
-        uint32_t trail_pos = s->trail_lims[level];
+        // trail_lims[l] is where level l starts, so keep everything below level + 1
+        uint32_t trail_pos = s->trail_lims[level + 1];
 
         // Undo assignments from levels > target
         for (uint32_t i = trail_pos; i < s->trail_size; i++) {
             Var v = var(s->trail[i].lit);
-            s->vars[v].value = UNDEF;
-            s->vars[v].level = INVALID_LEVEL;
-            s->vars[v].reason = INVALID_CLAUSE;
+            unassign_var(s, v);
+            s->levels[v] = INVALID_LEVEL;
+            s->reasons[v] = INVALID_CLAUSE;
             s->binary_reasons[v] = LIT_UNDEF;  // Clear binary reason
 
-            // Re-insert into decision heap
-            if (s->vars[v].heap_pos == UINT32_MAX) {
-                heap_insert(s, v);
-            }
+            // Make it a decision candidate again
+            order_push(s, v);
         }
 
         s->trail_size = trail_pos;
         s->qhead = trail_pos;
+        s->bin_qhead = trail_pos;
         s->decision_level = level;
+        if (s->gauss) gauss_backtrack(s, false);
     }
 }
 
@@ -660,10 +1047,10 @@ static Level solver_backtrack_chronological(Solver* s, const Lit* learnt, uint32
 
         for (uint32_t i = 0; i < learnt_size; i++) {
             Var v = var(learnt[i]);
-            if (s->vars[v].value == UNDEF) {
+            if (var_value(s, v) == UNDEF) {
                 unassigned++;
                 propagate_lit = learnt[i];
-            } else if (s->vars[v].value == (sign(learnt[i]) ? FALSE : TRUE)) {
+            } else if (lit_value(s, learnt[i]) == TRUE) {
                 // Literal is true - clause is satisfied, no need to propagate
                 unassigned = 0;
                 break;
@@ -687,20 +1074,132 @@ static Level solver_backtrack_chronological(Solver* s, const Lit* learnt, uint32
  * Clause Addition
  *********************************************************************/
 
+// Append a clause reference to the original clause list (binary clauses
+// get an INVALID_CLAUSE slot, so all clauses are counted and every slot
+// is initialized). Also used by elim.c and subsume.c. Returns false if
+// memory ran out.
+bool clauses_push(Solver* s, CRef cref) {
+    if (s->num_clauses >= s->num_original) {
+        uint32_t new_cap = s->num_original ? s->num_original * 2 : 1024;
+        CRef* new_clauses = (CRef*)realloc(s->clauses, new_cap * sizeof(CRef));
+        if (!new_clauses) return false;
+        s->clauses = new_clauses;
+        s->num_original = new_cap;
+    }
+    s->clauses[s->num_clauses++] = cref;
+    return true;
+}
+
+// Append a clause reference to the learned clause list (grows geometrically)
+static void learnts_push(Solver* s, CRef cref) {
+    if (s->num_learnts >= s->learnts_size) {
+        uint32_t new_size = s->learnts_size ? s->learnts_size * 2 : 1024;
+        CRef* new_learnts = (CRef*)realloc(s->learnts, new_size * sizeof(CRef));
+        if (new_learnts) {
+            s->learnts = new_learnts;
+            s->learnts_size = new_size;
+        }
+    }
+    if (s->num_learnts < s->learnts_size) {
+        s->learnts[s->num_learnts++] = cref;
+    }
+}
+
+// Simplify a clause against the level-0 assignment before adding it.
+// Drops duplicate and level-0 false literals. Returns false if the clause
+// is a tautology or already satisfied (nothing to add); otherwise *out
+// is either lits itself or a malloc'd copy the caller frees.
+static bool simplify_new_clause(Solver* s, const Lit* lits, uint32_t* size, Lit** out) {
+    *out = (Lit*)lits;
+    bool keep = true;
+    bool changed = false;
+
+    // seen[] is idle outside conflict analysis: bit 1 = positive, bit 2 = negative
+    uint32_t i;
+    for (i = 0; i < *size && keep; i++) {
+        Var v = var(lits[i]);
+        uint8_t bit = sign(lits[i]) ? 2 : 1;
+
+        if (var_value(s, v) != UNDEF && s->levels[v] == 0) {
+            if (lit_value(s, lits[i]) == TRUE) keep = false;  // Satisfied
+            changed = true;
+        } else if (s->seen[v] & bit) {
+            changed = true;                   // Duplicate
+        } else if (s->seen[v] & (3 - bit)) {
+            keep = false;                     // Tautology
+        }
+        s->seen[v] |= bit;
+    }
+    for (uint32_t j = 0; j < i; j++) s->seen[var(lits[j])] = 0;
+
+    if (!keep || !changed) return keep;
+
+    Lit* copy = (Lit*)malloc(*size * sizeof(Lit));
+    if (!copy) return true;  // Add the clause unsimplified
+    uint32_t n = 0;
+    for (i = 0; i < *size; i++) {
+        Var v = var(lits[i]);
+        if (var_value(s, v) != UNDEF && s->levels[v] == 0) continue;
+        if (s->seen[v]) continue;
+        s->seen[v] = 1;
+        copy[n++] = lits[i];
+    }
+    for (i = 0; i < n; i++) s->seen[var(copy[i])] = 0;
+
+    *size = n;
+    *out = copy;
+    return true;
+}
+
+static bool add_clause(Solver* s, const Lit* lits, uint32_t size);
+
+// Bring back the clauses BVE and BCE removed on the variables of lits
+// (see elim_restore) before lits is added or assumed. Returns false if
+// the formula became UNSAT or memory ran out.
+static bool restore_removed(Solver* s, const Lit* lits, uint32_t size) {
+    Lit* restored;
+    uint32_t restored_size;
+    if (!elim_restore(s, lits, size, &restored, &restored_size)) return false;
+
+    bool ok = true;
+    for (uint32_t i = 0; i < restored_size && ok; i += restored[i] + 1) {
+        const Lit* clause = &restored[i + 1];
+        for (uint32_t j = 0; j < restored[i]; j++) order_push(s, var(clause[j]));
+        ok = add_clause(s, clause, restored[i]);
+    }
+    free(restored);
+    return ok;
+}
+
 bool solver_add_clause(Solver* s, const Lit* lits, uint32_t size) {
+    if (s->result == FALSE) return false;  // Already UNSAT
+
+    if (s->elim && !restore_removed(s, lits, size)) return false;
+    return add_clause(s, lits, size);
+}
+
+static bool add_clause(Solver* s, const Lit* lits, uint32_t size) {
+    Lit* simplified;
+    if (!simplify_new_clause(s, lits, &size, &simplified)) {
+        return true;  // Tautology or satisfied at level 0
+    }
+    if (simplified != lits) {
+        bool ok = add_clause(s, simplified, size);
+        free(simplified);
+        return ok;
+    }
+
     if (size == 0) {
         s->result = FALSE;  // Empty clause = UNSAT
         return false;
     }
 
-    // TODO: Simplify clause (remove duplicates, check tautology)
-
     // Unit clause - immediately assign
     if (size == 1) {
         Var v = var(lits[0]);
-        if (s->vars[v].value == UNDEF) {
+        if (var_value(s, v) == UNDEF) {
             push_trail(s, lits[0]);
-        } else if (s->vars[v].value == (sign(lits[0]) ? TRUE : FALSE)) {
+        } else if (lit_value(s, lits[0]) == FALSE) {
             s->result = FALSE;  // Conflicting unit clause
             return false;
         }
@@ -716,48 +1215,42 @@ bool solver_add_clause(Solver* s, const Lit* lits, uint32_t size) {
         if (cref == INVALID_CLAUSE) {
             return false;  // Out of memory
         }
+    }
 
-        // Add to clause list
-        if (s->num_clauses >= s->num_original) {
-            uint32_t new_cap = s->num_original ? s->num_original * 2 : 1024;
-            CRef* new_clauses = (CRef*)realloc(s->clauses, new_cap * sizeof(CRef));
-            if (!new_clauses) {
-                arena_delete(s->arena, cref);
-                return false;
-            }
-            s->clauses = new_clauses;
-            s->num_original = new_cap;
-        }
-        s->clauses[s->num_clauses] = cref;
+    if (!clauses_push(s, cref)) {
+        if (cref != INVALID_CLAUSE) arena_delete(s->arena, cref);
+        return false;
     }
 
-    // Count all clauses, including binary ones
-    s->num_clauses++;
+    // Keep the persistent local search formula in sync; without this
+    // clause its models would be unsound, so drop local search instead
+    if (s->local_search.state && !local_search_add_clause(s->local_search.state, lits, size)) {
+        local_search_free(s->local_search.state);
+        s->local_search.state = NULL;
+        s->opts.local_search = false;
+    }
 
     // Add watches - need to find two non-false literals if possible
     if (size == 2) {
         // Binary clause - check if it's already unit or conflicting
-        Var v0 = var(lits[0]);
-        Var v1 = var(lits[1]);
-        lbool val0 = s->vars[v0].value;
-        lbool val1 = s->vars[v1].value;
+        lbool val0 = lit_value(s, lits[0]);
+        lbool val1 = lit_value(s, lits[1]);
 
         // Check for immediate conflict or unit
-        if (val0 == (sign(lits[0]) ? TRUE : FALSE) && val1 == (sign(lits[1]) ? TRUE : FALSE)) {
+        if (val0 == FALSE && val1 == FALSE) {
             // Both literals are false - conflict
             s->result = FALSE;
             return false;
-        } else if (val0 == (sign(lits[0]) ? TRUE : FALSE) && val1 == UNDEF) {
+        } else if (val0 == FALSE && val1 == UNDEF) {
             // First literal false, second unassigned - unit propagate
             push_trail(s, lits[1]);
-        } else if (val1 == (sign(lits[1]) ? TRUE : FALSE) && val0 == UNDEF) {
+        } else if (val1 == FALSE && val0 == UNDEF) {
             // Second literal false, first unassigned - unit propagate
             push_trail(s, lits[0]);
         }
 
-        // Always add watches for binary clauses
-        watch_add(s->watches, lits[0], INVALID_CLAUSE, lits[1]);
-        watch_add(s->watches, lits[1], INVALID_CLAUSE, lits[0]);
+        // Always add the implications for binary clauses
+        watch_add_binary(s->watches, lits[0], lits[1]);
     } else {
         // For larger clauses, find two literals that are not false to watch
         // First, get the clause literals from arena (they may be reordered)
@@ -766,8 +1259,7 @@ bool solver_add_clause(Solver* s, const Lit* lits, uint32_t size) {
         // Find first non-false literal
         uint32_t watch1 = 0;
         for (uint32_t i = 0; i < size; i++) {
-            Var v = var(clause_lits[i]);
-            if (s->vars[v].value != (sign(clause_lits[i]) ? TRUE : FALSE)) {
+            if (lit_value(s, clause_lits[i]) != FALSE) {
                 // This literal is not false
                 if (i != 0) {
                     // Swap it to position 0
@@ -783,8 +1275,7 @@ bool solver_add_clause(Solver* s, const Lit* lits, uint32_t size) {
         // Find second non-false literal
         uint32_t watch2 = 1;
         for (uint32_t i = 1; i < size; i++) {
-            Var v = var(clause_lits[i]);
-            if (s->vars[v].value != (sign(clause_lits[i]) ? TRUE : FALSE)) {
+            if (lit_value(s, clause_lits[i]) != FALSE) {
                 // This literal is not false
                 if (i != 1) {
                     // Swap it to position 1
@@ -806,246 +1297,640 @@ bool solver_add_clause(Solver* s, const Lit* lits, uint32_t size) {
 }
 
 /*********************************************************************
- * Model Access
- *********************************************************************/
-
-lbool solver_model_value(const Solver* s, Var v) {
-    if (v > s->num_vars) return UNDEF;
-    return s->vars[v].value;
-}
-
-/*********************************************************************
- * Statistics
+ * Learned Clause Import
  *********************************************************************/
 
-void solver_print_stats(const Solver* s) {
-    double cpu_time = (double)clock() / CLOCKS_PER_SEC - s->stats.start_time;
+bool solver_import_clause(Solver* s, const Lit* lits, uint32_t size, uint32_t lbd) {
+    ASSERT(s->decision_level == 0);
 
-    printf("c\n");
-    printf("c ========== Statistics ==========\n");
-    printf("c CPU time          : %.3f s\n", cpu_time);
-    printf("c Decisions         : %llu\n", (unsigned long long)s->stats.decisions);
-    printf("c Propagations      : %llu\n", (unsigned long long)s->stats.propagations);
-    printf("c Conflicts         : %llu\n", (unsigned long long)s->stats.conflicts);
-    printf("c Restarts          : %llu\n", (unsigned long long)s->stats.restarts);
-    printf("c Learned clauses   : %llu\n", (unsigned long long)s->stats.learned_clauses);
-    printf("c Learned literals  : %llu\n", (unsigned long long)s->stats.learned_literals);
-    printf("c Deleted clauses   : %llu\n", (unsigned long long)s->stats.deleted_clauses);
-    printf("c Blocked clauses   : %llu\n", (unsigned long long)s->stats.blocked_clauses);
-    printf("c Subsumed clauses  : %llu\n", (unsigned long long)s->stats.subsumed_clauses);
-    printf("c Minimized literals: %llu\n", (unsigned long long)s->stats.minimized_literals);
-    printf("c Glue clauses      : %llu\n", (unsigned long long)s->stats.glue_clauses);
-    printf("c Max LBD           : %llu\n", (unsigned long long)s->stats.max_lbd);
+    // Simplify against the level-0 assignment: drop false literals,
+    // skip the clause entirely if it is already satisfied
+    Lit simplified[size > 0 ? size : 1];
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < size; i++) {
+        Lit lit = lits[i];
+        Var v = var(lit);
+
+        // Ignore clauses over unknown or eliminated variables
+        if (v == 0 || v > s->num_vars) return true;
+        if (s->elim && v < s->elim->elim_capacity && s->elim->eliminated[v]) return true;
+
+        lbool val = lit_value(s, lit);
+        if (val == UNDEF) {
+            simplified[n++] = lit;
+        } else if (val == TRUE) {
+            return true;  // Satisfied at level 0
+        }
+        // else: false at level 0, drop it
+    }
 
-    if (s->stats.decisions > 0) {
-        printf("c Decisions/sec     : %.0f\n", s->stats.decisions / cpu_time);
+    if (n == 0) {
+        // Implied clause is falsified at level 0 = UNSAT
+        s->result = FALSE;
+        return false;
     }
-    if (s->stats.propagations > 0) {
-        printf("c Propagations/sec  : %.0f\n", s->stats.propagations / cpu_time);
+
+    if (n == 1) {
+        // Becomes a level-0 unit; propagated by the next solver_propagate call
+        push_trail(s, simplified[0]);
+        s->reasons[var(simplified[0])] = INVALID_CLAUSE;
+        s->binary_reasons[var(simplified[0])] = LIT_UNDEF;
+        s->share.imported_units++;
+        return true;
     }
-    if (s->stats.conflicts > 0) {
-        printf("c Conflicts/sec     : %.0f\n", s->stats.conflicts / cpu_time);
+
+    if (n == 2) {
+        // Binaries need no arena storage and are never reduced
+        watch_add_binary(s->watches, simplified[0], simplified[1]);
+        return true;
     }
 
-    // Memory statistics
-    ArenaStats astats = arena_stats(s->arena);
-    printf("c Memory used       : %.2f MB\n", astats.used_bytes / (1024.0 * 1024.0));
-    printf("c Memory allocated  : %.2f MB\n", astats.total_bytes / (1024.0 * 1024.0));
-    printf("c Memory peak       : %.2f MB\n", s->arena->peak_size * sizeof(uint32_t) / (1024.0 * 1024.0));
-    printf("c Memory wasted     : %.2f MB\n", astats.wasted_bytes / (1024.0 * 1024.0));
-    printf("c Arena growths     : %u\n", s->arena->num_growths);
+    CRef cref = arena_alloc(s->arena, simplified, n, true);
+    if (cref == INVALID_CLAUSE) return true;  // Out of memory: clause is optional
 
-    printf("c\n");
+    set_clause_lbd(s->arena, cref, lbd < n ? lbd : n);
+    learnts_push(s, cref);
+
+    // Both watched literals are unassigned, so the watches are valid immediately
+    watch_add(s->watches, simplified[0], cref, simplified[1]);
+    watch_add(s->watches, simplified[1], cref, simplified[0]);
+
+    return true;
 }
 
 /*********************************************************************
- * Unit Propagation (Two-Watched Literals)
+ * Model Access
  *********************************************************************/
 
-CRef solver_propagate(Solver* s) {
-    #ifdef DEBUG
-    static uint64_t prop_count = 0;
-    #endif
+lbool solver_model_value(const Solver* s, Var v) {
+    if (v > s->num_vars) return UNDEF;
+    if (s->incremental.model) {
+        return (v < s->incremental.model_size) ? s->incremental.model[v] : UNDEF;
+    }
+    return var_value(s, v);
+}
 
-    while (s->qhead < s->trail_size) {
-        #ifdef DEBUG
-        if (IS_DEBUG(s)) {
-            prop_count++;
-            if (prop_count > 1000) {
-                printf("[ERROR] Infinite propagation loop detected! qhead=%u trail_size=%u\n",
-                       s->qhead, s->trail_size);
-                exit(1);
-            }
+const Lit* solver_conflict(const Solver* s, uint32_t* size) {
+    *size = s->incremental.conflict_size;
+    return s->incremental.conflict;
+}
+
+void solver_set_frozen(Solver* s, Var v, bool frozen) {
+    if (v == 0 || v > s->num_vars) return;
+    s->vars[v].frozen = frozen;
+}
+
+bool solver_is_frozen(const Solver* s, Var v) {
+    if (v == 0 || v > s->num_vars) return false;
+    return s->vars[v].frozen;
+}
+
+/*********************************************************************
+ * Statistics
+ *********************************************************************/
+
+// Inprocessing techniques, by InprocessTechnique
+static const char* const inprocess_names[INPROCESS_TECHNIQUES] = {
+    "probe", "subsume", "vivify", "bce", "elim"
+};
+
+const char* const phase_names[PHASES] = {
+    "preprocess", "propagate", "analyze", "minimize", "backtrack", "decide",
+    "restart", "reduce", "gc", "inprocess", "local_search"
+};
+
+const char* const histogram_names[HISTOGRAMS] = {
+    "lbd", "learnt_size", "trail", "jump"
+};
+
+// Variables neither fixed at level 0 nor eliminated
+static uint32_t active_vars(const Solver* s) {
+    uint32_t fixed = s->decision_level > 0 ? s->trail_lims[1] : s->trail_size;
+    uint32_t eliminated = s->elim ? (uint32_t)s->elim->vars_eliminated : 0;
+    return s->num_vars - fixed - eliminated;
+}
+
+// Bytes of the process backed by transparent huge pages (0 if unknown)
+static uint64_t huge_page_bytes(void) {
+    uint64_t kb = 0;
+#ifdef __linux__
+    FILE* in = fopen("/proc/self/smaps_rollup", "r");
+    if (!in) return 0;
+    char line[256];
+    while (fgets(line, sizeof(line), in)) {
+        unsigned long long value;
+        if (sscanf(line, "AnonHugePages: %llu kB", &value) == 1) {
+            kb = value;
+            break;
         }
-        #endif
+    }
+    fclose(in);
+#endif
+    return kb * 1024;
+}
 
-        Lit p = s->trail[s->qhead++].lit;
+// One progress line every opts.report_interval conflicts, with the
+// column header repeated every 20 lines
+static void print_report_line(Solver* s) {
+    double seconds = (double)clock() / CLOCKS_PER_SEC - s->stats.start_time;
+    if (s->stats.reports++ % 20 == 0) {
+        printf("c\n");
+        printf("c  seconds  conflicts  restarts  reduces  learnts  irredundant"
+               "  avg-size  level  trail  Mprops/s  remaining\n");
+        printf("c\n");
+    }
+    double avg_size = s->stats.learned_clauses
+        ? (double)s->stats.learned_literals / s->stats.learned_clauses : 0.0;
+    printf("c %8.2f %10llu %9llu %8llu %8u %12u %9.1f %6u %5.0f%% %9.2f %10u\n",
+           seconds, (unsigned long long)s->stats.conflicts,
+           (unsigned long long)s->stats.restarts, (unsigned long long)s->stats.reduces,
+           s->num_learnts, s->num_clauses, avg_size, s->decision_level,
+           s->num_vars ? 100.0 * s->trail_size / s->num_vars : 0.0,
+           seconds > 0 ? s->stats.propagations / seconds / 1e6 : 0.0, active_vars(s));
+    fflush(stdout);
+}
 
-#ifdef DEBUG
-        if (IS_DEBUG(s)) {
-            printf("[PROPAGATE] qhead=%u trail_size=%u Processing literal %d (var=%u, value=%d)\n",
-                   s->qhead - 1, s->trail_size, toDimacs(p), var(p), s->vars[var(p)].value);
+#ifdef BSAT_PHASES
+// Ticks are calibrated against the wall clock since solver creation
+static double seconds_per_tick(const PhaseStats* p) {
+    uint64_t ticks = phase_ticks() - p->start_ticks;
+    double seconds = phase_wall_seconds() - p->start_seconds;
+    return ticks > 0 ? seconds / ticks : 0.0;
+}
+
+static void print_phase_stats(const Solver* s) {
+    const PhaseStats* p = &s->phases;
+    double scale = seconds_per_tick(p);
+    double wall = phase_wall_seconds() - p->start_seconds;
+
+    printf("c Phase times       : %.3f s wall since creation\n", wall);
+    for (int i = 0; i < PHASES; i++) {
+        if (p->calls[i] == 0) continue;
+        double seconds = p->ticks[i] * scale;
+        printf("c   %-16s: %8.3f s %5.1f%% (%llu calls)\n", phase_names[i], seconds,
+               wall > 0 ? 100.0 * seconds / wall : 0.0, (unsigned long long)p->calls[i]);
+    }
+
+    // Share of each power-of-two bucket, labelled by its lower bound
+    for (int h = 0; h < HISTOGRAMS; h++) {
+        uint64_t total = 0;
+        for (int b = 0; b < HIST_BUCKETS; b++) total += p->hist[h][b];
+        if (total == 0) continue;
+        printf("c Hist %-13s:", histogram_names[h]);
+        for (int b = 0; b < HIST_BUCKETS; b++) {
+            if (p->hist[h][b] == 0) continue;
+            uint64_t low = b ? (uint64_t)1 << (b - 1) : 0;
+            printf(" %llu:%.1f%%", (unsigned long long)low, 100.0 * p->hist[h][b] / total);
         }
+        printf("\n");
+    }
+}
 #endif
 
-        // Get watches for ~p (literals that could become unit)
-        WatchList* ws = watch_list(s->watches, neg(p));
-        Watch* watches = ws->watches;
-        uint32_t i = 0, j = 0;
+// Running totals the mode statistics are differences of
+static ModeStats mode_counters(const Solver* s) {
+    ModeStats now = {
+        .conflicts = s->stats.conflicts,
+        .decisions = s->stats.decisions,
+        .propagations = s->stats.propagations,
+        .ticks = search_ticks(s),
+        .restarts = s->stats.restarts,
+        .time = (double)clock() / CLOCKS_PER_SEC,
+    };
+    return now;
+}
 
-        s->stats.propagations++;
-        s->watches->visits++;
+// Statistics of a mode, including the phase in progress
+static ModeStats mode_stats(const Solver* s, bool stable) {
+    ModeStats total = s->mode.stats[stable];
+    if (s->opts.modes && s->mode.stable == stable) {
+        ModeStats now = mode_counters(s);
+        total.conflicts += now.conflicts - s->mode.start.conflicts;
+        total.decisions += now.decisions - s->mode.start.decisions;
+        total.propagations += now.propagations - s->mode.start.propagations;
+        total.ticks += now.ticks - s->mode.start.ticks;
+        total.restarts += now.restarts - s->mode.start.restarts;
+        total.time += now.time - s->mode.start.time;
+        total.phases++;
+    }
+    return total;
+}
 
-#ifdef DEBUG
-        if (IS_DEBUG(s)) {
-            printf("[PROPAGATE] Checking %u watches for literal %d\n",
-                   ws->size, toDimacs(neg(p)));
+void solver_print_stats(const Solver* s) {
+    double cpu_time = (double)clock() / CLOCKS_PER_SEC - s->stats.start_time;
+
+    printf("c\n");
+    printf("c ========== Statistics ==========\n");
+    printf("c CPU time          : %.3f s\n", cpu_time);
+    printf("c Decisions         : %llu\n", (unsigned long long)s->stats.decisions);
+    printf("c Propagations      : %llu\n", (unsigned long long)s->stats.propagations);
+    printf("c Ticks             : %llu\n", (unsigned long long)s->stats.ticks);
+    printf("c Conflicts         : %llu\n", (unsigned long long)s->stats.conflicts);
+    printf("c Restarts          : %llu\n", (unsigned long long)s->stats.restarts);
+    if (s->stats.reuse_restarts > 0) {
+        printf("c Trail reuse       : %llu restarts, %llu literals kept, %llu propagations avoided\n",
+               (unsigned long long)s->stats.reuse_restarts,
+               (unsigned long long)s->stats.reused_literals,
+               (unsigned long long)s->stats.reused_propagations);
+    }
+    if (s->stats.chrono_backtracks > 0) {
+        printf("c Chrono backtracks : %llu\n", (unsigned long long)s->stats.chrono_backtracks);
+    }
+    printf("c Learned clauses   : %llu\n", (unsigned long long)s->stats.learned_clauses);
+    printf("c Learned literals  : %llu\n", (unsigned long long)s->stats.learned_literals);
+    printf("c Deleted clauses   : %llu\n", (unsigned long long)s->stats.deleted_clauses);
+    printf("c Reduce time       : %.3f s (max %.1f ms)\n",
+           s->stats.reduce_time, s->stats.reduce_max_time * 1e3);
+    printf("c Learned tiers     : %u core, %u tier2, %u local\n",
+           s->stats.tier_core, s->stats.tier_mid, s->stats.tier_local);
+    printf("c Blocked clauses   : %llu\n", (unsigned long long)s->stats.blocked_clauses);
+    printf("c Subsumed clauses  : %llu\n", (unsigned long long)s->stats.subsumed_clauses);
+    if (s->gauss) {
+        printf("c Gauss-Jordan      : %llu propagations, %llu conflicts, %llu pivots\n",
+               (unsigned long long)s->stats.gauss_propagations,
+               (unsigned long long)s->stats.gauss_conflicts,
+               (unsigned long long)s->stats.gauss_pivots);
+    }
+    if (s->opts.modes) {
+        for (int m = 0; m < 2; m++) {
+            ModeStats ms = mode_stats(s, m);
+            printf("c %-18s: %u phases, %llu conflicts, %llu decisions, %llu propagations, %llu ticks, %llu restarts, %.3f s\n",
+                   m ? "Stable mode" : "Focused mode", ms.phases,
+                   (unsigned long long)ms.conflicts, (unsigned long long)ms.decisions,
+                   (unsigned long long)ms.propagations, (unsigned long long)ms.ticks,
+                   (unsigned long long)ms.restarts, ms.time);
         }
+    }
+    if (s->checkpoint.written > 0) {
+        printf("c Checkpoints       : %u written, %.3f s\n", s->checkpoint.written, s->checkpoint.time);
+    }
+    if (s->stats.subsume_rounds > 0) {
+        printf("c Subsumption rounds: %llu, %llu removed, %llu strengthened, %.3f s\n",
+               (unsigned long long)s->stats.subsume_rounds,
+               (unsigned long long)s->stats.subsume_removed,
+               (unsigned long long)s->stats.subsume_strengthened,
+               s->stats.subsume_time);
+    }
+    for (int t = 0; t < INPROCESS_TECHNIQUES; t++) {
+        const InprocessSchedule* sched = &s->inprocess.sched[t];
+        if (sched->rounds == 0) continue;
+        printf("c Inprocess %-8s: %llu rounds, %llu productive, interval %llu ticks, %.3f s\n",
+               inprocess_names[t], (unsigned long long)sched->rounds,
+               (unsigned long long)sched->productive, (unsigned long long)sched->interval,
+               sched->time);
+    }
+    printf("c Minimized literals: %llu\n", (unsigned long long)s->stats.minimized_literals);
+    printf("c Shrunk literals   : %llu\n", (unsigned long long)s->stats.shrunk_literals);
+    printf("c Glue clauses      : %llu\n", (unsigned long long)s->stats.glue_clauses);
+    printf("c Max LBD           : %llu\n", (unsigned long long)s->stats.max_lbd);
+
+    if (s->stats.decisions > 0) {
+        printf("c Decisions/sec     : %.0f\n", s->stats.decisions / cpu_time);
+    }
+    if (s->stats.propagations > 0) {
+        printf("c Propagations/sec  : %.0f\n", s->stats.propagations / cpu_time);
+    }
+    if (s->stats.conflicts > 0) {
+        printf("c Conflicts/sec     : %.0f\n", s->stats.conflicts / cpu_time);
+    }
+
+    // Watch statistics: binary implications vs long-clause watches
+    WatchStats wstats = watch_stats(s->watches);
+    printf("c Binary clauses    : %llu (%llu implications visited)\n",
+           (unsigned long long)wstats.binary_clauses, (unsigned long long)wstats.binary_visits);
+    printf("c Long watches      : %llu (%.1f%% skipped by blocker)\n",
+           (unsigned long long)wstats.long_watches, wstats.skip_rate);
+
+    // Local search statistics
+    if (s->local_search.state) {
+        LocalSearchState* ls = s->local_search.state;
+        printf("c Local search      : %u calls, %u successes (%s)\n",
+               s->local_search.calls, s->local_search.successes,
+               ls->probsat ? "ProbSAT" : "WalkSAT");
+        printf("c LS flips          : %llu (%.0f flips/sec)\n", (unsigned long long)ls->flips,
+               ls->time > 0 ? ls->flips / ls->time : 0.0);
+        printf("c LS added clauses  : %llu\n", (unsigned long long)ls->added_clauses);
+    }
+
+    // Memory statistics
+    ArenaStats astats = arena_stats(s->arena);
+    printf("c Memory used       : %.2f MB\n", astats.used_bytes / (1024.0 * 1024.0));
+    printf("c Memory allocated  : %.2f MB\n", astats.total_bytes / (1024.0 * 1024.0));
+    printf("c Memory peak       : %.2f MB\n", s->arena->peak_size * sizeof(uint32_t) / (1024.0 * 1024.0));
+    printf("c Memory wasted     : %.2f MB\n", astats.wasted_bytes / (1024.0 * 1024.0));
+    printf("c Arena growths     : %u (%s%s)\n", s->arena->num_growths,
+           astats.mapped ? "mapped" : "malloc", astats.huge_pages ? ", huge pages advised" : "");
+    printf("c Watch slab        : %.2f MB (%.2f MB free), %.2f MB in large lists\n",
+           wstats.slab_bytes / (1024.0 * 1024.0), wstats.slab_free_bytes / (1024.0 * 1024.0),
+           wstats.large_bytes / (1024.0 * 1024.0));
+    printf("c Arena collections : %u (%u major), %.3f s (max pause %.1f ms)\n",
+           s->arena->num_collections, s->arena->num_major,
+           s->stats.gc_time, s->stats.gc_max_time * 1e3);
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#ifdef __APPLE__
+        double peak_rss_mb = usage.ru_maxrss / (1024.0 * 1024.0);  // Bytes on macOS
+#else
+        double peak_rss_mb = usage.ru_maxrss / 1024.0;             // Kilobytes on Linux
 #endif
+        printf("c Peak RSS          : %.2f MB (%.2f MB in huge pages)\n", peak_rss_mb,
+               huge_page_bytes() / (1024.0 * 1024.0));
+        printf("c Page faults       : %ld minor, %ld major\n", usage.ru_minflt, usage.ru_majflt);
+    }
 
-        while (i < ws->size) {
-            Watch w = watches[i];
+    // DRAT proof output statistics
+    if (s->proof) {
+        ProofStats pstats = proof_stats(s->proof);
+        printf("c Proof lemmas      : %llu added, %llu deleted\n",
+               (unsigned long long)pstats.added, (unsigned long long)pstats.deleted);
+        printf("c Proof size        : %.2f MB (%s)\n", pstats.bytes / (1024.0 * 1024.0),
+               s->opts.binary_proof ? "binary" : "text");
+        printf("c Proof write time  : %.3f s (%.3f s waiting)\n", pstats.write_time, pstats.wait_time);
+    }
 
-            // Binary clause special case
-            if (is_binary_watch(w)) {
-                Lit q = w.blocker;
-                Var v = var(q);
+    // Portfolio clause sharing statistics
+    if (s->share.exported > 0 || s->share.imported > 0) {
+        printf("c Shared exported   : %llu\n", (unsigned long long)s->share.exported);
+        printf("c Shared imported   : %llu (%llu units)\n",
+               (unsigned long long)s->share.imported,
+               (unsigned long long)s->share.imported_units);
+    }
 
-#ifdef DEBUG
-                if (IS_DEBUG(s)) {
-                    printf("[PROPAGATE] Binary clause: literal %d, other lit %d, var %u value=%d\n",
-                           toDimacs(neg(p)), toDimacs(q), v, s->vars[v].value);
-                }
+#ifdef BSAT_PHASES
+    print_phase_stats(s);
+#endif
+
+    printf("c\n");
+}
+
+void solver_write_stats_json(const Solver* s, FILE* out) {
+    double cpu_time = (double)clock() / CLOCKS_PER_SEC - s->stats.start_time;
+    ArenaStats astats = arena_stats(s->arena);
+    ModeStats focused = mode_stats(s, false);
+    ModeStats stable = mode_stats(s, true);
+    WatchStats wstats = watch_stats(s->watches);
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) memset(&usage, 0, sizeof(usage));
+
+    fprintf(out, "{\n");
+    fprintf(out, "  \"cpu_time\": %.6f,\n", cpu_time);
+    fprintf(out, "  \"variables\": %u,\n", s->num_vars);
+    fprintf(out, "  \"clauses\": %u,\n", s->num_clauses);
+    fprintf(out, "  \"active_variables\": %u,\n", active_vars(s));
+
+    const struct { const char* name; uint64_t value; } counters[] = {
+        { "decisions",            s->stats.decisions },
+        { "propagations",         s->stats.propagations },
+        { "ticks",                s->stats.ticks },
+        { "conflicts",            s->stats.conflicts },
+        { "restarts",             s->stats.restarts },
+        { "reuse_restarts",       s->stats.reuse_restarts },
+        { "chrono_backtracks",    s->stats.chrono_backtracks },
+        { "reduces",              s->stats.reduces },
+        { "learned_clauses",      s->stats.learned_clauses },
+        { "learned_literals",     s->stats.learned_literals },
+        { "deleted_clauses",      s->stats.deleted_clauses },
+        { "minimized_literals",   s->stats.minimized_literals },
+        { "shrunk_literals",      s->stats.shrunk_literals },
+        { "glue_clauses",         s->stats.glue_clauses },
+        { "max_lbd",              s->stats.max_lbd },
+        { "subsumed_clauses",     s->stats.subsumed_clauses },
+        { "subsume_removed",      s->stats.subsume_removed },
+        { "subsume_strengthened", s->stats.subsume_strengthened },
+        { "blocked_clauses",      s->stats.blocked_clauses },
+        { "gauss_propagations",   s->stats.gauss_propagations },
+        { "gauss_conflicts",      s->stats.gauss_conflicts },
+        { "gauss_pivots",         s->stats.gauss_pivots },
+        { "focused_phases",       focused.phases },
+        { "focused_conflicts",    focused.conflicts },
+        { "focused_propagations", focused.propagations },
+        { "focused_ticks",        focused.ticks },
+        { "stable_phases",        stable.phases },
+        { "stable_conflicts",     stable.conflicts },
+        { "stable_propagations",  stable.propagations },
+        { "stable_ticks",         stable.ticks },
+        { "checkpoints",          s->checkpoint.written },
+        { "arena_collections",    s->arena->num_collections },
+        { "arena_growths",        s->arena->num_growths },
+        { "arena_used_bytes",     astats.used_bytes },
+        { "arena_peak_bytes",     s->arena->peak_size * sizeof(uint32_t) },
+        { "arena_mapped",         astats.mapped },
+        { "watch_slab_bytes",     wstats.slab_bytes },
+        { "huge_page_bytes",      huge_page_bytes() },
+        { "minor_page_faults",    (uint64_t)usage.ru_minflt },
+        { "major_page_faults",    (uint64_t)usage.ru_majflt },
+    };
+    fprintf(out, "  \"counters\": {\n");
+    int num_counters = (int)(sizeof(counters) / sizeof(counters[0]));
+    for (int i = 0; i < num_counters; i++) {
+        fprintf(out, "    \"%s\": %llu%s\n", counters[i].name,
+                (unsigned long long)counters[i].value, i + 1 < num_counters ? "," : "");
+    }
+    fprintf(out, "  },\n");
+
+    // Seconds measured by the always-on timers
+    fprintf(out, "  \"times\": {\n");
+    fprintf(out, "    \"reduce\": %.6f,\n", s->stats.reduce_time);
+    fprintf(out, "    \"gc\": %.6f,\n", s->stats.gc_time);
+    fprintf(out, "    \"checkpoint\": %.6f,\n", s->checkpoint.time);
+    fprintf(out, "    \"subsume\": %.6f", s->stats.subsume_time);
+    for (int t = 0; t < INPROCESS_TECHNIQUES; t++) {
+        fprintf(out, ",\n    \"inprocess_%s\": %.6f", inprocess_names[t], s->inprocess.sched[t].time);
+    }
+    fprintf(out, "\n  },\n");
+
+#ifdef BSAT_PHASES
+    const PhaseStats* p = &s->phases;
+    double scale = seconds_per_tick(p);
+    fprintf(out, "  \"wall_time\": %.6f,\n", phase_wall_seconds() - p->start_seconds);
+    fprintf(out, "  \"phases\": {\n");
+    for (int i = 0; i < PHASES; i++) {
+        fprintf(out, "    \"%s\": {\"seconds\": %.6f, \"calls\": %llu}%s\n",
+                phase_names[i], p->ticks[i] * scale, (unsigned long long)p->calls[i],
+                i + 1 < PHASES ? "," : "");
+    }
+    fprintf(out, "  },\n");
+
+    // Bucket 0 counts zeros, bucket b > 0 values in [2^(b-1), 2^b)
+    fprintf(out, "  \"histograms\": {\n");
+    for (int h = 0; h < HISTOGRAMS; h++) {
+        int last = HIST_BUCKETS - 1;
+        while (last > 0 && p->hist[h][last] == 0) last--;
+        fprintf(out, "    \"%s\": [", histogram_names[h]);
+        for (int b = 0; b <= last; b++) {
+            fprintf(out, "%s%llu", b ? ", " : "", (unsigned long long)p->hist[h][b]);
+        }
+        fprintf(out, "]%s\n", h + 1 < HISTOGRAMS ? "," : "");
+    }
+    fprintf(out, "  }\n");
+#else
+    fprintf(out, "  \"phases\": null,\n");
+    fprintf(out, "  \"histograms\": null\n");
 #endif
+    fprintf(out, "}\n");
+}
+
+/*********************************************************************
+ * Unit Propagation (Two-Watched Literals)
+ *********************************************************************/
+
+static inline CRef propagate_clauses(Solver* s) {
+    #ifdef DEBUG
+    uint64_t prop_count = 0;
+    #endif
 
-                if (s->vars[v].value == UNDEF) {
-                    // Unit propagation via binary clause
-                    s->vars[v].value = sign(q) ? FALSE : TRUE;
-                    s->vars[v].level = s->decision_level;
-                    s->vars[v].reason = INVALID_CLAUSE;  // Binary clause marker
-                    s->vars[v].trail_pos = s->trail_size;
+    while (s->qhead < s->trail_size) {
+        // Binary implications of every pending literal come first: they
+        // need no clause access and often find the conflict before any
+        // long clause is touched
+        while (s->bin_qhead < s->trail_size) {
+            Lit false_lit = neg(s->trail[s->bin_qhead++].lit);
+            BinList* bl = bin_list(s->watches, false_lit);
+            const Lit* others = bl->lits;
+            uint32_t count = bl->size;
+            s->watches->binary_visits += count;
+            s->stats.ticks += 1 + cache_lines(count * sizeof(Lit));
+
+            for (uint32_t k = 0; k < count; k++) {
+                Lit q = others[k];
+                Var v = var(q);
 
-                    // Store the other literal for conflict analysis
-                    // Binary clause is (neg(p) | q), so neg(p) is the "reason" for q
-                    s->binary_reasons[v] = neg(p);
+                if (lit_value(s, q) == UNDEF) {
+                    // Binary clause (false_lit | q): q is implied
+                    assign_lit(s, q);
+                    s->levels[v] = s->decision_level;
+                    s->reasons[v] = INVALID_CLAUSE;  // Binary clause marker
+                    s->trail_pos[v] = s->trail_size;
+                    s->binary_reasons[v] = false_lit;
 
                     s->trail[s->trail_size].lit = q;
                     s->trail[s->trail_size].level = s->decision_level;
                     s->trail_size++;
 
-#ifdef DEBUG
-                    if (IS_DEBUG(s)) {
-                        printf("[PROPAGATE] Binary unit: propagated %d (var %u = %s)\n",
-                               toDimacs(q), v, sign(q) ? "false" : "true");
-                    }
-#endif
-
                     if (s->opts.phase_saving) {
                         s->vars[v].polarity = !sign(q);
                     }
-                } else if (s->vars[v].value == (sign(q) ? TRUE : FALSE)) {
-                    // Conflict in binary clause: (neg(p) | q) with both literals false
+                } else if (lit_value(s, q) == FALSE) {
+                    // Both literals false
 #ifdef DEBUG
                     if (IS_DEBUG(s)) {
                         printf("[PROPAGATE] Binary conflict! %d and %d are both false\n",
-                               toDimacs(neg(p)), toDimacs(q));
+                               toDimacs(false_lit), toDimacs(q));
                     }
 #endif
-                    // Store the conflicting literals for conflict analysis
-                    s->binary_conflict_lits[0] = neg(p);  // The watched literal (false)
-                    s->binary_conflict_lits[1] = q;       // The other literal (false)
-
-                    // Put watches back
-                    while (i < ws->size) {
-                        watches[j++] = watches[i++];
-                    }
-                    ws->size = j;
-                    return BINARY_CONFLICT;  // Signal binary conflict
+                    s->binary_conflict_lits[0] = false_lit;
+                    s->binary_conflict_lits[1] = q;
+                    return BINARY_CONFLICT;
                 }
+            }
+        }
 
-                watches[j++] = w;
-                i++;
-                continue;
+        #ifdef DEBUG
+        if (IS_DEBUG(s)) {
+            prop_count++;
+            if (prop_count > s->num_vars) {
+                printf("[ERROR] Infinite propagation loop detected! qhead=%u trail_size=%u\n",
+                       s->qhead, s->trail_size);
+                exit(1);
             }
+        }
+        #endif
 
-            // Non-binary clause
-            CRef cref = w.cref;
-            Lit blocker = w.blocker;
+        Lit p = s->trail[s->qhead++].lit;
 
-            // Check if clause was deleted (e.g., by BVE preprocessing)
-            if (clause_deleted(s->arena, cref)) {
-                // Skip deleted clause - don't copy to output
-                i++;
-                continue;
+#ifdef DEBUG
+        if (IS_DEBUG(s)) {
+            printf("[PROPAGATE] qhead=%u trail_size=%u Processing literal %d (var=%u, value=%d)\n",
+                   s->qhead - 1, s->trail_size, toDimacs(p), var(p), var_value(s, var(p)));
+        }
+#endif
+
+        // Get watches for ~p (literals that could become unit). New
+        // watches always go to a non-false literal, never to this list,
+        // so its array and size stay put for the whole scan.
+        Lit false_lit = neg(p);
+        WatchList* ws = watch_list(s->watches, false_lit);
+        Watch* watches = ws->watches;
+        const uint32_t end = ws->size;
+        const uint32_t* memory = s->arena->memory;
+        uint32_t i = 0, j = 0;
+        uint32_t touched = 0;  // Clauses whose memory was read
+
+        s->stats.propagations++;
+        s->stats.ticks += 1 + cache_lines(end * sizeof(Watch));
+
+#ifdef DEBUG
+        if (IS_DEBUG(s)) {
+            printf("[PROPAGATE] Checking %u watches for literal %d\n",
+                   end, toDimacs(false_lit));
+        }
+#endif
+
+        while (i < end) {
+            Watch w = watches[i++];
+
+            // Start loading the clause a few watches ahead while this one
+            // is processed. Testing its blocker first costs more than the
+            // occasional useless prefetch.
+            if (PROPAGATE_PREFETCH > 0 && i + PROPAGATE_PREFETCH <= end) {
+                __builtin_prefetch(&memory[watches[i + PROPAGATE_PREFETCH - 1].cref]);
             }
 
-            // Check blocker first
-            Var bv = var(blocker);
-            if (s->vars[bv].value == (sign(blocker) ? FALSE : TRUE)) {
-                // Blocker is satisfied - keep watching
+            // Check blocker first: a satisfied blocker skips the clause
+            // without touching its memory
+            if (lit_value(s, w.blocker) == TRUE) {
                 watches[j++] = w;
-                i++;
-                s->watches->skipped++;
                 continue;
             }
 
-            // Need to examine clause
-            uint32_t size = CLAUSE_SIZE(s->arena, cref);
+            // Need to examine clause. Watches of deleted clauses are
+            // dropped here or by the next collection; the flag shares
+            // the header word with the size, so the check costs no load.
+            CRef cref = w.cref;
+            const ClauseHeader* header = CLAUSE_HEADER(s->arena, cref);
+            touched++;
+            if (__builtin_expect(header->flags & CLAUSE_DELETED, 0)) continue;
+            uint32_t size = header->size;
             Lit* lits = CLAUSE_LITS(s->arena, cref);
 
             // Ensure watched literals are in first two positions
-            if (lits[0] == neg(p)) {
-                lits[0] = lits[1];
-                lits[1] = neg(p);
-            }
-            ASSERT(lits[1] == neg(p));
-
-            // Look for new watch
             Lit first = lits[0];
-            Var fv = var(first);
+            if (first == false_lit) {
+                first = lits[1];
+                lits[0] = first;
+                lits[1] = false_lit;
+            }
+            ASSERT(lits[1] == false_lit);
 
             // If first literal is true, clause is satisfied
-            if (s->vars[fv].value == (sign(first) ? FALSE : TRUE)) {
+            lbool first_val = lit_value(s, first);
+            if (first_val == TRUE) {
                 watches[j++] = (Watch){cref, first};
-                i++;
                 continue;
             }
 
             // Look for another literal to watch
-            bool found = false;
-            for (uint32_t k = 2; k < size; k++) {
+            uint32_t k = 2;
+            while (k < size && lit_value(s, lits[k]) == FALSE) k++;
+            if (k < size) {
+                // Found a non-false literal: move the watch there
                 Lit lit = lits[k];
-                Var v = var(lit);
-
-                if (s->vars[v].value != (sign(lit) ? TRUE : FALSE)) {
-                    // Found a non-false literal
-                    lits[1] = lit;
-                    lits[k] = neg(p);
-
-                    // Add new watch
-                    watch_add(s->watches, lit, cref, first);
-                    found = true;
-                    break;
-                }
-            }
-
-            if (found) {
-                // Don't keep old watch
-                i++;
+                lits[1] = lit;
+                lits[k] = false_lit;
+                watch_add(s->watches, lit, cref, first);
                 continue;
             }
 
             // Clause is unit or conflicting
-            watches[j++] = w;
-            i++;
+            watches[j++] = (Watch){cref, first};
 
-            // Check if unit or conflict
-            if (s->vars[fv].value == UNDEF) {
+            if (first_val == UNDEF) {
                 // Unit clause - propagate
-                s->vars[fv].value = sign(first) ? FALSE : TRUE;
-                s->vars[fv].level = s->decision_level;
-                s->vars[fv].reason = cref;
-                s->vars[fv].trail_pos = s->trail_size;
+                Var fv = var(first);
+                assign_lit(s, first);
+                s->levels[fv] = s->decision_level;
+                s->reasons[fv] = cref;
+                s->trail_pos[fv] = s->trail_size;
 
                 s->trail[s->trail_size].lit = first;
                 s->trail[s->trail_size].level = s->decision_level;
@@ -1057,7 +1942,10 @@ CRef solver_propagate(Solver* s) {
             } else {
                 // Conflict!
                 // Put remaining watches back
-                while (i < ws->size) {
+                s->watches->visits += i;
+                s->watches->skipped += i - touched;
+                s->stats.ticks += touched;
+                while (i < end) {
                     watches[j++] = watches[i++];
                 }
                 ws->size = j;
@@ -1067,40 +1955,50 @@ CRef solver_propagate(Solver* s) {
         }
 
         ws->size = j;
+        s->watches->visits += end;
+        s->watches->skipped += end - touched;
+        s->stats.ticks += touched;
     }
 
     return INVALID_CLAUSE;  // No conflict
 }
 
+// Clauses first, then the XOR matrices on what they assigned, until
+// neither adds a literal
+CRef solver_propagate(Solver* s) {
+    CRef conflict = propagate_clauses(s);
+    if (!s->gauss) return conflict;
+
+    while (conflict == INVALID_CLAUSE) {
+        conflict = gauss_propagate(s);
+        if (conflict != INVALID_CLAUSE || s->qhead == s->trail_size) break;
+        conflict = propagate_clauses(s);
+    }
+    return conflict;
+}
+
 /*********************************************************************
  * Conflict Analysis (First UIP)
  *********************************************************************/
 
-static uint32_t calc_lbd(Solver* s, const Lit* lits, uint32_t size) {
-    // O(n) LBD calculation using seen array as level bitset
-    // The seen array is sized for num_vars, and decision level <= num_vars,
-    // so we can safely use it indexed by level. Clear after use.
-    uint32_t lbd = 0;
-
-    // Track which levels we've seen
-    for (uint32_t i = 0; i < size; i++) {
-        Level level = s->vars[var(lits[i])].level;
-        if (level == 0) continue;  // Level 0 doesn't count for LBD
-        if (level < s->var_capacity && !s->seen[level]) {
-            s->seen[level] = 1;
-            lbd++;
-        }
-    }
-
-    // Clear the seen flags for levels we marked
-    for (uint32_t i = 0; i < size; i++) {
-        Level level = s->vars[var(lits[i])].level;
-        if (level != 0 && level < s->var_capacity) {
-            s->seen[level] = 0;
+// A learned clause took part in conflict analysis: it survives the next
+// reduction (tier 2 the next two), and its activity orders local clauses
+// of equal LBD
+static void bump_learnt(Solver* s, CRef cref) {
+    ClauseHeader* header = CLAUSE_HEADER(s->arena, cref);
+    if (!(header->flags & CLAUSE_LEARNED)) return;
+
+    header->used = header->lbd <= s->opts.tier2_lbd ? 2 : 1;
+    float* activity = CLAUSE_ACTIVITY(s->arena, cref);
+    *activity += (float)s->db.clause_inc;
+    if (*activity > 1e20f) {
+        // Rescale to stay within float range
+        for (uint32_t i = 0; i < s->num_learnts; i++) {
+            if (!clause_learned(s->arena, s->learnts[i])) continue;
+            *CLAUSE_ACTIVITY(s->arena, s->learnts[i]) *= 1e-20f;
         }
+        s->db.clause_inc *= 1e-20;
     }
-
-    return lbd;
 }
 
 void solver_analyze(Solver* s, CRef conflict, Lit* learnt, uint32_t* learnt_size, Level* bt_level) {
@@ -1116,20 +2014,21 @@ void solver_analyze(Solver* s, CRef conflict, Lit* learnt, uint32_t* learnt_size
     if (conflict == BINARY_CONFLICT) {
         // Binary conflict - use stored conflict literals
         // Both literals in the binary clause are false
+        s->stats.ticks += 2;
         for (int i = 0; i < 2; i++) {
             Lit q = s->binary_conflict_lits[i];
             Var v = var(q);
 
-            if (!s->seen[v] && s->vars[v].level > 0) {
+            if (!s->seen[v] && s->levels[v] > 0) {
                 s->seen[v] = 1;
                 bump_var_activity(s, v, s->order.var_inc);
 
-                if (s->vars[v].level >= s->decision_level) {
+                if (s->levels[v] >= s->decision_level) {
                     pathC++;
                 } else {
                     learnt[(*learnt_size)++] = q;
-                    if (s->vars[v].level > *bt_level) {
-                        *bt_level = s->vars[v].level;
+                    if (s->levels[v] > *bt_level) {
+                        *bt_level = s->levels[v];
                     }
                 }
             }
@@ -1138,21 +2037,23 @@ void solver_analyze(Solver* s, CRef conflict, Lit* learnt, uint32_t* learnt_size
         // Regular conflict from arena
         uint32_t size = CLAUSE_SIZE(s->arena, conflict);
         Lit* lits = CLAUSE_LITS(s->arena, conflict);
+        bump_learnt(s, conflict);
+        s->stats.ticks += size;
 
         for (uint32_t i = 0; i < size; i++) {
             Lit q = lits[i];
             Var v = var(q);
 
-            if (!s->seen[v] && s->vars[v].level > 0) {
+            if (!s->seen[v] && s->levels[v] > 0) {
                 s->seen[v] = 1;
                 bump_var_activity(s, v, s->order.var_inc);
 
-                if (s->vars[v].level >= s->decision_level) {
+                if (s->levels[v] >= s->decision_level) {
                     pathC++;
                 } else {
                     learnt[(*learnt_size)++] = q;
-                    if (s->vars[v].level > *bt_level) {
-                        *bt_level = s->vars[v].level;
+                    if (s->levels[v] > *bt_level) {
+                        *bt_level = s->levels[v];
                     }
                 }
             }
@@ -1174,7 +2075,7 @@ void solver_analyze(Solver* s, CRef conflict, Lit* learnt, uint32_t* learnt_size
 
         p = s->trail[index].lit;
         Var v = var(p);
-        CRef reason = s->vars[v].reason;
+        CRef reason = s->reasons[v];
 
         s->seen[v] = 0;
         pathC--;
@@ -1185,21 +2086,23 @@ void solver_analyze(Solver* s, CRef conflict, Lit* learnt, uint32_t* learnt_size
                 // Expand reason clause
                 uint32_t size = CLAUSE_SIZE(s->arena, reason);
                 Lit* lits = CLAUSE_LITS(s->arena, reason);
+                bump_learnt(s, reason);
+                s->stats.ticks += size;
 
                 for (uint32_t i = 1; i < size; i++) {  // Skip first (it's p)
                     Lit q = lits[i];
                     Var qv = var(q);
 
-                    if (!s->seen[qv] && s->vars[qv].level > 0) {
+                    if (!s->seen[qv] && s->levels[qv] > 0) {
                         s->seen[qv] = 1;
                         bump_var_activity(s, qv, s->order.var_inc);
 
-                        if (s->vars[qv].level >= s->decision_level) {
+                        if (s->levels[qv] >= s->decision_level) {
                             pathC++;
                         } else {
                             learnt[(*learnt_size)++] = q;
-                            if (s->vars[qv].level > *bt_level) {
-                                *bt_level = s->vars[qv].level;
+                            if (s->levels[qv] > *bt_level) {
+                                *bt_level = s->levels[qv];
                             }
                         }
                     }
@@ -1209,17 +2112,18 @@ void solver_analyze(Solver* s, CRef conflict, Lit* learnt, uint32_t* learnt_size
                 // The binary clause is (binary_reasons[v] | p)
                 Lit q = s->binary_reasons[v];
                 Var qv = var(q);
+                s->stats.ticks += 2;
 
-                if (!s->seen[qv] && s->vars[qv].level > 0) {
+                if (!s->seen[qv] && s->levels[qv] > 0) {
                     s->seen[qv] = 1;
                     bump_var_activity(s, qv, s->order.var_inc);
 
-                    if (s->vars[qv].level >= s->decision_level) {
+                    if (s->levels[qv] >= s->decision_level) {
                         pathC++;
                     } else {
                         learnt[(*learnt_size)++] = q;
-                        if (s->vars[qv].level > *bt_level) {
-                            *bt_level = s->vars[qv].level;
+                        if (s->levels[qv] > *bt_level) {
+                            *bt_level = s->levels[qv];
                         }
                     }
                 }
@@ -1233,6 +2137,8 @@ void solver_analyze(Solver* s, CRef conflict, Lit* learnt, uint32_t* learnt_size
     // First literal is the asserting literal
     learnt[0] = neg(p);
 
+    if (s->mode.vmtf) vmtf_bump_analyzed(s);
+
     // Clear seen flags
     for (uint32_t i = 0; i < *learnt_size; i++) {
         s->seen[var(learnt[i])] = 0;
@@ -1246,20 +2152,25 @@ void solver_analyze(Solver* s, CRef conflict, Lit* learnt, uint32_t* learnt_size
 bool solver_decide(Solver* s) {
     Var next = INVALID_VAR;
 
-    // Pick unassigned variable with highest activity
-    while (s->order.size > 0) {
-        next = heap_extract_max(s);
-        // Skip assigned variables
-        if (s->vars[next].value != UNDEF) {
-            next = INVALID_VAR;
-            continue;
-        }
-        // Skip eliminated variables (from BVE preprocessing)
-        if (s->elim && s->elim->eliminated[next]) {
-            next = INVALID_VAR;
-            continue;
+    if (s->mode.vmtf) {
+        // Unassigned variable bumped most recently
+        next = vmtf_next(s);
+    } else {
+        // Pick unassigned variable with highest activity
+        while (s->order.size > 0) {
+            next = heap_extract_max(s);
+            // Skip assigned variables
+            if (var_value(s, next) != UNDEF) {
+                next = INVALID_VAR;
+                continue;
+            }
+            // Skip eliminated variables (from BVE preprocessing)
+            if (s->elim && next < s->elim->elim_capacity && s->elim->eliminated[next]) {
+                next = INVALID_VAR;
+                continue;
+            }
+            break;
         }
-        break;
     }
 
     if (next == INVALID_VAR) {
@@ -1276,8 +2187,8 @@ bool solver_decide(Solver* s) {
         sign = !s->vars[next].polarity;
     } else if (s->opts.random_phase) {
         // Random phase with probability
-        if ((rand() / (double)RAND_MAX) < s->opts.random_phase_prob) {
-            sign = rand() & 1;
+        if (rng_double(&s->rng) < s->opts.random_phase_prob) {
+            sign = rng_next(&s->rng) & 1;
         } else {
             // BUG FIX: Default to positive (sign=false) like Python does
             sign = false;
@@ -1292,10 +2203,10 @@ bool solver_decide(Solver* s) {
     s->trail_lims[s->decision_level] = s->trail_size;
 
     Lit dec = mkLit(next, sign);
-    s->vars[next].value = sign ? FALSE : TRUE;
-    s->vars[next].level = s->decision_level;
-    s->vars[next].reason = INVALID_CLAUSE;
-    s->vars[next].trail_pos = s->trail_size;
+    assign_lit(s, mkLit(next, sign));
+    s->levels[next] = s->decision_level;
+    s->reasons[next] = INVALID_CLAUSE;
+    s->trail_pos[next] = s->trail_size;
     s->trail[s->trail_size].lit = dec;
     s->trail[s->trail_size].level = s->decision_level;
     s->trail_size++;
@@ -1357,6 +2268,17 @@ static void solver_rephase(Solver* s) {
  * Local Search Hybridization
  *********************************************************************/
 
+// The first call comes after opts.ls_interval conflicts; later calls
+// are as many search ticks apart as those conflicts took
+static bool local_search_due(Solver* s) {
+    if (s->local_search.interval == 0) {
+        if (++s->local_search.conflicts_since < s->opts.ls_interval) return false;
+        s->local_search.interval = search_ticks(s) > 0 ? search_ticks(s) : 1;
+        return true;
+    }
+    return search_ticks(s) >= s->local_search.next;
+}
+
 /**
  * Try to solve with local search.
  * Returns true if a satisfying assignment was found.
@@ -1398,7 +2320,7 @@ static bool solver_try_local_search(Solver* s) {
                 s->local_search.state->num_unsat);
     }
 
-    s->local_search.conflicts_since = 0;
+    s->local_search.next = search_ticks(s) + s->local_search.interval;
 
     return found;
 }
@@ -1430,9 +2352,18 @@ static uint32_t luby_sequence(uint32_t i) {
  *********************************************************************/
 
 bool solver_should_restart(Solver* s) {
+    // Stable mode: Luby restarts over the conflicts since the last one.
+    // Focused mode uses the Glucose (or geometric) restarts below.
+    if (s->opts.modes && s->mode.stable) {
+        uint64_t threshold = (uint64_t)luby_sequence(s->mode.luby_index + 1) * s->opts.luby_unit;
+        if (s->stats.conflicts - s->mode.last_restart < threshold) return false;
+        s->mode.luby_index++;
+        return true;
+    }
+
     // Luby restart strategy (if enabled)
     // Uses TOTAL conflicts vs cumulative threshold, like Python
-    if (s->opts.luby_restart) {
+    if (s->opts.luby_restart && !s->opts.modes) {
         // Compute the current Luby threshold (uses luby_index which starts at 0)
         uint32_t luby_value = luby_sequence(s->restart.luby_index + 1);
         uint32_t threshold = luby_value * s->opts.luby_unit;
@@ -1529,119 +2460,368 @@ bool solver_should_restart(Solver* s) {
     }
 }
 
-/*********************************************************************
- * Clause Database Reduction
- *********************************************************************/
+// Decision candidate the heuristic would pick next, or INVALID_VAR.
+// Assigned and eliminated variables on top of the heap are dropped, as
+// solver_decide would drop them.
+static Var peek_next_decision(Solver* s) {
+    if (s->mode.vmtf) return vmtf_next(s);
 
-// Helper structure for sorting clauses
-typedef struct {
-    CRef cref;
-    uint32_t lbd;
-    float activity;
-} ClauseScore;
+    while (s->order.size > 0) {
+        Var v = s->order.heap[0];
+        bool eliminated = s->elim && v < s->elim->elim_capacity && s->elim->eliminated[v];
+        if (var_value(s, v) == UNDEF && !eliminated) return v;
+        heap_remove(s, v);
+    }
+    return INVALID_VAR;
+}
 
-// Comparison function for qsort - keep clauses with:
-// 1. Lower LBD (better quality)
-// 2. Higher activity (more recently used)
-static int compare_clauses(const void* a, const void* b) {
-    const ClauseScore* ca = (const ClauseScore*)a;
-    const ClauseScore* cb = (const ClauseScore*)b;
+// Level a restart backtracks to when reusing the trail: levels above base
+// are kept while their decision ranks at least as high as the variable
+// that would be decided next, since the search would make the same
+// decisions and propagations again.
+static Level reuse_trail_level(Solver* s, Level base) {
+    Var next = peek_next_decision(s);
+    if (next == INVALID_VAR) return base;
+
+    Level level = base;
+    while (level < s->decision_level) {
+        Var decision = var(s->trail[s->trail_lims[level + 1]].lit);
+        bool keep = s->mode.vmtf
+            ? s->queue.links[decision].stamp > s->queue.links[next].stamp
+            : s->order.activity[decision] >= s->order.activity[next];
+        if (!keep) break;
+        level++;
+    }
+    return level;
+}
 
-    // First, compare by LBD (lower is better)
-    if (ca->lbd != cb->lbd) {
-        return ca->lbd - cb->lbd;  // Ascending order (keep low LBD)
+// Restart: backtrack to base (the assumption levels), or above it when
+// reuse is allowed and the trail can be reused
+static void solver_restart(Solver* s, Level base, bool reuse) {
+    Level level = base;
+    if (reuse && s->opts.restart_reuse && base < s->decision_level) {
+        level = reuse_trail_level(s, base);
+        if (level > base) {
+            uint32_t from = s->trail_lims[base + 1];
+            uint32_t to = level < s->decision_level ? s->trail_lims[level + 1] : s->trail_size;
+            s->stats.reuse_restarts++;
+            s->stats.reused_literals += to - from;
+            s->stats.reused_propagations += (to - from) - (level - base);
+        }
     }
+    solver_backtrack(s, level);
+    s->stats.restarts++;
+    s->mode.last_restart = s->stats.conflicts;
+}
+
+/*********************************************************************
+ * Search Modes
+ *
+ * With opts.modes the search alternates between a focused mode (VMTF
+ * decisions, Glucose restarts) that finds short proofs quickly and a
+ * stable mode (VSIDS decisions, Luby restarts, target phases) that digs
+ * deeper towards models. Each heuristic keeps its scores while the other
+ * mode runs. The first focused phase lasts opts.mode_interval conflicts;
+ * every later phase gets the search ticks it took, multiplied by
+ * MODE_GROWTH after each stable phase.
+ *********************************************************************/
 
-    // If LBD is equal, compare by activity (higher is better)
-    if (ca->activity > cb->activity) return -1;  // Descending order
-    if (ca->activity < cb->activity) return 1;
-    return 0;
+static bool mode_switch_due(const Solver* s) {
+    if (s->mode.budget == 0) {
+        return s->stats.conflicts - s->mode.start.conflicts >= s->opts.mode_interval;
+    }
+    return search_ticks(s) - s->mode.start.ticks >= s->mode.budget;
 }
 
-void solver_reduce_db(Solver* s) {
-    s->stats.reduces++;
+// End the current phase (after a restart) and start one in the other mode
+static void mode_switch(Solver* s) {
+    bool stable = s->mode.stable;
+    s->mode.stats[stable] = mode_stats(s, stable);
 
-    // Count learned clauses
-    uint32_t num_learned = 0;
-    for (uint32_t i = 0; i < s->num_clauses; i++) {
-        CRef cref = s->clauses[i];
-        if (cref == INVALID_CLAUSE) continue;
-        if (clause_deleted(s->arena, cref)) continue;
-        if (clause_learned(s->arena, cref)) {
-            num_learned++;
-        }
+    uint64_t spent = search_ticks(s) - s->mode.start.ticks;
+    if (s->mode.budget == 0) {
+        s->mode.budget = spent > 0 ? spent : 1;
+    } else if (stable) {
+        s->mode.budget *= MODE_GROWTH;
     }
 
-    // If not too many learned clauses, skip reduction
-    uint32_t max_learned = s->num_clauses / 2 + 1000;  // Allow some learned clauses
-    if (num_learned < max_learned) {
-        return;
+    s->mode.start = mode_counters(s);
+    s->mode.stable = !stable;
+    s->mode.vmtf = stable;
+
+    if (s->mode.stable) {
+        // Variables assigned while VMTF decided left the heap for good
+        for (Var v = 1; v <= s->num_vars; v++) {
+            if (s->order.pos[v] == UINT32_MAX) heap_insert(s, v);
+        }
+    } else {
+        // Unassigned variables were not tracked: search the whole queue
+        s->queue.search = s->queue.last;
     }
 
     if (IS_VERBOSE(s)) {
-        fprintf(stderr, "c [DB Reduce #%llu] Conflicts: %llu, Learned: %u (max: %u)\n",
-                (unsigned long long)s->stats.reduces,
+        fprintf(stderr, "c [Mode] %s at %llu conflicts, budget %llu ticks\n",
+                s->mode.stable ? "stable" : "focused",
                 (unsigned long long)s->stats.conflicts,
-                num_learned, max_learned);
+                (unsigned long long)s->mode.budget);
     }
+}
 
-    // Collect all learned clauses with their scores
-    ClauseScore* scores = (ClauseScore*)malloc(num_learned * sizeof(ClauseScore));
-    if (!scores) return;  // Out of memory, skip reduction
+/*********************************************************************
+ * Clause Database Reduction
+ *********************************************************************/
 
+// A clause is locked while it is the reason of its first literal
+static inline bool clause_locked(const Solver* s, CRef cref) {
+    Lit first = CLAUSE_LITS(s->arena, cref)[0];
+    return s->reasons[var(first)] == cref && lit_value(s, first) == TRUE;
+}
+
+static inline uint32_t lbd_bucket(const Arena* arena, CRef cref) {
+    uint32_t lbd = clause_lbd(arena, cref);
+    return lbd < REDUCE_LBD_BUCKETS ? lbd : REDUCE_LBD_BUCKETS - 1;
+}
+
+// Partial selection (nth_element): afterwards a[0 .. k-1] hold the k
+// least active clauses, in no particular order
+static void select_least_active(const Arena* arena, CRef* a, uint32_t n, uint32_t k) {
+    uint32_t lo = 0, hi = n;
+    while (hi - lo > 1 && k > lo && k < hi) {
+        float pivot = clause_activity(arena, a[lo + (hi - lo) / 2]);
+        uint32_t i = lo, j = hi - 1;
+        while (i <= j) {
+            while (clause_activity(arena, a[i]) < pivot) i++;
+            while (clause_activity(arena, a[j]) > pivot) j--;
+            if (i <= j) {
+                CRef tmp = a[i];
+                a[i] = a[j];
+                a[j] = tmp;
+                i++;
+                if (j == 0) break;
+                j--;
+            }
+        }
+        // a[lo .. j] <= pivot <= a[i .. hi - 1]
+        if (k <= j) {
+            hi = j + 1;
+        } else if (k >= i) {
+            lo = i;
+        } else {
+            break;  // k falls among elements equal to the pivot
+        }
+    }
+}
+
+static void delete_learnt(Solver* s, CRef cref) {
+    if (s->proof) {
+        proof_delete_clause(s, CLAUSE_LITS(s->arena, cref), CLAUSE_SIZE(s->arena, cref));
+    }
+    arena_delete(s->arena, cref);
+}
+
+// Move every clause reference into a compacted arena. Deleted clauses
+// lose their watches and list entries.
+static void collect_garbage(Solver* s) {
+    double start = now_seconds();
+    gauss_release_reasons(s);
+    if (!arena_gc_begin(s->arena)) return;
+    PHASE_START(s, PHASE_GC);
+
+    // Keepers first, in watch order: originals and core learned clauses
+    // rarely die, so they are promoted to the tenured region
+    uint32_t num_lits = 2 * (s->watches->num_vars + 1);
+    for (uint32_t l = 0; l < num_lits; l++) {
+        WatchList* ws = &s->watches->lists[l];
+        for (uint32_t i = 0; i < ws->size; i++) {
+            CRef cref = ws->watches[i].cref;
+            if (cref < s->arena->gc_base) continue;
+            const ClauseHeader* header = CLAUSE_HEADER(s->arena, cref);
+            if (header->flags & (CLAUSE_DELETED | CLAUSE_MOVED)) continue;
+            if (!(header->flags & CLAUSE_LEARNED) || header->lbd <= s->opts.glue_lbd) {
+                arena_gc_move(s->arena, cref);
+            }
+        }
+    }
+    arena_gc_tenure(s->arena);
+
+    // Watch lists (moves the remaining clauses, again in watch order)
+    for (uint32_t l = 0; l < num_lits; l++) {
+        WatchList* ws = &s->watches->lists[l];
+        uint32_t j = 0;
+        for (uint32_t i = 0; i < ws->size; i++) {
+            CRef moved = arena_gc_move(s->arena, ws->watches[i].cref);
+            if (moved == INVALID_CLAUSE) continue;
+            ws->watches[j] = ws->watches[i];
+            ws->watches[j++].cref = moved;
+        }
+        ws->size = j;
+    }
+
+    // Reasons of assigned variables
+    for (uint32_t i = 0; i < s->trail_size; i++) {
+        Var v = var(s->trail[i].lit);
+        s->reasons[v] = arena_gc_move(s->arena, s->reasons[v]);
+    }
+    gauss_move_reasons(s);
+
+    // Clause lists (original binaries keep their INVALID_CLAUSE slots)
     uint32_t j = 0;
     for (uint32_t i = 0; i < s->num_clauses; i++) {
         CRef cref = s->clauses[i];
-        if (cref == INVALID_CLAUSE) continue;
-        if (clause_deleted(s->arena, cref)) continue;
-        if (!clause_learned(s->arena, cref)) continue;
+        if (cref != INVALID_CLAUSE) {
+            cref = arena_gc_move(s->arena, cref);
+            if (cref == INVALID_CLAUSE) continue;
+        }
+        s->clauses[j++] = cref;
+    }
+    s->num_clauses = j;
 
-        scores[j].cref = cref;
-        scores[j].lbd = clause_lbd(s->arena, cref);
-        scores[j].activity = clause_activity(s->arena, cref);
-        j++;
+    j = 0;
+    for (uint32_t i = 0; i < s->num_learnts; i++) {
+        CRef moved = arena_gc_move(s->arena, s->learnts[i]);
+        if (moved != INVALID_CLAUSE) s->learnts[j++] = moved;
+    }
+    s->num_learnts = j;
+
+    // Elimination occurrence lists
+    if (s->elim) {
+        for (uint32_t l = 0; l < s->elim->occs_capacity; l++) {
+            OccList* occ = &s->elim->occs[l];
+            j = 0;
+            for (uint32_t i = 0; i < occ->size; i++) {
+                CRef moved = arena_gc_move(s->arena, occ->occs[i].cref);
+                if (moved == INVALID_CLAUSE) continue;
+                occ->occs[j] = occ->occs[i];
+                occ->occs[j++].cref = moved;
+            }
+            occ->size = j;
+        }
     }
 
-    // Sort by quality (low LBD, high activity)
-    qsort(scores, num_learned, sizeof(ClauseScore), compare_clauses);
+    arena_gc_end(s->arena);
+    PHASE_STOP(s, PHASE_GC);
 
-    // Keep the best half, delete the rest
-    // But ALWAYS keep glue clauses (LBD <= glue_lbd threshold, typically 2)
-    uint32_t to_keep = num_learned / 2;
-    uint32_t deleted = 0;
+    double pause = now_seconds() - start;
+    s->stats.gc_time += pause;
+    if (pause > s->stats.gc_max_time) s->stats.gc_max_time = pause;
+}
 
-    for (uint32_t i = to_keep; i < num_learned; i++) {
-        // Check if this is a glue clause - never delete these
-        if (scores[i].lbd <= s->opts.glue_lbd) {
-            continue;  // Keep glue clauses even if beyond the limit
-        }
+void solver_reduce_db(Solver* s) {
+    s->stats.reduces++;
+    double start = now_seconds();
 
-        // Log deletion to DRAT proof file
-        if (s->proof_file) {
-            CRef cref = scores[i].cref;
-            uint32_t size = CLAUSE_SIZE(s->arena, cref);
-            Lit* lits = CLAUSE_LITS(s->arena, cref);
-            proof_delete_clause(s, lits, size);
+    // Drop entries of clauses deleted elsewhere (e.g. by subsumption)
+    uint32_t num_learned = 0;
+    for (uint32_t i = 0; i < s->num_learnts; i++) {
+        CRef cref = s->learnts[i];
+        if (!clause_deleted(s->arena, cref)) s->learnts[num_learned++] = cref;
+    }
+    s->num_learnts = num_learned;
+
+    // If not too many learned clauses, skip reduction
+    uint32_t max_learned = s->num_clauses / 2 + 1000;  // Allow some learned clauses
+    if (num_learned < max_learned) {
+        return;
+    }
+
+    if (IS_VERBOSE(s)) {
+        fprintf(stderr, "c [DB Reduce #%llu] Conflicts: %llu, Learned: %u (max: %u)\n",
+                (unsigned long long)s->stats.reduces,
+                (unsigned long long)s->stats.conflicts,
+                num_learned, max_learned);
+    }
+
+    if (s->db.cands_size < num_learned) {
+        CRef* cands = (CRef*)realloc(s->db.cands, num_learned * sizeof(CRef));
+        if (!cands) return;  // Out of memory, skip reduction
+        s->db.cands = cands;
+        s->db.cands_size = num_learned;
+    }
+
+    // Tiers: core (LBD <= glue_lbd) is kept forever, tier 2 (LBD <=
+    // tier2_lbd) for two rounds after its last use, local clauses only
+    // for one. Reasons are never deleted.
+    uint32_t buckets[REDUCE_LBD_BUCKETS] = {0};
+    uint32_t num_cands = 0;
+    uint32_t core = 0, mid = 0;
+    for (uint32_t i = 0; i < num_learned; i++) {
+        CRef cref = s->learnts[i];
+        ClauseHeader* header = CLAUSE_HEADER(s->arena, cref);
+        bool used = header->used != 0;
+        if (used) header->used--;
+
+        if (header->lbd <= s->opts.glue_lbd) {
+            core++;
+        } else if (header->lbd <= s->opts.tier2_lbd) {
+            mid++;
+            if (!used && !clause_locked(s, cref)) {
+                s->db.cands[num_cands++] = cref;
+                buckets[lbd_bucket(s->arena, cref)]++;
+            }
+        } else if (!used && !clause_locked(s, cref)) {
+            s->db.cands[num_cands++] = cref;
+            buckets[lbd_bucket(s->arena, cref)]++;
         }
+    }
+
+    // Delete the worst candidates: whole LBD buckets from the top, then
+    // the least active clauses of the cutoff bucket
+    uint32_t target = (uint32_t)(num_cands * (1.0 - s->opts.reduce_fraction));
+    uint32_t cutoff = REDUCE_LBD_BUCKETS;
+    uint32_t above = 0;
+    while (cutoff > 0 && above + buckets[cutoff - 1] <= target) {
+        above += buckets[--cutoff];
+    }
 
-        // Delete this clause
-        arena_delete(s->arena, scores[i].cref);
-        deleted++;
+    uint32_t deleted = 0;
+    uint32_t in_cutoff = 0;
+    for (uint32_t i = 0; i < num_cands; i++) {
+        CRef cref = s->db.cands[i];
+        uint32_t bucket = lbd_bucket(s->arena, cref);
+        if (bucket >= cutoff) {
+            delete_learnt(s, cref);
+            deleted++;
+        } else if (cutoff > 0 && bucket == cutoff - 1) {
+            s->db.cands[in_cutoff++] = cref;
+        }
+    }
+    uint32_t rest = target - above;
+    if (rest > 0 && in_cutoff > 0) {
+        select_least_active(s->arena, s->db.cands, in_cutoff, rest);
+        for (uint32_t i = 0; i < rest && i < in_cutoff; i++) {
+            delete_learnt(s, s->db.cands[i]);
+            deleted++;
+        }
     }
 
-    free(scores);
+    uint32_t kept = 0;
+    for (uint32_t i = 0; i < num_learned; i++) {
+        CRef cref = s->learnts[i];
+        if (!clause_deleted(s->arena, cref)) s->learnts[kept++] = cref;
+    }
+    s->num_learnts = kept;
 
     s->stats.deleted_clauses += deleted;
+    s->stats.tier_core = core;
+    s->stats.tier_mid = mid;
+    s->stats.tier_local = kept - core - mid;
+
+    // Compact right away instead of carrying the holes
+    if (arena_gc_due(s->arena)) {
+        collect_garbage(s);
+    }
+
+    double elapsed = now_seconds() - start;
+    s->stats.reduce_time += elapsed;
+    if (elapsed > s->stats.reduce_max_time) s->stats.reduce_max_time = elapsed;
 
     if (IS_VERBOSE(s)) {
-        fprintf(stderr, "c [DB Reduce #%llu] Deleted: %u, Kept: %u, Total deletions: %llu\n",
+        fprintf(stderr, "c [DB Reduce #%llu] Deleted: %u, Kept: %u (core %u, tier2 %u), "
+                "Total deletions: %llu, %.2f ms\n",
                 (unsigned long long)s->stats.reduces,
-                deleted, num_learned - deleted,
-                (unsigned long long)s->stats.deleted_clauses);
+                deleted, kept, core, mid,
+                (unsigned long long)s->stats.deleted_clauses, elapsed * 1e3);
     }
-
-    // Optionally trigger garbage collection if many deletions
-    // For now, let arena GC happen naturally when space is needed
 }
 
 /*********************************************************************
@@ -1708,14 +2888,14 @@ static void solver_on_the_fly_subsumption(Solver* s, const Lit* learnt, uint32_t
             bool is_reason = false;
             for (uint32_t j = 0; j < other_size && !is_reason; j++) {
                 Var v = var(other_lits[j]);
-                if (s->vars[v].value != UNDEF && s->vars[v].reason == cref) {
+                if (var_value(s, v) != UNDEF && s->reasons[v] == cref) {
                     is_reason = true;
                 }
             }
 
             if (!is_reason) {
                 // Log deletion to DRAT proof file BEFORE deleting
-                if (s->proof_file) {
+                if (s->proof) {
                     proof_delete_clause(s, other_lits, other_size);
                 }
 
@@ -1732,204 +2912,263 @@ static void solver_on_the_fly_subsumption(Solver* s, const Lit* learnt, uint32_t
 }
 
 /*********************************************************************
- * Clause Minimization (Recursive Literal Removal)
- *********************************************************************/
-
-/*********************************************************************
- * MiniSat-style Clause Minimization
+ * Clause Minimization and Shrinking
  *
- * Removes redundant literals from learned clauses using two techniques:
- * 1. Self-subsuming resolution: literal can be removed if all literals
- *    in its reason clause are in the learned clause or at level 0
- * 2. Recursive minimization: extends above by recursively checking reasons
+ * Minimization removes the literals of a learned clause that are
+ * implied by its other literals (MiniSat's recursive check). Verdicts
+ * are cached in seen[] for the whole conflict, as in Van Gelder's
+ * scheme: a variable is marked removable once every path from it back
+ * to the decisions runs into the clause, and poisoned once one path
+ * escapes it, so no part of the implication graph is searched twice.
+ * Exact per-level stamps replace MiniSat's abstract level bitmask.
  *
- * Uses abstract level bitmask for quick pruning: if a literal's reason
- * contains literals at levels not in the learned clause, it can't be redundant.
+ * Shrinking (CaDiCaL) then replaces all literals of a decision level
+ * by the single literal of that level they were all implied through,
+ * as long as everything in between only depends on that level and on
+ * literals the clause implies.
  *********************************************************************/
 
-// Compute abstract level bitmask (for quick pruning)
-static inline uint64_t abstract_level(Level level) {
-    return (uint64_t)1 << (level & 63);
+// seen[] marks during minimization and shrinking
+enum {
+    SEEN_CLAUSE    = 1,   // In the learned clause
+    SEEN_REMOVABLE = 2,   // Implied by the clause
+    SEEN_POISON    = 4,   // Not implied by the clause
+    SEEN_VISITING  = 8,   // On the redundancy check stack
+    SEEN_SHRINK    = 16,  // Implies a clause literal of its level
+};
+
+static inline void minimize_mark(Solver* s, Var v, uint8_t mark) {
+    if (!s->seen[v]) s->analyze_toclear[s->num_toclear++] = v;
+    s->seen[v] |= mark;
 }
 
-// Check if literal is redundant using recursive deep analysis
-// abstract_levels: bitmask of levels present in learned clause
-// Uses seen array: 0=unseen, 1=in learned clause, 2=exploring
-//
-// Returns true if literal p can be proven redundant (its reason chain
-// terminates at literals in the learned clause or level 0).
-static bool lit_redundant(Solver* s, Lit p, uint64_t abstract_levels) {
-    Var v = var(p);
-
-    // Check seen status
-    uint8_t seen_val = s->seen[v];
-    if (seen_val == 1) {
-        return true;   // In learned clause - definitely covered
-    }
-    if (seen_val == 2) {
-        return false;  // Cycle - being explored
-    }
-
-    // Check for reason clause
-    CRef reason = s->vars[v].reason;
-
-    // Skip binary conflict markers
-    if (reason == BINARY_CONFLICT) {
-        return false;
-    }
-
-    // Quick abstract level check: if this level isn't in abstract_levels,
-    // we need to keep this literal (it's at a level not covered)
-    Level level = s->vars[v].level;
-    if (level > 0 && !(abstract_levels & abstract_level(level))) {
-        return false;
-    }
-
-    // Handle binary propagation or decision
+// Reason literals of an implied variable, NULL for decisions. Binary
+// reasons are the other literal only.
+static inline const Lit* reason_lits(const Solver* s, Var v, uint32_t* size) {
+    CRef reason = s->reasons[v];
     if (reason == INVALID_CLAUSE) {
-        // Both decision variables and binary propagations are never redundant.
-        // Binary propagations store their reason in binary_reasons[], but we
-        // conservatively treat them as non-redundant to avoid complexity.
-        return false;
+        if (s->binary_reasons[v] == LIT_UNDEF) return NULL;
+        *size = 1;
+        return &s->binary_reasons[v];
     }
+    if (reason == BINARY_CONFLICT) return NULL;
+    *size = CLAUSE_SIZE(s->arena, reason);
+    return CLAUSE_LITS(s->arena, reason);
+}
 
-    // Mark as being explored (cycle detection)
-    // Save original value to restore on failure
-    uint8_t orig_seen = s->seen[v];
-    s->seen[v] = 2;
-
-    // Check all literals in reason clause (normal clause from arena)
-    uint32_t size = CLAUSE_SIZE(s->arena, reason);
-    Lit* lits = CLAUSE_LITS(s->arena, reason);
-
-    for (uint32_t i = 0; i < size; i++) {
-        Lit q = lits[i];
-        Var qv = var(q);
-
-        // Skip the literal itself (it's the implied literal)
-        if (qv == v) continue;
-
-        // SAFETY CHECK: If a reason literal is at a higher level than the implied
-        // literal, the reason clause is stale (the variable was reassigned after
-        // the original propagation). This can happen during chronological
-        // backtracking when we backtrack partway, reassign some variables, and
-        // then reach another conflict. In this case, return false to keep the
-        // literal in the learned clause.
-        if (s->vars[qv].level > level) {
-            s->seen[v] = orig_seen;
-            return false;
-        }
+// Cheap reasons why v cannot be implied by the clause: it is a
+// decision, no clause literal shares its level, or it comes before
+// every clause literal of its level on the trail (so only the decision
+// of that level, which is not in the clause, can imply it)
+static inline bool minimize_hopeless(const Solver* s, Var v) {
+    const AnalyzeLevel* level = &s->analyze_levels[s->levels[v]];
+    if (level->stamp != s->analyze_stamp || s->trail_pos[v] < level->first) return true;
+    return s->reasons[v] == INVALID_CLAUSE && s->binary_reasons[v] == LIT_UNDEF;
+}
 
-        // Level 0 literals are always satisfied
-        if (s->vars[qv].level == 0) {
+// Is the assigned variable v implied by the clause? Iterative depth-first
+// search over reasons; every variable it settles keeps its verdict.
+static bool lit_redundant(Solver* s, Var v) {
+    uint8_t* seen = s->seen;
+    MinimizeFrame* stack = s->analyze_stack;
+    uint32_t depth = 0;
+
+    minimize_mark(s, v, SEEN_VISITING);
+    stack[depth++] = (MinimizeFrame){ v, 0 };
+
+    while (depth > 0) {
+        MinimizeFrame* frame = &stack[depth - 1];
+        Var u = frame->var;
+        uint32_t size = 0;
+        const Lit* lits = reason_lits(s, u, &size);
+
+        if (frame->next == size) {
+            // Every reason literal is implied, and so is u
+            seen[u] = (uint8_t)((seen[u] & ~SEEN_VISITING) | SEEN_REMOVABLE);
+            depth--;
             continue;
         }
 
-        // Recursively check if this literal is covered
-        if (!lit_redundant(s, q, abstract_levels)) {
-            s->seen[v] = orig_seen;
+        Var q = var(lits[frame->next++]);
+        if (q == u || s->levels[q] == 0) continue;
+        uint8_t mark = seen[q];
+        if (!(mark & SEEN_VISITING) && (mark & (SEEN_CLAUSE | SEEN_REMOVABLE))) continue;
+
+        // A reason literal above u's level belongs to a stale reason
+        // (chronological backtracking reassigned it): keep u
+        bool stale = s->levels[q] > s->levels[u];
+        if (stale || (mark & (SEEN_VISITING | SEEN_POISON)) || minimize_hopeless(s, q)) {
+            if (!stale && !mark) minimize_mark(s, q, SEEN_POISON);
+            // Nothing on the stack is implied either
+            while (depth > 0) {
+                Var w = stack[--depth].var;
+                seen[w] = (uint8_t)((seen[w] & ~SEEN_VISITING) | SEEN_POISON);
+            }
             return false;
         }
-    }
 
-    // All reason literals are covered - restore original value and return true
-    // We don't change the seen value here; the caller manages seen[] for
-    // literals it's considering removing
-    s->seen[v] = orig_seen;
+        minimize_mark(s, q, SEEN_VISITING);
+        stack[depth++] = (MinimizeFrame){ q, 0 };
+    }
     return true;
 }
 
-// Main minimization function - called after conflict analysis
-// learnt[0] is the asserting literal (always kept)
-// Returns number of literals removed
-//
-// Algorithm: For each literal L in the clause, check if all paths from L
-// back to decision variables pass through other literals in the clause.
-// If so, L is redundant and can be removed.
-//
-// Key safety: lit_redundant only treats seen==1 as coverage, preventing
-// circular dependency chains (A depends on B, B depends on A) from causing
-// both to be incorrectly removed.
-static uint32_t solver_minimize_clause(Solver* s, Lit* learnt, uint32_t* learnt_size) {
-    // Skip minimization when DRAT proof logging is enabled.
-    // Minimized clauses are semantically equivalent but may not be RUP-derivable,
-    // which would cause proof verification to fail.
-    if (s->proof_file) {
-        return 0;
+// Walk the trail down from the last clause literal of the level until
+// one literal is left that implies all of them. Returns that (true)
+// trail literal, or LIT_UNDEF if a literal on the way depends on
+// something the clause does not imply.
+static Lit shrink_level(Solver* s, Level level) {
+    const AnalyzeLevel* info = &s->analyze_levels[level];
+    uint8_t* seen = s->seen;
+    uint32_t open = info->count;
+
+    for (uint32_t pos = info->last + 1; pos-- > 0;) {
+        Lit t = s->trail[pos].lit;
+        Var u = var(t);
+        if (!(seen[u] & SEEN_SHRINK) || s->levels[u] != level) continue;
+        if (open == 1) return t;
+        open--;
+
+        uint32_t size;
+        const Lit* lits = reason_lits(s, u, &size);
+        if (!lits) return LIT_UNDEF;
+        for (uint32_t i = 0; i < size; i++) {
+            Var q = var(lits[i]);
+            Level q_level = s->levels[q];
+            if (q == u || q_level == 0) continue;
+            if (q_level == level) {
+                if (!(seen[q] & SEEN_SHRINK)) {
+                    minimize_mark(s, q, SEEN_SHRINK);
+                    open++;
+                }
+                continue;
+            }
+            if (q_level > level) return LIT_UNDEF;
+            uint8_t mark = seen[q];
+            if (mark & (SEEN_CLAUSE | SEEN_REMOVABLE)) continue;
+            if (mark & SEEN_POISON) return LIT_UNDEF;
+            if (minimize_hopeless(s, q)) {
+                minimize_mark(s, q, SEEN_POISON);
+                return LIT_UNDEF;
+            }
+            if (!lit_redundant(s, q)) return LIT_UNDEF;
+        }
     }
+    return LIT_UNDEF;
+}
 
-    // Skip if minimization is disabled
-    if (!s->opts.minimize) {
-        return 0;
-    }
+// Minimize and shrink the learned clause after conflict analysis.
+// learnt[0] is the asserting literal and is always kept. Returns the
+// LBD, counted over the levels of the other literals while stamping
+// them (neither technique removes the last literal of a level).
+static uint32_t solver_minimize_clause(Solver* s, Lit* learnt, uint32_t* learnt_size) {
+    uint32_t size = *learnt_size;
 
-    if (*learnt_size <= 2) {
-        return 0;  // Don't minimize unit or binary clauses
+    uint32_t stamp = ++s->analyze_stamp;
+    if (stamp == 0) {
+        memset(s->analyze_levels, 0, (s->var_capacity + 1) * sizeof(AnalyzeLevel));
+        stamp = s->analyze_stamp = 1;
     }
-
-    uint32_t original_size = *learnt_size;
-
-    // Step 1: Compute abstract level bitmask for quick filtering
-    uint64_t abstract_levels = 0;
-    for (uint32_t i = 0; i < *learnt_size; i++) {
-        Level level = s->vars[var(learnt[i])].level;
-        abstract_levels |= abstract_level(level);
+    uint32_t lbd = 0;
+    for (uint32_t i = 1; i < size; i++) {
+        Var v = var(learnt[i]);
+        uint32_t pos = s->trail_pos[v];
+        AnalyzeLevel* level = &s->analyze_levels[s->levels[v]];
+        if (level->stamp != stamp) {
+            *level = (AnalyzeLevel){ stamp, 0, pos, pos, LIT_UNDEF };
+            lbd++;
+        }
+        level->count++;
+        if (pos < level->first) level->first = pos;
+        if (pos > level->last) level->last = pos;
     }
 
-    // Step 2: Mark all literals in learned clause (seen = 1)
-    for (uint32_t i = 0; i < *learnt_size; i++) {
-        s->seen[var(learnt[i])] = 1;
+    // Both results stay RUP: every removed or replaced literal is implied
+    // false by reasons in the clause database, so proofs log them as is
+    if (size <= 2 || (!s->opts.minimize && !s->opts.shrink)) {
+        return lbd;
     }
 
-    // Step 3: Try to remove each literal (except asserting literal at [0])
-    uint32_t new_size = 1;  // Keep learnt[0] (asserting literal)
-    for (uint32_t i = 1; i < *learnt_size; i++) {
-        Lit p = learnt[i];
-        Var v = var(p);
+    s->num_toclear = 0;
+    for (uint32_t i = 0; i < size; i++) {
+        minimize_mark(s, var(learnt[i]), SEEN_CLAUSE);
+    }
 
-        // Skip decision variables and binary propagations
-        if (s->vars[v].reason == INVALID_CLAUSE) {
-            learnt[new_size++] = p;
-            continue;
+    uint32_t kept = size;
+    if (s->opts.minimize) {
+        kept = 1;
+        for (uint32_t i = 1; i < size; i++) {
+            Var v = var(learnt[i]);
+            uint32_t reason_size;
+            if (reason_lits(s, v, &reason_size) && lit_redundant(s, v)) {
+                s->analyze_levels[s->levels[v]].count--;
+            } else {
+                learnt[kept++] = learnt[i];
+            }
         }
+        s->stats.minimized_literals += size - kept;
+    }
 
-        // CRITICAL: Temporarily clear seen[v] before checking redundancy.
-        // This prevents circular dependencies where literal p uses itself
-        // as coverage (e.g., p's reason leads to q, q's reason leads to p).
-        s->seen[v] = 0;
-
-        if (!lit_redundant(s, p, abstract_levels)) {
-            // Not redundant - restore and keep
-            s->seen[v] = 1;
-            learnt[new_size++] = p;
+    if (s->opts.shrink && kept > 2) {
+        // Mark every clause literal first: a level is shrunk against the
+        // clause as minimized, with lower levels possibly still to come
+        for (uint32_t i = 1; i < kept; i++) {
+            s->seen[var(learnt[i])] |= SEEN_SHRINK;
+        }
+        bool shrunk = false;
+        for (uint32_t i = 1; i < kept; i++) {
+            AnalyzeLevel* level = &s->analyze_levels[s->levels[var(learnt[i])]];
+            if (level->count < 2 || level->uip != LIT_UNDEF) continue;
+            Lit uip = shrink_level(s, s->levels[var(learnt[i])]);
+            if (uip == LIT_UNDEF) {
+                level->count = 1;  // Keep the literals, don't try again
+            } else {
+                level->uip = neg(uip);
+                shrunk = true;
+            }
+        }
+        if (shrunk) {
+            uint32_t before = kept;
+            kept = 1;
+            for (uint32_t i = 1; i < before; i++) {
+                AnalyzeLevel* level = &s->analyze_levels[s->levels[var(learnt[i])]];
+                if (level->uip == LIT_UNDEF) {
+                    learnt[kept++] = learnt[i];
+                } else if (level->count > 0) {
+                    learnt[kept++] = level->uip;
+                    level->count = 0;
+                }
+            }
+            s->stats.shrunk_literals += before - kept;
         }
-        // else: redundant, leave seen[v] = 0 so future checks can't use it
     }
+    *learnt_size = kept;
 
-    *learnt_size = new_size;
-
-    // Step 4: Clear seen array
-    // Clear remaining literals in the learned clause
-    for (uint32_t i = 0; i < new_size; i++) {
-        s->seen[var(learnt[i])] = 0;
+    for (uint32_t i = 0; i < s->num_toclear; i++) {
+        s->seen[s->analyze_toclear[i]] = 0;
     }
-
-    return original_size - new_size;
+    return lbd;
 }
 
 /*********************************************************************
  * Vivification (Clause Strengthening)
  *********************************************************************/
 
-// Helper: Remove watch for clause cref from literal lit's watch list
-static void remove_watch_for_clause(WatchManager* wm, Lit lit, CRef cref) {
-    WatchList* wl = watch_list(wm, lit);
-    for (uint32_t i = 0; i < wl->size; i++) {
-        if (wl->watches[i].cref == cref) {
-            watchlist_remove(wl, i);
-            return;
-        }
+// Undo the level-0 assumptions of a vivification probe and everything
+// they implied. Reasons are cleared as in solver_backtrack: a stale
+// binary reason would later make a decision look implied.
+static void vivify_undo(Solver* s, uint32_t trail_before) {
+    while (s->trail_size > trail_before) {
+        s->trail_size--;
+        Var v = var(s->trail[s->trail_size].lit);
+        unassign_var(s, v);
+        s->levels[v] = INVALID_LEVEL;
+        s->reasons[v] = INVALID_CLAUSE;
+        s->binary_reasons[v] = LIT_UNDEF;
     }
+    s->qhead = trail_before;
+    s->bin_qhead = trail_before;
+    if (s->gauss) gauss_backtrack(s, false);
 }
 
 // Try to strengthen a clause by removing redundant literals
@@ -1942,11 +3181,10 @@ static bool vivify_clause(Solver* s, CRef cref) {
     uint32_t size = CLAUSE_SIZE(s->arena, cref);
     if (size <= 2) return false;
 
-    Lit* lits = CLAUSE_LITS(s->arena, cref);
-
-    // Save original watched literals for later watch list update
-    Lit old_watch0 = lits[0];
-    Lit old_watch1 = lits[1];
+    // Work on a copy: propagation below reorders the clause's literals
+    Lit* clause = CLAUSE_LITS(s->arena, cref);
+    Lit lits[size];
+    memcpy(lits, clause, size * sizeof(Lit));
 
     // Save current trail size for backtracking
     uint32_t trail_before = s->trail_size;
@@ -1957,33 +3195,28 @@ static bool vivify_clause(Solver* s, CRef cref) {
     Lit new_lits[size];
 
     for (uint32_t i = 0; i < size; i++) {
-        // Assume all OTHER literals are false
-        for (uint32_t j = 0; j < size; j++) {
-            if (i == j) continue;
-
-            Lit lit = lits[j];
+        // Assume the kept literals before i and all literals after it
+        // false (a literal already removed must not be assumed, or two
+        // removals could each rely on the other)
+        for (uint32_t j = 0; j < new_size + size - i - 1; j++) {
+            Lit lit = j < new_size ? new_lits[j] : lits[i + 1 + j - new_size];
             Var v = var(lit);
 
             // If already assigned, skip
-            if (s->vars[v].value != UNDEF) {
-                if (s->vars[v].value == (sign(lit) ? FALSE : TRUE)) {
+            if (var_value(s, v) != UNDEF) {
+                if (lit_value(s, lit) == TRUE) {
                     // Literal is true - clause is satisfied, done
-                    // Backtrack assumptions
-                    while (s->trail_size > trail_before) {
-                        s->trail_size--;
-                        Lit trail_lit = s->trail[s->trail_size].lit;
-                        s->vars[var(trail_lit)].value = UNDEF;
-                    }
+                    vivify_undo(s, trail_before);
                     return false;
                 }
                 continue;
             }
 
             // Assign the negation (assume this literal is false)
-            s->vars[v].value = sign(lit) ? TRUE : FALSE;
-            s->vars[v].level = 0;
-            s->vars[v].reason = INVALID_CLAUSE;
-            s->vars[v].trail_pos = s->trail_size;
+            assign_lit(s, neg(lit));
+            s->levels[v] = 0;
+            s->reasons[v] = INVALID_CLAUSE;
+            s->trail_pos[v] = s->trail_size;
 
             s->trail[s->trail_size].lit = neg(lit);
             s->trail[s->trail_size].level = 0;
@@ -1999,8 +3232,7 @@ static bool vivify_clause(Solver* s, CRef cref) {
             strengthened = true;
         } else {
             // Check if lits[i] was propagated to false
-            Var v = var(lits[i]);
-            if (s->vars[v].value == (sign(lits[i]) ? TRUE : FALSE)) {
+            if (lit_value(s, lits[i]) == FALSE) {
                 // Literal propagated to false - it's redundant!
                 strengthened = true;
             } else {
@@ -2010,56 +3242,58 @@ static bool vivify_clause(Solver* s, CRef cref) {
         }
 
         // Backtrack all assumptions
-        while (s->trail_size > trail_before) {
-            s->trail_size--;
-            Lit trail_lit = s->trail[s->trail_size].lit;
-            s->vars[var(trail_lit)].value = UNDEF;
-        }
-        s->qhead = trail_before;
+        vivify_undo(s, trail_before);
     }
 
-    // If we strengthened the clause, update it
+    // If we strengthened the clause, update it. XOR reasons may have
+    // moved the arena meanwhile.
+    clause = CLAUSE_LITS(s->arena, cref);
     if (strengthened && new_size > 0) {
         // CRITICAL: Remove old watches BEFORE modifying clause
-        remove_watch_for_clause(s->watches, old_watch0, cref);
-        remove_watch_for_clause(s->watches, old_watch1, cref);
+        watch_remove_clause(s->watches, s->arena, cref);
+        if (s->proof) {
+            proof_add_clause(s, new_lits, new_size);
+            proof_delete_clause(s, clause, size);
+        }
 
         // Update clause in place
         for (uint32_t i = 0; i < new_size; i++) {
-            lits[i] = new_lits[i];
+            clause[i] = new_lits[i];
         }
 
         // Update size
-        CLAUSE_HEADER(s->arena, cref)->size = new_size;
+        arena_shrink(s->arena, cref, new_size);
 
         // Handle based on new clause size
         if (new_size == 1) {
             // Became unit - propagate it (no watches needed for units)
-            Lit unit = lits[0];
+            Lit unit = clause[0];
             Var v = var(unit);
-            if (s->vars[v].value == UNDEF) {
-                s->vars[v].value = sign(unit) ? FALSE : TRUE;
-                s->vars[v].level = 0;
-                s->vars[v].reason = cref;
-                s->vars[v].trail_pos = s->trail_size;
+            if (var_value(s, v) == UNDEF) {
+                assign_lit(s, unit);
+                s->levels[v] = 0;
+                s->reasons[v] = cref;
+                s->trail_pos[v] = s->trail_size;
 
                 s->trail[s->trail_size].lit = unit;
                 s->trail[s->trail_size].level = 0;
                 s->trail_size++;
             }
         } else {
-            // Add new watches for lits[0] and lits[1]
+            // Add new watches for clause[0] and clause[1]
             // Blocker is the other watched literal
-            watch_add(s->watches, lits[0], cref, lits[1]);
-            watch_add(s->watches, lits[1], cref, lits[0]);
+            watch_add(s->watches, clause[0], cref, clause[1]);
+            watch_add(s->watches, clause[1], cref, clause[0]);
         }
 
         return true;
     } else if (strengthened && new_size == 0) {
         // Clause became empty - UNSAT!
         // Remove old watches
-        remove_watch_for_clause(s->watches, old_watch0, cref);
-        remove_watch_for_clause(s->watches, old_watch1, cref);
+        watch_remove_clause(s->watches, s->arena, cref);
+        if (s->proof) {
+            proof_add_clause(s, new_lits, 0);
+        }
         s->result = FALSE;
         return true;
     }
@@ -2068,439 +3302,547 @@ static bool vivify_clause(Solver* s, CRef cref) {
 }
 
 /*********************************************************************
- * Blocked Clause Elimination (BCE)
+ * Failed Literal Probing
  *********************************************************************/
 
-// Check if resolving clauses c1 and c2 on variable v results in a tautology
-// A resolvent is a tautology if it contains both a literal and its negation
-static bool resolvent_is_tautology(Solver* s, CRef c1, CRef c2, Var v) {
-    // Safety check: validate clause references before accessing
-    if (c1 == INVALID_CLAUSE || c1 >= s->arena->size ||
-        c2 == INVALID_CLAUSE || c2 >= s->arena->size) {
-        return false;
-    }
+// Open a new decision level with lit and propagate.
+// Returns false on conflict; the caller backtracks in either case.
+bool solver_decide_literal(Solver* s, Lit lit) {
+    ASSERT(var_value(s, var(lit)) == UNDEF);
+    new_decision(s, lit);
+    return solver_propagate(s) == INVALID_CLAUSE;
+}
 
-    // Safety check: ensure clauses are not deleted
-    if (clause_deleted(s->arena, c1) || clause_deleted(s->arena, c2)) {
-        return false;
-    }
+void solver_new_decision(Solver* s, Lit lit) {
+    ASSERT(var_value(s, var(lit)) == UNDEF);
+    new_decision(s, lit);
+}
 
-    // Get clause sizes and validate they're reasonable
-    uint32_t size1 = CLAUSE_SIZE(s->arena, c1);
-    uint32_t size2 = CLAUSE_SIZE(s->arena, c2);
+// Try assigning a literal one level above the current one, propagate, and undo.
+// Returns false if the literal fails (its negation is implied).
+// If implied is non-NULL it receives the number of literals assigned.
+bool solver_probe(Solver* s, Lit lit, uint32_t* implied) {
+    Level base = s->decision_level;
+    uint32_t start = s->trail_size;
 
-    // Safety check: clause sizes must be reasonable (not corrupted)
-    // Maximum clause size should not exceed num_vars
-    if (size1 == 0 || size1 > s->num_vars || size2 == 0 || size2 > s->num_vars) {
-        return false;
-    }
+    bool ok = solver_decide_literal(s, lit);
+    if (implied) *implied = s->trail_size - start;
 
-    // Clear seen array
-    for (Var i = 1; i <= s->num_vars; i++) {
-        s->seen[i] = 0;
-    }
+    solver_backtrack(s, base);
+    return ok;
+}
 
-    // Add all literals from c1 except v and ¬v
-    Lit* lits1 = CLAUSE_LITS(s->arena, c1);
-    for (uint32_t i = 0; i < size1; i++) {
-        if (var(lits1[i]) != v) {
-            Var lit_var = var(lits1[i]);
+// Probe a literal at decision level 0. Returns:
+//  - TRUE if propagation succeeds (no conflict)
+//  - FALSE if conflict found (literal's negation is implied)
+static bool probe_literal(Solver* s, Lit lit) {
+    ASSERT(s->decision_level == 0);
+    return solver_probe(s, lit, NULL);
+}
 
-            // Safety check: validate literal variable is in bounds
-            if (lit_var < 1 || lit_var > s->num_vars) {
-                // Invalid literal - clause is corrupted, can't check tautology
-                for (Var j = 1; j <= s->num_vars; j++) {
-                    s->seen[j] = 0;
-                }
-                return false;
-            }
+// Assign a unit derived at decision level 0 (propagated by the caller)
+static void enqueue_root_unit(Solver* s, Lit unit) {
+    Var v = var(unit);
+    assign_lit(s, unit);
+    s->levels[v] = 0;
+    s->reasons[v] = INVALID_CLAUSE;
+    s->trail_pos[v] = s->trail_size;
 
-            bool is_negated = sign(lits1[i]);
+    s->trail[s->trail_size].lit = unit;
+    s->trail[s->trail_size].level = 0;
+    s->trail_size++;
+}
 
-            // Check if we've seen the opposite polarity
-            if (s->seen[lit_var] == (is_negated ? 1 : 2)) {
-                // Tautology! We have both x and ¬x
-                // Clear seen array before returning
-                for (Var j = 1; j <= s->num_vars; j++) {
-                    s->seen[j] = 0;
-                }
-                return true;
-            }
-            // Mark this polarity as seen (1 = positive, 2 = negative)
-            s->seen[lit_var] = is_negated ? 2 : 1;
-        }
-    }
+// Perform failed literal probing at decision level 0, round-robin from
+// inprocess.probe_cursor, until a sweep over all variables finds no unit
+// or budget propagations are spent.
+// Returns the number of unit clauses discovered, or -1 if UNSAT detected
+static int failed_literal_probing(Solver* s, uint64_t budget) {
+    if (s->decision_level > 0) return 0;
 
-    // Add all literals from c2 except v and ¬v
-    Lit* lits2 = CLAUSE_LITS(s->arena, c2);
-    for (uint32_t i = 0; i < size2; i++) {
-        if (var(lits2[i]) != v) {
-            Var lit_var = var(lits2[i]);
+    // Backtracking to level 0 marks the whole trail as propagated, so
+    // pending units must be propagated before the first probe
+    if (solver_propagate(s) != INVALID_CLAUSE) return -1;
 
-            // Safety check: validate literal variable is in bounds
-            if (lit_var < 1 || lit_var > s->num_vars) {
-                // Invalid literal - clause is corrupted, can't check tautology
-                for (Var j = 1; j <= s->num_vars; j++) {
-                    s->seen[j] = 0;
-                }
-                return false;
-            }
+    uint64_t start = s->stats.propagations;
+    int units_found = 0;
+    uint32_t unchanged = 0;  // Variables probed since the last unit
 
-            bool is_negated = sign(lits2[i]);
+    while (unchanged < s->num_vars && s->stats.propagations - start < budget) {
+        Var v = s->inprocess.probe_cursor;
+        if (v == 0 || v > s->num_vars) v = 1;
+        s->inprocess.probe_cursor = v + 1;
+        unchanged++;
 
-            // Check if we've seen the opposite polarity
-            if (s->seen[lit_var] == (is_negated ? 1 : 2)) {
-                // Tautology! We have both x and ¬x
-                // Clear seen array before returning
-                for (Var j = 1; j <= s->num_vars; j++) {
-                    s->seen[j] = 0;
-                }
-                return true;
-            }
-            // Mark this polarity as seen (1 = positive, 2 = negative)
-            s->seen[lit_var] = is_negated ? 2 : 1;
-        }
-    }
+        // Skip assigned and eliminated variables
+        if (var_value(s, v) != UNDEF || elim_is_eliminated(s, v)) continue;
 
-    // Clear seen array
-    for (Var i = 1; i <= s->num_vars; i++) {
-        s->seen[i] = 0;
+        bool pos_ok = probe_literal(s, mkLit(v, false));  // v = true
+        bool neg_ok = probe_literal(s, mkLit(v, true));   // v = false
+        if (pos_ok && neg_ok) continue;
+
+        // A failing polarity implies the other one (both failing = UNSAT)
+        Lit unit = pos_ok ? mkLit(v, false) : mkLit(v, true);
+        if (s->proof) {
+            proof_add_clause(s, &unit, 1);
+        }
+        if (!pos_ok && !neg_ok) return -1;
+        enqueue_root_unit(s, unit);
+        units_found++;
+        unchanged = 0;
+
+        // Propagate the new unit
+        if (solver_propagate(s) != INVALID_CLAUSE) {
+            return -1;  // UNSAT
+        }
     }
 
-    return false;
+    return units_found;
 }
 
-// Check if clause c is blocked on literal lit
-// A clause is blocked on a literal L if for every clause D containing ¬L,
-// the resolvent of C and D on var(L) is a tautology
-static bool clause_is_blocked(Solver* s, CRef cref, Lit blocking_lit) {
-    Var v = var(blocking_lit);
-    Lit negated = neg(blocking_lit);
+/*********************************************************************
+ * Simplification
+ *
+ * Inprocessing scheduler: probing, subsumption, vivification, BCE and
+ * BVE each run at level 0 on their own schedule (see solver.h). A round
+ * gets a per-mille share of the search propagations made since the
+ * technique last ran, as propagations (probing, vivification), literal
+ * visits (subsumption, BCE) or resolution pairs (BVE).
+ *********************************************************************/
 
-    // Get all clauses containing ¬blocking_lit by checking watch lists
-    WatchList* wl = watch_list(s->watches, negated);
+// Vivify learned clauses of the core and tier-2 (local ones are likely
+// to be reduced soon), round-robin from inprocess.vivify_cursor, until
+// budget propagations are spent. Returns the number of clauses
+// strengthened (s->result is FALSE if the formula was found UNSAT).
+static uint32_t vivify_learnts(Solver* s, uint64_t budget) {
+    uint64_t start = s->stats.propagations;
+    uint32_t vivified = 0;
 
-    // Safety check: watch list might not be initialized
-    if (!wl || !wl->watches) {
-        return false;
-    }
+    for (uint32_t k = 0; k < s->num_learnts && s->stats.propagations - start < budget; k++) {
+        uint32_t i = s->inprocess.vivify_cursor;
+        if (i >= s->num_learnts) i = 0;
+        s->inprocess.vivify_cursor = i + 1;
 
-    for (uint32_t i = 0; i < wl->size; i++) {
-        CRef other_cref = wl->watches[i].cref;
+        CRef cref = s->learnts[i];
+        if (cref == INVALID_CLAUSE || clause_deleted(s->arena, cref)) continue;
+        if (clause_lbd(s->arena, cref) > s->opts.tier2_lbd) continue;
 
-        // Safety check: validate clause reference
-        if (other_cref == INVALID_CLAUSE || other_cref >= s->arena->size) {
-            continue;
-        }
+        uint32_t trail_before = s->trail_size;
+        if (vivify_clause(s, cref)) vivified++;
+        if (s->result == FALSE) break;
 
-        // Skip deleted clauses
-        if (clause_deleted(s->arena, other_cref)) {
-            continue;
+        // A clause vivified to a unit put it on the trail: propagate it
+        // before the next clause backtracks over it
+        if (s->trail_size > trail_before && solver_propagate(s) != INVALID_CLAUSE) {
+            s->result = FALSE;
+            break;
         }
+    }
+    return vivified;
+}
 
-        // Skip the same clause
-        if (other_cref == cref) {
-            continue;
-        }
+// Drop learned clauses over variables eliminated by an inprocessing BVE
+// round (they are not part of the reduced formula)
+static void drop_eliminated_learnts(Solver* s) {
+    uint32_t j = 0;
+    for (uint32_t i = 0; i < s->num_learnts; i++) {
+        CRef cref = s->learnts[i];
+        if (clause_deleted(s->arena, cref)) continue;
 
-        // Additional validation: check clause size is reasonable
-        uint32_t other_size = CLAUSE_SIZE(s->arena, other_cref);
-        if (other_size == 0 || other_size > s->num_vars) {
-            continue;  // Skip corrupted clauses
+        const Lit* lits = CLAUSE_LITS(s->arena, cref);
+        uint32_t size = CLAUSE_SIZE(s->arena, cref);
+        bool eliminated = false;
+        for (uint32_t k = 0; k < size && !eliminated; k++) {
+            eliminated = elim_is_eliminated(s, var(lits[k]));
         }
-
-        // Check if resolvent is a tautology
-        if (!resolvent_is_tautology(s, cref, other_cref, v)) {
-            // Found a resolvent that is NOT a tautology
-            // This literal is not blocking
-            return false;
+        if (eliminated) {
+            delete_learnt(s, cref);
+            s->stats.deleted_clauses++;
+        } else {
+            s->learnts[j++] = cref;
         }
     }
-
-    // All resolvents are tautologies (or no clauses with ¬L exist)
-    // This clause is blocked on blocking_lit
-    return true;
+    s->num_learnts = j;
 }
 
-// Blocked Clause Elimination preprocessing
-// Removes clauses that are blocked on some literal
-// Returns number of clauses eliminated
-static uint32_t solver_eliminate_blocked_clauses(Solver* s) {
-    if (!s->opts.bce) {
+// Run one round of technique t with the given budget. Returns how much
+// it simplified the formula (units, clauses or variables), or -1 if the
+// formula was found UNSAT.
+static int64_t inprocess_round(Solver* s, InprocessTechnique t, uint64_t budget) {
+    switch (t) {
+    case INPROCESS_PROBE:
+        return failed_literal_probing(s, budget);
+
+    case INPROCESS_SUBSUME: {
+        uint64_t before = s->stats.subsume_removed + s->stats.subsume_strengthened;
+        if (!subsume_run(s, budget)) return -1;
+        return (int64_t)(s->stats.subsume_removed + s->stats.subsume_strengthened - before);
+    }
+
+    case INPROCESS_VIVIFY: {
+        uint32_t vivified = vivify_learnts(s, budget);
+        return s->result == FALSE ? -1 : (int64_t)vivified;
+    }
+
+    case INPROCESS_BCE: {
+        uint32_t blocked = elim_blocked_clauses(s, budget);
+        s->stats.blocked_clauses += blocked;
+        return blocked;
+    }
+
+    case INPROCESS_ELIM: {
+        uint32_t eliminated = elim_run(s, budget);
+        if (s->result == FALSE) return -1;
+        if (eliminated > 0) drop_eliminated_learnts(s);
+        return eliminated;
+    }
+
+    default:
         return 0;
     }
+}
 
-    uint32_t eliminated = 0;
+static bool inprocess_enabled(const Solver* s, InprocessTechnique t) {
+    switch (t) {
+    case INPROCESS_PROBE:   return s->opts.probing && s->opts.inprocess_probe > 0;
+    case INPROCESS_SUBSUME: return s->opts.subsumption && s->opts.inprocess_subsume > 0;
+    case INPROCESS_VIVIFY:  return s->opts.inprocess_vivify > 0;
+    case INPROCESS_BCE:     return s->opts.bce && s->opts.inprocess_bce > 0;
+    case INPROCESS_ELIM:    return s->opts.elim && s->opts.inprocess_elim > 0;
+    default:                return false;
+    }
+}
 
-    // Only eliminate from original clauses (not learned clauses)
-    for (uint32_t i = 0; i < s->num_original; i++) {
-        // Check if progress stats requested via signal (BCE can be slow)
-        if (print_stats_requested) {
-            print_stats_requested = 0;
-            fprintf(stderr, "c [BCE] Processing clause %u / %u (%.1f%% complete)\n",
-                    i, s->num_original, (100.0 * i) / s->num_original);
-            fflush(stderr);
+static uint32_t inprocess_share(const Solver* s, InprocessTechnique t) {
+    switch (t) {
+    case INPROCESS_PROBE:   return s->opts.inprocess_probe;
+    case INPROCESS_SUBSUME: return s->opts.inprocess_subsume;
+    case INPROCESS_VIVIFY:  return s->opts.inprocess_vivify;
+    case INPROCESS_BCE:     return s->opts.inprocess_bce;
+    case INPROCESS_ELIM:    return s->opts.inprocess_elim;
+    default:                return 0;
+    }
+}
+
+// Whether a technique waits for the next visit to level 0
+static bool inprocess_due(const Solver* s) {
+    if (!s->opts.inprocess) return false;
+    uint64_t first = s->opts.inprocess_interval ? s->opts.inprocess_interval : 1;
+    for (int t = 0; t < INPROCESS_TECHNIQUES; t++) {
+        const InprocessSchedule* sched = &s->inprocess.sched[t];
+        if (!inprocess_enabled(s, t)) continue;
+        if (sched->interval == 0 ? s->stats.conflicts >= first : search_ticks(s) >= sched->next) {
+            return true;
         }
+    }
+    return false;
+}
 
-        CRef cref = s->clauses[i];
+bool solver_simplify(Solver* s) {
+    // Can only simplify at level 0
+    if (s->decision_level > 0 || !s->opts.inprocess) return true;
 
-        // Skip deleted clauses - validate bounds before accessing
-        if (cref == INVALID_CLAUSE || cref >= s->arena->size) {
-            continue;
+    // The base interval is the search ticks of the first rounds' wait
+    uint64_t first = s->opts.inprocess_interval ? s->opts.inprocess_interval : 1;
+    if (s->inprocess.base == 0) {
+        if (s->stats.conflicts < first) return true;
+        s->inprocess.base = search_ticks(s) > 0 ? search_ticks(s) : 1;
+    }
+    uint64_t base = s->inprocess.base;
+    bool propagated = false;
+
+    for (int t = 0; t < INPROCESS_TECHNIQUES; t++) {
+        InprocessSchedule* sched = &s->inprocess.sched[t];
+        if (!inprocess_enabled(s, t)) continue;
+        if (sched->interval == 0) {
+            // First round right away
+            sched->interval = base;
+            sched->next = search_ticks(s);
         }
+        if (search_ticks(s) < sched->next) continue;
 
-        if (clause_deleted(s->arena, cref)) {
-            continue;
+        // Techniques start from a fully propagated level 0
+        if (!propagated) {
+            if (solver_propagate(s) != INVALID_CLAUSE) {
+                s->result = FALSE;
+                return false;
+            }
+            propagated = true;
         }
 
-        // Skip learned clauses (shouldn't happen in original clauses, but be safe)
-        if (clause_learned(s->arena, cref)) {
-            continue;
+        // Budget: a share of the search propagations since the last round
+        uint64_t search_props = s->stats.propagations - s->inprocess.props;
+        uint64_t budget = (search_props - sched->last_props) * inprocess_share(s, t) / 1000;
+        if (budget < INPROCESS_MIN_EFFORT) budget = INPROCESS_MIN_EFFORT;
+
+        double start = now_seconds();
+        uint64_t props_before = s->stats.propagations;
+        uint64_t ticks_before = s->stats.ticks;
+        PHASE_START(s, PHASE_INPROCESS);
+        int64_t simplified = inprocess_round(s, t, budget);
+        PHASE_STOP(s, PHASE_INPROCESS);
+        s->inprocess.props += s->stats.propagations - props_before;
+        s->inprocess.ticks += s->stats.ticks - ticks_before;
+
+        sched->rounds++;
+        sched->effort += budget;
+        sched->time += now_seconds() - start;
+        sched->last_props = s->stats.propagations - s->inprocess.props;
+        if (simplified < 0) {
+            s->result = FALSE;
+            return false;
         }
 
-        uint32_t size = CLAUSE_SIZE(s->arena, cref);
-        Lit* lits = CLAUSE_LITS(s->arena, cref);
-
-        // Try each literal as a blocking literal
-        bool blocked = false;
-        for (uint32_t j = 0; j < size && !blocked; j++) {
-            Lit lit = lits[j];
-
-            if (clause_is_blocked(s, cref, lit)) {
-                // This clause is blocked on lit - eliminate it!
-                // Note: We just mark it as INVALID instead of calling arena_delete()
-                // to avoid corrupting watch lists that still point to this clause.
-                // The clause memory remains allocated but won't be used in search.
-                s->clauses[i] = INVALID_CLAUSE;
-                eliminated++;
-                blocked = true;
-
-                if (s->opts.verbose) {
-                    printf("c [BCE] Eliminated clause blocked on literal %d%d\n",
-                           sign(lit) ? -((int)var(lit)) : (int)var(lit), sign(lit));
-                }
-            }
+        // Adapt the interval to how productive the round was
+        if (simplified > 0) {
+            sched->productive++;
+            sched->interval = sched->interval / 2 > base ? sched->interval / 2 : base;
+        } else if (sched->interval < base * INPROCESS_MAX_SCALE) {
+            sched->interval *= 2;
         }
-    }
+        sched->next = search_ticks(s) + sched->interval;
 
-    if (eliminated > 0 && s->opts.verbose) {
-        printf("c [BCE] Eliminated %u blocked clauses\n", eliminated);
+        if (IS_VERBOSE(s)) {
+            printf("c [Inprocess] %s: %lld at conflict %llu (budget %llu, next in %llu ticks)\n",
+                   inprocess_names[t], (long long)simplified,
+                   (unsigned long long)s->stats.conflicts, (unsigned long long)budget,
+                   (unsigned long long)sched->interval);
+        }
     }
 
-    return eliminated;
+    return true;
 }
 
 /*********************************************************************
- * Failed Literal Probing
+ * Checkpoints
+ *
+ * The state is saved at a full restart, on decision level 0, once
+ * opts.checkpoint_interval seconds have passed since the last write,
+ * and once more when a limit stops the search.
  *********************************************************************/
 
-// Try assigning a literal and propagate. Returns:
-//  - TRUE if propagation succeeds (no conflict)
-//  - FALSE if conflict found (literal's negation is implied)
-static bool probe_literal(Solver* s, Lit lit) {
-    ASSERT(s->decision_level == 0);
-
-    // Make temporary assignment at level 1
-    s->decision_level = 1;
-    s->trail_lims[1] = s->trail_size;
-
-    Var v = var(lit);
-    s->vars[v].value = sign(lit) ? FALSE : TRUE;
-    s->vars[v].level = 1;
-    s->vars[v].reason = INVALID_CLAUSE;
-    s->vars[v].trail_pos = s->trail_size;
-
-    s->trail[s->trail_size].lit = lit;
-    s->trail[s->trail_size].level = 1;
-    s->trail_size++;
-
-    // Propagate
-    CRef conflict = solver_propagate(s);
-
-    // Backtrack to level 0
-    solver_backtrack(s, 0);
-
-    return (conflict == INVALID_CLAUSE);
+static bool checkpoint_due(const Solver* s) {
+    return s->checkpoint.active && now_seconds() - s->checkpoint.last >= s->opts.checkpoint_interval;
 }
 
-// Perform failed literal probing at decision level 0
-// Returns the number of unit clauses discovered, or -1 if UNSAT detected
-static int failed_literal_probing(Solver* s) {
-    if (s->decision_level > 0) return 0;
-
-    int units_found = 0;
-    bool made_progress = true;
-
-    // Repeat until no more units found (fixed point)
-    while (made_progress) {
-        made_progress = false;
-
-        for (Var v = 1; v <= s->num_vars; v++) {
-            // Skip assigned variables
-            if (s->vars[v].value != UNDEF) continue;
-
-            Lit pos = mkLit(v, false);  // v = true
-            Lit neg = mkLit(v, true);   // v = false
-
-            bool pos_ok = probe_literal(s, pos);
-            bool neg_ok = probe_literal(s, neg);
-
-            if (!pos_ok && !neg_ok) {
-                // Both polarities lead to conflict = UNSAT
-                return -1;
-            } else if (!pos_ok) {
-                // Positive leads to conflict, so v must be false
-                s->vars[v].value = FALSE;
-                s->vars[v].level = 0;
-                s->vars[v].reason = INVALID_CLAUSE;
-                s->vars[v].trail_pos = s->trail_size;
-
-                s->trail[s->trail_size].lit = neg;
-                s->trail[s->trail_size].level = 0;
-                s->trail_size++;
-
-                units_found++;
-                made_progress = true;
+static void checkpoint_save(Solver* s) {
+    double start = now_seconds();
+    if (checkpoint_write(s, s->opts.checkpoint_path)) {
+        s->checkpoint.written++;
+    } else if (!s->opts.quiet) {
+        fprintf(stderr, "c Warning: Cannot write checkpoint %s\n", s->opts.checkpoint_path);
+    }
+    s->checkpoint.last = now_seconds();
+    s->checkpoint.time += s->checkpoint.last - start;
+}
 
-                // Propagate the new unit
-                CRef conflict = solver_propagate(s);
-                if (conflict != INVALID_CLAUSE) {
-                    return -1;  // UNSAT
-                }
-            } else if (!neg_ok) {
-                // Negative leads to conflict, so v must be true
-                s->vars[v].value = TRUE;
-                s->vars[v].level = 0;
-                s->vars[v].reason = INVALID_CLAUSE;
-                s->vars[v].trail_pos = s->trail_size;
-
-                s->trail[s->trail_size].lit = pos;
-                s->trail[s->trail_size].level = 0;
-                s->trail_size++;
+/*********************************************************************
+ * Incremental Solving Support
+ *********************************************************************/
 
-                units_found++;
-                made_progress = true;
+static void conflict_push(Solver* s, Lit lit) {
+    if (s->incremental.conflict_size >= s->incremental.conflict_capacity) {
+        uint32_t new_cap = s->incremental.conflict_capacity ? s->incremental.conflict_capacity * 2 : 16;
+        Lit* new_conflict = (Lit*)realloc(s->incremental.conflict, new_cap * sizeof(Lit));
+        if (!new_conflict) return;
+        s->incremental.conflict = new_conflict;
+        s->incremental.conflict_capacity = new_cap;
+    }
+    s->incremental.conflict[s->incremental.conflict_size++] = lit;
+}
 
-                // Propagate the new unit
-                CRef conflict = solver_propagate(s);
-                if (conflict != INVALID_CLAUSE) {
-                    return -1;  // UNSAT
-                }
+// MiniSat-style analyzeFinal: explain the false assumption ~p in terms of
+// the assumption decisions above level 0. The result is a clause over
+// negated assumptions, starting with p.
+static void analyze_final(Solver* s, Lit p) {
+    s->incremental.conflict_size = 0;
+    conflict_push(s, p);
+    if (s->decision_level == 0) return;
+
+    s->seen[var(p)] = 1;
+
+    for (uint32_t i = s->trail_size; i-- > s->trail_lims[1]; ) {
+        Var x = var(s->trail[i].lit);
+        if (!s->seen[x]) continue;
+
+        CRef reason = s->reasons[x];
+        if (reason != INVALID_CLAUSE) {
+            uint32_t size = CLAUSE_SIZE(s->arena, reason);
+            Lit* lits = CLAUSE_LITS(s->arena, reason);
+            for (uint32_t j = 0; j < size; j++) {
+                Var q = var(lits[j]);
+                if (q != x && s->levels[q] > 0) s->seen[q] = 1;
             }
+        } else if (s->binary_reasons[x] != LIT_UNDEF) {
+            Var q = var(s->binary_reasons[x]);
+            if (s->levels[q] > 0) s->seen[q] = 1;
+        } else if (s->levels[x] > 0) {
+            // Decisions below the assumption levels are assumptions
+            conflict_push(s, neg(s->trail[i].lit));
         }
+        s->seen[x] = 0;
     }
 
-    return units_found;
+    s->seen[var(p)] = 0;
 }
 
-/*********************************************************************
- * Simplification
- *********************************************************************/
+// Copy the full assignment into the model, then return to level 0 and drop
+// the values that are not on the trail (set by local search or by model
+// extension), so clauses can be added before the next call
+static void save_model(Solver* s) {
+    if (s->incremental.model_size < s->num_vars + 1) {
+        lbool* new_model = (lbool*)realloc(s->incremental.model, (s->num_vars + 1) * sizeof(lbool));
+        if (!new_model) return;
+        s->incremental.model = new_model;
+    }
+    s->incremental.model_size = s->num_vars + 1;
+    s->incremental.model[0] = UNDEF;
+    for (Var v = 1; v <= s->num_vars; v++) {
+        s->incremental.model[v] = var_value(s, v);
+    }
 
-bool solver_simplify(Solver* s) {
-    // Can only simplify at level 0
-    if (s->decision_level > 0) return true;
-
-    // Vivification: strengthen learned clauses by removing redundant literals
-    // Enable with: --inprocess flag
-    static uint64_t last_vivify = 0;
-    if (s->opts.inprocess && s->stats.conflicts >= last_vivify + s->opts.inprocess_interval) {
-        last_vivify = s->stats.conflicts;
-
-        uint32_t vivified = 0;
-        // Only vivify a limited number of clauses per round
-        uint32_t max_vivify = s->num_learnts < 100 ? s->num_learnts : 100;
-        for (uint32_t i = 0; i < max_vivify; i++) {
-            CRef cref = s->learnts[i];
-            if (cref == INVALID_CLAUSE) continue;
-            if (clause_deleted(s->arena, cref)) continue;
+    solver_backtrack(s, 0);
 
-            if (vivify_clause(s, cref)) {
-                vivified++;
-            }
+    for (Var v = 1; v <= s->num_vars; v++) {
+        if (var_value(s, v) == UNDEF) continue;
+        uint32_t pos = s->trail_pos[v];
+        if (s->levels[v] == 0 && pos < s->trail_size && var(s->trail[pos].lit) == v) continue;
+
+        unassign_var(s, v);
+        s->levels[v] = INVALID_LEVEL;
+        s->reasons[v] = INVALID_CLAUSE;
+        s->binary_reasons[v] = LIT_UNDEF;
+        bool eliminated = s->elim && v < s->elim->elim_capacity && s->elim->eliminated[v];
+        if (!eliminated) order_push(s, v);
+    }
+}
 
-            // Check if UNSAT was detected during vivification
-            if (s->result == FALSE) {
-                return false;
-            }
-        }
+// Common exit of the search loop
+static lbool solve_finish(Solver* s, lbool result, Lit* learnt_clause) {
+    free(learnt_clause);
+    proof_flush(s->proof);
 
-        if (vivified > 0 && IS_VERBOSE(s)) {
-            printf("c Vivified %u clauses at conflict %llu\n", vivified, s->stats.conflicts);
+    if (result == TRUE) {
+        if (s->elim) {
+            elim_extend_model(s);
         }
+        s->result = TRUE;
+        save_model(s);
     }
 
-    return true;
+    solver_backtrack(s, 0);
+    if (result == UNDEF && s->checkpoint.active) checkpoint_save(s);
+    return result;
 }
 
 /*********************************************************************
  * Main Solve Function
  *********************************************************************/
 
-lbool solver_solve(Solver* s) {
-    return solver_solve_with_assumptions(s, NULL, 0);
-}
-
-lbool solver_solve_with_assumptions(Solver* s, const Lit* assumps, uint32_t n_assumps) {
-    // Install signal handlers for progress monitoring
-    install_signal_handlers();
-
-    // Check if already solved
-    if (s->result != UNDEF) {
-        return s->result;
-    }
+// Blocked clause elimination, failed literal probing, subsumption and BVE.
+// Returns false if the formula was found UNSAT.
+static bool solver_preprocess(Solver* s) {
+    // XOR recovery first: BCE and BVE leave the matrix variables alone
+    if (s->opts.gauss && !gauss_init(s)) return false;
 
     // Preprocessing: Blocked Clause Elimination
     if (s->opts.bce) {
-        uint32_t blocked = solver_eliminate_blocked_clauses(s);
-        s->stats.blocked_clauses = blocked;
+        uint32_t blocked = elim_blocked_clauses(s, UINT64_MAX);
+        s->stats.blocked_clauses += blocked;
+        if (blocked > 0 && !s->opts.quiet) {
+            printf("c [BCE] Eliminated %u blocked clauses\n", blocked);
+        }
     }
 
     // Preprocessing: Failed Literal Probing
     if (s->opts.probing) {
-        int probing_result = failed_literal_probing(s);
+        int probing_result = failed_literal_probing(s, UINT64_MAX);
         if (probing_result < 0) {
             // UNSAT detected during probing
             s->result = FALSE;
-            return FALSE;
+            return false;
         }
         if (probing_result > 0 && !s->opts.quiet) {
             printf("c [Probing] Found %d implied units\n", probing_result);
         }
     }
 
+    // Preprocessing: Backward subsumption and self-subsuming strengthening
+    if (s->opts.subsumption) {
+        uint64_t removed = s->stats.subsume_removed;
+        uint64_t strengthened = s->stats.subsume_strengthened;
+        if (!subsume_run(s, s->opts.subsume_effort)) {
+            return false;
+        }
+        removed = s->stats.subsume_removed - removed;
+        strengthened = s->stats.subsume_strengthened - strengthened;
+        if ((removed > 0 || strengthened > 0) && !s->opts.quiet) {
+            printf("c [Subsume] Removed %llu subsumed clauses, strengthened %llu in %.2fs\n",
+                   (unsigned long long)removed, (unsigned long long)strengthened,
+                   s->stats.subsume_time);
+        }
+    }
+
     // Preprocessing: Bounded Variable Elimination (BVE)
     if (s->opts.elim) {
-        uint32_t eliminated = elim_preprocess(s);
+        elim_preprocess(s);  // Reports its own summary
         if (s->result == FALSE) {
             // UNSAT detected during BVE
-            return FALSE;
-        }
-        if (eliminated > 0 && !s->opts.quiet) {
-            printf("c [BVE] Eliminated %u variables\n", eliminated);
+            return false;
         }
     }
 
-    // Add assumptions
+    return true;
+}
+
+lbool solver_solve(Solver* s) {
+    return solver_solve_with_assumptions(s, NULL, 0);
+}
+
+lbool solver_solve_with_assumptions(Solver* s, const Lit* assumps, uint32_t n_assumps) {
+    // Install signal handlers for progress monitoring
+    install_signal_handlers();
+
+    // A formula proven UNSAT stays UNSAT; any other answer is recomputed
+    s->incremental.solves++;
+    s->incremental.conflict_size = 0;
+    s->incremental.model_size = 0;
+    if (s->result == FALSE) {
+        return FALSE;
+    }
+    s->result = UNDEF;
+    solver_backtrack(s, 0);
+
+    // Every assumption takes one decision level
+    if (n_assumps > s->num_vars) return UNDEF;
     for (uint32_t i = 0; i < n_assumps; i++) {
-        Lit a = assumps[i];
-        Var v = var(a);
+        Var v = var(assumps[i]);
+        if (v == 0 || v > s->num_vars) return UNDEF;
+    }
 
-        if (s->vars[v].value == UNDEF) {
-            s->decision_level++;
-            s->trail_lims[s->decision_level] = s->trail_size;
+    // Assumptions on variables that BVE or BCE removed clauses on (they
+    // were not frozen) bring those clauses back first
+    if (s->elim && !restore_removed(s, assumps, n_assumps)) {
+        return s->result == FALSE ? FALSE : UNDEF;
+    }
 
-            s->vars[v].value = sign(a) ? FALSE : TRUE;
-            s->vars[v].level = s->decision_level;
-            s->vars[v].reason = INVALID_CLAUSE;
-            s->vars[v].trail_pos = s->trail_size;
+    s->checkpoint.active = s->opts.checkpoint_path && n_assumps == 0 && !s->share.exchange;
+    s->checkpoint.last = now_seconds();
 
-            s->trail[s->trail_size].lit = a;
-            s->trail[s->trail_size].level = s->decision_level;
-            s->trail_size++;
-        } else if (s->vars[v].value == (sign(a) ? TRUE : FALSE)) {
-            // Conflicting assumption
-            s->result = FALSE;
+    // Assumed variables must survive BVE and BCE, in preprocessing and
+    // in inprocessing rounds between restarts
+    for (uint32_t i = 0; i < n_assumps; i++) {
+        s->vars[var(assumps[i])].frozen = true;
+    }
+
+    // Preprocessing runs once, before the first search. Later calls keep
+    // the learned clauses, activities and phases of the earlier ones.
+    if (!s->incremental.preprocessed) {
+        s->incremental.preprocessed = true;
+        PHASE_START(s, PHASE_PREPROCESS);
+        bool preprocessed = solver_preprocess(s);
+        PHASE_STOP(s, PHASE_PREPROCESS);
+        if (!preprocessed) {
             return FALSE;
         }
     }
@@ -2555,12 +3897,18 @@ lbool solver_solve_with_assumptions(Solver* s, const Lit* assumps, uint32_t n_as
         }
         #endif
 
+        PHASE_START(s, PHASE_PROPAGATE);
         CRef conflict = solver_propagate(s);
+        PHASE_STOP(s, PHASE_PROPAGATE);
 
         if (conflict != INVALID_CLAUSE) {
             // Conflict!
             s->stats.conflicts++;
             s->restart.conflicts_since++;
+            HIST_ADD(s, HIST_TRAIL, s->trail_size);
+            if (s->opts.report_interval && s->stats.conflicts % s->opts.report_interval == 0) {
+                print_report_line(s);
+            }
 
             // Adaptive random phase: detect stuck states
             // If many conflicts at low decision levels, we're likely stuck in a local minimum
@@ -2594,30 +3942,69 @@ lbool solver_solve_with_assumptions(Solver* s, const Lit* assumps, uint32_t n_as
                         (unsigned long long)s->stats.reduces);
             }
 
+            // A matrix row found on a later check (after a conflict, or
+            // as the sum of rows) may be false below the current level:
+            // analysis needs a literal of the conflict's own level
+            if (s->gauss && conflict != BINARY_CONFLICT && s->decision_level > 0) {
+                Level level = 0;
+                const Lit* lits = CLAUSE_LITS(s->arena, conflict);
+                for (uint32_t i = 0; i < CLAUSE_SIZE(s->arena, conflict); i++) {
+                    if (s->levels[var(lits[i])] > level) level = s->levels[var(lits[i])];
+                }
+                solver_backtrack(s, level);
+            }
+
             if (s->decision_level == 0) {
                 // Conflict at level 0 = UNSAT
                 s->result = FALSE;
-                free(learnt_clause);
-                return FALSE;
+                return solve_finish(s, FALSE, learnt_clause);
             }
 
             // Learn clause
             uint32_t learnt_size;
             Level backtrack_level;
+            PHASE_START(s, PHASE_ANALYZE);
             solver_analyze(s, conflict, learnt_clause, &learnt_size, &backtrack_level);
+            PHASE_STOP(s, PHASE_ANALYZE);
+
+            // Minimize and shrink the learned clause. This must happen
+            // BEFORE backtracking while all reason clauses are valid
+            PHASE_START(s, PHASE_MINIMIZE);
+            uint32_t lbd = solver_minimize_clause(s, learnt_clause, &learnt_size);
+            PHASE_STOP(s, PHASE_MINIMIZE);
+            HIST_ADD(s, HIST_LEARNT_SIZE, learnt_size);
+
+            // Second watch = highest-level literal after the asserting one, so
+            // the clause is re-examined as soon as backtracking unassigns it
+            if (learnt_size > 1) {
+                uint32_t max_i = 1;
+                for (uint32_t i = 2; i < learnt_size; i++) {
+                    if (s->levels[var(learnt_clause[i])] > s->levels[var(learnt_clause[max_i])]) {
+                        max_i = i;
+                    }
+                }
+                Lit tmp = learnt_clause[1];
+                learnt_clause[1] = learnt_clause[max_i];
+                learnt_clause[max_i] = tmp;
+                backtrack_level = s->levels[var(learnt_clause[1])];
+            }
 
-            // Minimize the learned clause using MiniSat-style recursive analysis
-            // This must happen BEFORE backtracking while all reason clauses are valid
-            uint32_t minimized = solver_minimize_clause(s, learnt_clause, &learnt_size);
-            s->stats.minimized_literals += minimized;
-
-            // Backtrack (chronological - step down one level at a time)
-            // The chronological backtracking function may return a different level
-            // than requested if the learned clause becomes unit at an earlier level
-            Level actual_backtrack_level = solver_backtrack_chronological(s, learnt_clause, learnt_size, backtrack_level);
-
-            // Update backtrack_level to reflect where we actually ended up
-            backtrack_level = actual_backtrack_level;
+            // Backtrack: jumps over more than chrono_threshold levels step
+            // down one level at a time instead, keeping the trail below.
+            // The chronological backtracking function may return a different
+            // level than requested if the learned clause becomes unit earlier.
+            PHASE_START(s, PHASE_BACKTRACK);
+#ifdef BSAT_PHASES
+            Level conflict_level = s->decision_level;
+#endif
+            if (s->opts.chrono && s->decision_level - backtrack_level > s->opts.chrono_threshold) {
+                backtrack_level = solver_backtrack_chronological(s, learnt_clause, learnt_size, backtrack_level);
+                s->stats.chrono_backtracks++;
+            } else {
+                solver_backtrack(s, backtrack_level);
+            }
+            PHASE_STOP(s, PHASE_BACKTRACK);
+            HIST_ADD(s, HIST_JUMP, conflict_level - s->decision_level);
 
             // Add learned clause
             if (learnt_size == 1) {
@@ -2629,18 +4016,23 @@ lbool solver_solve_with_assumptions(Solver* s, const Lit* assumps, uint32_t n_as
                 }
 
                 // Log unit clause to DRAT proof file
-                if (s->proof_file) {
+                if (s->proof) {
                     proof_add_clause(s, learnt_clause, 1);
                 }
 
+                // Units are always worth sharing with other portfolio workers
+                if (s->share.exchange) {
+                    exchange_export(s, learnt_clause, 1, 1);
+                }
+
                 Lit unit = learnt_clause[0];
                 Var v = var(unit);
-                ASSERT(s->vars[v].value == UNDEF);
+                ASSERT(var_value(s, v) == UNDEF);
 
-                s->vars[v].value = sign(unit) ? FALSE : TRUE;
-                s->vars[v].level = 0;
-                s->vars[v].reason = INVALID_CLAUSE;
-                s->vars[v].trail_pos = s->trail_size;
+                assign_lit(s, unit);
+                s->levels[v] = 0;
+                s->reasons[v] = INVALID_CLAUSE;
+                s->trail_pos[v] = s->trail_size;
 
                 s->trail[s->trail_size].lit = unit;
                 s->trail[s->trail_size].level = 0;
@@ -2673,18 +4065,20 @@ lbool solver_solve_with_assumptions(Solver* s, const Lit* assumps, uint32_t n_as
                     }
                 }
             } else {
-                // Add learned clause
-                CRef learnt_ref = arena_alloc(s->arena, learnt_clause, learnt_size, true);
+                // Learned binaries go straight to the implication lists,
+                // longer clauses to the arena
+                bool binary = learnt_size == 2;
+                CRef learnt_ref = binary ? INVALID_CLAUSE
+                                         : arena_alloc(s->arena, learnt_clause, learnt_size, true);
 
-                if (learnt_ref != INVALID_CLAUSE) {
+                if (binary || learnt_ref != INVALID_CLAUSE) {
                     // Log to DRAT proof file
-                    if (s->proof_file) {
+                    if (s->proof) {
                         proof_add_clause(s, learnt_clause, learnt_size);
                     }
 
-                    // Update LBD
-                    uint32_t lbd = calc_lbd(s, learnt_clause, learnt_size);
-                    set_clause_lbd(s->arena, learnt_ref, lbd);
+                    if (!binary) set_clause_lbd(s->arena, learnt_ref, lbd);
+                    HIST_ADD(s, HIST_LBD, lbd);
 
                     if (lbd > s->stats.max_lbd) {
                         s->stats.max_lbd = lbd;
@@ -2723,17 +4117,18 @@ lbool solver_solve_with_assumptions(Solver* s, const Lit* assumps, uint32_t n_as
                         }
                     }
 
-                    // Add to learned clauses
-                    if (s->num_learnts >= s->learnts_size) {
-                        uint32_t new_size = s->learnts_size ? s->learnts_size * 2 : 1024;
-                        CRef* new_learnts = (CRef*)realloc(s->learnts, new_size * sizeof(CRef));
-                        if (new_learnts) {
-                            s->learnts = new_learnts;
-                            s->learnts_size = new_size;
-                        }
+                    // Add to learned clauses (binaries are never reduced)
+                    if (!binary) learnts_push(s, learnt_ref);
+
+                    // Share low-LBD clauses with other portfolio workers
+                    if (s->share.exchange) {
+                        exchange_export(s, learnt_clause, learnt_size, lbd);
                     }
-                    if (s->num_learnts < s->learnts_size) {
-                        s->learnts[s->num_learnts++] = learnt_ref;
+
+                    // Hand binary and glue clauses to local search (a
+                    // failed append only loses that clause)
+                    if (s->local_search.state && (binary || lbd <= s->opts.glue_lbd)) {
+                        local_search_add_clause(s->local_search.state, learnt_clause, learnt_size);
                     }
 
                     // On-the-fly backward subsumption
@@ -2743,18 +4138,23 @@ lbool solver_solve_with_assumptions(Solver* s, const Lit* assumps, uint32_t n_as
                     }
 
                     // Add watches
-                    watch_add(s->watches, learnt_clause[0], learnt_ref, learnt_clause[1]);
-                    watch_add(s->watches, learnt_clause[1], learnt_ref, learnt_clause[0]);
+                    if (binary) {
+                        watch_add_binary(s->watches, learnt_clause[0], learnt_clause[1]);
+                    } else {
+                        watch_add(s->watches, learnt_clause[0], learnt_ref, learnt_clause[1]);
+                        watch_add(s->watches, learnt_clause[1], learnt_ref, learnt_clause[0]);
+                    }
 
                     // Unit propagate the asserting literal
                     Lit unit = learnt_clause[0];
                     Var v = var(unit);
-                    ASSERT(s->vars[v].value == UNDEF);
+                    ASSERT(var_value(s, v) == UNDEF);
 
-                    s->vars[v].value = sign(unit) ? FALSE : TRUE;
-                    s->vars[v].level = backtrack_level;
-                    s->vars[v].reason = learnt_ref;
-                    s->vars[v].trail_pos = s->trail_size;
+                    assign_lit(s, unit);
+                    s->levels[v] = backtrack_level;
+                    s->reasons[v] = learnt_ref;  // INVALID_CLAUSE for binaries
+                    s->trail_pos[v] = s->trail_size;
+                    if (binary) s->binary_reasons[v] = learnt_clause[1];
 
                     s->trail[s->trail_size].lit = unit;
                     s->trail[s->trail_size].level = backtrack_level;
@@ -2767,9 +4167,12 @@ lbool solver_solve_with_assumptions(Solver* s, const Lit* assumps, uint32_t n_as
 
             // Decay activities
             decay_var_inc(s);
+            s->db.clause_inc /= CLAUSE_ACTIVITY_DECAY;
 
-            // Check for restart
-            if (solver_should_restart(s)) {
+            // Check for restart (a mode switch restarts too)
+            bool switching = s->opts.modes && mode_switch_due(s);
+            if (switching || solver_should_restart(s)) {
+                bool checkpointing = checkpoint_due(s);
                 if (IS_VERBOSE(s)) {
                     fprintf(stderr, "c [Restart #%llu] Conflicts: %llu, Level: %u",
                             (unsigned long long)s->stats.restarts + 1,
@@ -2781,8 +4184,31 @@ lbool solver_solve_with_assumptions(Solver* s, const Lit* assumps, uint32_t n_as
                     }
                     fprintf(stderr, "\n");
                 }
-                solver_backtrack(s, n_assumps);  // Keep assumptions
-                s->stats.restarts++;
+                // Keep assumptions, unless imports from other portfolio
+                // workers are due (they need level 0). Due inprocessing
+                // rounds and checkpoints need level 0 too, so they rule
+                // out trail reuse.
+                PHASE_START(s, PHASE_RESTART);
+                if (s->share.exchange || checkpointing) {
+                    solver_restart(s, 0, false);
+                } else {
+                    solver_restart(s, n_assumps, !switching && !inprocess_due(s));
+                }
+                PHASE_STOP(s, PHASE_RESTART);
+
+                // Stable mode searches from the target phases
+                if (switching) mode_switch(s);
+                if (s->opts.modes && s->mode.stable) solver_rephase(s);
+
+                // Pull in clauses learned by other portfolio workers
+                if (s->share.exchange && s->decision_level == 0) {
+                    if (!exchange_import(s)) {
+                        s->result = FALSE;
+                        return solve_finish(s, FALSE, learnt_clause);
+                    }
+                }
+
+                if (checkpointing) checkpoint_save(s);
             }
 
             // Check for rephasing (Kissat-style target phases)
@@ -2793,45 +4219,58 @@ lbool solver_solve_with_assumptions(Solver* s, const Lit* assumps, uint32_t n_as
                 }
             }
 
-            // Try local search periodically
-            if (s->opts.local_search) {
-                s->local_search.conflicts_since++;
-                if (s->local_search.conflicts_since >= s->opts.ls_interval) {
-                    // Backtrack to level 0 before local search
-                    solver_backtrack(s, 0);
-                    if (solver_try_local_search(s)) {
-                        // Local search found a solution
-                        s->result = TRUE;
-                        if (s->elim) {
-                            elim_extend_model(s);
-                        }
-                        free(learnt_clause);
-                        return TRUE;
-                    }
+            // Try local search periodically (its models ignore assumptions)
+            if (s->opts.local_search && n_assumps == 0 && local_search_due(s)) {
+                // Backtrack to level 0 before local search
+                solver_backtrack(s, 0);
+                PHASE_START(s, PHASE_LOCAL_SEARCH);
+                bool found = solver_try_local_search(s);
+                PHASE_STOP(s, PHASE_LOCAL_SEARCH);
+                if (found) {
+                    // Local search found a solution
+                    return solve_finish(s, TRUE, learnt_clause);
                 }
             }
 
             // Reduce clause database periodically
             if (s->stats.conflicts % s->opts.reduce_interval == 0) {
+                PHASE_START(s, PHASE_REDUCE);
                 solver_reduce_db(s);
+                PHASE_STOP(s, PHASE_REDUCE);
             }
 
             // Simplify/vivify clauses periodically
-            solver_simplify(s);
+            if (!solver_simplify(s)) {
+                return solve_finish(s, FALSE, learnt_clause);
+            }
 
         } else {
-            // No conflict
-            if (!solver_decide(s)) {
-                // No more variables to decide = SAT
-                s->result = TRUE;
-
-                // Extend model to include eliminated variables (if BVE was used)
-                if (s->elim) {
-                    elim_extend_model(s);
+            // No conflict: place the next assumption, one per level
+            if (s->decision_level < n_assumps) {
+                Lit p = assumps[s->decision_level];
+                lbool value = lit_value(s, p);
+                if (value == UNDEF) {
+                    new_decision(s, p);
+                    continue;
+                }
+                if (value == FALSE) {
+                    // Assumption falsified by the formula and earlier assumptions
+                    analyze_final(s, neg(p));
+                    return solve_finish(s, FALSE, learnt_clause);
                 }
+                // Already true: open an empty level to keep levels aligned
+                s->decision_level++;
+                s->trail_lims[s->decision_level] = s->trail_size;
+                continue;
+            }
 
-                free(learnt_clause);
-                return TRUE;
+            PHASE_START(s, PHASE_DECIDE);
+            bool decided = solver_decide(s);
+            PHASE_STOP(s, PHASE_DECIDE);
+            if (!decided) {
+                // No more variables to decide = SAT (model extended to
+                // eliminated variables if BVE was used)
+                return solve_finish(s, TRUE, learnt_clause);
             }
 
             // Track best assignment for rephasing (Kissat-style target phases)
@@ -2839,22 +4278,23 @@ lbool solver_solve_with_assumptions(Solver* s, const Lit* assumps, uint32_t n_as
         }
 
         // Check resource limits
+        if (exchange_should_stop(s->share.exchange)) {
+            // Another portfolio worker already has the answer
+            return solve_finish(s, UNDEF, learnt_clause);
+        }
         if (s->opts.max_conflicts && s->stats.conflicts >= s->opts.max_conflicts) {
-            s->result = UNDEF;
-            free(learnt_clause);
-            return UNDEF;
+            return solve_finish(s, UNDEF, learnt_clause);
         }
         if (s->opts.max_decisions && s->stats.decisions >= s->opts.max_decisions) {
-            s->result = UNDEF;
-            free(learnt_clause);
-            return UNDEF;
+            return solve_finish(s, UNDEF, learnt_clause);
+        }
+        if (s->opts.max_ticks && s->stats.ticks >= s->opts.max_ticks) {
+            return solve_finish(s, UNDEF, learnt_clause);
         }
         if (s->opts.max_time > 0) {
             double elapsed = (double)clock() / CLOCKS_PER_SEC - s->stats.start_time;
             if (elapsed >= s->opts.max_time) {
-                s->result = UNDEF;
-                free(learnt_clause);
-                return UNDEF;
+                return solve_finish(s, UNDEF, learnt_clause);
             }
         }
     }
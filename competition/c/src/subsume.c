@@ -0,0 +1,374 @@
+/*********************************************************************
+ * BSAT Competition Solver - Backward Subsumption and Strengthening
+ *
+ * Occurrence-list subsumption with self-subsuming strengthening over
+ * the irredundant and tier-2 learned clauses (see subsume.h).
+ *********************************************************************/
+
+#define _POSIX_C_SOURCE 200809L  // clock_gettime
+
+#include "../include/subsume.h"
+#include "../include/solver.h"
+#include "../include/timer.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+/*********************************************************************
+ * Forward Declarations
+ *********************************************************************/
+
+// DRAT proof logging (defined in solver.c when proof is enabled)
+extern void proof_add_clause(Solver* s, const Lit* lits, uint32_t size);
+extern void proof_delete_clause(Solver* s, const Lit* lits, uint32_t size);
+
+// Append to the solver's clause list (defined in solver.c)
+extern bool clauses_push(Solver* s, CRef cref);
+
+/*********************************************************************
+ * Pass State
+ *********************************************************************/
+
+typedef struct Subsumer {
+    Solver*   s;
+    OccList*  occs;          // occs[lit] = candidate long clauses containing lit
+    uint32_t  num_lits;
+    uint8_t*  marks;         // Literals of the current subsumer
+    CRef*     queue;         // Long clauses to try as subsumers
+    uint32_t  queue_size;
+    uint32_t  queue_capacity;
+    Lit*      bins;          // Binary clauses made by strengthening, as pairs
+    uint32_t  bins_size;
+    uint32_t  bins_capacity;
+    Lit*      tmp;           // Strengthened clause under construction
+    uint64_t  visits;        // Effort spent so far
+    uint64_t  limit;         // Effort budget
+    uint32_t  subsumed;
+    uint32_t  strengthened;
+    bool      unsat;
+} Subsumer;
+
+static bool queue_push(Subsumer* sb, CRef cref) {
+    if (sb->queue_size >= sb->queue_capacity) {
+        uint32_t new_cap = sb->queue_capacity ? sb->queue_capacity * 2 : 1024;
+        CRef* new_queue = (CRef*)realloc(sb->queue, new_cap * sizeof(CRef));
+        if (!new_queue) return false;
+        sb->queue = new_queue;
+        sb->queue_capacity = new_cap;
+    }
+    sb->queue[sb->queue_size++] = cref;
+    return true;
+}
+
+static void bins_push(Subsumer* sb, Lit a, Lit b) {
+    if (sb->bins_size + 2 > sb->bins_capacity) {
+        uint32_t new_cap = sb->bins_capacity ? sb->bins_capacity * 2 : 64;
+        Lit* new_bins = (Lit*)realloc(sb->bins, new_cap * sizeof(Lit));
+        if (!new_bins) return;
+        sb->bins = new_bins;
+        sb->bins_capacity = new_cap;
+    }
+    sb->bins[sb->bins_size++] = a;
+    sb->bins[sb->bins_size++] = b;
+}
+
+// Assign a unit at level 0 (propagated at the end of the round)
+static void enqueue_unit(Solver* s, Lit unit) {
+    Var v = var(unit);
+    assign_lit(s, unit);
+    s->levels[v] = 0;
+    s->reasons[v] = INVALID_CLAUSE;
+    s->binary_reasons[v] = LIT_UNDEF;
+    s->trail_pos[v] = s->trail_size;
+    s->trail[s->trail_size].lit = unit;
+    s->trail[s->trail_size].level = 0;
+    s->trail_size++;
+}
+
+/*********************************************************************
+ * Candidates
+ *********************************************************************/
+
+// Irredundant or tier-2 learned, and not satisfied at level 0
+static bool is_candidate(const Solver* s, CRef cref) {
+    if (clause_deleted(s->arena, cref)) return false;
+    if (clause_learned(s->arena, cref) && clause_lbd(s->arena, cref) > s->opts.tier2_lbd) {
+        return false;
+    }
+    const Lit* lits = CLAUSE_LITS(s->arena, cref);
+    uint32_t size = CLAUSE_SIZE(s->arena, cref);
+    for (uint32_t i = 0; i < size; i++) {
+        if (lit_value(s, lits[i]) == TRUE) return false;
+    }
+    return true;
+}
+
+static int cmp_key(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+// Build the occurrence lists and the subsumer queue (by size, then by
+// reference). Returns false if memory ran out.
+static bool collect_candidates(Subsumer* sb) {
+    Solver* s = sb->s;
+    uint32_t total = s->num_clauses + s->num_learnts;
+    uint64_t* keys = (uint64_t*)malloc((total ? total : 1) * sizeof(uint64_t));
+    if (!keys) return false;
+
+    uint32_t n = 0, max_size = 0;
+    for (uint32_t i = 0; i < total; i++) {
+        CRef cref = i < s->num_clauses ? s->clauses[i] : s->learnts[i - s->num_clauses];
+        if (cref == INVALID_CLAUSE || !is_candidate(s, cref)) continue;
+        uint32_t size = CLAUSE_SIZE(s->arena, cref);
+        const Lit* lits = CLAUSE_LITS(s->arena, cref);
+        uint64_t sig = clause_signature(lits, size);
+        for (uint32_t j = 0; j < size; j++) {
+            if (!occ_push(&sb->occs[lits[j]], cref, sig)) {
+                free(keys);
+                return false;
+            }
+        }
+        keys[n++] = ((uint64_t)size << 32) | cref;
+        if (size > max_size) max_size = size;
+    }
+
+    qsort(keys, n, sizeof(uint64_t), cmp_key);
+    sb->tmp = (Lit*)malloc((max_size ? max_size : 1) * sizeof(Lit));
+    bool ok = sb->tmp != NULL;
+    for (uint32_t i = 0; i < n && ok; i++) {
+        ok = queue_push(sb, (CRef)keys[i]);
+    }
+    free(keys);
+    return ok;
+}
+
+/*********************************************************************
+ * Subsumption and Strengthening
+ *********************************************************************/
+
+// C subsumes D: delete D. A learned C that subsumes an irredundant D
+// takes its place among the irredundant clauses.
+static void remove_subsumed(Subsumer* sb, CRef c, CRef d) {
+    Solver* s = sb->s;
+    if (c != INVALID_CLAUSE && clause_learned(s->arena, c)) {
+        ClauseHeader* header = CLAUSE_HEADER(s->arena, c);
+        if (!clause_learned(s->arena, d)) {
+            if (!clauses_push(s, c)) return;
+            arena_promote(s->arena, c);
+        } else if (clause_lbd(s->arena, d) < header->lbd) {
+            header->lbd = clause_lbd(s->arena, d);
+        }
+    }
+
+    if (s->proof) {
+        proof_delete_clause(s, CLAUSE_LITS(s->arena, d), CLAUSE_SIZE(s->arena, d));
+    }
+    arena_delete(s->arena, d);
+    sb->subsumed++;
+}
+
+// Remove lit from D (level-0 false literals go as well)
+static void strengthen(Subsumer* sb, CRef d, Lit lit) {
+    Solver* s = sb->s;
+    Lit* lits = CLAUSE_LITS(s->arena, d);
+    uint32_t size = CLAUSE_SIZE(s->arena, d);
+
+    // Units found earlier in the round are not propagated yet
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < size; i++) {
+        lbool val = lit_value(s, lits[i]);
+        if (val == TRUE) return;
+        if (lits[i] != lit && val == UNDEF) sb->tmp[n++] = lits[i];
+    }
+
+    if (s->proof) {
+        proof_add_clause(s, sb->tmp, n);
+        proof_delete_clause(s, lits, size);
+    }
+    sb->strengthened++;
+
+    if (n == 0) {
+        sb->unsat = true;
+        return;
+    }
+    if (n <= 2) {
+        // Units and binaries leave the arena; the stale watches are
+        // dropped lazily by propagation
+        bool learned = clause_learned(s->arena, d);
+        arena_delete(s->arena, d);
+        if (n == 1) {
+            enqueue_unit(s, sb->tmp[0]);
+        } else {
+            watch_add_binary(s->watches, sb->tmp[0], sb->tmp[1]);
+            if (!learned) clauses_push(s, INVALID_CLAUSE);
+            bins_push(sb, sb->tmp[0], sb->tmp[1]);
+        }
+        return;
+    }
+
+    // The watches stay valid as long as both watched literals remain
+    // (they are the first two kept literals then)
+    bool rewatch = sb->tmp[0] != lits[0] || sb->tmp[1] != lits[1];
+    if (rewatch) watch_remove_clause(s->watches, s->arena, d);
+    memcpy(lits, sb->tmp, n * sizeof(Lit));
+    arena_shrink(s->arena, d, n);
+    if (clause_learned(s->arena, d) && clause_lbd(s->arena, d) > n) {
+        set_clause_lbd(s->arena, d, n);
+    }
+    if (rewatch) {
+        watch_add(s->watches, lits[0], d, lits[1]);
+        watch_add(s->watches, lits[1], d, lits[0]);
+    }
+
+    // The shorter clause may subsume others now
+    queue_push(sb, d);
+}
+
+// Try C (cref INVALID_CLAUSE for a binary clause) against the clauses
+// containing the variable of C that occurs least
+static void subsume_with(Subsumer* sb, const Lit* c, uint32_t size, CRef cref) {
+    Solver* s = sb->s;
+    uint64_t sig = clause_signature(c, size);
+
+    Lit best = c[0];
+    uint32_t best_count = UINT32_MAX;
+    for (uint32_t i = 0; i < size; i++) {
+        uint32_t count = sb->occs[c[i]].size + sb->occs[neg(c[i])].size;
+        if (count < best_count) {
+            best = c[i];
+            best_count = count;
+        }
+        sb->marks[c[i]] = 1;
+    }
+    sb->visits += size;
+
+    for (int side = 0; side < 2 && !sb->unsat; side++) {
+        const OccList* ol = &sb->occs[side ? neg(best) : best];
+        for (uint32_t k = 0; k < ol->size && !sb->unsat; k++) {
+            sb->visits++;
+            const Occ* o = &ol->occs[k];
+            if (o->cref == cref || (sig & ~o->sig)) continue;
+            CRef d = o->cref;
+            if (clause_deleted(s->arena, d)) continue;
+            uint32_t dsize = CLAUSE_SIZE(s->arena, d);
+            if (dsize < size) continue;
+
+            // Every literal of C in D, at most one of them negated
+            const Lit* dlits = CLAUSE_LITS(s->arena, d);
+            uint32_t found = 0;
+            Lit flipped = LIT_UNDEF;
+            bool fail = false;
+            for (uint32_t j = 0; j < dsize; j++) {
+                if (sb->marks[dlits[j]]) {
+                    found++;
+                } else if (sb->marks[neg(dlits[j])]) {
+                    if (flipped != LIT_UNDEF) {
+                        fail = true;
+                        break;
+                    }
+                    flipped = dlits[j];
+                    found++;
+                }
+            }
+            sb->visits += dsize;
+            if (fail || found < size) continue;
+
+            if (flipped == LIT_UNDEF) {
+                remove_subsumed(sb, cref, d);
+            } else {
+                strengthen(sb, d, flipped);
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < size; i++) sb->marks[c[i]] = 0;
+}
+
+/*********************************************************************
+ * Round
+ *********************************************************************/
+
+bool subsume_run(Solver* s, uint64_t effort) {
+    if (s->decision_level > 0) return true;
+    if (solver_propagate(s) != INVALID_CLAUSE) {
+        s->result = FALSE;
+        return false;
+    }
+
+    double start = now_seconds();
+    Subsumer sb;
+    memset(&sb, 0, sizeof(sb));
+    sb.s = s;
+    sb.num_lits = 2 * (s->num_vars + 1);
+    sb.limit = effort;
+    sb.occs = (OccList*)calloc(sb.num_lits, sizeof(OccList));
+    sb.marks = (uint8_t*)calloc(sb.num_lits, sizeof(uint8_t));
+
+    if (sb.occs && sb.marks && collect_candidates(&sb)) {
+        // Binary clauses first: they are never reduced, so they subsume
+        // without promotion
+        for (Lit lit = 2; lit < sb.num_lits && sb.visits < sb.limit && !sb.unsat; lit++) {
+            if (lit_value(s, lit) != UNDEF) continue;
+            const BinList* bl = bin_list(s->watches, lit);
+            for (uint32_t k = 0; k < bl->size && sb.visits < sb.limit && !sb.unsat; k++) {
+                Lit other = bl->lits[k];
+                if (other < lit || lit_value(s, other) != UNDEF) continue;
+                Lit pair[2] = { lit, other };
+                subsume_with(&sb, pair, 2, INVALID_CLAUSE);
+            }
+        }
+
+        // Then the long clauses, shortest first (the queue grows with
+        // strengthened clauses); binaries made on the way go right away
+        for (uint32_t i = 0; i < sb.queue_size && sb.visits < sb.limit && !sb.unsat; i++) {
+            CRef cref = sb.queue[i];
+            if (!clause_deleted(s->arena, cref)) {
+                subsume_with(&sb, CLAUSE_LITS(s->arena, cref), CLAUSE_SIZE(s->arena, cref), cref);
+            }
+            while (sb.bins_size > 0 && sb.visits < sb.limit && !sb.unsat) {
+                sb.bins_size -= 2;
+                Lit pair[2] = { sb.bins[sb.bins_size], sb.bins[sb.bins_size + 1] };
+                if (lit_value(s, pair[0]) == UNDEF && lit_value(s, pair[1]) == UNDEF) {
+                    subsume_with(&sb, pair, 2, INVALID_CLAUSE);
+                }
+            }
+        }
+    }
+
+    if (sb.occs) {
+        for (uint32_t i = 0; i < sb.num_lits; i++) free(sb.occs[i].occs);
+    }
+    free(sb.occs);
+    free(sb.marks);
+    free(sb.queue);
+    free(sb.bins);
+    free(sb.tmp);
+
+    // Drop deleted and promoted clauses from the learned list
+    uint32_t j = 0;
+    for (uint32_t i = 0; i < s->num_learnts; i++) {
+        CRef cref = s->learnts[i];
+        if (!clause_deleted(s->arena, cref) && clause_learned(s->arena, cref)) {
+            s->learnts[j++] = cref;
+        }
+    }
+    s->num_learnts = j;
+
+    s->stats.subsume_rounds++;
+    s->stats.subsume_removed += sb.subsumed;
+    s->stats.subsume_strengthened += sb.strengthened;
+    s->stats.subsume_time += now_seconds() - start;
+
+    if (IS_VERBOSE(s)) {
+        fprintf(stderr, "c [Subsume #%llu] Removed %u, strengthened %u, %llu/%llu visits\n",
+                (unsigned long long)s->stats.subsume_rounds, sb.subsumed, sb.strengthened,
+                (unsigned long long)sb.visits, (unsigned long long)sb.limit);
+    }
+
+    if (sb.unsat || solver_propagate(s) != INVALID_CLAUSE) {
+        s->result = FALSE;
+        return false;
+    }
+    return true;
+}
@@ -6,6 +6,116 @@
 #include <stdlib.h>
 #include <string.h>
 
+/*********************************************************************
+ * Watch Slab
+ *********************************************************************/
+
+// Size class of a block (bytes is a power of two between the bounds)
+static uint32_t slab_class(size_t bytes) {
+    uint32_t c = 0;
+    while (((size_t)WATCH_SLAB_MIN_BYTES << c) < bytes) c++;
+    return c;
+}
+
+static void slab_release(WatchSlab* slab, void* block, size_t bytes) {
+    if (!block) return;
+    if (bytes > WATCH_SLAB_MAX_BYTES) {
+        free(block);
+        slab->large_bytes -= bytes;
+        return;
+    }
+    uint32_t c = slab_class(bytes);
+    *(void**)block = slab->free_blocks[c];
+    slab->free_blocks[c] = block;
+    slab->free_bytes += bytes;
+}
+
+static void* slab_alloc(WatchSlab* slab, size_t bytes) {
+    if (bytes > WATCH_SLAB_MAX_BYTES) {
+        void* block = malloc(bytes);
+        if (block) slab->large_bytes += bytes;
+        return block;
+    }
+
+    uint32_t c = slab_class(bytes);
+    if (slab->free_blocks[c]) {
+        void* block = slab->free_blocks[c];
+        slab->free_blocks[c] = *(void**)block;
+        slab->free_bytes -= bytes;
+        return block;
+    }
+
+    if (slab->left < bytes) {
+        if (slab->num_chunks == slab->chunks_capacity) {
+            uint32_t new_cap = slab->chunks_capacity ? slab->chunks_capacity * 2 : 16;
+            char** grown = (char**)realloc(slab->chunks, new_cap * sizeof(char*));
+            if (!grown) return NULL;
+            slab->chunks = grown;
+            slab->chunks_capacity = new_cap;
+        }
+        char* chunk = (char*)malloc(WATCH_SLAB_CHUNK_BYTES);
+        if (!chunk) return NULL;
+
+        // The tail of the old chunk goes to the free lists of smaller classes
+        while (slab->left >= WATCH_SLAB_MIN_BYTES) {
+            size_t piece = WATCH_SLAB_MIN_BYTES;
+            while (piece * 2 <= slab->left) piece *= 2;
+            slab_release(slab, slab->next, piece);
+            slab->next += piece;
+            slab->left -= piece;
+        }
+
+        slab->chunks[slab->num_chunks++] = chunk;
+        slab->next = chunk;
+        slab->left = WATCH_SLAB_CHUNK_BYTES;
+    }
+
+    void* block = slab->next;
+    slab->next += bytes;
+    slab->left -= bytes;
+    return block;
+}
+
+// Move a list's first used_bytes to a block of new_bytes
+static void* slab_grow(WatchSlab* slab, void* block, size_t old_bytes,
+                       size_t new_bytes, size_t used_bytes) {
+    if (old_bytes > WATCH_SLAB_MAX_BYTES) {
+        void* grown = realloc(block, new_bytes);
+        if (grown) slab->large_bytes += new_bytes - old_bytes;
+        return grown;
+    }
+
+    void* grown = slab_alloc(slab, new_bytes);
+    if (!grown) return NULL;
+    if (used_bytes) memcpy(grown, block, used_bytes);
+    slab_release(slab, block, old_bytes);
+    return grown;
+}
+
+static void watchlist_push(WatchManager* wm, WatchList* wl, Watch w) {
+    if (wl->size == wl->capacity) {
+        uint32_t new_cap = wl->capacity ? wl->capacity * 2 : 16;
+        Watch* grown = (Watch*)slab_grow(&wm->slab, wl->watches, wl->capacity * sizeof(Watch),
+                                         new_cap * sizeof(Watch), wl->size * sizeof(Watch));
+        if (!grown) return;
+        wl->watches = grown;
+        wl->capacity = new_cap;
+    }
+    wl->watches[wl->size++] = w;
+}
+
+static void binlist_push(WatchManager* wm, BinList* bl, Lit other) {
+    if (bl->size == bl->capacity) {
+        uint32_t new_cap = bl->capacity ? bl->capacity * 2 : 4;
+        Lit* grown = (Lit*)slab_grow(&wm->slab, bl->lits, bl->capacity * sizeof(Lit),
+                                     new_cap * sizeof(Lit), bl->size * sizeof(Lit));
+        if (!grown) return;
+        bl->lits = grown;
+        bl->capacity = new_cap;
+    }
+    bl->lits[bl->size++] = other;
+}
+
 /*********************************************************************
  * Watch Manager
  *********************************************************************/
@@ -20,7 +130,10 @@ WatchManager* watch_init(uint32_t num_vars) {
     // We allocate for literals 0..2*num_vars+1 to handle 1-based variables
     uint32_t num_lits = 2 * (num_vars + 1);
     wm->lists = (WatchList*)calloc(num_lits, sizeof(WatchList));
-    if (!wm->lists) {
+    wm->bins = (BinList*)calloc(num_lits, sizeof(BinList));
+    if (!wm->lists || !wm->bins) {
+        free(wm->lists);
+        free(wm->bins);
         free(wm);
         return NULL;
     }
@@ -40,11 +153,18 @@ bool watch_resize(WatchManager* wm, uint32_t new_num_vars) {
     if (!new_lists) return false;
     wm->lists = new_lists;
 
-    // Initialize new watch lists to empty
+    BinList* new_bins = (BinList*)realloc(wm->bins, new_num_lits * sizeof(BinList));
+    if (!new_bins) return false;
+    wm->bins = new_bins;
+
+    // Initialize new watch and binary lists to empty
     for (uint32_t i = old_num_lits; i < new_num_lits; i++) {
         wm->lists[i].watches = NULL;
         wm->lists[i].size = 0;
         wm->lists[i].capacity = 0;
+        wm->bins[i].lits = NULL;
+        wm->bins[i].size = 0;
+        wm->bins[i].capacity = 0;
     }
 
     wm->num_vars = new_num_vars;
@@ -54,14 +174,23 @@ bool watch_resize(WatchManager* wm, uint32_t new_num_vars) {
 void watch_free(WatchManager* wm) {
     if (!wm) return;
 
-    if (wm->lists) {
-        uint32_t num_lits = 2 * (wm->num_vars + 1);
-        for (uint32_t i = 0; i < num_lits; i++) {
+    // Only arrays beyond the largest class live outside the slab
+    uint32_t num_lits = 2 * (wm->num_vars + 1);
+    for (uint32_t i = 0; i < num_lits; i++) {
+        if (wm->lists[i].capacity * sizeof(Watch) > WATCH_SLAB_MAX_BYTES) {
             free(wm->lists[i].watches);
         }
-        free(wm->lists);
+        if (wm->bins[i].capacity * sizeof(Lit) > WATCH_SLAB_MAX_BYTES) {
+            free(wm->bins[i].lits);
+        }
     }
+    free(wm->lists);
+    free(wm->bins);
 
+    for (uint32_t i = 0; i < wm->slab.num_chunks; i++) {
+        free(wm->slab.chunks[i]);
+    }
+    free(wm->slab.chunks);
     free(wm);
 }
 
@@ -71,20 +200,46 @@ void watch_clear(WatchManager* wm) {
     uint32_t num_lits = 2 * (wm->num_vars + 1);
     for (uint32_t i = 0; i < num_lits; i++) {
         wm->lists[i].size = 0;
+        wm->bins[i].size = 0;
     }
 
     wm->updates = 0;
     wm->visits = 0;
     wm->skipped = 0;
+    wm->binary_visits = 0;
 }
 
 void watch_add(WatchManager* wm, Lit lit, CRef cref, Lit blocker) {
     WatchList* wl = watch_list(wm, lit);
     Watch w = {cref, blocker};
-    watchlist_push(wl, w);
+    watchlist_push(wm, wl, w);
     wm->updates++;
 }
 
+void watch_add_binary(WatchManager* wm, Lit a, Lit b) {
+    // a false implies b, b false implies a
+    binlist_push(wm, bin_list(wm, a), b);
+    binlist_push(wm, bin_list(wm, b), a);
+    wm->updates += 2;
+}
+
+// Remove one occurrence of other from lit's implication list
+static bool binlist_remove(BinList* bl, Lit other) {
+    for (uint32_t i = 0; i < bl->size; i++) {
+        if (bl->lits[i] == other) {
+            bl->lits[i] = bl->lits[--bl->size];
+            return true;
+        }
+    }
+    return false;
+}
+
+bool watch_remove_binary(WatchManager* wm, Lit a, Lit b) {
+    bool found_a = binlist_remove(bin_list(wm, a), b);
+    bool found_b = binlist_remove(bin_list(wm, b), a);
+    return found_a && found_b;
+}
+
 void watch_remove_clause(WatchManager* wm, Arena* arena, CRef cref) {
     if (!wm || !arena || cref == INVALID_CLAUSE) return;
 
@@ -92,29 +247,8 @@ void watch_remove_clause(WatchManager* wm, Arena* arena, CRef cref) {
     uint32_t size = CLAUSE_SIZE(arena, cref);
     Lit* lits = CLAUSE_LITS(arena, cref);
 
-    // For binary clauses, both literals watch each other
-    if (size == 2) {
-        // Remove from first literal's watch list
-        WatchList* wl0 = watch_list(wm, lits[0]);
-        for (uint32_t i = 0; i < wl0->size; i++) {
-            if (wl0->watches[i].cref == cref ||
-                (is_binary_watch(wl0->watches[i]) && wl0->watches[i].blocker == lits[1])) {
-                watchlist_remove(wl0, i);
-                break;
-            }
-        }
-
-        // Remove from second literal's watch list
-        WatchList* wl1 = watch_list(wm, lits[1]);
-        for (uint32_t i = 0; i < wl1->size; i++) {
-            if (wl1->watches[i].cref == cref ||
-                (is_binary_watch(wl1->watches[i]) && wl1->watches[i].blocker == lits[0])) {
-                watchlist_remove(wl1, i);
-                break;
-            }
-        }
-    } else if (size > 2) {
-        // For larger clauses, only first two literals are watched
+    if (size >= 2) {
+        // Only the first two literals are watched
         WatchList* wl0 = watch_list(wm, lits[0]);
         for (uint32_t i = 0; i < wl0->size; i++) {
             if (wl0->watches[i].cref == cref) {
@@ -145,19 +279,19 @@ WatchStats watch_stats(const WatchManager* wm) {
     uint32_t num_lits = 2 * (wm->num_vars + 1);
 
     for (uint32_t i = 0; i < num_lits; i++) {
-        const WatchList* wl = &wm->lists[i];
-        stats.total_watches += wl->size;
-
-        for (uint32_t j = 0; j < wl->size; j++) {
-            if (is_binary_watch(wl->watches[j])) {
-                stats.binary_watches++;
-            }
-        }
+        stats.long_watches += wm->lists[i].size;
+        stats.binary_watches += wm->bins[i].size;
     }
+    stats.total_watches = stats.long_watches + stats.binary_watches;
+    stats.binary_clauses = stats.binary_watches / 2;
 
     stats.updates = wm->updates;
     stats.visits = wm->visits;
     stats.skipped = wm->skipped;
+    stats.binary_visits = wm->binary_visits;
+    stats.slab_bytes = (size_t)wm->slab.num_chunks * WATCH_SLAB_CHUNK_BYTES;
+    stats.slab_free_bytes = wm->slab.free_bytes;
+    stats.large_bytes = wm->slab.large_bytes;
 
     if (stats.visits > 0) {
         stats.skip_rate = 100.0 * stats.skipped / stats.visits;
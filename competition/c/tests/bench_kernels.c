@@ -0,0 +1,432 @@
+/*********************************************************************
+ * BSAT C Solver - Kernel Microbenchmarks
+ *
+ * Times the hot kernels in isolation, on generated inputs that are the
+ * same on every run:
+ *   parse      dimacs_parse_string on an in-memory random 3-SAT (MB/s)
+ *   propagate  solver_propagate along a fixed decision sequence (props/s)
+ *   analyze    solver_analyze on the conflicts of that sequence (conflicts/s)
+ *   reduce     one solver_reduce_db over a full learned database (ms)
+ *   gc         arena collection of a half-deleted arena (MB/s moved)
+ *
+ * Every kernel runs --repeats times; the JSON report on stdout (or -o)
+ * has the samples, mean, standard deviation and range of each. With
+ * --baseline FILE, the means are compared against an earlier report and
+ * the exit status is 1 if any kernel is more than --tolerance percent
+ * worse.
+ *
+ * Usage: bench_kernels [--repeats N] [--scale F] [-o FILE]
+ *                      [--baseline FILE] [--tolerance PCT]
+ *********************************************************************/
+
+#define _POSIX_C_SOURCE 200809L  // clock_gettime
+
+#include "../include/arena.h"
+#include "../include/dimacs.h"
+#include "../include/solver.h"
+#include "../include/timer.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Required for linking (normally defined in main.c)
+bool g_verbose = false;
+
+#define MAX_REPEATS 100
+
+typedef struct Kernel {
+    const char* name;
+    const char* unit;
+    bool        higher_is_better;
+    double      samples[MAX_REPEATS];
+    uint32_t    count;
+} Kernel;
+
+/*********************************************************************
+ * Helpers
+ *********************************************************************/
+
+static uint64_t next_random(uint64_t* seed) {
+    *seed ^= *seed << 13;
+    *seed ^= *seed >> 7;
+    *seed ^= *seed << 17;
+    return *seed;
+}
+
+static void die(const char* msg) {
+    fprintf(stderr, "bench_kernels: %s\n", msg);
+    exit(2);
+}
+
+// Random 3-SAT over distinct variables, as DIMACS text
+static char* random_cnf(uint32_t num_vars, uint32_t num_clauses, uint64_t seed, size_t* bytes) {
+    size_t cap = 32 + (size_t)num_clauses * 40;
+    char* buf = (char*)malloc(cap);
+    if (!buf) die("out of memory");
+    size_t n = (size_t)sprintf(buf, "p cnf %u %u\n", num_vars, num_clauses);
+    for (uint32_t c = 0; c < num_clauses; c++) {
+        uint32_t vars[3];
+        for (int k = 0; k < 3; k++) {
+            uint32_t v;
+            do {
+                v = (uint32_t)(next_random(&seed) % num_vars) + 1;
+            } while ((k > 0 && v == vars[0]) || (k > 1 && v == vars[1]));
+            vars[k] = v;
+            n += (size_t)sprintf(buf + n, "%s%u ", (seed >> 32) & 1 ? "-" : "", v);
+        }
+        n += (size_t)sprintf(buf + n, "0\n");
+    }
+    *bytes = n;
+    return buf;
+}
+
+static Solver* quiet_solver(void) {
+    SolverOpts opts = default_opts();
+    opts.quiet = true;
+    Solver* s = solver_new_with_opts(&opts);
+    if (!s) die("out of memory");
+    return s;
+}
+
+/*********************************************************************
+ * Kernels
+ *
+ * Each returns one sample; setup and teardown are not timed.
+ *********************************************************************/
+
+static double bench_parse(double scale) {
+    uint32_t num_clauses = (uint32_t)(1000000 * scale);
+    size_t bytes;
+    char* cnf = random_cnf(num_clauses / 4, num_clauses, 1, &bytes);
+    Solver* s = quiet_solver();
+
+    double start = now_seconds();
+    if (dimacs_parse_string(s, cnf) != DIMACS_OK) die("parse failed");
+    double elapsed = now_seconds() - start;
+
+    solver_free(s);
+    free(cnf);
+    return (double)bytes / (1 << 20) / elapsed;
+}
+
+// The same decisions on the same formula give the same trails, so only
+// the kernel changes between two builds. Decisions continue after each
+// conflict from level 0, without learning.
+typedef struct Replay {
+    Solver*  s;
+    Lit*     decisions;
+    uint32_t num_decisions;
+    Lit*     learnt;
+} Replay;
+
+static Replay replay_new(double scale) {
+    Replay r;
+    uint32_t num_vars = (uint32_t)(50000 * scale);
+    size_t bytes;
+    char* cnf = random_cnf(num_vars, num_vars * 4, 2, &bytes);
+    r.s = quiet_solver();
+    if (dimacs_parse_string(r.s, cnf) != DIMACS_OK) die("parse failed");
+    free(cnf);
+    if (solver_propagate(r.s) != INVALID_CLAUSE) die("formula is UNSAT at level 0");
+
+    uint64_t seed = 3;
+    r.num_decisions = num_vars;
+    r.decisions = (Lit*)malloc(num_vars * sizeof(Lit));
+    r.learnt = (Lit*)malloc((num_vars + 1) * sizeof(Lit));
+    if (!r.decisions || !r.learnt) die("out of memory");
+    for (uint32_t i = 0; i < num_vars; i++) {
+        r.decisions[i] = mkLit(i + 1, next_random(&seed) & 1);
+    }
+    for (uint32_t i = num_vars - 1; i > 0; i--) {
+        uint32_t j = (uint32_t)(next_random(&seed) % (i + 1));
+        Lit t = r.decisions[i];
+        r.decisions[i] = r.decisions[j];
+        r.decisions[j] = t;
+    }
+    return r;
+}
+
+static void replay_free(Replay* r) {
+    solver_free(r->s);
+    free(r->decisions);
+    free(r->learnt);
+}
+
+// Run the decision sequence; with analyze set, only the analysis of the
+// conflicts is timed and the result is conflicts per second
+static double replay_run(Replay* r, bool analyze) {
+    Solver* s = r->s;
+    uint64_t props = s->stats.propagations;
+    uint64_t conflicts = 0;
+    double analyze_time = 0;
+
+    double start = now_seconds();
+    for (uint32_t i = 0; i < r->num_decisions; i++) {
+        Lit lit = r->decisions[i];
+        if (lit_value(s, lit) != UNDEF) continue;
+        solver_new_decision(s, lit);
+        CRef conflict = solver_propagate(s);
+        if (conflict == INVALID_CLAUSE) continue;
+
+        conflicts++;
+        if (analyze) {
+            uint32_t size;
+            Level level;
+            double t0 = now_seconds();
+            solver_analyze(s, conflict, r->learnt, &size, &level);
+            analyze_time += now_seconds() - t0;
+        }
+        solver_backtrack(s, 0);
+    }
+    solver_backtrack(s, 0);
+    double elapsed = now_seconds() - start;
+
+    if (analyze) {
+        if (conflicts == 0) die("decision sequence has no conflicts");
+        return conflicts / analyze_time;
+    }
+    return (s->stats.propagations - props) / elapsed;
+}
+
+static double bench_propagate(double scale) {
+    Replay r = replay_new(scale);
+    double rate = replay_run(&r, false);
+    replay_free(&r);
+    return rate;
+}
+
+static double bench_analyze(double scale) {
+    Replay r = replay_new(scale);
+    double rate = replay_run(&r, true);
+    replay_free(&r);
+    return rate;
+}
+
+// A small formula with many imported learned clauses of mixed LBD
+static double bench_reduce(double scale) {
+    uint32_t num_vars = 2000;
+    uint32_t num_learnts = (uint32_t)(100000 * scale);
+    size_t bytes;
+    char* cnf = random_cnf(num_vars, num_vars * 2, 4, &bytes);
+    Solver* s = quiet_solver();
+    if (dimacs_parse_string(s, cnf) != DIMACS_OK) die("parse failed");
+    free(cnf);
+
+    uint64_t seed = 5;
+    Lit lits[32];
+    for (uint32_t i = 0; i < num_learnts; i++) {
+        // Consecutive variables from a random start are distinct
+        uint32_t size = 4 + (uint32_t)(next_random(&seed) % 28);
+        Var base = (Var)(next_random(&seed) % (num_vars - 32)) + 1;
+        for (uint32_t k = 0; k < size; k++) {
+            lits[k] = mkLit(base + k, next_random(&seed) & 1);
+        }
+        uint32_t lbd = 2 + (uint32_t)(next_random(&seed) % (size - 1));
+        if (!solver_import_clause(s, lits, size, lbd)) die("import failed");
+    }
+
+    double start = now_seconds();
+    solver_reduce_db(s);
+    double elapsed = now_seconds() - start;
+
+    if (s->stats.deleted_clauses == 0) die("reduction deleted nothing");
+    solver_free(s);
+    return elapsed * 1e3;
+}
+
+// Clauses of 3..12 literals, every other one deleted
+static double bench_gc(double scale) {
+    uint32_t num_clauses = (uint32_t)(1000000 * scale);
+    Arena* arena = arena_init(estimate_arena_size(num_clauses, 1000));
+    CRef* crefs = (CRef*)malloc(num_clauses * sizeof(CRef));
+    if (!arena || !crefs) die("out of memory");
+
+    uint64_t seed = 6;
+    Lit lits[12];
+    for (uint32_t i = 0; i < num_clauses; i++) {
+        uint32_t size = 3 + (uint32_t)(next_random(&seed) % 10);
+        for (uint32_t k = 0; k < size; k++) lits[k] = mkLit(k + 1, next_random(&seed) & 1);
+        crefs[i] = arena_alloc(arena, lits, size, true);
+        if (crefs[i] == INVALID_CLAUSE) die("out of memory");
+    }
+    for (uint32_t i = 0; i < num_clauses; i += 2) arena_delete(arena, crefs[i]);
+    size_t live = (arena->size - arena->wasted) * sizeof(uint32_t);
+
+    double start = now_seconds();
+    if (!arena_gc_begin(arena)) die("out of memory");
+    for (uint32_t i = 0; i < num_clauses; i++) crefs[i] = arena_gc_move(arena, crefs[i]);
+    arena_gc_end(arena);
+    double elapsed = now_seconds() - start;
+
+    free(crefs);
+    arena_free(arena);
+    return (double)live / (1 << 20) / elapsed;
+}
+
+/*********************************************************************
+ * Report
+ *********************************************************************/
+
+static double kernel_mean(const Kernel* k) {
+    double sum = 0;
+    for (uint32_t i = 0; i < k->count; i++) sum += k->samples[i];
+    return sum / k->count;
+}
+
+static double kernel_stddev(const Kernel* k) {
+    if (k->count < 2) return 0;
+    double mean = kernel_mean(k);
+    double sum = 0;
+    for (uint32_t i = 0; i < k->count; i++) {
+        double d = k->samples[i] - mean;
+        sum += d * d;
+    }
+    return sqrt(sum / (k->count - 1));
+}
+
+static void write_report(FILE* out, const Kernel* kernels, int num_kernels,
+                         uint32_t repeats, double scale) {
+    fprintf(out, "{\n  \"benchmark\": \"bsat_kernels\",\n");
+    fprintf(out, "  \"repeats\": %u,\n  \"scale\": %g,\n  \"kernels\": {\n", repeats, scale);
+    for (int i = 0; i < num_kernels; i++) {
+        const Kernel* k = &kernels[i];
+        double min = k->samples[0], max = k->samples[0];
+        for (uint32_t j = 1; j < k->count; j++) {
+            if (k->samples[j] < min) min = k->samples[j];
+            if (k->samples[j] > max) max = k->samples[j];
+        }
+        double mean = kernel_mean(k), stddev = kernel_stddev(k);
+        fprintf(out, "    \"%s\": {\"unit\": \"%s\", \"better\": \"%s\", ",
+                k->name, k->unit, k->higher_is_better ? "higher" : "lower");
+        fprintf(out, "\"mean\": %.6g, \"stddev\": %.6g, \"cv\": %.4f, \"min\": %.6g, \"max\": %.6g, ",
+                mean, stddev, mean > 0 ? stddev / mean : 0.0, min, max);
+        fprintf(out, "\"samples\": [");
+        for (uint32_t j = 0; j < k->count; j++) {
+            fprintf(out, "%s%.6g", j ? ", " : "", k->samples[j]);
+        }
+        fprintf(out, "]}%s\n", i + 1 < num_kernels ? "," : "");
+    }
+    fprintf(out, "  }\n}\n");
+}
+
+// Mean of a kernel in a report written by write_report (NAN if absent)
+static double baseline_mean(const char* report, const char* name) {
+    char key[64];
+    snprintf(key, sizeof(key), "\"%s\": {", name);
+    const char* p = strstr(report, key);
+    if (!p) return NAN;
+    p = strstr(p, "\"mean\": ");
+    if (!p) return NAN;
+    return strtod(p + 8, NULL);
+}
+
+static char* read_file(const char* path) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return NULL;
+    fseek(f, 0, SEEK_END);
+    long len = ftell(f);
+    rewind(f);
+    char* buf = (char*)malloc((size_t)len + 1);
+    if (buf && fread(buf, 1, (size_t)len, f) != (size_t)len) {
+        free(buf);
+        buf = NULL;
+    }
+    if (buf) buf[len] = '\0';
+    fclose(f);
+    return buf;
+}
+
+// Number of kernels more than tolerance percent worse than the baseline
+static int compare_baseline(const char* report, const Kernel* kernels, int num_kernels,
+                            double tolerance) {
+    int regressions = 0;
+    for (int i = 0; i < num_kernels; i++) {
+        const Kernel* k = &kernels[i];
+        double base = baseline_mean(report, k->name);
+        if (isnan(base) || base <= 0) {
+            fprintf(stderr, "  %-10s no baseline\n", k->name);
+            continue;
+        }
+        double mean = kernel_mean(k);
+        double change = 100.0 * (mean - base) / base;
+        double worse = k->higher_is_better ? -change : change;
+        bool regressed = worse > tolerance;
+        fprintf(stderr, "  %-10s %12.4g -> %12.4g %-10s %+6.1f%%%s\n",
+                k->name, base, mean, k->unit, change, regressed ? "  REGRESSION" : "");
+        if (regressed) regressions++;
+    }
+    return regressions;
+}
+
+/*********************************************************************
+ * Main
+ *********************************************************************/
+
+int main(int argc, char** argv) {
+    uint32_t repeats = 5;
+    double scale = 1.0;
+    double tolerance = 10.0;
+    const char* output = NULL;
+    const char* baseline = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        bool has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--repeats") == 0 && has_value) {
+            repeats = (uint32_t)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--scale") == 0 && has_value) {
+            scale = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--tolerance") == 0 && has_value) {
+            tolerance = atof(argv[++i]);
+        } else if (strcmp(argv[i], "-o") == 0 && has_value) {
+            output = argv[++i];
+        } else if (strcmp(argv[i], "--baseline") == 0 && has_value) {
+            baseline = argv[++i];
+        } else {
+            fprintf(stderr, "Usage: %s [--repeats N] [--scale F] [-o FILE] "
+                    "[--baseline FILE] [--tolerance PCT]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (repeats < 1 || repeats > MAX_REPEATS) die("--repeats must be between 1 and 100");
+    if (scale <= 0) die("--scale must be positive");
+
+    Kernel kernels[] = {
+        { "parse",     "MB/s",        true,  {0}, 0 },
+        { "propagate", "props/s",     true,  {0}, 0 },
+        { "analyze",   "conflicts/s", true,  {0}, 0 },
+        { "reduce",    "ms",          false, {0}, 0 },
+        { "gc",        "MB/s",        true,  {0}, 0 },
+    };
+    double (*const run[])(double) = {
+        bench_parse, bench_propagate, bench_analyze, bench_reduce, bench_gc
+    };
+    const int num_kernels = (int)(sizeof(kernels) / sizeof(kernels[0]));
+
+    for (int i = 0; i < num_kernels; i++) {
+        fprintf(stderr, "c %-10s", kernels[i].name);
+        for (uint32_t r = 0; r < repeats; r++) {
+            kernels[i].samples[kernels[i].count++] = run[i](scale);
+        }
+        fprintf(stderr, " %12.4g %s (cv %.1f%%)\n", kernel_mean(&kernels[i]), kernels[i].unit,
+                100.0 * kernel_stddev(&kernels[i]) / kernel_mean(&kernels[i]));
+    }
+
+    FILE* out = stdout;
+    if (output && !(out = fopen(output, "w"))) die("cannot write the report");
+    write_report(out, kernels, num_kernels, repeats, scale);
+    if (out != stdout) fclose(out);
+
+    if (baseline) {
+        char* report = read_file(baseline);
+        if (!report) die("cannot read the baseline");
+        fprintf(stderr, "c Against %s (tolerance %.1f%%):\n", baseline, tolerance);
+        int regressions = compare_baseline(report, kernels, num_kernels, tolerance);
+        free(report);
+        if (regressions > 0) {
+            fprintf(stderr, "c %d kernel(s) regressed\n", regressions);
+            return 1;
+        }
+    }
+    return 0;
+}
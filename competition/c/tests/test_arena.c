@@ -345,6 +345,229 @@ void test_arena_growth() {
     PASS();
 }
 
+void test_mapped_growth() {
+    TEST("Clauses survive growth into and within the mapping");
+
+    // 16 words (malloc'd) to 8M words: on Linux the arena switches to a
+    // mapping at 2 MB and is then grown with mremap
+    Arena* arena = arena_init(16);
+    const uint32_t num = 1500000;
+    for (uint32_t i = 0; i < num; i++) {
+        Lit lits[3] = {mkLit(i % 1000 + 1, false), mkLit(i, true), mkLit(7, i & 1)};
+        if (arena_alloc(arena, lits, 3, i % 3 == 0) == INVALID_CLAUSE) {
+            FAIL("Allocation failed during growth");
+        }
+    }
+    if (arena->num_growths < 10) FAIL("Arena should have grown repeatedly");
+#ifdef __linux__
+    if (!arena_stats(arena).mapped) FAIL("Large arena should be mapped");
+#endif
+
+    // Walk the clauses back in allocation order
+    size_t pos = 1;
+    for (uint32_t i = 0; i < num; i++) {
+        CRef cref = (CRef)(pos + (i % 3 == 0 ? ACTIVITY_WORDS : 0));
+        Lit* lits = CLAUSE_LITS(arena, cref);
+        if (CLAUSE_SIZE(arena, cref) != 3 || clause_learned(arena, cref) != (i % 3 == 0) ||
+            lits[0] != mkLit(i % 1000 + 1, false) || lits[1] != mkLit(i, true) ||
+            lits[2] != mkLit(7, i & 1)) {
+            FAIL("Clause changed while the arena grew");
+        }
+        pos = cref + HEADER_WORDS + 3;
+    }
+
+    arena_free(arena);
+    PASS();
+}
+
+void test_shrink_accounting() {
+    TEST("Clause shrinking tracks wasted space");
+
+    Arena* arena = arena_init(1024);
+
+    Lit lits[5] = {mkLit(1, false), mkLit(2, false), mkLit(3, false), mkLit(4, false), mkLit(5, false)};
+    CRef cref = arena_alloc(arena, lits, 5, true);
+    arena_shrink(arena, cref, 3);
+
+    if (CLAUSE_SIZE(arena, cref) != 3) {
+        FAIL("Shrunk clause should have size 3");
+    }
+    if (arena->wasted != 2) {
+        FAIL("Dropped literals should count as wasted");
+    }
+
+    // Growing is not shrinking
+    arena_shrink(arena, cref, 4);
+    if (CLAUSE_SIZE(arena, cref) != 3 || arena->wasted != 2) {
+        FAIL("arena_shrink must not grow a clause");
+    }
+
+    arena_free(arena);
+    PASS();
+}
+
+void test_garbage_collection() {
+    TEST("Garbage collection moves live clauses");
+
+    Arena* arena = arena_init(1024);
+
+    CRef crefs[10];
+    for (int i = 0; i < 10; i++) {
+        Lit lits[4] = {mkLit(i + 1, false), mkLit(i + 2, true), mkLit(i + 3, false), mkLit(i + 4, true)};
+        crefs[i] = arena_alloc(arena, lits, 4, i % 2 == 1);
+        set_clause_lbd(arena, crefs[i], i + 2);
+    }
+    for (int i = 0; i < 10; i += 3) {
+        arena_delete(arena, crefs[i]);
+    }
+    arena_shrink(arena, crefs[1], 3);
+
+    if (arena->num_clauses != 6) {
+        FAIL("Arena should count 6 live clauses");
+    }
+    if (!arena_gc_due(arena)) {
+        FAIL("Collection should be due with 40% waste");
+    }
+
+    if (!arena_gc_begin(arena)) {
+        FAIL("Collection failed to start");
+    }
+    CRef moved[10];
+    for (int i = 0; i < 10; i++) {
+        moved[i] = arena_gc_move(arena, crefs[i]);
+    }
+
+    // Moving the same reference twice follows the forwarding address
+    if (arena_gc_move(arena, crefs[1]) != moved[1]) {
+        FAIL("Second move should return the forwarding address");
+    }
+    arena_gc_end(arena);
+
+    for (int i = 0; i < 10; i++) {
+        if (i % 3 == 0) {
+            if (moved[i] != INVALID_CLAUSE) FAIL("Deleted clause should not be moved");
+            continue;
+        }
+        uint32_t expected_size = (i == 1) ? 3 : 4;
+        if (CLAUSE_SIZE(arena, moved[i]) != expected_size) FAIL("Size changed by collection");
+        if (CLAUSE_LITS(arena, moved[i])[0] != mkLit(i + 1, false)) FAIL("Literals changed by collection");
+        if (clause_lbd(arena, moved[i]) != (uint32_t)i + 2) FAIL("LBD changed by collection");
+        if (clause_learned(arena, moved[i]) != (i % 2 == 1)) FAIL("Flags changed by collection");
+    }
+
+    if (arena->wasted != 0 || arena_gc_due(arena)) {
+        FAIL("Collected arena should have no waste");
+    }
+    // Originals 2, 4, 8 take 2 + 4 words; learned 5 and 7 one more for
+    // their activity, and shrunk learned 1 one less
+    if (arena->size != 1 + 3 * (2 + 4) + 2 * (1 + 2 + 4) + (1 + 2 + 3)) {
+        FAIL("Collected arena should hold exactly the live clauses");
+    }
+
+    arena_free(arena);
+    PASS();
+}
+
+void test_generational_collection() {
+    TEST("Minor collection leaves tenured clauses in place");
+
+    Arena* arena = arena_init(1024);
+
+    Lit lits[3] = {mkLit(1, false), mkLit(2, false), mkLit(3, false)};
+    CRef keeper = arena_alloc(arena, lits, 3, false);
+    CRef young = arena_alloc(arena, lits, 3, true);
+
+    // First collection promotes the keeper only
+    if (!arena_gc_begin(arena)) FAIL("Collection failed to start");
+    keeper = arena_gc_move(arena, keeper);
+    arena_gc_tenure(arena);
+    young = arena_gc_move(arena, young);
+    arena_gc_end(arena);
+    if (arena->tenured + ACTIVITY_WORDS != young) FAIL("Young region should start after the keeper");
+
+    CRef doomed = arena_alloc(arena, lits, 3, true);
+    CRef late = arena_alloc(arena, lits, 2, true);
+    arena_delete(arena, doomed);
+    if (arena->tenured_wasted != 0 || !arena_gc_due(arena)) {
+        FAIL("Young deletion should make a minor collection due");
+    }
+
+    if (!arena_gc_begin(arena)) FAIL("Collection failed to start");
+    if (arena_gc_move(arena, keeper) != keeper) FAIL("Tenured clause should not move");
+    young = arena_gc_move(arena, young);
+    late = arena_gc_move(arena, late);
+    arena_gc_end(arena);
+
+    if (arena->num_collections != 2 || arena->num_major != 1) {
+        FAIL("Expected one major and one minor collection");
+    }
+    if (CLAUSE_SIZE(arena, late) != 2 || !clause_learned(arena, late)) FAIL("Young clause damaged");
+    if (arena->size != 1 + 5 + 6 + 5 || arena->wasted != 0) FAIL("Young region should be compacted");
+
+    // Waste in the tenured region triggers a major collection
+    arena_delete(arena, keeper);
+    if (arena->tenured_wasted != 5 || !arena_gc_due(arena)) FAIL("Tenured waste not tracked");
+    if (!arena_gc_begin(arena)) FAIL("Collection failed to start");
+    if (arena_gc_move(arena, keeper) != INVALID_CLAUSE) FAIL("Deleted tenured clause should be dropped");
+    young = arena_gc_move(arena, young);
+    late = arena_gc_move(arena, late);
+    arena_gc_end(arena);
+    if (arena->num_major != 2 || young != 1 + ACTIVITY_WORDS || arena->tenured != 1) {
+        FAIL("Major collection should restart at 1");
+    }
+
+    arena_free(arena);
+    PASS();
+}
+
+void test_compact_header() {
+    TEST("Only learned clauses carry an activity word");
+
+    Arena* arena = arena_init(1024);
+
+    if (sizeof(ClauseHeader) != 8) FAIL("Header should take two words");
+
+    Lit lits[3] = {mkLit(1, false), mkLit(2, false), mkLit(3, false)};
+    CRef original = arena_alloc(arena, lits, 3, false);
+    if (arena->size != 1 + 2 + 3) FAIL("Original clause should take 5 words");
+    if (clause_activity(arena, original) != 0.0f) FAIL("Original clause has no activity");
+
+    CRef learned = arena_alloc(arena, lits, 3, true);
+    if (learned != 1 + 5 + 1 || arena->size != 1 + 5 + 6) FAIL("Learned clause should take 6 words");
+    bump_clause_activity(arena, learned, 2.0f);
+    set_clause_lbd(arena, learned, 3);
+    CLAUSE_HEADER(arena, learned)->used = 2;
+    if (CLAUSE_SIZE(arena, original) != 3 || clause_lbd(arena, original) != 0) {
+        FAIL("Activity must not overwrite the previous clause");
+    }
+
+    // Collection keeps activity, LBD and used
+    if (!arena_gc_begin(arena)) FAIL("Collection failed to start");
+    original = arena_gc_move(arena, original);
+    learned = arena_gc_move(arena, learned);
+    arena_gc_end(arena);
+    if (clause_activity(arena, learned) != 2.0f || clause_lbd(arena, learned) != 3 ||
+        CLAUSE_HEADER(arena, learned)->used != 2) {
+        FAIL("Metadata changed by collection");
+    }
+
+    // A promoted clause leaves its activity word behind as waste
+    arena_promote(arena, learned);
+    if (clause_learned(arena, learned) || arena->wasted != ACTIVITY_WORDS) {
+        FAIL("Promotion should waste the activity word");
+    }
+    if (!arena_gc_begin(arena)) FAIL("Collection failed to start");
+    original = arena_gc_move(arena, original);
+    learned = arena_gc_move(arena, learned);
+    arena_gc_end(arena);
+    if (learned != 1 + 5 || arena->size != 1 + 5 + 5 || CLAUSE_LITS(arena, learned)[2] != lits[2]) {
+        FAIL("Promoted clause should be stored as an original");
+    }
+
+    arena_free(arena);
+    PASS();
+}
+
 /*********************************************************************
  * Main Test Runner
  *********************************************************************/
@@ -365,11 +588,16 @@ int main(void) {
     test_activity_operations();
     test_clause_deletion();
     test_arena_stats();
+    test_shrink_accounting();
+    test_garbage_collection();
+    test_generational_collection();
+    test_compact_header();
 
     // Edge cases
     test_empty_clause();
     test_large_clause();
     test_arena_growth();
+    test_mapped_growth();
 
     printf("\n========================================\n");
     printf("Results: %d/%d tests passed\n", tests_passed, tests_run);
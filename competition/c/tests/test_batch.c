@@ -0,0 +1,175 @@
+/*********************************************************************
+ * BSAT C Solver - Batch Solving Unit Tests
+ *
+ * Tests for solver_reset and for batch solving of listed files and
+ * framed formulas.
+ *********************************************************************/
+
+#define _POSIX_C_SOURCE 200809L  // mkstemp
+
+#include "../include/batch.h"
+#include "../include/dimacs.h"
+#include "test_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// Required for linking (normally defined in main.c)
+bool g_verbose = false;
+
+// Test counter
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define TEST(name) \
+    do { \
+        printf("Testing %s... ", name); \
+        tests_run++; \
+    } while (0)
+
+#define PASS() \
+    do { \
+        printf("✅ PASS\n"); \
+        tests_passed++; \
+    } while (0)
+
+#define FAIL(msg) \
+    do { \
+        printf("❌ FAIL: %s\n", msg); \
+        exit(1); \
+    } while (0)
+
+/*********************************************************************
+ * Helpers
+ *********************************************************************/
+
+static const char* small_sat =
+    "p cnf 5 6\n"
+    "1 2 0\n"
+    "-1 3 0\n"
+    "-2 -3 0\n"
+    "3 4 5 0\n"
+    "-4 1 0\n"
+    "-5 -1 0\n";
+
+/*********************************************************************
+ * Test Cases
+ *********************************************************************/
+
+void test_reset_matches_fresh_solver() {
+    TEST("Reset solver repeats a fresh solver's search");
+
+    SolverOpts opts = default_opts();
+    opts.quiet = true;
+    char* php = pigeonhole_cnf(6);
+    if (!php) FAIL("Out of memory");
+
+    Solver* fresh = solver_new_with_opts(&opts);
+    if (dimacs_parse_string(fresh, php) != DIMACS_OK) FAIL("Parse failed");
+    if (solver_solve(fresh) != FALSE) FAIL("Pigeonhole is UNSAT");
+
+    // A larger formula first, so the reset solver has spare capacity
+    Solver* reused = solver_new_with_opts(&opts);
+    char* big = pigeonhole_cnf(7);
+    if (!big) FAIL("Out of memory");
+    if (dimacs_parse_string(reused, big) != DIMACS_OK) FAIL("Parse failed");
+    solver_solve(reused);
+    uint32_t capacity = reused->var_capacity;
+
+    if (!solver_reset(reused, &opts)) FAIL("Reset failed");
+    if (reused->num_vars != 0 || reused->num_clauses != 0 || reused->stats.conflicts != 0) {
+        FAIL("Reset must clear the formula and statistics");
+    }
+    if (dimacs_parse_string(reused, php) != DIMACS_OK) FAIL("Parse failed");
+    if (reused->var_capacity != capacity) FAIL("Reset must keep the variable capacity");
+    if (solver_solve(reused) != FALSE) FAIL("Pigeonhole is UNSAT");
+
+    if (reused->stats.conflicts != fresh->stats.conflicts ||
+        reused->stats.decisions != fresh->stats.decisions) {
+        FAIL("Search after reset differs from a fresh solver");
+    }
+
+    // Options may change between formulas
+    opts.vmtf = true;
+    if (!solver_reset(reused, &opts)) FAIL("Reset failed");
+    if (dimacs_parse_string(reused, small_sat) != DIMACS_OK) FAIL("Parse failed");
+    if (solver_solve(reused) != TRUE) FAIL("Formula is SAT");
+
+    solver_free(fresh);
+    solver_free(reused);
+    free(php);
+    free(big);
+    PASS();
+}
+
+void test_batch_paths_and_frames() {
+    TEST("Batch solving of paths and frames");
+
+    char cnf_path[32];
+    strcpy(cnf_path, "/tmp/bsat_batch_XXXXXX");
+    int fd = mkstemp(cnf_path);
+    if (fd < 0) FAIL("Could not create temp file");
+    FILE* f = fdopen(fd, "w");
+    char* php = pigeonhole_cnf(4);
+    if (!php) FAIL("Out of memory");
+    fputs(php, f);
+    fclose(f);
+
+    // Path, comment, frame, missing file, frame
+    FILE* in = tmpfile();
+    FILE* out = tmpfile();
+    if (!in || !out) FAIL("Could not create temp files");
+    fprintf(in, "%s\n# comment\n\n@%zu\n%s", cnf_path, strlen(small_sat), small_sat);
+    fprintf(in, "/nonexistent/bsat.cnf\n@%zu\n%s", strlen(php), php);
+    rewind(in);
+
+    SolverOpts opts = default_opts();
+    BatchOpts bopts = { 2, true };
+    BatchStats stats;
+    if (!batch_solve(&opts, in, out, &bopts, &stats)) FAIL("Batch failed");
+
+    if (stats.instances != 4 || stats.sat != 1 || stats.unsat != 2 || stats.errors != 1) {
+        FAIL("Wrong batch totals");
+    }
+
+    // Lines come in completion order; find each id
+    const char* expected[4] = { "\"UNSAT\"", "\"SAT\"", "\"ERROR\"", "\"UNSAT\"" };
+    bool seen[4] = { false, false, false, false };
+    char line[4096];
+    rewind(out);
+    while (fgets(line, sizeof(line), out)) {
+        unsigned id;
+        if (sscanf(line, "{\"id\": %u", &id) != 1 || id >= 4) FAIL("Malformed line");
+        if (!strstr(line, expected[id])) FAIL("Wrong result for an item");
+        if (id == 1 && !strstr(line, "\"model\": [")) FAIL("SAT line without model");
+        if (id == 0 && !strstr(line, "\"input\": \"/tmp/bsat_batch_")) FAIL("Missing input path");
+        seen[id] = true;
+    }
+    if (!seen[0] || !seen[1] || !seen[2] || !seen[3]) FAIL("Missing result lines");
+
+    fclose(in);
+    fclose(out);
+    unlink(cnf_path);
+    free(php);
+    PASS();
+}
+
+/*********************************************************************
+ * Main Test Runner
+ *********************************************************************/
+
+int main() {
+    printf("========================================\n");
+    printf("BSAT Batch Solving Unit Tests\n");
+    printf("========================================\n\n");
+
+    test_reset_matches_fresh_solver();
+    test_batch_paths_and_frames();
+
+    printf("\n========================================\n");
+    printf("Results: %d/%d tests passed\n", tests_passed, tests_run);
+    printf("========================================\n");
+
+    return (tests_passed == tests_run) ? 0 : 1;
+}
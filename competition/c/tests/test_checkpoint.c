@@ -0,0 +1,332 @@
+/*********************************************************************
+ * BSAT C Solver - Checkpoint and Resume Unit Tests
+ *
+ * Tests for saving the search state mid-run and continuing from it:
+ * restored clause database and heuristic state, answers and models of
+ * resumed runs (with variable elimination), periodic checkpoints at
+ * restarts, and refusal of damaged files and of other inputs.
+ *********************************************************************/
+
+#define _POSIX_C_SOURCE 200809L  // mkstemp
+
+#include "../include/checkpoint.h"
+#include "../include/solver.h"
+#include "../include/dimacs.h"
+#include "test_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// Required for linking (normally defined in main.c)
+bool g_verbose = false;
+
+// Test counter
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define TEST(name) \
+    do { \
+        printf("Testing %s... ", name); \
+        tests_run++; \
+    } while (0)
+
+#define PASS() \
+    do { \
+        printf("✅ PASS\n"); \
+        tests_passed++; \
+    } while (0)
+
+#define FAIL(msg) \
+    do { \
+        printf("❌ FAIL: %s\n", msg); \
+        exit(1); \
+    } while (0)
+
+/*********************************************************************
+ * Helpers
+ *********************************************************************/
+
+#define FORMULA_MAX_CLAUSES 1024
+
+// Random 3-SAT formula as DIMACS text, kept for model checks
+typedef struct Formula {
+    char dimacs[32 + FORMULA_MAX_CLAUSES * 3 * 12];
+} Formula;
+
+static void random_formula(Formula* f, uint64_t seed, uint32_t num_vars, uint32_t num_clauses) {
+    uint64_t rng = seed;
+    int len = sprintf(f->dimacs, "p cnf %u %u\n", num_vars, num_clauses);
+    for (uint32_t i = 0; i < num_clauses; i++) {
+        for (uint32_t k = 0; k < 3; k++) {
+            int v = 1 + (int)rng_below(&rng, num_vars);
+            len += sprintf(f->dimacs + len, "%d ", rng_below(&rng, 2) ? -v : v);
+        }
+        len += sprintf(f->dimacs + len, "0\n");
+    }
+}
+
+static Solver* new_solver(const SolverOpts* opts, const Formula* f) {
+    Solver* s = solver_new_with_opts(opts);
+    if (!s) FAIL("Cannot create solver");
+    if (f && dimacs_parse_string(s, f->dimacs) != DIMACS_OK) FAIL("Cannot parse formula");
+    return s;
+}
+
+static SolverOpts quiet_opts(void) {
+    SolverOpts opts = default_opts();
+    opts.quiet = true;
+    return opts;
+}
+
+/*********************************************************************
+ * Test Cases
+ *********************************************************************/
+
+void test_state_restored() {
+    TEST("A stopped search leaves a checkpoint of its state");
+
+    char path[64];
+    if (!make_temp(path)) FAIL("Cannot create temp file");
+
+    Formula f;
+    random_formula(&f, 7, 150, 640);
+    SolverOpts opts = quiet_opts();
+    opts.max_conflicts = 500;
+    opts.checkpoint_path = path;
+    Solver* s = new_solver(&opts, &f);
+    if (solver_solve(s) != UNDEF) FAIL("Search should hit the conflict limit");
+    if (s->checkpoint.written != 1) FAIL("The stop should write one checkpoint");
+
+    Solver* r = new_solver(&opts, NULL);
+    const char* error = NULL;
+    if (!checkpoint_load(r, path, NULL, &error)) FAIL(error);
+
+    if (r->num_vars != s->num_vars || r->num_clauses != s->num_clauses) FAIL("Formula size differs");
+    if (r->num_learnts != s->num_learnts) FAIL("Learned clauses differ");
+    if (r->arena->size != s->arena->size ||
+        memcmp(r->arena->memory, s->arena->memory, s->arena->size * sizeof(uint32_t)) != 0) {
+        FAIL("Arena differs");
+    }
+    if (r->trail_size != s->trail_size) FAIL("Level-0 units differ");
+    if (r->stats.conflicts != s->stats.conflicts || r->stats.ticks != s->stats.ticks) FAIL("Statistics differ");
+    if (r->rng != s->rng || r->restart.threshold != s->restart.threshold ||
+        r->restart.slow_ma != s->restart.slow_ma) {
+        FAIL("Restart state differs");
+    }
+    for (Var v = 1; v <= s->num_vars; v++) {
+        if (r->order.activity[v] != s->order.activity[v]) FAIL("Activities differ");
+        if (r->vars[v].polarity != s->vars[v].polarity) FAIL("Saved phases differ");
+        if (r->rephase.best_phase[v] != s->rephase.best_phase[v]) FAIL("Best phases differ");
+    }
+    if (!r->incremental.preprocessed) FAIL("Preprocessing should be marked done");
+
+    solver_free(s);
+    solver_free(r);
+    unlink(path);
+    PASS();
+}
+
+void test_resumed_answers() {
+    TEST("Resumed runs give the answers of uninterrupted ones");
+
+    char path[64];
+    if (!make_temp(path)) FAIL("Cannot create temp file");
+
+    uint32_t resumes = 0;
+    for (uint64_t seed = 1; seed <= 12; seed++) {
+        Formula f;
+        random_formula(&f, seed, 120, 500 + 5 * (uint32_t)seed);
+
+        SolverOpts opts = quiet_opts();
+        opts.elim = seed % 2 == 0;
+        opts.modes = seed % 3 == 0;
+        Solver* ref = new_solver(&opts, &f);
+        lbool expected = solver_solve(ref);
+        solver_free(ref);
+
+        // Run in slices of 100 conflicts, each from the previous checkpoint
+        opts.checkpoint_path = path;
+        opts.max_conflicts = 100;
+        Solver* s = new_solver(&opts, &f);
+        lbool result = solver_solve(s);
+        while (result == UNDEF) {
+            solver_free(s);
+            opts.max_conflicts += 100;
+            s = new_solver(&opts, NULL);
+            const char* error = NULL;
+            if (!checkpoint_load(s, path, NULL, &error)) FAIL(error);
+            result = solver_solve(s);
+            resumes++;
+        }
+
+        if (result != expected) FAIL("Answers differ");
+        if (result == TRUE && !model_satisfies(s, f.dimacs)) FAIL("Model violates a clause");
+        solver_free(s);
+    }
+    if (resumes == 0) FAIL("No run was resumed");
+
+    unlink(path);
+    PASS();
+}
+
+void test_periodic_checkpoints() {
+    TEST("Checkpoints are written at restarts once the interval passed");
+
+    char path[64];
+    if (!make_temp(path)) FAIL("Cannot create temp file");
+
+    Formula f;
+    random_formula(&f, 3, 150, 640);
+    SolverOpts opts = quiet_opts();
+    opts.max_conflicts = 2000;
+    opts.checkpoint_path = path;
+    opts.checkpoint_interval = 0;
+    Solver* s = new_solver(&opts, &f);
+    lbool result = solver_solve(s);
+    if (s->checkpoint.written < 2) FAIL("Every restart should write one");
+    if (result == UNDEF && s->checkpoint.written != s->stats.restarts + 1) {
+        FAIL("One per restart and one at the stop");
+    }
+    solver_free(s);
+
+    // Calls with assumptions depend on them: no checkpoints
+    opts.checkpoint_interval = 600;
+    unlink(path);
+    s = new_solver(&opts, &f);
+    Lit assumption = mkLit(1, false);
+    solver_solve_with_assumptions(s, &assumption, 1);
+    if (s->checkpoint.written != 0 || access(path, F_OK) == 0) FAIL("Assumptions should not checkpoint");
+    solver_free(s);
+
+    PASS();
+}
+
+void test_damaged_files() {
+    TEST("Damaged and foreign files are refused");
+
+    char path[64];
+    if (!make_temp(path)) FAIL("Cannot create temp file");
+
+    Formula f;
+    random_formula(&f, 11, 150, 640);
+    SolverOpts opts = quiet_opts();
+    opts.max_conflicts = 300;
+    opts.checkpoint_path = path;
+    Solver* s = new_solver(&opts, &f);
+    solver_solve(s);
+
+    // A solver that already has a formula
+    const char* error = NULL;
+    if (checkpoint_load(s, path, NULL, &error) || !error) FAIL("Loading needs an empty solver");
+    solver_free(s);
+
+    FILE* in = fopen(path, "rb");
+    if (!in) FAIL("Cannot read checkpoint");
+    fseek(in, 0, SEEK_END);
+    long size = ftell(in);
+    fseek(in, 0, SEEK_SET);
+    unsigned char* data = (unsigned char*)malloc(size);
+    if (fread(data, 1, size, in) != (size_t)size) FAIL("Cannot read checkpoint");
+    fclose(in);
+
+    // One flipped byte, a cut off tail, a foreign file
+    long cuts[3] = { size, size / 2, size };
+    for (int k = 0; k < 3; k++) {
+        if (k == 0) data[size - 16] ^= 0x40;
+        if (k == 2) memcpy(data, "NOTACKPT", 8);
+        FILE* out = fopen(path, "wb");
+        fwrite(data, 1, cuts[k], out);
+        fclose(out);
+
+        Solver* r = new_solver(&opts, NULL);
+        error = NULL;
+        if (checkpoint_load(r, path, NULL, &error) || !error) FAIL("Damaged file should be refused");
+        solver_free(r);
+    }
+
+    Solver* r = new_solver(&opts, NULL);
+    if (checkpoint_load(r, "/nonexistent/checkpoint", NULL, &error)) FAIL("Missing file should fail");
+    solver_free(r);
+
+    free(data);
+    unlink(path);
+    PASS();
+}
+
+// Write f as a DIMACS file
+static void write_dimacs(const char* path, const Formula* f) {
+    FILE* out = fopen(path, "w");
+    if (!out) FAIL("Cannot write formula");
+    fputs(f->dimacs, out);
+    fclose(out);
+}
+
+void test_other_input_refused() {
+    TEST("A checkpoint is only resumed against its own input");
+
+    char path[64], cnf_a[64], cnf_b[64];
+    if (!make_temp(path) || !make_temp(cnf_a) || !make_temp(cnf_b)) FAIL("Cannot create temp file");
+
+    // Same size and shape, different clauses
+    Formula a, b;
+    random_formula(&a, 21, 150, 640);
+    random_formula(&b, 22, 150, 640);
+    write_dimacs(cnf_a, &a);
+    write_dimacs(cnf_b, &b);
+
+    CheckpointInput input_a, input_b, again;
+    if (!checkpoint_input(cnf_a, &input_a) || !checkpoint_input(cnf_b, &input_b) ||
+        !checkpoint_input(cnf_a, &again)) {
+        FAIL("Cannot fingerprint input");
+    }
+    if (input_a.size != again.size || input_a.hash != again.hash) FAIL("Fingerprint should be stable");
+    if (input_a.hash == input_b.hash) FAIL("Different inputs should differ");
+    if (checkpoint_input("/nonexistent/input.cnf", &again)) FAIL("Missing input has no fingerprint");
+
+    SolverOpts opts = quiet_opts();
+    opts.max_conflicts = 300;
+    opts.checkpoint_path = path;
+    Solver* s = new_solver(&opts, &a);
+    s->checkpoint.input_size = input_a.size;
+    s->checkpoint.input_hash = input_a.hash;
+    solver_solve(s);
+    solver_free(s);
+
+    const char* error = NULL;
+    Solver* r = new_solver(&opts, NULL);
+    if (checkpoint_load(r, path, &input_b, &error) || !error) FAIL("Other input should be refused");
+    solver_free(r);
+
+    r = new_solver(&opts, NULL);
+    if (!checkpoint_load(r, path, &input_a, &error)) FAIL(error);
+    if (r->checkpoint.input_hash != input_a.hash) FAIL("Fingerprint should carry over");
+    solver_free(r);
+
+    unlink(path);
+    unlink(cnf_a);
+    unlink(cnf_b);
+    PASS();
+}
+
+/*********************************************************************
+ * Main Test Runner
+ *********************************************************************/
+
+int main() {
+    printf("========================================\n");
+    printf("BSAT Checkpoint Unit Tests\n");
+    printf("========================================\n\n");
+
+    test_state_restored();
+    test_resumed_answers();
+    test_periodic_checkpoints();
+    test_damaged_files();
+    test_other_input_refused();
+
+    printf("\n========================================\n");
+    printf("Results: %d/%d tests passed\n", tests_passed, tests_run);
+    printf("========================================\n");
+
+    return (tests_passed == tests_run) ? 0 : 1;
+}
@@ -0,0 +1,307 @@
+/*********************************************************************
+ * BSAT C Solver - Cube-and-Conquer Unit Tests
+ *
+ * Tests for lookahead cube generation, cube file parsing, and
+ * conquering cubes with resumable results.
+ *********************************************************************/
+
+#define _POSIX_C_SOURCE 200809L  // mkstemp, fdopen
+
+#include "../include/cube.h"
+#include "test_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// Required for linking (normally defined in main.c)
+bool g_verbose = false;
+
+// Test counter
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define TEST(name) \
+    do { \
+        printf("Testing %s... ", name); \
+        tests_run++; \
+    } while (0)
+
+#define PASS() \
+    do { \
+        printf("✅ PASS\n"); \
+        tests_passed++; \
+    } while (0)
+
+#define FAIL(msg) \
+    do { \
+        printf("❌ FAIL: %s\n", msg); \
+        exit(1); \
+    } while (0)
+
+/*********************************************************************
+ * Helpers
+ *********************************************************************/
+
+static bool write_file(const char* path, const char* text) {
+    FILE* f = fopen(path, "w");
+    if (!f) return false;
+    fputs(text, f);
+    fclose(f);
+    return true;
+}
+
+// Count the lines of a results file that report the given status
+static uint32_t count_status(const char* path, const char* status) {
+    FILE* f = fopen(path, "r");
+    if (!f) return 0;
+    uint32_t count = 0;
+    char line[256], word[16];
+    unsigned cube;
+    while (fgets(line, sizeof(line), f)) {
+        if (sscanf(line, "%u %15s", &cube, word) == 2 && strcmp(word, status) == 0) count++;
+    }
+    fclose(f);
+    return count;
+}
+
+// Generate cubes for a DIMACS string into cube_path
+static lbool generate(const char* cnf, uint32_t depth, const char* cube_path, CubeGenStats* stats) {
+    Solver* s = solver_new();
+    if (dimacs_parse_string(s, cnf) != DIMACS_OK) FAIL("Parse failed");
+    FILE* out = fopen(cube_path, "w");
+    if (!out) FAIL("Cannot open cube file");
+    lbool result = cube_generate(s, depth, out, stats);
+    fclose(out);
+    if (s->decision_level != 0) FAIL("Generator must return to level 0");
+    solver_free(s);
+    return result;
+}
+
+/*********************************************************************
+ * Test Cases
+ *********************************************************************/
+
+void test_probe_at_level() {
+    TEST("Probing above level 0 keeps the current level");
+
+    // (x1 ∨ x2) ∧ (~x2 ∨ x3) ∧ (~x4 ∨ x5) ∧ (~x4 ∨ ~x5 ∨ x1)
+    Solver* s = solver_new();
+    dimacs_parse_string(s, "p cnf 5 4\n1 2 0\n-2 3 0\n-4 5 0\n-4 -5 1 0\n");
+
+    if (!solver_decide_literal(s, mkLit(1, true))) FAIL("~x1 should not conflict");
+    if (var_value(s, 3) != TRUE) FAIL("~x1 should imply x3");
+
+    // Under ~x1, x4 implies x5 and then falsifies the last clause
+    uint32_t implied = 0;
+    if (solver_probe(s, mkLit(4, false), &implied)) FAIL("x4 should fail under ~x1");
+    if (!solver_probe(s, mkLit(4, true), &implied) || implied != 1) {
+        FAIL("~x4 should succeed and assign only itself");
+    }
+    if (s->decision_level != 1 || var_value(s, 3) != TRUE || var_value(s, 4) != UNDEF) {
+        FAIL("Probe must restore the level it started from");
+    }
+
+    solver_backtrack(s, 0);
+    if (var_value(s, 1) != UNDEF || var_value(s, 2) != UNDEF) {
+        FAIL("Backtrack to 0 should clear level 1");
+    }
+
+    solver_free(s);
+    PASS();
+}
+
+void test_read_cube_file() {
+    TEST("Cube file parsing");
+
+    char path[32];
+    if (!make_temp(path)) FAIL("Could not create temp file");
+    write_file(path, "c comment\na 1 -2 0\na 3 0\n\na -4 5 -6 0\n");
+
+    CubeSet set;
+    if (!cube_read_file(path, &set)) FAIL("Failed to read cube file");
+    if (set.num_cubes != 3) FAIL("Expected 3 cubes");
+    if (set.start[1] != 2 || set.start[2] != 3 || set.start[3] != 6) FAIL("Wrong cube boundaries");
+    if (set.lits[1] != mkLit(2, true) || set.lits[3] != mkLit(4, true)) FAIL("Wrong literals");
+    if (set.max_var != 6) FAIL("Wrong max_var");
+    cube_set_free(&set);
+
+    // A cube without terminating 0 is an error
+    write_file(path, "a 1 2\n");
+    if (cube_read_file(path, &set)) FAIL("Truncated cube should fail");
+
+    unlink(path);
+    PASS();
+}
+
+void test_generate_covers_unsat() {
+    TEST("Generated cubes of PHP(6,5) are all refuted");
+
+    char* cnf = pigeonhole_cnf(5);
+    if (!cnf) FAIL("Out of memory");
+    char cube_path[32], cnf_path[32];
+    if (!make_temp(cube_path) || !make_temp(cnf_path)) FAIL("Could not create temp files");
+    write_file(cnf_path, cnf);
+
+    CubeGenStats stats;
+    lbool gen = generate(cnf, 4, cube_path, &stats);
+    if (gen != UNDEF) FAIL("Pigeonhole should not be refuted by lookahead alone");
+    if (stats.cubes == 0 || stats.cubes > 16) FAIL("Depth 4 gives between 1 and 16 cubes");
+
+    CubeSet cubes;
+    if (!cube_read_file(cube_path, &cubes)) FAIL("Cannot read generated cubes");
+    if (cubes.num_cubes != stats.cubes) FAIL("File and stats disagree");
+
+    SolverOpts opts = default_opts();
+    opts.quiet = true;
+    CubeSolveOpts copts = { NULL, 2, 0, 1 };
+    Solver* s = NULL;
+    DimacsError err;
+    lbool result = cube_solve(&opts, cnf_path, &cubes, &copts, &s, &err);
+
+    if (err != DIMACS_OK) FAIL("Cube solve parse failed");
+    if (result != FALSE) FAIL("All cubes of PHP(6,5) should be UNSAT");
+
+    solver_free(s);
+    cube_set_free(&cubes);
+    unlink(cube_path);
+    unlink(cnf_path);
+    free(cnf);
+    PASS();
+}
+
+void test_cube_solve_sat() {
+    TEST("Cube solving finds a model");
+
+    const char* cnf =
+        "p cnf 5 6\n"
+        "1 2 0\n"
+        "-1 3 0\n"
+        "-2 -3 0\n"
+        "3 4 5 0\n"
+        "-4 1 0\n"
+        "-5 -1 0\n";
+    char cube_path[32], cnf_path[32];
+    if (!make_temp(cube_path) || !make_temp(cnf_path)) FAIL("Could not create temp files");
+    write_file(cnf_path, cnf);
+    write_file(cube_path, "a -1 0\na 1 0\n");
+
+    CubeSet cubes;
+    cube_read_file(cube_path, &cubes);
+
+    SolverOpts opts = default_opts();
+    opts.quiet = true;
+    CubeSolveOpts copts = { NULL, 1, 0, 1 };
+    Solver* s = NULL;
+    DimacsError err;
+    lbool result = cube_solve(&opts, cnf_path, &cubes, &copts, &s, &err);
+
+    if (err != DIMACS_OK || !s) FAIL("Cube solve failed");
+    if (result != TRUE) FAIL("Formula is SAT");
+
+    bool x[6];
+    for (Var v = 1; v <= 5; v++) x[v] = solver_model_value(s, v) == TRUE;
+    if (!((x[1] || x[2]) && (!x[1] || x[3]) && (!x[2] || !x[3]) &&
+          (x[3] || x[4] || x[5]) && (!x[4] || x[1]) && (!x[5] || !x[1]))) {
+        FAIL("Model does not satisfy formula");
+    }
+
+    solver_free(s);
+    cube_set_free(&cubes);
+    unlink(cube_path);
+    unlink(cnf_path);
+    PASS();
+}
+
+void test_resume_and_nodes() {
+    TEST("Results file resume and node split");
+
+    char* cnf = pigeonhole_cnf(4);
+    if (!cnf) FAIL("Out of memory");
+    char cube_path[32], cnf_path[32], res_path[32];
+    if (!make_temp(cube_path) || !make_temp(cnf_path) || !make_temp(res_path)) {
+        FAIL("Could not create temp files");
+    }
+    write_file(cnf_path, cnf);
+    write_file(cube_path, "a 1 0\na -1 2 0\na -1 -2 0\n");
+
+    CubeSet cubes;
+    cube_read_file(cube_path, &cubes);
+    SolverOpts opts = default_opts();
+    opts.quiet = true;
+    Solver* s = NULL;
+    DimacsError err;
+
+    // Node 0 of 2 owns cubes 0 and 2: refutes them but cannot claim UNSAT
+    CubeSolveOpts copts = { res_path, 1, 0, 2 };
+    lbool result = cube_solve(&opts, cnf_path, &cubes, &copts, &s, &err);
+    solver_free(s);
+    if (result != UNDEF) FAIL("A partial node must not report UNSAT");
+    if (count_status(res_path, "UNSAT") != 2) FAIL("Node 0 should log 2 refuted cubes");
+
+    // Single node resumes from the log and only solves cube 1
+    copts.node = 0;
+    copts.num_nodes = 1;
+    result = cube_solve(&opts, cnf_path, &cubes, &copts, &s, &err);
+    solver_free(s);
+    if (result != FALSE) FAIL("Resumed run should finish UNSAT");
+    if (count_status(res_path, "UNSAT") != 3) FAIL("Resume should add exactly one cube");
+
+    cube_set_free(&cubes);
+    unlink(cube_path);
+    unlink(cnf_path);
+    unlink(res_path);
+    free(cnf);
+    PASS();
+}
+
+void test_foreign_cubes_rejected() {
+    TEST("Cubes over unknown variables are rejected");
+
+    char cube_path[32], cnf_path[32];
+    if (!make_temp(cube_path) || !make_temp(cnf_path)) FAIL("Could not create temp files");
+    write_file(cnf_path, "p cnf 2 1\n1 2 0\n");
+    write_file(cube_path, "a 7 0\n");
+
+    CubeSet cubes;
+    cube_read_file(cube_path, &cubes);
+    SolverOpts opts = default_opts();
+    opts.quiet = true;
+    CubeSolveOpts copts = { NULL, 1, 0, 1 };
+    Solver* s = NULL;
+    DimacsError err;
+    cube_solve(&opts, cnf_path, &cubes, &copts, &s, &err);
+    if (err == DIMACS_OK) FAIL("Variable 7 does not exist in the formula");
+
+    solver_free(s);
+    cube_set_free(&cubes);
+    unlink(cube_path);
+    unlink(cnf_path);
+    PASS();
+}
+
+/*********************************************************************
+ * Main Test Runner
+ *********************************************************************/
+
+int main() {
+    printf("========================================\n");
+    printf("BSAT Cube-and-Conquer Unit Tests\n");
+    printf("========================================\n\n");
+
+    // Building blocks
+    test_probe_at_level();
+    test_read_cube_file();
+
+    // Cube and conquer
+    test_generate_covers_unsat();
+    test_cube_solve_sat();
+    test_resume_and_nodes();
+    test_foreign_cubes_rejected();
+
+    printf("\n========================================\n");
+    printf("Results: %d/%d tests passed\n", tests_passed, tests_run);
+    printf("========================================\n");
+
+    return (tests_passed == tests_run) ? 0 : 1;
+}
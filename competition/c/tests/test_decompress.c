@@ -0,0 +1,315 @@
+/*********************************************************************
+ * BSAT C Solver - Compressed Input Unit Tests
+ *
+ * Tests for format detection and for parsing gzip, xz and zstd input
+ * through the threaded decompressor. Compressed test data is produced
+ * with the codec libraries themselves, so only codecs built into this
+ * binary are exercised.
+ *********************************************************************/
+
+#define _POSIX_C_SOURCE 200809L  // mkstemp
+
+#include "../include/dimacs.h"
+#include "../include/decompress.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#ifdef BSAT_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef BSAT_HAVE_LZMA
+#include <lzma.h>
+#endif
+#ifdef BSAT_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+// Required for linking (normally defined in main.c)
+bool g_verbose = false;
+
+// Test counter
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define TEST(name) \
+    do { \
+        printf("Testing %s... ", name); \
+        tests_run++; \
+    } while (0)
+
+#define PASS() \
+    do { \
+        printf("✅ PASS\n"); \
+        tests_passed++; \
+    } while (0)
+
+#define FAIL(msg) \
+    do { \
+        printf("❌ FAIL: %s\n", msg); \
+        exit(1); \
+    } while (0)
+
+/*********************************************************************
+ * Helpers
+ *********************************************************************/
+
+static const CompressFormat formats[] = { COMPRESS_GZIP, COMPRESS_XZ, COMPRESS_ZSTD };
+#define NUM_FORMATS (sizeof(formats) / sizeof(formats[0]))
+
+// Compress text with the given codec; returns NULL if not built in
+static unsigned char* compress_text(CompressFormat format, const char* text, size_t size, size_t* out_size) {
+    size_t cap = size + size / 2 + 1024;
+    unsigned char* out = malloc(cap);
+    bool ok = false;
+    (void)text;      // Unused without codecs
+    (void)out_size;
+
+    switch (format) {
+#ifdef BSAT_HAVE_ZLIB
+        case COMPRESS_GZIP: {
+            z_stream z;
+            memset(&z, 0, sizeof(z));
+            if (deflateInit2(&z, 6, Z_DEFLATED, 16 + MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) break;
+            z.next_in = (Bytef*)text;
+            z.avail_in = (uInt)size;
+            z.next_out = out;
+            z.avail_out = (uInt)cap;
+            ok = deflate(&z, Z_FINISH) == Z_STREAM_END;
+            *out_size = z.total_out;
+            deflateEnd(&z);
+            break;
+        }
+#endif
+#ifdef BSAT_HAVE_LZMA
+        case COMPRESS_XZ:
+            *out_size = 0;
+            ok = lzma_easy_buffer_encode(1, LZMA_CHECK_CRC64, NULL, (const uint8_t*)text, size,
+                                         out, out_size, cap) == LZMA_OK;
+            break;
+#endif
+#ifdef BSAT_HAVE_ZSTD
+        case COMPRESS_ZSTD:
+            *out_size = ZSTD_compress(out, cap, text, size, 3);
+            ok = !ZSTD_isError(*out_size);
+            break;
+#endif
+        default:
+            break;
+    }
+
+    if (!ok) {
+        free(out);
+        return NULL;
+    }
+    return out;
+}
+
+static bool write_temp(char* path, const void* data, size_t size) {
+    strcpy(path, "/tmp/bsat_gz_XXXXXX");
+    int fd = mkstemp(path);
+    if (fd < 0) return false;
+    bool ok = write(fd, data, size) == (ssize_t)size;
+    close(fd);
+    return ok;
+}
+
+// Random 3-SAT text with the given number of clauses
+static char* random_cnf(uint32_t num_vars, uint32_t num_clauses, size_t* size) {
+    size_t cap = (size_t)num_clauses * 24 + 64;
+    char* text = malloc(cap);
+    size_t len = snprintf(text, cap, "p cnf %u %u\n", num_vars, num_clauses);
+    uint64_t seed = 88172645463325252ULL;
+    for (uint32_t c = 0; c < num_clauses; c++) {
+        for (int i = 0; i < 3; i++) {
+            seed ^= seed << 13;
+            seed ^= seed >> 7;
+            seed ^= seed << 17;
+            int lit = (int)(seed % num_vars) + 1;
+            len += snprintf(text + len, cap - len, "%d ", (seed >> 32) & 1 ? -lit : lit);
+        }
+        len += snprintf(text + len, cap - len, "0\n");
+    }
+    *size = len;
+    return text;
+}
+
+/*********************************************************************
+ * Test Cases
+ *********************************************************************/
+
+void test_detect() {
+    TEST("Format detection by magic bytes");
+
+    const unsigned char gz[] = { 0x1f, 0x8b, 0x08, 0x00 };
+    const unsigned char xz[] = { 0xfd, '7', 'z', 'X', 'Z', 0x00 };
+    const unsigned char zst[] = { 0x28, 0xb5, 0x2f, 0xfd };
+    const unsigned char plain[] = "p cnf";
+    if (decompress_detect(gz, sizeof(gz)) != COMPRESS_GZIP) FAIL("gzip not detected");
+    if (decompress_detect(xz, sizeof(xz)) != COMPRESS_XZ) FAIL("xz not detected");
+    if (decompress_detect(zst, sizeof(zst)) != COMPRESS_ZSTD) FAIL("zstd not detected");
+    if (decompress_detect(plain, 5) != COMPRESS_NONE) FAIL("Plain text misdetected");
+    if (decompress_detect(xz, 3) != COMPRESS_NONE) FAIL("Short prefix must not match");
+
+    PASS();
+}
+
+void test_parse_compressed() {
+    TEST("Compressed files parse like plain files");
+
+    const char* text = "c comment\np cnf 3 4\n1 2 0\n-1 3 0\n-2 -3 0\n-3 0\n";
+    SolverOpts opts = default_opts();
+    opts.quiet = true;
+    Solver* plain = solver_new_with_opts(&opts);
+    dimacs_parse_string(plain, text);
+    lbool expected = solver_solve(plain);
+
+    for (size_t i = 0; i < NUM_FORMATS; i++) {
+        size_t size;
+        unsigned char* data = compress_text(formats[i], text, strlen(text), &size);
+        char path[32];
+        if (!data) {
+            // Codec not built in: the error must say so
+            static const unsigned char magics[NUM_FORMATS][DECOMPRESS_MAGIC_SIZE] = {
+                { 0x1f, 0x8b },                          // gzip
+                { 0xfd, '7', 'z', 'X', 'Z', 0x00 },      // xz
+                { 0x28, 0xb5, 0x2f, 0xfd },              // zstd
+            };
+            if (!write_temp(path, magics[i], DECOMPRESS_MAGIC_SIZE)) FAIL("Could not write temp file");
+            Solver* s = solver_new();
+            if (dimacs_parse_file(s, path) != DIMACS_ERROR_COMPRESSION) FAIL("Missing codec should be reported");
+            solver_free(s);
+            unlink(path);
+            continue;
+        }
+        if (!write_temp(path, data, size)) FAIL("Could not write temp file");
+
+        Solver* s = solver_new_with_opts(&opts);
+        if (dimacs_parse_file(s, path) != DIMACS_OK) FAIL("Compressed file did not parse");
+        if (s->num_vars != plain->num_vars || s->num_clauses != plain->num_clauses) {
+            FAIL("Compressed and plain parse differ");
+        }
+        if (solver_solve(s) != expected) FAIL("Different result for compressed input");
+        solver_free(s);
+
+        // The same through a FILE stream (e.g. stdin)
+        FILE* f = fopen(path, "rb");
+        s = solver_new();
+        if (dimacs_parse_stream(s, f) != DIMACS_OK || s->num_clauses != plain->num_clauses) {
+            FAIL("Compressed stream did not parse");
+        }
+        fclose(f);
+        solver_free(s);
+
+        unlink(path);
+        free(data);
+    }
+
+    solver_free(plain);
+    PASS();
+}
+
+void test_many_chunks() {
+    TEST("Input larger than the chunk ring");
+
+    // More than DECOMPRESS_RING chunks forces the producer to wait
+    size_t size;
+    char* text = random_cnf(50000, 600000, &size);
+    if (size < (size_t)DECOMPRESS_CHUNK * (DECOMPRESS_RING + 2)) FAIL("Test input too small");
+
+    SolverOpts opts = default_opts();
+    opts.quiet = true;
+    Solver* plain = solver_new_with_opts(&opts);
+    dimacs_parse_buffer(plain, text, size);
+
+    for (size_t i = 0; i < NUM_FORMATS; i++) {
+        size_t csize;
+        unsigned char* data = compress_text(formats[i], text, size, &csize);
+        if (!data) continue;
+        char path[32];
+        if (!write_temp(path, data, csize)) FAIL("Could not write temp file");
+
+        Solver* s = solver_new_with_opts(&opts);
+        if (dimacs_parse_file(s, path) != DIMACS_OK) FAIL("Large compressed file did not parse");
+        if (s->num_vars != plain->num_vars || s->num_clauses != plain->num_clauses) {
+            FAIL("Clause counts differ");
+        }
+        solver_free(s);
+
+        // Whole-file read used by cube mode
+        DimacsError err;
+        char* read = dimacs_read_text(path, &err);
+        if (!read || err != DIMACS_OK || strlen(read) != size || memcmp(read, text, size) != 0) {
+            FAIL("dimacs_read_text did not reproduce the input");
+        }
+        free(read);
+
+        unlink(path);
+        free(data);
+    }
+
+    solver_free(plain);
+    free(text);
+    PASS();
+}
+
+void test_truncated() {
+    TEST("Truncated compressed input is an error");
+
+    size_t size;
+    char* text = random_cnf(100, 2000, &size);
+
+    for (size_t i = 0; i < NUM_FORMATS; i++) {
+        size_t csize;
+        unsigned char* data = compress_text(formats[i], text, size, &csize);
+        if (!data) continue;
+        char path[32];
+        if (!write_temp(path, data, csize / 2)) FAIL("Could not write temp file");
+
+        Solver* s = solver_new();
+        DimacsError err = dimacs_parse_file(s, path);
+        if (err != DIMACS_ERROR_COMPRESSION && err != DIMACS_ERROR_FORMAT) {
+            FAIL("Truncated input should not parse");
+        }
+        solver_free(s);
+
+        DimacsError read_err;
+        if (dimacs_read_text(path, &read_err) || read_err != DIMACS_ERROR_COMPRESSION) {
+            FAIL("Truncated input should not be read");
+        }
+
+        unlink(path);
+        free(data);
+    }
+
+    free(text);
+    PASS();
+}
+
+/*********************************************************************
+ * Main Test Runner
+ *********************************************************************/
+
+int main() {
+    printf("========================================\n");
+    printf("BSAT Compressed Input Unit Tests\n");
+    printf("========================================\n\n");
+
+    printf("Codecs:");
+    for (size_t i = 0; i < NUM_FORMATS; i++) {
+        if (decompress_supported(formats[i])) printf(" %s", decompress_format_name(formats[i]));
+    }
+    printf("\n\n");
+
+    test_detect();
+    test_parse_compressed();
+    test_many_chunks();
+    test_truncated();
+
+    printf("\n========================================\n");
+    printf("Results: %d/%d tests passed\n", tests_passed, tests_run);
+    printf("========================================\n");
+
+    return (tests_passed == tests_run) ? 0 : 1;
+}
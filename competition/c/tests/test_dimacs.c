@@ -178,10 +178,111 @@ void test_parse_empty_lines() {
 void test_malformed_input() {
     TEST("Malformed input error handling");
 
-    // TODO: Parser is lenient and doesn't strictly validate
-    // This is acceptable - skip for now
-    printf("⏭️  SKIP (parser is lenient)\n");
-    tests_run--;  // Don't count as run
+    const char* bad_tokens[] = {
+        "p cnf 2 1\n1 x 0\n",    // Non-numeric literal
+        "p cnf 2 1\n1 2a 0\n",   // Trailing garbage
+        "p dnf 2 1\n1 2 0\n",    // Wrong format name
+        "p cnf 2 1\np cnf 2 1\n", // Duplicate header
+    };
+    for (size_t i = 0; i < sizeof(bad_tokens) / sizeof(bad_tokens[0]); i++) {
+        Solver* s = solver_new();
+        if (dimacs_parse_string(s, bad_tokens[i]) != DIMACS_ERROR_FORMAT) {
+            FAIL("Malformed input should be rejected");
+        }
+        solver_free(s);
+    }
+
+    Solver* s = solver_new();
+    if (dimacs_parse_string(s, "p cnf 1 1\n99999999999 0\n") != DIMACS_ERROR_SIZE) {
+        FAIL("Variable beyond MAX_VARS should be a size error");
+    }
+    solver_free(s);
+
+    PASS();
+}
+
+void test_free_layout() {
+    TEST("Clauses spanning lines, no final newline, % marker");
+
+    // Clause boundaries are the 0 tokens, not the line breaks
+    Solver* s = solver_new();
+    DimacsError err = dimacs_parse_string(s, "p cnf 3 2\n1\n2 3\n0 -1\t-2 0");
+    if (err != DIMACS_OK || s->num_clauses != 2) {
+        FAIL("Expected 2 clauses");
+    }
+    solver_free(s);
+
+    // Everything after a SATLIB "%" line is ignored
+    s = solver_new();
+    err = dimacs_parse_string(s, "p cnf 2 1\n1 2 0\n%\n0\n");
+    if (err != DIMACS_OK || s->num_clauses != 1) {
+        FAIL("% should end the formula");
+    }
+    solver_free(s);
+
+    // Buffers need not be NUL-terminated
+    const char text[] = "p cnf 2 1\n1 2 0\n-1 -2 0\n";
+    s = solver_new();
+    err = dimacs_parse_buffer(s, text, 16);
+    if (err != DIMACS_OK || s->num_clauses != 1) {
+        FAIL("Parser must stop at the buffer size");
+    }
+    solver_free(s);
+
+    PASS();
+}
+
+void test_long_clause() {
+    TEST("Clause with 200000 literals");
+
+    const uint32_t n = 200000;
+    size_t cap = (size_t)n * 8 + 64;
+    char* text = malloc(cap);
+    size_t len = snprintf(text, cap, "p cnf %u 3\n", n);
+    for (uint32_t v = 1; v <= n; v++) {
+        len += snprintf(text + len, cap - len, "%u ", v);
+    }
+    snprintf(text + len, cap - len, "0\n-1 -2 0\n-1 2 0\n");
+
+    SolverOpts opts = default_opts();
+    opts.quiet = true;
+    Solver* s = solver_new_with_opts(&opts);
+    DimacsError err = dimacs_parse_string(s, text);
+    if (err != DIMACS_OK || s->num_vars != n || s->num_clauses != 3) {
+        FAIL("Long clause not parsed");
+    }
+    if (solver_solve(s) != TRUE) {
+        FAIL("Expected SAT");
+    }
+
+    solver_free(s);
+    free(text);
+    PASS();
+}
+
+void test_stream_matches_file() {
+    TEST("Stream and memory-mapped parse agree");
+
+    const char* path = "../tests/fixtures/unit/horn_unsat.cnf";
+    FILE* f = fopen(path, "r");
+    if (!f) {
+        FAIL("Cannot open fixture");
+    }
+
+    Solver* a = solver_new();
+    Solver* b = solver_new();
+    if (dimacs_parse_stream(a, f) != DIMACS_OK || dimacs_parse_file(b, path) != DIMACS_OK) {
+        FAIL("Failed to parse fixture");
+    }
+    fclose(f);
+
+    if (a->num_vars != b->num_vars || a->num_clauses != b->num_clauses) {
+        FAIL("Stream and file parse differ");
+    }
+
+    solver_free(a);
+    solver_free(b);
+    PASS();
 }
 
 void test_unit_propagation() {
@@ -279,6 +380,124 @@ void test_horn_unsat() {
     PASS();
 }
 
+void test_model_output() {
+    TEST("Text and binary model output");
+
+    Solver* s = solver_new();
+    if (dimacs_parse_file(s, "../tests/fixtures/unit/horn_sat.cnf") != DIMACS_OK) {
+        FAIL("Failed to parse file");
+    }
+    if (solver_solve(s) != TRUE) {
+        FAIL("Expected SAT");
+    }
+
+    // Text model: every variable once, in order, terminated by 0
+    FILE* text = tmpfile();
+    if (!text) {
+        FAIL("Cannot create temporary file");
+    }
+    dimacs_write_model(s, text);
+    rewind(text);
+
+    Var next = 1;
+    char word[32];
+    bool terminated = false;
+    while (fscanf(text, "%31s", word) == 1) {
+        if (strcmp(word, "v") == 0) continue;
+        long lit = strtol(word, NULL, 10);
+        if (lit == 0) {
+            terminated = true;
+            break;
+        }
+        Var v = (Var)labs(lit);
+        if (v != next++ || (lit > 0) != (solver_model_value(s, v) == TRUE)) {
+            FAIL("Text model disagrees with the solver");
+        }
+    }
+    fclose(text);
+    if (!terminated || next != s->num_vars + 1) {
+        FAIL("Text model incomplete");
+    }
+
+    // Binary model: header followed by one bit per variable
+    const char* path = "/tmp/bsat_test_model.bin";
+    if (!dimacs_write_model_binary(s, path)) {
+        FAIL("Cannot write binary model");
+    }
+    FILE* bin = fopen(path, "rb");
+    unsigned char data[MODEL_BINARY_HEADER + 64];
+    size_t len = bin ? fread(data, 1, sizeof(data), bin) : 0;
+    if (bin) fclose(bin);
+    remove(path);
+
+    uint32_t num_vars = data[8] | (data[9] << 8) | (data[10] << 16) | ((uint32_t)data[11] << 24);
+    if (len != MODEL_BINARY_HEADER + (s->num_vars + 7) / 8 ||
+        memcmp(data, MODEL_BINARY_MAGIC, 8) != 0 || num_vars != s->num_vars) {
+        FAIL("Bad binary model header");
+    }
+    for (Var v = 1; v <= s->num_vars; v++) {
+        bool bit = (data[MODEL_BINARY_HEADER + (v - 1) / 8] >> ((v - 1) % 8)) & 1;
+        if (bit != (solver_model_value(s, v) == TRUE)) {
+            FAIL("Binary model disagrees with the solver");
+        }
+    }
+
+    solver_free(s);
+    PASS();
+}
+
+// Fill the stack below the caller with '9' bytes, so a model writer that
+// reads uninitialized digits sees carries instead of clean zeros
+__attribute__((noinline)) static void dirty_stack(void) {
+    volatile char junk[1 << 17];
+    for (size_t i = 0; i < sizeof(junk); i++) junk[i] = '9';
+}
+
+void test_model_output_many_vars() {
+    TEST("Text model with multi-digit variables");
+
+    // Units fix every variable: v is negative when divisible by 3
+    enum { VARS = 1234 };
+    char* cnf = malloc(VARS * 8 + 32);
+    if (!cnf) FAIL("Out of memory");
+    size_t len = (size_t)sprintf(cnf, "p cnf %d %d\n", VARS, VARS);
+    for (int v = 1; v <= VARS; v++) {
+        len += (size_t)sprintf(cnf + len, "%d 0\n", v % 3 == 0 ? -v : v);
+    }
+    Solver* s = solver_new();
+    if (dimacs_parse_string(s, cnf) != DIMACS_OK) FAIL("Failed to parse formula");
+    free(cnf);
+    if (solver_solve(s) != TRUE) FAIL("Expected SAT");
+
+    FILE* text = tmpfile();
+    if (!text) FAIL("Cannot create temporary file");
+    dirty_stack();
+    dimacs_write_model(s, text);
+    rewind(text);
+
+    // Every printed literal names the next variable, with its sign
+    long next = 1;
+    char word[32];
+    bool terminated = false;
+    while (fscanf(text, "%31s", word) == 1) {
+        if (strcmp(word, "v") == 0) continue;
+        long lit = strtol(word, NULL, 10);
+        if (lit == 0) {
+            terminated = true;
+            break;
+        }
+        if (labs(lit) != next || (lit < 0) != (next % 3 == 0)) {
+            FAIL("Wrong literal in the text model");
+        }
+        next++;
+    }
+    fclose(text);
+    if (!terminated || next != VARS + 1) FAIL("Text model incomplete");
+
+    solver_free(s);
+    PASS();
+}
+
 /*********************************************************************
  * Main Test Runner
  *********************************************************************/
@@ -296,6 +515,9 @@ int main() {
     test_parse_unit_clauses();
     test_parse_empty_lines();
     test_malformed_input();
+    test_free_layout();
+    test_long_clause();
+    test_stream_matches_file();
 
     // Fixture tests
     test_unit_propagation();
@@ -303,6 +525,8 @@ int main() {
     test_simple_unsat_3();
     test_horn_sat();
     test_horn_unsat();
+    test_model_output();
+    test_model_output_many_vars();
 
     printf("\n========================================\n");
     printf("Results: %d/%d tests passed\n", tests_passed, tests_run);
@@ -0,0 +1,142 @@
+/*********************************************************************
+ * BSAT C Solver - DIMACS Parse Throughput Benchmark
+ *
+ * Writes a random 3-SAT file and reports parse throughput (MB/s) for
+ * the memory-mapped and the streaming parser. The size in MB can be
+ * given as the first argument (default 8).
+ *********************************************************************/
+
+#define _POSIX_C_SOURCE 200809L  // mkstemp, clock_gettime
+
+#include "../include/dimacs.h"
+#include "../include/solver.h"
+#include "../include/timer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// Required for linking (normally defined in main.c)
+bool g_verbose = false;
+
+// Test counter
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define TEST(name) \
+    do { \
+        printf("Testing %s... ", name); \
+        tests_run++; \
+    } while (0)
+
+#define PASS() \
+    do { \
+        printf("✅ PASS\n"); \
+        tests_passed++; \
+    } while (0)
+
+#define FAIL(msg) \
+    do { \
+        printf("❌ FAIL: %s\n", msg); \
+        exit(1); \
+    } while (0)
+
+/*********************************************************************
+ * Helpers
+ *********************************************************************/
+
+// Write random 3-SAT clauses until the file reaches target bytes.
+// The header is padded so it can be rewritten with the final count.
+static uint32_t write_random_cnf(FILE* f, uint32_t num_vars, size_t target, size_t* bytes) {
+    fprintf(f, "p cnf %u %-12u\n", num_vars, 0u);
+    uint64_t seed = 0x9E3779B97F4A7C15ULL;
+    uint32_t clauses = 0;
+    size_t written = 0;
+    while (written < target) {
+        for (int i = 0; i < 3; i++) {
+            seed ^= seed << 13;
+            seed ^= seed >> 7;
+            seed ^= seed << 17;
+            int lit = (int)(seed % num_vars) + 1;
+            written += fprintf(f, "%d ", (seed >> 32) & 1 ? -lit : lit);
+        }
+        written += fprintf(f, "0\n");
+        clauses++;
+    }
+    rewind(f);
+    fprintf(f, "p cnf %u %-12u\n", num_vars, clauses);
+    fseek(f, 0, SEEK_END);
+    *bytes = (size_t)ftell(f);
+    return clauses;
+}
+
+/*********************************************************************
+ * Test Cases
+ *********************************************************************/
+
+void test_throughput(size_t megabytes) {
+    TEST("Parse throughput (memory map vs stream)");
+
+    char path[] = "/tmp/bsat_parse_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) FAIL("Could not create temp file");
+    FILE* f = fdopen(fd, "w+");
+    if (!f) FAIL("Could not open temp file");
+
+    const uint32_t num_vars = 1000000;
+    size_t bytes;
+    uint32_t clauses = write_random_cnf(f, num_vars, megabytes << 20, &bytes);
+    fclose(f);
+
+    SolverOpts opts = default_opts();
+    opts.quiet = true;
+
+    // Memory-mapped fast path
+    Solver* a = solver_new_with_opts(&opts);
+    double t0 = now_seconds();
+    if (dimacs_parse_file(a, path) != DIMACS_OK) FAIL("Memory-mapped parse failed");
+    double mapped = now_seconds() - t0;
+
+    // Buffered stream
+    Solver* b = solver_new_with_opts(&opts);
+    f = fopen(path, "r");
+    if (!f) FAIL("Could not reopen temp file");
+    t0 = now_seconds();
+    if (dimacs_parse_stream(b, f) != DIMACS_OK) FAIL("Stream parse failed");
+    double streamed = now_seconds() - t0;
+    fclose(f);
+
+    if (a->num_vars != num_vars || b->num_vars != num_vars) FAIL("Wrong variable count");
+    if (a->num_clauses != b->num_clauses || a->num_clauses > clauses) FAIL("Clause counts differ");
+
+    double mb = (double)bytes / (1 << 20);
+    printf("\n  %.1f MB, %u clauses: mmap %.1f MB/s, stream %.1f MB/s\n",
+           mb, clauses, mb / mapped, mb / streamed);
+
+    solver_free(a);
+    solver_free(b);
+    unlink(path);
+    PASS();
+}
+
+/*********************************************************************
+ * Main Test Runner
+ *********************************************************************/
+
+int main(int argc, char** argv) {
+    printf("========================================\n");
+    printf("BSAT DIMACS Parse Throughput\n");
+    printf("========================================\n\n");
+
+    size_t megabytes = 8;
+    if (argc > 1) megabytes = (size_t)strtoul(argv[1], NULL, 10);
+    if (megabytes == 0) megabytes = 1;
+
+    test_throughput(megabytes);
+
+    printf("\n========================================\n");
+    printf("Results: %d/%d tests passed\n", tests_passed, tests_run);
+    printf("========================================\n");
+
+    return (tests_passed == tests_run) ? 0 : 1;
+}
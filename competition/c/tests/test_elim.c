@@ -0,0 +1,214 @@
+/*********************************************************************
+ * BSAT C Solver - Bounded Variable Elimination Unit Tests
+ *
+ * Tests for elimination through binary clauses, model reconstruction,
+ * resolvent subsumption, UNSAT detection, thread-independent batches and
+ * blocked clause elimination.
+ *********************************************************************/
+
+#include "../include/solver.h"
+#include "../include/dimacs.h"
+#include "../include/elim.h"
+#include "test_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Required for linking (normally defined in main.c)
+bool g_verbose = false;
+
+// Test counter
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define TEST(name) \
+    do { \
+        printf("Testing %s... ", name); \
+        tests_run++; \
+    } while (0)
+
+#define PASS() \
+    do { \
+        printf("✅ PASS\n"); \
+        tests_passed++; \
+    } while (0)
+
+#define FAIL(msg) \
+    do { \
+        printf("❌ FAIL: %s\n", msg); \
+        exit(1); \
+    } while (0)
+
+/*********************************************************************
+ * Helpers
+ *********************************************************************/
+
+// BVE only: no BCE, probing or subsumption, so every removed clause is
+// BVE's work
+static Solver* elim_solver(uint32_t threads) {
+    SolverOpts opts = default_opts();
+    opts.quiet = true;
+    opts.elim = true;
+    opts.bce = false;
+    opts.probing = false;
+    opts.subsumption = false;
+    opts.elim_threads = threads;
+    return solver_new_with_opts(&opts);
+}
+
+// Random 3-SAT below the threshold, as DIMACS
+static char* random_3sat(uint32_t vars, uint32_t clauses, uint32_t seed) {
+    char* buf = (char*)malloc(32 + clauses * 40);
+    int n = sprintf(buf, "p cnf %u %u\n", vars, clauses);
+    for (uint32_t c = 0; c < clauses; c++) {
+        for (int k = 0; k < 3; k++) {
+            seed = seed * 1103515245u + 12345u;
+            int v = (int)((seed >> 8) % vars) + 1;
+            n += sprintf(buf + n, "%d ", (seed >> 4) & 1 ? v : -v);
+        }
+        n += sprintf(buf + n, "0\n");
+    }
+    return buf;
+}
+
+/*********************************************************************
+ * Test Cases
+ *********************************************************************/
+
+void test_binary_elimination() {
+    TEST("Variables in binary clauses are eliminated and reconstructed");
+
+    // Only binary clauses: x1 and x4 are resolved away through them
+    const char* cnf = "p cnf 5 4\n1 2 0\n-2 3 0\n3 4 0\n-4 5 0\n";
+    Solver* s = elim_solver(1);
+    dimacs_parse_string(s, cnf);
+
+    if (solver_solve(s) != TRUE) FAIL("Formula is SAT");
+    if (!s->elim || s->elim->vars_eliminated == 0) FAIL("BVE should eliminate variables");
+    if (!model_satisfies(s, cnf)) FAIL("Model does not satisfy formula");
+
+    solver_free(s);
+    PASS();
+}
+
+void test_reconstruction_forced() {
+    TEST("Reconstruction follows the saved side");
+
+    // x1 is eliminated; the model of x2, x3 then forces its value
+    const char* cnf = "p cnf 3 4\n1 2 0\n1 3 0\n-1 -2 0\n-2 0\n";
+    Solver* s = elim_solver(1);
+    dimacs_parse_string(s, cnf);
+    solver_set_frozen(s, 2, true);
+    solver_set_frozen(s, 3, true);
+
+    if (solver_solve(s) != TRUE) FAIL("Formula is SAT");
+    if (!s->elim || !s->elim->eliminated[1]) FAIL("x1 should be eliminated");
+    if (solver_model_value(s, 1) != TRUE) FAIL("x1 must be true when x2 is false");
+    if (!model_satisfies(s, cnf)) FAIL("Model does not satisfy formula");
+
+    solver_free(s);
+    PASS();
+}
+
+void test_subsumed_resolvent() {
+    TEST("Subsumed resolvents are not added");
+
+    // Resolving x1 gives (x2 ∨ x3 ∨ x4), subsumed by (x2 ∨ x3)
+    Solver* s = elim_solver(1);
+    dimacs_parse_string(s, "p cnf 4 3\n1 2 3 0\n-1 4 0\n2 3 0\n");
+    for (Var v = 2; v <= 4; v++) solver_set_frozen(s, v, true);
+
+    if (solver_solve(s) != TRUE) FAIL("Formula is SAT");
+    if (!s->elim->eliminated[1]) FAIL("x1 should be eliminated");
+    if (s->elim->resolvents_subsumed != 1 || s->elim->resolvents_added != 0) {
+        FAIL("The resolvent should be dropped as subsumed");
+    }
+
+    solver_free(s);
+    PASS();
+}
+
+void test_unsat_by_elimination() {
+    TEST("Complementary unit resolvents prove UNSAT");
+
+    // Resolving x1 yields the units x2 and ¬x2
+    Solver* s = elim_solver(1);
+    dimacs_parse_string(s, "p cnf 2 5\n1 2 0\n1 2 0\n-1 2 0\n-1 -2 0\n1 -2 0\n");
+    solver_set_frozen(s, 2, true);
+
+    if (solver_solve(s) != FALSE) FAIL("Formula is UNSAT");
+
+    solver_free(s);
+    PASS();
+}
+
+void test_threads_deterministic() {
+    TEST("Elimination does not depend on the thread count");
+
+    char* cnf = random_3sat(2000, 5000, 42);
+    Solver* a = elim_solver(1);
+    Solver* b = elim_solver(4);
+    dimacs_parse_string(a, cnf);
+    dimacs_parse_string(b, cnf);
+
+    if (solver_solve(a) != TRUE || solver_solve(b) != TRUE) FAIL("Formula should be SAT");
+    if (a->elim->vars_eliminated == 0) FAIL("BVE should eliminate variables");
+    if (a->elim->vars_eliminated != b->elim->vars_eliminated ||
+        a->elim->resolvents_added != b->elim->resolvents_added) {
+        FAIL("Thread count changed the result");
+    }
+    if (memcmp(a->elim->eliminated, b->elim->eliminated, (a->num_vars + 1) * sizeof(bool)) != 0) {
+        FAIL("Different variables eliminated");
+    }
+    if (!model_satisfies(a, cnf) || !model_satisfies(b, cnf)) FAIL("Model does not satisfy formula");
+
+    solver_free(a);
+    solver_free(b);
+    free(cnf);
+    PASS();
+}
+
+void test_blocked_clauses() {
+    TEST("Blocked clauses are removed and reconstructed");
+
+    // (x1 ∨ x2) is blocked on x1: its only resolvent with (¬x1 ∨ ¬x2) is
+    // a tautology
+    const char* cnf = "p cnf 3 3\n1 2 0\n-1 -2 0\n2 3 0\n";
+    SolverOpts opts = default_opts();
+    opts.quiet = true;
+    opts.bce = true;
+    opts.probing = false;
+    opts.subsumption = false;
+    Solver* s = solver_new_with_opts(&opts);
+    dimacs_parse_string(s, cnf);
+
+    if (solver_solve(s) != TRUE) FAIL("Formula is SAT");
+    if (s->stats.blocked_clauses == 0) FAIL("BCE should remove clauses");
+    if (!model_satisfies(s, cnf)) FAIL("Model does not satisfy formula");
+
+    solver_free(s);
+    PASS();
+}
+
+/*********************************************************************
+ * Main Test Runner
+ *********************************************************************/
+
+int main() {
+    printf("========================================\n");
+    printf("BSAT Variable Elimination Unit Tests\n");
+    printf("========================================\n\n");
+
+    test_binary_elimination();
+    test_reconstruction_forced();
+    test_subsumed_resolvent();
+    test_unsat_by_elimination();
+    test_threads_deterministic();
+    test_blocked_clauses();
+
+    printf("\n========================================\n");
+    printf("Results: %d/%d tests passed\n", tests_passed, tests_run);
+    printf("========================================\n");
+
+    return (tests_passed == tests_run) ? 0 : 1;
+}
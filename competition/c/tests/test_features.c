@@ -11,6 +11,7 @@
 #include "../include/dimacs.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <assert.h>
 
 // Required for linking (normally defined in main.c)
@@ -38,6 +39,31 @@ static int tests_passed = 0;
         exit(1); \
     } while (0)
 
+/*********************************************************************
+ * Helpers
+ *********************************************************************/
+
+// Pigeonhole formula: holes + 1 pigeons into holes holes (UNSAT)
+static void add_pigeonhole(Solver* s, int holes) {
+    for (int i = 0; i < (holes + 1) * holes; i++) {
+        solver_new_var(s);
+    }
+    Lit lits[16];
+    for (int p = 0; p <= holes; p++) {
+        for (int h = 0; h < holes; h++) lits[h] = mkLit(p * holes + h + 1, false);
+        solver_add_clause(s, lits, holes);
+    }
+    for (int h = 0; h < holes; h++) {
+        for (int p = 0; p <= holes; p++) {
+            for (int q = p + 1; q <= holes; q++) {
+                lits[0] = mkLit(p * holes + h + 1, true);
+                lits[1] = mkLit(q * holes + h + 1, true);
+                solver_add_clause(s, lits, 2);
+            }
+        }
+    }
+}
+
 /*********************************************************************
  * Feature Test Cases
  *********************************************************************/
@@ -160,6 +186,95 @@ void test_restarts() {
     PASS();
 }
 
+void test_trail_reuse() {
+    TEST("Restarts reuse the trail");
+
+    // Frequent geometric restarts, so that some keep their first levels
+    SolverOpts opts = default_opts();
+    opts.quiet = true;
+    opts.glucose_restart = false;
+    opts.restart_first = 10;
+    opts.restart_inc = 1.1;
+    Solver* s = solver_new_with_opts(&opts);
+    add_pigeonhole(s, 6);
+
+    if (solver_solve(s) != FALSE) {
+        FAIL("Pigeonhole formula is UNSAT");
+    }
+    if (s->stats.reuse_restarts == 0 || s->stats.reused_literals == 0) {
+        FAIL("No restart kept any trail");
+    }
+    if (s->stats.reuse_restarts > s->stats.restarts ||
+        s->stats.reused_propagations > s->stats.reused_literals) {
+        FAIL("Reuse counters out of range");
+    }
+
+    printf("(restarts=%llu, reused=%llu) ", (unsigned long long)s->stats.restarts,
+           (unsigned long long)s->stats.reuse_restarts);
+
+    solver_free(s);
+    PASS();
+}
+
+void test_chrono_threshold() {
+    TEST("Chronological backtracking threshold");
+
+    // 0 = every conflict backtracks one level; chrono off = never
+    uint64_t chrono[2];
+    for (int off = 0; off < 2; off++) {
+        SolverOpts opts = default_opts();
+        opts.quiet = true;
+        opts.chrono = !off;
+        opts.chrono_threshold = 0;
+        Solver* s = solver_new_with_opts(&opts);
+        add_pigeonhole(s, 6);
+
+        if (solver_solve(s) != FALSE) {
+            FAIL("Pigeonhole formula is UNSAT");
+        }
+        chrono[off] = s->stats.chrono_backtracks;
+        if (!off && chrono[off] == 0) {
+            FAIL("Threshold 0 should backtrack chronologically");
+        }
+        solver_free(s);
+    }
+    if (chrono[1] != 0) {
+        FAIL("No chronological backtracks when disabled");
+    }
+
+    printf("(chrono=%llu) ", (unsigned long long)chrono[0]);
+    PASS();
+}
+
+void test_tick_limit() {
+    TEST("Tick limits stop searches at the same point");
+
+    uint64_t conflicts[2], ticks[2];
+    for (int run = 0; run < 2; run++) {
+        SolverOpts opts = default_opts();
+        opts.quiet = true;
+        opts.max_ticks = 200000;
+        Solver* s = solver_new_with_opts(&opts);
+        add_pigeonhole(s, 9);
+
+        if (solver_solve(s) != UNDEF) {
+            FAIL("Limit should be reached");
+        }
+        if (s->stats.ticks < opts.max_ticks) {
+            FAIL("Search stopped before the limit");
+        }
+        conflicts[run] = s->stats.conflicts;
+        ticks[run] = s->stats.ticks;
+        solver_free(s);
+    }
+    if (conflicts[0] != conflicts[1] || ticks[0] != ticks[1]) {
+        FAIL("Runs with the same limit should be identical");
+    }
+
+    printf("(conflicts=%llu) ", (unsigned long long)conflicts[0]);
+    PASS();
+}
+
 void test_bce_preprocessing() {
     TEST("BCE preprocessing (blocked clauses eliminated)");
 
@@ -257,6 +372,79 @@ void test_vsids_decisions() {
     PASS();
 }
 
+void test_vmtf_decisions() {
+    TEST("VMTF queue (move-to-front decisions)");
+
+    SolverOpts opts = default_opts();
+    opts.quiet = true;
+    opts.vmtf = true;
+    Solver* s = solver_new_with_opts(&opts);
+
+    // Needs many conflicts, so many bumps
+    add_pigeonhole(s, 5);
+
+    if (solver_solve(s) != FALSE) {
+        FAIL("Pigeonhole formula is UNSAT");
+    }
+    if (s->stats.conflicts == 0) {
+        FAIL("No conflicts - nothing was bumped");
+    }
+
+    // Every variable is linked once, with stamps increasing to the end
+    uint32_t linked = 0;
+    uint64_t stamp = 0;
+    for (Var v = s->queue.first; v != 0; v = s->queue.links[v].next) {
+        if (s->queue.links[v].stamp <= stamp) {
+            FAIL("Stamps must increase along the queue");
+        }
+        stamp = s->queue.links[v].stamp;
+        linked++;
+    }
+    if (linked != s->num_vars || s->queue.links[s->queue.last].stamp != stamp) {
+        FAIL("Queue must link every variable");
+    }
+
+    printf("(conflicts=%llu) ", (unsigned long long)s->stats.conflicts);
+
+    solver_free(s);
+    PASS();
+}
+
+void test_search_modes() {
+    TEST("Focused and stable search modes alternate");
+
+    SolverOpts opts = default_opts();
+    opts.quiet = true;
+    opts.modes = true;
+    opts.mode_interval = 50;
+    Solver* s = solver_new_with_opts(&opts);
+    add_pigeonhole(s, 7);
+
+    if (solver_solve(s) != FALSE) {
+        FAIL("Pigeonhole formula is UNSAT");
+    }
+    if (s->mode.stats[0].phases == 0 || s->mode.stats[1].phases == 0) {
+        FAIL("Both modes should have run");
+    }
+    if (s->mode.budget == 0) {
+        FAIL("The first switch should set the propagation budget");
+    }
+    if (s->mode.vmtf == s->mode.stable) {
+        FAIL("VMTF decides exactly in focused mode");
+    }
+
+    // Finished phases account for part of the search
+    uint64_t conflicts = s->mode.stats[0].conflicts + s->mode.stats[1].conflicts;
+    if (conflicts == 0 || conflicts > s->stats.conflicts) {
+        FAIL("Mode conflicts out of range");
+    }
+
+    printf("(phases=%u+%u) ", s->mode.stats[0].phases, s->mode.stats[1].phases);
+
+    solver_free(s);
+    PASS();
+}
+
 void test_clause_minimization() {
     TEST("Clause minimization (learned clauses minimized)");
 
@@ -502,6 +690,33 @@ void test_minisat_clause_minimization(void) {
     PASS();
 }
 
+void test_clause_shrinking(void) {
+    TEST("Learned clause shrinking");
+
+    SolverOpts opts = default_opts();
+    opts.quiet = true;
+    opts.probing = false;
+    Solver* s = solver_new_with_opts(&opts);
+    add_pigeonhole(s, 7);
+    if (solver_solve(s) != FALSE) FAIL("Pigeonhole formula is UNSAT");
+    if (s->stats.shrunk_literals == 0) FAIL("Shrinking should remove literals");
+    if (s->stats.minimized_literals == 0) FAIL("Minimization should remove literals");
+    printf("(minimized=%llu, shrunk=%llu) ", (unsigned long long)s->stats.minimized_literals,
+           (unsigned long long)s->stats.shrunk_literals);
+    solver_free(s);
+
+    opts.minimize = false;
+    opts.shrink = false;
+    s = solver_new_with_opts(&opts);
+    add_pigeonhole(s, 7);
+    if (solver_solve(s) != FALSE) FAIL("Pigeonhole formula is UNSAT");
+    if (s->stats.shrunk_literals != 0 || s->stats.minimized_literals != 0) {
+        FAIL("Both techniques should be off");
+    }
+    solver_free(s);
+    PASS();
+}
+
 void test_vivification_inprocessing(void) {
     TEST("Vivification inprocessing (clause strengthening)");
 
@@ -543,6 +758,38 @@ void test_vivification_inprocessing(void) {
     PASS();
 }
 
+void test_stats_json(void) {
+    TEST("Statistics JSON report");
+
+    SolverOpts opts = default_opts();
+    opts.quiet = true;
+    Solver* s = solver_new_with_opts(&opts);
+    dimacs_parse_string(s, "p cnf 3 4\n1 2 0\n-1 2 0\n1 -2 0\n-1 -2 3 0\n");
+    if (solver_solve(s) != TRUE) FAIL("Formula is SAT");
+
+    FILE* f = tmpfile();
+    if (!f) FAIL("Cannot create temporary file");
+    solver_write_stats_json(s, f);
+    long size = ftell(f);
+    char* json = (char*)calloc((size_t)size + 1, 1);
+    rewind(f);
+    if (fread(json, 1, (size_t)size, f) != (size_t)size) FAIL("Short read");
+    fclose(f);
+
+    if (json[0] != '{' || json[size - 2] != '}') FAIL("Report should be one JSON object");
+    if (!strstr(json, "\"conflicts\": ")) FAIL("Missing conflict counter");
+    if (!strstr(json, "\"inprocess_probe\": ")) FAIL("Missing inprocessing times");
+#ifdef BSAT_PHASES
+    if (!strstr(json, "\"propagate\": {\"seconds\": ")) FAIL("Missing phase times");
+#else
+    if (!strstr(json, "\"phases\": null")) FAIL("Phases should be null when compiled out");
+#endif
+
+    free(json);
+    solver_free(s);
+    PASS();
+}
+
 /*********************************************************************
  * Main Test Runner
  *********************************************************************/
@@ -556,11 +803,16 @@ int main(void) {
     test_clause_learning();
     test_unit_propagation();
     test_vsids_decisions();
+    test_vmtf_decisions();
+    test_search_modes();
     test_binary_clauses();
     test_lbd_calculation();
 
     // Advanced features
     test_restarts();
+    test_trail_reuse();
+    test_chrono_threshold();
+    test_tick_limit();
     test_bce_preprocessing();
     test_clause_minimization();
     test_subsumption();
@@ -570,8 +822,12 @@ int main(void) {
     // New optimization features
     test_failed_literal_probing();
     test_minisat_clause_minimization();
+    test_clause_shrinking();
     test_vivification_inprocessing();
 
+    // Reporting
+    test_stats_json();
+
     printf("\n========================================\n");
     printf("Results: %d/%d tests passed\n", tests_passed, tests_run);
     printf("========================================\n");
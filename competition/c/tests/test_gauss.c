@@ -0,0 +1,270 @@
+/*********************************************************************
+ * BSAT C Solver - Gauss-Jordan Elimination Unit Tests
+ *
+ * Tests for XOR recovery from clauses, "x" lines in DIMACS input, the
+ * auxiliary variables of long XORs, inconsistent XOR systems, and
+ * agreement of search with and without the matrices.
+ *********************************************************************/
+
+#include "../include/solver.h"
+#include "../include/dimacs.h"
+#include "../include/gauss.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Required for linking (normally defined in main.c)
+bool g_verbose = false;
+
+// Test counter
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define TEST(name) \
+    do { \
+        printf("Testing %s... ", name); \
+        tests_run++; \
+    } while (0)
+
+#define PASS() \
+    do { \
+        printf("✅ PASS\n"); \
+        tests_passed++; \
+    } while (0)
+
+#define FAIL(msg) \
+    do { \
+        printf("❌ FAIL: %s\n", msg); \
+        exit(1); \
+    } while (0)
+
+/*********************************************************************
+ * Helpers
+ *********************************************************************/
+
+static Solver* gauss_solver(const char* cnf, bool gauss) {
+    SolverOpts opts = default_opts();
+    opts.quiet = true;
+    opts.gauss = gauss;
+    Solver* s = solver_new_with_opts(&opts);
+    if (cnf && dimacs_parse_string(s, cnf) != DIMACS_OK) FAIL("Parse error");
+    return s;
+}
+
+// Parity of the true model values among vars
+static bool model_parity(const Solver* s, const Var* vars, uint32_t size) {
+    bool parity = false;
+    for (uint32_t i = 0; i < size; i++) {
+        parity ^= solver_model_value(s, vars[i]) == TRUE;
+    }
+    return parity;
+}
+
+/*********************************************************************
+ * Test Cases
+ *********************************************************************/
+
+void test_xor_recovery() {
+    TEST("XORs are recovered from their clauses");
+
+    // 1^2^3 = 1 and 3^4^5 = 0 as clauses, and the equivalence 5 = -6
+    const char* cnf =
+        "p cnf 6 10\n"
+        "1 2 3 0\n1 -2 -3 0\n-1 2 -3 0\n-1 -2 3 0\n"
+        "-3 4 5 0\n3 -4 5 0\n3 4 -5 0\n-3 -4 -5 0\n"
+        "5 6 0\n-5 -6 0\n";
+    Solver* s = gauss_solver(cnf, true);
+
+    if (!gauss_init(s)) FAIL("XORs are consistent");
+    if (!s->gauss) FAIL("A matrix should be built");
+    if (s->gauss->num_xors != 3) FAIL("Three XORs should be found");
+    if (s->gauss->num_matrices != 1) FAIL("The XORs share variables: one matrix");
+    if (s->gauss->num_rows != 3 || s->gauss->num_cols != 6) FAIL("Matrix should be 3 x 6");
+    for (Var v = 1; v <= 6; v++) {
+        if (!s->vars[v].in_matrix) FAIL("Matrix variables are kept from BCE and BVE");
+    }
+
+    if (solver_solve(s) != TRUE) FAIL("Formula is SAT");
+    Var x1[3] = { 1, 2, 3 }, x2[3] = { 3, 4, 5 }, x3[2] = { 5, 6 };
+    if (!model_parity(s, x1, 3) || model_parity(s, x2, 3) || !model_parity(s, x3, 2)) {
+        FAIL("Model violates an XOR");
+    }
+
+    solver_free(s);
+    PASS();
+}
+
+void test_incomplete_encoding() {
+    TEST("Partial encodings are not taken for XORs");
+
+    // Three of the four clauses of 1^2^3 = 1
+    const char* cnf = "p cnf 4 4\n1 2 3 0\n1 -2 -3 0\n-1 2 -3 0\n2 3 4 0\n";
+    Solver* s = gauss_solver(cnf, true);
+
+    if (!gauss_init(s)) FAIL("Formula is SAT");
+    if (s->gauss) FAIL("No XOR should be found");
+
+    solver_free(s);
+    PASS();
+}
+
+void test_xor_lines() {
+    TEST("x lines are parsed as XOR constraints");
+
+    // 1^2^3 = 1, 3^4 = 0 (a negative literal flips the parity), 1 = 1
+    const char* cnf = "p cnf 4 3\nx1 2 3 0\nx -3 4 0\nx 1 0\n";
+    Solver* s = gauss_solver(cnf, false);
+
+    if (s->num_vars != 4 || s->num_input_vars != 0) FAIL("Short XORs need no new variables");
+    if (solver_solve(s) != TRUE) FAIL("Formula is SAT");
+    Var x1[3] = { 1, 2, 3 }, x2[2] = { 3, 4 };
+    if (!model_parity(s, x1, 3) || model_parity(s, x2, 2)) FAIL("Model violates an XOR");
+    if (solver_model_value(s, 1) != TRUE) FAIL("Unit XOR should hold");
+
+    solver_free(s);
+    PASS();
+}
+
+void test_long_xor() {
+    TEST("Long XORs are cut with auxiliary variables");
+
+    const char* cnf = "p cnf 10 2\nx1 2 3 4 5 6 7 8 9 -10 0\n1 2 0\n";
+    Solver* s = gauss_solver(cnf, true);
+
+    if (s->num_input_vars != 10) FAIL("Input variables should be recorded");
+    if (s->num_vars <= 10) FAIL("Auxiliary variables should be added");
+    if (solver_input_vars(s) != 10) FAIL("Models should cover the input variables only");
+    if (solver_solve(s) != TRUE) FAIL("Formula is SAT");
+
+    Var vars[10] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+    if (model_parity(s, vars, 10)) FAIL("Model violates the XOR");
+
+    solver_free(s);
+    PASS();
+}
+
+void test_repeated_variables() {
+    TEST("Repeated XOR variables cancel");
+
+    // 1^2^1 is 2
+    Solver* s = gauss_solver("p cnf 3 0\n", false);
+    Lit a[3] = { mkLit(1, false), mkLit(2, false), mkLit(1, false) };
+    if (!solver_add_xor(s, a, 3)) FAIL("XOR is satisfiable");
+    if (solver_solve(s) != TRUE || solver_model_value(s, 2) != TRUE) FAIL("Variable 2 should be true");
+    solver_free(s);
+
+    // 3^-3 is always true, 3^3 never
+    s = gauss_solver("p cnf 3 0\n", false);
+    Lit b[2] = { mkLit(3, false), mkLit(3, true) };
+    if (!solver_add_xor(s, b, 2) || solver_solve(s) != TRUE) FAIL("x3 ^ -x3 always holds");
+    solver_free(s);
+
+    s = gauss_solver("p cnf 3 0\n", false);
+    Lit c[2] = { mkLit(3, false), mkLit(3, false) };
+    if (solver_add_xor(s, c, 2)) FAIL("x3 ^ x3 should be refused");
+    if (solver_solve(s) != FALSE) FAIL("x3 ^ x3 never holds");
+    solver_free(s);
+    PASS();
+}
+
+void test_inconsistent_system() {
+    TEST("Inconsistent XOR systems are refuted without search");
+
+    // The sum of the first two rows contradicts the third
+    const char* cnf = "p cnf 5 3\nx1 2 3 0\nx-3 4 5 0\nx -1 2 4 5 0\n";
+    Solver* s = gauss_solver(cnf, true);
+
+    if (solver_solve(s) != FALSE) FAIL("Formula is UNSAT");
+    if (s->stats.conflicts != 0) FAIL("Elimination alone should refute it");
+
+    solver_free(s);
+    PASS();
+}
+
+void test_agreement() {
+    TEST("Search agrees with and without the matrices");
+
+    uint64_t rng = 12345;
+    for (int round = 0; round < 40; round++) {
+        uint32_t n = 30 + rng_below(&rng, 40);
+        uint32_t num_xors = n / 2 + rng_below(&rng, n / 2);
+        uint32_t num_clauses = rng_below(&rng, 2 * n);
+
+        Solver* with = gauss_solver(NULL, true);
+        Solver* without = gauss_solver(NULL, false);
+        for (uint32_t v = 0; v < n; v++) {
+            solver_new_var(with);
+            solver_new_var(without);
+        }
+
+        Var xors[64][4];
+        uint32_t xor_sizes[64];
+        bool xor_rhs[64];
+        if (num_xors > 64) num_xors = 64;
+        for (uint32_t i = 0; i < num_xors; i++) {
+            uint32_t size = 2 + rng_below(&rng, 3);
+            Lit lits[4];
+            xor_rhs[i] = true;
+            for (uint32_t k = 0; k < size; k++) {
+                Var v;
+                bool repeated;
+                do {
+                    v = 1 + rng_below(&rng, n);
+                    repeated = false;
+                    for (uint32_t j = 0; j < k; j++) repeated |= xors[i][j] == v;
+                } while (repeated);
+                xors[i][k] = v;
+                lits[k] = mkLit(v, rng_below(&rng, 2));
+                xor_rhs[i] ^= sign(lits[k]);
+            }
+            xor_sizes[i] = size;
+            solver_add_xor(with, lits, size);
+            solver_add_xor(without, lits, size);
+        }
+        for (uint32_t i = 0; i < num_clauses; i++) {
+            Lit lits[3];
+            for (uint32_t k = 0; k < 3; k++) lits[k] = mkLit(1 + rng_below(&rng, n), rng_below(&rng, 2));
+            solver_add_clause(with, lits, 3);
+            solver_add_clause(without, lits, 3);
+        }
+
+        lbool expected = solver_solve(without);
+        if (solver_solve(with) != expected) FAIL("Results differ");
+        if (expected == TRUE) {
+            for (uint32_t i = 0; i < num_xors; i++) {
+                if (model_parity(with, xors[i], xor_sizes[i]) != xor_rhs[i]) {
+                    FAIL("Model violates an XOR");
+                }
+            }
+        }
+
+        solver_free(with);
+        solver_free(without);
+    }
+
+    PASS();
+}
+
+/*********************************************************************
+ * Main Test Runner
+ *********************************************************************/
+
+int main() {
+    printf("========================================\n");
+    printf("BSAT Gauss-Jordan Unit Tests\n");
+    printf("========================================\n\n");
+
+    test_xor_recovery();
+    test_incomplete_encoding();
+    test_xor_lines();
+    test_long_xor();
+    test_repeated_variables();
+    test_inconsistent_system();
+    test_agreement();
+
+    printf("\n========================================\n");
+    printf("Results: %d/%d tests passed\n", tests_passed, tests_run);
+    printf("========================================\n");
+
+    return (tests_passed == tests_run) ? 0 : 1;
+}
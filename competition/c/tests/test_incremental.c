@@ -0,0 +1,382 @@
+/*********************************************************************
+ * BSAT C Solver - Incremental Solving Unit Tests
+ *
+ * Tests for repeated solving under assumptions, final conflicts,
+ * adding clauses between calls, freezing variables and the persistent
+ * local search state.
+ *********************************************************************/
+
+#include "../include/solver.h"
+#include "../include/dimacs.h"
+#include "../include/elim.h"
+#include "test_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Required for linking (normally defined in main.c)
+bool g_verbose = false;
+
+// Test counter
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define TEST(name) \
+    do { \
+        printf("Testing %s... ", name); \
+        tests_run++; \
+    } while (0)
+
+#define PASS() \
+    do { \
+        printf("✅ PASS\n"); \
+        tests_passed++; \
+    } while (0)
+
+#define FAIL(msg) \
+    do { \
+        printf("❌ FAIL: %s\n", msg); \
+        exit(1); \
+    } while (0)
+
+/*********************************************************************
+ * Helpers
+ *********************************************************************/
+
+static Solver* quiet_solver(void) {
+    SolverOpts opts = default_opts();
+    opts.quiet = true;
+    return solver_new_with_opts(&opts);
+}
+
+static bool conflict_contains(const Solver* s, Lit lit) {
+    uint32_t size;
+    const Lit* conflict = solver_conflict(s, &size);
+    for (uint32_t i = 0; i < size; i++) {
+        if (conflict[i] == lit) return true;
+    }
+    return false;
+}
+
+// Pigeonhole PHP(holes + 1, holes) with every clause guarded by the
+// selector variable: UNSAT only when the selector is assumed true
+static Solver* guarded_pigeonhole(uint32_t holes, Var* selector) {
+    Solver* s = quiet_solver();
+    uint32_t pigeons = holes + 1;
+    Var sel = pigeons * holes + 1;
+    while (s->num_vars < sel) solver_new_var(s);
+
+    Lit lits[32];
+    for (uint32_t p = 0; p < pigeons; p++) {
+        uint32_t n = 0;
+        for (uint32_t h = 0; h < holes; h++) lits[n++] = mkLit(p * holes + h + 1, false);
+        lits[n++] = mkLit(sel, true);
+        solver_add_clause(s, lits, n);
+    }
+    for (uint32_t h = 0; h < holes; h++) {
+        for (uint32_t p = 0; p < pigeons; p++) {
+            for (uint32_t q = p + 1; q < pigeons; q++) {
+                lits[0] = mkLit(p * holes + h + 1, true);
+                lits[1] = mkLit(q * holes + h + 1, true);
+                lits[2] = mkLit(sel, true);
+                solver_add_clause(s, lits, 3);
+            }
+        }
+    }
+
+    *selector = sel;
+    return s;
+}
+
+/*********************************************************************
+ * Test Cases
+ *********************************************************************/
+
+void test_repeated_assumptions() {
+    TEST("Repeated solves under different assumptions");
+
+    // (x1 ∨ x2) ∧ (~x1 ∨ x3)
+    Solver* s = quiet_solver();
+    dimacs_parse_string(s, "p cnf 3 2\n1 2 0\n-1 3 0\n");
+
+    Lit a1[1] = { mkLit(3, true) };
+    if (solver_solve_with_assumptions(s, a1, 1) != TRUE) FAIL("~x3 should be SAT");
+    if (solver_model_value(s, 3) != FALSE || solver_model_value(s, 1) != FALSE ||
+        solver_model_value(s, 2) != TRUE) {
+        FAIL("~x3 forces ~x1 and x2");
+    }
+    if (s->decision_level != 0) FAIL("Solver should return to level 0");
+
+    Lit a2[2] = { mkLit(3, true), mkLit(2, true) };
+    if (solver_solve_with_assumptions(s, a2, 2) != FALSE) FAIL("~x3, ~x2 should be UNSAT");
+    if (s->result == FALSE) FAIL("Failed assumptions must not mark the formula UNSAT");
+    uint32_t size;
+    solver_conflict(s, &size);
+    if (size != 2 || !conflict_contains(s, mkLit(3, false)) || !conflict_contains(s, mkLit(2, false))) {
+        FAIL("Conflict should be (x3 ∨ x2)");
+    }
+
+    if (solver_solve(s) != TRUE) FAIL("Formula without assumptions is SAT");
+    solver_conflict(s, &size);
+    if (size != 0) FAIL("SAT answer should clear the conflict");
+    if (s->incremental.solves != 3) FAIL("Expected 3 solve calls");
+
+    solver_free(s);
+    PASS();
+}
+
+void test_conflict_subset() {
+    TEST("Final conflict holds only the needed assumptions");
+
+    // x4 is unrelated; x1 and x2 cannot both hold
+    Solver* s = quiet_solver();
+    dimacs_parse_string(s, "p cnf 4 2\n-1 -2 0\n3 4 0\n");
+
+    Lit assumps[3] = { mkLit(4, false), mkLit(1, false), mkLit(2, false) };
+    if (solver_solve_with_assumptions(s, assumps, 3) != FALSE) FAIL("x1, x2 should conflict");
+    uint32_t size;
+    solver_conflict(s, &size);
+    if (size != 2 || !conflict_contains(s, mkLit(1, true)) || !conflict_contains(s, mkLit(2, true))) {
+        FAIL("Conflict should be (~x1 ∨ ~x2)");
+    }
+    if (conflict_contains(s, mkLit(4, true))) FAIL("x4 is not part of the conflict");
+
+    // An assumption falsified at level 0 is a conflict on its own
+    Lit unit[1] = { mkLit(3, true) };
+    solver_add_clause(s, unit, 1);
+    Lit a2[1] = { mkLit(3, false) };
+    if (solver_solve_with_assumptions(s, a2, 1) != FALSE) FAIL("x3 is false at level 0");
+    solver_conflict(s, &size);
+    if (size != 1 || !conflict_contains(s, mkLit(3, true))) FAIL("Conflict should be (~x3)");
+
+    solver_free(s);
+    PASS();
+}
+
+void test_add_clauses_between_solves() {
+    TEST("Adding clauses between solves (model enumeration)");
+
+    // (x1 ∨ x2 ∨ x3) has 7 models over three variables
+    Solver* s = quiet_solver();
+    dimacs_parse_string(s, "p cnf 3 1\n1 2 3 0\n");
+
+    uint32_t models = 0;
+    while (solver_solve(s) == TRUE && models < 10) {
+        models++;
+        bool x[4];
+        for (Var v = 1; v <= 3; v++) x[v] = solver_model_value(s, v) == TRUE;
+        if (!(x[1] || x[2] || x[3])) FAIL("Model does not satisfy formula");
+
+        // Block this model
+        Lit block[3];
+        for (Var v = 1; v <= 3; v++) block[v - 1] = mkLit(v, x[v]);
+        solver_add_clause(s, block, 3);
+    }
+
+    if (models != 7) FAIL("Expected exactly 7 models");
+    if (s->result != FALSE) FAIL("All models blocked: formula is UNSAT");
+    uint32_t size;
+    solver_conflict(s, &size);
+    if (size != 0) FAIL("Formula UNSAT should give an empty conflict");
+    if (solver_solve(s) != FALSE) FAIL("UNSAT is final");
+
+    solver_free(s);
+    PASS();
+}
+
+void test_learnts_kept() {
+    TEST("Learned clauses carry over between calls");
+
+    Var sel;
+    Solver* s = guarded_pigeonhole(5, &sel);
+
+    Lit on[1] = { mkLit(sel, false) };
+    if (solver_solve_with_assumptions(s, on, 1) != FALSE) FAIL("Guarded PHP(6,5) should be UNSAT");
+    if (!conflict_contains(s, mkLit(sel, true))) FAIL("Conflict should blame the selector");
+    uint64_t first = s->stats.conflicts;
+    if (first == 0 || s->stats.learned_clauses == 0) FAIL("Refutation should learn clauses");
+
+    // Without the selector the formula is satisfiable
+    if (solver_solve(s) != TRUE) FAIL("Unguarded formula should be SAT");
+    if (solver_model_value(s, sel) != FALSE) FAIL("Model must switch the selector off");
+
+    // Nothing was lost: the second refutation is answered faster
+    uint64_t before = s->stats.conflicts;
+    if (solver_solve_with_assumptions(s, on, 1) != FALSE) FAIL("Second call should be UNSAT");
+    if (s->stats.conflicts - before >= first) FAIL("Second refutation should reuse learned clauses");
+
+    solver_free(s);
+    PASS();
+}
+
+void test_frozen_survive_elimination() {
+    TEST("Frozen variables are not eliminated");
+
+    // Every variable occurs in at most two clauses and is cheap to eliminate
+    SolverOpts opts = default_opts();
+    opts.quiet = true;
+    opts.elim = true;
+    Solver* s = solver_new_with_opts(&opts);
+    dimacs_parse_string(s, "p cnf 5 4\n1 2 0\n-2 3 0\n3 4 0\n-4 5 0\n");
+
+    solver_set_frozen(s, 2, true);
+    solver_set_frozen(s, 3, true);
+    if (!solver_is_frozen(s, 2) || solver_is_frozen(s, 4)) FAIL("Wrong frozen flags");
+
+    // First call: x5 is frozen automatically as an assumption
+    Lit a1[1] = { mkLit(5, true) };
+    if (solver_solve_with_assumptions(s, a1, 1) != TRUE) FAIL("~x5 should be SAT");
+    if (!solver_is_frozen(s, 5)) FAIL("Assumption variables should be frozen");
+    if (!s->elim) FAIL("BVE should have run");
+    if (s->elim->eliminated[2] || s->elim->eliminated[3] || s->elim->eliminated[5]) {
+        FAIL("Frozen variables were eliminated");
+    }
+
+    // Frozen variables can still be assumed later
+    Lit a2[2] = { mkLit(2, false), mkLit(3, true) };
+    if (solver_solve_with_assumptions(s, a2, 2) != FALSE) FAIL("x2, ~x3 should be UNSAT");
+    Lit a3[1] = { mkLit(2, false) };
+    if (solver_solve_with_assumptions(s, a3, 1) != TRUE) FAIL("x2 should be SAT");
+    bool x[6];
+    for (Var v = 1; v <= 5; v++) x[v] = solver_model_value(s, v) == TRUE;
+    if (!((x[1] || x[2]) && (!x[2] || x[3]) && (x[3] || x[4]) && (!x[4] || x[5])) || !x[2]) {
+        FAIL("Model does not satisfy formula");
+    }
+
+    solver_free(s);
+    PASS();
+}
+
+// Solve a DIMACS string from scratch, without BVE or BCE
+static lbool reference_solve(const char* dimacs) {
+    Solver* s = quiet_solver();
+    dimacs_parse_string(s, dimacs);
+    lbool result = solver_solve(s);
+    solver_free(s);
+    return result;
+}
+
+void test_clauses_on_eliminated_vars() {
+    TEST("Clauses and assumptions on eliminated variables restore them");
+
+    // Random 3-SAT below the threshold (three distinct variables per
+    // clause) leaves many variables to BVE and BCE; clauses and
+    // assumptions added later mention some of them
+    enum { VARS = 30, CLAUSES = 90, ADDED = 12, ROUNDS = 300 };
+    char body[(CLAUSES + ADDED + 1) * 16];
+    char cnf[sizeof(body) + 32];
+    uint64_t rng = 0x2545f4914f6cdd1dULL;
+    uint32_t touched = 0;
+    for (int round = 0; round < ROUNDS; round++) {
+        SolverOpts opts = default_opts();
+        opts.quiet = true;
+        opts.elim = true;
+        opts.bce = true;
+        Solver* s = solver_new_with_opts(&opts);
+        for (Var v = 1; v <= VARS; v++) solver_new_var(s);
+
+        size_t len = 0;
+        for (int i = 0; i < CLAUSES + ADDED; i++) {
+            if (i == CLAUSES) {
+                if (solver_solve(s) == UNDEF) FAIL("First call should finish");
+                if (!s->elim) FAIL("BVE should have run");
+            }
+            Lit lits[3];
+            for (int k = 0; k < 3; k++) {
+                int lit;
+                bool repeated;
+                do {
+                    rng ^= rng << 13; rng ^= rng >> 7; rng ^= rng << 17;
+                    lit = (int)(rng % VARS + 1) * ((rng >> 32) & 1 ? -1 : 1);
+                    repeated = false;
+                    for (int j = 0; j < k; j++) repeated |= (int)var(lits[j]) == abs(lit);
+                } while (repeated);
+                len += (size_t)sprintf(body + len, "%d ", lit);
+                lits[k] = fromDimacs(lit);
+                if (i >= CLAUSES && elim_is_eliminated(s, var(lits[k]))) touched++;
+            }
+            len += (size_t)sprintf(body + len, "0\n");
+            solver_add_clause(s, lits, 3);
+        }
+
+        // Without assumptions, as a plain clause set
+        lbool result = solver_solve(s);
+        sprintf(cnf, "p cnf %d %d\n%s", VARS, CLAUSES + ADDED, body);
+        if (result != reference_solve(cnf)) FAIL("Wrong result after adding clauses");
+        if (result == TRUE && !model_satisfies(s, cnf)) FAIL("Model violates an added clause");
+
+        // Assume a literal on an eliminated variable if there is one,
+        // checked against the reference as a unit clause
+        Var assumed = 1;
+        for (Var v = 1; v <= VARS; v++) {
+            if (elim_is_eliminated(s, v)) assumed = v;
+        }
+        Lit a[1] = { mkLit(assumed, round & 1) };
+        result = solver_solve_with_assumptions(s, a, 1);
+        sprintf(cnf, "p cnf %d %d\n%s%d 0\n", VARS, CLAUSES + ADDED + 1, body, toDimacs(a[0]));
+        if (result != reference_solve(cnf)) FAIL("Wrong result under the assumption");
+        if (result == TRUE && !model_satisfies(s, cnf)) FAIL("Model violates the assumption");
+        solver_free(s);
+    }
+    if (touched == 0) FAIL("No added clause mentioned an eliminated variable");
+
+    PASS();
+}
+
+void test_local_search_persistent() {
+    TEST("Local search state follows added clauses and units");
+
+    SolverOpts opts = default_opts();
+    opts.quiet = true;
+    opts.local_search = true;
+    Solver* s = solver_new_with_opts(&opts);
+    dimacs_parse_string(s, "p cnf 3 2\n1 2 0\n-1 3 0\n");
+
+    LocalSearchState* ls = local_search_init(s);
+    if (!ls) FAIL("Could not build local search state");
+    s->local_search.state = ls;  // Owned by the solver from here on
+    uint32_t initial = ls->num_clauses;
+    if (!local_search_run(s, ls, 1000, 0.5)) FAIL("LS should satisfy (x1 ∨ x2)(¬x1 ∨ x3)");
+
+    // Clauses added to the solver are appended to the same state
+    Lit c[2] = { mkLit(2, true), mkLit(3, true) };
+    solver_add_clause(s, c, 2);
+    if (s->local_search.state != ls) FAIL("State should be kept");
+    if (ls->num_clauses != initial + 1 || ls->added_clauses != 1) FAIL("Clause not appended");
+
+    // A level-0 unit fixes x1: the only model left is ¬x1, x2, ¬x3
+    Lit u[1] = { mkLit(1, true) };
+    solver_add_clause(s, u, 1);
+    if (!local_search_run(s, ls, 1000, 0.5)) FAIL("LS should find the remaining model");
+    if (ls->assignment[1] || !ls->assignment[2] || ls->assignment[3]) FAIL("Wrong LS model");
+
+    solver_free(s);
+    PASS();
+}
+
+/*********************************************************************
+ * Main Test Runner
+ *********************************************************************/
+
+int main() {
+    printf("========================================\n");
+    printf("BSAT Incremental Solving Unit Tests\n");
+    printf("========================================\n\n");
+
+    // Assumptions and conflicts
+    test_repeated_assumptions();
+    test_conflict_subset();
+
+    // State kept between calls
+    test_add_clauses_between_solves();
+    test_learnts_kept();
+    test_frozen_survive_elimination();
+    test_clauses_on_eliminated_vars();
+    test_local_search_persistent();
+
+    printf("\n========================================\n");
+    printf("Results: %d/%d tests passed\n", tests_passed, tests_run);
+    printf("========================================\n");
+
+    return (tests_passed == tests_run) ? 0 : 1;
+}
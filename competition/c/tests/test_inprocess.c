@@ -0,0 +1,221 @@
+/*********************************************************************
+ * BSAT C Solver - Inprocessing Scheduler Unit Tests
+ *
+ * Tests for the per-technique inprocessing schedule: interval back-off,
+ * independence of solver instances, BVE during search, frozen
+ * assumptions and probing from a fully propagated level 0.
+ *********************************************************************/
+
+#include "../include/solver.h"
+#include "../include/dimacs.h"
+#include "test_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Required for linking (normally defined in main.c)
+bool g_verbose = false;
+
+// Test counter
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define TEST(name) \
+    do { \
+        printf("Testing %s... ", name); \
+        tests_run++; \
+    } while (0)
+
+#define PASS() \
+    do { \
+        printf("✅ PASS\n"); \
+        tests_passed++; \
+    } while (0)
+
+#define FAIL(msg) \
+    do { \
+        printf("❌ FAIL: %s\n", msg); \
+        exit(1); \
+    } while (0)
+
+/*********************************************************************
+ * Helpers
+ *********************************************************************/
+
+// Every technique enabled, with a short base interval
+static Solver* inprocess_solver(uint32_t interval) {
+    SolverOpts opts = default_opts();
+    opts.quiet = true;
+    opts.inprocess = true;
+    opts.inprocess_interval = interval;
+    opts.bce = true;
+    opts.elim = true;
+    opts.elim_threads = 1;
+    return solver_new_with_opts(&opts);
+}
+
+// Random 3-SAT near the threshold, as DIMACS
+static char* random_3sat(uint32_t vars, uint32_t clauses, uint32_t seed) {
+    char* buf = (char*)malloc(32 + clauses * 40);
+    int n = sprintf(buf, "p cnf %u %u\n", vars, clauses);
+    for (uint32_t c = 0; c < clauses; c++) {
+        for (int k = 0; k < 3; k++) {
+            seed = seed * 1103515245u + 12345u;
+            int v = (int)((seed >> 8) % vars) + 1;
+            n += sprintf(buf + n, "%d ", (seed >> 4) & 1 ? v : -v);
+        }
+        n += sprintf(buf + n, "0\n");
+    }
+    return buf;
+}
+
+/*********************************************************************
+ * Test Cases
+ *********************************************************************/
+
+void test_probing_pending_units() {
+    TEST("Probing starts from a fully propagated level 0");
+
+    // The units are still unpropagated when preprocessing probes; their
+    // consequences must not be lost when a probe backtracks
+    SolverOpts opts = default_opts();
+    opts.quiet = true;
+    Solver* s = solver_new_with_opts(&opts);
+    dimacs_parse_string(s, "p cnf 17 5\n-17 5 -8 0\n-15 0\n17 15 0\n-5 0\n8 0\n");
+
+    if (solver_solve(s) != FALSE) FAIL("Formula is UNSAT");
+
+    solver_free(s);
+    PASS();
+}
+
+void test_schedule_backoff() {
+    TEST("Intervals stay between the base and its back-off limit");
+
+    char* cnf = random_3sat(150, 630, 7);
+    Solver* s = inprocess_solver(20);
+    dimacs_parse_string(s, cnf);
+
+    lbool result = solver_solve(s);
+    if (result == UNDEF) FAIL("Solver returned UNKNOWN");
+    if (result == TRUE && !model_satisfies(s, cnf)) FAIL("Model does not satisfy formula");
+
+    // Intervals are in ticks, based on the ticks of the first 20 conflicts
+    uint64_t base = s->inprocess.base;
+    if (base == 0) FAIL("Base interval should be measured");
+    bool backed_off = false;
+    for (int t = 0; t < INPROCESS_TECHNIQUES; t++) {
+        const InprocessSchedule* sched = &s->inprocess.sched[t];
+        if (sched->rounds == 0) FAIL("Every technique should run");
+        if (sched->interval < base || sched->interval > base * INPROCESS_MAX_SCALE) {
+            FAIL("Interval out of range");
+        }
+        if (sched->interval > base) backed_off = true;
+    }
+    if (!backed_off) FAIL("Fruitless rounds should back off");
+
+    solver_free(s);
+    free(cnf);
+    PASS();
+}
+
+void test_instances_independent() {
+    TEST("Solver instances keep separate schedules");
+
+    char* cnf = random_3sat(150, 630, 11);
+    Solver* a = inprocess_solver(20);
+    Solver* b = inprocess_solver(20);
+    dimacs_parse_string(a, cnf);
+    dimacs_parse_string(b, cnf);
+
+    // b starts after a has run all its rounds, and must repeat them
+    lbool ra = solver_solve(a);
+    lbool rb = solver_solve(b);
+    if (ra != rb) FAIL("Different answers");
+    if (a->stats.conflicts != b->stats.conflicts) FAIL("Different searches");
+    for (int t = 0; t < INPROCESS_TECHNIQUES; t++) {
+        const InprocessSchedule* sa = &a->inprocess.sched[t];
+        const InprocessSchedule* sb = &b->inprocess.sched[t];
+        if (sa->rounds != sb->rounds || sa->productive != sb->productive ||
+            sa->interval != sb->interval || sa->effort != sb->effort) {
+            FAIL("Schedules differ");
+        }
+    }
+
+    solver_free(a);
+    solver_free(b);
+    free(cnf);
+    PASS();
+}
+
+void test_elim_during_search() {
+    TEST("BVE during search drops learned clauses over eliminated variables");
+
+    // x151 only occurs in two clauses and is eliminated by the first round
+    char* base = random_3sat(150, 630, 3);
+    char* cnf = (char*)malloc(strlen(base) + 64);
+    sprintf(cnf, "p cnf 151 632\n%s151 1 2 0\n-151 3 0\n", strchr(base, '\n') + 1);
+    Solver* s = inprocess_solver(10);
+    dimacs_parse_string(s, cnf);
+    s->incremental.preprocessed = true;  // Leave all the work to inprocessing
+
+    lbool result = solver_solve(s);
+    if (result == UNDEF) FAIL("Solver returned UNKNOWN");
+    if (!s->elim || !s->elim->eliminated[151]) FAIL("x151 should be eliminated");
+    if (s->inprocess.sched[INPROCESS_ELIM].productive == 0) FAIL("BVE round should be productive");
+    for (uint32_t i = 0; i < s->num_learnts; i++) {
+        CRef cref = s->learnts[i];
+        if (clause_deleted(s->arena, cref)) continue;
+        const Lit* lits = CLAUSE_LITS(s->arena, cref);
+        for (uint32_t k = 0; k < CLAUSE_SIZE(s->arena, cref); k++) {
+            if (s->elim->eliminated[var(lits[k])]) FAIL("Learned clause over eliminated variable");
+        }
+    }
+    if (result == TRUE && !model_satisfies(s, cnf)) FAIL("Model does not satisfy formula");
+
+    solver_free(s);
+    free(base);
+    free(cnf);
+    PASS();
+}
+
+void test_assumptions_frozen() {
+    TEST("Assumed variables are frozen in every call");
+
+    Solver* s = inprocess_solver(10);
+    dimacs_parse_string(s, "p cnf 4 3\n1 2 0\n-2 3 0\n3 4 0\n");
+
+    // Thawed by the caller between calls, x4 must not be left open to
+    // the inprocessing rounds of the second call
+    Lit assump = mkLit(4, true);
+    if (solver_solve_with_assumptions(s, &assump, 1) != TRUE) FAIL("Formula is SAT under ~x4");
+    solver_set_frozen(s, 4, false);
+    if (solver_solve_with_assumptions(s, &assump, 1) != TRUE) FAIL("Formula is SAT under ~x4");
+    if (!solver_is_frozen(s, 4)) FAIL("x4 should be frozen");
+    if (solver_model_value(s, 4) != FALSE) FAIL("Assumption should hold in the model");
+
+    solver_free(s);
+    PASS();
+}
+
+/*********************************************************************
+ * Main Test Runner
+ *********************************************************************/
+
+int main() {
+    printf("========================================\n");
+    printf("BSAT Inprocessing Scheduler Unit Tests\n");
+    printf("========================================\n\n");
+
+    test_probing_pending_units();
+    test_schedule_backoff();
+    test_instances_independent();
+    test_elim_during_search();
+    test_assumptions_frozen();
+
+    printf("\n========================================\n");
+    printf("Results: %d/%d tests passed\n", tests_passed, tests_run);
+    printf("========================================\n");
+
+    return (tests_passed == tests_run) ? 0 : 1;
+}
@@ -0,0 +1,262 @@
+/*********************************************************************
+ * BSAT C Solver - Portfolio Unit Tests
+ *
+ * Tests for the lock-free clause exchange, worker diversification
+ * and the multi-threaded portfolio driver.
+ *********************************************************************/
+
+#define _POSIX_C_SOURCE 200809L  // mkstemp, fdopen
+
+#include "../include/portfolio.h"
+#include "test_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// Required for linking (normally defined in main.c)
+bool g_verbose = false;
+
+// Test counter
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define TEST(name) \
+    do { \
+        printf("Testing %s... ", name); \
+        tests_run++; \
+    } while (0)
+
+#define PASS() \
+    do { \
+        printf("✅ PASS\n"); \
+        tests_passed++; \
+    } while (0)
+
+#define FAIL(msg) \
+    do { \
+        printf("❌ FAIL: %s\n", msg); \
+        exit(1); \
+    } while (0)
+
+/*********************************************************************
+ * Helpers
+ *********************************************************************/
+
+// Write DIMACS text to a temporary file; returns the path (caller unlinks)
+static char* write_temp_cnf(const char* text) {
+    static char path[64];
+    strcpy(path, "/tmp/bsat_portfolio_XXXXXX");
+    int fd = mkstemp(path);
+    if (fd < 0) return NULL;
+    FILE* f = fdopen(fd, "w");
+    if (!f) { close(fd); return NULL; }
+    fputs(text, f);
+    fclose(f);
+    return path;
+}
+
+/*********************************************************************
+ * Test Cases
+ *********************************************************************/
+
+void test_exchange_round_trip() {
+    TEST("Exchange export/import between two solvers");
+
+    ClauseExchange* ex = exchange_new(2, 16, 4);
+    if (!ex) FAIL("Failed to create exchange");
+
+    Solver* a = solver_new();
+    Solver* b = solver_new();
+    for (int i = 0; i < 4; i++) {
+        solver_new_var(a);
+        solver_new_var(b);
+    }
+    if (!exchange_attach(ex, a, 0) || !exchange_attach(ex, b, 1)) {
+        FAIL("Failed to attach solvers");
+    }
+
+    // A publishes a unit and a binary, plus a high-LBD clause that must be filtered
+    Lit unit[1] = { mkLit(1, false) };
+    Lit bin[2] = { mkLit(2, true), mkLit(3, false) };
+    Lit wide[3] = { mkLit(2, false), mkLit(3, false), mkLit(4, false) };
+    exchange_export(a, unit, 1, 1);
+    exchange_export(a, bin, 2, 2);
+    exchange_export(a, wide, 3, 9);
+
+    if (!exchange_import(b)) FAIL("Import reported UNSAT");
+    if (b->share.imported != 2) FAIL("Expected exactly 2 imported clauses");
+    if (b->share.imported_units != 1) FAIL("Expected 1 imported unit");
+    if (var_value(b, 1) != TRUE) FAIL("Imported unit should be assigned at level 0");
+
+    // A solver never imports its own clauses
+    if (!exchange_import(a)) FAIL("Self import reported UNSAT");
+    if (a->share.imported != 0) FAIL("Solver imported its own clauses");
+
+    // A second import sees nothing new
+    if (!exchange_import(b) || b->share.imported != 2) {
+        FAIL("Repeated import should be empty");
+    }
+
+    a->share.exchange = NULL;
+    b->share.exchange = NULL;
+    solver_free(a);
+    solver_free(b);
+    exchange_free(ex);
+    PASS();
+}
+
+void test_exchange_lapped_reader() {
+    TEST("Exchange reader skips overwritten slots");
+
+    ClauseExchange* ex = exchange_new(2, 4, 8);
+    Solver* a = solver_new();
+    Solver* b = solver_new();
+    for (int i = 0; i < 20; i++) {
+        solver_new_var(a);
+        solver_new_var(b);
+    }
+    exchange_attach(ex, a, 0);
+    exchange_attach(ex, b, 1);
+
+    // Publish more clauses than the ring holds before b reads anything
+    for (Var v = 1; v <= 10; v++) {
+        Lit lits[2] = { mkLit(v, false), mkLit(v + 10, false) };
+        exchange_export(a, lits, 2, 2);
+    }
+
+    if (!exchange_import(b)) FAIL("Import reported UNSAT");
+    if (b->share.imported == 0 || b->share.imported > 4) {
+        FAIL("Lapped reader should import at most one ring of clauses");
+    }
+
+    a->share.exchange = NULL;
+    b->share.exchange = NULL;
+    solver_free(a);
+    solver_free(b);
+    exchange_free(ex);
+    PASS();
+}
+
+void test_worker_diversity() {
+    TEST("Worker options are diversified");
+
+    SolverOpts base = default_opts();
+    SolverOpts w0 = portfolio_worker_opts(&base, 0);
+    if (w0.lrb != base.lrb || w0.glucose_restart != base.glucose_restart) {
+        FAIL("Worker 0 should run the base configuration");
+    }
+
+    SolverOpts w1 = portfolio_worker_opts(&base, 1);
+    SolverOpts w2 = portfolio_worker_opts(&base, 2);
+    if (w1.seed == w0.seed || w2.seed == w1.seed) {
+        FAIL("Workers should use distinct seeds");
+    }
+    if (w1.lrb == w2.lrb && w1.luby_restart == w2.luby_restart) {
+        FAIL("Workers 1 and 2 should differ");
+    }
+    if (portfolio_worker_name(0) == NULL || portfolio_worker_name(1000) == NULL) {
+        FAIL("Worker names should always be defined");
+    }
+
+    PASS();
+}
+
+void test_portfolio_sat() {
+    TEST("Portfolio solves SAT instance");
+
+    const char* cnf =
+        "p cnf 4 5\n"
+        "1 2 0\n"
+        "-1 3 0\n"
+        "-2 -3 0\n"
+        "3 4 0\n"
+        "-4 1 0\n";
+    char* path = write_temp_cnf(cnf);
+    if (!path) FAIL("Could not create temp file");
+
+    SolverOpts opts = default_opts();
+    opts.quiet = true;
+    Solver* s = NULL;
+    DimacsError err;
+    lbool result = portfolio_solve(&opts, path, 4, &s, &err);
+    unlink(path);
+
+    if (err != DIMACS_OK || !s) FAIL("Portfolio parse failed");
+    if (result != TRUE) FAIL("Should be SAT");
+
+    // Check the winner's model against the formula
+    bool x1 = solver_model_value(s, 1) == TRUE;
+    bool x2 = solver_model_value(s, 2) == TRUE;
+    bool x3 = solver_model_value(s, 3) == TRUE;
+    bool x4 = solver_model_value(s, 4) == TRUE;
+    if (!((x1 || x2) && (!x1 || x3) && (!x2 || !x3) && (x3 || x4) && (!x4 || x1))) {
+        FAIL("Model does not satisfy formula");
+    }
+
+    solver_free(s);
+    PASS();
+}
+
+void test_portfolio_unsat() {
+    TEST("Portfolio proves pigeonhole UNSAT");
+
+    char* cnf = pigeonhole_cnf(6);
+    if (!cnf) FAIL("Out of memory");
+    char* path = write_temp_cnf(cnf);
+    free(cnf);
+    if (!path) FAIL("Could not create temp file");
+
+    SolverOpts opts = default_opts();
+    opts.quiet = true;
+    Solver* s = NULL;
+    DimacsError err;
+    lbool result = portfolio_solve(&opts, path, 3, &s, &err);
+    unlink(path);
+
+    if (err != DIMACS_OK || !s) FAIL("Portfolio parse failed");
+    if (result != FALSE) FAIL("PHP(7,6) should be UNSAT");
+
+    solver_free(s);
+    PASS();
+}
+
+void test_portfolio_missing_file() {
+    TEST("Portfolio reports missing file");
+
+    SolverOpts opts = default_opts();
+    opts.quiet = true;
+    Solver* s = NULL;
+    DimacsError err;
+    portfolio_solve(&opts, "/nonexistent/bsat.cnf", 2, &s, &err);
+
+    if (err == DIMACS_OK) FAIL("Missing file should be a parse error");
+    if (s) solver_free(s);
+    PASS();
+}
+
+/*********************************************************************
+ * Main Test Runner
+ *********************************************************************/
+
+int main() {
+    printf("========================================\n");
+    printf("BSAT Portfolio Unit Tests\n");
+    printf("========================================\n\n");
+
+    // Exchange tests
+    test_exchange_round_trip();
+    test_exchange_lapped_reader();
+
+    // Driver tests
+    test_worker_diversity();
+    test_portfolio_sat();
+    test_portfolio_unsat();
+    test_portfolio_missing_file();
+
+    printf("\n========================================\n");
+    printf("Results: %d/%d tests passed\n", tests_passed, tests_run);
+    printf("========================================\n");
+
+    return (tests_passed == tests_run) ? 0 : 1;
+}
@@ -0,0 +1,407 @@
+/*********************************************************************
+ * BSAT C Solver - DRAT Proof Writer Unit Tests
+ *
+ * Tests for the text and binary DRAT encodings, buffer hand-off to the
+ * writer thread, proof statistics, and a RUP check of the lemmas the
+ * solver logs with clause minimization and shrinking on.
+ *********************************************************************/
+
+#define _POSIX_C_SOURCE 200809L  // mkstemp
+
+#include "../include/proof.h"
+#include "../include/solver.h"
+#include "../include/dimacs.h"
+#include "test_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// Required for linking (normally defined in main.c)
+bool g_verbose = false;
+
+// Test counter
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define TEST(name) \
+    do { \
+        printf("Testing %s... ", name); \
+        tests_run++; \
+    } while (0)
+
+#define PASS() \
+    do { \
+        printf("✅ PASS\n"); \
+        tests_passed++; \
+    } while (0)
+
+#define FAIL(msg) \
+    do { \
+        printf("❌ FAIL: %s\n", msg); \
+        exit(1); \
+    } while (0)
+
+/*********************************************************************
+ * Helpers
+ *********************************************************************/
+
+// Read a whole file; returns its size
+static size_t read_all(const char* path, unsigned char** data) {
+    FILE* f = fopen(path, "rb");
+    if (!f) FAIL("Cannot open proof");
+    fseek(f, 0, SEEK_END);
+    size_t size = (size_t)ftell(f);
+    rewind(f);
+    *data = malloc(size + 1);
+    if (fread(*data, 1, size, f) != size) FAIL("Short read");
+    fclose(f);
+    return size;
+}
+
+// Clause set of a forward RUP check (DIMACS literals)
+typedef struct RupClauses {
+    int**    lits;
+    uint32_t* sizes;
+    uint32_t num;
+    uint32_t capacity;
+} RupClauses;
+
+// Clauses are sets: duplicate literals are dropped, like the solver does
+static void rup_add(RupClauses* c, const int* lits, uint32_t size) {
+    if (c->num == c->capacity) {
+        c->capacity = c->capacity ? 2 * c->capacity : 256;
+        c->lits = realloc(c->lits, c->capacity * sizeof(int*));
+        c->sizes = realloc(c->sizes, c->capacity * sizeof(uint32_t));
+    }
+    int* copy = malloc((size + 1) * sizeof(int));
+    uint32_t n = 0;
+    for (uint32_t k = 0; k < size; k++) {
+        uint32_t j = 0;
+        while (j < n && copy[j] != lits[k]) j++;
+        if (j == n) copy[n++] = lits[k];
+    }
+    c->lits[c->num] = copy;
+    c->sizes[c->num++] = n;
+}
+
+// Remove one clause with the same literals (in any order)
+static void rup_delete(RupClauses* c, const int* lits, uint32_t size) {
+    for (uint32_t i = 0; i < c->num; i++) {
+        if (c->sizes[i] != size) continue;
+        uint32_t found = 0;
+        for (uint32_t k = 0; k < size; k++) {
+            for (uint32_t j = 0; j < size; j++) {
+                if (c->lits[i][j] == lits[k]) {
+                    found++;
+                    break;
+                }
+            }
+        }
+        if (found == size) {
+            free(c->lits[i]);
+            c->lits[i] = c->lits[--c->num];
+            c->sizes[i] = c->sizes[c->num];
+            return;
+        }
+    }
+}
+
+// Does unit propagation on the negated lemma reach a conflict?
+static bool rup_implied(const RupClauses* c, const int* lemma, uint32_t size, int num_vars) {
+    signed char* val = calloc(num_vars + 1, 1);
+    bool conflict = false;
+    for (uint32_t k = 0; k < size && !conflict; k++) {
+        int v = abs(lemma[k]);
+        signed char want = lemma[k] > 0 ? -1 : 1;
+        if (val[v] == -want) conflict = true;  // Tautology
+        val[v] = want;
+    }
+    for (bool changed = true; changed && !conflict; ) {
+        changed = false;
+        for (uint32_t i = 0; i < c->num && !conflict; i++) {
+            int unit = 0;
+            uint32_t open = 0;
+            bool sat = false;
+            for (uint32_t j = 0; j < c->sizes[i] && !sat; j++) {
+                int lit = c->lits[i][j];
+                signed char v = val[abs(lit)];
+                if (v == 0) {
+                    open++;
+                    unit = lit;
+                } else {
+                    sat = (v > 0) == (lit > 0);
+                }
+            }
+            if (sat || open > 1) continue;
+            if (open == 0) {
+                conflict = true;
+            } else {
+                val[abs(unit)] = unit > 0 ? 1 : -1;
+                changed = true;
+            }
+        }
+    }
+    free(val);
+    return conflict;
+}
+
+/*********************************************************************
+ * Test Cases
+ *********************************************************************/
+
+void test_binary_encoding() {
+    TEST("Binary DRAT encoding");
+
+    char path[32];
+    if (!make_temp(path)) FAIL("Could not create temp file");
+
+    ProofWriter* p = proof_open(path, true, true);
+    if (!p) FAIL("Could not open proof");
+    Lit add[3] = { mkLit(1, false), mkLit(63, true), mkLit(64, false) };
+    Lit del[1] = { mkLit(8192, true) };
+    proof_add(p, add, 3);
+    proof_delete(p, del, 1);
+    proof_add(p, NULL, 0);
+    ProofStats stats = proof_stats(p);
+    if (!proof_close(p)) FAIL("Close failed");
+
+    // 1 -> 2, -63 -> 127, 64 -> 128 (two bytes), -8192 -> 16385 (three bytes)
+    const unsigned char expected[] = {
+        'a', 0x02, 0x7f, 0x80, 0x01, 0x00,
+        'd', 0x81, 0x80, 0x01, 0x00,
+        'a', 0x00
+    };
+    unsigned char* data;
+    size_t size = read_all(path, &data);
+    if (size != sizeof(expected) || memcmp(data, expected, size) != 0) FAIL("Wrong binary encoding");
+    if (stats.added != 2 || stats.deleted != 1 || stats.bytes != sizeof(expected)) FAIL("Wrong stats");
+
+    free(data);
+    unlink(path);
+    PASS();
+}
+
+void test_text_encoding() {
+    TEST("Text DRAT encoding");
+
+    char path[32];
+    if (!make_temp(path)) FAIL("Could not create temp file");
+
+    ProofWriter* p = proof_open(path, false, false);
+    if (!p) FAIL("Could not open proof");
+    Lit add[2] = { mkLit(10, true), mkLit(4000000, false) };
+    proof_add(p, add, 2);
+    proof_delete(p, add + 1, 1);
+    if (!proof_close(p)) FAIL("Close failed");
+
+    const char* expected = "-10 4000000 0\nd 4000000 0\n";
+    unsigned char* data;
+    size_t size = read_all(path, &data);
+    data[size] = '\0';
+    if (strcmp((char*)data, expected) != 0) FAIL("Wrong text encoding");
+
+    free(data);
+    unlink(path);
+    PASS();
+}
+
+void test_many_buffers() {
+    TEST("Threaded and direct writers agree across buffers");
+
+    // Several times PROOF_BUFFERS * PROOF_BUFFER_SIZE, including one
+    // clause longer than a whole buffer
+    char threaded_path[32], direct_path[32];
+    if (!make_temp(threaded_path) || !make_temp(direct_path)) FAIL("Could not create temp files");
+
+    ProofWriter* a = proof_open(threaded_path, true, true);
+    ProofWriter* b = proof_open(direct_path, true, false);
+    if (!a || !b) FAIL("Could not open proofs");
+
+    uint32_t long_size = PROOF_BUFFER_SIZE / 2;
+    Lit* lits = malloc(long_size * sizeof(Lit));
+    for (uint32_t i = 0; i < long_size; i++) lits[i] = mkLit(100000 + i, i & 1);
+    proof_add(a, lits, long_size);
+    proof_add(b, lits, long_size);
+
+    uint64_t seed = 12345;
+    for (uint32_t c = 0; c < 3000000; c++) {
+        Lit clause[4];
+        for (int i = 0; i < 4; i++) {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            clause[i] = mkLit((Var)((seed >> 33) % 1000000) + 1, (seed >> 20) & 1);
+        }
+        if (c % 3 == 0) {
+            proof_delete(a, clause, 4);
+            proof_delete(b, clause, 4);
+        } else {
+            proof_add(a, clause, 4);
+            proof_add(b, clause, 4);
+        }
+    }
+    ProofStats sa = proof_stats(a);
+    ProofStats sb = proof_stats(b);
+    if (!proof_close(a) || !proof_close(b)) FAIL("Close failed");
+
+    unsigned char *da, *db;
+    size_t na = read_all(threaded_path, &da);
+    size_t nb = read_all(direct_path, &db);
+    if (na < (size_t)PROOF_BUFFERS * PROOF_BUFFER_SIZE) FAIL("Test proof too small");
+    if (na != nb || memcmp(da, db, na) != 0) FAIL("Threaded proof differs");
+    if (sa.bytes != na || sb.bytes != nb) FAIL("Byte counts differ from file size");
+
+    free(lits);
+    free(da);
+    free(db);
+    unlink(threaded_path);
+    unlink(direct_path);
+    PASS();
+}
+
+void test_solver_binary_proof() {
+    TEST("Solver writes a binary proof");
+
+    // PHP(4,3)
+    const char* cnf =
+        "p cnf 12 22\n"
+        "1 2 3 0\n4 5 6 0\n7 8 9 0\n10 11 12 0\n"
+        "-1 -4 0\n-1 -7 0\n-1 -10 0\n-4 -7 0\n-4 -10 0\n-7 -10 0\n"
+        "-2 -5 0\n-2 -8 0\n-2 -11 0\n-5 -8 0\n-5 -11 0\n-8 -11 0\n"
+        "-3 -6 0\n-3 -9 0\n-3 -12 0\n-6 -9 0\n-6 -12 0\n-9 -12 0\n";
+
+    char path[32];
+    if (!make_temp(path)) FAIL("Could not create temp file");
+    SolverOpts opts = default_opts();
+    opts.quiet = true;
+    opts.proof_path = path;
+    opts.binary_proof = true;
+    Solver* s = solver_new_with_opts(&opts);
+    dimacs_parse_string(s, cnf);
+    if (solver_solve(s) != FALSE) FAIL("PHP(4,3) is UNSAT");
+
+    ProofStats stats = proof_stats(s->proof);
+    if (stats.added == 0) FAIL("Refutation should log lemmas");
+    solver_free(s);
+
+    // Every record is a tag followed by literals and a 0 byte
+    unsigned char* data;
+    size_t size = read_all(path, &data);
+    if (size != stats.bytes) FAIL("Stats disagree with file size");
+    uint64_t added = 0;
+    size_t i = 0;
+    while (i < size) {
+        if (data[i] != 'a' && data[i] != 'd') FAIL("Bad record tag");
+        if (data[i++] == 'a') added++;
+        uint32_t value;
+        do {
+            value = 0;
+            for (int shift = 0; ; shift += 7) {
+                if (i >= size) FAIL("Truncated record");
+                unsigned char byte = data[i++];
+                value |= (uint32_t)(byte & 0x7f) << shift;
+                if (!(byte & 0x80)) break;
+            }
+            if (value != 0 && (value >> 1) > 12) FAIL("Literal out of range");
+        } while (value != 0);
+    }
+    if (added != stats.added) FAIL("Record count disagrees with stats");
+
+    free(data);
+    unlink(path);
+    PASS();
+}
+
+void test_minimized_lemmas_are_rup() {
+    TEST("Proofs with minimization and shrinking check as RUP");
+
+    // Random 3-SAT at ratio 5.5: UNSAT after a few hundred conflicts
+    enum { VARS = 100, CLAUSES = 550 };
+    RupClauses clauses = { NULL, NULL, 0, 0 };
+    char cnf[CLAUSES * 16 + 32];
+    size_t len = (size_t)sprintf(cnf, "p cnf %d %d\n", VARS, CLAUSES);
+    uint64_t rng = 0x9e3779b97f4a7c15ULL;
+    for (int i = 0; i < CLAUSES; i++) {
+        int lits[3];
+        for (int k = 0; k < 3; k++) {
+            rng ^= rng << 13; rng ^= rng >> 7; rng ^= rng << 17;
+            lits[k] = (int)(rng % VARS + 1) * ((rng >> 32) & 1 ? -1 : 1);
+        }
+        len += (size_t)sprintf(cnf + len, "%d %d %d 0\n", lits[0], lits[1], lits[2]);
+        rup_add(&clauses, lits, 3);
+    }
+
+    char path[32];
+    if (!make_temp(path)) FAIL("Could not create temp file");
+    SolverOpts opts = default_opts();
+    opts.quiet = true;
+    opts.proof_path = path;
+    Solver* s = solver_new_with_opts(&opts);
+    dimacs_parse_string(s, cnf);
+    if (solver_solve(s) != FALSE) FAIL("Formula should be UNSAT");
+    if (s->stats.minimized_literals + s->stats.shrunk_literals == 0) {
+        FAIL("Minimization should remove literals with a proof");
+    }
+    solver_free(s);
+
+    // Check every added lemma against the clauses before it
+    FILE* in = fopen(path, "r");
+    if (!in) FAIL("Cannot open proof");
+    int lemma[VARS * 2 + 1];
+    uint32_t size = 0;
+    bool deletion = false, empty = false;
+    char token[32];
+    while (fscanf(in, "%31s", token) == 1) {
+        if (strcmp(token, "d") == 0) {
+            deletion = true;
+            continue;
+        }
+        int lit = atoi(token);
+        if (lit != 0) {
+            if (size == VARS * 2) FAIL("Lemma too long");
+            lemma[size++] = lit;
+            continue;
+        }
+        if (deletion) {
+            rup_delete(&clauses, lemma, size);
+        } else {
+            if (!rup_implied(&clauses, lemma, size, VARS)) FAIL("Lemma is not RUP");
+            rup_add(&clauses, lemma, size);
+            empty |= size == 0;
+        }
+        size = 0;
+        deletion = false;
+    }
+    fclose(in);
+    if (!empty && !rup_implied(&clauses, NULL, 0, VARS)) FAIL("Proof does not refute the formula");
+
+    for (uint32_t i = 0; i < clauses.num; i++) free(clauses.lits[i]);
+    free(clauses.lits);
+    free(clauses.sizes);
+    unlink(path);
+    PASS();
+}
+
+/*********************************************************************
+ * Main Test Runner
+ *********************************************************************/
+
+int main() {
+    printf("========================================\n");
+    printf("BSAT DRAT Proof Writer Unit Tests\n");
+    printf("========================================\n\n");
+
+    // Encodings
+    test_binary_encoding();
+    test_text_encoding();
+
+    // Buffering and solver integration
+    test_many_buffers();
+    test_solver_binary_proof();
+    test_minimized_lemmas_are_rup();
+
+    printf("\n========================================\n");
+    printf("Results: %d/%d tests passed\n", tests_passed, tests_run);
+    printf("========================================\n");
+
+    return (tests_passed == tests_run) ? 0 : 1;
+}
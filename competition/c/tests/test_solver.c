@@ -319,6 +319,33 @@ void test_multiple_solves() {
     PASS();
 }
 
+void test_deleted_clause_watches() {
+    TEST("Watches of deleted clauses are ignored");
+
+    Solver* s = solver_new();
+    for (int i = 0; i < 4; i++) solver_new_var(s);
+
+    // (¬1 ∨ ¬2 ∨ ¬3) is deleted with its watches left in place, as
+    // reduction does until the next collection
+    Lit lits[3] = { mkLit(1, true), mkLit(2, true), mkLit(3, true) };
+    solver_add_clause(s, lits, 3);
+    Lit other[3] = { mkLit(1, true), mkLit(2, true), mkLit(4, false) };
+    solver_add_clause(s, other, 3);
+    arena_delete(s->arena, s->clauses[0]);
+
+    Lit assumptions[3] = { mkLit(1, false), mkLit(2, false), mkLit(3, false) };
+    if (solver_solve_with_assumptions(s, assumptions, 3) != TRUE) {
+        FAIL("Deleted clause should not cause a conflict");
+    }
+    if (solver_model_value(s, 4) != TRUE) FAIL("Live clause should still propagate");
+
+    WatchStats stats = watch_stats(s->watches);
+    if (stats.skipped > stats.visits) FAIL("Skipped watches exceed examined ones");
+
+    solver_free(s);
+    PASS();
+}
+
 /*********************************************************************
  * Main Test Runner
  *********************************************************************/
@@ -344,6 +371,7 @@ int main() {
     test_conflict_limit();
     test_assumptions();
     test_multiple_solves();
+    test_deleted_clause_watches();
 
     printf("\n========================================\n");
     printf("Results: %d/%d tests passed\n", tests_passed, tests_run);
@@ -0,0 +1,206 @@
+/*********************************************************************
+ * BSAT C Solver - Subsumption Unit Tests
+ *
+ * Tests for backward subsumption, self-subsuming strengthening, the
+ * promotion of subsuming learned clauses and the effort budget of the
+ * occurrence-list subsumption pass.
+ *********************************************************************/
+
+#include "../include/solver.h"
+#include "../include/dimacs.h"
+#include "../include/subsume.h"
+#include "test_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Required for linking (normally defined in main.c)
+bool g_verbose = false;
+
+// Test counter
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define TEST(name) \
+    do { \
+        printf("Testing %s... ", name); \
+        tests_run++; \
+    } while (0)
+
+#define PASS() \
+    do { \
+        printf("✅ PASS\n"); \
+        tests_passed++; \
+    } while (0)
+
+#define FAIL(msg) \
+    do { \
+        printf("❌ FAIL: %s\n", msg); \
+        exit(1); \
+    } while (0)
+
+/*********************************************************************
+ * Helpers
+ *********************************************************************/
+
+static Solver* subsume_solver(const char* cnf) {
+    SolverOpts opts = default_opts();
+    opts.quiet = true;
+    opts.probing = false;
+    Solver* s = solver_new_with_opts(&opts);
+    dimacs_parse_string(s, cnf);
+    return s;
+}
+
+// Number of live long clauses in the clause list
+static uint32_t live_clauses(const Solver* s) {
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < s->num_clauses; i++) {
+        CRef cref = s->clauses[i];
+        if (cref != INVALID_CLAUSE && !clause_deleted(s->arena, cref)) n++;
+    }
+    return n;
+}
+
+/*********************************************************************
+ * Test Cases
+ *********************************************************************/
+
+void test_backward_subsumption() {
+    TEST("Supersets of a clause are removed");
+
+    const char* cnf = "p cnf 5 3\n1 2 3 0\n1 2 3 4 0\n-1 3 2 5 0\n";
+    Solver* s = subsume_solver(cnf);
+
+    if (!subsume_run(s, s->opts.subsume_effort)) FAIL("Formula is SAT");
+    if (s->stats.subsume_removed != 1) FAIL("One clause should be subsumed");
+    if (live_clauses(s) != 2) FAIL("Two clauses should remain");
+
+    solver_free(s);
+    PASS();
+}
+
+void test_binary_subsumer() {
+    TEST("Binary clauses subsume and strengthen long clauses");
+
+    // (1 ∨ 2) subsumes the first clause and strengthens the second to (2 ∨ 3 ∨ 4)
+    const char* cnf = "p cnf 4 3\n1 2 0\n1 2 3 0\n-1 2 3 4 0\n";
+    Solver* s = subsume_solver(cnf);
+
+    if (!subsume_run(s, s->opts.subsume_effort)) FAIL("Formula is SAT");
+    if (s->stats.subsume_removed != 1) FAIL("One clause should be subsumed");
+    if (s->stats.subsume_strengthened != 1) FAIL("One clause should be strengthened");
+    if (solver_solve(s) != TRUE) FAIL("Formula is SAT");
+    if (!model_satisfies(s, cnf)) FAIL("Model does not satisfy formula");
+
+    solver_free(s);
+    PASS();
+}
+
+void test_self_subsumption() {
+    TEST("Self-subsuming resolution removes the negated literal");
+
+    const char* cnf = "p cnf 5 2\n1 2 3 0\n-1 2 3 4 5 0\n";
+    Solver* s = subsume_solver(cnf);
+
+    if (!subsume_run(s, s->opts.subsume_effort)) FAIL("Formula is SAT");
+    if (s->stats.subsume_strengthened != 1) FAIL("One clause should be strengthened");
+
+    CRef cref = s->clauses[1];
+    if (CLAUSE_SIZE(s->arena, cref) != 4) FAIL("Strengthened clause should have 4 literals");
+    const Lit* lits = CLAUSE_LITS(s->arena, cref);
+    for (uint32_t i = 0; i < 4; i++) {
+        if (var(lits[i]) == 1) FAIL("Variable 1 should be gone");
+    }
+    if (solver_solve(s) != TRUE) FAIL("Formula is SAT");
+    if (!model_satisfies(s, cnf)) FAIL("Model does not satisfy formula");
+
+    solver_free(s);
+    PASS();
+}
+
+void test_learned_promotion() {
+    TEST("Learned clauses that subsume originals become irredundant");
+
+    Solver* s = subsume_solver("p cnf 4 1\n1 2 3 4 0\n");
+    Lit learnt[3] = { mkLit(1, false), mkLit(2, false), mkLit(3, false) };
+    solver_import_clause(s, learnt, 3, 3);
+    if (s->num_learnts != 1) FAIL("Imported clause should be learned");
+    CRef cref = s->learnts[0];
+
+    if (!subsume_run(s, s->opts.subsume_effort)) FAIL("Formula is SAT");
+    if (s->stats.subsume_removed != 1) FAIL("The original clause should be subsumed");
+    if (clause_learned(s->arena, cref)) FAIL("Subsumer should be irredundant");
+    if (s->num_learnts != 0) FAIL("Subsumer should leave the learned list");
+    if (live_clauses(s) != 1) FAIL("Subsumer should be in the clause list");
+
+    solver_free(s);
+    PASS();
+}
+
+void test_effort_budget() {
+    TEST("An exhausted budget stops the round");
+
+    Solver* s = subsume_solver("p cnf 4 2\n1 2 3 0\n1 2 3 4 0\n");
+
+    if (!subsume_run(s, 0)) FAIL("Formula is SAT");
+    if (s->stats.subsume_removed != 0) FAIL("No work should be done");
+    if (s->stats.subsume_rounds != 1) FAIL("The round should be counted");
+
+    solver_free(s);
+    PASS();
+}
+
+void test_strengthened_binary() {
+    TEST("Binaries made by strengthening are used in the same round");
+
+    // (1 ∨ 2 ∨ -3) becomes (1 ∨ 2), which then strengthens the last clause
+    const char* cnf = "p cnf 5 3\n1 2 3 0\n1 2 -3 0\n1 -2 4 5 0\n";
+    Solver* s = subsume_solver(cnf);
+
+    if (!subsume_run(s, s->opts.subsume_effort)) FAIL("Formula is SAT");
+    if (s->stats.subsume_strengthened != 2) FAIL("Two clauses should be strengthened");
+    if (solver_solve(s) != TRUE) FAIL("Formula is SAT");
+    if (!model_satisfies(s, cnf)) FAIL("Model does not satisfy formula");
+
+    solver_free(s);
+    PASS();
+}
+
+void test_unsat_preserved() {
+    TEST("Strengthened UNSAT formula stays UNSAT");
+
+    // All eight sign patterns over three variables
+    Solver* s = subsume_solver("p cnf 3 8\n1 2 3 0\n1 2 -3 0\n1 -2 3 0\n1 -2 -3 0\n"
+                               "-1 2 3 0\n-1 2 -3 0\n-1 -2 3 0\n-1 -2 -3 0\n");
+
+    if (solver_solve(s) != FALSE) FAIL("Formula is UNSAT");
+    if (s->stats.subsume_strengthened == 0) FAIL("Preprocessing should strengthen clauses");
+
+    solver_free(s);
+    PASS();
+}
+
+/*********************************************************************
+ * Main Test Runner
+ *********************************************************************/
+
+int main() {
+    printf("========================================\n");
+    printf("BSAT Subsumption Unit Tests\n");
+    printf("========================================\n\n");
+
+    test_backward_subsumption();
+    test_binary_subsumer();
+    test_self_subsumption();
+    test_learned_promotion();
+    test_effort_budget();
+    test_strengthened_binary();
+    test_unsat_preserved();
+
+    printf("\n========================================\n");
+    printf("Results: %d/%d tests passed\n", tests_passed, tests_run);
+    printf("========================================\n");
+
+    return (tests_passed == tests_run) ? 0 : 1;
+}
@@ -0,0 +1,83 @@
+/*********************************************************************
+ * BSAT C Solver - Shared Test Helpers
+ *
+ * Formula generators, model checks and file helpers used by several
+ * unit test programs. Everything is static inline, so each test only
+ * compiles what it uses. make_temp needs _POSIX_C_SOURCE defined by the
+ * test before any include.
+ *********************************************************************/
+
+#ifndef BSAT_TEST_UTIL_H
+#define BSAT_TEST_UTIL_H
+
+#include "../include/solver.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_POSIX_C_SOURCE) && _POSIX_C_SOURCE >= 200809L
+#include <unistd.h>
+
+// Create an empty temporary file; path must hold at least 32 bytes
+static inline bool make_temp(char* path) {
+    strcpy(path, "/tmp/bsat_test_XXXXXX");
+    int fd = mkstemp(path);
+    if (fd < 0) return false;
+    close(fd);
+    return true;
+}
+#endif
+
+// Pigeonhole PHP(holes + 1, holes) in DIMACS form (UNSAT). Returns a
+// malloc'd string, or NULL if memory ran out.
+static inline char* pigeonhole_cnf(uint32_t holes) {
+    size_t pigeons = (size_t)holes + 1;
+    size_t vars = pigeons * holes;
+    size_t pairs = holes * pigeons * (pigeons - 1) / 2;
+
+    // At most 11 characters per variable number plus a sign and a space
+    size_t cap = 64 + vars * 12 + pigeons * 2 + pairs * 28;
+    char* buf = (char*)malloc(cap);
+    if (!buf) return NULL;
+
+    size_t len = (size_t)snprintf(buf, cap, "p cnf %zu %zu\n", vars, pigeons + pairs);
+    for (size_t p = 0; p < pigeons; p++) {
+        for (size_t h = 0; h < holes; h++) {
+            len += (size_t)snprintf(buf + len, cap - len, "%zu ", p * holes + h + 1);
+        }
+        len += (size_t)snprintf(buf + len, cap - len, "0\n");
+    }
+    for (size_t h = 0; h < holes; h++) {
+        for (size_t p = 0; p < pigeons; p++) {
+            for (size_t q = p + 1; q < pigeons; q++) {
+                len += (size_t)snprintf(buf + len, cap - len, "-%zu -%zu 0\n",
+                                        p * holes + h + 1, q * holes + h + 1);
+            }
+        }
+    }
+    return buf;
+}
+
+// Check the model against the clauses of a DIMACS string
+static inline bool model_satisfies(const Solver* s, const char* dimacs) {
+    const char* p = strchr(dimacs, '\n');
+    bool satisfied = false;
+    while (p && *p) {
+        char* end;
+        long lit = strtol(p, &end, 10);
+        if (end == p) break;
+        p = end;
+        if (lit == 0) {
+            if (!satisfied) return false;
+            satisfied = false;
+        } else {
+            lbool val = solver_model_value(s, (Var)labs(lit));
+            if ((lit > 0 && val == TRUE) || (lit < 0 && val == FALSE)) satisfied = true;
+        }
+    }
+    return true;
+}
+
+#endif // BSAT_TEST_UTIL_H
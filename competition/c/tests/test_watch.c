@@ -2,7 +2,8 @@
  * BSAT C Solver - Watch Manager Tests
  *
  * Tests for watch.c: two-watched literal scheme, watch list management,
- * adding/removing watches, and blocking literal optimization.
+ * adding/removing watches, blocking literal optimization, and binary
+ * implication lists.
  *********************************************************************/
 
 #include "../include/watch.h"
@@ -344,6 +345,45 @@ void test_watch_list_growth() {
     PASS();
 }
 
+void test_watch_slab(void) {
+    TEST("Watch slab reuses blocks and keeps long lists intact");
+
+    WatchManager* wm = watch_init(100);
+    if (watch_stats(wm).slab_bytes != 0) FAIL("Empty manager should own no chunks");
+
+    // Growing a list from 16 to 32 watches frees its first block, which
+    // the next list of 16 takes over
+    for (uint32_t i = 0; i < 17; i++) watch_add(wm, mkLit(1, false), i + 1, mkLit(2, false));
+    WatchStats stats = watch_stats(wm);
+    if (stats.slab_bytes != WATCH_SLAB_CHUNK_BYTES) FAIL("Lists should share one chunk");
+    if (stats.slab_free_bytes != 16 * sizeof(Watch)) FAIL("Outgrown block should be free");
+    watch_add(wm, mkLit(3, false), 100, mkLit(4, false));
+    if (watch_stats(wm).slab_free_bytes != 0) FAIL("Free block should be reused");
+
+    // Lists beyond the largest class leave the slab, content intact
+    uint32_t n = 3 * WATCH_SLAB_MAX_BYTES / sizeof(Watch);
+    for (uint32_t i = 0; i < n; i++) watch_add(wm, mkLit(5, true), i + 1, mkLit(i % 90 + 6, false));
+    for (uint32_t i = 0; i < 5000; i++) watch_add_binary(wm, mkLit(6, false), mkLit(i % 90 + 7, true));
+    stats = watch_stats(wm);
+    if (stats.large_bytes == 0) FAIL("Longest list should be malloc'd");
+    WatchList* wl = watch_list(wm, mkLit(5, true));
+    for (uint32_t i = 0; i < n; i++) {
+        if (wl->watches[i].cref != i + 1 || wl->watches[i].blocker != mkLit(i % 90 + 6, false)) {
+            FAIL("Watch changed while the list moved");
+        }
+    }
+    BinList* bl = bin_list(wm, mkLit(6, false));
+    for (uint32_t i = 0; i < 5000; i++) {
+        if (bl->lits[i] != mkLit(i % 90 + 7, true)) FAIL("Implication changed while the list moved");
+    }
+    if (watch_list(wm, mkLit(1, false))->size != 17 || watch_list(wm, mkLit(3, false))->size != 1) {
+        FAIL("Short lists should be untouched");
+    }
+
+    watch_free(wm);
+    PASS();
+}
+
 void test_binary_clause_watches(void) {
     TEST("Binary clause (2 literals) watches");
 
@@ -383,6 +423,73 @@ void test_binary_clause_watches(void) {
     PASS();
 }
 
+void test_binary_implication_lists(void) {
+    TEST("Binary implication lists");
+
+    WatchManager* wm = watch_init(5);
+
+    // (x1 ∨ ¬x2) and (x1 ∨ x3): x1 false implies ¬x2 and x3
+    watch_add_binary(wm, mkLit(1, false), mkLit(2, true));
+    watch_add_binary(wm, mkLit(1, false), mkLit(3, false));
+
+    BinList* bl = bin_list(wm, mkLit(1, false));
+    if (bl->size != 2 || bl->lits[0] != mkLit(2, true) || bl->lits[1] != mkLit(3, false)) {
+        FAIL("x1 should imply ¬x2 and x3");
+    }
+    if (bin_list(wm, mkLit(2, true))->size != 1 || bin_list(wm, mkLit(2, true))->lits[0] != mkLit(1, false)) {
+        FAIL("¬x2 false should imply x1");
+    }
+    if (watch_list(wm, mkLit(1, false))->size != 0) {
+        FAIL("Binary clauses must not use long watch lists");
+    }
+
+    // Lists survive a resize
+    if (!watch_resize(wm, 50)) FAIL("watch_resize should succeed");
+    if (bin_list(wm, mkLit(1, false))->size != 2) FAIL("Implications lost on resize");
+    if (bin_list(wm, mkLit(50, true))->size != 0) FAIL("New literal should have no implications");
+
+    // Removal
+    if (!watch_remove_binary(wm, mkLit(3, false), mkLit(1, false))) FAIL("Clause should be found");
+    if (watch_remove_binary(wm, mkLit(3, false), mkLit(1, false))) FAIL("Clause is already gone");
+    bl = bin_list(wm, mkLit(1, false));
+    if (bl->size != 1 || bl->lits[0] != mkLit(2, true)) FAIL("Wrong implication removed");
+    if (bin_list(wm, mkLit(3, false))->size != 0) FAIL("x3 list should be empty");
+
+    // Clear
+    watch_clear(wm);
+    if (bin_list(wm, mkLit(1, false))->size != 0 || bin_list(wm, mkLit(2, true))->size != 0) {
+        FAIL("watch_clear should empty implication lists");
+    }
+
+    watch_free(wm);
+    PASS();
+}
+
+void test_binary_and_long_stats(void) {
+    TEST("Statistics separate binary and long watches");
+
+    Arena* arena = arena_init(1024);
+    WatchManager* wm = watch_init(10);
+
+    watch_add_binary(wm, mkLit(1, false), mkLit(2, false));
+    watch_add_binary(wm, mkLit(3, true), mkLit(4, false));
+    watch_add_binary(wm, mkLit(1, false), mkLit(5, true));
+
+    Lit lits[3] = {mkLit(6, false), mkLit(7, false), mkLit(8, true)};
+    CRef cref = arena_alloc(arena, lits, 3, false);
+    watch_add(wm, lits[0], cref, lits[1]);
+    watch_add(wm, lits[1], cref, lits[0]);
+
+    WatchStats stats = watch_stats(wm);
+    if (stats.binary_clauses != 3 || stats.binary_watches != 6) FAIL("Expected 3 binary clauses");
+    if (stats.long_watches != 2) FAIL("Expected 2 long watches");
+    if (stats.total_watches != 8) FAIL("Total should include both kinds");
+
+    watch_free(wm);
+    arena_free(arena);
+    PASS();
+}
+
 void test_watch_resize(void) {
     TEST("Watch manager in-place resize");
 
@@ -481,9 +588,12 @@ int main(void) {
     test_blocker_literal();
     test_positive_and_negative_literals();
     test_binary_clause_watches();
+    test_binary_implication_lists();
+    test_binary_and_long_stats();
 
     // Edge cases
     test_watch_list_growth();
+    test_watch_slab();
 
     // New optimization tests
     test_watch_resize();
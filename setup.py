@@ -1,12 +1,28 @@
 """Setup script for bsat package."""
 
-from setuptools import setup, find_packages
+from setuptools import setup, find_packages, Extension
 from pathlib import Path
 
 # Read the README file
 readme_file = Path(__file__).parent / "src" / "bsat" / "README.md"
 long_description = readme_file.read_text(encoding="utf-8") if readme_file.exists() else ""
 
+# C engine bindings (bsat._engine): the competition solver sources minus its
+# command-line entry point. Optional, so installs without a C compiler fall
+# back to the pure Python solvers.
+engine_dir = Path("competition") / "c"
+engine_sources = sorted(
+    str(path) for path in (engine_dir / "src").glob("*.c") if path.name != "main.c"
+)
+engine_extension = Extension(
+    "bsat._engine",
+    sources=["src/bsat/_engine.c"] + engine_sources,
+    include_dirs=[str(engine_dir / "include")],
+    extra_compile_args=["-std=c11", "-O3", "-pthread"],
+    extra_link_args=["-pthread"],
+    optional=True,
+)
+
 setup(
     name="bsat",
     version="0.1.0",
@@ -36,6 +52,7 @@ setup(
     ],
     package_dir={"": "src"},
     packages=find_packages(where="src"),
+    ext_modules=[engine_extension],
     python_requires=">=3.7",
     install_requires=[
         # No external dependencies required
@@ -8,6 +8,7 @@ from .hornsat import HornSATSolver, solve_horn_sat, is_horn_formula
 from .xorsat import XORSATSolver, solve_xorsat, get_xorsat_stats
 from .walksat import WalkSATSolver, solve_walksat, get_walksat_stats
 from .cdcl import CDCLSolver, solve_cdcl, get_cdcl_stats
+from .engine import CSolver, HAVE_C_ENGINE, solve_c, cnf_to_flat
 from .schoening import SchoeningSolver, solve_schoening, get_schoening_stats
 from .reductions import (
     reduce_to_3sat,
@@ -63,6 +64,10 @@ __all__ = [
     'CDCLSolver',
     'solve_cdcl',
     'get_cdcl_stats',
+    'CSolver',
+    'HAVE_C_ENGINE',
+    'solve_c',
+    'cnf_to_flat',
     'SchoeningSolver',
     'solve_schoening',
     'get_schoening_stats',
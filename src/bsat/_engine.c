@@ -0,0 +1,442 @@
+/*********************************************************************
+ * bsat._engine - CPython bindings for the C CDCL solver
+ *
+ * Wraps one competition/c Solver per Python object. Clauses are passed
+ * as one flat buffer of signed integers with 0 after each clause (the
+ * DIMACS body), read in place through the buffer protocol, so numpy
+ * arrays and array('i') cost no per-literal Python objects. The GIL is
+ * released while solving.
+ *********************************************************************/
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include "solver.h"
+
+// Output control flags (defined by main.c in the command-line solver)
+bool g_verbose = false;
+bool g_debug = false;
+
+typedef struct {
+    PyObject_HEAD
+    Solver*  solver;
+    Lit*     lits;          // Clause being added
+    uint32_t lits_capacity;
+    bool     busy;          // Solving with the GIL released
+} EngineSolver;
+
+/*********************************************************************
+ * Helpers
+ *********************************************************************/
+
+// The solver exists and no other thread is solving with it
+static bool check_ready(EngineSolver* self) {
+    if (!self->solver) {
+        PyErr_SetString(PyExc_RuntimeError, "solver is not initialized");
+        return false;
+    }
+    if (self->busy) {
+        PyErr_SetString(PyExc_RuntimeError, "solver is busy in another thread");
+        return false;
+    }
+    return true;
+}
+
+// Create variables up to v; false (with an exception set) if too many
+static bool ensure_var(EngineSolver* self, long long v) {
+    if (v > (long long)MAX_VARS) {
+        PyErr_Format(PyExc_ValueError, "variable %lld exceeds the limit of %u", v, (unsigned)MAX_VARS);
+        return false;
+    }
+    while (self->solver->num_vars < (uint64_t)v) {
+        if (solver_new_var(self->solver) == INVALID_VAR) {
+            PyErr_NoMemory();
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool push_lit(EngineSolver* self, uint32_t size, long long value) {
+    if (size == self->lits_capacity) {
+        uint32_t capacity = self->lits_capacity ? self->lits_capacity * 2 : 64;
+        Lit* grown = (Lit*)PyMem_Realloc(self->lits, capacity * sizeof(Lit));
+        if (!grown) {
+            PyErr_NoMemory();
+            return false;
+        }
+        self->lits = grown;
+        self->lits_capacity = capacity;
+    }
+    long long v = value < 0 ? -value : value;
+    if (!ensure_var(self, v)) return false;
+    self->lits[size] = mkLit((Var)v, value < 0);
+    return true;
+}
+
+// Item size of a buffer of signed integers, 0 if the format is not one
+static Py_ssize_t int_format_size(const Py_buffer* view) {
+    const char* f = view->format ? view->format : "B";
+    if (*f == '@' || *f == '=' || *f == '<' || *f == '!' || *f == '>') {
+        // Only native byte order can be read in place
+        bool little = *f == '<';
+        bool big = *f == '>' || *f == '!';
+        const uint16_t probe = 1;
+        bool native_little = *(const uint8_t*)&probe == 1;
+        if ((little && !native_little) || (big && native_little)) return 0;
+        f++;
+    }
+    if (f[0] == '\0' || f[1] != '\0') return 0;
+    switch (f[0]) {
+        case 'b': case 'h': case 'i': case 'l': case 'q': case 'n':
+            return view->itemsize;
+        default:
+            return 0;
+    }
+}
+
+static long long buffer_item(const char* data, Py_ssize_t itemsize, Py_ssize_t i) {
+    switch (itemsize) {
+        case 1: return ((const int8_t*)data)[i];
+        case 2: return ((const int16_t*)data)[i];
+        case 4: return ((const int32_t*)data)[i];
+        default: return ((const int64_t*)data)[i];
+    }
+}
+
+/*********************************************************************
+ * Methods
+ *********************************************************************/
+
+static void Solver_dealloc(EngineSolver* self) {
+    solver_free(self->solver);
+    PyMem_Free(self->lits);
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static int Solver_init(EngineSolver* self, PyObject* args, PyObject* kwds) {
+    static char* kwlist[] = {"seed", "var_decay", "elim", "inprocess", "vmtf", NULL};
+    unsigned int seed = 0;
+    SolverOpts opts = default_opts();
+    int elim = opts.elim, inprocess = opts.inprocess, vmtf = opts.vmtf;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|Idppp", kwlist,
+                                     &seed, &opts.var_decay, &elim, &inprocess, &vmtf)) {
+        return -1;
+    }
+    opts.seed = seed;
+    opts.elim = elim;
+    opts.inprocess = inprocess;
+    opts.vmtf = vmtf;
+    opts.quiet = true;
+    opts.stats = false;
+
+    solver_free(self->solver);
+    self->solver = solver_new_with_opts(&opts);
+    if (!self->solver) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    return 0;
+}
+
+PyDoc_STRVAR(add_clauses_doc,
+"add_clauses(buffer) -> bool\n\n"
+"Add clauses from a flat buffer of signed integers (numpy array,\n"
+"array('i'), bytes of int32, ...), each clause terminated by 0. Variables\n"
+"are created as needed. Returns False once the formula is known UNSAT.");
+
+static PyObject* Solver_add_clauses(EngineSolver* self, PyObject* arg) {
+    if (!check_ready(self)) return NULL;
+
+    Py_buffer view;
+    if (PyObject_GetBuffer(arg, &view, PyBUF_FORMAT | PyBUF_C_CONTIGUOUS) < 0) return NULL;
+    Py_ssize_t itemsize = int_format_size(&view);
+    if (itemsize != 1 && itemsize != 2 && itemsize != 4 && itemsize != 8) {
+        PyBuffer_Release(&view);
+        PyErr_SetString(PyExc_TypeError, "expected a buffer of native signed integers");
+        return NULL;
+    }
+
+    const char* data = (const char*)view.buf;
+    Py_ssize_t n = view.len / itemsize;
+    uint32_t size = 0;
+    bool ok = true;
+    for (Py_ssize_t i = 0; i < n; i++) {
+        long long value = buffer_item(data, itemsize, i);
+        if (value != 0) {
+            if (!push_lit(self, size, value)) {
+                PyBuffer_Release(&view);
+                return NULL;
+            }
+            size++;
+            continue;
+        }
+        ok = solver_add_clause(self->solver, self->lits, size) && ok;
+        size = 0;
+    }
+    PyBuffer_Release(&view);
+
+    if (size > 0) {
+        PyErr_SetString(PyExc_ValueError, "last clause is not terminated by 0");
+        return NULL;
+    }
+    return PyBool_FromLong(ok && self->solver->result != FALSE);
+}
+
+PyDoc_STRVAR(add_clause_doc,
+"add_clause(literals) -> bool\n\n"
+"Add one clause given as an iterable of non-zero signed integers.");
+
+static PyObject* Solver_add_clause(EngineSolver* self, PyObject* arg) {
+    if (!check_ready(self)) return NULL;
+
+    PyObject* seq = PySequence_Fast(arg, "clause must be an iterable of integers");
+    if (!seq) return NULL;
+    Py_ssize_t n = PySequence_Fast_GET_SIZE(seq);
+    for (Py_ssize_t i = 0; i < n; i++) {
+        long long value = PyLong_AsLongLong(PySequence_Fast_GET_ITEM(seq, i));
+        if (value == -1 && PyErr_Occurred()) {
+            Py_DECREF(seq);
+            return NULL;
+        }
+        if (value == 0) {
+            Py_DECREF(seq);
+            PyErr_SetString(PyExc_ValueError, "literal 0 inside a clause");
+            return NULL;
+        }
+        if (!push_lit(self, (uint32_t)i, value)) {
+            Py_DECREF(seq);
+            return NULL;
+        }
+    }
+    Py_DECREF(seq);
+
+    bool ok = solver_add_clause(self->solver, self->lits, (uint32_t)n);
+    return PyBool_FromLong(ok && self->solver->result != FALSE);
+}
+
+PyDoc_STRVAR(solve_doc,
+"solve(assumptions=(), max_conflicts=0, max_ticks=0) -> True | False | None\n\n"
+"Solve under the given assumption literals. Returns True (SAT), False\n"
+"(UNSAT, under the assumptions if any) or None when the conflict or\n"
+"tick limit is reached. Ticks measure effort deterministically, so a\n"
+"tick limit stops at the same point on every machine. Can be called\n"
+"again after adding more clauses.");
+
+static PyObject* Solver_solve(EngineSolver* self, PyObject* args, PyObject* kwds) {
+    static char* kwlist[] = {"assumptions", "max_conflicts", "max_ticks", NULL};
+    PyObject* assumptions = NULL;
+    unsigned long max_conflicts = 0;
+    unsigned long long max_ticks = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OkK", kwlist, &assumptions, &max_conflicts,
+                                     &max_ticks)) {
+        return NULL;
+    }
+    if (!check_ready(self)) return NULL;
+
+    uint32_t n = 0;
+    if (assumptions && assumptions != Py_None) {
+        PyObject* seq = PySequence_Fast(assumptions, "assumptions must be an iterable of integers");
+        if (!seq) return NULL;
+        Py_ssize_t count = PySequence_Fast_GET_SIZE(seq);
+        for (Py_ssize_t i = 0; i < count; i++) {
+            long long value = PyLong_AsLongLong(PySequence_Fast_GET_ITEM(seq, i));
+            if (value == 0 && !PyErr_Occurred()) {
+                PyErr_SetString(PyExc_ValueError, "assumption literal 0");
+            }
+            if (PyErr_Occurred() || !push_lit(self, n, value)) {
+                Py_DECREF(seq);
+                return NULL;
+            }
+            n++;
+        }
+        Py_DECREF(seq);
+    }
+
+    // Limits count from the start of this call
+    Solver* s = self->solver;
+    s->opts.max_conflicts = max_conflicts ? (uint32_t)(s->stats.conflicts + max_conflicts) : 0;
+    s->opts.max_ticks = max_ticks ? s->stats.ticks + max_ticks : 0;
+
+    lbool result;
+    self->busy = true;
+    Py_BEGIN_ALLOW_THREADS
+    result = solver_solve_with_assumptions(s, self->lits, n);
+    Py_END_ALLOW_THREADS
+    self->busy = false;
+
+    if (result == TRUE) Py_RETURN_TRUE;
+    if (result == FALSE) Py_RETURN_FALSE;
+    Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(model_doc,
+"model() -> list\n\n"
+"Model of the last SAT answer as signed literals [1, -2, 3, ...], one per\n"
+"variable.");
+
+static PyObject* Solver_model(EngineSolver* self, PyObject* Py_UNUSED(ignored)) {
+    if (!check_ready(self)) return NULL;
+
+    const Solver* s = self->solver;
+    PyObject* list = PyList_New(s->num_vars);
+    if (!list) return NULL;
+    for (Var v = 1; v <= s->num_vars; v++) {
+        long value = solver_model_value(s, v) == TRUE ? (long)v : -(long)v;
+        PyObject* item = PyLong_FromLong(value);
+        if (!item) {
+            Py_DECREF(list);
+            return NULL;
+        }
+        PyList_SET_ITEM(list, v - 1, item);
+    }
+    return list;
+}
+
+PyDoc_STRVAR(value_doc,
+"value(var) -> True | False | None\n\n"
+"Value of a variable in the model of the last SAT answer.");
+
+static PyObject* Solver_value(EngineSolver* self, PyObject* arg) {
+    if (!check_ready(self)) return NULL;
+    long v = PyLong_AsLong(arg);
+    if (v == -1 && PyErr_Occurred()) return NULL;
+    if (v <= 0) {
+        PyErr_SetString(PyExc_ValueError, "variables are numbered from 1");
+        return NULL;
+    }
+    lbool value = solver_model_value(self->solver, (Var)v);
+    if (value == TRUE) Py_RETURN_TRUE;
+    if (value == FALSE) Py_RETURN_FALSE;
+    Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(conflict_doc,
+"conflict() -> list\n\n"
+"After UNSAT under assumptions: the negations of the assumptions that\n"
+"were needed (empty if the formula itself is UNSAT).");
+
+static PyObject* Solver_conflict(EngineSolver* self, PyObject* Py_UNUSED(ignored)) {
+    if (!check_ready(self)) return NULL;
+    uint32_t size;
+    const Lit* lits = solver_conflict(self->solver, &size);
+    PyObject* list = PyList_New(size);
+    if (!list) return NULL;
+    for (uint32_t i = 0; i < size; i++) {
+        long v = (long)var(lits[i]);
+        PyObject* item = PyLong_FromLong(sign(lits[i]) ? -v : v);
+        if (!item) {
+            Py_DECREF(list);
+            return NULL;
+        }
+        PyList_SET_ITEM(list, i, item);
+    }
+    return list;
+}
+
+PyDoc_STRVAR(freeze_doc,
+"freeze(var, frozen=True)\n\n"
+"Keep a variable out of preprocessing (needed with elim=True for\n"
+"variables that later clauses or assumptions mention).");
+
+static PyObject* Solver_freeze(EngineSolver* self, PyObject* args) {
+    long v;
+    int frozen = 1;
+    if (!PyArg_ParseTuple(args, "l|p", &v, &frozen)) return NULL;
+    if (!check_ready(self)) return NULL;
+    if (v <= 0) {
+        PyErr_SetString(PyExc_ValueError, "variables are numbered from 1");
+        return NULL;
+    }
+    if (!ensure_var(self, v)) return NULL;
+    solver_set_frozen(self->solver, (Var)v, frozen);
+    Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(stats_doc, "stats() -> dict\n\nSearch counters of this solver.");
+
+static PyObject* Solver_stats(EngineSolver* self, PyObject* Py_UNUSED(ignored)) {
+    if (!check_ready(self)) return NULL;
+    const Solver* s = self->solver;
+    return Py_BuildValue("{s:K,s:K,s:K,s:K,s:K,s:K}",
+                         "decisions", (unsigned long long)s->stats.decisions,
+                         "propagations", (unsigned long long)s->stats.propagations,
+                         "ticks", (unsigned long long)s->stats.ticks,
+                         "conflicts", (unsigned long long)s->stats.conflicts,
+                         "restarts", (unsigned long long)s->stats.restarts,
+                         "learned_clauses", (unsigned long long)s->stats.learned_clauses);
+}
+
+static PyObject* Solver_get_num_vars(EngineSolver* self, void* Py_UNUSED(closure)) {
+    if (!check_ready(self)) return NULL;
+    return PyLong_FromUnsignedLong(self->solver->num_vars);
+}
+
+static PyObject* Solver_get_num_clauses(EngineSolver* self, void* Py_UNUSED(closure)) {
+    if (!check_ready(self)) return NULL;
+    return PyLong_FromUnsignedLong(self->solver->num_clauses);
+}
+
+static PyMethodDef Solver_methods[] = {
+    {"add_clauses", (PyCFunction)Solver_add_clauses, METH_O, add_clauses_doc},
+    {"add_clause", (PyCFunction)Solver_add_clause, METH_O, add_clause_doc},
+    {"solve", (PyCFunction)(void (*)(void))Solver_solve, METH_VARARGS | METH_KEYWORDS, solve_doc},
+    {"model", (PyCFunction)Solver_model, METH_NOARGS, model_doc},
+    {"value", (PyCFunction)Solver_value, METH_O, value_doc},
+    {"conflict", (PyCFunction)Solver_conflict, METH_NOARGS, conflict_doc},
+    {"freeze", (PyCFunction)Solver_freeze, METH_VARARGS, freeze_doc},
+    {"stats", (PyCFunction)Solver_stats, METH_NOARGS, stats_doc},
+    {NULL, NULL, 0, NULL}
+};
+
+static PyGetSetDef Solver_getset[] = {
+    {"num_vars", (getter)Solver_get_num_vars, NULL, "Number of variables", NULL},
+    {"num_clauses", (getter)Solver_get_num_clauses, NULL, "Number of clauses added", NULL},
+    {NULL, NULL, NULL, NULL, NULL}
+};
+
+PyDoc_STRVAR(Solver_doc,
+"Solver(seed=0, var_decay=0.95, elim=False, inprocess=False, vmtf=False)\n\n"
+"Incremental CDCL solver backed by the C engine. Variables are positive\n"
+"integers and literals are signed integers, as in DIMACS.");
+
+static PyTypeObject SolverType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "bsat._engine.Solver",
+    .tp_doc = Solver_doc,
+    .tp_basicsize = sizeof(EngineSolver),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_new = PyType_GenericNew,
+    .tp_init = (initproc)Solver_init,
+    .tp_dealloc = (destructor)Solver_dealloc,
+    .tp_methods = Solver_methods,
+    .tp_getset = Solver_getset,
+};
+
+/*********************************************************************
+ * Module
+ *********************************************************************/
+
+static struct PyModuleDef engine_module = {
+    PyModuleDef_HEAD_INIT,
+    .m_name = "bsat._engine",
+    .m_doc = "CPython bindings for the bsat C CDCL solver.",
+    .m_size = -1,
+};
+
+PyMODINIT_FUNC PyInit__engine(void) {
+    if (PyType_Ready(&SolverType) < 0) return NULL;
+
+    PyObject* m = PyModule_Create(&engine_module);
+    if (!m) return NULL;
+
+    Py_INCREF(&SolverType);
+    if (PyModule_AddObject(m, "Solver", (PyObject*)&SolverType) < 0) {
+        Py_DECREF(&SolverType);
+        Py_DECREF(m);
+        return NULL;
+    }
+    return m;
+}
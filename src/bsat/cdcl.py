@@ -21,6 +21,7 @@ from dataclasses import dataclass
 from collections import defaultdict
 import heapq
 from .cnf import CNFExpression, Clause, Literal
+from .engine import HAVE_C_ENGINE, solve_c
 
 
 @dataclass
@@ -442,7 +443,8 @@ class CDCLSolver:
 
 def solve_cdcl(cnf: CNFExpression,
                vsids_decay: float = 0.95,
-               max_conflicts: int = 1000000) -> Optional[Dict[str, bool]]:
+               max_conflicts: int = 1000000,
+               engine: str = 'auto') -> Optional[Dict[str, bool]]:
     """
     Solve a CNF formula using CDCL algorithm.
 
@@ -450,6 +452,8 @@ def solve_cdcl(cnf: CNFExpression,
         cnf: CNF formula to solve
         vsids_decay: VSIDS decay factor (0.9-0.99 typical)
         max_conflicts: Maximum conflicts before giving up
+        engine: 'c' for the compiled C solver (bsat.engine), 'python' for
+            CDCLSolver, 'auto' (default) for C when it was built
 
     Returns:
         Dictionary mapping variables to values if SAT, None if UNSAT
@@ -463,6 +467,11 @@ def solve_cdcl(cnf: CNFExpression,
         ... else:
         ...     print("UNSAT")
     """
+    if engine not in ('auto', 'c', 'python'):
+        raise ValueError(f"unknown engine: {engine!r}")
+    if engine == 'c' or (engine == 'auto' and HAVE_C_ENGINE):
+        return solve_c(cnf, vsids_decay=vsids_decay, max_conflicts=max_conflicts)
+
     solver = CDCLSolver(cnf, vsids_decay=vsids_decay)
     return solver.solve(max_conflicts=max_conflicts)
 
@@ -0,0 +1,87 @@
+"""
+Fast CDCL solving through the C engine.
+
+The compiled extension ``bsat._engine`` wraps the solver in
+``competition/c``. It is built by ``setup.py`` when a C compiler is
+available; otherwise ``HAVE_C_ENGINE`` is False and callers fall back to
+the pure Python solvers.
+
+Clauses are handed over as one flat integer buffer in DIMACS order (each
+clause followed by 0), which the extension reads in place:
+
+    >>> from array import array
+    >>> from bsat.engine import CSolver
+    >>> solver = CSolver()
+    >>> solver.add_clauses(array('i', [1, 2, 0, -1, 2, 0, -2, 3, 0]))
+    True
+    >>> solver.solve()
+    True
+    >>> solver.value(3)
+    True
+
+numpy arrays of int32 or int64 work the same way. ``solve`` accepts
+assumptions and can be called again after adding clauses.
+"""
+
+from array import array
+from typing import Dict, List, Optional, Tuple
+
+from .cnf import CNFExpression
+
+try:
+    from ._engine import Solver as CSolver
+    HAVE_C_ENGINE = True
+except ImportError:
+    CSolver = None
+    HAVE_C_ENGINE = False
+
+
+def cnf_to_flat(cnf: CNFExpression) -> Tuple[array, List[str]]:
+    """
+    Number the variables of a CNF expression and flatten its clauses.
+
+    Args:
+        cnf: CNF formula
+
+    Returns:
+        Tuple of (flat array('i') of signed literals with 0 after each
+        clause, variable names where names[i] is variable i + 1)
+    """
+    names = sorted(cnf.get_variables())
+    index = {name: i + 1 for i, name in enumerate(names)}
+    flat = array('i')
+    for clause in cnf.clauses:
+        flat.extend(-index[lit.variable] if lit.negated else index[lit.variable]
+                    for lit in clause.literals)
+        flat.append(0)
+    return flat, names
+
+
+def solve_c(cnf: CNFExpression,
+            vsids_decay: float = 0.95,
+            max_conflicts: int = 0) -> Optional[Dict[str, bool]]:
+    """
+    Solve a CNF formula with the C engine.
+
+    Args:
+        cnf: CNF formula to solve
+        vsids_decay: VSIDS decay factor
+        max_conflicts: Maximum conflicts before giving up (0 = unlimited)
+
+    Returns:
+        Dictionary mapping variables to values if SAT, None if UNSAT or
+        the conflict limit was reached
+
+    Raises:
+        RuntimeError: if the extension was not built
+    """
+    if not HAVE_C_ENGINE:
+        raise RuntimeError("bsat._engine is not available (built without a C compiler?)")
+
+    flat, names = cnf_to_flat(cnf)
+    solver = CSolver(var_decay=vsids_decay)
+    if not solver.add_clauses(flat):
+        return None
+    if solver.solve(max_conflicts=max_conflicts) is not True:
+        return None
+    return {names[abs(lit) - 1]: lit > 0 for lit in solver.model()[:len(names)]}
@@ -0,0 +1,134 @@
+"""
+Tests for the C engine bindings (bsat._engine).
+"""
+
+import unittest
+from array import array
+from bsat import (
+    CNFExpression, Clause, Literal,
+    CSolver, HAVE_C_ENGINE, solve_c, cnf_to_flat, solve_cdcl
+)
+
+
+def pigeonhole(holes):
+    """Flat clauses of PHP(holes + 1, holes), which is UNSAT."""
+    pigeons = holes + 1
+    var = lambda p, h: p * holes + h + 1
+    flat = array('i')
+    for p in range(pigeons):
+        flat.extend(var(p, h) for h in range(holes))
+        flat.append(0)
+    for h in range(holes):
+        for p in range(pigeons):
+            for q in range(p + 1, pigeons):
+                flat.extend([-var(p, h), -var(q, h), 0])
+    return flat
+
+
+@unittest.skipUnless(HAVE_C_ENGINE, "bsat._engine was not built")
+class TestEngine(unittest.TestCase):
+    """Test cases for the C engine bindings."""
+
+    def test_flat_clauses(self):
+        """Test adding a flat array('i') of clauses in one call."""
+        solver = CSolver()
+        self.assertTrue(solver.add_clauses(array('i', [1, 2, 0, -1, 2, 0, -2, 3, 0])))
+        self.assertEqual(solver.num_vars, 3)
+        self.assertEqual(solver.num_clauses, 3)
+        self.assertTrue(solver.solve())
+        model = solver.model()
+        self.assertEqual(len(model), 3)
+        self.assertIn(2, model)
+        self.assertIn(3, model)
+        self.assertTrue(solver.value(2))
+
+    def test_integer_widths(self):
+        """Test 8-byte and memoryview buffers."""
+        solver = CSolver()
+        self.assertTrue(solver.add_clauses(array('q', [1, -2, 0])))
+        self.assertTrue(solver.add_clauses(memoryview(array('i', [2, 0]))))
+        self.assertTrue(solver.solve())
+        self.assertEqual(solver.model(), [1, 2])
+
+    def test_unsat(self):
+        """Test an UNSAT pigeonhole formula."""
+        solver = CSolver()
+        solver.add_clauses(pigeonhole(5))
+        self.assertFalse(solver.solve())
+        self.assertGreater(solver.stats()['conflicts'], 0)
+
+    def test_assumptions(self):
+        """Test incremental solving under assumptions."""
+        solver = CSolver()
+        solver.add_clauses(array('i', [1, 2, 0, -1, 2, 0, -2, 3, 0]))
+        self.assertFalse(solver.solve(assumptions=[-3]))
+        self.assertEqual(solver.conflict(), [3])
+        self.assertTrue(solver.solve())
+        solver.add_clause([-3])
+        self.assertFalse(solver.solve())
+        self.assertEqual(solver.conflict(), [])
+
+    def test_conflict_limit(self):
+        """Test that a conflict limit gives an unknown answer."""
+        solver = CSolver()
+        solver.add_clauses(pigeonhole(9))
+        self.assertIsNone(solver.solve(max_conflicts=10))
+
+    def test_tick_limit(self):
+        """Test that a tick limit stops at the same point every time."""
+        counts = []
+        for _ in range(2):
+            solver = CSolver()
+            solver.add_clauses(pigeonhole(9))
+            self.assertIsNone(solver.solve(max_ticks=100000))
+            stats = solver.stats()
+            self.assertGreaterEqual(stats['ticks'], 100000)
+            counts.append((stats['conflicts'], stats['ticks']))
+        self.assertEqual(counts[0], counts[1])
+
+    def test_bad_input(self):
+        """Test rejected buffers and clauses."""
+        solver = CSolver()
+        with self.assertRaises(ValueError):
+            solver.add_clauses(array('i', [1, 2]))
+        with self.assertRaises(TypeError):
+            solver.add_clauses(array('d', [1.0, 0.0]))
+        with self.assertRaises(ValueError):
+            solver.add_clause([1, 0, 2])
+
+    def test_cnf_handoff(self):
+        """Test that CNFExpression formulas go through the C engine."""
+        cnf = CNFExpression([
+            Clause([Literal('x', False), Literal('y', False)]),
+            Clause([Literal('x', True), Literal('z', False)]),
+            Clause([Literal('y', True), Literal('z', True)])
+        ])
+        flat, names = cnf_to_flat(cnf)
+        self.assertEqual(names, ['x', 'y', 'z'])
+        self.assertEqual(list(flat), [1, 2, 0, -1, 3, 0, -2, -3, 0])
+
+        result = solve_c(cnf)
+        self.assertIsNotNone(result)
+        self.assertTrue(cnf.evaluate(result))
+        self.assertEqual(solve_cdcl(cnf, engine='c'), result)
+
+        unsat = CNFExpression([
+            Clause([Literal('x', False)]),
+            Clause([Literal('x', True)])
+        ])
+        self.assertIsNone(solve_cdcl(unsat, engine='c'))
+        self.assertIsNone(solve_cdcl(unsat, engine='python'))
+
+
+def run_tests():
+    """Run all engine tests."""
+    suite = unittest.TestLoader().loadTestsFromTestCase(TestEngine)
+    runner = unittest.TextTestRunner(verbosity=2)
+    result = runner.run(suite)
+    return result.wasSuccessful()
+
+
+if __name__ == '__main__':
+    import sys
+    success = run_tests()
+    sys.exit(0 if success else 1)